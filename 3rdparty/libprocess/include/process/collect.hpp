@@ -13,16 +13,20 @@
 #ifndef __PROCESS_COLLECT_HPP__
 #define __PROCESS_COLLECT_HPP__
 
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <tuple>
 #include <vector>
 
 #include <process/check.hpp>
 #include <process/defer.hpp>
+#include <process/dispatch.hpp>
 #include <process/future.hpp>
 #include <process/id.hpp>
 #include <process/owned.hpp>
 #include <process/process.hpp>
+#include <process/queue.hpp>
 
 #include <stout/lambda.hpp>
 
@@ -57,6 +61,17 @@ template <typename... Ts>
 Future<std::tuple<Future<Ts>...>> await(const Future<Ts>&... futures);
 
 
+// Streaming variant of `await`: returns a queue that yields each of
+// the specified futures as it transitions out of pending, in
+// completion order rather than in the order specified. Exactly
+// `futures.size()` futures are yielded and the caller is expected to
+// stop reading the queue once it has seen them all (an abandoned
+// future is never yielded). This lets wide fan-out callers process
+// completions incrementally instead of waiting on the last straggler.
+template <typename T>
+Queue<Future<T>> awaitEach(const std::vector<Future<T>>& futures);
+
+
 // Waits on the future specified and returns after the future has been
 // completed or the await has been discarded. This is useful when
 // wanting to "break out" of a future chain if a discard occurs but
@@ -124,8 +139,7 @@ public:
       Promise<std::vector<T>>* _promise)
     : ProcessBase(ID::generate("__collect__")),
       futures(_futures),
-      promise(_promise),
-      ready(0) {}
+      promise(_promise) {}
 
   ~CollectProcess() override
   {
@@ -138,8 +152,24 @@ protected:
     // Stop this nonsense if nobody cares.
     promise->future().onDiscard(defer(this, &CollectProcess::discarded));
 
+    // Completions are counted on a shared atomic rather than
+    // dispatched into this process one at a time: with tens of
+    // thousands of futures (e.g. containerizer recovery) a dispatch
+    // per completion allocates and queues an event per future. We
+    // only dispatch in for terminal events, i.e. the completion that
+    // makes the set whole or the first failure or discard.
+    auto ready = std::make_shared<std::atomic<size_t>>(0);
+    const size_t total = futures.size();
+    const PID<CollectProcess<T>> pid = this->self();
+
     foreach (const Future<T>& future, futures) {
-      future.onAny(defer(this, &CollectProcess::waited, lambda::_1));
+      future.onAny([ready, total, pid](const Future<T>& future) {
+        if (!future.isReady()) {
+          dispatch(pid, &CollectProcess::failed, future);
+        } else if (ready->fetch_add(1) + 1 == total) {
+          dispatch(pid, &CollectProcess::completed);
+        }
+      });
       future.onAbandoned(defer(this, &CollectProcess::abandoned));
     }
   }
@@ -167,34 +197,37 @@ private:
     terminate(this);
   }
 
-  void waited(const Future<T>& future)
+  void failed(const Future<T>& future)
   {
+    // NOTE: this can get dispatched more than once if several futures
+    // fail, but the `terminate` below ensures only the first delivery
+    // is processed.
     if (future.isFailed()) {
       promise->fail("Collect failed: " + future.failure());
-      terminate(this);
-    } else if (future.isDiscarded()) {
-      promise->fail("Collect failed: future discarded");
-      terminate(this);
     } else {
-      CHECK_READY(future);
-      ready += 1;
-      if (ready == futures.size()) {
-        std::vector<T> values;
-        values.reserve(futures.size());
+      CHECK(future.isDiscarded());
+      promise->fail("Collect failed: future discarded");
+    }
 
-        foreach (const Future<T>& future, futures) {
-          values.push_back(future.get());
-        }
+    terminate(this);
+  }
 
-        promise->set(std::move(values));
-        terminate(this);
-      }
+  void completed()
+  {
+    std::vector<T> values;
+    values.reserve(futures.size());
+
+    foreach (const Future<T>& future, futures) {
+      CHECK_READY(future);
+      values.push_back(future.get());
     }
+
+    promise->set(std::move(values));
+    terminate(this);
   }
 
   const std::vector<Future<T>> futures;
   Promise<std::vector<T>>* promise;
-  size_t ready;
 };
 
 
@@ -207,8 +240,7 @@ public:
       Promise<std::vector<Future<T>>>* _promise)
     : ProcessBase(ID::generate("__await__")),
       futures(_futures),
-      promise(_promise),
-      ready(0) {}
+      promise(_promise) {}
 
   ~AwaitProcess() override
   {
@@ -220,8 +252,19 @@ public:
     // Stop this nonsense if nobody cares.
     promise->future().onDiscard(defer(this, &AwaitProcess::discarded));
 
+    // As with `CollectProcess`, count completions on a shared atomic
+    // and dispatch into this process exactly once, when the final
+    // future transitions out of pending.
+    auto ready = std::make_shared<std::atomic<size_t>>(0);
+    const size_t total = futures.size();
+    const PID<AwaitProcess<T>> pid = this->self();
+
     foreach (const Future<T>& future, futures) {
-      future.onAny(defer(this, &AwaitProcess::waited, lambda::_1));
+      future.onAny([ready, total, pid](const Future<T>&) {
+        if (ready->fetch_add(1) + 1 == total) {
+          dispatch(pid, &AwaitProcess::completed);
+        }
+      });
       future.onAbandoned(defer(this, &AwaitProcess::abandoned));
     }
   }
@@ -249,21 +292,15 @@ private:
     terminate(this);
   }
 
-  void waited(const Future<T>& future)
+  void completed()
   {
-    CHECK(!future.isPending());
-
-    ready += 1;
-    if (ready == futures.size()) {
-      // It is safe to move futures at this point.
-      promise->set(std::move(futures));
-      terminate(this);
-    }
+    // It is safe to move futures at this point.
+    promise->set(std::move(futures));
+    terminate(this);
   }
 
   std::vector<Future<T>> futures;
   Promise<std::vector<Future<T>>>* promise;
-  size_t ready;
 };
 
 
@@ -321,6 +358,23 @@ inline Future<std::vector<Future<T>>> await(
 }
 
 
+template <typename T>
+Queue<Future<T>> awaitEach(const std::vector<Future<T>>& futures)
+{
+  Queue<Future<T>> queue;
+
+  // No process is needed here: `Queue` serializes access to its own
+  // state, so each future simply enqueues itself upon completion.
+  foreach (const Future<T>& future, futures) {
+    future.onAny([queue](const Future<T>& future) mutable {
+      queue.put(future);
+    });
+  }
+
+  return queue;
+}
+
+
 template <typename... Ts>
 Future<std::tuple<Future<Ts>...>> await(const Future<Ts>&... futures)
 {
@@ -13,6 +13,8 @@
 #ifndef __PROCESS_EVENT_HPP__
 #define __PROCESS_EVENT_HPP__
 
+#include <stdint.h>
+
 #include <memory> // TODO(benh): Replace shared_ptr with unique_ptr.
 
 #include <process/future.hpp>
@@ -97,6 +99,12 @@ struct Event
 
   // JSON representation for an Event.
   operator JSON::Object() const;
+
+  // Monotonic clock reading (in nanoseconds) taken when this event
+  // was enqueued, if the event was selected for latency sampling
+  // (see `LIBPROCESS_EVENT_LATENCY_SAMPLING` in process.cpp), or 0
+  // otherwise.
+  int64_t enqueue_time_ns = 0;
 };
 
 
@@ -179,7 +187,7 @@ struct DispatchEvent : Event
 {
   DispatchEvent(
       const UPID& _pid,
-      std::unique_ptr<lambda::CallableOnce<void(ProcessBase*)>> _f,
+      lambda::CallableOnce<void(ProcessBase*)>&& _f,
       const Option<const std::type_info*>& _functionType)
     : pid(_pid),
       f(std::move(_f)),
@@ -205,7 +213,7 @@ struct DispatchEvent : Event
   UPID pid;
 
   // Function to get invoked as a result of this dispatch event.
-  std::unique_ptr<lambda::CallableOnce<void(ProcessBase*)>> f;
+  lambda::CallableOnce<void(ProcessBase*)> f;
 
   Option<const std::type_info*> functionType;
 };
@@ -13,7 +13,11 @@
 #ifndef __PROCESS_FIREWALL_HPP__
 #define __PROCESS_FIREWALL_HPP__
 
+#include <stdint.h>
+
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <process/http.hpp>
 #include <process/owned.hpp>
@@ -66,6 +70,12 @@ public:
  *
  * Matches are required to be exact, no substrings nor wildcards are
  * considered for a match.
+ *
+ * The disabled paths are compiled once at construction time into a
+ * trie over their bytes, so applying the rule walks the request path
+ * at most once and bails out at the first byte that cannot lead to a
+ * disabled endpoint (unlike a hash lookup, which always processes
+ * the entire path).
  */
 class DisabledEndpointsFirewallRule : public FirewallRule
 {
@@ -78,7 +88,7 @@ public:
       const network::inet::Socket&,
       const http::Request& request) override
   {
-    if (paths.contains(request.url.path)) {
+    if (disabled(request.url.path)) {
       return http::Forbidden("Endpoint '" + request.url.path + "' is disabled");
     }
 
@@ -86,7 +96,21 @@ public:
   }
 
 private:
-  hashset<std::string> paths;
+  // Returns whether the path exactly matches one of the disabled
+  // endpoints.
+  bool disabled(const std::string& path) const;
+
+  // A node of the trie. Outgoing edges are stored as a vector of
+  // (byte, node index) pairs since the branching factor of endpoint
+  // paths is tiny and a linear scan is cheaper than hashing.
+  struct Node
+  {
+    std::vector<std::pair<char, uint32_t>> edges;
+    bool terminal = false;
+  };
+
+  // Trie over the bytes of the disabled paths, rooted at index 0.
+  std::vector<Node> nodes;
 };
 
 } // namespace firewall {
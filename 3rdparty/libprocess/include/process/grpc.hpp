@@ -14,12 +14,14 @@
 #define __PROCESS_GRPC_HPP__
 
 #include <chrono>
+#include <deque>
 #include <memory>
 #include <ostream>
 #include <string>
 #include <thread>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <google/protobuf/message.h>
 
@@ -31,6 +33,8 @@
 #include <process/pid.hpp>
 #include <process/process.hpp>
 
+#include <process/metrics/timer.hpp>
+
 #include <stout/duration.hpp>
 #include <stout/error.hpp>
 #include <stout/lambda.hpp>
@@ -121,6 +125,22 @@ public:
   explicit Connection(std::shared_ptr<::grpc::Channel> _channel)
     : channel(std::move(_channel)) {}
 
+  /**
+   * Returns a `Connection` whose channel is shared with any other pooled
+   * connection to the same endpoint. Since a gRPC channel is thread safe
+   * and multiplexes concurrent RPCs, reusing one channel per endpoint
+   * avoids repeated connection establishment (and TLS handshakes) across
+   * callers.
+   *
+   * NOTE: The credentials are only used when the channel for the given
+   * endpoint is first created; they are ignored if a pooled channel for
+   * the endpoint already exists.
+   */
+  static Connection pooled(
+      const std::string& uri,
+      const std::shared_ptr<::grpc::ChannelCredentials>& credentials =
+        ::grpc::InsecureChannelCredentials());
+
   const std::shared_ptr<::grpc::Channel> channel;
 };
 
@@ -144,20 +164,27 @@ struct CallOptions
 
 /**
  * A copyable interface to manage an internal runtime process for asynchronous
- * gRPC calls. A runtime process keeps a gRPC `CompletionQueue` to manage
- * outstanding requests, a looper thread to wait for any incoming responses from
- * the `CompletionQueue`, and handles the requests and responses. All `Runtime`
- * copies share the same runtime process. Usually we only need a single runtime
- * process to handle all gRPC calls, but multiple runtime processes can be
- * instantiated for better parallelism and isolation.
+ * gRPC calls. A runtime process keeps one or more gRPC `CompletionQueue`s to
+ * manage outstanding requests, a looper thread per queue to wait for any
+ * incoming responses from that queue, and handles the requests and responses.
+ * Calls are distributed across the completion queues round-robin, so running
+ * more than one queue keeps slow responses from delaying the handling of
+ * other calls' completions. All `Runtime` copies share the same runtime
+ * process. Usually we only need a single runtime process to handle all gRPC
+ * calls, but multiple runtime processes can be instantiated for better
+ * parallelism and isolation.
+ *
+ * The latency of every call (from sending the request to receiving the
+ * response) is tracked in a `<runtime process id>/call_latency_ms` metric.
  *
- * NOTE: The caller must call `terminate` to drain the `CompletionQueue` before
- * finalizing libprocess to gracefully terminate the gRPC runtime.
+ * NOTE: The caller must call `terminate` to drain the `CompletionQueue`s
+ * before finalizing libprocess to gracefully terminate the gRPC runtime.
  */
 class Runtime
 {
 public:
-  Runtime() : data(new Data()) {}
+  explicit Runtime(size_t completionQueues = 1)
+    : data(new Data(completionQueues)) {}
 
   /**
    * Sends an asynchronous gRPC call.
@@ -206,12 +233,15 @@ public:
         [connection, method, options, promise](
             const Request& request,
             bool terminating,
-            ::grpc::CompletionQueue* queue) {
+            ::grpc::CompletionQueue* queue,
+            metrics::Timer<Milliseconds>& call_latency) {
           if (terminating) {
             promise->fail("Runtime has been terminated");
             return;
           }
 
+          call_latency.time(promise->future());
+
           // TODO(chhsiao): The `shared_ptr`s here aren't shared, but only to be
           // captured by the lambda below. Use `unique_ptr`s once we get C++14.
           std::shared_ptr<::grpc::ClientContext> context(
@@ -264,7 +294,8 @@ public:
         },
         std::forward<Request>(request),
         lambda::_1,
-        lambda::_2));
+        lambda::_2,
+        lambda::_3));
 
     return future;
   }
@@ -287,13 +318,15 @@ private:
   // Type of the callback functions that can get invoked when sending a request
   // or receiving a response.
   typedef lambda::CallableOnce<
-      void(bool, ::grpc::CompletionQueue*)> SendCallback;
+      void(bool,
+           ::grpc::CompletionQueue*,
+           metrics::Timer<Milliseconds>&)> SendCallback;
   typedef lambda::CallableOnce<void()> ReceiveCallback;
 
   class RuntimeProcess : public Process<RuntimeProcess>
   {
   public:
-    RuntimeProcess();
+    explicit RuntimeProcess(size_t completionQueues);
     ~RuntimeProcess() override;
 
     void send(SendCallback callback);
@@ -305,17 +338,24 @@ private:
     void initialize() override;
     void finalize() override;
 
-    void loop();
+    void loop(::grpc::CompletionQueue* queue);
+
+    // NOTE: `CompletionQueue` is neither copyable nor movable, hence
+    // the `deque` which can construct its elements in place.
+    std::deque<::grpc::CompletionQueue> queues;
+
+    // Index of the completion queue the next call is assigned to.
+    size_t position;
 
-    ::grpc::CompletionQueue queue;
-    std::unique_ptr<std::thread> looper;
+    std::vector<std::unique_ptr<std::thread>> loopers;
     bool terminating;
     Promise<Nothing> terminated;
+    metrics::Timer<Milliseconds> call_latency;
   };
 
   struct Data
   {
-     Data();
+     explicit Data(size_t completionQueues);
      ~Data();
 
      PID<RuntimeProcess> pid;
@@ -19,9 +19,12 @@
 #include <atomic>
 #include <initializer_list>
 #include <iosfwd>
+#include <map>
 #include <memory>
 #include <queue>
+#include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <boost/functional/hash.hpp>
@@ -40,6 +43,7 @@
 #include <stout/none.hpp>
 #include <stout/nothing.hpp>
 #include <stout/option.hpp>
+#include <stout/result.hpp>
 #include <stout/stringify.hpp>
 #include <stout/strings.hpp>
 #include <stout/try.hpp>
@@ -359,6 +363,11 @@ public:
     // was unable to continue reading!
     Future<Nothing> readerClosed() const;
 
+    // Returns the number of bytes written to the pipe that the
+    // reader has not yet consumed. Writers can use this to avoid
+    // buffering unboundedly when the reader falls behind.
+    size_t outstanding() const;
+
     // Comparison operators useful for checking connection equality.
     bool operator==(const Writer& other) const { return data == other.data; }
     bool operator!=(const Writer& other) const { return !(*this == other); }
@@ -390,7 +399,8 @@ private:
   {
     Data()
       : readEnd(Reader::OPEN),
-        writeEnd(Writer::OPEN) {}
+        writeEnd(Writer::OPEN),
+        writesSize(0) {}
 
     // Rather than use a process to serialize access to the pipe's
     // internal data we use a 'std::atomic_flag'.
@@ -406,6 +416,9 @@ private:
     // empty strings as they serve as a signal for end-of-file.
     std::queue<std::string> writes;
 
+    // Total number of bytes currently queued in 'writes'.
+    size_t writesSize;
+
     // Signals when the read-end is closed before the write-end.
     Promise<Nothing> readerClosure;
 
@@ -452,35 +465,42 @@ private:
 } // namespace header {
 
 
-class Headers : public hashmap<
-    std::string,
-    std::string,
-    CaseInsensitiveHash,
-    CaseInsensitiveEqual>
+// A case-insensitive mapping from HTTP header names to values.
+// Messages typically carry only a handful of headers, so the entries
+// are kept flat in a contiguous buffer (in insertion order) and
+// looked up by a linear scan that first compares precomputed
+// case-insensitive hashes. This avoids the per-header node
+// allocations of a map-based container on the request/response hot
+// path.
+class Headers
 {
 public:
+  typedef std::pair<std::string, std::string> value_type;
+  typedef std::vector<value_type>::iterator iterator;
+  typedef std::vector<value_type>::const_iterator const_iterator;
+
   Headers() {}
 
   Headers(const std::map<std::string, std::string>& map)
-    : hashmap<
-          std::string,
-          std::string,
-          CaseInsensitiveHash,
-          CaseInsensitiveEqual>(map) {}
+  {
+    foreachpair (const std::string& key, const std::string& value, map) {
+      put(key, value);
+    }
+  }
 
   Headers(std::map<std::string, std::string>&& map)
-    : hashmap<
-          std::string,
-          std::string,
-          CaseInsensitiveHash,
-          CaseInsensitiveEqual>(map) {}
+  {
+    foreachpair (const std::string& key, std::string& value, map) {
+      put(key, std::move(value));
+    }
+  }
 
   Headers(std::initializer_list<std::pair<std::string, std::string>> list)
-     : hashmap<
-          std::string,
-          std::string,
-          CaseInsensitiveHash,
-          CaseInsensitiveEqual>(list) {}
+  {
+    foreach (const value_type& entry, list) {
+      put(entry.first, entry.second);
+    }
+  }
 
   template <typename T>
   Result<T> get() const
@@ -498,19 +518,112 @@ public:
 
   Option<std::string> get(const std::string& key) const
   {
-    return hashmap<
-        std::string,
-        std::string,
-        CaseInsensitiveHash,
-        CaseInsensitiveEqual>::get(key);
+    size_t index = find(key, CaseInsensitiveHash()(key));
+    if (index == entries.size()) {
+      return None();
+    }
+    return entries[index].second;
+  }
+
+  std::string& operator[](const std::string& key)
+  {
+    const size_t hash = CaseInsensitiveHash()(key);
+
+    size_t index = find(key, hash);
+    if (index == entries.size()) {
+      append(key, std::string(), hash);
+    }
+
+    return entries[index].second;
+  }
+
+  void put(const std::string& key, std::string value)
+  {
+    const size_t hash = CaseInsensitiveHash()(key);
+
+    size_t index = find(key, hash);
+    if (index == entries.size()) {
+      append(key, std::move(value), hash);
+    } else {
+      entries[index].second = std::move(value);
+    }
+  }
+
+  const std::string& at(const std::string& key) const
+  {
+    size_t index = find(key, CaseInsensitiveHash()(key));
+    if (index == entries.size()) {
+      throw std::out_of_range(key);
+    }
+    return entries[index].second;
+  }
+
+  bool contains(const std::string& key) const
+  {
+    return find(key, CaseInsensitiveHash()(key)) != entries.size();
+  }
+
+  size_t size() const { return entries.size(); }
+
+  bool empty() const { return entries.empty(); }
+
+  void clear()
+  {
+    entries.clear();
+    hashes.clear();
   }
 
+  iterator begin() { return entries.begin(); }
+  iterator end() { return entries.end(); }
+  const_iterator begin() const { return entries.begin(); }
+  const_iterator end() const { return entries.end(); }
+
   Headers operator+(const Headers& that) const
   {
     Headers result = *this;
-    result.insert(that.begin(), that.end());
+    for (size_t i = 0; i < that.entries.size(); i++) {
+      // Keys already present are left untouched, matching the
+      // `insert()` semantics of the map-based implementation.
+      if (result.find(that.entries[i].first, that.hashes[i]) ==
+          result.entries.size()) {
+        result.append(
+            that.entries[i].first, that.entries[i].second, that.hashes[i]);
+      }
+    }
     return result;
   }
+
+private:
+  // Returns the index of the entry with the given key, or the size
+  // of `entries` if not present. `hash` must be the result of
+  // `CaseInsensitiveHash` for `key`.
+  size_t find(const std::string& key, size_t hash) const
+  {
+    for (size_t i = 0; i < entries.size(); i++) {
+      if (hashes[i] == hash &&
+          CaseInsensitiveEqual()(entries[i].first, key)) {
+        return i;
+      }
+    }
+    return entries.size();
+  }
+
+  void append(const std::string& key, std::string value, size_t hash)
+  {
+    if (entries.capacity() == 0) {
+      // A single up-front allocation covers the typical message.
+      entries.reserve(16);
+      hashes.reserve(16);
+    }
+
+    entries.push_back(value_type(key, std::move(value)));
+    hashes.push_back(hash);
+  }
+
+  // Entries are kept in insertion order; `hashes[i]` caches the
+  // case-insensitive hash of `entries[i].first`.
+  std::vector<value_type> entries;
+  std::vector<size_t> hashes;
 };
 
 
@@ -963,7 +1076,7 @@ public:
   /**
    * Returns a future that is satisfied when a disconnection occurs.
    */
-  Future<Nothing> disconnected();
+  Future<Nothing> disconnected() const;
 
   bool operator==(const Connection& c) const { return data == c.data; }
   bool operator!=(const Connection& c) const { return !(*this == c); }
@@ -1000,6 +1113,25 @@ Future<Nothing> serve(
     network::Socket s,
     std::function<Future<Response>(const Request&)>&& f);
 
+
+// The subset of a file requested via an HTTP 'Range' header, i.e.,
+// the half-open byte interval [offset, offset + length).
+struct ByteRange
+{
+  off_t offset;
+  size_t length;
+};
+
+
+// Parses a 'Range' header of the form "bytes=first-last",
+// "bytes=first-" or "bytes=-suffix" against a file of the given
+// size. Returns None if the header should be ignored, i.e., it is
+// syntactically invalid, uses an unsupported unit, or contains
+// multiple ranges (RFC 7233 permits servers to ignore the header
+// and send the full representation). Returns an Error if the range
+// is unsatisfiable, which warrants a 416 response.
+Result<ByteRange> parseRangeHeader(const std::string& header, size_t size);
+
 } // namespace internal {
 
 
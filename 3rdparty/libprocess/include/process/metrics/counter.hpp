@@ -13,11 +13,15 @@
 #ifndef __PROCESS_METRICS_COUNTER_HPP__
 #define __PROCESS_METRICS_COUNTER_HPP__
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <string>
 
 #include <process/metrics/metric.hpp>
 
+#include <stout/foreach.hpp>
+
 namespace process {
 namespace metrics {
 
@@ -33,19 +37,21 @@ public:
     : Metric(name, window),
       data(new Data())
   {
-    push(static_cast<double>(data->value.load()));
+    push(static_cast<double>(data->total()));
   }
 
   ~Counter() override {}
 
   Future<double> value() const override
   {
-    return static_cast<double>(data->value.load());
+    return static_cast<double>(data->total());
   }
 
   void reset()
   {
-    data->value.store(0);
+    foreach (Data::Cell& cell, data->cells) {
+      cell.value.store(0);
+    }
     push(0);
   }
 
@@ -63,17 +69,55 @@ public:
 
   Counter& operator+=(int64_t v)
   {
-    int64_t prev = data->value.fetch_add(v);
-    push(static_cast<double>(prev + v));
+    data->cell().fetch_add(v);
+
+    // Computing the aggregate requires reading all of the cells, so
+    // only bother if we are actually retaining a history of values.
+    if (hasHistory()) {
+      push(static_cast<double>(data->total()));
+    }
+
     return *this;
   }
 
 private:
   struct Data
   {
-    explicit Data() : value(0) {}
-
-    std::atomic<int64_t> value;
+    // The value is sharded across multiple cache lines so that
+    // concurrent increments from different worker threads (e.g., a
+    // heavily instrumented hot path) don't all contend on the same
+    // one. Reads sum over the cells; each cell is monotonic (modulo
+    // `reset()`) so a single reader always observes non-decreasing
+    // totals.
+    static constexpr size_t CELLS = 8;
+
+    struct alignas(64) Cell
+    {
+      Cell() : value(0) {}
+
+      std::atomic<int64_t> value;
+    };
+
+    explicit Data() {}
+
+    // Returns the calling thread's cell.
+    std::atomic<int64_t>& cell()
+    {
+      static std::atomic<size_t> counter(0);
+      static thread_local size_t id = counter.fetch_add(1);
+      return cells[id % CELLS].value;
+    }
+
+    int64_t total() const
+    {
+      int64_t total = 0;
+      foreach (const Cell& cell, cells) {
+        total += cell.value.load();
+      }
+      return total;
+    }
+
+    std::array<Cell, CELLS> cells;
   };
 
   std::shared_ptr<Data> data;
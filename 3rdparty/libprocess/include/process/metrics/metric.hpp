@@ -59,6 +59,15 @@ protected:
   Metric(const std::string& name, const Option<Duration>& window)
     : data(new Data(name, window)) {}
 
+  // Returns true if a time series of values is being retained for
+  // this metric (i.e., it was constructed with a window). Lets
+  // derived classes skip computing a value that `push()` would only
+  // throw away.
+  bool hasHistory() const
+  {
+    return data->history.isSome();
+  }
+
   // Inserts 'value' into the history for this metric.
   void push(double value) {
     if (data->history.isSome()) {
@@ -15,6 +15,7 @@
 
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <process/dispatch.hpp>
@@ -22,6 +23,7 @@
 #include <process/limiter.hpp>
 #include <process/owned.hpp>
 #include <process/process.hpp>
+#include <process/time.hpp>
 
 #include <process/metrics/metric.hpp>
 
@@ -49,12 +51,15 @@ protected:
 
 private:
   static std::string help();
+  static std::string prometheusHelp();
 
   MetricsProcess(
       const Option<Owned<RateLimiter>>& _limiter,
+      const Duration& _cacheTtl,
       const Option<std::string>& _authenticationRealm)
     : ProcessBase("metrics"),
       limiter(_limiter),
+      cacheTtl(_cacheTtl),
       authenticationRealm(_authenticationRealm)
   {}
 
@@ -66,6 +71,10 @@ private:
       const http::Request& request,
       const Option<http::authentication::Principal>&);
 
+  Future<http::Response> _prometheus(
+      const http::Request& request,
+      const Option<http::authentication::Principal>&);
+
   // TODO(bmahler): Make this static once we can move
   // capture with C++14.
   Future<std::map<std::string, double>> __snapshot(
@@ -80,6 +89,18 @@ private:
   // Used to rate limit the snapshot endpoint.
   Option<Owned<RateLimiter>> limiter;
 
+  // Freshness window during which a completed snapshot is served
+  // without re-evaluating the gauges; zero disables caching.
+  const Duration cacheTtl;
+
+  // The most recently completed snapshot and the time it was taken.
+  Option<std::pair<Time, std::map<std::string, double>>> cache;
+
+  // The in-flight gauge collection, if any, used to coalesce
+  // concurrent scrapes onto a single fan-out.
+  Option<Future<std::map<std::string, double>>> outstanding;
+  Option<Duration> outstandingTimeout;
+
   // The authentication realm that metrics HTTP endpoints are installed into.
   const Option<std::string> authenticationRealm;
 };
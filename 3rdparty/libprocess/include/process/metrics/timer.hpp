@@ -87,6 +87,21 @@ public:
     return t;
   }
 
+  // Record an externally measured duration. This allows using a
+  // single Timer for overlapping intervals, which `start()`/`stop()`
+  // cannot express.
+  void update(const T& duration)
+  {
+    double value = 0.0;
+
+    synchronized (data->lock) {
+      data->lastValue = duration.value();
+      value = data->lastValue.get();
+    }
+
+    push(value);
+  }
+
   // Time an asynchronous event.
   template <typename U>
   Future<U> time(const Future<U>& future)
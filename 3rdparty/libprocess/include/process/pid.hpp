@@ -127,6 +127,24 @@ struct UPID
       return *this;
     }
 
+    bool operator==(const ID& that) const
+    {
+      // Interned ids (e.g., those coming out of the parse cache in
+      // pid.cpp) share their underlying string, in which case a
+      // pointer comparison suffices.
+      if (id == that.id) {
+        return true;
+      }
+
+      return static_cast<const std::string&>(*this) ==
+             static_cast<const std::string&>(that);
+    }
+
+    bool operator!=(const ID& that) const
+    {
+      return !(*this == that);
+    }
+
     bool operator==(const std::string& that) const
     {
       if (!id) {
@@ -18,6 +18,7 @@
 #include <memory>
 #include <map>
 #include <queue>
+#include <set>
 #include <vector>
 
 #include <process/address.hpp>
@@ -45,6 +46,7 @@ class EventQueue;
 class Gate;
 class Logging;
 class Sequence;
+struct ProcessProfile;
 
 namespace firewall {
 
@@ -144,6 +146,21 @@ protected:
       const char* data = nullptr,
       size_t length = 0);
 
+  /**
+   * Sends the message to each of the specified `UPID`s. The data is
+   * serialized and encoded only once: all remote destinations share
+   * a single refcounted copy of the message body rather than each
+   * getting their own, making this the preferred way to broadcast
+   * a (potentially large) message to many peers.
+   *
+   * @see process::Message
+   */
+  void send(
+      const std::set<UPID>& to,
+      const std::string& name,
+      const char* data = nullptr,
+      size_t length = 0);
+
   void send(
       const UPID& to,
       std::string&& name);
@@ -444,6 +461,12 @@ private:
     Option<std::string> realm;
     Option<AuthenticatedHttpRequestHandler> authenticatedHandler;
     RouteOptions options;
+
+    // The path under which authorization callbacks for this
+    // endpoint are looked up (i.e., "/<process id>/<route>"),
+    // precomputed at registration time so that serving a request
+    // doesn't have to construct it.
+    std::string authorizationPath;
   };
 
   // Handlers for messages and HTTP requests.
@@ -481,6 +504,13 @@ private:
   // a pointer so we can hide the implementation of `EventQueue`.
   std::unique_ptr<EventQueue> events;
 
+  // Sampled enqueue-to-execute latency and queue depth histograms,
+  // only allocated when event latency sampling is enabled (see
+  // `LIBPROCESS_EVENT_LATENCY_SAMPLING` in process.cpp). As with
+  // `EventQueue` we employ the PIMPL idiom here to hide the
+  // implementation.
+  std::unique_ptr<ProcessProfile> profile;
+
   // NOTE: this is a shared pointer to a _pointer_, hence this is not
   // responsible for the ProcessBase itself.
   std::shared_ptr<ProcessBase*> reference;
@@ -26,7 +26,8 @@ class Profiler : public Process<Profiler>
 public:
   Profiler(const Option<std::string>& _authenticationRealm)
     : ProcessBase("profiler"),
-      authenticationRealm(_authenticationRealm) {}
+      authenticationRealm(_authenticationRealm),
+      started(false) {}
 
   ~Profiler() override {}
 
@@ -42,11 +43,17 @@ protected:
           authenticationRealm,
           STOP_HELP(),
           &Profiler::stop);
+
+    route("/download",
+          authenticationRealm,
+          DOWNLOAD_HELP(),
+          &Profiler::download);
   }
 
 private:
   static const std::string START_HELP();
   static const std::string STOP_HELP();
+  static const std::string DOWNLOAD_HELP();
 
   // HTTP endpoints.
 
@@ -62,9 +69,23 @@ private:
       const http::Request& request,
       const Option<http::authentication::Principal>&);
 
+  // Returns the profile collected by the last completed run, in the
+  // pprof format understood by `pprof` / `google-pprof`. This allows
+  // fetching a profile again after `/stop` has been accessed.
+  Future<http::Response> download(
+      const http::Request& request,
+      const Option<http::authentication::Principal>&);
+
   // The authentication realm that the profiler's HTTP endpoints will be
   // installed into.
   Option<std::string> authenticationRealm;
+
+  // Whether a profiling run is currently in progress.
+  bool started;
+
+  // Absolute path of the profile dumped by the last completed run,
+  // if any.
+  Option<std::string> profilePath;
 };
 
 } // namespace process {
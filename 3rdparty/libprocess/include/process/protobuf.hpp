@@ -19,8 +19,10 @@
 #include <google/protobuf/message.h>
 #include <google/protobuf/repeated_field.h>
 
+#include <atomic>
 #include <iterator>
 #include <set>
+#include <type_traits>
 #include <vector>
 
 #include <process/defer.hpp>
@@ -28,8 +30,11 @@
 #include <process/id.hpp>
 #include <process/process.hpp>
 
+#include <stout/duration.hpp>
 #include <stout/hashmap.hpp>
 #include <stout/lambda.hpp>
+#include <stout/stopwatch.hpp>
+#include <stout/synchronized.hpp>
 
 
 // Provides an implementation of process::post that for a protobuf.
@@ -53,6 +58,63 @@ inline void post(const process::UPID& from,
   post(from, to, message.GetTypeName(), data.data(), data.size());
 }
 
+
+// A sampling census of the protobuf messages received by all
+// ProtobufProcess instances, aggregated by message type. Every
+// `SAMPLE_INTERVAL`-th received message has its wire size and parse
+// time recorded, so the fast path costs a single relaxed atomic
+// increment; consumers should scale the sampled figures by the
+// interval to estimate totals.
+class MessageCensus
+{
+public:
+  struct Stats
+  {
+    uint64_t count = 0;                 // Number of sampled messages.
+    uint64_t bytes = 0;                 // Wire bytes of sampled messages.
+    Duration parse = Duration::zero();  // Cumulative sampled parse time.
+  };
+
+  static constexpr unsigned int SAMPLE_INTERVAL = 16;
+
+  static MessageCensus* instance()
+  {
+    static MessageCensus* census = new MessageCensus();
+    return census;
+  }
+
+  // Returns whether the caller should measure and record this message.
+  bool sample()
+  {
+    return received.fetch_add(1, std::memory_order_relaxed) %
+           SAMPLE_INTERVAL == 0;
+  }
+
+  void record(const std::string& name, size_t bytes, const Duration& parseTime)
+  {
+    synchronized (lock) {
+      Stats& stats = statistics[name];
+      stats.count++;
+      stats.bytes += bytes;
+      stats.parse += parseTime;
+    }
+  }
+
+  hashmap<std::string, Stats> snapshot()
+  {
+    synchronized (lock) {
+      return statistics;
+    }
+  }
+
+private:
+  MessageCensus() : received(0) {}
+
+  std::atomic<uint64_t> received;
+  std::atomic_flag lock = ATOMIC_FLAG_INIT;
+  hashmap<std::string, Stats> statistics;
+};
+
 } // namespace process {
 
 
@@ -92,6 +154,15 @@ std::vector<T> convert(google::protobuf::RepeatedPtrField<T>&& items)
       std::make_move_iterator(items.end()));
 }
 
+
+template <typename T,
+          typename std::enable_if<
+              !std::is_lvalue_reference<T>::value, int>::type = 0>
+T convert(T&& t)
+{
+  return std::move(t);
+}
+
 } // namespace protobuf {
 } // namespace google {
 
@@ -105,10 +176,10 @@ public:
 protected:
   void consume(process::MessageEvent&& event) override
   {
-    if (protobufHandlers.count(event.message.name) > 0) {
+    auto handler = protobufHandlers.find(event.message.name);
+    if (handler != protobufHandlers.end()) {
       from = event.message.from; // For 'reply'.
-      protobufHandlers[event.message.name](
-          event.message.from, event.message.body);
+      handler->second(event.message.from, event.message.body);
       from = process::UPID();
     } else {
       process::Process<T>::consume(std::move(event));
@@ -159,6 +230,14 @@ protected:
   template <typename M, typename P>
   using MessageProperty = P(M::*)() const;
 
+  // A mutable property of a message (e.g.,
+  // `&StatusUpdateMessage::mutable_update`). Installing a handler
+  // with mutable properties moves the fields out of the parsed
+  // message rather than copying them into the handler call, which
+  // avoids a copy per message for submessage arguments.
+  template <typename M, typename P>
+  using MutableMessageProperty = P* (M::*)();
+
   template <typename M>
   void install(void (T::*method)(const process::UPID&))
   {
@@ -191,6 +270,26 @@ protected:
     delete m;
   }
 
+  template <typename M,
+            typename ...P, typename ...PC>
+  void install(
+      void (T::*method)(const process::UPID&, PC...),
+      MutableMessageProperty<M, P>... param)
+  {
+    google::protobuf::Message* m = new M();
+    T* t = static_cast<T*>(this);
+    protobufHandlers[m->GetTypeName()] =
+      lambda::bind(static_cast<void(&)(
+                       T*,
+                       void (T::*)(const process::UPID&, PC...),
+                       const process::UPID&,
+                       const std::string&,
+                       MutableMessageProperty<M, P>...)>(handlerMutN),
+                   t, method,
+                   lambda::_1, lambda::_2, param...);
+    delete m;
+  }
+
   // Installs that do not take the sender.
   template <typename M>
   void install(void (T::*method)(const M&))
@@ -248,9 +347,47 @@ protected:
     delete m;
   }
 
+  template <typename M,
+            typename ...P, typename ...PC>
+  void install(
+      void (T::*method)(PC...),
+      MutableMessageProperty<M, P>... param)
+  {
+    google::protobuf::Message* m = new M();
+    T* t = static_cast<T*>(this);
+    protobufHandlers[m->GetTypeName()] =
+      lambda::bind(static_cast<void(&)(
+                       T*,
+                       void (T::*)(PC...),
+                       const process::UPID&,
+                       const std::string&,
+                       MutableMessageProperty<M, P>...)>(_handlerMutN),
+                   t, method,
+                   lambda::_1, lambda::_2, param...);
+    delete m;
+  }
+
   using process::Process<T>::install;
 
 private:
+  // Parses a message, contributing the wire size and parse time to
+  // the census when this message is sampled.
+  template <typename M>
+  static void parse(M* m, const std::string& data)
+  {
+    if (process::MessageCensus::instance()->sample()) {
+      Stopwatch watch;
+      watch.start();
+
+      m->ParseFromString(data);
+
+      process::MessageCensus::instance()->record(
+          m->GetTypeName(), data.size(), watch.elapsed());
+    } else {
+      m->ParseFromString(data);
+    }
+  }
+
   // Handlers that take the sender as the first argument.
   template <typename M>
   static void handlerM(
@@ -261,7 +398,7 @@ private:
   {
     google::protobuf::Arena arena;
     M* m = CHECK_NOTNULL(google::protobuf::Arena::CreateMessage<M>(&arena));
-    m->ParseFromString(data);
+    parse(m, data);
 
     if (m->IsInitialized()) {
       (t->*method)(sender, *m);
@@ -279,7 +416,7 @@ private:
       const std::string& data)
   {
     M m;
-    m.ParseFromString(data);
+    parse(&m, data);
 
     if (m.IsInitialized()) {
       (t->*method)(sender, std::move(m));
@@ -309,7 +446,7 @@ private:
   {
     google::protobuf::Arena arena;
     M* m = CHECK_NOTNULL(google::protobuf::Arena::CreateMessage<M>(&arena));
-    m->ParseFromString(data);
+    parse(m, data);
 
     if (m->IsInitialized()) {
       (t->*method)(sender, google::protobuf::convert((m->*p)())...);
@@ -319,6 +456,28 @@ private:
     }
   }
 
+  template <typename M,
+            typename ...P, typename ...PC>
+  static void handlerMutN(
+      T* t,
+      void (T::*method)(const process::UPID&, PC...),
+      const process::UPID& sender,
+      const std::string& data,
+      MutableMessageProperty<M, P>... p)
+  {
+    // NOTE: we don't use an arena here (like `handlerMutM`) because
+    // we move the fields out of the message.
+    M m;
+    parse(&m, data);
+
+    if (m.IsInitialized()) {
+      (t->*method)(sender, google::protobuf::convert(std::move(*(m.*p)()))...);
+    } else {
+      LOG(WARNING) << "Initialization errors: "
+                   << m.InitializationErrorString();
+    }
+  }
+
   // Handlers that ignore the sender.
   template <typename M>
   static void _handlerM(
@@ -329,7 +488,7 @@ private:
   {
     google::protobuf::Arena arena;
     M* m = CHECK_NOTNULL(google::protobuf::Arena::CreateMessage<M>(&arena));
-    m->ParseFromString(data);
+    parse(m, data);
 
     if (m->IsInitialized()) {
       (t->*method)(*m);
@@ -347,7 +506,7 @@ private:
       const std::string& data)
   {
     M m;
-    m.ParseFromString(data);
+    parse(&m, data);
 
     if (m.IsInitialized()) {
       (t->*method)(std::move(m));
@@ -377,7 +536,7 @@ private:
   {
     google::protobuf::Arena arena;
     M* m = CHECK_NOTNULL(google::protobuf::Arena::CreateMessage<M>(&arena));
-    m->ParseFromString(data);
+    parse(m, data);
 
     if (m->IsInitialized()) {
       (t->*method)(google::protobuf::convert((m->*p)())...);
@@ -387,6 +546,28 @@ private:
     }
   }
 
+  template <typename M,
+            typename ...P, typename ...PC>
+  static void _handlerMutN(
+      T* t,
+      void (T::*method)(PC...),
+      const process::UPID&,
+      const std::string& data,
+      MutableMessageProperty<M, P>... p)
+  {
+    // NOTE: we don't use an arena here (like `_handlerMutM`) because
+    // we move the fields out of the message.
+    M m;
+    parse(&m, data);
+
+    if (m.IsInitialized()) {
+      (t->*method)(google::protobuf::convert(std::move(*(m.*p)()))...);
+    } else {
+      LOG(WARNING) << "Initialization errors: "
+                   << m.InitializationErrorString();
+    }
+  }
+
   typedef lambda::function<
       void(const process::UPID&, const std::string&)> handler;
   hashmap<std::string, handler> protobufHandlers;
@@ -50,6 +50,8 @@ public:
   bool enable_tls_v1_0;
   bool enable_tls_v1_1;
   bool enable_tls_v1_2;
+  bool session_resumption;
+  unsigned int session_cache_size;
 };
 
 
@@ -16,6 +16,7 @@
 #include <map>
 #include <mutex>
 #include <set>
+#include <utility>
 
 #include <process/clock.hpp>
 #include <process/pid.hpp>
@@ -34,15 +35,19 @@
 
 using std::list;
 using std::map;
+using std::multimap;
 using std::recursive_mutex;
 using std::set;
 
 namespace process {
 
-// We store the timers in a map of lists indexed by the timeout of the
+// We store the timers in a multimap indexed by the timeout of the
 // timer so that we can have two timers that have the same timeout. We
-// exploit that the map is SORTED!
-static map<Time, list<Timer>>* timers = new map<Time, list<Timer>>();
+// exploit that the multimap is SORTED! Note that an ordered container
+// is load bearing here: determining the next "tick" as well as the
+// paused clock semantics (Clock::advance, Clock::settled) rely on
+// cheaply finding the earliest pending timer.
+static multimap<Time, Timer>* timers = new multimap<Time, Timer>();
 static recursive_mutex* timers_mutex = new recursive_mutex();
 
 
@@ -85,7 +90,7 @@ set<Time>* ticks = new set<Time>();
 //
 // TODO(benh): Create a generic 'Timers' abstraction which hides this
 // and more away (i.e., all manipulations of 'timers' below).
-Option<Time> next(const map<Time, list<Timer>>& timers)
+Option<Time> next(const multimap<Time, Timer>& timers)
 {
   if (!timers.empty()) {
     Time first = timers.begin()->first;
@@ -116,7 +121,7 @@ void tick(const Time& time);
 // a 'synchronized' block.
 // TODO(bmahler): Consider taking an optional 'now' to avoid
 // excessive syscalls via Clock::now(nullptr).
-void scheduleTick(const map<Time, list<Timer>>& timers, set<Time>* ticks)
+void scheduleTick(const multimap<Time, Timer>& timers, set<Time>* ticks)
 {
   // Determine when the next 'tick' should fire.
   const Option<Time> next = clock::next(timers);
@@ -151,12 +156,12 @@ void tick(const Time& time)
 
     VLOG(3) << "Handling timers up to " << now;
 
-    foreachkey (const Time& timeout, *timers) {
-      if (timeout > now) {
-        break;
-      }
+    multimap<Time, Timer>::iterator upper = timers->upper_bound(now);
 
-      VLOG(3) << "Have timeout(s) at " << timeout;
+    for (multimap<Time, Timer>::iterator iterator = timers->begin();
+         iterator != upper;
+         ++iterator) {
+      VLOG(3) << "Have timeout(s) at " << iterator->first;
 
       // Need to toggle 'settling' so that we don't prematurely say
       // we're settled until after the timers are executed below,
@@ -165,11 +170,11 @@ void tick(const Time& time)
         clock::settling = true;
       }
 
-      timedout.splice(timedout.end(), (*timers)[timeout]);
+      timedout.push_back(std::move(iterator->second));
     }
 
     // Now erase the range of timers that timed out.
-    timers->erase(timers->begin(), timers->upper_bound(now));
+    timers->erase(timers->begin(), upper);
 
     // Okay, so the timeout for the next timer should not have fired.
     CHECK(timers->empty() || (timers->begin()->first > now));
@@ -281,17 +286,16 @@ Timer Clock::timer(
 
   // Add the timer.
   synchronized (timers_mutex) {
-    if (timers->size() == 0 ||
-        timer.timeout().time() < timers->begin()->first) {
-      // Need to interrupt the loop to update/set timer repeat.
-      (*timers)[timer.timeout().time()].push_back(timer);
+    // We may need to interrupt the event loop if this timer is
+    // earlier than all currently pending timers.
+    bool schedule =
+      timers->empty() || timer.timeout().time() < timers->begin()->first;
 
+    timers->emplace(timer.timeout().time(), timer);
+
+    if (schedule) {
       // Schedule another "tick" if necessary.
       clock::scheduleTick(*timers, clock::ticks);
-    } else {
-      // Timer repeat is adequate, just add the timeout.
-      CHECK(timers->size() >= 1);
-      (*timers)[timer.timeout().time()].push_back(timer);
     }
   }
 
@@ -303,15 +307,19 @@ bool Clock::cancel(const Timer& timer)
 {
   bool canceled = false;
   synchronized (timers_mutex) {
-    // Check if the timeout is still pending, and if so, erase it. In
-    // addition, erase an empty list if we just removed the last
-    // timeout.
-    Time time = timer.timeout().time();
-    if (timers->count(time) > 0) {
-      canceled = true;
-      (*timers)[time].remove(timer);
-      if ((*timers)[time].empty()) {
-        timers->erase(time);
+    // Check if this exact timer is still pending, and if so, erase
+    // it. Note that multiple timers may share the timeout so we
+    // compare the timers themselves (i.e., their ids).
+    std::pair<multimap<Time, Timer>::iterator, multimap<Time, Timer>::iterator>
+      range = timers->equal_range(timer.timeout().time());
+
+    for (multimap<Time, Timer>::iterator iterator = range.first;
+         iterator != range.second;
+         ++iterator) {
+      if (iterator->second == timer) {
+        timers->erase(iterator);
+        canceled = true;
+        break;
       }
     }
   }
@@ -611,6 +611,7 @@ private:
     decoder->response = new http::Response();
     decoder->response->type = http::Response::PIPE;
     decoder->writer = None();
+    decoder->decompressor.reset();
 
     return http_parsing::SUCCESS;
   }
@@ -695,12 +696,12 @@ private:
       return http_parsing::FAILURE;
     }
 
-    // We cannot provide streaming gzip decompression!
     Option<std::string> encoding =
       decoder->response->headers.get("Content-Encoding");
+
     if (encoding.isSome() && encoding.get() == "gzip") {
-      decoder->failure = true;
-      return http_parsing::FAILURE;
+      decoder->decompressor =
+        Owned<gzip::Decompressor>(new gzip::Decompressor());
     }
 
     CHECK_NONE(decoder->writer);
@@ -729,7 +730,23 @@ private:
     CHECK_SOME(decoder->writer);
 
     http::Pipe::Writer writer = decoder->writer.get(); // Remove const.
-    writer.write(std::string(data, length));
+
+    std::string body;
+    if (decoder->decompressor.get() != nullptr) {
+      Try<std::string> decompressed =
+        decoder->decompressor->decompress(std::string(data, length));
+
+      if (decompressed.isError()) {
+        decoder->failure = true;
+        return http_parsing::FAILURE;
+      }
+
+      body = std::move(decompressed.get());
+    } else {
+      body = std::string(data, length);
+    }
+
+    writer.write(std::move(body));
 
     return http_parsing::SUCCESS;
   }
@@ -746,6 +763,14 @@ private:
     }
 
     http::Pipe::Writer writer = decoder->writer.get(); // Remove const.
+
+    if (decoder->decompressor.get() != nullptr &&
+        !decoder->decompressor->finished()) {
+      writer.fail("Failed to decompress body");
+      decoder->failure = true;
+      return http_parsing::FAILURE;
+    }
+
     writer.close();
 
     decoder->writer = None();
@@ -769,6 +794,7 @@ private:
 
   http::Response* response;
   Option<http::Pipe::Writer> writer;
+  Owned<gzip::Decompressor> decompressor;
 
   std::deque<http::Response*> responses;
 };
@@ -16,9 +16,12 @@
 #include <stdint.h>
 #include <time.h>
 
+#include <algorithm>
 #include <limits>
 #include <map>
+#include <memory>
 #include <sstream>
+#include <vector>
 
 #include <process/http.hpp>
 #include <process/process.hpp>
@@ -27,6 +30,7 @@
 #include <stout/gzip.hpp>
 #include <stout/hashmap.hpp>
 #include <stout/numify.hpp>
+#include <stout/option.hpp>
 #include <stout/os.hpp>
 
 
@@ -34,6 +38,13 @@ namespace process {
 
 const uint32_t GZIP_MINIMUM_BODY_LENGTH = 1024;
 
+// Bodies at least this large are kept as their own buffer when
+// encoding rather than getting copied into the header stream.
+// Smaller bodies are flattened into a single buffer so that a
+// typical message or response still goes out with one send() call
+// instead of one per chunk.
+const size_t UNCOPIED_MINIMUM_BODY_LENGTH = 64 * 1024;
+
 
 class Encoder
 {
@@ -56,14 +67,40 @@ public:
 };
 
 
+// Encodes a sequence of buffers which get sent back-to-back on a
+// socket. Accepting multiple buffers lets callers hand over, say,
+// HTTP headers and an already materialized body without having to
+// first assemble them into one contiguous string (an extra full copy
+// of the body, which for responses like the master's /state can be
+// hundreds of megabytes). The buffers are immutable and refcounted
+// so that the same payload can be queued on many sockets (e.g., when
+// broadcasting a message to all of a network's members) without
+// getting copied once per peer.
 class DataEncoder : public Encoder
 {
 public:
   DataEncoder(const std::string& _data)
-    : data(_data), index(0) {}
+    : index(0), offset(0)
+  {
+    chunks.push_back(std::make_shared<const std::string>(_data));
+  }
 
   DataEncoder(std::string&& _data)
-    : data(std::move(_data)), index(0) {}
+    : index(0), offset(0)
+  {
+    chunks.push_back(std::make_shared<const std::string>(std::move(_data)));
+  }
+
+  DataEncoder(std::vector<std::string>&& _chunks)
+    : index(0), offset(0)
+  {
+    foreach (std::string& chunk, _chunks) {
+      chunks.push_back(std::make_shared<const std::string>(std::move(chunk)));
+    }
+  }
+
+  DataEncoder(std::vector<std::shared_ptr<const std::string>>&& _chunks)
+    : chunks(std::move(_chunks)), index(0), offset(0) {}
 
   ~DataEncoder() override {}
 
@@ -72,29 +109,59 @@ public:
     return Encoder::DATA;
   }
 
+  // Returns a pointer to the next chunk of data and marks it as
+  // consumed. Callers must invoke `backup()` with however much of the
+  // chunk did not actually get sent, and must not call `next()` once
+  // `remaining()` returns zero.
   virtual const char* next(size_t* length)
   {
-    size_t temp = index;
-    index = data.size();
-    *length = data.size() - temp;
-    return data.data() + temp;
+    // Skip anything already consumed as well as any empty chunks.
+    while (index < chunks.size() && offset == chunks[index]->size()) {
+      index++;
+      offset = 0;
+    }
+
+    if (index == chunks.size()) {
+      *length = 0;
+      return nullptr;
+    }
+
+    const char* data = chunks[index]->data() + offset;
+    *length = chunks[index]->size() - offset;
+    offset = chunks[index]->size();
+    return data;
   }
 
   void backup(size_t length) override
   {
-    if (index >= length) {
-      index -= length;
+    while (length > 0) {
+      if (offset == 0) {
+        if (index == 0) {
+          break;
+        }
+        index--;
+        offset = chunks[index]->size();
+        continue;
+      }
+      size_t size = std::min(length, offset);
+      offset -= size;
+      length -= size;
     }
   }
 
   size_t remaining() const override
   {
-    return data.size() - index;
+    size_t size = 0;
+    for (size_t i = index; i < chunks.size(); i++) {
+      size += chunks[i]->size() - (i == index ? offset : 0);
+    }
+    return size;
   }
 
 private:
-  const std::string data;
-  size_t index;
+  std::vector<std::shared_ptr<const std::string>> chunks;
+  size_t index;  // Current chunk.
+  size_t offset; // Consumed bytes of the current chunk.
 };
 
 
@@ -102,9 +169,43 @@ class MessageEncoder : public DataEncoder
 {
 public:
   MessageEncoder(const Message& message)
-    : DataEncoder(encode(message)) {}
+    : DataEncoder(encode(
+          message,
+          std::make_shared<const std::string>(message.body))) {}
+
+  // Moves the body out of the message rather than copying it.
+  MessageEncoder(Message&& message)
+    : DataEncoder(encode(
+          message,
+          std::make_shared<const std::string>(std::move(message.body)))) {}
+
+  // Encodes the message around the given body, ignoring
+  // `message.body`. Used when the same buffer backs the encoders of
+  // multiple destinations.
+  MessageEncoder(
+      const Message& message,
+      const std::shared_ptr<const std::string>& body)
+    : DataEncoder(encode(message, body)) {}
+
+  static std::vector<std::string> encode(const Message& message)
+  {
+    std::vector<std::string> chunks;
+    foreach (const std::shared_ptr<const std::string>& chunk,
+             encode(message, std::make_shared<const std::string>(
+                 message.body))) {
+      chunks.push_back(*chunk);
+    }
+    return chunks;
+  }
 
-  static std::string encode(const Message& message)
+  // Encodes the message around the given body. Note that we take the
+  // body separately (and deliberately never look at `message.body`)
+  // so that a single refcounted buffer can back the encoders of many
+  // destinations, e.g., when broadcasting to all members of a
+  // network.
+  static std::vector<std::shared_ptr<const std::string>> encode(
+      const Message& message,
+      const std::shared_ptr<const std::string>& body)
   {
     std::ostringstream out;
 
@@ -124,18 +225,26 @@ public:
         << "Connection: Keep-Alive\r\n"
         << "Host: \r\n";
 
-    if (message.body.size() > 0) {
+    if (body->size() > 0) {
       out << "Transfer-Encoding: chunked\r\n\r\n"
-          << std::hex << message.body.size() << "\r\n";
-      out.write(message.body.data(), message.body.size());
-      out << "\r\n"
-          << "0\r\n"
-          << "\r\n";
-    } else {
-      out << "\r\n";
+          << std::hex << body->size() << "\r\n";
+
+      if (body->size() < UNCOPIED_MINIMUM_BODY_LENGTH) {
+        out.write(body->data(), body->size());
+        out << "\r\n"
+            << "0\r\n"
+            << "\r\n";
+        return {std::make_shared<const std::string>(out.str())};
+      }
+
+      return {std::make_shared<const std::string>(out.str()),
+              body,
+              std::make_shared<const std::string>("\r\n0\r\n\r\n")};
     }
 
-    return out.str();
+    out << "\r\n";
+
+    return {std::make_shared<const std::string>(out.str())};
   }
 };
 
@@ -148,7 +257,7 @@ public:
       const http::Request& request)
     : DataEncoder(encode(response, request)) {}
 
-  static std::string encode(
+  static std::vector<std::string> encode(
       const http::Response& response,
       const http::Request& request)
   {
@@ -179,19 +288,19 @@ public:
     headers["Date"] = date;
 
     // Should we compress this response?
-    std::string body = response.body;
+    Option<std::string> compressed;
 
     if (response.type == http::Response::BODY &&
         response.body.length() >= GZIP_MINIMUM_BODY_LENGTH &&
         !headers.contains("Content-Encoding") &&
         request.acceptsEncoding("gzip")) {
-      Try<std::string> compressed = gzip::compress(body);
-      if (compressed.isError()) {
-        LOG(WARNING) << "Failed to gzip response body: " << compressed.error();
+      Try<std::string> compress = gzip::compress(response.body);
+      if (compress.isError()) {
+        LOG(WARNING) << "Failed to gzip response body: " << compress.error();
       } else {
-        body = std::move(compressed.get());
+        compressed = std::move(compress.get());
 
-        headers["Content-Length"] = stringify(body.length());
+        headers["Content-Length"] = stringify(compressed->length());
         headers["Content-Encoding"] = "gzip";
       }
     }
@@ -207,25 +316,36 @@ public:
       out << "Content-Length: 0\r\n";
     } else if (response.type == http::Response::BODY &&
                !headers.contains("Content-Length")) {
-      out << "Content-Length: " << body.size() << "\r\n";
+      out << "Content-Length: "
+          << (compressed.isSome() ? compressed->size() : response.body.size())
+          << "\r\n";
     }
 
     // Use a CRLF to mark end of headers.
     out << "\r\n";
 
-    // Add the body if necessary.
+    // Add the body if necessary. Note that we return the body as its
+    // own chunk so that it doesn't get copied into the header stream.
     if (response.type == http::Response::BODY) {
-      // If the Content-Length header was supplied, only write as much data
-      // as the length specifies.
+      std::string body =
+        compressed.isSome() ? std::move(compressed.get()) : response.body;
+
+      // If the Content-Length header was supplied, only send as much
+      // data as the length specifies.
       Result<uint32_t> length = numify<uint32_t>(headers.get("Content-Length"));
       if (length.isSome() && length.get() <= body.length()) {
-        out.write(body.data(), length.get());
-      } else {
+        body.resize(length.get());
+      }
+
+      if (body.size() < UNCOPIED_MINIMUM_BODY_LENGTH) {
         out.write(body.data(), body.size());
+        return {out.str()};
       }
+
+      return {out.str(), std::move(body)};
     }
 
-    return out.str();
+    return {out.str()};
   }
 };
 
@@ -233,14 +353,17 @@ public:
 class FileEncoder : public Encoder
 {
 public:
-  FileEncoder(int_fd _fd, size_t _size)
-    : fd(_fd), size(static_cast<off_t>(_size)), index(0)
+  // Encodes `_size` bytes of the file starting at `_offset` (e.g.,
+  // for serving an HTTP range request).
+  FileEncoder(int_fd _fd, size_t _size, off_t _offset = 0)
+    : fd(_fd), size(static_cast<off_t>(_size) + _offset), index(_offset)
   {
     // NOTE: For files, we expect the size to be derived from `stat`-ing
     // the file.  The `struct stat` returns the size in `off_t` form,
     // meaning that it is a programmer error to construct the `FileEncoder`
     // with a size greater the max value of `off_t`.
     CHECK_LE(_size, static_cast<size_t>(std::numeric_limits<off_t>::max()));
+    CHECK_GE(_offset, 0);
   }
 
   ~FileEncoder() override
@@ -206,7 +206,7 @@ private:
 
   void decomission()
   {
-    comissioned.store(true);
+    comissioned.store(false);
     while (!empty()) {
       delete dequeue();
     }
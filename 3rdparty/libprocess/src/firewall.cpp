@@ -25,10 +25,62 @@ namespace firewall {
 DisabledEndpointsFirewallRule::DisabledEndpointsFirewallRule(
     const hashset<string>& _paths)
 {
+  // Root node.
+  nodes.emplace_back();
+
   foreach (const string& path, _paths) {
-    paths.insert(process::absolutePath(path));
+    const string absolute = process::absolutePath(path);
+
+    uint32_t current = 0;
+
+    foreach (char c, absolute) {
+      uint32_t next = 0;
+
+      foreach (const auto& edge, nodes[current].edges) {
+        if (edge.first == c) {
+          next = edge.second;
+          break;
+        }
+      }
+
+      if (next == 0) {
+        next = static_cast<uint32_t>(nodes.size());
+        nodes[current].edges.emplace_back(c, next);
+        nodes.emplace_back();
+      }
+
+      current = next;
+    }
+
+    nodes[current].terminal = true;
   }
 }
 
+
+bool DisabledEndpointsFirewallRule::disabled(const string& path) const
+{
+  uint32_t current = 0;
+
+  foreach (char c, path) {
+    uint32_t next = 0;
+
+    foreach (const auto& edge, nodes[current].edges) {
+      if (edge.first == c) {
+        next = edge.second;
+        break;
+      }
+    }
+
+    // No disabled endpoint starts with the path seen so far.
+    if (next == 0) {
+      return false;
+    }
+
+    current = next;
+  }
+
+  return nodes[current].terminal;
+}
+
 } // namespace firewall {
 } // namespace process {
@@ -10,15 +10,24 @@
 // See the License for the specific language governing permissions and
 // limitations under the License
 
+#include <mutex>
+#include <string>
+
 #include <process/grpc.hpp>
 
 #include <process/dispatch.hpp>
 #include <process/id.hpp>
 #include <process/process.hpp>
 
+#include <process/metrics/metrics.hpp>
+
+#include <stout/foreach.hpp>
+#include <stout/hashmap.hpp>
+#include <stout/synchronized.hpp>
 #include <stout/unreachable.hpp>
 
 using std::ostream;
+using std::string;
 
 namespace grpc {
 
@@ -73,6 +82,35 @@ namespace process {
 namespace grpc {
 namespace client {
 
+namespace internal {
+
+// Channels shared by `Connection::pooled`, keyed by endpoint URI.
+// Channels are never evicted: the pool is intended for endpoints
+// that are called repeatedly (e.g., CSI plugins), so its cardinality
+// stays small.
+static std::mutex* channels_mutex = new std::mutex();
+static hashmap<string, std::shared_ptr<::grpc::Channel>>* channels =
+  new hashmap<string, std::shared_ptr<::grpc::Channel>>();
+
+} // namespace internal {
+
+
+Connection Connection::pooled(
+    const string& uri,
+    const std::shared_ptr<::grpc::ChannelCredentials>& credentials)
+{
+  synchronized (internal::channels_mutex) {
+    if (!internal::channels->contains(uri)) {
+      internal::channels->put(uri, ::grpc::CreateChannel(uri, credentials));
+    }
+
+    return Connection(internal::channels->at(uri));
+  }
+
+  UNREACHABLE();
+}
+
+
 void Runtime::terminate()
 {
   dispatch(data->pid, &RuntimeProcess::terminate);
@@ -85,19 +123,28 @@ Future<Nothing> Runtime::wait()
 }
 
 
-Runtime::RuntimeProcess::RuntimeProcess()
-  : ProcessBase(ID::generate("__grpc_client__")), terminating(false) {}
+Runtime::RuntimeProcess::RuntimeProcess(size_t completionQueues)
+  : ProcessBase(ID::generate("__grpc_client__")),
+    queues(completionQueues),
+    position(0),
+    terminating(false),
+    call_latency(string(self().id) + "/call_latency", Minutes(1))
+{
+  CHECK_GT(completionQueues, 0u);
+}
 
 
 Runtime::RuntimeProcess::~RuntimeProcess()
 {
-  CHECK(!looper);
+  CHECK(loopers.empty());
 }
 
 
 void Runtime::RuntimeProcess::send(SendCallback callback)
 {
-  std::move(callback)(terminating, &queue);
+  // Distribute calls across the completion queues round-robin.
+  std::move(callback)(
+      terminating, &queues[position++ % queues.size()], call_latency);
 }
 
 
@@ -111,7 +158,9 @@ void Runtime::RuntimeProcess::terminate()
 {
   if (!terminating) {
     terminating = true;
-    queue.Shutdown();
+    foreach (::grpc::CompletionQueue& queue, queues) {
+      queue.Shutdown();
+    }
   }
 }
 
@@ -124,10 +173,15 @@ Future<Nothing> Runtime::RuntimeProcess::wait()
 
 void Runtime::RuntimeProcess::initialize()
 {
-  // The looper thread can only be created here since it need to happen
-  // after `queue` is initialized.
-  CHECK(!looper);
-  looper.reset(new std::thread(&RuntimeProcess::loop, this));
+  // The looper threads can only be created here since it need to happen
+  // after `queues` is initialized.
+  CHECK(loopers.empty());
+
+  foreach (::grpc::CompletionQueue& queue, queues) {
+    loopers.emplace_back(new std::thread(&RuntimeProcess::loop, this, &queue));
+  }
+
+  metrics::add(call_latency);
 }
 
 
@@ -135,21 +189,25 @@ void Runtime::RuntimeProcess::finalize()
 {
   CHECK(terminating) << "Runtime has not yet been terminated";
 
-  // NOTE: This is a blocking call. However, the thread is guaranteed
+  // NOTE: These are blocking calls. However, the threads are guaranteed
   // to be exiting, therefore the amount of blocking time should be
   // short (just like other syscalls we invoke).
-  looper->join();
-  looper.reset();
+  foreach (std::unique_ptr<std::thread>& looper, loopers) {
+    looper->join();
+  }
+
+  loopers.clear();
+  metrics::remove(call_latency);
   terminated.set(Nothing());
 }
 
 
-void Runtime::RuntimeProcess::loop()
+void Runtime::RuntimeProcess::loop(::grpc::CompletionQueue* queue)
 {
   void* tag;
   bool ok;
 
-  while (queue.Next(&tag, &ok)) {
+  while (queue->Next(&tag, &ok)) {
     // Currently only unary RPCs are supported, so `ok` should always be true.
     // See: https://grpc.io/grpc/cpp/classgrpc_1_1_completion_queue.html#a86d9810ced694e50f7987ac90b9f8c1a // NOLINT
     CHECK(ok);
@@ -161,14 +219,16 @@ void Runtime::RuntimeProcess::loop()
     delete callback;
   }
 
-  // Terminate self after all events are drained.
+  // Terminate self after all events are drained. This is idempotent,
+  // so it is safe for every looper thread to call it once its queue
+  // is drained.
   process::terminate(self(), false);
 }
 
 
-Runtime::Data::Data()
+Runtime::Data::Data(size_t completionQueues)
 {
-  RuntimeProcess* process = new RuntimeProcess();
+  RuntimeProcess* process = new RuntimeProcess(completionQueues);
   terminated = process->wait();
   pid = spawn(process, true);
 }
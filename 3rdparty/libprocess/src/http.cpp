@@ -34,6 +34,7 @@
 #include <process/after.hpp>
 #include <process/collect.hpp>
 #include <process/defer.hpp>
+#include <process/delay.hpp>
 #include <process/dispatch.hpp>
 #include <process/future.hpp>
 #include <process/http.hpp>
@@ -48,12 +49,14 @@
 
 #include <stout/error.hpp>
 #include <stout/foreach.hpp>
+#include <stout/gzip.hpp>
 #include <stout/ip.hpp>
 #include <stout/lambda.hpp>
 #include <stout/net.hpp>
 #include <stout/nothing.hpp>
 #include <stout/numify.hpp>
 #include <stout/option.hpp>
+#include <stout/result.hpp>
 #include <stout/strings.hpp>
 #include <stout/synchronized.hpp>
 #include <stout/try.hpp>
@@ -341,26 +344,43 @@ bool Request::acceptsEncoding(const string& encoding) const
 
   foreach (const string& candidate, candidates) {
     // Is the candidate one of the accepted encodings?
-    foreach (const string& encoding_, strings::tokenize(accept.get(), ",")) {
-      vector<string> tokens = strings::tokenize(encoding_, ";");
+    //
+    // NOTE: We tokenize with views since this runs when encoding
+    // each response; only the `q` parameter (if any) gets copied
+    // out for parsing.
+    foreach (const strings::View& encoding_,
+             strings::tokenizeView(accept.get(), ",")) {
+      vector<strings::View> tokens = strings::tokenizeView(encoding_, ";");
 
       if (tokens.empty()) {
         continue;
       }
 
-      if (strings::lower(tokens[0]) == strings::lower(candidate)) {
+      if (strings::lower(tokens[0].str()) == strings::lower(candidate)) {
         // Is there a 0 q value? Ex: 'gzip;q=0.0'.
-        const map<string, vector<string>> values =
-          strings::pairs(encoding_, ";", "=");
+        // We expect exactly one well formed q parameter,
+        // otherwise the encoding is acceptable.
+        Option<strings::View> q = None();
+        bool malformed = false;
+
+        for (size_t i = 1; i < tokens.size(); i++) {
+          vector<strings::View> param = strings::tokenizeView(tokens[i], "=");
+          if (param.size() == 2 && param[0] == "q") {
+            if (q.isSome()) {
+              malformed = true;
+              break;
+            }
+            q = param[1];
+          }
+        }
 
-        // Look for { "q": ["0"] }.
-        if (values.count("q") == 0 || values.find("q")->second.size() != 1) {
+        if (q.isNone() || malformed) {
           // No q value, or malformed q value.
           return true;
         }
 
         // Is the q value > 0?
-        Try<double> value = numify<double>(values.find("q")->second[0]);
+        Try<double> value = numify<double>(q->str());
         return value.isSome() && value.get() > 0;
       }
     }
@@ -412,27 +432,40 @@ bool Request::_acceptsMediaType(
   candidates.push_back("*/*");
 
   foreach (const string& candidate, candidates) {
-    foreach (const string& type, strings::tokenize(name.get(), ",")) {
-      vector<string> tokens = strings::tokenize(type, ";");
+    foreach (const strings::View& type,
+             strings::tokenizeView(name.get(), ",")) {
+      vector<strings::View> tokens = strings::tokenizeView(type, ";");
 
       if (tokens.empty()) {
         continue;
       }
 
       // Is the candidate one of the accepted type?
-      if (strings::lower(tokens[0]) == strings::lower(candidate)) {
+      if (strings::lower(tokens[0].str()) == strings::lower(candidate)) {
         // Is there a 0 q value? Ex: 'gzip;q=0.0'.
-        const map<string, vector<string>> values =
-          strings::pairs(type, ";", "=");
+        // We expect exactly one well formed q parameter,
+        // otherwise the media type is acceptable.
+        Option<strings::View> q = None();
+        bool malformed = false;
+
+        for (size_t i = 1; i < tokens.size(); i++) {
+          vector<strings::View> param = strings::tokenizeView(tokens[i], "=");
+          if (param.size() == 2 && param[0] == "q") {
+            if (q.isSome()) {
+              malformed = true;
+              break;
+            }
+            q = param[1];
+          }
+        }
 
-        // Look for { "q": ["0"] }.
-        if (values.count("q") == 0 || values.find("q")->second.size() != 1) {
+        if (q.isNone() || malformed) {
           // No q value, or malformed q value.
           return true;
         }
 
         // Is the q value > 0?
-        Try<double> value = numify<double>(values.find("q")->second[0]);
+        Try<double> value = numify<double>(q->str());
         return value.isSome() && value.get() > 0;
       }
     }
@@ -461,6 +494,7 @@ Future<string> Pipe::Reader::read()
       return Failure("closed");
     } else if (!data->writes.empty()) {
       Future<string> future = data->writes.front();
+      data->writesSize -= data->writes.front().size();
       data->writes.pop();
       return future;
     } else if (data->writeEnd == Writer::CLOSED) {
@@ -509,6 +543,7 @@ bool Pipe::Reader::close()
       while (!data->writes.empty()) {
         data->writes.pop();
       }
+      data->writesSize = 0;
 
       // Extract the pending reads so we can fail them.
       std::swap(data->reads, reads);
@@ -554,6 +589,7 @@ bool Pipe::Writer::write(string s)
       // Don't bother surfacing empty writes to the readers.
       if (!s.empty()) {
         if (data->reads.empty()) {
+          data->writesSize += s.size();
           data->writes.push(std::move(s));
         } else {
           read = data->reads.front();
@@ -633,6 +669,14 @@ Future<Nothing> Pipe::Writer::readerClosed() const
 }
 
 
+size_t Pipe::Writer::outstanding() const
+{
+  synchronized (data->lock) {
+    return data->writesSize;
+  }
+}
+
+
 namespace header {
 
 Try<WWWAuthenticate> WWWAuthenticate::create(const string& value)
@@ -1354,6 +1398,209 @@ private:
   bool close;
 };
 
+
+// How many idle keep-alive connections we retain per endpoint. Any
+// connection released beyond this limit is simply closed.
+constexpr size_t MAX_IDLE_CONNECTIONS_PER_ENDPOINT = 5;
+
+// How long an idle keep-alive connection is retained before we close
+// it. This is kept well below typical server keep-alive timeouts so
+// that we rarely hand out a connection the peer is about to close.
+constexpr Duration IDLE_CONNECTION_TIMEOUT = Seconds(15);
+
+
+// Maintains a cache of idle keep-alive connections, keyed by
+// endpoint, so that consecutive one-off `http::request` calls to the
+// same endpoint (e.g., HTTP health checks, fetcher plugins) don't pay
+// TCP (and on SSL builds, TLS handshake) setup each time.
+//
+// A connection is removed from the cache as soon as the peer closes
+// it, and is closed by us once it has been idle for
+// `IDLE_CONNECTION_TIMEOUT`.
+class ConnectionPoolProcess : public Process<ConnectionPoolProcess>
+{
+public:
+  struct Acquired
+  {
+    Connection connection;
+
+    // Whether the connection was reused from the cache (in which
+    // case the peer may have closed it while it was idle).
+    bool reused;
+  };
+
+  ConnectionPoolProcess()
+    : ProcessBase(ID::generate("__http_connection_pool__")) {}
+
+  Future<Acquired> acquire(const URL& url)
+  {
+    const string key = endpoint(url);
+
+    if (idle.contains(key)) {
+      list<IdleConnection>& connections = idle[key];
+
+      Connection connection = connections.front().connection;
+      connections.pop_front();
+
+      if (connections.empty()) {
+        idle.erase(key);
+      }
+
+      return Acquired{connection, true};
+    }
+
+    return http::connect(url)
+      .then([](const Connection& connection) {
+        return Acquired{connection, false};
+      });
+  }
+
+  void release(const URL& url, const Connection& connection)
+  {
+    const string key = endpoint(url);
+
+    list<IdleConnection>& connections = idle[key];
+
+    if (connections.size() >= MAX_IDLE_CONNECTIONS_PER_ENDPOINT) {
+      close(connection);
+      return;
+    }
+
+    int64_t sequence = next++;
+
+    connections.push_back(IdleConnection{sequence, connection});
+
+    // Drop the connection from the cache if the peer closes it
+    // while it is idle.
+    connection.disconnected()
+      .onAny(defer(self(), &Self::evict, key, sequence));
+
+    delay(
+        IDLE_CONNECTION_TIMEOUT,
+        self(),
+        &Self::expire,
+        key,
+        sequence);
+  }
+
+private:
+  struct IdleConnection
+  {
+    // Identifies one stint of a connection in the cache, so that
+    // stale evictions and expirations (e.g., after the connection
+    // got handed out again) are ignored.
+    int64_t sequence;
+
+    Connection connection;
+  };
+
+  // Returns the cache key for the given URL. Note that we key on the
+  // host as specified (rather than on the resolved address) so that
+  // the cache doesn't have to resolve anything itself.
+  static string endpoint(const URL& url)
+  {
+    return url.scheme.getOrElse("http") + "://" +
+           (url.ip.isSome() ? stringify(url.ip.get())
+                            : url.domain.getOrElse("")) +
+           ":" + stringify(url.port.getOrElse(0));
+  }
+
+  void evict(const string& key, int64_t sequence)
+  {
+    remove(key, sequence);
+  }
+
+  void expire(const string& key, int64_t sequence)
+  {
+    Option<Connection> connection = remove(key, sequence);
+
+    if (connection.isSome()) {
+      close(connection.get());
+    }
+  }
+
+  Option<Connection> remove(const string& key, int64_t sequence)
+  {
+    if (!idle.contains(key)) {
+      return None();
+    }
+
+    list<IdleConnection>& connections = idle[key];
+
+    for (auto iterator = connections.begin();
+         iterator != connections.end();
+         ++iterator) {
+      if (iterator->sequence == sequence) {
+        Connection connection = iterator->connection;
+        connections.erase(iterator);
+
+        if (connections.empty()) {
+          idle.erase(key);
+        }
+
+        return connection;
+      }
+    }
+
+    return None();
+  }
+
+  static void close(const Connection& connection)
+  {
+    // Since the `Connection` is reference-counted, we must maintain
+    // a copy until the disconnection occurs.
+    Connection connection_ = connection;
+    connection_.disconnect();
+    connection.disconnected().onAny([connection]() {});
+  }
+
+  // NOTE: We use a `list` since `Connection` (which holds const
+  // members) is not assignable, which `deque` erasure requires.
+  hashmap<string, list<IdleConnection>> idle;
+
+  int64_t next = 0;
+};
+
+
+// Returns the global connection pool, spawning it on first use.
+static PID<ConnectionPoolProcess> pool()
+{
+  static PID<ConnectionPoolProcess> pid =
+    spawn(new ConnectionPoolProcess(), true);
+  return pid;
+}
+
+
+// Sends the request over the given connection and, once the response
+// has been received, either returns the connection to the pool for
+// reuse or closes it.
+Future<Response> exchange(
+    const PID<ConnectionPoolProcess>& pool,
+    const Connection& connection,
+    const Request& request)
+{
+  Connection connection_ = connection;
+  Future<Response> response = connection_.send(request, false);
+
+  const URL url = request.url;
+
+  response
+    .onAny([=](const Future<Response>& response) {
+      // Only return the connection for reuse if the exchange
+      // left it open.
+      if (response.isReady() &&
+          response->headers.get("Connection").getOrElse("") != "close") {
+        dispatch(pool, &ConnectionPoolProcess::release, url, connection);
+      } else {
+        Connection connection_ = connection;
+        connection_.disconnect();
+        connection.disconnected().onAny([connection]() {});
+      }
+    });
+
+  return response;
+}
+
 } // namespace internal {
 
 
@@ -1415,7 +1662,7 @@ Future<Nothing> Connection::disconnect()
 }
 
 
-Future<Nothing> Connection::disconnected()
+Future<Nothing> Connection::disconnected() const
 {
   return dispatch(
       data->process,
@@ -1559,6 +1806,72 @@ Future<Nothing> send(
 }
 
 
+Result<ByteRange> parseRangeHeader(const string& header, size_t size)
+{
+  if (!strings::startsWith(header, "bytes=")) {
+    return None(); // Unsupported range unit.
+  }
+
+  const string spec = strings::trim(header.substr(strlen("bytes=")));
+
+  if (spec.empty() || strings::contains(spec, ",")) {
+    return None(); // Multiple (or no) ranges are not supported.
+  }
+
+  size_t dash = spec.find('-');
+  if (dash == string::npos) {
+    return None();
+  }
+
+  const string first = strings::trim(spec.substr(0, dash));
+  const string last = strings::trim(spec.substr(dash + 1));
+
+  ByteRange range;
+
+  if (first.empty()) {
+    // Suffix form: the last 'last' bytes of the file.
+    Try<size_t> suffix = numify<size_t>(last);
+    if (suffix.isError()) {
+      return None();
+    }
+
+    if (suffix.get() == 0 || size == 0) {
+      return Error("Empty suffix range");
+    }
+
+    range.length = std::min(suffix.get(), size);
+    range.offset = static_cast<off_t>(size - range.length);
+
+    return range;
+  }
+
+  Try<size_t> start = numify<size_t>(first);
+  if (start.isError()) {
+    return None();
+  }
+
+  if (start.get() >= size) {
+    return Error("Range starts beyond the end of the file");
+  }
+
+  size_t end = size - 1;
+
+  if (!last.empty()) {
+    Try<size_t> end_ = numify<size_t>(last);
+    if (end_.isError() || end_.get() < start.get()) {
+      return None();
+    }
+
+    end = std::min(end_.get(), size - 1);
+  }
+
+  range.offset = static_cast<off_t>(start.get());
+  range.length = end - start.get() + 1;
+
+  return range;
+}
+
+
 Future<Nothing> sendfile(
     network::Socket socket,
     Response response,
@@ -1598,9 +1911,43 @@ Future<Nothing> sendfile(
     return send(socket, InternalServerError(body), request);
   }
 
+  // Serve a subset of the file if the client sent a satisfiable
+  // 'Range' header. Only single byte ranges are supported; any
+  // 'Range' header we cannot honor is ignored and the full file
+  // is sent instead (which RFC 7233 permits).
+  off_t offset = 0;
+  size_t length = size->bytes();
+
+  response.headers["Accept-Ranges"] = "bytes";
+
+  Option<string> range = request->headers.get("Range");
+
+  if (range.isSome() && response.code == Status::OK) {
+    Result<ByteRange> parsed = parseRangeHeader(range.get(), size->bytes());
+
+    if (parsed.isError()) {
+      Response unsatisfiable = Response(
+          Status::REQUESTED_RANGE_NOT_SATISFIABLE);
+      unsatisfiable.headers["Content-Range"] =
+        "bytes */" + stringify(size->bytes());
+
+      os::close(fd.get());
+      return send(socket, unsatisfiable, request);
+    } else if (parsed.isSome()) {
+      offset = parsed->offset;
+      length = parsed->length;
+
+      response.code = Status::PARTIAL_CONTENT;
+      response.status = Status::string(response.code);
+      response.headers["Content-Range"] =
+        "bytes " + stringify(offset) + "-" +
+        stringify(offset + length - 1) + "/" + stringify(size->bytes());
+    }
+  }
+
   // While the user is expected to properly set a 'Content-Type'
   // header, we'll fill in (or overwrite) 'Content-Length' header.
-  response.headers["Content-Length"] = stringify(size->bytes());
+  response.headers["Content-Length"] = stringify(length);
 
   // TODO(benh): If this is a TCP socket consider turning on TCP_CORK
   // for both sends and then turning it off.
@@ -1617,7 +1964,7 @@ Future<Nothing> sendfile(
     })
     .then([=]() mutable -> Future<Nothing> {
       // NOTE: the file descriptor gets closed by FileEncoder.
-      Encoder* encoder = new FileEncoder(fd.get(), size->bytes());
+      Encoder* encoder = new FileEncoder(fd.get(), length, offset);
       return send(socket, encoder)
         .onAny([=]() {
           delete encoder;
@@ -1628,26 +1975,42 @@ Future<Nothing> sendfile(
 
 Future<Nothing> stream(
     const network::Socket& socket,
-    http::Pipe::Reader reader)
+    http::Pipe::Reader reader,
+    const Option<Owned<gzip::Compressor>>& compressor)
 {
   return loop(
       None(),
       [=]() mutable {
         return reader.read();
       },
-      [=](const string& data) mutable {
-        bool finished = false;
+      [=](const string& data) mutable -> Future<ControlFlow<Nothing>> {
+        bool finished = data.empty(); // An empty read signals the end.
+
+        string payload = data;
+
+        if (compressor.isSome()) {
+          Try<string> compressed = finished
+            ? compressor.get()->finish()
+            : compressor.get()->compress(data);
+
+          if (compressed.isError()) {
+            return Failure("Failed to compress stream: " + compressed.error());
+          }
+
+          payload = std::move(compressed.get());
+        }
 
         ostringstream out;
 
-        if (data.empty()) {
+        if (!payload.empty()) {
+          out << std::hex << payload.size() << "\r\n";
+          out << payload;
+          out << "\r\n";
+        }
+
+        if (finished) {
           // Finished reading.
           out << "0\r\n" << "\r\n";
-          finished = true;
-        } else {
-          out << std::hex << data.size() << "\r\n";
-          out << data;
-          out << "\r\n";
         }
 
         Encoder* encoder = new DataEncoder(out.str());
@@ -1694,6 +2057,17 @@ Future<Nothing> stream(
   // header, we'll fill in (or overwrite) 'Transfer-Encoding' header.
   response.headers["Transfer-Encoding"] = "chunked";
 
+  // Compress the stream if the client accepts it and the response
+  // is not already encoded. Each chunk is flushed through the
+  // compressor so that the client can decompress it immediately.
+  Option<Owned<gzip::Compressor>> compressor;
+
+  if (!response.headers.contains("Content-Encoding") &&
+      request->acceptsEncoding("gzip")) {
+    response.headers["Content-Encoding"] = "gzip";
+    compressor = Owned<gzip::Compressor>(new gzip::Compressor());
+  }
+
   Encoder* encoder = new HttpResponseEncoder(response, *request);
 
   return send(socket, encoder)
@@ -1701,7 +2075,7 @@ Future<Nothing> stream(
       delete encoder;
     })
     .then([=]() {
-      return stream(socket, response.reader.get());
+      return stream(socket, response.reader.get(), compressor);
     })
     // Regardless of whether `send` or `stream` completed successfully
     // or failed we close the reader so any writers will be notified.
@@ -2323,9 +2697,56 @@ Request createRequest(
 
 Future<Response> request(const Request& request, bool streamedResponse)
 {
-  // We rely on the connection closing after the response.
+  // We rely on either the connection pool or the connection
+  // closing after the response.
   CHECK(!request.keepAlive);
 
+  // Requests with in-memory bodies and responses go over pooled
+  // keep-alive connections so that consecutive one-off calls to the
+  // same endpoint don't set up a new connection each time. Streamed
+  // responses and PIPE requests hold onto their connection for an
+  // arbitrary amount of time, so they get a connection of their own
+  // which closes after the response.
+  if (!streamedResponse && request.type == Request::BODY) {
+    Request request_ = request;
+    request_.keepAlive = true;
+
+    PID<internal::ConnectionPoolProcess> pool = internal::pool();
+
+    return dispatch(
+        pool,
+        &internal::ConnectionPoolProcess::acquire,
+        request_.url)
+      .then([=](const internal::ConnectionPoolProcess::Acquired& acquired) {
+        Future<Response> response =
+          internal::exchange(pool, acquired.connection, request_);
+
+        // The peer may close a pooled connection while it sits idle,
+        // and we may not have noticed by the time it gets handed out
+        // again. Retry once on a fresh connection, but only for
+        // idempotent methods: for others we cannot rule out that the
+        // peer already acted on the request.
+        bool idempotent =
+          request_.method == "GET" ||
+          request_.method == "HEAD" ||
+          request_.method == "OPTIONS" ||
+          request_.method == "PUT" ||
+          request_.method == "DELETE";
+
+        if (!acquired.reused || !idempotent) {
+          return response;
+        }
+
+        return response.repair(
+            [=](const Future<Response>& failed) -> Future<Response> {
+              return http::connect(request_.url)
+                .then([=](const Connection& connection) {
+                  return internal::exchange(pool, connection, request_);
+                });
+            });
+      });
+  }
+
   return http::connect(request.url)
     .then([=](Connection connection) {
       Future<Response> response = connection.send(request, streamedResponse);
@@ -44,6 +44,7 @@ void HttpProxy::finalize()
     reader.close();
   }
   pipe = None();
+  compressor = None();
 
   while (!items.empty()) {
     Item* item = items.front();
@@ -174,17 +175,57 @@ bool HttpProxy::process(const Future<Response>& future, const Request& request)
         VLOG(1) << "Returning '404 Not Found' for directory '" << path << "'";
         socket_manager->send(NotFound(), request, socket);
       } else {
+        // Serve a subset of the file if the client sent a satisfiable
+        // 'Range' header. Only single byte ranges are supported; any
+        // 'Range' header we cannot honor is ignored and the full file
+        // is sent instead (which RFC 7233 permits).
+        off_t offset = 0;
+        size_t length = size->bytes();
+
+        response.headers["Accept-Ranges"] = "bytes";
+
+        Option<string> range = request.headers.get("Range");
+
+        if (range.isSome() && response.code == http::Status::OK) {
+          Result<http::internal::ByteRange> parsed =
+            http::internal::parseRangeHeader(range.get(), size->bytes());
+
+          if (parsed.isError()) {
+            VLOG(1) << "Returning '416 Requested Range Not Satisfiable'"
+                    << " for path '" << path << "': " << parsed.error();
+
+            Response unsatisfiable =
+              Response(http::Status::REQUESTED_RANGE_NOT_SATISFIABLE);
+            unsatisfiable.headers["Content-Range"] =
+              "bytes */" + stringify(size->bytes());
+
+            os::close(fd.get());
+            socket_manager->send(unsatisfiable, request, socket);
+            return true; // All done, can process next request.
+          } else if (parsed.isSome()) {
+            offset = parsed->offset;
+            length = parsed->length;
+
+            response.code = http::Status::PARTIAL_CONTENT;
+            response.status = http::Status::string(response.code);
+            response.headers["Content-Range"] =
+              "bytes " + stringify(offset) + "-" +
+              stringify(offset + length - 1) + "/" +
+              stringify(size->bytes());
+          }
+        }
+
         // While the user is expected to properly set a 'Content-Type'
         // header, we fill in (or overwrite) 'Content-Length' header.
-        response.headers["Content-Length"] = stringify(size->bytes());
+        response.headers["Content-Length"] = stringify(length);
 
-        if (size.get() == 0) {
+        if (length == 0) {
+          os::close(fd.get());
           socket_manager->send(response, request, socket);
           return true; // All done, can process next request.
         }
 
-        VLOG(1) << "Sending file at '" << path << "' with length "
-                << size.get();
+        VLOG(1) << "Sending file at '" << path << "' with length " << length;
 
         // TODO(benh): Consider a way to have the socket manager turn
         // on TCP_CORK for both sends and then turn it off.
@@ -195,7 +236,7 @@ bool HttpProxy::process(const Future<Response>& future, const Request& request)
 
         // Note the file descriptor gets closed by FileEncoder.
         socket_manager->send(
-            new FileEncoder(fd.get(), size->bytes()),
+            new FileEncoder(fd.get(), length, offset),
             request.keepAlive,
             socket);
       }
@@ -209,6 +250,16 @@ bool HttpProxy::process(const Future<Response>& future, const Request& request)
     // header, we fill in (or overwrite) 'Transfer-Encoding' header.
     response.headers["Transfer-Encoding"] = "chunked";
 
+    // Compress the stream if the client accepts it and the response
+    // is not already encoded. Each chunk gets flushed through the
+    // compressor so the client can decompress it immediately, at a
+    // small cost in compression ratio.
+    if (!response.headers.contains("Content-Encoding") &&
+        request.acceptsEncoding("gzip")) {
+      response.headers["Content-Encoding"] = "gzip";
+      compressor = Owned<gzip::Compressor>(new gzip::Compressor());
+    }
+
     VLOG(3) << "Starting \"chunked\" streaming";
 
     socket_manager->send(
@@ -251,27 +302,44 @@ void HttpProxy::stream(
   bool finished = false; // Whether we're done streaming.
 
   if (chunk.isReady()) {
-    std::ostringstream out;
+    Try<string> payload = chunk.get();
 
-    if (chunk->empty()) {
-      // Finished reading.
-      out << "0\r\n" << "\r\n";
+    if (compressor.isSome()) {
+      payload = chunk->empty()
+        ? compressor.get()->finish()
+        : compressor.get()->compress(chunk.get());
+    }
+
+    if (payload.isError()) {
+      VLOG(1) << "Failed to compress stream: " << payload.error();
+      // TODO(bmahler): Have to close connection if headers were sent!
+      socket_manager->send(InternalServerError(), *request, socket);
       finished = true;
     } else {
-      out << std::hex << chunk->size() << "\r\n";
-      out << chunk.get();
-      out << "\r\n";
+      std::ostringstream out;
 
-      // Keep reading.
-      reader.read()
-        .onAny(defer(self(), &Self::stream, request, lambda::_1));
-    }
+      if (!payload->empty()) {
+        out << std::hex << payload->size() << "\r\n";
+        out << payload.get();
+        out << "\r\n";
+      }
 
-    // Always persist the connection when streaming is not finished.
-    socket_manager->send(
-        new DataEncoder(out.str()),
-        finished ? request->keepAlive : true,
-        socket);
+      if (chunk->empty()) {
+        // Finished reading.
+        out << "0\r\n" << "\r\n";
+        finished = true;
+      } else {
+        // Keep reading.
+        reader.read()
+          .onAny(defer(self(), &Self::stream, request, lambda::_1));
+      }
+
+      // Always persist the connection when streaming is not finished.
+      socket_manager->send(
+          new DataEncoder(out.str()),
+          finished ? request->keepAlive : true,
+          socket);
+    }
   } else if (chunk.isFailed()) {
     VLOG(1) << "Failed to read from stream: " << chunk.failure();
     // TODO(bmahler): Have to close connection if headers were sent!
@@ -287,6 +355,7 @@ void HttpProxy::stream(
   if (finished) {
     reader.close();
     pipe = None();
+    compressor = None();
     next();
   }
 }
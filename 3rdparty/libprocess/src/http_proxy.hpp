@@ -17,9 +17,11 @@
 
 #include <process/future.hpp>
 #include <process/http.hpp>
+#include <process/owned.hpp>
 #include <process/process.hpp>
 #include <process/socket.hpp>
 
+#include <stout/gzip.hpp>
 #include <stout/option.hpp>
 
 namespace process {
@@ -91,6 +93,10 @@ private:
   std::queue<Item*> items;
 
   Option<http::Pipe::Reader> pipe; // Current pipe, if streaming.
+
+  // Set when the current stream is being compressed, i.e., the
+  // client accepts the gzip content encoding.
+  Option<Owned<gzip::Compressor>> compressor;
 };
 
 } // namespace process {
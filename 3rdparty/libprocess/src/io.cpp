@@ -97,6 +97,11 @@ Future<Nothing> splice(
     const vector<lambda::function<void(const string&)>>& hooks)
 {
   boost::shared_array<char> data(new char[chunk]);
+
+  // We need to share the write position between the iterations of
+  // the write loop below.
+  std::shared_ptr<size_t> index(new size_t(0));
+
   return loop(
       None(),
       [=]() {
@@ -108,12 +113,37 @@ Future<Nothing> splice(
         }
 
         // Send the data to the redirect hooks.
-        const string s = string(data.get(), length);
-        foreach (const lambda::function<void(const string&)>& hook, hooks) {
-          hook(s);
+        //
+        // NOTE: We only materialize the data as a string if there
+        // are hooks installed, so that the common hook-less relay
+        // does not copy every chunk.
+        if (!hooks.empty()) {
+          const string s = string(data.get(), length);
+          foreach (const lambda::function<void(const string&)>& hook, hooks) {
+            hook(s);
+          }
         }
 
-        return io::write(to, s)
+        // Write the chunk out directly from the read buffer. Note
+        // that we write to `to` without duplicating it (unlike
+        // `io::write(int_fd, const string&)`): our caller retains
+        // ownership of the file descriptor until the returned future
+        // completes, so there is no need to pay for a `dup` and the
+        // async preparation of the duplicate on every chunk.
+        *index = 0;
+
+        return loop(
+            None(),
+            [=]() {
+              return io::write(to, data.get() + *index, length - *index);
+            },
+            [=](size_t written) -> ControlFlow<Nothing> {
+              if ((*index += written) != length) {
+                return Continue();
+              }
+
+              return Break();
+            })
           .then([]() -> Future<ControlFlow<Nothing>> {
             return Continue();
           });
@@ -95,9 +95,14 @@ constexpr char LIBPROCESS_DEFAULT_TMPDIR[] = "/tmp";
 constexpr char RAW_PROFILE_FILENAME[] = "profile.dump";
 constexpr char SYMBOLIZED_PROFILE_FILENAME[] = "symbolized-profile.dump";
 constexpr char GRAPH_FILENAME[] = "profile.svg";
+constexpr char DIFF_BASE_FILENAME[] = "diff-base.dump";
+constexpr char DIFF_SECOND_FILENAME[] = "diff-second.dump";
+constexpr char DIFF_PROFILE_FILENAME[] = "diff-profile.txt";
 constexpr Duration MINIMUM_COLLECTION_TIME = Seconds(1);
 constexpr Duration DEFAULT_COLLECTION_TIME = Minutes(5);
 constexpr Duration MAXIMUM_COLLECTION_TIME = Hours(24);
+constexpr Duration DEFAULT_DIFF_TIME = Minutes(1);
+constexpr Duration MAXIMUM_DIFF_TIME = Hours(1);
 
 
 constexpr char JEMALLOC_NOT_DETECTED_MESSAGE[] = R"_(
@@ -428,6 +433,36 @@ const string MemoryProfiler::STOP_HELP()
 }
 
 
+const string MemoryProfiler::DIFF_HELP()
+{
+  return HELP(
+      TLDR(
+          "Returns the heap allocation delta over an interval."),
+      DESCRIPTION(
+          "Captures a heap profile immediately and a second one after the",
+          "given duration has elapsed, and returns the symbolized allocation",
+          "delta between the two snapshots, with the retained bytes of each",
+          "allocation site ranked by growth. Allocations that were freed",
+          "during the interval cancel out, so steadily growing sites stand",
+          "out even on a long-running process.",
+          "",
+          "If memory profiling is not active, it is activated for the",
+          "duration of the diff and deactivated afterwards.",
+          "",
+          "Requires that the running binary was built with symbols and that",
+          "jeprof is installed on the host machine.",
+          "",
+          "**NOTE:** The response is delayed until the second snapshot",
+          "has been taken.",
+          "",
+          "Query parameters:",
+          "",
+          ">        duration=VALUE   Time between the two snapshots.",
+          ">                         (default: 1mins)"),
+      AUTHENTICATION(true));
+}
+
+
 const string MemoryProfiler::DOWNLOAD_RAW_HELP()
 {
   return HELP(
@@ -531,6 +566,11 @@ void MemoryProfiler::initialize()
         STOP_HELP(),
         &MemoryProfiler::stop);
 
+  route("/diff",
+        authenticationRealm,
+        DIFF_HELP(),
+        &MemoryProfiler::diff);
+
   route("/download/raw",
         authenticationRealm,
         DOWNLOAD_RAW_HELP(),
@@ -784,6 +824,146 @@ Future<http::Response> MemoryProfiler::stop(
 }
 
 
+Future<http::Response> MemoryProfiler::diff(
+    const http::Request& request,
+    const Option<http::authentication::Principal>&)
+{
+  if (!detectJemalloc()) {
+    return http::BadRequest(string(JEMALLOC_NOT_DETECTED_MESSAGE) + ".\n");
+  }
+
+  if (currentDiff.isSome()) {
+    return http::Conflict("A heap-diff run is already in progress.\n");
+  }
+
+  Duration duration = DEFAULT_DIFF_TIME;
+
+  Option<string> durationParameter = request.url.query.get("duration");
+  if (durationParameter.isSome()) {
+    Try<Duration> parsed = Duration::parse(durationParameter.get());
+    if (parsed.isError()) {
+      return http::BadRequest(
+          "Could not parse parameter 'duration': " + parsed.error() + ".\n");
+    }
+    duration = parsed.get();
+  }
+
+  if (duration < MINIMUM_COLLECTION_TIME || duration > MAXIMUM_DIFF_TIME) {
+    return http::BadRequest(
+        "Duration '" + stringify(duration) + "' must be between "
+        + stringify(MINIMUM_COLLECTION_TIME) + " and "
+        + stringify(MAXIMUM_DIFF_TIME) + ".\n");
+  }
+
+  // Make sure allocation sampling is active between the two
+  // snapshots, remembering whether we need to deactivate it again
+  // when the run finishes.
+  bool deactivateProfiling = false;
+
+  Try<bool> active = jemalloc::profilingActive();
+  if (active.isError()) {
+    return http::BadRequest(
+        "Error interfacing with jemalloc: " + active.error() + ".\n");
+  }
+
+  if (!active.get()) {
+    Try<bool> started = jemalloc::startProfiling();
+    if (started.isError()) {
+      return http::BadRequest(
+          string(JEMALLOC_PROFILING_NOT_ENABLED_MESSAGE) + ".\n");
+    }
+
+    deactivateProfiling = true;
+  }
+
+  Try<Path> tmpdir = getTemporaryDirectoryPath();
+  if (tmpdir.isError()) {
+    return http::BadRequest(
+        "Could not determine snapshot path: " + tmpdir.error() + ".\n");
+  }
+
+  const string basePath = path::join(tmpdir.get(), DIFF_BASE_FILENAME);
+
+  Try<Nothing> baseline = jemalloc::dump(basePath);
+  if (baseline.isError()) {
+    if (deactivateProfiling) {
+      jemalloc::stopProfiling();
+    }
+
+    return http::BadRequest(
+        "Failed to dump baseline snapshot: " + baseline.error() + ".\n");
+  }
+
+  DiffRun run;
+  run.id = std::chrono::system_clock::to_time_t(
+      std::chrono::system_clock::now());
+  run.basePath = basePath;
+  run.deactivateProfiling = deactivateProfiling;
+  run.promise.reset(new Promise<http::Response>());
+
+  currentDiff = std::move(run);
+
+  delay(duration, this, &MemoryProfiler::_diff);
+
+  return currentDiff->promise->future();
+}
+
+
+void MemoryProfiler::_diff()
+{
+  CHECK_SOME(currentDiff);
+
+  const string basePath = currentDiff->basePath;
+
+  diffProfile = DiskArtifact::create(
+      DIFF_PROFILE_FILENAME,
+      currentDiff->id,
+      [basePath](const string& outputPath) -> Try<Nothing> {
+        // The temporary directory is already known to exist at this
+        // point, since the baseline snapshot was dumped into it.
+        Try<Path> tmpdir = getTemporaryDirectoryPath();
+        if (tmpdir.isError()) {
+          return Error(tmpdir.error());
+        }
+
+        const string secondPath =
+          path::join(tmpdir.get(), DIFF_SECOND_FILENAME);
+
+        Try<Nothing> second = jemalloc::dump(secondPath);
+        if (second.isError()) {
+          return Error(
+              "Failed to dump second snapshot: " + second.error());
+        }
+
+        return generateJeprofFile(
+            secondPath,
+            "--text --base=" + basePath,
+            outputPath);
+      });
+
+  // Restore the sampling state unless a regular profiling run was
+  // started while the diff was in progress.
+  if (currentDiff->deactivateProfiling && currentRun.isNone()) {
+    Try<bool> stopped = jemalloc::stopProfiling();
+    if (stopped.isError()) {
+      LOG(WARNING) << "Failed to deactivate memory profiling after heap-diff"
+                   << " run: " << stopped.error();
+    }
+  }
+
+  if (diffProfile.isError()) {
+    const string message = "Cannot generate heap diff: " + diffProfile.error();
+    LOG(WARNING) << message;
+    currentDiff->promise->set(
+        static_cast<http::Response>(http::BadRequest(message + ".\n")));
+  } else {
+    currentDiff->promise->set(diffProfile->asHttp());
+  }
+
+  currentDiff = None();
+}
+
+
 Future<http::Response> MemoryProfiler::downloadRawProfile(
     const http::Request& request,
     const Option<http::authentication::Principal>&)
@@ -18,6 +18,7 @@
 
 #include <process/future.hpp>
 #include <process/http.hpp>
+#include <process/owned.hpp>
 #include <process/process.hpp>
 
 #include <stout/nothing.hpp>
@@ -47,6 +48,7 @@ protected:
 private:
   static const std::string START_HELP();
   static const std::string STOP_HELP();
+  static const std::string DIFF_HELP();
   static const std::string DOWNLOAD_RAW_HELP();
   static const std::string DOWNLOAD_TEXT_HELP();
   static const std::string DOWNLOAD_GRAPH_HELP();
@@ -66,6 +68,12 @@ private:
       const http::Request& request,
       const Option<http::authentication::Principal>&);
 
+  // Captures two heap profiles over a requested interval and returns
+  // the symbolized allocation delta between them, ranked by growth.
+  Future<http::Response> diff(
+      const http::Request& request,
+      const Option<http::authentication::Principal>&);
+
   // Returns a raw heap profile.
   Future<http::Response> downloadRawProfile(
       const http::Request& request,
@@ -96,6 +104,10 @@ private:
   // Deactivates data collection and attempts to dump the raw profile to disk.
   void stopAndGenerateRawProfile();
 
+  // Captures the second snapshot of a heap-diff run and completes the
+  // pending response with the generated delta.
+  void _diff();
+
   // The authentication realm that the profiler's HTTP endpoints will be
   // installed into.
   Option<std::string> authenticationRealm;
@@ -115,6 +127,23 @@ private:
 
   Option<ProfilingRun> currentRun;
 
+  // Stores information about an in-flight heap-diff run. The promise
+  // is fulfilled with the generated delta once the second snapshot
+  // was taken.
+  struct DiffRun
+  {
+    time_t id;
+    std::string basePath;
+
+    // Whether profiling was activated for this run and should be
+    // deactivated again when it finishes.
+    bool deactivateProfiling;
+
+    Owned<Promise<http::Response>> promise;
+  };
+
+  Option<DiffRun> currentDiff;
+
   // Represents a file on the filesystem that is generated as the result
   // of running some action.
   class DiskArtifact
@@ -146,6 +175,10 @@ private:
   // These profiles are obtained by running `jeprof` on the `raw` profile.
   Try<DiskArtifact> symbolizedProfile = Error("Not yet generated");
   Try<DiskArtifact> graphProfile = Error("Not yet generated");
+
+  // This profile is obtained by running `jeprof --base` on the two
+  // snapshots captured by the `/diff` endpoint.
+  Try<DiskArtifact> diffProfile = Error("Not yet generated");
 };
 
 } // namespace process {
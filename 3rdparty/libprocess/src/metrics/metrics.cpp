@@ -12,11 +12,16 @@
 
 #include <glog/logging.h>
 
+#include <cmath>
+#include <limits>
 #include <map>
+#include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <process/after.hpp>
+#include <process/clock.hpp>
 #include <process/collect.hpp>
 #include <process/dispatch.hpp>
 #include <process/help.hpp>
@@ -40,6 +45,49 @@ namespace process {
 namespace metrics {
 namespace internal {
 
+// Renders a snapshot in the Prometheus text exposition format.
+// Metric names are sanitized to the character set Prometheus permits
+// (slashes and dashes become underscores); all metrics are exposed as
+// bare values since `Metric` carries no type information.
+static string prometheus(const map<string, double>& snapshot)
+{
+  std::ostringstream out;
+  out.precision(std::numeric_limits<double>::digits10 + 2);
+
+  foreachpair (const string& key, double value, snapshot) {
+    string name = key;
+
+    for (size_t i = 0; i < name.size(); i++) {
+      const char c = name[i];
+      const bool valid =
+        (c >= 'a' && c <= 'z') ||
+        (c >= 'A' && c <= 'Z') ||
+        (c >= '0' && c <= '9' && i > 0) ||
+        c == '_' ||
+        c == ':';
+
+      if (!valid) {
+        name[i] = '_';
+      }
+    }
+
+    out << name << " ";
+
+    if (std::isnan(value)) {
+      out << "NaN";
+    } else if (std::isinf(value)) {
+      out << (value > 0 ? "+Inf" : "-Inf");
+    } else {
+      out << value;
+    }
+
+    out << "\n";
+  }
+
+  return out.str();
+}
+
+
 MetricsProcess* MetricsProcess::create(
     const Option<string>& authenticationRealm)
 {
@@ -88,7 +136,27 @@ MetricsProcess* MetricsProcess::create(
     }
   }
 
-  return new MetricsProcess(limiter, authenticationRealm);
+  // An optional freshness window during which a completed snapshot
+  // is served without re-evaluating the gauges. This bounds the cost
+  // of multiple monitoring systems scraping the endpoints: scrapes
+  // landing within the window share one collection.
+  Duration cacheTtl = Duration::zero();
+
+  Option<string> ttl = os::getenv("LIBPROCESS_METRICS_SNAPSHOT_CACHE_TTL");
+
+  if (ttl.isSome() && !ttl->empty()) {
+    Try<Duration> duration = Duration::parse(ttl.get());
+
+    if (duration.isError()) {
+      EXIT(EXIT_FAILURE)
+        << "Failed to parse LIBPROCESS_METRICS_SNAPSHOT_CACHE_TTL "
+        << "'" << ttl.get() << "': " << duration.error();
+    }
+
+    cacheTtl = duration.get();
+  }
+
+  return new MetricsProcess(limiter, cacheTtl, authenticationRealm);
 }
 
 
@@ -98,6 +166,11 @@ void MetricsProcess::initialize()
         authenticationRealm,
         help(),
         &MetricsProcess::_snapshot);
+
+  route("/prometheus",
+        authenticationRealm,
+        prometheusHelp(),
+        &MetricsProcess::_prometheus);
 }
 
 
@@ -118,6 +191,22 @@ string MetricsProcess::help()
 }
 
 
+string MetricsProcess::prometheusHelp()
+{
+  return HELP(
+      TLDR("Provides current metrics in the Prometheus text format."),
+      DESCRIPTION(
+          "This endpoint renders the same snapshot served by '/snapshot'",
+          "in the Prometheus text exposition format. Metric names are",
+          "sanitized to the character set Prometheus permits.",
+          "",
+          "The optional query parameter 'timeout' determines the maximum",
+          "amount of time the endpoint will take to respond. If the timeout",
+          "is exceeded, some metrics may not be included in the response."),
+      AUTHENTICATION(true));
+}
+
+
 Future<Nothing> MetricsProcess::add(Owned<Metric> metric)
 {
   bool inserted = metrics.emplace(metric->name(), metric).second;
@@ -126,6 +215,10 @@ Future<Nothing> MetricsProcess::add(Owned<Metric> metric)
     return Failure("Metric '" + metric->name() + "' was already added");
   }
 
+  // Invalidate the cached snapshot so that the new metric is visible
+  // immediately rather than after the freshness window elapses.
+  cache = None();
+
   return Nothing();
 }
 
@@ -138,6 +231,9 @@ Future<Nothing> MetricsProcess::remove(const string& name)
     return Failure("Metric '" + name + "' not found");
   }
 
+  // As in `add`, don't let removed metrics linger in the cache.
+  cache = None();
+
   return Nothing();
 }
 
@@ -145,6 +241,23 @@ Future<Nothing> MetricsProcess::remove(const string& name)
 Future<map<string, double>> MetricsProcess::snapshot(
     const Option<Duration>& timeout)
 {
+  // Serve the cached snapshot while it is fresh.
+  if (cacheTtl > Duration::zero() &&
+      cache.isSome() &&
+      Clock::now(this) - cache->first < cacheTtl) {
+    return cache->second;
+  }
+
+  // Coalesce concurrent scrapes onto the in-flight collection: the
+  // gauge fan-out below dispatches into the busiest actors, so there
+  // is no point in fanning out again while a collection with the
+  // same timeout is still pending.
+  if (outstanding.isSome() &&
+      outstanding->isPending() &&
+      outstandingTimeout == timeout) {
+    return outstanding.get();
+  }
+
   // To avoid creating a new vector when calling `await()` below, we use three
   // ordered vectors, where the Nth key in `keys` is associated with the Nth
   // items in each of `futures` and `statistics`.
@@ -177,7 +290,7 @@ Future<map<string, double>> MetricsProcess::snapshot(
       timedout,
       await(futures).then([]{ return Nothing(); }) });
 
-  return waited
+  outstanding = waited
     .onAny([=]() mutable { timedout.discard(); }) // Don't accumulate timers.
     .then(defer(self(),
                 &Self::__snapshot,
@@ -185,6 +298,9 @@ Future<map<string, double>> MetricsProcess::snapshot(
                 std::move(keys),
                 std::move(futures),
                 std::move(statistics)));
+  outstandingTimeout = timeout;
+
+  return outstanding.get();
 }
 
 
@@ -222,6 +338,44 @@ Future<http::Response> MetricsProcess::_snapshot(
 }
 
 
+Future<http::Response> MetricsProcess::_prometheus(
+    const http::Request& request,
+    const Option<http::authentication::Principal>&)
+{
+  // Parse the 'timeout' parameter.
+  Option<Duration> timeout;
+
+  if (request.url.query.contains("timeout")) {
+    string parameter = request.url.query.get("timeout").get();
+
+    Try<Duration> duration = Duration::parse(parameter);
+
+    if (duration.isError()) {
+      return http::BadRequest(
+          "Invalid timeout '" + parameter + "': " + duration.error() + ".\n");
+    }
+
+    timeout = duration.get();
+  }
+
+  Future<Nothing> acquire = Nothing();
+
+  if (limiter.isSome()) {
+    acquire = limiter.get()->acquire();
+  }
+
+  // NOTE: This renders from the same (possibly cached) snapshot that
+  // '/snapshot' serves, so concurrent scrapes of the two endpoints
+  // share one gauge collection.
+  return acquire.then(defer(self(), &Self::snapshot, timeout))
+      .then([](const map<string, double>& metrics) -> http::Response {
+        http::OK response(prometheus(metrics));
+        response.headers["Content-Type"] = "text/plain; version=0.0.4";
+        return response;
+      });
+}
+
+
 Future<map<string, double>> MetricsProcess::__snapshot(
     const Option<Duration>& timeout,
     vector<string>&& keys,
@@ -230,6 +384,8 @@ Future<map<string, double>> MetricsProcess::__snapshot(
 {
   map<string, double> snapshot;
 
+  bool complete = true;
+
   for (size_t i = 0; i < metrics.size(); ++i) {
     // TODO(dhamon): Maybe add the failure message for this metric to the
     // response if value.isFailed().
@@ -240,6 +396,7 @@ Future<map<string, double>> MetricsProcess::__snapshot(
       CHECK_SOME(timeout);
       VLOG(1) << "Exceeded timeout of " << timeout.get()
               << " when attempting to get metric '" << key << "'";
+      complete = false;
     } else if (value.isReady()) {
       snapshot.emplace_hint(snapshot.end(), key, value.get());
     }
@@ -261,6 +418,12 @@ Future<map<string, double>> MetricsProcess::__snapshot(
     }
   }
 
+  // Only cache complete snapshots so that a scrape that timed out
+  // does not pin a partial result for the freshness window.
+  if (cacheTtl > Duration::zero() && complete) {
+    cache = std::make_pair(Clock::now(this), snapshot);
+  }
+
   // NOTE: Newer compilers (clang-3.9 and gcc-5.1) can perform
   // this move automatically when optimization is on. Once these
   // are the minimum versions, remove this `std::move`.
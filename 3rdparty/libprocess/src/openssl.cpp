@@ -30,8 +30,10 @@
 
 #include <process/ssl/flags.hpp>
 
+#include <stout/linkedhashmap.hpp>
 #include <stout/os.hpp>
 #include <stout/strings.hpp>
+#include <stout/synchronized.hpp>
 
 #ifdef __WINDOWS__
 // OpenSSL on Windows requires this adapter module to be compiled as part of the
@@ -63,6 +65,21 @@ namespace openssl {
 static SSL_CTX* ctx = nullptr;
 
 
+// Client-side TLS session cache, keyed by peer address. OpenSSL's
+// internal session cache only covers the server side; a client has to
+// remember the session negotiated with each peer itself and offer it
+// on the next connection in order to get an abbreviated handshake.
+// Sessions are kept in insertion order so that the oldest entry can
+// be evicted when the cache is full.
+//
+// NOTE: These are raw pointers because they are shared between
+// threads and we don't want to destruct them at exit (the same
+// pattern used for 'mutexes' below).
+static std::mutex* client_sessions_mutex = new std::mutex();
+static LinkedHashMap<string, SSL_SESSION*>* client_sessions =
+  new LinkedHashMap<string, SSL_SESSION*>();
+
+
 Flags::Flags()
 {
   add(&Flags::enabled,
@@ -159,6 +176,18 @@ Flags::Flags()
       "enable_tls_v1_2",
       "Enable SSLV1.2.",
       true);
+
+  add(&Flags::session_resumption,
+      "session_resumption",
+      "Enable TLS session resumption. Established sessions are cached "
+      "(and session tickets issued to clients) so that a reconnecting "
+      "peer can perform an abbreviated handshake instead of a full one.",
+      true);
+
+  add(&Flags::session_cache_size,
+      "session_cache_size",
+      "Maximum number of TLS sessions to cache for resumption.",
+      10240u);
 }
 
 
@@ -455,6 +484,16 @@ void reinitialize()
   if (ctx != nullptr) {
     SSL_CTX_free(ctx);
     ctx = nullptr;
+
+    // Sessions negotiated against the previous context (potentially
+    // with different certificates or ciphers) cannot be resumed
+    // against the new one, so drop them.
+    synchronized (client_sessions_mutex) {
+      foreachvalue (SSL_SESSION* session, *client_sessions) {
+        SSL_SESSION_free(session);
+      }
+      client_sessions->clear();
+    }
   }
 
   // Replace with `TLS_method` once our minimum OpenSSL version
@@ -463,12 +502,22 @@ void reinitialize()
   CHECK(ctx) << "Failed to create SSL context: "
              << ERR_error_string(ERR_get_error(), nullptr);
 
-  // Disable SSL session caching.
-  SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_OFF);
+  // Enable server-side session caching so that reconnecting peers
+  // can resume their previous session with an abbreviated handshake
+  // instead of performing a full one. This matters most during
+  // reconnection storms (e.g. agents re-connecting after a master
+  // failover). Clients additionally remember sessions per peer in
+  // 'client_sessions' (see 'cache_session').
+  if (ssl_flags->session_resumption) {
+    SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_SERVER);
+    SSL_CTX_sess_set_cache_size(ctx, ssl_flags->session_cache_size);
+  } else {
+    SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_OFF);
+  }
 
-  // Set a session id to avoid connection termination upon
-  // re-connect. We can use something more relevant when we care
-  // about session caching.
+  // Set a session id so that servers recognize the sessions they
+  // issued; session resumption is refused across mismatching session
+  // id contexts.
   const uint64_t session_ctx = 7;
 
   const unsigned char* session_id =
@@ -673,6 +722,11 @@ void reinitialize()
   // Disable TLSv1.2.
   if (!ssl_flags->enable_tls_v1_2) { ssl_options |= SSL_OP_NO_TLSv1_2; }
 
+  // Session tickets (RFC 5077) allow stateless resumption and are on
+  // by default in OpenSSL; turn them off along with the caches when
+  // resumption is disabled.
+  if (!ssl_flags->session_resumption) { ssl_options |= SSL_OP_NO_TICKET; }
+
   SSL_CTX_set_options(ctx, ssl_options);
 
 #if OPENSSL_VERSION_NUMBER >= 0x0090800fL && !defined(OPENSSL_NO_ECDH)
@@ -707,6 +761,58 @@ SSL_CTX* context()
 }
 
 
+void cache_session(const string& key, SSL* ssl)
+{
+  if (!ssl_flags->session_resumption) {
+    return;
+  }
+
+  // 'SSL_get1_session' bumps the reference count; the cache owns
+  // that reference until the entry is replaced or evicted. A null
+  // result means no session was established (e.g. the handshake
+  // was aborted).
+  SSL_SESSION* session = SSL_get1_session(ssl);
+  if (session == nullptr) {
+    return;
+  }
+
+  synchronized (client_sessions_mutex) {
+    Option<SSL_SESSION*> previous = client_sessions->get(key);
+    if (previous.isSome()) {
+      SSL_SESSION_free(previous.get());
+      client_sessions->erase(key);
+    }
+
+    (*client_sessions)[key] = session;
+
+    // Evict the oldest entries if we've exceeded the cache size.
+    while (client_sessions->size() > ssl_flags->session_cache_size) {
+      const string oldest = client_sessions->keys().front();
+      SSL_SESSION_free(client_sessions->at(oldest));
+      client_sessions->erase(oldest);
+    }
+  }
+}
+
+
+void set_cached_session(SSL* ssl, const string& key)
+{
+  if (!ssl_flags->session_resumption) {
+    return;
+  }
+
+  synchronized (client_sessions_mutex) {
+    Option<SSL_SESSION*> session = client_sessions->get(key);
+    if (session.isSome()) {
+      // 'SSL_set_session' takes its own reference on the session.
+      // If the session has expired or the server refuses to resume
+      // it, the connection simply falls back to a full handshake.
+      SSL_set_session(ssl, session.get());
+    }
+  }
+}
+
+
 Try<Nothing> verify(
     const SSL* const ssl,
     const Option<string>& hostname,
@@ -52,6 +52,8 @@ namespace openssl {
 //    LIBPROCESS_SSL_ENABLE_TLS_V1_1=(false|0,true|1)
 //    LIBPROCESS_SSL_ENABLE_TLS_V1_2=(false|0,true|1)
 //    LIBPROCESS_SSL_ECDH_CURVES=(auto|list of curves separated by ':')
+//    LIBPROCESS_SSL_SESSION_RESUMPTION=(false|0,true|1)
+//    LIBPROCESS_SSL_SESSION_CACHE_SIZE=(maximum number of cached sessions)
 //
 // TODO(benh): When/If we need to support multiple contexts in the
 // same process, for example for Server Name Indication (SNI), then
@@ -63,6 +65,20 @@ void initialize();
 // Returns the _global_ OpenSSL context.
 SSL_CTX* context();
 
+// Caches the session negotiated on the given client-side SSL
+// connection under 'key' (typically the stringified peer address) so
+// that subsequent connections to the same peer can offer it for an
+// abbreviated handshake. No-op if session resumption is disabled or
+// no session was established.
+void cache_session(const std::string& key, SSL* ssl);
+
+// Offers a previously cached session for 'key' on the given
+// client-side SSL connection, if one exists. Must be called before
+// the handshake is started. The server decides whether to accept the
+// resumption; a refused or expired session falls back to a full
+// handshake.
+void set_cached_session(SSL* ssl, const std::string& key);
+
 // Verify that the hostname is properly associated with the peer
 // certificate associated with the specified SSL connection.
 Try<Nothing> verify(
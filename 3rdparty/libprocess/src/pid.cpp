@@ -23,14 +23,18 @@
 #include <glog/logging.h>
 
 #include <iostream>
+#include <mutex>
 #include <sstream>
 #include <string>
 
 #include <process/pid.hpp>
 #include <process/process.hpp>
 
+#include <stout/cache.hpp>
 #include <stout/net.hpp>
+#include <stout/option.hpp>
 #include <stout/os.hpp>
+#include <stout/synchronized.hpp>
 
 #include "config.hpp"
 
@@ -43,17 +47,60 @@ using std::string;
 
 namespace process {
 
-UPID::UPID(const char* s)
-{
-  istringstream in(s);
-  in >> *this;
-}
+namespace internal {
+
+// The same few thousand agent and framework PIDs account for
+// virtually all traffic on a master, so we keep a bounded LRU cache
+// of parsed PIDs. This avoids re-parsing (including a potential DNS
+// lookup when the host is not a numeric IP) and re-allocating the id
+// for every message arrival. Since cached entries share their
+// underlying id string, comparing PIDs that came out of the cache
+// reduces to a pointer comparison (see `UPID::ID::operator==`).
+constexpr size_t PID_CACHE_CAPACITY = 10000;
+
+static std::mutex pid_cache_mutex;
+static Cache<string, UPID> pid_cache(PID_CACHE_CAPACITY);
+
+} // namespace internal {
+
+
+UPID::UPID(const char* s) : UPID(string(s)) {}
 
 
 UPID::UPID(const string& s)
 {
+  Option<UPID> cached = None();
+
+  synchronized (internal::pid_cache_mutex) {
+    cached = internal::pid_cache.get(s);
+  }
+
+  if (cached.isSome()) {
+    *this = std::move(cached.get());
+
+    // The cached weak reference to the process may be stale, e.g.,
+    // the process had not been spawned yet when the PID was first
+    // parsed, or has since terminated. Refresh it (and the cache)
+    // if it no longer points at a live process.
+    if (reference.isNone() || reference->expired()) {
+      resolve();
+
+      synchronized (internal::pid_cache_mutex) {
+        internal::pid_cache.put(s, *this);
+      }
+    }
+
+    return;
+  }
+
   istringstream in(s);
   in >> *this;
+
+  if (!in.fail()) {
+    synchronized (internal::pid_cache_mutex) {
+      internal::pid_cache.put(s, *this);
+    }
+  }
 }
 
 
@@ -14,7 +14,11 @@
 #include <unistd.h>
 #endif // __WINDOWS__
 
+#include <atomic>
+#include <map>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 #include <event2/event.h>
 #include <event2/thread.h>
@@ -23,6 +27,9 @@
 #include <process/logging.hpp>
 #include <process/once.hpp>
 
+#include <stout/numify.hpp>
+#include <stout/option.hpp>
+#include <stout/os.hpp>
 #include <stout/synchronized.hpp>
 
 #include "event_loop.hpp"
@@ -31,25 +38,38 @@
 namespace process {
 
 event_base* base = nullptr;
+std::vector<event_base*> bases;
 
 
 static std::mutex* functions_mutex = new std::mutex();
-std::queue<lambda::function<void()>>* functions =
-  new std::queue<lambda::function<void()>>();
+
+// Queued functions for each event loop, keyed by the loop they must
+// run on.
+std::map<event_base*, std::queue<lambda::function<void()>>>* functions =
+  new std::map<event_base*, std::queue<lambda::function<void()>>>();
 
 
 thread_local bool* _in_event_loop_ = nullptr;
+thread_local event_base* _event_loop_base_ = nullptr;
+
+
+event_base* next_base()
+{
+  static std::atomic<size_t> next(0);
+  return bases[next.fetch_add(1) % bases.size()];
+}
 
 
 void async_function(evutil_socket_t socket, short which, void* arg)
 {
   event* ev = reinterpret_cast<event*>(arg);
+  event_base* base_ = event_get_base(ev);
   event_free(ev);
 
   std::queue<lambda::function<void()>> q;
 
   synchronized (functions_mutex) {
-    std::swap(q, *functions);
+    std::swap(q, (*functions)[base_]);
   }
 
   while (!q.empty()) {
@@ -60,28 +80,33 @@ void async_function(evutil_socket_t socket, short which, void* arg)
 
 
 void run_in_event_loop(
+    event_base* base_,
     const lambda::function<void()>& f,
     EventLoopLogicFlow event_loop_logic_flow)
 {
-  if (__in_event_loop__ && event_loop_logic_flow == ALLOW_SHORT_CIRCUIT) {
+  // Only short-circuit if this thread owns the target loop; running
+  // the function on a different loop's thread would reintroduce the
+  // races that `run_in_event_loop` exists to prevent.
+  if (_event_loop_base_ == base_ &&
+      event_loop_logic_flow == ALLOW_SHORT_CIRCUIT) {
     f();
     return;
   }
 
   synchronized (functions_mutex) {
-    functions->push(f);
+    (*functions)[base_].push(f);
 
     // Add an event and activate it to interrupt the event loop.
     // TODO(jmlvanre): after libevent v 2.1 we can use
     // event_self_cbarg instead of re-assigning the event. For now we
     // manually re-assign the event to pass in the pointer to the
     // event itself as the callback argument.
-    event* ev = evtimer_new(base, async_function, nullptr);
+    event* ev = evtimer_new(base_, async_function, nullptr);
 
     // 'event_assign' is only valid on non-pending AND non-active
     // events. This means we have to assign the callback before
     // calling 'event_active'.
-    if (evtimer_assign(ev, base, async_function, ev) < 0) {
+    if (evtimer_assign(ev, base_, async_function, ev) < 0) {
       LOG(FATAL) << "Failed to assign callback on event";
     }
 
@@ -90,12 +115,23 @@ void run_in_event_loop(
 }
 
 
-void EventLoop::run()
+void run_in_event_loop(
+    const lambda::function<void()>& f,
+    EventLoopLogicFlow event_loop_logic_flow)
+{
+  run_in_event_loop(base, f, event_loop_logic_flow);
+}
+
+
+namespace internal {
+
+static void run(event_base* base_)
 {
   __in_event_loop__ = true;
+  _event_loop_base_ = base_;
 
   do {
-    int result = event_base_loop(base, EVLOOP_ONCE);
+    int result = event_base_loop(base_, EVLOOP_ONCE);
     if (result < 0) {
       LOG(FATAL) << "Failed to run event loop";
     } else if (result > 0) {
@@ -103,21 +139,46 @@ void EventLoop::run()
       continue;
     } else {
       CHECK_EQ(0, result);
-      if (event_base_got_break(base)) {
+      if (event_base_got_break(base_)) {
         break;
-      } else if (event_base_got_exit(base)) {
+      } else if (event_base_got_exit(base_)) {
         break;
       }
     }
   } while (true);
 
+  _event_loop_base_ = nullptr;
   __in_event_loop__ = false;
 }
 
+}  // namespace internal {
+
+
+void EventLoop::run()
+{
+  // The additional event loops (if any) run on their own threads
+  // while the default loop runs on this thread, preserving the
+  // join semantics the caller had with a single loop.
+  std::vector<std::thread> threads;
+  threads.reserve(bases.size() - 1);
+
+  for (size_t i = 1; i < bases.size(); i++) {
+    threads.emplace_back(&internal::run, bases[i]);
+  }
+
+  internal::run(base);
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
 
 void EventLoop::stop()
 {
-  event_base_loopexit(base, nullptr);
+  for (event_base* base_ : bases) {
+    event_base_loopexit(base_, nullptr);
+  }
 }
 
 
@@ -199,12 +260,63 @@ void EventLoop::initialize()
 #error "Libevent must be compiled with either pthread or Windows thread support"
 #endif
 
-  base = event_base_new();
+  // We allow the operator to run more than one event loop, using an
+  // environment variable. Sockets are assigned to loops round-robin
+  // (see `next_base()`) while timers and deferred functions stay on
+  // the default loop, so additional loops let socket processing
+  // (notably TLS encryption and decryption) scale across cores
+  // instead of saturating a single thread.
+  size_t num_bases = 1;
+
+  constexpr char env_var[] = "LIBPROCESS_NUM_EVENT_LOOPS";
+  Option<std::string> value = os::getenv(env_var);
+  if (value.isSome()) {
+    constexpr size_t maxval = 1024;
+    Try<size_t> number = numify<size_t>(value->c_str());
+    if (number.isSome() && number.get() > 0 && number.get() <= maxval) {
+      num_bases = number.get();
+    } else {
+      LOG(WARNING) << "Ignoring invalid value " << value.get()
+                   << " for " << env_var
+                   << ", using default value " << num_bases
+                   << ". Valid values are integers in the range 1 to "
+                   << maxval;
+    }
+  }
+
+  bases.reserve(num_bases);
+
+  for (size_t i = 0; i < num_bases; i++) {
+    event_base* base_ = event_base_new();
+
+    if (base_ == nullptr) {
+      LOG(FATAL) << "Failed to initialize, event_base_new";
+    }
 
-  if (base == nullptr) {
-    LOG(FATAL) << "Failed to initialize, event_base_new";
+    // An event loop with nothing to watch makes `event_base_loop`
+    // return immediately, which would turn the loop in `run` into a
+    // busy-wait. Pin a persistent no-op timer to each loop so that it
+    // blocks until real work (or an activation from
+    // `run_in_event_loop`) arrives.
+    event* keepalive = event_new(
+        base_,
+        -1,
+        EV_PERSIST,
+        [](evutil_socket_t, short, void*) {},
+        nullptr);
+
+    if (keepalive == nullptr) {
+      LOG(FATAL) << "Failed to initialize, event_new";
+    }
+
+    timeval interval = {3600, 0};
+    event_add(keepalive, &interval);
+
+    bases.push_back(base_);
   }
 
+  base = bases.front();
+
   initialized->done();
 }
 
@@ -15,14 +15,32 @@
 
 #include <event2/event.h>
 
+#include <vector>
+
 #include <stout/lambda.hpp>
 
 namespace process {
 
-// Event loop.
+// The default event loop, i.e., `bases.front()`. Timers and any work
+// not tied to a particular socket run here.
 extern event_base* base;
 
 
+// All event loops. Each loop runs on its own thread. Sockets are
+// assigned a loop round-robin (see `next_base()`) so that socket
+// processing (in particular TLS encryption and decryption, which
+// libevent performs on the loop thread that owns the bufferevent) can
+// scale across cores rather than saturating a single thread. The
+// number of loops is controlled by the `LIBPROCESS_NUM_EVENT_LOOPS`
+// environment variable and defaults to 1.
+extern std::vector<event_base*> bases;
+
+
+// Returns the event loop to assign to a new socket, chosen
+// round-robin across `bases`.
+event_base* next_base();
+
+
 // Per thread bool pointer. We use a pointer to lazily construct the
 // actual bool.
 extern thread_local bool* _in_event_loop_;
@@ -32,6 +50,12 @@ extern thread_local bool* _in_event_loop_;
   _in_event_loop_ = new bool(false) : _in_event_loop_)
 
 
+// The event loop owned by this thread if it is an event loop thread,
+// and `nullptr` otherwise. Used to determine whether
+// `run_in_event_loop` can short-circuit.
+extern thread_local event_base* _event_loop_base_;
+
+
 enum EventLoopLogicFlow
 {
   ALLOW_SHORT_CIRCUIT,
@@ -39,6 +63,14 @@ enum EventLoopLogicFlow
 };
 
 
+// Runs the function on the thread that owns the given event loop.
+void run_in_event_loop(
+    event_base* base_,
+    const lambda::function<void()>& f,
+    EventLoopLogicFlow event_loop_logic_flow = ALLOW_SHORT_CIRCUIT);
+
+
+// Runs the function on the thread that owns the default event loop.
 void run_in_event_loop(
     const lambda::function<void()>& f,
     EventLoopLogicFlow event_loop_logic_flow = ALLOW_SHORT_CIRCUIT);
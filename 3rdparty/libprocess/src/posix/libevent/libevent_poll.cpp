@@ -53,11 +53,12 @@ void pollCallback(evutil_socket_t, short what, void* arg)
 }
 
 
-void pollDiscard(const std::weak_ptr<event>& ev, short events)
+void pollDiscard(event_base* base_, const std::weak_ptr<event>& ev, short events)
 {
-  // Discarding inside the event loop prevents `pollCallback()` from being
-  // called twice if the future is discarded.
-  run_in_event_loop([=]() {
+  // Discarding inside the event loop that owns the event prevents
+  // `pollCallback()` from being called twice if the future is
+  // discarded.
+  run_in_event_loop(base_, [=]() {
     std::shared_ptr<event> shared = ev.lock();
     // If `ev` cannot be locked `pollCallback` already ran. If it was locked
     // but not pending, `pollCallback` is scheduled to be executed.
@@ -85,10 +86,14 @@ Future<short> poll(int_fd fd, short events)
   short what =
     ((events & io::READ) ? EV_READ : 0) | ((events & io::WRITE) ? EV_WRITE : 0);
 
+  // Distribute events across the event loops so that polling scales
+  // with the number of loop threads.
+  event_base* base_ = next_base();
+
   // Bind `event_free` to the destructor of the `ev` shared pointer
   // guaranteeing that the event will be freed only once.
   poll->ev.reset(
-      event_new(base, fd, what, &internal::pollCallback, poll),
+      event_new(base_, fd, what, &internal::pollCallback, poll),
       event_free);
 
   if (poll->ev == nullptr) {
@@ -105,7 +110,7 @@ Future<short> poll(int_fd fd, short events)
   event_add(poll->ev.get(), nullptr);
 
   return future
-    .onDiscard(lambda::bind(&internal::pollDiscard, ev, what));
+    .onDiscard(lambda::bind(&internal::pollDiscard, base_, ev, what));
 }
 
 } // namespace io {
@@ -59,7 +59,8 @@
 // There is a deadlock scenario in libevent-openssl (v 2.0.21) when
 // modifying the bufferevent (bev) from another thread (not the event
 // loop). To avoid this we run all bufferevent manipulation logic in
-// continuations that are executed within the event loop.
+// continuations that are executed within the event loop that owns
+// the bufferevent (see 'ev_base').
 
 // DISALLOW_SHORT_CIRCUIT:
 //
@@ -115,7 +116,10 @@ LibeventSSLSocketImpl::~LibeventSSLSocketImpl()
   bufferevent* _bev = bev;
   std::weak_ptr<LibeventSSLSocketImpl>* _event_loop_handle = event_loop_handle;
 
+  // Sockets that never connected, listened or were accepted have no
+  // owning event loop; clean those up on the default loop.
   run_in_event_loop(
+      ev_base != nullptr ? ev_base : base,
       [_listener, _bev, _event_loop_handle, fd]() {
         // Once this lambda is called, it should not be possible for
         // more event loop callbacks to be triggered with 'this->bev'.
@@ -183,6 +187,7 @@ Try<Nothing, SocketError> LibeventSSLSocketImpl::shutdown(int how)
   auto self = shared(this);
 
   run_in_event_loop(
+      ev_base,
       [self]() {
         CHECK(__in_event_loop__);
         CHECK(self);
@@ -448,6 +453,12 @@ void LibeventSSLSocketImpl::event_callback(short events)
       return;
     }
 
+    // Remember the negotiated session so that future connections to
+    // this peer can attempt an abbreviated handshake.
+    if (peer_session_key.isSome()) {
+      openssl::cache_session(peer_session_key.get(), ssl);
+    }
+
     current_connect_request->promise.set(Nothing());
   } else if (events & BEV_EVENT_ERROR) {
     CHECK(EVUTIL_SOCKET_ERROR() != 0);
@@ -486,6 +497,7 @@ LibeventSSLSocketImpl::LibeventSSLSocketImpl(int_fd _s)
   : SocketImpl(_s),
     bev(nullptr),
     listener(nullptr),
+    ev_base(nullptr),
     recv_request(nullptr),
     send_request(nullptr),
     connect_request(nullptr),
@@ -499,6 +511,7 @@ LibeventSSLSocketImpl::LibeventSSLSocketImpl(
   : SocketImpl(_s),
     bev(_bev),
     listener(nullptr),
+    ev_base(bufferevent_get_base(_bev)),
     recv_request(nullptr),
     send_request(nullptr),
     connect_request(nullptr),
@@ -521,12 +534,16 @@ Future<Nothing> LibeventSSLSocketImpl::connect(const Address& address)
     return Failure("Failed to connect: SSL_new");
   }
 
+  // Assign this socket to an event loop. All subsequent bufferevent
+  // manipulation must run on that loop's thread.
+  ev_base = next_base();
+
   // Construct the bufferevent in the connecting state.
   // We set 'BEV_OPT_DEFER_CALLBACKS' to avoid calling the
   // 'event_callback' before 'bufferevent_socket_connect' returns.
   CHECK(bev == nullptr);
   bev = bufferevent_openssl_socket_new(
-      base,
+      ev_base,
       s,
       ssl,
       BUFFEREVENT_SSL_CONNECTING,
@@ -559,6 +576,13 @@ Future<Nothing> LibeventSSLSocketImpl::connect(const Address& address)
     peer_ip = network::convert<inet::Address>(address)->ip;
   }
 
+  // If we still have a session from an earlier connection to this
+  // peer, offer it so the server can resume it with an abbreviated
+  // handshake. This must happen before the handshake is initiated
+  // below.
+  peer_session_key = stringify(address);
+  openssl::set_cached_session(ssl, peer_session_key.get());
+
   // Optimistically construct a 'ConnectRequest' and future.
   Owned<ConnectRequest> request(new ConnectRequest());
   Future<Nothing> future = request->promise.future();
@@ -582,6 +606,7 @@ Future<Nothing> LibeventSSLSocketImpl::connect(const Address& address)
   auto self = shared(this);
 
   run_in_event_loop(
+      ev_base,
       [self, address]() {
         sockaddr_storage addr = address;
 
@@ -648,6 +673,7 @@ Future<size_t> LibeventSSLSocketImpl::recv(char* data, size_t size)
 
       if (self != nullptr) {
         run_in_event_loop(
+            self->ev_base,
             [self]() {
               CHECK(__in_event_loop__);
               CHECK(self);
@@ -686,6 +712,7 @@ Future<size_t> LibeventSSLSocketImpl::recv(char* data, size_t size)
   auto self = shared(this);
 
   run_in_event_loop(
+      ev_base,
       [self]() {
         CHECK(__in_event_loop__);
         CHECK(self);
@@ -756,6 +783,7 @@ Future<size_t> LibeventSSLSocketImpl::send(const char* data, size_t size)
   auto self = shared(this);
 
   run_in_event_loop(
+      ev_base,
       [self, buffer]() {
         CHECK(__in_event_loop__);
         CHECK(self);
@@ -850,6 +878,7 @@ Future<size_t> LibeventSSLSocketImpl::sendfile(
   auto self = shared(this);
 
   run_in_event_loop(
+      ev_base,
       [self, owned_fd, offset, size]() {
         CHECK(__in_event_loop__);
         CHECK(self);
@@ -898,11 +927,16 @@ Try<Nothing> LibeventSSLSocketImpl::listen(int backlog)
 
   CHECK(bev == nullptr);
 
+  // Assign the listener to an event loop. Note that accepted sockets
+  // get their own loop assignment (see below) so that connections are
+  // distributed across the loop threads.
+  ev_base = next_base();
+
   // NOTE: Accepted sockets are nonblocking by default in libevent, but
   // can be set to block via the `LEV_OPT_LEAVE_SOCKETS_BLOCKING`
   // flag for `evconnlistener_new`.
   listener = evconnlistener_new(
-      base,
+      ev_base,
       [](evconnlistener* listener,
          evutil_socket_t socket,
          sockaddr* addr,
@@ -942,9 +976,9 @@ Try<Nothing> LibeventSSLSocketImpl::listen(int backlog)
             VLOG(2) << "Could not convert sockaddr to net::IP: " << ip.error();
           }
 
-          // We pass the 'listener' into the 'AcceptRequest' because
-          // this function could be executed before 'this->listener'
-          // is set.
+          // We assign the accepted socket to an event loop
+          // round-robin so that connections are distributed across
+          // the loop threads.
           AcceptRequest* request =
             new AcceptRequest(
                   // NOTE: The `int_fd` must be explicitly constructed
@@ -952,7 +986,7 @@ Try<Nothing> LibeventSSLSocketImpl::listen(int backlog)
                   // resulting in a `HANDLE` instead of a `SOCKET` on
                   // Windows.
                   int_fd(socket),
-                  listener,
+                  next_base(),
                   ip.isSome() ? Option<net::IP>(ip.get()) : None());
 
           impl->accept_callback(request);
@@ -1082,16 +1116,24 @@ void LibeventSSLSocketImpl::accept_callback(AcceptRequest* request)
   // If we support downgrading the connection, first wait for this
   // socket to become readable. We will then MSG_PEEK it to test
   // whether we want to dispatch as SSL or non-SSL.
+  //
+  // Note that we create the peek event on the loop assigned to the
+  // accepted socket so that 'peek_callback' (and hence
+  // 'accept_SSL_callback') runs on the thread that owns the loop on
+  // which the bufferevent will be created.
   if (openssl::flags().support_downgrade) {
     request->peek_event = event_new(
-        base,
+        request->base,
         request->socket,
         EV_READ,
         &LibeventSSLSocketImpl::peek_callback,
         request);
     event_add(request->peek_event, nullptr);
   } else {
-    accept_SSL_callback(request);
+    run_in_event_loop(
+        request->base,
+        [request]() { accept_SSL_callback(request); },
+        DISALLOW_SHORT_CIRCUIT);
   }
 }
 
@@ -1108,11 +1150,11 @@ void LibeventSSLSocketImpl::accept_SSL_callback(AcceptRequest* request)
     return;
   }
 
-  // We use 'request->listener' because 'this->listener' may not have
-  // been set by the time this function is executed. See comment in
-  // the lambda for evconnlistener_new in
-  // 'LibeventSSLSocketImpl::listen'.
-  event_base* ev_base = evconnlistener_get_base(request->listener);
+  // The event loop that was assigned to the accepted socket. Note
+  // that we are running on this loop's thread (see the comments in
+  // 'accept_callback'), so creating the bufferevent and assigning
+  // its callbacks below does not race with the handshake events.
+  event_base* ev_base = request->base;
 
   // Construct the bufferevent in the accepting state.
   bufferevent* bev = bufferevent_openssl_socket_new(
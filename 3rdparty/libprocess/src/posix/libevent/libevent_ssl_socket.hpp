@@ -72,15 +72,17 @@ private:
   {
     AcceptRequest(
         int_fd _socket,
-        evconnlistener* _listener,
+        event_base* _base,
         const Option<net::IP>& _ip)
       : peek_event(nullptr),
-        listener(_listener),
+        base(_base),
         socket(_socket),
         ip(_ip) {}
     event* peek_event;
     Promise<std::shared_ptr<SocketImpl>> promise;
-    evconnlistener* listener;
+    // The event loop assigned to the accepted socket. Accepted
+    // sockets are distributed across the event loops round-robin.
+    event_base* base;
     int_fd socket;
     Option<net::IP> ip;
   };
@@ -148,6 +150,13 @@ private:
 
   evconnlistener* listener;
 
+  // The event loop that owns 'bev' (or 'listener'). All bufferevent
+  // manipulation must run as a continuation on this loop's thread
+  // (see the 'Continuation' comment in the implementation). Assigned
+  // round-robin (see 'next_base()') when the socket connects, listens
+  // or is accepted; remains nullptr for sockets that never do.
+  event_base* ev_base;
+
   // Protects the following instance variables.
   std::atomic_flag lock = ATOMIC_FLAG_INIT;
   Owned<RecvRequest> recv_request;
@@ -156,7 +165,8 @@ private:
 
   // Indicates whether or not an EOF has been received on this socket.
   // Our accesses to this member are not synchronized because they all
-  // occur within the event loop, which runs on a single thread.
+  // occur on the thread of the event loop that owns this socket's
+  // bufferevent.
   bool received_eof = false;
 
   // This is a weak pointer to 'this', i.e., ourselves, this class
@@ -189,6 +199,11 @@ private:
 
   Option<std::string> peer_hostname;
   Option<net::IP> peer_ip;
+
+  // Key under which the TLS session negotiated on an outgoing
+  // connection is cached for resumption (see `openssl::cache_session`).
+  // Only set on connecting (client-side) sockets.
+  Option<std::string> peer_session_key;
 };
 
 } // namespace internal {
@@ -17,8 +17,10 @@
 #include <sys/prctl.h>
 #include <sys/syscall.h>
 #endif // __linux__
+#include <spawn.h>
 #include <sys/types.h>
 
+#include <list>
 #include <string>
 
 #include <glog/logging.h>
@@ -35,6 +37,7 @@
 #include <stout/none.hpp>
 #include <stout/option.hpp>
 #include <stout/os.hpp>
+#include <stout/stringify.hpp>
 #include <stout/try.hpp>
 #include <stout/unreachable.hpp>
 
@@ -308,6 +311,97 @@ inline int childMain(
 }
 
 
+// Whether `posix_spawn` can close stray file descriptors in the
+// child itself. Without this, the descriptor hygiene of the fork path
+// (which closes descriptors in the child's frozen descriptor table)
+// cannot be reproduced race-free: enumerating descriptors in the
+// parent can both miss descriptors created by other threads after the
+// enumeration and fail at spawn time on descriptors closed after it.
+#if defined(__GLIBC__) && defined(__GLIBC_PREREQ)
+#if __GLIBC_PREREQ(2, 34)
+#define PROCESS_HAS_POSIX_SPAWN_ADDCLOSEFROM 1
+#endif
+#endif
+
+
+// Launches the child with `posix_spawn`, which (on Linux) uses vfork
+// semantics and thus avoids duplicating the parent's page tables the
+// way `fork` does -- significant when the parent has a large resident
+// set. Callers must ensure that nothing needs to run between `fork`
+// and `exec`: no custom clone function, no parent or child hooks, and
+// no whitelisted file descriptors to preserve.
+inline Try<pid_t> spawnChild(
+    const std::string& path,
+    char** argv,
+    char** envp,
+    const InputFileDescriptors& stdinfds,
+    const OutputFileDescriptors& stdoutfds,
+    const OutputFileDescriptors& stderrfds)
+{
+  posix_spawn_file_actions_t actions;
+
+  int error = ::posix_spawn_file_actions_init(&actions);
+  if (error != 0) {
+    return Error(
+        "Failed to initialize spawn file actions: " + os::strerror(error));
+  }
+
+  // Redirect I/O for stdin/stdout/stderr. The `dup2` actions clear
+  // close-on-exec on the duplicates, while the originals (which
+  // `subprocess` marked close-on-exec) go away at exec time, just
+  // like in `childMain`.
+  if (error == 0) {
+    error = ::posix_spawn_file_actions_adddup2(
+        &actions, stdinfds.read, STDIN_FILENO);
+  }
+  if (error == 0) {
+    error = ::posix_spawn_file_actions_adddup2(
+        &actions, stdoutfds.write, STDOUT_FILENO);
+  }
+  if (error == 0) {
+    error = ::posix_spawn_file_actions_adddup2(
+        &actions, stderrfds.write, STDERR_FILENO);
+  }
+
+  if (error != 0) {
+    ::posix_spawn_file_actions_destroy(&actions);
+    return Error(
+        "Failed to set up spawn file actions: " + os::strerror(error));
+  }
+
+#ifdef PROCESS_HAS_POSIX_SPAWN_ADDCLOSEFROM
+  // Close stray file descriptors in the child, mirroring what
+  // `handleWhitelistFds` does on the fork path. The redirections
+  // above run first, so everything past stderr can go; performing
+  // the close in the child's own (frozen) descriptor table avoids
+  // racing with other threads creating or closing descriptors in
+  // the parent. Note that this also closes descriptors marked
+  // close-on-exec, which would not have survived the exec anyway.
+  error = ::posix_spawn_file_actions_addclosefrom_np(
+      &actions, STDERR_FILENO + 1);
+
+  if (error != 0) {
+    ::posix_spawn_file_actions_destroy(&actions);
+    return Error("Failed to add closefrom action: " + os::strerror(error));
+  }
+#endif
+
+  // Use `posix_spawnp` to get the same `PATH` lookup semantics as
+  // the `os::execvpe` call on the fork path.
+  pid_t pid;
+  error = ::posix_spawnp(&pid, path.c_str(), &actions, nullptr, argv, envp);
+
+  ::posix_spawn_file_actions_destroy(&actions);
+
+  if (error != 0) {
+    return Error(
+        "Failed to posix_spawnp '" + path + "': " + os::strerror(error));
+  }
+
+  return pid;
+}
+
+
 inline Try<pid_t> cloneChild(
     const std::string& path,
     std::vector<std::string> argv,
@@ -357,6 +451,23 @@ inline Try<pid_t> cloneChild(
   lambda::function<pid_t(const lambda::function<int()>&)> clone =
     (_clone.isSome() ? _clone.get() : defaultClone);
 
+  // When nothing needs to run between `fork` and `exec` we can use
+  // `posix_spawn` instead of forking, which avoids copying the
+  // parent's page tables -- something that gets expensive (and can
+  // draw the OOM killer's attention) when the parent has a large
+  // resident set.
+#ifdef PROCESS_HAS_POSIX_SPAWN_ADDCLOSEFROM
+  const bool spawnable =
+    _clone.isNone() &&
+    parent_hooks.empty() &&
+    child_hooks.empty() &&
+    whitelist_fds.empty();
+#else
+  // Without a child-side closefrom spawn action we cannot replicate
+  // the fork path's descriptor hygiene race-free, so keep forking.
+  const bool spawnable = false;
+#endif
+
   // Currently we will block the child's execution of the new process
   // until all the `parent_hooks` (if any) have executed.
   std::array<int, 2> pipes;
@@ -371,19 +482,38 @@ inline Try<pid_t> cloneChild(
     pipes = pipe.get();
   }
 
-  // Now, clone the child process.
-  pid_t pid = clone(lambda::bind(
-      &childMain,
-      path,
-      _argv,
-      envp,
-      stdinfds,
-      stdoutfds,
-      stderrfds,
-      whitelist_fds,
-      blocking,
-      pipes.data(),
-      child_hooks));
+  // Now, spawn or clone the child process.
+  pid_t pid = -1;
+  Option<Error> error = None();
+
+  if (spawnable) {
+    Try<pid_t> spawned =
+      spawnChild(path, _argv, envp, stdinfds, stdoutfds, stderrfds);
+
+    if (spawned.isError()) {
+      error = Error(spawned.error());
+    } else {
+      pid = spawned.get();
+    }
+  } else {
+    pid = clone(lambda::bind(
+        &childMain,
+        path,
+        _argv,
+        envp,
+        stdinfds,
+        stdoutfds,
+        stderrfds,
+        whitelist_fds,
+        blocking,
+        pipes.data(),
+        child_hooks));
+
+    if (pid == -1) {
+      // Save the errno as the cleanup below might overwrite it.
+      error = ErrnoError("Failed to clone");
+    }
+  }
 
   delete[] _argv;
 
@@ -400,9 +530,7 @@ inline Try<pid_t> cloneChild(
     delete[] envp;
   }
 
-  if (pid == -1) {
-    // Save the errno as 'close' below might overwrite it.
-    ErrnoError error("Failed to clone");
+  if (error.isSome()) {
     internal::close(stdinfds, stdoutfds, stderrfds);
 
     if (blocking) {
@@ -410,7 +538,7 @@ inline Try<pid_t> cloneChild(
       os::close(pipes[1]);
     }
 
-    return error;
+    return error.get();
   }
 
   // Close the child-ends of the file descriptors that are created by
@@ -43,9 +43,12 @@
 #endif // __WINDOWS__
 
 #include <algorithm>
+#include <array>
+#include <chrono>
 #include <deque>
 #include <fstream>
 #include <iomanip>
+#include <limits>
 #include <list>
 #include <map>
 #include <memory> // TODO(benh): Replace shared_ptr with unique_ptr.
@@ -108,6 +111,7 @@
 #include <stout/stringify.hpp>
 #include <stout/strings.hpp>
 #include <stout/synchronized.hpp>
+#include <stout/unreachable.hpp>
 
 #include "authenticator_manager.hpp"
 #include "config.hpp"
@@ -296,6 +300,133 @@ map<string, string> types;
 } // namespace mime {
 
 
+// Interval at which enqueued events get sampled for the per-process
+// latency and queue depth histograms (i.e., 1 of every N enqueued
+// events is sampled), or 0 if sampling is disabled (the default).
+// Set via the `LIBPROCESS_EVENT_LATENCY_SAMPLING` environment
+// variable, which is parsed in the `ProcessManager` constructor,
+// i.e., before any process can be spawned.
+static size_t event_sampling_interval = 0;
+
+
+// Returns the current monotonic clock reading in nanoseconds, used
+// to timestamp sampled events. We deliberately bypass `Clock::now()`
+// so that latency measurements remain meaningful when the clock is
+// paused (e.g., in tests).
+static int64_t nanoseconds_now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+// Per-process instrumentation collected when event latency sampling
+// is enabled, see `event_sampling_interval` above.
+struct ProcessProfile
+{
+  // An HDR style histogram with one bucket per power of two, i.e.,
+  // bucket i counts sampled values v with 2^i <= v < 2^(i+1) (with
+  // zero counted by bucket 0). This bounds the relative error of any
+  // reported quantile by a factor of 2 while keeping recording a
+  // couple of increments.
+  struct Histogram
+  {
+    void record(uint64_t value)
+    {
+      size_t bucket = 0;
+      while (value >>= 1) {
+        bucket++;
+      }
+      buckets[bucket]++;
+      count++;
+    }
+
+    // Returns an upper bound on the quantile `q` in [0.0, 1.0], or 0
+    // if nothing has been recorded.
+    uint64_t quantile(double q) const
+    {
+      if (count == 0) {
+        return 0;
+      }
+
+      uint64_t rank = std::min(
+          count - 1, static_cast<uint64_t>(q * static_cast<double>(count)));
+
+      uint64_t seen = 0;
+      for (size_t i = 0; i < buckets.size(); i++) {
+        seen += buckets[i];
+        if (seen > rank) {
+          return bound(i);
+        }
+      }
+
+      UNREACHABLE();
+    }
+
+    // Returns the (inclusive) upper bound of the i-th bucket.
+    static uint64_t bound(size_t i)
+    {
+      return i < 63
+        ? (uint64_t(2) << i) - 1
+        : std::numeric_limits<uint64_t>::max();
+    }
+
+    JSON::Object json() const
+    {
+      JSON::Object object;
+      object.values["count"] = count;
+      object.values["p50"] = quantile(0.5);
+      object.values["p90"] = quantile(0.9);
+      object.values["p99"] = quantile(0.99);
+      object.values["max"] = quantile(1.0);
+
+      JSON::Array array;
+      for (size_t i = 0; i < buckets.size(); i++) {
+        if (buckets[i] != 0) {
+          JSON::Object bucket;
+          bucket.values["upper_bound"] = bound(i);
+          bucket.values["count"] = buckets[i];
+          array.values.push_back(std::move(bucket));
+        }
+      }
+      object.values["buckets"] = std::move(array);
+
+      return object;
+    }
+
+    uint64_t count = 0;
+    std::array<uint64_t, 64> buckets = {};
+  };
+
+  JSON::Object json() const
+  {
+    JSON::Object object;
+    object.values["sampling_interval"] = event_sampling_interval;
+    object.values["enqueue_latency_ns"] = latency.json();
+    object.values["queue_depth"] = depths.json();
+    return object;
+  }
+
+  // Number of events enqueued so far; used to pick every Nth event
+  // for sampling.
+  std::atomic<size_t> enqueues = ATOMIC_VAR_INIT(0);
+
+  // Approximate number of currently queued events, maintained on
+  // enqueue and dequeue. Approximate because events that get dropped
+  // on termination are not always accounted for.
+  std::atomic<long> depth = ATOMIC_VAR_INIT(0);
+
+  // Histograms of the sampled enqueue-to-execute latencies (in
+  // nanoseconds) and of the queue depth observed when a sampled
+  // event got executed. Only written from `ProcessManager::resume`
+  // (which acts as the single consumer of the event queue) and read
+  // while executing within the process, so no synchronization is
+  // needed.
+  Histogram latency;
+  Histogram depths;
+};
+
+
 // Helper for creating routes without a process.
 // TODO(benh): Move this into route.hpp.
 class Route
@@ -427,9 +558,28 @@ private:
   // Delegate process name to receive root HTTP requests.
   const Option<string> delegate;
 
-  // Map of all local spawned and running processes.
-  hashmap<string, ProcessBase*> processes;
-  std::recursive_mutex processes_mutex;
+  // Map of all local spawned and running processes, sharded by a
+  // hash of the process id. Every message delivery resolves its
+  // destination `UPID` through this table, so guarding it with a
+  // single mutex serializes the message hot path across all worker
+  // threads. The mutexes are recursive because a critical section
+  // may re-enter the table (e.g., `SocketManager::exited()` is
+  // invoked from within `cleanup()` and can cause lookups).
+  struct ProcessTableShard
+  {
+    hashmap<string, ProcessBase*> processes;
+    std::recursive_mutex mutex;
+  };
+
+  static constexpr size_t PROCESS_TABLE_SHARDS = 64;
+
+  std::array<ProcessTableShard, PROCESS_TABLE_SHARDS> process_table;
+
+  // Returns the shard that owns the given process id.
+  ProcessTableShard& process_table_shard(const string& id)
+  {
+    return process_table[std::hash<string>()(id) % PROCESS_TABLE_SHARDS];
+  }
 
   // Queue of runnable processes.
   //
@@ -687,6 +837,87 @@ static void transport(
 }
 
 
+// Optional recording of delivered message events, enabled by setting
+// `LIBPROCESS_MESSAGE_TRACE` in the environment to the path of the
+// trace file. Every record describes one delivered message in the
+// following layout (all integers in host byte order):
+//
+//   uint64_t  timestamp in nanoseconds since the epoch
+//   uint32_t  length of the message name, followed by the name
+//   uint32_t  length of the stringified sender PID, followed by it
+//   uint32_t  length of the stringified receiver PID, followed by it
+//   uint32_t  size of the message body (the body itself is elided)
+//
+// The trace is intended to be replayed against a test instance to
+// benchmark fixes against recorded production workloads; see
+// `src/tests/message_replay.hpp` in the mesos repository. Note that
+// recording adds a synchronized file write to every message delivery,
+// so it should only be enabled when capturing a workload.
+class MessageTraceRecorder
+{
+public:
+  static MessageTraceRecorder* instance()
+  {
+    static MessageTraceRecorder* recorder = new MessageTraceRecorder();
+    return recorder;
+  }
+
+  bool enabled() const
+  {
+    return file.is_open();
+  }
+
+  void record(const Message& message)
+  {
+    const uint64_t timestamp = Clock::now().duration().ns();
+    const string from = stringify(message.from);
+    const string to = stringify(message.to);
+
+    synchronized (mutex) {
+      write(timestamp);
+      write(message.name);
+      write(from);
+      write(to);
+      write(static_cast<uint32_t>(message.body.size()));
+    }
+  }
+
+private:
+  MessageTraceRecorder()
+  {
+    Option<string> path = os::getenv("LIBPROCESS_MESSAGE_TRACE");
+
+    if (path.isSome()) {
+      file.open(
+          path->c_str(),
+          std::ios::out | std::ios::binary | std::ios::trunc);
+
+      if (file.is_open()) {
+        LOG(INFO) << "Recording message trace to '" << path.get() << "'";
+      } else {
+        LOG(ERROR) << "Failed to open message trace file '"
+                   << path.get() << "'";
+      }
+    }
+  }
+
+  template <typename T>
+  void write(const T& value)
+  {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  void write(const string& value)
+  {
+    write(static_cast<uint32_t>(value.size()));
+    file.write(value.data(), value.size());
+  }
+
+  std::mutex mutex;
+  std::ofstream file;
+};
+
+
 // Returns true if `request` contains an inbound libprocess message.
 // A libprocess message can either be sent by another instance of
 // libprocess (i.e. both of the "User-Agent" and "Libprocess-From"
@@ -1883,7 +2114,8 @@ void SocketManager::send(
 void SocketManager::send_connect(
     const Future<Nothing>& future,
     Socket socket,
-    Message&& message)
+    Message&& message,
+    const std::shared_ptr<const string>& body)
 {
   if (future.isDiscarded() || future.isFailed()) {
     if (future.isFailed()) {
@@ -1929,8 +2161,8 @@ void SocketManager::send_connect(
       connect.onAny(lambda::bind(
           // TODO(benh): with C++14 we can use lambda instead of
           // `std::bind` and capture `message` with a `std::move`.
-          [this, poll_socket](Message& message, const Future<Nothing>& f) {
-            send_connect(f, poll_socket.get(), std::move(message));
+          [this, poll_socket, body](Message& message, const Future<Nothing>& f) {
+            send_connect(f, poll_socket.get(), std::move(message), body);
           },
           std::move(message),
           lambda::_1));
@@ -1946,7 +2178,7 @@ void SocketManager::send_connect(
     return;
   }
 
-  Encoder* encoder = new MessageEncoder(message);
+  Encoder* encoder = new MessageEncoder(message, body);
 
   // Receive and ignore data from this socket. Note that we don't
   // expect to receive anything other than HTTP '202 Accepted'
@@ -1967,6 +2199,21 @@ void SocketManager::send_connect(
 
 
 void SocketManager::send(Message&& message, const SocketImpl::Kind& kind)
+{
+  // Move the body into a refcounted buffer. When broadcasting, the
+  // caller provides a single buffer shared across all destinations
+  // via the overload below.
+  const std::shared_ptr<const string> body =
+    std::make_shared<const string>(std::move(message.body));
+
+  send(std::move(message), body, kind);
+}
+
+
+void SocketManager::send(
+    Message&& message,
+    const std::shared_ptr<const string>& body,
+    const SocketImpl::Kind& kind)
 {
   const Address& address = message.to.address;
 
@@ -1989,7 +2236,7 @@ void SocketManager::send(Message&& message, const SocketImpl::Kind& kind)
       }
 
       if (outgoing.count(socket.get()) > 0) {
-        outgoing[socket.get()].push(new MessageEncoder(message));
+        outgoing[socket.get()].push(new MessageEncoder(message, body));
         return;
       } else {
         // Initialize the outgoing queue.
@@ -2033,13 +2280,13 @@ void SocketManager::send(Message&& message, const SocketImpl::Kind& kind)
       .onAny(lambda::bind(
             // TODO(benh): with C++14 we can use lambda instead of
             // `std::bind` and capture `message` with a `std::move`.
-            [this, socket](Message& message, const Future<Nothing>& f) {
-              send_connect(f, socket.get(), std::move(message));
+            [this, socket, body](Message& message, const Future<Nothing>& f) {
+              send_connect(f, socket.get(), std::move(message), body);
             }, std::move(message), lambda::_1));
   } else {
     // If we're not connecting and we haven't added the encoder to
     // the 'outgoing' queue then schedule it to be sent.
-    internal::send(new MessageEncoder(message), socket.get());
+    internal::send(new MessageEncoder(message, body), socket.get());
   }
 }
 
@@ -2400,7 +2647,27 @@ ProcessManager::ProcessManager(const Option<string>& _delegate)
   : delegate(_delegate),
     running(0),
     joining_threads(false),
-    finalizing(false) {}
+    finalizing(false)
+{
+  // We allow the operator to sample 1 of every N enqueued events
+  // into per-process enqueue-to-execute latency and queue depth
+  // histograms, exposed via `/__processes__?histograms=1`. Sampling
+  // (rather than timestamping every event) keeps the overhead
+  // negligible even for busy processes.
+  constexpr char env_var[] = "LIBPROCESS_EVENT_LATENCY_SAMPLING";
+  Option<string> value = os::getenv(env_var);
+  if (value.isSome()) {
+    Try<size_t> interval = numify<size_t>(value->c_str());
+    if (interval.isSome()) {
+      event_sampling_interval = interval.get();
+    } else {
+      LOG(WARNING) << "Ignoring invalid value " << value.get()
+                   << " for " << env_var
+                   << ", sampling remains disabled. Valid values are"
+                   << " non-negative integers";
+    }
+  }
+}
 
 
 ProcessManager::~ProcessManager() {}
@@ -2422,14 +2689,21 @@ void ProcessManager::finalize()
     // If the process has already terminated, further termination
     // is a noop.
     UPID pid;
-
-    synchronized (processes_mutex) {
-      if (processes.empty()) {
-        break;
+    bool found = false;
+
+    foreach (ProcessTableShard& shard, process_table) {
+      synchronized (shard.mutex) {
+        if (!shard.processes.empty()) {
+          // Grab the `UPID` for the next process we'll terminate.
+          pid = shard.processes.begin()->second->self();
+          found = true;
+          break;
+        }
       }
+    }
 
-      // Grab the `UPID` for the next process we'll terminate.
-      pid = processes.begin()->second->self();
+    if (!found) {
+      break;
     }
 
     // Terminate this process but do not inject the message,
@@ -2541,8 +2815,9 @@ ProcessReference ProcessManager::use(const UPID& pid)
   }
 
   if (pid.address == __address__) {
-    synchronized (processes_mutex) {
-      Option<ProcessBase*> process = processes.get(pid.id);
+    ProcessTableShard& shard = process_table_shard(pid.id);
+    synchronized (shard.mutex) {
+      Option<ProcessBase*> process = shard.processes.get(pid.id);
       if (process.isSome()) {
         return ProcessReference(process.get()->reference);
       }
@@ -2796,6 +3071,15 @@ bool ProcessManager::deliver(
 {
   CHECK(event != nullptr);
 
+  // The flag is latched on the first delivery so that the environment
+  // lookup is not repeated on this hot path.
+  static const bool tracing = MessageTraceRecorder::instance()->enabled();
+
+  if (tracing && event->is<MessageEvent>()) {
+    MessageTraceRecorder::instance()->record(
+        event->as<MessageEvent>().message);
+  }
+
   if (ProcessReference receiver = use(to)) {
     return deliver(receiver, event, sender);
   }
@@ -2824,12 +3108,13 @@ UPID ProcessManager::spawn(ProcessBase* process, bool manage)
       << "Attempted to spawn a process (" << process->self()
       << ") that has already been initialized";
   } else {
-    synchronized (processes_mutex) {
-      if (processes.count(process->pid.id) > 0) {
+    ProcessTableShard& shard = process_table_shard(process->pid.id);
+    synchronized (shard.mutex) {
+      if (shard.processes.count(process->pid.id) > 0) {
         LOG(WARNING)
           << "Attempted to spawn already running process " << process->pid;
       } else {
-        processes[process->pid.id] = process;
+        shard.processes[process->pid.id] = process;
 
         // NOTE: we set process reference on it's `UPID` _after_ we've
         // spawned so that we make sure that we'll take the
@@ -2959,6 +3244,18 @@ void ProcessManager::resume(ProcessBase* process)
     if (!blocked) {
       CHECK_NOTNULL(event);
 
+      if (process->profile != nullptr) {
+        long depth =
+          process->profile->depth.fetch_sub(1, std::memory_order_relaxed) - 1;
+
+        if (event->enqueue_time_ns != 0) {
+          process->profile->latency.record(static_cast<uint64_t>(std::max(
+              int64_t(0), nanoseconds_now() - event->enqueue_time_ns)));
+          process->profile->depths.record(
+              static_cast<uint64_t>(std::max(0L, depth)));
+        }
+      }
+
       // Before serving this event check if we've triggered a
       // terminate and if so purge all events until we get to the
       // terminate event.
@@ -2969,6 +3266,10 @@ void ProcessManager::resume(ProcessBase* process)
           delete event;
           event = process->events->consumer.dequeue();
           CHECK_NOTNULL(event);
+
+          if (process->profile != nullptr) {
+            process->profile->depth.fetch_sub(1, std::memory_order_relaxed);
+          }
         }
       }
 
@@ -3046,9 +3347,9 @@ void ProcessManager::cleanup(ProcessBase* process)
   // First, set the terminating state so no more events will get
   // enqueued and then decomission the event queue which will also
   // delete all the pending events. We want to delete the events
-  // before we hold `processes_mutex` because deleting an event could
-  // cause code outside libprocess to get executed which might cause a
-  // deadlock with `processes_mutex`. Also, deleting the events now
+  // before we hold the process table shard's mutex because deleting
+  // an event could cause code outside libprocess to get executed
+  // which might cause a deadlock. Also, deleting the events now
   // rather than later has the nice property of making sure that any
   // _new_ events that might have gotten enqueued _BACK_ onto this
   // process due to the deleting of the pending events will get
@@ -3066,11 +3367,12 @@ void ProcessManager::cleanup(ProcessBase* process)
   std::shared_ptr<Gate> gate = process->gate;
 
   // Remove process.
-  synchronized (processes_mutex) {
+  ProcessTableShard& shard = process_table_shard(process->pid.id);
+  synchronized (shard.mutex) {
     // Reset the reference so that we don't keep giving out references
     // in `ProcessManager::use`.
     //
-    // NOTE: this must be done from within the `processes_mutex` since
+    // NOTE: this must be done while holding the shard's mutex since
     // that is where we read it and this is considered a write.
     process->reference.reset();
 
@@ -3082,7 +3384,7 @@ void ProcessManager::cleanup(ProcessBase* process)
 #endif
     }
 
-    processes.erase(process->pid.id);
+    shard.processes.erase(process->pid.id);
 
     // Note that we don't remove the process from the clock during
     // cleanup, but rather the clock is reset for a process when it is
@@ -3096,7 +3398,7 @@ void ProcessManager::cleanup(ProcessBase* process)
 
     // Now we tell the socket manager about this process exiting so
     // that it can create exited events for linked processes. We
-    // _must_ do this while synchronized on processes because
+    // _must_ do this while synchronized on the shard because
     // otherwise another process could attempt to link this process
     // and `SocketManager::link()` would see that the processes
     // doesn't exist when it attempts to get a `ProcessReference`
@@ -3114,10 +3416,10 @@ void ProcessManager::cleanup(ProcessBase* process)
     // will only return _after_ we open the gate below.
     // ***************************************************************
 
-    // Note that we need to open the gate within `synchronized
-    // (processes_mutex)` so that there is a happens-before
-    // relationship with respect to a process terminating and another
-    // process starting with the same `UPID`.
+    // Note that we need to open the gate while holding the shard's
+    // mutex so that there is a happens-before relationship with
+    // respect to a process terminating and another process starting
+    // with the same `UPID` (which necessarily uses the same shard).
     CHECK(gate);
     gate->open();
   }
@@ -3268,12 +3570,15 @@ string ProcessManager::absolutePath(const string& path)
     return path;
   }
 
-  if (processes.find(decode.get()) != processes.end()) {
-    // Return path when the first token is a process id.
-    return path;
-  } else {
-    return "/" + delegate.get() + path;
+  ProcessTableShard& shard = process_table_shard(decode.get());
+  synchronized (shard.mutex) {
+    if (shard.processes.contains(decode.get())) {
+      // Return path when the first token is a process id.
+      return path;
+    }
   }
+
+  return "/" + delegate.get() + path;
 }
 
 
@@ -3387,28 +3692,44 @@ void ProcessManager::settle()
 }
 
 
-Future<Response> ProcessManager::__processes__(const Request&)
-{
-  synchronized (processes_mutex) {
-    return collect(lambda::map(
-        [](ProcessBase* process) {
-          // TODO(benh): Try and "inject" this dispatch or create a
-          // high-priority set of events (i.e., mailbox).
-          return dispatch(
-              process->self(),
-              [process]() -> JSON::Object {
-                return *process;
-              });
-        },
-        process_manager->processes.values()))
-      .then([](const std::vector<JSON::Object>& objects) -> Response {
-        JSON::Array array;
-        foreach (const JSON::Object& object, objects) {
-          array.values.push_back(object);
-        }
-        return OK(array);
-      });
+Future<Response> ProcessManager::__processes__(const Request& request)
+{
+  // More detail can be requested via `?histograms=1`, which includes
+  // the sampled per-process latency and queue depth histograms (only
+  // collected when `LIBPROCESS_EVENT_LATENCY_SAMPLING` is set).
+  const bool histograms = request.url.query.contains("histograms");
+
+  std::vector<Future<JSON::Object>> futures;
+
+  foreach (ProcessTableShard& shard, process_table) {
+    synchronized (shard.mutex) {
+      // NOTE: we dispatch while holding the shard's mutex so that a
+      // process can't get cleaned up in between us grabbing the
+      // pointer and the dispatch resolving it.
+      foreach (ProcessBase* process, shard.processes.values()) {
+        // TODO(benh): Try and "inject" this dispatch or create a
+        // high-priority set of events (i.e., mailbox).
+        futures.push_back(dispatch(
+            process->self(),
+            [process, histograms]() -> JSON::Object {
+              JSON::Object object = *process;
+              if (histograms && process->profile != nullptr) {
+                object.values["histograms"] = process->profile->json();
+              }
+              return object;
+            }));
+      }
+    }
   }
+
+  return collect(futures)
+    .then([](const std::vector<JSON::Object>& objects) -> Response {
+      JSON::Array array;
+      foreach (const JSON::Object& object, objects) {
+        array.values.push_back(object);
+      }
+      return OK(array);
+    });
 }
 
 
@@ -3423,6 +3744,10 @@ ProcessBase::ProcessBase(const string& id)
   pid.address = __address__;
   pid.addresses.v6 = __address6__;
 
+  if (event_sampling_interval > 0) {
+    profile.reset(new ProcessProfile());
+  }
+
   // If using a manual clock, try and set current time of process
   // using happens before relationship between creator (__process__)
   // and createe (this)!
@@ -3496,6 +3821,17 @@ void ProcessBase::enqueue(Event* event)
     case State::BOTTOM:
     case State::READY:
     case State::BLOCKED:
+      if (profile != nullptr) {
+        profile->depth.fetch_add(1, std::memory_order_relaxed);
+
+        // Timestamp 1 of every `event_sampling_interval` events.
+        // NOTE: we must not touch the event after enqueueing it, so
+        // the timestamp is taken (slightly conservatively) here.
+        if (profile->enqueues.fetch_add(1, std::memory_order_relaxed) %
+            event_sampling_interval == 0) {
+          event->enqueue_time_ns = nanoseconds_now();
+        }
+      }
       events->producer.enqueue(event);
       break;
     case State::TERMINATING:
@@ -3539,6 +3875,34 @@ void ProcessBase::send(
 }
 
 
+void ProcessBase::send(
+    const std::set<UPID>& to,
+    const string& name,
+    const char* data,
+    size_t length)
+{
+  // Serialize into a single refcounted buffer that can back the
+  // encoders of all remote destinations, rather than giving each
+  // destination its own copy of the body.
+  const std::shared_ptr<const string> body =
+    std::make_shared<const string>(data, length);
+
+  foreach (const UPID& upid, to) {
+    if (!upid) {
+      continue;
+    }
+
+    if (upid.address == __address__) {
+      // Local messages still get their own copy, since a
+      // MessageEvent owns its message's body.
+      transport(pid, upid, name, data, length, this);
+    } else {
+      socket_manager->send(encode(pid, upid, string(name), string()), body);
+    }
+  }
+}
+
+
 void ProcessBase::send(
     const UPID& to,
     string&& name)
@@ -3579,7 +3943,7 @@ void ProcessBase::consume(MessageEvent&& event)
 
 void ProcessBase::consume(DispatchEvent&& event)
 {
-  std::move(*event.f)(this);
+  std::move(event.f)(this);
 }
 
 
@@ -3621,14 +3985,24 @@ void ProcessBase::consume(HttpEvent&& event)
   // Look for an endpoint handler for this path. We begin with the full path,
   // but if no handler is found and the path is nested, we shorten it and look
   // again. For example: if the request is for '/a/b/c' and no handler is found,
-  // we will then check for '/a/b', and finally for '/a'.
-  while (Path(name, '/').dirname() != name) {
-    if (handlers.http.count(name) == 0) {
-      name = Path(name, '/').dirname();
+  // we will then check for '/a/b', and finally for '/a'. Note that we shrink
+  // the name in place rather than materializing each prefix so that resolving
+  // a route doesn't allocate.
+  while (true) {
+    auto handler = handlers.http.find(name);
+
+    if (handler == handlers.http.end()) {
+      size_t index = name.rfind('/');
+
+      if (index == string::npos) {
+        break;
+      }
+
+      name.resize(index);
       continue;
     }
 
-    const HttpEndpoint& endpoint = handlers.http[name];
+    const HttpEndpoint& endpoint = handler->second;
 
     Owned<Request> request(new Request(*event.request));
     Future<Response> response;
@@ -3721,7 +4095,7 @@ Future<Response> ProcessBase::_consume(
       [authentication]() { return authentication; });
 
   return authentication
-    .then(defer(self(), [this, endpoint, request, name](
+    .then(defer(self(), [this, endpoint, request](
         const Option<AuthenticationResult>& authentication)
           -> Future<Response> {
       Option<Principal> principal = None();
@@ -3759,7 +4133,9 @@ Future<Response> ProcessBase::_consume(
       Future<bool> authorization = true;
 
       if (authorization_callbacks.load() != nullptr) {
-        const string callback_path = path::join("/" + pid.id, name);
+        // Note that this path was precomputed when the route
+        // was installed.
+        const string& callback_path = endpoint.authorizationPath;
 
         synchronized (authorization_callbacks_mutex) {
           AuthorizationCallbacks* callbacks = authorization_callbacks.load();
@@ -3839,6 +4215,7 @@ void ProcessBase::route(
   HttpEndpoint endpoint;
   endpoint.handler = handler;
   endpoint.options = options;
+  endpoint.authorizationPath = path::join("/" + pid.id, name.substr(1));
 
   handlers.http[name.substr(1)] = endpoint;
 
@@ -3864,6 +4241,7 @@ void ProcessBase::route(
   endpoint.realm = realm;
   endpoint.authenticatedHandler = handler;
   endpoint.options = options;
+  endpoint.authorizationPath = path::join("/" + pid.id, name.substr(1));
 
   handlers.http[name.substr(1)] = endpoint;
 
@@ -4038,7 +4416,7 @@ namespace internal {
 
 void dispatch(
     const UPID& pid,
-    std::unique_ptr<lambda::CallableOnce<void(ProcessBase*)>> f,
+    lambda::CallableOnce<void(ProcessBase*)> f,
     const Option<const std::type_info*>& functionType)
 {
   process::initialize();
@@ -26,13 +26,44 @@
 #include "stout/format.hpp"
 #include "stout/option.hpp"
 #include "stout/os.hpp"
+#include "stout/path.hpp"
+
+#include "stout/os/stat.hpp"
 #include "stout/os/strerror.hpp"
 
 namespace process {
 
 #ifdef ENABLE_GPERFTOOLS
 namespace {
+
 constexpr char PROFILE_FILE[] = "perftools.out";
+
+
+// The directory where the profile is dumped. It is created lazily on
+// the first profiling run and reused afterwards, so that the profile
+// ends up in a writable location regardless of the current working
+// directory of the profiled process.
+Option<std::string> profileDirectory;
+
+
+Try<std::string> getProfilePath()
+{
+  if (profileDirectory.isNone()) {
+    const std::string tmpdir = os::getenv("TMPDIR").getOrElse("/tmp");
+
+    Try<std::string> directory =
+      os::mkdtemp(path::join(tmpdir, "libprocess.XXXXXX"));
+
+    if (directory.isError()) {
+      return Error(directory.error());
+    }
+
+    profileDirectory = directory.get();
+  }
+
+  return path::join(profileDirectory.get(), PROFILE_FILE);
+}
+
 } // namespace {
 #endif
 
@@ -42,7 +73,9 @@ const std::string Profiler::START_HELP()
     TLDR(
         "Start profiling."),
     DESCRIPTION(
-        "Start to use google perftools do profiling."),
+        "Start to use google perftools do profiling.",
+        "The CPU profile is sampled until '/stop' is accessed and can",
+        "then be fetched from '/download'."),
     AUTHENTICATION(true));
 }
 
@@ -53,7 +86,25 @@ const std::string Profiler::STOP_HELP()
     TLDR(
         "Stops profiling."),
     DESCRIPTION(
-        "Stop to use google perftools do profiling."),
+        "Stop to use google perftools do profiling.",
+        "Returns the collected profile; it also remains available",
+        "through the '/download' endpoint."),
+    AUTHENTICATION(true));
+}
+
+
+const std::string Profiler::DOWNLOAD_HELP()
+{
+  return HELP(
+    TLDR(
+        "Returns the last collected CPU profile."),
+    DESCRIPTION(
+        "Returns the profile dumped when '/stop' was last accessed, in",
+        "the format understood by pprof. Analyze it with e.g.",
+        "",
+        "    pprof -flame /path/to/binary profile",
+        "",
+        "or convert it to collapsed stacks for flamegraph tooling."),
     AUTHENTICATION(true));
 }
 
@@ -76,6 +127,12 @@ Future<http::Response> Profiler::start(
     return http::BadRequest("Profiler already started.\n");
   }
 
+  Try<std::string> path = getProfilePath();
+  if (path.isError()) {
+    return http::InternalServerError(
+        "Failed to determine profile location: " + path.error() + ".\n");
+  }
+
   LOG(INFO) << "Starting Profiler";
 
   // WARNING: If using libunwind < 1.0.1, profiling should not be used, as
@@ -86,7 +143,7 @@ Future<http::Response> Profiler::start(
   // here:
   // https://groups.google.com/d/topic/google-perftools/Df10Uy4Djrg/discussion
   // NOTE: We have not tested this with libunwind > 1.0.1.
-  if (!ProfilerStart(PROFILE_FILE)) {
+  if (!ProfilerStart(path->c_str())) {
     Try<std::string> error =
       strings::format("Failed to start profiler: %s", os::strerror(errno));
     LOG(ERROR) << error.get();
@@ -116,14 +173,54 @@ Future<http::Response> Profiler::stop(
 
   ProfilerStop();
 
+  started = false;
+
+  // `getProfilePath()` cannot fail here since profiling was started.
+  profilePath = getProfilePath().get();
+
   http::OK response;
   response.type = response.PATH;
-  response.path = "perftools.out";
+  response.path = profilePath.get();
+  response.headers["Content-Type"] = "application/octet-stream";
+  response.headers["Content-Disposition"] =
+    strings::format("attachment; filename=%s", PROFILE_FILE).get();
+
+  return response;
+#else
+  return http::BadRequest(
+      "Perftools is disabled. To enable perftools, "
+      "configure libprocess with --enable-perftools.\n");
+#endif
+}
+
+
+Future<http::Response> Profiler::download(
+    const http::Request& request,
+    const Option<http::authentication::Principal>&)
+{
+#ifdef ENABLE_GPERFTOOLS
+  if (started) {
+    return http::BadRequest(
+        "A profiling run is in progress. Access '/stop' first.\n");
+  }
+
+  if (profilePath.isNone()) {
+    return http::BadRequest(
+        "No profile has been collected yet. Start a profiling run"
+        " with '/start' followed by '/stop'.\n");
+  }
+
+  if (!os::stat::isfile(profilePath.get())) {
+    return http::BadRequest("The profile was deleted from local disk.\n");
+  }
+
+  http::OK response;
+  response.type = response.PATH;
+  response.path = profilePath.get();
   response.headers["Content-Type"] = "application/octet-stream";
   response.headers["Content-Disposition"] =
     strings::format("attachment; filename=%s", PROFILE_FILE).get();
 
-  started = false;
   return response;
 #else
   return http::BadRequest(
@@ -22,6 +22,10 @@
 #endif // __MACH__
 
 #include <stout/check.hpp>
+#include <stout/numify.hpp>
+#include <stout/option.hpp>
+#include <stout/os.hpp>
+#include <stout/try.hpp>
 
 // TODO(benh): Introduce a user-level semaphore that _only_ traps into
 // the kernel if the thread would actually need to wait.
@@ -241,6 +245,23 @@ thread_local KernelSemaphore* __semaphore__ = nullptr;
   (__semaphore__ == nullptr ? __semaphore__ = new KernelSemaphore() \
                             : __semaphore__)
 
+
+// Hint to the processor that we're in a spin-wait loop, so it can
+// play nice with a hyperthread sharing the core (and save power).
+// Note that we don't call this `pause` to avoid conflicting with the
+// function of the same name declared in unistd.h.
+inline void spin_pause()
+{
+#ifdef __WINDOWS__
+  YieldProcessor();
+#elif defined(__i386__) || defined(__x86_64__)
+  asm volatile("pause");
+#elif defined(__aarch64__) || defined(__arm__)
+  asm volatile("yield");
+#endif
+}
+
+
 class DecomissionableLastInFirstOutFixedSizeSemaphore
 {
 public:
@@ -253,6 +274,23 @@ public:
     for (size_t i = 0; i < semaphores.size(); i++) {
       semaphores[i] = nullptr;
     }
+
+    // We allow the operator to tune how long a thread spins in
+    // `wait()` before parking on its semaphore, using an environment
+    // variable. Spinning longer trades CPU for lower wakeup latency
+    // at high dispatch rates; setting the value to 0 disables
+    // spinning entirely.
+    Option<std::string> value = os::getenv("LIBPROCESS_SEMAPHORE_SPIN_COUNT");
+    if (value.isSome()) {
+      Try<size_t> number = numify<size_t>(value->c_str());
+      if (number.isSome()) {
+        spins = number.get();
+      } else {
+        LOG(WARNING) << "Ignoring invalid value " << value.get()
+                     << " for LIBPROCESS_SEMAPHORE_SPIN_COUNT"
+                     << ", using default value " << spins;
+      }
+    }
   }
 
   void signal()
@@ -264,6 +302,18 @@ public:
     // always signal a new thread.
     count.fetch_add(1);
 
+    // If there are enough threads spinning to consume everything
+    // that has been enqueued then we can elide the (comparatively
+    // expensive) wakeup of a parked thread. A spinning thread is
+    // guaranteed to either observe the count we just added while
+    // spinning or re-check it one last time before parking (see
+    // `wait()`), so this cannot result in a lost wakeup. This
+    // effectively batches consecutive signals into zero kernel
+    // operations for as long as the spinning threads keep up.
+    if (spinners.load() >= count.load()) {
+      return;
+    }
+
     while (waiters.load() > 0 && count.load() > 0) {
       for (size_t i = 0; i < semaphores.size(); i++) {
         // Don't bother finding a semaphore to signal if there isn't
@@ -317,6 +367,26 @@ public:
         return;
       }
 
+      // Spin for a bounded number of iterations in the hope that a
+      // signal arrives, since parking and the subsequent wakeup are
+      // significantly more expensive than briefly polling `count`.
+      // While we are registered in `spinners` the signalers can
+      // elide waking up a parked thread (see `signal()`).
+      if (spins > 0) {
+        spinners.fetch_add(1);
+
+        for (size_t spin = 0; spin < spins; spin++) {
+          spin_pause();
+
+          if ((old = count.load()) > 0) {
+            spinners.fetch_sub(1);
+            goto CAS;
+          }
+        }
+
+        spinners.fetch_sub(1);
+      }
+
       // Need to actually wait (slow path).
       waiters.fetch_add(1);
 
@@ -410,6 +480,17 @@ private:
   // Number of threads waiting for an available "unit of resource".
   std::atomic<size_t> waiters = ATOMIC_VAR_INIT(0);
 
+  // Number of threads currently spinning in `wait()` before parking.
+  // Used by `signal()` to elide wakeups when the spinning threads
+  // will consume the available count anyway.
+  std::atomic<size_t> spinners = ATOMIC_VAR_INIT(0);
+
+  // Bounded number of iterations a thread spins in `wait()` before
+  // parking, tunable via LIBPROCESS_SEMAPHORE_SPIN_COUNT. The default
+  // is roughly a couple of microseconds worth of spinning, which is
+  // well below the cost of a futex park/wake round trip.
+  size_t spins = 100;
+
   // Fixed array holding thread-local semaphores used for waiting and
   // signaling threads.
   std::array<std::atomic<KernelSemaphore*>, THREADS> semaphores;
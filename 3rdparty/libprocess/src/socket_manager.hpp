@@ -13,8 +13,10 @@
 #ifndef __PROCESS_SOCKET_MANAGER_HPP__
 #define __PROCESS_SOCKET_MANAGER_HPP__
 
+#include <memory>
 #include <mutex>
 #include <queue>
+#include <string>
 
 #include <process/address.hpp>
 #include <process/future.hpp>
@@ -79,6 +81,16 @@ public:
       const network::internal::SocketImpl::Kind& kind =
         network::internal::SocketImpl::DEFAULT_KIND());
 
+  // Sends the message with the given body, which is kept separate
+  // from the message so that a single refcounted buffer can back the
+  // encoders of many destinations (e.g., when broadcasting). Note
+  // that 'message.body' is ignored.
+  void send(
+      Message&& message,
+      const std::shared_ptr<const std::string>& body,
+      const network::internal::SocketImpl::Kind& kind =
+        network::internal::SocketImpl::DEFAULT_KIND());
+
   Encoder* next(int_fd s);
 
   void close(int_fd s);
@@ -119,7 +131,8 @@ private:
   void send_connect(
       const Future<Nothing>& future,
       network::inet::Socket socket,
-      Message&& message);
+      Message&& message,
+      const std::shared_ptr<const std::string>& body);
 
   // Collection of all active sockets (both inbound and outbound).
   hashmap<int_fd, network::inet::Socket> sockets;
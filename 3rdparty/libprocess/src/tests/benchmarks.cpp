@@ -41,10 +41,15 @@
 #include <stout/gtest.hpp>
 #include <stout/hashset.hpp>
 #include <stout/stopwatch.hpp>
+#include <stout/strings.hpp>
 
 #include "benchmarks.pb.h"
 
+#include "decoder.hpp"
+#include "encoder.hpp"
+#include "event_queue.hpp"
 #include "mpsc_linked_queue.hpp"
+#include "run_queue.hpp"
 
 namespace http = process::http;
 namespace metrics = process::metrics;
@@ -916,3 +921,225 @@ TEST(ProcessTest, Process_BENCHMARK_MpscLinkedQueueNonContendedRead)
   cout << "Estimated total throughput: "
        << std::fixed << throughput << " op/s" << endl;
 }
+
+
+// Measures the throughput of the process mailbox, i.e., whichever
+// `EventQueue` implementation was selected at build time (the mutex
+// based queue by default, the lock-free queue when configured with
+// `--enable-lock-free-event-queue`). This allows the two variants to
+// be compared with otherwise identical builds.
+TEST(ProcessTest, Process_BENCHMARK_EventQueue)
+{
+  // NOTE: we set the total number of producers to be 1 less than the
+  // hardware concurrency so the consumer doesn't have to fight for
+  // processing time with the producers.
+  const unsigned int producerCount = std::thread::hardware_concurrency() - 1;
+  const int messageCount = 1000000;
+  const int totalCount = messageCount * producerCount;
+  process::EventQueue q;
+
+  Stopwatch consumerWatch;
+
+  auto consumer = std::thread([totalCount, &q, &consumerWatch]() {
+    consumerWatch.start();
+    for (int i = totalCount; i > 0;) {
+      if (!q.consumer.empty()) {
+        delete q.consumer.dequeue();
+        i--;
+      }
+    }
+    consumerWatch.stop();
+  });
+
+  std::vector<std::thread> producers;
+
+  Stopwatch producerWatch;
+  producerWatch.start();
+
+  for (unsigned int t = 0; t < producerCount; t++) {
+    producers.push_back(std::thread([&]() {
+      for (int i = 0; i < messageCount; i++) {
+        q.producer.enqueue(
+            new MessageEvent(UPID(), UPID(), "ping", nullptr, 0));
+      }
+    }));
+  }
+
+  for (std::thread& producer : producers) {
+    producer.join();
+  }
+
+  producerWatch.stop();
+
+  consumer.join();
+
+  Duration producerElapsed = producerWatch.elapsed();
+  Duration consumerElapsed = consumerWatch.elapsed();
+
+  double consumerThroughput = (double) totalCount / consumerElapsed.secs();
+  double producerThroughput = (double) totalCount / producerElapsed.secs();
+  double throughput = consumerThroughput + producerThroughput;
+
+  cout << "Estimated producer throughput (" << producerCount << " threads): "
+       << std::fixed << producerThroughput << " op/s" << endl;
+  cout << "Estimated consumer throughput: "
+       << std::fixed << consumerThroughput << " op/s" << endl;
+  cout << "Estimated total throughput: "
+       << std::fixed << throughput << " op/s" << endl;
+}
+
+
+// Measures the throughput of the run queue, i.e., whichever
+// `RunQueue` implementation was selected at build time (the mutex
+// based queue by default, the lock-free queue when configured with
+// `--enable-lock-free-run-queue`). Unlike the mailbox, the run queue
+// is multi-consumer, so we use as many consumers as producers to
+// simulate the contention the worker threads experience.
+TEST(ProcessTest, Process_BENCHMARK_RunQueue)
+{
+  const unsigned int producerCount = std::thread::hardware_concurrency() / 2;
+  const unsigned int consumerCount = producerCount;
+  const long messageCount = 1000000;
+  const long totalCount = messageCount * producerCount;
+
+  process::RunQueue q;
+
+  // The run queue just passes pointers around so we can use a single
+  // process that never gets spawned for all of the enqueues.
+  ProcessBase process;
+
+  std::atomic<long> consumed(0);
+
+  std::vector<std::thread> consumers;
+
+  for (unsigned int t = 0; t < consumerCount; t++) {
+    consumers.push_back(std::thread([&]() {
+      while (true) {
+        q.wait();
+        if (q.dequeue() == nullptr) {
+          // The queue has been decommissioned and fully drained.
+          break;
+        }
+        consumed.fetch_add(1);
+      }
+    }));
+  }
+
+  std::vector<std::thread> producers;
+
+  Stopwatch watch;
+  watch.start();
+
+  for (unsigned int t = 0; t < producerCount; t++) {
+    producers.push_back(std::thread([&]() {
+      for (long i = 0; i < messageCount; i++) {
+        q.enqueue(&process);
+      }
+    }));
+  }
+
+  for (std::thread& producer : producers) {
+    producer.join();
+  }
+
+  while (consumed.load() < totalCount) {
+    std::this_thread::yield();
+  }
+
+  watch.stop();
+
+  q.decomission();
+
+  for (std::thread& consumer : consumers) {
+    consumer.join();
+  }
+
+  Duration elapsed = watch.elapsed();
+
+  double throughput = (double) totalCount / elapsed.secs();
+
+  cout << "Estimated throughput (" << producerCount << " producers, "
+       << consumerCount << " consumers): "
+       << std::fixed << throughput << " op/s" << endl;
+}
+
+
+// Measures the throughput of the HTTP request decoders over a
+// pipelined stream of libprocess messages, sized like the calls a
+// v1 framework sends to the master. `StreamingRequestDecoder` is
+// what the server side of libprocess actually runs; `DataDecoder`
+// is included for comparison since it skips the response pipe
+// machinery and thus isolates the parser itself.
+TEST(ProcessTest, Process_BENCHMARK_HttpDecoder)
+{
+  const size_t messageCount = 100000;
+
+  process::Message message;
+  message.name = "mesos.scheduler.Call";
+  message.from = UPID("scheduler-dd344d9a@127.0.0.1:46643");
+  message.to = UPID("master@127.0.0.1:5050");
+  message.body = string(200, 'a');
+
+  const string data =
+    strings::join("", process::MessageEncoder::encode(message));
+
+  {
+    process::DataDecoder decoder;
+
+    Stopwatch watch;
+    watch.start();
+
+    size_t received = 0;
+
+    for (size_t i = 0; i < messageCount; i++) {
+      foreach (http::Request* request, decoder.decode(data.data(),
+                                                      data.size())) {
+        delete request;
+        received++;
+      }
+    }
+
+    watch.stop();
+
+    ASSERT_FALSE(decoder.failed());
+    ASSERT_EQ(messageCount, received);
+
+    double megabytes =
+      (double) (messageCount * data.size()) / Megabytes(1).bytes();
+
+    cout << "DataDecoder parsed " << messageCount << " requests in "
+         << watch.elapsed() << " ("
+         << std::fixed << (megabytes / watch.elapsed().secs()) << " MB/s)"
+         << endl;
+  }
+
+  {
+    process::StreamingRequestDecoder decoder;
+
+    Stopwatch watch;
+    watch.start();
+
+    size_t received = 0;
+
+    for (size_t i = 0; i < messageCount; i++) {
+      foreach (http::Request* request, decoder.decode(data.data(),
+                                                      data.size())) {
+        delete request;
+        received++;
+      }
+    }
+
+    watch.stop();
+
+    ASSERT_FALSE(decoder.failed());
+    ASSERT_EQ(messageCount, received);
+
+    double megabytes =
+      (double) (messageCount * data.size()) / Megabytes(1).bytes();
+
+    cout << "StreamingRequestDecoder parsed " << messageCount
+         << " requests in " << watch.elapsed() << " ("
+         << std::fixed << (megabytes / watch.elapsed().secs()) << " MB/s)"
+         << endl;
+  }
+}
@@ -22,6 +22,7 @@
 using process::Future;
 using process::Owned;
 using process::Promise;
+using process::Queue;
 
 using std::string;
 using std::vector;
@@ -256,6 +257,44 @@ TEST(AwaitTest, Discarded)
 }
 
 
+TEST(AwaitTest, AwaitEach)
+{
+  Promise<int> promise1;
+  Promise<int> promise2;
+  Promise<int> promise3;
+
+  vector<Future<int>> futures = {
+    promise1.future(),
+    promise2.future(),
+    promise3.future(),
+  };
+
+  Queue<Future<int>> queue = process::awaitEach(futures);
+
+  // We expect the futures to be yielded in completion order, not in
+  // the order they were passed in.
+  promise2.set(2);
+
+  Future<Future<int>> completed = queue.get();
+  AWAIT_READY(completed);
+  ASSERT_TRUE(completed->isReady());
+  EXPECT_EQ(2, completed->get());
+
+  promise3.fail("failure");
+
+  completed = queue.get();
+  AWAIT_READY(completed);
+  EXPECT_TRUE(completed->isFailed());
+
+  promise1.set(1);
+
+  completed = queue.get();
+  AWAIT_READY(completed);
+  ASSERT_TRUE(completed->isReady());
+  EXPECT_EQ(1, completed->get());
+}
+
+
 TEST(AwaitTest, DiscardPropagation)
 {
   Promise<int> promise1;
@@ -21,6 +21,7 @@
 #include <process/socket.hpp>
 
 #include <stout/gtest.hpp>
+#include <stout/strings.hpp>
 
 #include "encoder.hpp"
 #include "decoder.hpp"
@@ -42,7 +43,8 @@ TEST(EncoderTest, Response)
   const http::OK response("body");
 
   // Encode the response.
-  const string encoded = HttpResponseEncoder::encode(response, request);
+  const string encoded =
+    strings::join("", HttpResponseEncoder::encode(response, request));
 
   // Now decode it back, and verify the encoding was correct.
   ResponseDecoder decoder;
@@ -48,6 +48,8 @@
 #include <stout/nothing.hpp>
 #include <stout/option.hpp>
 #include <stout/os.hpp>
+#include <stout/path.hpp>
+#include <stout/result.hpp>
 #include <stout/stringify.hpp>
 
 #include <stout/tests/utils.hpp>
@@ -559,6 +561,39 @@ TEST(HTTPTest, PipeReadAll)
 }
 
 
+TEST(HTTPTest, PipeOutstanding)
+{
+  http::Pipe pipe;
+  http::Pipe::Reader reader = pipe.reader();
+  http::Pipe::Writer writer = pipe.writer();
+
+  EXPECT_EQ(0u, writer.outstanding());
+
+  // Writes accumulate until the reader consumes them.
+  EXPECT_TRUE(writer.write("hello"));
+  EXPECT_TRUE(writer.write("world"));
+  EXPECT_EQ(10u, writer.outstanding());
+
+  AWAIT_EQ("hello", reader.read());
+  EXPECT_EQ(5u, writer.outstanding());
+
+  AWAIT_EQ("world", reader.read());
+  EXPECT_EQ(0u, writer.outstanding());
+
+  // A write that satisfies a pending read is never queued.
+  Future<string> read = reader.read();
+  EXPECT_TRUE(writer.write("!"));
+  EXPECT_EQ(0u, writer.outstanding());
+  AWAIT_EQ("!", read);
+
+  // Closing the read end throws away any queued data.
+  EXPECT_TRUE(writer.write("ignored"));
+  EXPECT_EQ(7u, writer.outstanding());
+  EXPECT_TRUE(reader.close());
+  EXPECT_EQ(0u, writer.outstanding());
+}
+
+
 TEST_P(HTTPTest, PipeReaderCloses)
 {
   http::Pipe pipe;
@@ -797,6 +832,55 @@ TEST_P(HTTPTest, StreamingGetComplete)
 }
 
 
+TEST_P(HTTPTest, StreamingGetGzip)
+{
+  Http http;
+
+  http::Pipe pipe;
+  http::OK ok;
+  ok.type = http::Response::PIPE;
+  ok.reader = pipe.reader();
+
+  EXPECT_CALL(*http.process, pipe(_))
+    .WillOnce(Return(ok));
+
+  http::Headers headers;
+  headers["Accept-Encoding"] = "gzip";
+
+  Future<http::Response> response = http::streaming::get(
+      http.process->self(), "pipe", None(), headers, GetParam());
+
+  // The response should be ready since the headers were sent.
+  AWAIT_READY(response);
+
+  // The stream should get compressed since we accept gzip; the
+  // decoder decompresses transparently so the chunks we read
+  // below are the original data.
+  EXPECT_SOME_EQ("chunked", response->headers.get("Transfer-Encoding"));
+  EXPECT_SOME_EQ("gzip", response->headers.get("Content-Encoding"));
+  ASSERT_EQ(http::Response::PIPE, response->type);
+  ASSERT_SOME(response->reader);
+
+  http::Pipe::Reader reader = response->reader.get();
+
+  // There is no data to read yet.
+  Future<string> read = reader.read();
+  EXPECT_TRUE(read.isPending());
+
+  // Stream data into the body and read it from the response.
+  http::Pipe::Writer writer = pipe.writer();
+  EXPECT_TRUE(writer.write("hello"));
+  AWAIT_EQ("hello", read);
+
+  EXPECT_TRUE(writer.write("goodbye"));
+  AWAIT_EQ("goodbye", reader.read());
+
+  // Complete the response.
+  EXPECT_TRUE(writer.close());
+  AWAIT_EQ("", reader.read()); // EOF.
+}
+
+
 TEST_P(HTTPTest, StreamingGetFailure)
 {
   Http http;
@@ -981,6 +1065,163 @@ TEST_P(HTTPTest, Request)
 }
 
 
+// Checks the parsing of 'Range' request headers against a file size.
+TEST(HTTPTest, ParseRangeHeader)
+{
+  Result<http::internal::ByteRange> range =
+    http::internal::parseRangeHeader("bytes=0-0", 10);
+
+  ASSERT_SOME(range);
+  EXPECT_EQ(0, range->offset);
+  EXPECT_EQ(1u, range->length);
+
+  range = http::internal::parseRangeHeader("bytes=2-5", 10);
+
+  ASSERT_SOME(range);
+  EXPECT_EQ(2, range->offset);
+  EXPECT_EQ(4u, range->length);
+
+  // An open-ended range extends to the end of the file.
+  range = http::internal::parseRangeHeader("bytes=5-", 10);
+
+  ASSERT_SOME(range);
+  EXPECT_EQ(5, range->offset);
+  EXPECT_EQ(5u, range->length);
+
+  // A last byte position past the end of the file is clamped.
+  range = http::internal::parseRangeHeader("bytes=0-100", 10);
+
+  ASSERT_SOME(range);
+  EXPECT_EQ(0, range->offset);
+  EXPECT_EQ(10u, range->length);
+
+  // Suffix form: the last N bytes of the file.
+  range = http::internal::parseRangeHeader("bytes=-4", 10);
+
+  ASSERT_SOME(range);
+  EXPECT_EQ(6, range->offset);
+  EXPECT_EQ(4u, range->length);
+
+  // A suffix longer than the file yields the whole file.
+  range = http::internal::parseRangeHeader("bytes=-100", 10);
+
+  ASSERT_SOME(range);
+  EXPECT_EQ(0, range->offset);
+  EXPECT_EQ(10u, range->length);
+
+  // Unsatisfiable ranges: a first byte position at or past the end
+  // of the file, an empty suffix, and any suffix of an empty file.
+  EXPECT_ERROR(http::internal::parseRangeHeader("bytes=10-", 10));
+  EXPECT_ERROR(http::internal::parseRangeHeader("bytes=10-20", 10));
+  EXPECT_ERROR(http::internal::parseRangeHeader("bytes=-0", 10));
+  EXPECT_ERROR(http::internal::parseRangeHeader("bytes=-5", 0));
+
+  // Headers that should be ignored in favor of the full file:
+  // unsupported units, multiple ranges and malformed specs.
+  EXPECT_NONE(http::internal::parseRangeHeader("items=0-1", 10));
+  EXPECT_NONE(http::internal::parseRangeHeader("bytes=0-1,4-5", 10));
+  EXPECT_NONE(http::internal::parseRangeHeader("bytes=", 10));
+  EXPECT_NONE(http::internal::parseRangeHeader("bytes=5", 10));
+  EXPECT_NONE(http::internal::parseRangeHeader("bytes=5-2", 10));
+  EXPECT_NONE(http::internal::parseRangeHeader("bytes=a-b", 10));
+  EXPECT_NONE(http::internal::parseRangeHeader("bytes=1.5-2", 10));
+}
+
+
+// Checks that file ('PATH') responses honor 'Range' request headers.
+TEST_P(HTTPTest, RangeRequest)
+{
+  Http http;
+
+  const string file = path::join(sandbox.get(), "file");
+  ASSERT_SOME(os::write(file, "0123456789"));
+
+  EXPECT_CALL(*http.process, get(_))
+    .WillRepeatedly(Invoke([file](const http::Request&) {
+      http::OK response;
+      response.type = http::Response::PATH;
+      response.path = file;
+      return response;
+    }));
+
+  // Without a 'Range' header the full file is served, advertising
+  // that range requests are supported.
+  Future<http::Response> response =
+    http::get(http.process->self(), "get", None(), None(), GetParam());
+
+  AWAIT_READY(response);
+  EXPECT_EQ(http::Status::OK, response->code);
+  EXPECT_EQ("0123456789", response->body);
+  EXPECT_SOME_EQ("bytes", response->headers.get("Accept-Ranges"));
+
+  // A single byte.
+  response = http::get(
+      http.process->self(),
+      "get",
+      None(),
+      http::Headers({{"Range", "bytes=0-0"}}),
+      GetParam());
+
+  AWAIT_READY(response);
+  EXPECT_EQ(http::Status::PARTIAL_CONTENT, response->code);
+  EXPECT_EQ("0", response->body);
+  EXPECT_SOME_EQ("bytes 0-0/10", response->headers.get("Content-Range"));
+  EXPECT_SOME_EQ("1", response->headers.get("Content-Length"));
+
+  // An interior range.
+  response = http::get(
+      http.process->self(),
+      "get",
+      None(),
+      http::Headers({{"Range", "bytes=2-5"}}),
+      GetParam());
+
+  AWAIT_READY(response);
+  EXPECT_EQ(http::Status::PARTIAL_CONTENT, response->code);
+  EXPECT_EQ("2345", response->body);
+  EXPECT_SOME_EQ("bytes 2-5/10", response->headers.get("Content-Range"));
+
+  // A suffix longer than the file yields the whole file.
+  response = http::get(
+      http.process->self(),
+      "get",
+      None(),
+      http::Headers({{"Range", "bytes=-100"}}),
+      GetParam());
+
+  AWAIT_READY(response);
+  EXPECT_EQ(http::Status::PARTIAL_CONTENT, response->code);
+  EXPECT_EQ("0123456789", response->body);
+  EXPECT_SOME_EQ("bytes 0-9/10", response->headers.get("Content-Range"));
+
+  // A range starting at the end of the file is unsatisfiable and
+  // names the file size in the 'Content-Range' header.
+  response = http::get(
+      http.process->self(),
+      "get",
+      None(),
+      http::Headers({{"Range", "bytes=10-"}}),
+      GetParam());
+
+  AWAIT_READY(response);
+  EXPECT_EQ(http::Status::REQUESTED_RANGE_NOT_SATISFIABLE, response->code);
+  EXPECT_EQ("", response->body);
+  EXPECT_SOME_EQ("bytes */10", response->headers.get("Content-Range"));
+
+  // A malformed range is ignored in favor of the full file.
+  response = http::get(
+      http.process->self(),
+      "get",
+      None(),
+      http::Headers({{"Range", "bytes=oops"}}),
+      GetParam());
+
+  AWAIT_READY(response);
+  EXPECT_EQ(http::Status::OK, response->code);
+  EXPECT_EQ("0123456789", response->body);
+}
+
+
 // This test verifies that the server can correctly receive the
 // uncompressed data from the request.
 TEST(HTTPConnectionTest, GzipRequestBody)
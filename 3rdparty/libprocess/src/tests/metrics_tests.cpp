@@ -19,6 +19,7 @@
 #include <stout/base64.hpp>
 #include <stout/duration.hpp>
 #include <stout/gtest.hpp>
+#include <stout/strings.hpp>
 
 #include <process/authenticator.hpp>
 #include <process/clock.hpp>
@@ -315,6 +316,39 @@ TEST_F(MetricsTest, THREADSAFE_Snapshot)
 }
 
 
+TEST_F(MetricsTest, THREADSAFE_Prometheus)
+{
+  UPID upid("metrics", process::address());
+
+  Clock::pause();
+
+  Counter counter("test/counter");
+  PullGauge gauge("test/gauge", []() { return 42.0; });
+
+  AWAIT_READY(metrics::add(counter));
+  AWAIT_READY(metrics::add(gauge));
+
+  counter += 2;
+
+  // Advance the clock to avoid rate limit.
+  Clock::advance(Seconds(1));
+
+  Future<Response> response = http::get(upid, "prometheus");
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(OK().status, response);
+
+  EXPECT_SOME_EQ(
+      "text/plain; version=0.0.4",
+      response->headers.get("Content-Type"));
+
+  // Metric names are sanitized to the Prometheus character set.
+  EXPECT_TRUE(strings::contains(response->body, "test_counter 2\n"));
+  EXPECT_TRUE(strings::contains(response->body, "test_gauge 42\n"));
+
+  AWAIT_READY(metrics::remove(counter));
+  AWAIT_READY(metrics::remove(gauge));
+}
+
+
 // Ensure the response string has the JSON keys sorted
 // alphabetically, we do this for easier human consumption.
 TEST_F(MetricsTest, SnapshotAlphabetical)
@@ -58,6 +58,7 @@
 #include <stout/os.hpp>
 #include <stout/stopwatch.hpp>
 #include <stout/stringify.hpp>
+#include <stout/strings.hpp>
 #include <stout/try.hpp>
 
 #include <stout/os/killtree.hpp>
@@ -1403,7 +1404,7 @@ TEST(ProcessTest, Remote)
   message.from = UPID("sender", sender.get());
   message.to = process.self();
 
-  const string data = MessageEncoder::encode(message);
+  const string data = strings::join("", MessageEncoder::encode(message));
 
   AWAIT_READY(socket.send(data));
 
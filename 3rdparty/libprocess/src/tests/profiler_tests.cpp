@@ -87,6 +87,10 @@ TEST_F(ProfilerTest, StartAndStop)
 
     response = http::get(upid, "stop");
     AWAIT_EXPECT_RESPONSE_STATUS_EQ(OK().status, response);
+
+    // The profile of the completed run remains downloadable.
+    response = http::get(upid, "download");
+    AWAIT_EXPECT_RESPONSE_STATUS_EQ(OK().status, response);
   } else {
     AWAIT_EXPECT_RESPONSE_STATUS_EQ(BadRequest().status, response);
     AWAIT_EXPECT_RESPONSE_BODY_EQ(
@@ -97,6 +101,9 @@ TEST_F(ProfilerTest, StartAndStop)
     response = http::get(upid, "stop");
     AWAIT_EXPECT_RESPONSE_STATUS_EQ(BadRequest().status, response);
     AWAIT_EXPECT_RESPONSE_BODY_EQ("Profiler not running.\n", response);
+
+    response = http::get(upid, "download");
+    AWAIT_EXPECT_RESPONSE_STATUS_EQ(BadRequest().status, response);
   }
 #else
   AWAIT_EXPECT_RESPONSE_STATUS_EQ(BadRequest().status, response);
@@ -111,6 +118,13 @@ TEST_F(ProfilerTest, StartAndStop)
       "Perftools is disabled. To enable perftools, "
       "configure libprocess with --enable-perftools.\n",
       response);
+
+  response = http::get(upid, "download");
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(BadRequest().status, response);
+  AWAIT_EXPECT_RESPONSE_BODY_EQ(
+      "Perftools is disabled. To enable perftools, "
+      "configure libprocess with --enable-perftools.\n",
+      response);
 #endif
 }
 
@@ -133,4 +147,7 @@ TEST_F(ProfilerTest, StartAndStopAuthenticationEnabled)
 
   response = http::get(upid, "stop");
   AWAIT_EXPECT_RESPONSE_STATUS_EQ(Unauthorized({}).status, response);
+
+  response = http::get(upid, "download");
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(Unauthorized({}).status, response);
 }
@@ -22,6 +22,7 @@
 #include <stout/nothing.hpp>
 #include <stout/option.hpp>
 #include <stout/os.hpp>
+#include <stout/strings.hpp>
 
 #include "encoder.hpp"
 
@@ -191,7 +192,7 @@ int main(int argc, char** argv)
       message.from = UPID("(1)", address);
       message.to = parent;
 
-      outgoing->send(MessageEncoder::encode(message));
+      outgoing->send(strings::join("", MessageEncoder::encode(message)));
     });
 
   // Now sit and accept links until the linkee is killed.
@@ -15,6 +15,7 @@
 
 #include <ctype.h> // For 'isdigit'.
 #include <stdint.h>
+#include <stdio.h> // For 'snprintf'.
 
 #include <iomanip>
 #include <iostream>
@@ -138,22 +139,46 @@ inline constexpr Bytes Terabytes(uint64_t value)
 }
 
 
-inline std::ostream& operator<<(std::ostream& stream, const Bytes& bytes)
+// Formats the value directly into a small stack buffer rather than
+// through a `std::ostringstream`; sizes get stringified on logging
+// hot paths.
+inline std::string stringify(const Bytes& bytes_)
 {
+  uint64_t value = bytes_.bytes();
+  const char* units = "B";
+
   // Only raise the unit when there is no loss of information.
-  if (bytes.bytes() == 0) {
-    return stream << "0B";
-  } else if (bytes.bytes() % Bytes::KILOBYTES != 0) {
-    return stream << bytes.bytes() << "B";
-  } else if (bytes.bytes() % Bytes::MEGABYTES != 0) {
-    return stream << (bytes.bytes() / Bytes::KILOBYTES) << "KB";
-  } else if (bytes.bytes() % Bytes::GIGABYTES != 0) {
-    return stream << (bytes.bytes() / Bytes::MEGABYTES) << "MB";
-  } else if (bytes.bytes() % Bytes::TERABYTES != 0) {
-    return stream << (bytes.bytes() / Bytes::GIGABYTES) << "GB";
+  if (value == 0 || value % Bytes::KILOBYTES != 0) {
+    // Keep bytes.
+  } else if (value % Bytes::MEGABYTES != 0) {
+    value /= Bytes::KILOBYTES;
+    units = "KB";
+  } else if (value % Bytes::GIGABYTES != 0) {
+    value /= Bytes::MEGABYTES;
+    units = "MB";
+  } else if (value % Bytes::TERABYTES != 0) {
+    value /= Bytes::GIGABYTES;
+    units = "GB";
   } else {
-    return stream << (bytes.bytes() / Bytes::TERABYTES) << "TB";
+    value /= Bytes::TERABYTES;
+    units = "TB";
   }
+
+  char buffer[32];
+  const int size = snprintf(
+      buffer,
+      sizeof(buffer),
+      "%llu%s",
+      static_cast<unsigned long long>(value),
+      units);
+
+  return std::string(buffer, size);
+}
+
+
+inline std::ostream& operator<<(std::ostream& stream, const Bytes& bytes)
+{
+  return stream << stringify(bytes);
 }
 
 
@@ -0,0 +1,115 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __STOUT_COWHASHMAP_HPP__
+#define __STOUT_COWHASHMAP_HPP__
+
+#include <memory>
+#include <utility>
+
+#include <stout/hashmap.hpp>
+#include <stout/hashset.hpp>
+#include <stout/option.hpp>
+
+// A copy-on-write hashmap. Copying a `CowHashMap` is O(1) and the
+// copies share the underlying storage, so taking a point-in-time
+// snapshot of a large map is cheap regardless of its size. The
+// storage is copied lazily: the first mutation after the map became
+// shared clones it, and subsequent mutations are applied in place
+// until another copy is taken.
+//
+// This makes the container well suited for state that is mutated in
+// one place but periodically snapshotted by readers, e.g., to build
+// an endpoint response without blocking writers.
+//
+// NOTE: Mutable references into the map (e.g., `operator[]`) are
+// deliberately not provided since they could be used to modify
+// storage that a snapshot still observes. Iteration is const-only
+// for the same reason.
+template <typename Key, typename Value>
+class CowHashMap
+{
+public:
+  typedef typename hashmap<Key, Value>::const_iterator const_iterator;
+
+  CowHashMap() : data(std::make_shared<hashmap<Key, Value>>()) {}
+
+  // Copies (i.e., snapshots) share storage and are O(1).
+  CowHashMap(const CowHashMap&) = default;
+  CowHashMap& operator=(const CowHashMap&) = default;
+
+  bool contains(const Key& key) const
+  {
+    return data->contains(key);
+  }
+
+  Option<Value> get(const Key& key) const
+  {
+    return data->get(key);
+  }
+
+  const Value& at(const Key& key) const
+  {
+    return data->at(key);
+  }
+
+  void put(const Key& key, const Value& value)
+  {
+    detach();
+    data->put(key, value);
+  }
+
+  size_t erase(const Key& key)
+  {
+    if (!data->contains(key)) {
+      return 0;
+    }
+
+    detach();
+    return data->erase(key);
+  }
+
+  void clear()
+  {
+    // No need to clone storage that we are about to clear.
+    if (data.use_count() > 1) {
+      data = std::make_shared<hashmap<Key, Value>>();
+    } else {
+      data->clear();
+    }
+  }
+
+  size_t size() const { return data->size(); }
+  bool empty() const { return data->empty(); }
+
+  hashset<Key> keys() const { return data->keys(); }
+  std::vector<Value> values() const { return data->values(); }
+
+  // Support for const iteration; this allows using `foreachpair`
+  // and related constructs.
+  const_iterator begin() const { return data->cbegin(); }
+  const_iterator end() const { return data->cend(); }
+
+private:
+  // Clones the underlying storage if it is shared with a snapshot,
+  // so that mutations do not alter the snapshot's view.
+  void detach()
+  {
+    if (data.use_count() > 1) {
+      data = std::make_shared<hashmap<Key, Value>>(*data);
+    }
+  }
+
+  std::shared_ptr<hashmap<Key, Value>> data;
+};
+
+#endif // __STOUT_COWHASHMAP_HPP__
@@ -0,0 +1,87 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __STOUT_COWHASHSET_HPP__
+#define __STOUT_COWHASHSET_HPP__
+
+#include <memory>
+
+#include <stout/hashset.hpp>
+
+// A copy-on-write hashset, the set counterpart of `CowHashMap`.
+// Copies are O(1) and share the underlying storage; the first
+// mutation after the set became shared clones it.
+template <typename Elem>
+class CowHashSet
+{
+public:
+  typedef typename hashset<Elem>::const_iterator const_iterator;
+
+  CowHashSet() : data(std::make_shared<hashset<Elem>>()) {}
+
+  // Copies (i.e., snapshots) share storage and are O(1).
+  CowHashSet(const CowHashSet&) = default;
+  CowHashSet& operator=(const CowHashSet&) = default;
+
+  bool contains(const Elem& elem) const
+  {
+    return data->contains(elem);
+  }
+
+  void insert(const Elem& elem)
+  {
+    detach();
+    data->insert(elem);
+  }
+
+  size_t erase(const Elem& elem)
+  {
+    if (!data->contains(elem)) {
+      return 0;
+    }
+
+    detach();
+    return data->erase(elem);
+  }
+
+  void clear()
+  {
+    // No need to clone storage that we are about to clear.
+    if (data.use_count() > 1) {
+      data = std::make_shared<hashset<Elem>>();
+    } else {
+      data->clear();
+    }
+  }
+
+  size_t size() const { return data->size(); }
+  bool empty() const { return data->empty(); }
+
+  // Support for const iteration; this allows using `foreach`
+  // and related constructs.
+  const_iterator begin() const { return data->cbegin(); }
+  const_iterator end() const { return data->cend(); }
+
+private:
+  // Clones the underlying storage if it is shared with a snapshot,
+  // so that mutations do not alter the snapshot's view.
+  void detach()
+  {
+    if (data.use_count() > 1) {
+      data = std::make_shared<hashset<Elem>>(*data);
+    }
+  }
+
+  std::shared_ptr<hashset<Elem>> data;
+};
+
+#endif // __STOUT_COWHASHSET_HPP__
@@ -14,6 +14,7 @@
 #define __STOUT_DURATION_HPP__
 
 #include <ctype.h> // For 'isdigit'.
+#include <stdio.h> // For 'snprintf'.
 
 // For 'timeval'.
 #ifndef __WINDOWS__
@@ -156,9 +157,7 @@ private:
 
   int64_t nanos;
 
-  friend std::ostream& operator<<(
-    std::ostream& stream,
-    const Duration& duration);
+  friend std::string stringify(const Duration& duration);
 };
 
 
@@ -273,16 +272,20 @@ public:
 };
 
 
-inline std::ostream& operator<<(std::ostream& stream, const Duration& duration_)
+// Formats the duration directly into a small stack buffer rather
+// than through a `std::ostringstream`; durations get stringified on
+// logging hot paths.
+inline std::string stringify(const Duration& duration_)
 {
-  // Output the duration in full double precision and save the old precision.
-  std::streamsize precision =
-    stream.precision(std::numeric_limits<double>::digits10);
+  // Large enough for a sign, 19 digits, a decimal point, the full
+  // double precision used below and the longest unit suffix.
+  char buffer[64];
+  size_t offset = 0;
 
   // Parse the duration as the sign and the absolute value.
   Duration duration = duration_;
   if (duration_ < Duration::zero()) {
-    stream << "-";
+    buffer[offset++] = '-';
 
     // Duration::min() may not be representable as a positive Duration.
     if (duration_ == Duration::min()) {
@@ -292,6 +295,28 @@ inline std::ostream& operator<<(std::ostream& stream, const Duration& duration_)
     }
   }
 
+  // Output the value in full double precision, matching what
+  // `operator<<` historically produced with `std::ostream`
+  // precision set to `std::numeric_limits<double>::digits10`.
+  auto write = [&buffer, &offset](double value, const std::string& units) {
+    offset += snprintf(
+        buffer + offset,
+        sizeof(buffer) - offset,
+        "%.*g%s",
+        std::numeric_limits<double>::digits10,
+        value,
+        units.c_str());
+  };
+
+  auto writeNanos = [&buffer, &offset](int64_t value) {
+    offset += snprintf(
+        buffer + offset,
+        sizeof(buffer) - offset,
+        "%lld%s",
+        static_cast<long long>(value),
+        Nanoseconds::units().c_str());
+  };
+
   // First determine which bucket of time unit the duration falls into
   // then check whether the duration can be represented as a whole
   // number with this time unit or a smaller one.
@@ -300,63 +325,66 @@ inline std::ostream& operator<<(std::ostream& stream, const Duration& duration_)
   // instead of 'weeks' to output the duration.
   int64_t nanoseconds = duration.ns();
   if (duration < Microseconds(1)) {
-    stream << duration.ns() << Nanoseconds::units();
+    writeNanos(duration.ns());
   } else if (duration < Milliseconds(1)) {
     if (nanoseconds % Duration::MICROSECONDS != 0) {
       // We can't get a whole number using this unit but we can at
       // one level down.
-      stream << duration.ns() << Nanoseconds::units();
+      writeNanos(duration.ns());
     } else {
-      stream << duration.us() << Microseconds::units();
+      write(duration.us(), Microseconds::units());
     }
   } else if (duration < Seconds(1)) {
     if (nanoseconds % Duration::MILLISECONDS != 0 &&
         nanoseconds % Duration::MICROSECONDS == 0) {
-      stream << duration.us() << Microseconds::units();
+      write(duration.us(), Microseconds::units());
     } else {
-      stream << duration.ms() << Milliseconds::units();
+      write(duration.ms(), Milliseconds::units());
     }
   } else if (duration < Minutes(1)) {
     if (nanoseconds % Duration::SECONDS != 0 &&
         nanoseconds % Duration::MILLISECONDS == 0) {
-      stream << duration.ms() << Milliseconds::units();
+      write(duration.ms(), Milliseconds::units());
     } else {
-      stream << duration.secs() << Seconds::units();
+      write(duration.secs(), Seconds::units());
     }
   } else if (duration < Hours(1)) {
     if (nanoseconds % Duration::MINUTES != 0 &&
         nanoseconds % Duration::SECONDS == 0) {
-      stream << duration.secs() << Seconds::units();
+      write(duration.secs(), Seconds::units());
     } else {
-      stream << duration.mins() << Minutes::units();
+      write(duration.mins(), Minutes::units());
     }
   } else if (duration < Days(1)) {
     if (nanoseconds % Duration::HOURS != 0 &&
         nanoseconds % Duration::MINUTES == 0) {
-      stream << duration.mins() << Minutes::units();
+      write(duration.mins(), Minutes::units());
     } else {
-      stream << duration.hrs() << Hours::units();
+      write(duration.hrs(), Hours::units());
     }
   } else if (duration < Weeks(1)) {
     if (nanoseconds % Duration::DAYS != 0 &&
         nanoseconds % Duration::HOURS == 0) {
-      stream << duration.hrs() << Hours::units();
+      write(duration.hrs(), Hours::units());
     } else {
-      stream << duration.days() << Days::units();
+      write(duration.days(), Days::units());
     }
   } else {
     if (nanoseconds % Duration::WEEKS != 0 &&
         nanoseconds % Duration::DAYS == 0) {
-      stream << duration.days() << Days::units();
+      write(duration.days(), Days::units());
     } else {
-      stream << duration.weeks() << Weeks::units();
+      write(duration.weeks(), Weeks::units());
     }
   }
 
-  // Return the stream to original formatting state.
-  stream.precision(precision);
+  return std::string(buffer, offset);
+}
+
 
-  return stream;
+inline std::ostream& operator<<(std::ostream& stream, const Duration& duration)
+{
+  return stream << stringify(duration);
 }
 
 
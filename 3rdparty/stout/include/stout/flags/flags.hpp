@@ -23,6 +23,7 @@
 #include <stout/error.hpp>
 #include <stout/exit.hpp>
 #include <stout/foreach.hpp>
+#include <stout/hashmap.hpp>
 #include <stout/lambda.hpp>
 #include <stout/multimap.hpp>
 #include <stout/none.hpp>
@@ -39,6 +40,10 @@
 
 #include <stout/os/environment.hpp>
 
+#ifndef __WINDOWS__
+#include <stout/os/raw/environment.hpp>
+#endif // __WINDOWS__
+
 namespace flags {
 
 class FlagsBase
@@ -321,11 +326,17 @@ private:
       bool duplicates = false,
       const Option<std::string>& prefix = None());
 
-  // Maps flag's name to flag.
+  // Maps flag's name to flag. Note that we keep the flags ordered by
+  // name since 'usage()' and the iteration interface expose them in
+  // sorted order.
   std::map<std::string, Flag> flags_;
 
-  // Maps flag's alias to flag's name.
-  std::map<std::string, std::string> aliases;
+  // Maps both flag names and aliases to the flag's name, so that
+  // resolving a name takes a single hash lookup instead of
+  // consecutive searches of an alias map and 'flags_'. This matters
+  // when loading several hundred flags from the environment and
+  // command line during startup.
+  hashmap<std::string, std::string> names_;
 };
 
 
@@ -509,8 +520,9 @@ inline void FlagsBase::add(const Flag& flag)
   }
 
   flags_[flag.name.value] = flag;
+  names_[flag.name.value] = flag.name.value;
   if (flag.alias.isSome()) {
-    aliases[flag.alias->value] = flag.name.value;
+    names_[flag.alias->value] = flag.name.value;
   }
 }
 
@@ -521,6 +533,9 @@ inline std::map<std::string, Option<std::string>> FlagsBase::extract(
 {
   std::map<std::string, Option<std::string>> values;
 
+#ifdef __WINDOWS__
+  // NOTE: `os::raw::environment()` is not available on Windows, so we
+  // pay the price of materializing the entire environment into a map.
   foreachpair (const std::string& key,
                const std::string& value,
                os::environment()) {
@@ -532,11 +547,39 @@ inline std::map<std::string, Option<std::string>> FlagsBase::extract(
       // TODO(vinod): Reject flags with an unknown name if `unknowns` is false.
       // This will break backwards compatibility however!
       std::string flag_name = strings::remove(name, "no-", strings::PREFIX);
-      if (flags_.count(flag_name) > 0 || aliases.count(flag_name) > 0) {
+      if (names_.contains(flag_name)) {
         values[name] = Some(value);
       }
     }
   }
+#else
+  // Make a single pass over the raw environment rather than first
+  // materializing all variables into a map: only entries carrying the
+  // prefix need to be examined or copied.
+  for (char** entry = os::raw::environment(); *entry != nullptr; entry++) {
+    if (strncmp(*entry, prefix.data(), prefix.size()) != 0) {
+      continue;
+    }
+
+    const char* begin = *entry + prefix.size();
+
+    const char* separator = strchr(begin, '=');
+    if (separator == nullptr) {
+      continue;
+    }
+
+    // Allow PREFIX_NAME or PREFIX_name.
+    std::string name = strings::lower(std::string(begin, separator - begin));
+
+    // Only add if it's a known flag.
+    // TODO(vinod): Reject flags with an unknown name if `unknowns` is false.
+    // This will break backwards compatibility however!
+    std::string flag_name = strings::remove(name, "no-", strings::PREFIX);
+    if (names_.contains(flag_name)) {
+      values[name] = Some(std::string(separator + 1));
+    }
+  }
+#endif // __WINDOWS__
 
   return values;
 }
@@ -747,9 +790,11 @@ inline Try<Warnings> FlagsBase::load(
     bool is_negated = strings::startsWith(name, "no-");
     std::string flag_name = !is_negated ? name : name.substr(3);
 
-    auto iter = aliases.count(flag_name)
-      ? flags_.find(aliases[flag_name])
-      : flags_.find(flag_name);
+    Option<std::string> canonical = names_.get(flag_name);
+
+    auto iter = canonical.isSome()
+      ? flags_.find(canonical.get())
+      : flags_.end();
 
     if (iter == flags_.end()) {
       if (!unknowns) {
@@ -801,7 +846,7 @@ inline Try<Warnings> FlagsBase::load(
     // TODO(vinod): Move this logic inside `Flag::load()`.
 
     // Set `loaded_name` to the Name corresponding to `flag_name`.
-    if (aliases.count(flag_name)) {
+    if (canonical.get() != flag_name) { // Loaded via an alias.
       CHECK_SOME(flag->alias);
       flag->loaded_name = flag->alias.get();
     } else {
@@ -0,0 +1,543 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __STOUT_FLATHASHMAP_HPP__
+#define __STOUT_FLATHASHMAP_HPP__
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "foreach.hpp"
+#include "hashset.hpp"
+#include "none.hpp"
+#include "option.hpp"
+#include "stringify.hpp"
+
+// Provides a hash map backed by open addressing with linear probing.
+// Unlike `hashmap` (which wraps the node based `std::unordered_map`),
+// entries are stored inline in a single flat array, so a lookup
+// touches one contiguous allocation instead of chasing per-node
+// pointers, and the per-entry space overhead is a single control byte
+// rather than a node header. This is intended as an opt-in
+// replacement for `hashmap` at call sites with large or hot tables;
+// it provides the subset of the `hashmap` API that is in use
+// (`contains`, `get`, `put`, `keys`, `values`, etc.).
+//
+// NOTE: Unlike `hashmap`, insertion invalidates all iterators and
+// references into the map (entries move when the table grows), and
+// erasure invalidates iterators and references to the erased entry.
+template <typename Key,
+          typename Value,
+          typename Hash = typename std::conditional<
+            std::is_enum<Key>::value,
+            EnumClassHash,
+            std::hash<Key>>::type,
+          typename Equal = std::equal_to<Key>>
+class FlatHashMap
+{
+private:
+  // Entries are stored with a mutable key so that they can be moved
+  // when the table grows; iterators expose them as `value_type` (with
+  // a `const` key) below, like the standard containers do.
+  typedef std::pair<Key, Value> Slot;
+
+  // Per-slot control byte. `EMPTY` must be zero so that zero
+  // initialized control arrays denote an empty table. A probe
+  // sequence continues over `DELETED` slots and stops at an `EMPTY`
+  // one.
+  enum Control : uint8_t
+  {
+    EMPTY = 0,
+    DELETED = 1,
+    FULL = 2,
+  };
+
+public:
+  typedef std::pair<const Key, Value> value_type;
+
+  template <typename T, typename M>
+  class iterator_base
+  {
+  public:
+    iterator_base(M* map, size_t index) : map_(map), index_(index)
+    {
+      skip();
+    }
+
+    // Allow implicit conversion from `iterator` to `const_iterator`.
+    template <
+        typename T_,
+        typename M_,
+        typename std::enable_if<
+            std::is_convertible<M_*, M*>::value, int>::type = 0>
+    iterator_base(const iterator_base<T_, M_>& that)
+      : map_(that.map_), index_(that.index_) {}
+
+    T& operator*() const
+    {
+      return reinterpret_cast<T&>(map_->slots_[index_]);
+    }
+
+    T* operator->() const { return &operator*(); }
+
+    iterator_base& operator++()
+    {
+      ++index_;
+      skip();
+      return *this;
+    }
+
+    bool operator==(const iterator_base& that) const
+    {
+      return index_ == that.index_;
+    }
+
+    bool operator!=(const iterator_base& that) const
+    {
+      return !(*this == that);
+    }
+
+  private:
+    template <typename T_, typename M_>
+    friend class iterator_base;
+
+    friend class FlatHashMap;
+
+    // Advances `index_` to the next occupied slot (or the end).
+    void skip()
+    {
+      while (index_ < map_->capacity_ && map_->control_[index_] != FULL) {
+        ++index_;
+      }
+    }
+
+    M* map_;
+    size_t index_;
+  };
+
+  typedef iterator_base<value_type, FlatHashMap> iterator;
+  typedef iterator_base<const value_type, const FlatHashMap> const_iterator;
+
+  FlatHashMap() {}
+
+  FlatHashMap(std::initializer_list<std::pair<Key, Value>> list)
+  {
+    reserve(list.size());
+
+    for (auto iterator = list.begin(); iterator != list.end(); ++iterator) {
+      put(iterator->first, iterator->second);
+    }
+  }
+
+  FlatHashMap(const FlatHashMap& that)
+  {
+    reserve(that.size_);
+
+    foreachpair (const Key& key, const Value& value, that) {
+      put(key, value);
+    }
+  }
+
+  FlatHashMap(FlatHashMap&& that) { swap(that); }
+
+  FlatHashMap& operator=(const FlatHashMap& that)
+  {
+    if (this != &that) {
+      FlatHashMap copy(that);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  FlatHashMap& operator=(FlatHashMap&& that)
+  {
+    swap(that);
+    return *this;
+  }
+
+  ~FlatHashMap()
+  {
+    destroy();
+
+    delete[] control_;
+    ::operator delete(slots_);
+  }
+
+  void swap(FlatHashMap& that)
+  {
+    std::swap(control_, that.control_);
+    std::swap(slots_, that.slots_);
+    std::swap(capacity_, that.capacity_);
+    std::swap(size_, that.size_);
+    std::swap(occupied_, that.occupied_);
+  }
+
+  size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+  // Checks whether this map contains a binding for a key.
+  bool contains(const Key& key) const
+  {
+    return find_(key) != capacity_;
+  }
+
+  size_t count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+  // Checks whether there exists a bound value in this map.
+  bool containsValue(const Value& v) const
+  {
+    foreachvalue (const Value& value, *this) {
+      if (value == v) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Inserts a key, value pair into the map replacing an old value
+  // if the key is already present.
+  void put(const Key& key, Value&& value)
+  {
+    insert_(key, std::move(value), true);
+  }
+
+  // Inserts a key, value pair into the map replacing an old value
+  // if the key is already present.
+  void put(const Key& key, const Value& value)
+  {
+    insert_(key, value, true);
+  }
+
+  std::pair<iterator, bool> insert(std::pair<Key, Value> entry)
+  {
+    std::pair<size_t, bool> result =
+      insert_(std::move(entry.first), std::move(entry.second), false);
+
+    return std::make_pair(iterator(this, result.first), result.second);
+  }
+
+  template <typename K, typename V>
+  std::pair<iterator, bool> emplace(K&& key, V&& value)
+  {
+    std::pair<size_t, bool> result =
+      insert_(std::forward<K>(key), std::forward<V>(value), false);
+
+    return std::make_pair(iterator(this, result.first), result.second);
+  }
+
+  Value& operator[](const Key& key)
+  {
+    // Avoid default constructing a `Value` when the key is already
+    // bound.
+    size_t index = find_(key);
+    if (index != capacity_) {
+      return slots_[index].second;
+    }
+
+    // NOTE: `insert_` may reallocate `slots_`, so it must be fully
+    // evaluated before `slots_` is read.
+    index = insert_(key, Value(), false).first;
+    return slots_[index].second;
+  }
+
+  // Returns an Option for the binding to the key.
+  Option<Value> get(const Key& key) const
+  {
+    size_t index = find_(key);
+    if (index == capacity_) {
+      return None();
+    }
+    return slots_[index].second;
+  }
+
+  Value& at(const Key& key)
+  {
+    size_t index = find_(key);
+    if (index == capacity_) {
+      throw std::out_of_range("FlatHashMap::at: key not found");
+    }
+    return slots_[index].second;
+  }
+
+  const Value& at(const Key& key) const
+  {
+    size_t index = find_(key);
+    if (index == capacity_) {
+      throw std::out_of_range("FlatHashMap::at: key not found");
+    }
+    return slots_[index].second;
+  }
+
+  iterator find(const Key& key)
+  {
+    return iterator(this, find_(key));
+  }
+
+  const_iterator find(const Key& key) const
+  {
+    return const_iterator(this, find_(key));
+  }
+
+  size_t erase(const Key& key)
+  {
+    size_t index = find_(key);
+    if (index == capacity_) {
+      return 0;
+    }
+
+    slots_[index].~Slot();
+    --size_;
+
+    // If the next slot in the probe sequence is empty then no probe
+    // sequence can pass through this slot (it would have terminated
+    // at the next slot), so it can be marked empty instead of
+    // leaving a tombstone behind.
+    if (control_[(index + 1) & (capacity_ - 1)] == EMPTY) {
+      control_[index] = EMPTY;
+      --occupied_;
+    } else {
+      control_[index] = DELETED;
+    }
+
+    return 1;
+  }
+
+  void clear()
+  {
+    destroy();
+    size_ = 0;
+    occupied_ = 0;
+
+    for (size_t i = 0; i < capacity_; ++i) {
+      control_[i] = EMPTY;
+    }
+  }
+
+  // Ensures that `n` entries fit without further growth.
+  void reserve(size_t n)
+  {
+    if (n * 8 > capacity_ * 7) {
+      rehash(capacityFor(n));
+    }
+  }
+
+  // Returns the set of keys in this map.
+  hashset<Key> keys() const
+  {
+    hashset<Key> result;
+    foreachkey (const Key& key, *this) {
+      result.insert(key);
+    }
+    return result;
+  }
+
+  // Returns the list of values in this map.
+  std::vector<Value> values() const
+  {
+    std::vector<Value> result;
+    result.reserve(size_);
+
+    foreachvalue (const Value& value, *this) {
+      result.push_back(value);
+    }
+
+    return result;
+  }
+
+  iterator begin() { return iterator(this, 0); }
+  iterator end() { return iterator(this, capacity_); }
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, capacity_); }
+
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+private:
+  // Returns the smallest valid capacity (a power of two of at least
+  // 8) at which `n` entries stay below the 7/8 load factor.
+  static size_t capacityFor(size_t n)
+  {
+    size_t capacity = 8;
+    while (n * 8 > capacity * 7) {
+      capacity *= 2;
+    }
+    return capacity;
+  }
+
+  // Returns the index of the slot bound to `key`, or `capacity_` if
+  // the key is not present.
+  size_t find_(const Key& key) const
+  {
+    if (capacity_ == 0) {
+      return capacity_;
+    }
+
+    const size_t mask = capacity_ - 1;
+    size_t index = hash_(key) & mask;
+
+    // The probe loop terminates because at least one slot is always
+    // empty (the load factor never reaches 1).
+    while (true) {
+      if (control_[index] == EMPTY) {
+        return capacity_;
+      }
+      if (control_[index] == FULL && equal_(slots_[index].first, key)) {
+        return index;
+      }
+      index = (index + 1) & mask;
+    }
+  }
+
+  // Inserts a binding for `key` unless one already exists, in which
+  // case the value is only replaced if `overwrite` is set. Returns
+  // the slot index and whether an insertion took place.
+  template <typename K, typename V>
+  std::pair<size_t, bool> insert_(K&& key, V&& value, bool overwrite)
+  {
+    // Grow when the table would exceed a 7/8 load factor, counting
+    // tombstones. Sizing the new table off the live count purges
+    // tombstones without necessarily doubling.
+    if ((occupied_ + 1) * 8 > capacity_ * 7) {
+      rehash(capacityFor(size_ + 1));
+    }
+
+    const size_t mask = capacity_ - 1;
+    size_t index = hash_(key) & mask;
+    size_t insertion = capacity_;
+
+    while (true) {
+      if (control_[index] == EMPTY) {
+        if (insertion == capacity_) {
+          insertion = index;
+        }
+
+        if (control_[insertion] == EMPTY) {
+          ++occupied_;
+        }
+
+        new (&slots_[insertion])
+          Slot(std::forward<K>(key), std::forward<V>(value));
+        control_[insertion] = FULL;
+        ++size_;
+
+        return std::make_pair(insertion, true);
+      }
+
+      if (control_[index] == DELETED) {
+        // Remember the first tombstone so the entry gets inserted as
+        // early in its probe sequence as possible.
+        if (insertion == capacity_) {
+          insertion = index;
+        }
+      } else if (equal_(slots_[index].first, key)) {
+        if (overwrite) {
+          slots_[index].second = std::forward<V>(value);
+        }
+        return std::make_pair(index, false);
+      }
+
+      index = (index + 1) & mask;
+    }
+  }
+
+  // Moves all live entries into a new table of the given capacity
+  // (a power of two, large enough to hold them below the maximum
+  // load factor).
+  void rehash(size_t capacity)
+  {
+    uint8_t* oldControl = control_;
+    Slot* oldSlots = slots_;
+    const size_t oldCapacity = capacity_;
+
+    control_ = new uint8_t[capacity]();
+    slots_ = static_cast<Slot*>(::operator new(capacity * sizeof(Slot)));
+    capacity_ = capacity;
+    occupied_ = size_;
+
+    const size_t mask = capacity - 1;
+
+    for (size_t i = 0; i < oldCapacity; ++i) {
+      if (oldControl[i] == FULL) {
+        size_t index = hash_(oldSlots[i].first) & mask;
+        while (control_[index] != EMPTY) {
+          index = (index + 1) & mask;
+        }
+
+        new (&slots_[index]) Slot(std::move(oldSlots[i]));
+        control_[index] = FULL;
+        oldSlots[i].~Slot();
+      }
+    }
+
+    delete[] oldControl;
+    ::operator delete(oldSlots);
+  }
+
+  // Destroys all live entries (but does not touch the control array).
+  void destroy()
+  {
+    for (size_t i = 0; i < capacity_; ++i) {
+      if (control_[i] == FULL) {
+        slots_[i].~Slot();
+      }
+    }
+  }
+
+  uint8_t* control_ = nullptr;
+  Slot* slots_ = nullptr;
+
+  // The table capacity; always zero or a power of two, which turns
+  // the modulo in the probe sequence into a mask.
+  size_t capacity_ = 0;
+
+  // Number of live entries.
+  size_t size_ = 0;
+
+  // Number of slots that are not empty, i.e., live entries plus
+  // tombstones; this is what the load factor is computed from.
+  size_t occupied_ = 0;
+
+  Hash hash_;
+  Equal equal_;
+};
+
+
+template <typename K, typename V>
+std::ostream& operator<<(std::ostream& stream, const FlatHashMap<K, V>& map)
+{
+  // NOTE: We can't go through `stringify(map)` (as `hashmap` does)
+  // since the generic `stringify` overload would just come back to
+  // this operator.
+  stream << "{ ";
+  typename FlatHashMap<K, V>::const_iterator iterator = map.begin();
+  while (iterator != map.end()) {
+    stream << stringify(iterator->first) << ": "
+           << stringify(iterator->second);
+    if (++iterator != map.end()) {
+      stream << ", ";
+    }
+  }
+  return stream << " }";
+}
+
+#endif // __STOUT_FLATHASHMAP_HPP__
@@ -0,0 +1,158 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __STOUT_FLATHASHSET_HPP__
+#define __STOUT_FLATHASHSET_HPP__
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+#include "flathashmap.hpp"
+#include "nothing.hpp"
+#include "stringify.hpp"
+
+// Provides a hash set backed by open addressing with linear probing,
+// the set counterpart of `FlatHashMap` (see flathashmap.hpp for the
+// trade-offs versus the node based `hashset`). Implemented as a thin
+// adapter over `FlatHashMap` with an empty value.
+//
+// NOTE: Unlike `hashset`, insertion invalidates all iterators and
+// references into the set, and erasure invalidates iterators and
+// references to the erased element.
+template <typename Elem,
+          typename Hash = typename std::conditional<
+            std::is_enum<Elem>::value,
+            EnumClassHash,
+            std::hash<Elem>>::type,
+          typename Equal = std::equal_to<Elem>>
+class FlatHashSet
+{
+private:
+  typedef FlatHashMap<Elem, Nothing, Hash, Equal> Map;
+
+public:
+  // Set elements are immutable, so there is only a `const` iterator.
+  class const_iterator
+  {
+  public:
+    const Elem& operator*() const { return iterator_->first; }
+    const Elem* operator->() const { return &iterator_->first; }
+
+    const_iterator& operator++()
+    {
+      ++iterator_;
+      return *this;
+    }
+
+    bool operator==(const const_iterator& that) const
+    {
+      return iterator_ == that.iterator_;
+    }
+
+    bool operator!=(const const_iterator& that) const
+    {
+      return !(*this == that);
+    }
+
+  private:
+    friend class FlatHashSet;
+
+    explicit const_iterator(typename Map::const_iterator iterator)
+      : iterator_(iterator) {}
+
+    typename Map::const_iterator iterator_;
+  };
+
+  typedef const_iterator iterator;
+
+  FlatHashSet() {}
+
+  // Allow simple construction via initializer list.
+  FlatHashSet(std::initializer_list<Elem> list)
+  {
+    reserve(list.size());
+
+    for (auto iterator = list.begin(); iterator != list.end(); ++iterator) {
+      insert(*iterator);
+    }
+  }
+
+  size_t size() const { return map_.size(); }
+
+  bool empty() const { return map_.empty(); }
+
+  // Checks whether this set contains the element.
+  bool contains(const Elem& elem) const { return map_.contains(elem); }
+
+  size_t count(const Elem& elem) const { return map_.count(elem); }
+
+  std::pair<const_iterator, bool> insert(const Elem& elem)
+  {
+    std::pair<typename Map::iterator, bool> result =
+      map_.emplace(elem, Nothing());
+
+    return std::make_pair(const_iterator(result.first), result.second);
+  }
+
+  std::pair<const_iterator, bool> insert(Elem&& elem)
+  {
+    std::pair<typename Map::iterator, bool> result =
+      map_.emplace(std::move(elem), Nothing());
+
+    return std::make_pair(const_iterator(result.first), result.second);
+  }
+
+  size_t erase(const Elem& elem) { return map_.erase(elem); }
+
+  void clear() { map_.clear(); }
+
+  // Ensures that `n` elements fit without further growth.
+  void reserve(size_t n) { map_.reserve(n); }
+
+  const_iterator begin() const { return const_iterator(map_.begin()); }
+  const_iterator end() const { return const_iterator(map_.end()); }
+
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  const_iterator find(const Elem& elem) const
+  {
+    return const_iterator(map_.find(elem));
+  }
+
+private:
+  Map map_;
+};
+
+
+template <typename Elem>
+std::ostream& operator<<(std::ostream& stream, const FlatHashSet<Elem>& set)
+{
+  // NOTE: We can't go through `stringify(set)` (as `hashset` users
+  // do) since the generic `stringify` overload would just come back
+  // to this operator.
+  stream << "{ ";
+  typename FlatHashSet<Elem>::const_iterator iterator = set.begin();
+  while (iterator != set.end()) {
+    stream << stringify(*iterator);
+    if (++iterator != set.end()) {
+      stream << ", ";
+    }
+  }
+  return stream << " }";
+}
+
+#endif // __STOUT_FLATHASHSET_HPP__
@@ -25,7 +25,6 @@
 
 
 // Compression utilities.
-// TODO(bmahler): Provide streaming compression as well.
 namespace gzip {
 
 namespace internal {
@@ -169,6 +168,132 @@ private:
 };
 
 
+// Provides the ability to incrementally compress
+// a stream of uncompressed input data.
+class Compressor
+{
+public:
+  // The compression level should be within the range [-1, 9],
+  // see `compress` below. An invalid level is a programmer
+  // error and will abort.
+  explicit Compressor(int level = Z_DEFAULT_COMPRESSION)
+    : _finished(false)
+  {
+    stream.zalloc = Z_NULL;
+    stream.zfree = Z_NULL;
+    stream.opaque = Z_NULL;
+    stream.next_in = Z_NULL;
+    stream.avail_in = 0;
+
+    int code = deflateInit2(
+        &stream,
+        level,          // Compression level.
+        Z_DEFLATED,     // Compression method.
+        MAX_WBITS + 16, // Zlib magic for gzip compression / decompression.
+        8,              // Default memLevel value.
+        Z_DEFAULT_STRATEGY);
+
+    if (code != Z_OK) {
+      Error error = internal::GzipError("Failed to deflateInit2", stream, code);
+      ABORT(error.message);
+    }
+  }
+
+  Compressor(const Compressor&) = delete;
+  Compressor& operator=(const Compressor&) = delete;
+
+  ~Compressor()
+  {
+    // NOTE: `deflateEnd` returns `Z_DATA_ERROR` if the stream was
+    // discarded before being finished (e.g., the connection that a
+    // compressed stream was being written to was closed prematurely),
+    // which is not an error here.
+    int code = deflateEnd(&stream);
+    if (code != Z_OK && code != Z_DATA_ERROR) {
+      ABORT("Failed to deflateEnd");
+    }
+  }
+
+  // Returns the compression of the provided chunk of data. The
+  // stream is flushed such that the returned data (together with
+  // the data already returned) can be decompressed by the receiver
+  // without waiting for more input, at a small cost in compression
+  // ratio.
+  Try<std::string> compress(const std::string& data)
+  {
+    if (_finished) {
+      return Error("Compression stream is finished");
+    }
+
+    return deflate_(data, Z_SYNC_FLUSH);
+  }
+
+  // Terminates the compression stream and returns any remaining
+  // output. No further data can be compressed afterwards.
+  Try<std::string> finish()
+  {
+    if (_finished) {
+      return Error("Compression stream is finished");
+    }
+
+    Try<std::string> result = deflate_(std::string(), Z_FINISH);
+
+    if (result.isSome()) {
+      _finished = true;
+    }
+
+    return result;
+  }
+
+  // Returns whether the compression stream is finished,
+  // i.e., `finish` completed successfully.
+  bool finished() const
+  {
+    return _finished;
+  }
+
+private:
+  Try<std::string> deflate_(const std::string& data, int flush)
+  {
+    stream.next_in =
+      const_cast<Bytef*>(reinterpret_cast<const Bytef*>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.length());
+
+    // Build up the compressed result.
+    Bytef buffer[GZIP_BUFFER_SIZE];
+    std::string result;
+
+    do {
+      stream.next_out = buffer;
+      stream.avail_out = GZIP_BUFFER_SIZE;
+
+      int code = deflate(&stream, flush);
+
+      // NOTE: `Z_BUF_ERROR` just means no progress was possible
+      // (e.g., the flush already completed exactly at the end of
+      // the previous buffer); it does not poison the stream.
+      if (code != Z_OK && code != Z_STREAM_END && code != Z_BUF_ERROR) {
+        return internal::GzipError("Failed to deflate", stream, code);
+      }
+
+      // Consume output.
+      result.append(
+          reinterpret_cast<char*>(buffer),
+          GZIP_BUFFER_SIZE - stream.avail_out);
+
+      if (code == Z_STREAM_END || code == Z_BUF_ERROR) {
+        break;
+      }
+    } while (stream.avail_in > 0 || stream.avail_out == 0);
+
+    return result;
+  }
+
+  z_stream_s stream;
+  bool _finished;
+};
+
+
 // Returns a gzip compressed version of the provided string.
 // The compression level should be within the range [-1, 9].
 // See zlib.h:
@@ -13,19 +13,6 @@
 #ifndef __STOUT_JSON__
 #define __STOUT_JSON__
 
-// NOTE: This undef is necessary because we cannot reliably re-order the
-// include statements in all cases.  We define this flag globally since
-// PicoJson requires it before importing <inttypes.h>.  However, other
-// libraries may import <inttypes.h> before we import <picojson.h>.
-// Hence, we undefine the flag here to prevent the redefinition error.
-#undef __STDC_FORMAT_MACROS
-// We also need to define `PICOJSON_USE_INT64`, since we're
-// unconditionally using the `picojson::value::get<uint64_t>()` and
-// `picojson::value::is<uint64_t>()` functions below.
-#define PICOJSON_USE_INT64
-#include <picojson.h>
-#define __STDC_FORMAT_MACROS
-
 #include <iomanip>
 #include <iostream>
 #include <limits>
@@ -36,11 +23,15 @@
 
 #include <boost/variant.hpp>
 
+#include <rapidjson/error/en.h>
+#include <rapidjson/reader.h>
+
 #include <stout/check.hpp>
 #include <stout/foreach.hpp>
 #include <stout/jsonify.hpp>
 #include <stout/numify.hpp>
 #include <stout/result.hpp>
+#include <stout/stringify.hpp>
 #include <stout/strings.hpp>
 #include <stout/try.hpp>
 #include <stout/unreachable.hpp>
@@ -85,11 +76,10 @@ struct String
 };
 
 
-// NOTE: Due to how PicoJson parses unsigned integers, a roundtrip from Number
-// to JSON and back to Number will result in:
-//   - a signed integer, if the value is less than or equal to INT64_MAX;
-//   - or a double, if the value is greater than INT64_MAX.
-// See: https://github.com/kazuho/picojson/blob/rel/v1.3.0/picojson.h#L777-L781
+// NOTE: When parsing, integral values get parsed as:
+//   - a signed integer, if the value fits in an int64_t;
+//   - an unsigned integer, if the value fits in a uint64_t;
+//   - or a double otherwise.
 struct Number
 {
   Number() : value(0) {}
@@ -889,129 +879,193 @@ inline std::ostream& operator<<(std::ostream& stream, const Null& null)
 
 namespace internal {
 
-// "Depth" is counted downwards to stay closer to the analogous
-// implementation in PicoJSON.
+// Maximum level of nesting we accept, mirroring the limit of the
+// earlier PicoJSON based parser.
 constexpr size_t STOUT_JSON_MAX_DEPTH = 200;
 
-// Our implementation of picojson's parsing context that allows
-// us to parse directly into our JSON::Value.
+
+// A SAX style handler for rapidjson's `Reader` that builds a
+// `JSON::Value` directly, without going through rapidjson's DOM
+// (which would allocate a node per value only to be copied into
+// our representation afterwards).
 //
-// https://github.com/kazuho/picojson/blob/v1.3.0/picojson.h#L820-L870
-class ParseContext {
+// See: http://rapidjson.org/md_doc_sax.html
+class ParseHandler
+{
 public:
-  ParseContext(Value* _value, size_t _depth = STOUT_JSON_MAX_DEPTH)
-    : value(_value), depth(_depth) {}
-
-  ParseContext(const ParseContext&) = delete;
-  ParseContext &operator=(const ParseContext&) = delete;
-
-  bool set_null() { *value = Null(); return true; }
-  bool set_bool(bool b) { *value = Boolean(b); return true; }
-  bool set_int64(int64_t i) { *value = Number(i); return true; }
-
-  bool set_number(double f) {
-    // We take a trip through picojson::value here because it
-    // is where the validation takes place (i.e. it throws):
-    //   https://github.com/kazuho/picojson/issues/94
-    //   https://github.com/kazuho/picojson/blob/v1.3.0/picojson.h#L195-L208
-    picojson::value v(f);
-    *value = Number(v.get<double>());
-    return true;
+  explicit ParseHandler(Value* root) : values({root}) {}
+
+  ParseHandler(const ParseHandler&) = delete;
+  ParseHandler& operator=(const ParseHandler&) = delete;
+
+  bool Null() { return set(JSON::Null()); }
+  bool Bool(bool value) { return set(Boolean(value)); }
+
+  bool Int(int value) { return set(Number(static_cast<int64_t>(value))); }
+  bool Int64(int64_t value) { return set(Number(value)); }
+  bool Uint(unsigned value) { return set(Number(static_cast<int64_t>(value))); }
+  bool Uint64(uint64_t value) { return set(Number(value)); }
+  bool Double(double value) { return set(Number(value)); }
+
+  bool RawNumber(const char*, rapidjson::SizeType, bool)
+  {
+    // Only invoked when parsing with `kParseNumbersAsStringsFlag`.
+    UNREACHABLE();
   }
 
-  template <typename Iter>
-  bool parse_string(picojson::input<Iter>& in) {
-    *value = String();
-    return picojson::_parse_string(value->as<String>().value, in);
+  bool String(const char* data, rapidjson::SizeType length, bool)
+  {
+    return set(JSON::String(std::string(data, length)));
   }
 
-  bool parse_array_start() {
-    if (depth <= 0) {
+  bool Key(const char* data, rapidjson::SizeType length, bool)
+  {
+    key.assign(data, length);
+    return true;
+  }
+
+  bool StartObject()
+  {
+    if (depth == 0) {
       return false;
     }
     --depth;
-    *value = Array();
-    return true;
-  }
 
-  template <typename Iter>
-  bool parse_array_item(picojson::input<Iter>& in, size_t) {
-    Array& array = value->as<Array>();
-    array.values.push_back(Value());
-    ParseContext context(&array.values.back(), depth);
-    return picojson::_parse(context, in);
+    Value* value = slot();
+    *value = Object();
+    values.push_back(value);
+    return true;
   }
 
-  bool parse_array_stop(size_t) {
+  bool EndObject(rapidjson::SizeType)
+  {
     ++depth;
+    values.pop_back();
     return true;
   }
 
-  bool parse_object_start() {
-    if (depth <= 0) {
+  bool StartArray()
+  {
+    if (depth == 0) {
       return false;
     }
     --depth;
-    *value = Object();
+
+    Value* value = slot();
+    *value = Array();
+    values.push_back(value);
     return true;
   }
 
-  template <typename Iter>
-  bool parse_object_item(picojson::input<Iter>& in, const std::string& key) {
-    Object& object = value->as<Object>();
-    ParseContext context(&object.values[key], depth);
-    return picojson::_parse(context, in);
+  bool EndArray(rapidjson::SizeType)
+  {
+    ++depth;
+    values.pop_back();
+    return true;
   }
 
-  bool parse_object_stop() {
-    ++depth;
+private:
+  template <typename T>
+  bool set(T&& t)
+  {
+    *slot() = std::forward<T>(t);
     return true;
   }
 
-  Value* value;
-  size_t depth;
+  // Returns the location to store the next parsed value: a new item
+  // in the innermost open object or array, or the root itself.
+  Value* slot()
+  {
+    Value* enclosing = values.back();
+    if (enclosing->is<Object>()) {
+      return &enclosing->as<Object>().values[key];
+    } else if (enclosing->is<Array>()) {
+      Array& array = enclosing->as<Array>();
+      array.values.push_back(Value());
+      return &array.values.back();
+    }
+    return enclosing;
+  }
+
+  // Stack of the values being built: the root plus the currently
+  // open objects and arrays. Values are built in place, so there is
+  // nothing left to do when the parse finishes.
+  std::vector<Value*> values;
+
+  // Key of the object item currently being parsed.
+  std::string key;
+
+  size_t depth = STOUT_JSON_MAX_DEPTH;
 };
 
 } // namespace internal {
 
 
-inline Try<Value> parse(const std::string& s)
+// NOTE: The `(const char*, size_t)` overload exists so that callers
+// holding a slice of a larger buffer (e.g. a record in a "Record-IO"
+// stream) can parse it without first copying it into an
+// `std::string`, see `recordio::Decoder`.
+inline Try<Value> parse(const char* data, size_t size)
 {
-  const char* parseBegin = s.c_str();
-  Value value;
-  std::string error;
+  // We parse in situ, i.e., escaped strings get unescaped inside the
+  // buffer and handed to the handler without any intermediate copies
+  // or allocations, which requires the input to be mutable (and NUL
+  // terminated).
+  std::vector<char> buffer;
+  buffer.reserve(size + 1);
+  buffer.insert(buffer.end(), data, data + size);
+  buffer.push_back('\0');
 
-  // Because PicoJson supports repeated parsing of multiple objects/arrays in a
-  // stream, it will quietly ignore trailing non-whitespace characters. We would
-  // rather throw an error, however, so use `last_char` to check for this.
-  //
-  // TODO(alexr): Address cases when `s` is empty or consists only of whitespace
-  // characters.
-  const char* lastVisibleChar =
-    parseBegin + s.find_last_not_of(strings::WHITESPACE);
+  Value value;
+  internal::ParseHandler handler(&value);
+
+  rapidjson::Reader reader;
+  rapidjson::InsituStringStream stream(buffer.data());
+
+  // NOTE: `kParseStopWhenDoneFlag` makes the reader stop after the
+  // root value rather than erroring out on trailing characters, so
+  // that we can produce a more helpful error message below.
+  rapidjson::ParseResult result = reader.Parse<
+      rapidjson::kParseInsituFlag |
+      rapidjson::kParseStopWhenDoneFlag |
+      rapidjson::kParseFullPrecisionFlag |
+      rapidjson::kParseValidateEncodingFlag>(stream, handler);
+
+  if (!result) {
+    switch (result.Code()) {
+      case rapidjson::kParseErrorNumberTooBig:
+        return Error("Value out of range");
+      case rapidjson::kParseErrorTermination:
+        // The only way we terminate the parse is the depth check in
+        // the handler above.
+        return Error("Maximum JSON nesting depth exceeded");
+      default:
+        return Error(
+            std::string(rapidjson::GetParseError_En(result.Code())) +
+            " at offset " + stringify(stream.Tell()));
+    }
+  }
 
-  // Parse the string, returning a pointer to the character immediately
-  // following the last one parsed. Convert exceptions to `Error`s.
+  // Make sure that at most whitespace follows the root value.
   //
-  // TODO(alexr): Remove `try-catch` wrapper once picojson stops throwing
-  // on parsing, see https://github.com/kazuho/picojson/issues/94
-  const char* parseEnd;
-  try {
-    internal::ParseContext context(&value);
-    parseEnd =
-      picojson::_parse(context, parseBegin, parseBegin + s.size(), &error);
-  } catch (const std::overflow_error&) {
-    return Error("Value out of range");
-  } catch (...) {
-    return Error("Unknown JSON parse error");
+  // NOTE: with in situ parsing the stream only ever consumes source
+  // characters, so its offset is also an offset into `data`.
+  size_t offset = stream.Tell();
+  while (offset < size &&
+         strings::WHITESPACE.find(data[offset]) != std::string::npos) {
+    offset++;
   }
 
-  if (!error.empty()) {
-    return Error(error);
-  } else if (parseEnd != lastVisibleChar + 1) {
+  if (offset != size) {
+    size_t end = size;
+    while (end > 0 &&
+           strings::WHITESPACE.find(data[end - 1]) != std::string::npos) {
+      end--;
+    }
+
     return Error(
-        "Parsed JSON included non-whitespace trailing characters: "
-        + s.substr(parseEnd - parseBegin, lastVisibleChar + 1 - parseEnd));
+        "Parsed JSON included non-whitespace trailing characters: " +
+        std::string(data + offset, end - offset));
   }
 
   // TODO(bmahler): Newer compilers (clang-3.9 and gcc-5.1) can
@@ -1022,6 +1076,12 @@ inline Try<Value> parse(const std::string& s)
 }
 
 
+inline Try<Value> parse(const std::string& s)
+{
+  return parse(s.data(), s.size());
+}
+
+
 template <typename T>
 Try<T> parse(const std::string& s)
 {
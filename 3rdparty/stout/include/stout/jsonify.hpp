@@ -33,7 +33,6 @@
 // #  define RAPIDJSON_SSE42
 // #endif
 
-#include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
 #include <cstddef>
@@ -72,6 +71,97 @@ namespace JSON { class Proxy; }
 template <typename T>
 JSON::Proxy jsonify(const T&);
 
+namespace JSON {
+
+// The output buffer underlying the JSON writers below. This replaces
+// `rapidjson::StringBuffer` in order to optionally hand the serialized
+// bytes off to a sink in bounded chunks (see `Proxy::stream()`) rather
+// than accumulating the entire output in memory.
+class ChunkedBuffer
+{
+public:
+  typedef char Ch;
+
+  ChunkedBuffer() : sink_(nullptr), chunkSize_(0) {}
+
+  ChunkedBuffer(std::function<void(std::string&&)> sink, size_t chunkSize)
+    : sink_(std::move(sink)), chunkSize_(chunkSize) {}
+
+  void Put(Ch c)
+  {
+    buffer_ += c;
+
+    if (sink_ && buffer_.size() >= chunkSize_) {
+      Flush();
+    }
+  }
+
+  // Support for rapidjson's "reserve then append unchecked" write
+  // path (see the `rapidjson::PutReserve` and `rapidjson::PutUnsafe`
+  // specializations below). The writer formats numbers into stack
+  // buffers (shortest round-trip doubles via Grisu2 and direct
+  // integer-to-buffer emission) and sizes strings up front, reserves
+  // the bytes once, and then appends them without going through the
+  // capacity and chunking checks in `Put`.
+  void Reserve(size_t count)
+  {
+    if (sink_ && buffer_.size() >= chunkSize_) {
+      Flush();
+    }
+
+    buffer_.reserve(buffer_.size() + count);
+  }
+
+  void PutUnsafe(Ch c)
+  {
+    buffer_ += c;
+  }
+
+  // NOTE: This is invoked by `rapidjson::Writer` once the root value
+  // is complete, so a sink observes the entire output even if the
+  // last chunk is smaller than `chunkSize_`.
+  void Flush()
+  {
+    if (sink_ && !buffer_.empty()) {
+      sink_(std::move(buffer_));
+      buffer_.clear();
+    }
+  }
+
+  // Extracts the accumulated output; only sensible without a sink.
+  std::string&& Extract() { return std::move(buffer_); }
+
+private:
+  std::function<void(std::string&&)> sink_;
+  size_t chunkSize_;
+  std::string buffer_;
+};
+
+} // namespace JSON {
+
+
+namespace rapidjson {
+
+// Route rapidjson's batched writes to `ChunkedBuffer`, mirroring
+// what rapidjson does for its own `StringBuffer`. Without these the
+// generic fallbacks turn every `PutUnsafe` back into a checked
+// `Put`.
+template <>
+inline void PutReserve(JSON::ChunkedBuffer& stream, size_t count)
+{
+  stream.Reserve(count);
+}
+
+
+template <>
+inline void PutUnsafe(JSON::ChunkedBuffer& stream, char c)
+{
+  stream.PutUnsafe(c);
+}
+
+} // namespace rapidjson {
+
+
 namespace JSON {
 
 // The result of `jsonify`. This is a light-weight proxy object that can either
@@ -87,16 +177,29 @@ class Proxy
 public:
   operator std::string() &&
   {
-    rapidjson::StringBuffer buffer;
-    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    ChunkedBuffer buffer;
+    rapidjson::Writer<ChunkedBuffer> writer(buffer);
 
     write(&writer);
 
-    return {buffer.GetString(), buffer.GetSize()};
+    return buffer.Extract();
+  }
+
+  // Streams the serialized JSON into `sink` in chunks of roughly
+  // `chunkSize` bytes rather than materializing the entire output in
+  // memory first. The final chunk may be smaller than `chunkSize`.
+  void stream(
+      std::function<void(std::string&&)> sink,
+      size_t chunkSize = 64 * 1024) &&
+  {
+    ChunkedBuffer buffer(std::move(sink), chunkSize);
+    rapidjson::Writer<ChunkedBuffer> writer(buffer);
+
+    write(&writer);
   }
 
 private:
-  Proxy(std::function<void(rapidjson::Writer<rapidjson::StringBuffer>*)> write)
+  Proxy(std::function<void(rapidjson::Writer<ChunkedBuffer>*)> write)
     : write(std::move(write)) {}
 
   // We declare copy/move constructors `private` to prevent statements that try
@@ -120,7 +223,7 @@ private:
 public:
   // This is public in order to enable the `ObjectWriter` and `ArrayWriter`
   // to continue writing to the same writer.
-  std::function<void(rapidjson::Writer<rapidjson::StringBuffer>*)> write;
+  std::function<void(rapidjson::Writer<ChunkedBuffer>*)> write;
 };
 
 
@@ -136,7 +239,7 @@ inline std::ostream& operator<<(std::ostream& stream, Proxy&& that)
 class BooleanWriter
 {
 public:
-  BooleanWriter(rapidjson::Writer<rapidjson::StringBuffer>* writer)
+  BooleanWriter(rapidjson::Writer<ChunkedBuffer>* writer)
     : writer_(writer), value_(false) {}
 
   BooleanWriter(const BooleanWriter&) = delete;
@@ -150,7 +253,7 @@ public:
   void set(bool value) { value_ = value; }
 
 private:
-  rapidjson::Writer<rapidjson::StringBuffer>* writer_;
+  rapidjson::Writer<ChunkedBuffer>* writer_;
   bool value_;
 };
 
@@ -160,7 +263,7 @@ private:
 class NumberWriter
 {
 public:
-  NumberWriter(rapidjson::Writer<rapidjson::StringBuffer>* writer)
+  NumberWriter(rapidjson::Writer<ChunkedBuffer>* writer)
     : writer_(writer), type_(INT), int_(0) {}
 
   NumberWriter(const NumberWriter&) = delete;
@@ -235,7 +338,7 @@ public:
   }
 
 private:
-  rapidjson::Writer<rapidjson::StringBuffer>* writer_;
+  rapidjson::Writer<ChunkedBuffer>* writer_;
 
   enum { INT, UINT, DOUBLE } type_;
 
@@ -254,7 +357,7 @@ private:
 class StringWriter
 {
 public:
-  StringWriter(rapidjson::Writer<rapidjson::StringBuffer>* writer)
+  StringWriter(rapidjson::Writer<ChunkedBuffer>* writer)
     : writer_(writer), empty_(true) {}
 
   StringWriter(const StringWriter&) = delete;
@@ -285,7 +388,7 @@ public:
   }
 
 private:
-  rapidjson::Writer<rapidjson::StringBuffer>* writer_;
+  rapidjson::Writer<ChunkedBuffer>* writer_;
   bool empty_;
 };
 
@@ -295,7 +398,7 @@ private:
 class ArrayWriter
 {
 public:
-  ArrayWriter(rapidjson::Writer<rapidjson::StringBuffer>* writer)
+  ArrayWriter(rapidjson::Writer<ChunkedBuffer>* writer)
     : writer_(writer)
   {
     CHECK(writer_->StartArray());
@@ -316,7 +419,7 @@ public:
   void element(const T& value) { jsonify(value).write(writer_); }
 
 private:
-  rapidjson::Writer<rapidjson::StringBuffer>* writer_;
+  rapidjson::Writer<ChunkedBuffer>* writer_;
 };
 
 
@@ -325,7 +428,7 @@ private:
 class ObjectWriter
 {
 public:
-  ObjectWriter(rapidjson::Writer<rapidjson::StringBuffer>* writer)
+  ObjectWriter(rapidjson::Writer<ChunkedBuffer>* writer)
     : writer_(writer)
   {
     CHECK(writer_->StartObject());
@@ -356,14 +459,14 @@ public:
   }
 
 private:
-  rapidjson::Writer<rapidjson::StringBuffer>* writer_;
+  rapidjson::Writer<ChunkedBuffer>* writer_;
 };
 
 
 class NullWriter
 {
 public:
-  NullWriter(rapidjson::Writer<rapidjson::StringBuffer>* writer)
+  NullWriter(rapidjson::Writer<ChunkedBuffer>* writer)
     : writer_(writer) {}
 
   NullWriter(const NullWriter&) = delete;
@@ -375,7 +478,7 @@ public:
   NullWriter& operator=(NullWriter&&) = delete;
 
 private:
-  rapidjson::Writer<rapidjson::StringBuffer>* writer_;
+  rapidjson::Writer<ChunkedBuffer>* writer_;
 };
 
 
@@ -556,7 +659,7 @@ void json(ObjectWriter* writer, const Dictionary& dictionary)
 class WriterProxy
 {
 public:
-  WriterProxy(rapidjson::Writer<rapidjson::StringBuffer>* writer)
+  WriterProxy(rapidjson::Writer<ChunkedBuffer>* writer)
     : writer_(writer) {}
 
   ~WriterProxy()
@@ -654,7 +757,7 @@ private:
     NullWriter null_writer;
   };
 
-  rapidjson::Writer<rapidjson::StringBuffer>* writer_;
+  rapidjson::Writer<ChunkedBuffer>* writer_;
   Type type_;
   Writer proxy_;
 };
@@ -670,11 +773,11 @@ namespace internal {
 
 // Given an `F` which is a "write" function, we simply use it directly.
 template <typename F, typename = typename result_of<F(WriterProxy)>::type>
-std::function<void(rapidjson::Writer<rapidjson::StringBuffer>*)> jsonify(
+std::function<void(rapidjson::Writer<ChunkedBuffer>*)> jsonify(
     const F& write,
     Prefer)
 {
-  return [&write](rapidjson::Writer<rapidjson::StringBuffer>* writer) {
+  return [&write](rapidjson::Writer<ChunkedBuffer>* writer) {
       write(WriterProxy(writer));
   };
 }
@@ -685,11 +788,11 @@ std::function<void(rapidjson::Writer<rapidjson::StringBuffer>*)> jsonify(
 // namespace as well, since `WriterProxy` is intentionally defined in the
 // `JSON` namespace.
 template <typename T>
-std::function<void(rapidjson::Writer<rapidjson::StringBuffer>*)> jsonify(
+std::function<void(rapidjson::Writer<ChunkedBuffer>*)> jsonify(
     const T& value,
     LessPrefer)
 {
-  return [&value](rapidjson::Writer<rapidjson::StringBuffer>* writer) {
+  return [&value](rapidjson::Writer<ChunkedBuffer>* writer) {
     json(WriterProxy(writer), value);
   };
 }
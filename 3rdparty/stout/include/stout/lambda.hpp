@@ -16,6 +16,7 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <new>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -405,11 +406,12 @@ struct Invoke<void>
 // This is similar to `std::function`, but it can only be called once.
 // The "called once" semantics is enforced by having rvalue-ref qualifier
 // on `operator()`, so instances of `CallableOnce` must be `std::move`'d
-// in order to be invoked. Similar to `std::function`, this has heap
-// allocation overhead due to type erasure.
+// in order to be invoked.
 //
-// Note: Heap allocation can be avoided in some cases by implementing
-// small buffer optimization. This is currently not implemented.
+// Unlike `std::function` circa C++11, callables whose state fits into
+// the inline buffer are stored in place, so the common small-capture
+// case (e.g., a dispatch of a method pointer plus a few arguments)
+// does not allocate on the heap.
 template <typename F>
 class CallableOnce;
 
@@ -429,12 +431,52 @@ public:
                  R>::value),
           int>::type = 0>
   CallableOnce(F&& f)
-    : f(new CallableFn<typename std::decay<F>::type>(std::forward<F>(f))) {}
+  {
+    typedef CallableFn<typename std::decay<F>::type> Fn;
+
+    if (sizeof(Fn) <= BUFFER_SIZE &&
+        alignof(Fn) <= alignof(decltype(buffer))) {
+      this->f = new (&buffer) Fn(std::forward<F>(f));
+      local = true;
+    } else {
+      this->f = new Fn(std::forward<F>(f));
+    }
+  }
+
+  CallableOnce(CallableOnce&& that) : f(nullptr), local(false)
+  {
+    *this = std::move(that);
+  }
 
-  CallableOnce(CallableOnce&&) = default;
   CallableOnce(const CallableOnce&) = delete;
 
-  CallableOnce& operator=(CallableOnce&&) = default;
+  ~CallableOnce()
+  {
+    reset();
+  }
+
+  CallableOnce& operator=(CallableOnce&& that)
+  {
+    if (this == &that) {
+      return *this;
+    }
+
+    reset();
+
+    if (that.f != nullptr) {
+      if (that.local) {
+        f = std::move(*that.f).moveTo(&buffer);
+        local = true;
+        that.reset();
+      } else {
+        f = that.f;
+        that.f = nullptr;
+      }
+    }
+
+    return *this;
+  }
+
   CallableOnce& operator=(const CallableOnce&) = delete;
 
   R operator()(Args... args) &&
@@ -448,6 +490,11 @@ private:
   {
     virtual ~Callable() = default;
     virtual R operator()(Args&&...) && = 0;
+
+    // Move constructs this callable into the given storage and
+    // returns the newly constructed copy. Only invoked for callables
+    // living in the inline buffer.
+    virtual Callable* moveTo(void* storage) && = 0;
   };
 
   template <typename F>
@@ -462,9 +509,34 @@ private:
     {
       return internal::Invoke<R>{}(std::move(f), std::forward<Args>(args)...);
     }
+
+    Callable* moveTo(void* storage) && override
+    {
+      return new (storage) CallableFn(std::move(f));
+    }
   };
 
-  std::unique_ptr<Callable> f;
+  void reset()
+  {
+    if (f != nullptr) {
+      if (local) {
+        f->~Callable();
+      } else {
+        delete f;
+      }
+      f = nullptr;
+      local = false;
+    }
+  }
+
+  static constexpr size_t BUFFER_SIZE = 112;
+
+  typename std::aligned_storage<BUFFER_SIZE>::type buffer;
+
+  Callable* f = nullptr;
+
+  // Whether `f` lives in `buffer`.
+  bool local = false;
 };
 
 } // namespace lambda {
@@ -53,6 +53,7 @@
 #include <stout/os/int_fd.hpp>
 #include <stout/os/kill.hpp>
 #include <stout/os/ls.hpp>
+#include <stout/os/lsdir.hpp>
 #include <stout/os/lseek.hpp>
 #include <stout/os/lsof.hpp>
 #include <stout/os/mkdir.hpp>
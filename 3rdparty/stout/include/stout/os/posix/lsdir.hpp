@@ -0,0 +1,150 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __STOUT_OS_POSIX_LSDIR_HPP__
+#define __STOUT_OS_POSIX_LSDIR_HPP__
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include <string>
+#include <vector>
+
+#include <stout/error.hpp>
+#include <stout/try.hpp>
+
+
+namespace os {
+
+// A directory entry together with its type, as provided by the
+// directory scan itself. This lets callers that filter the entries of
+// a large directory (e.g. agent recovery or garbage collection
+// walking sandbox trees) avoid a `stat` call per entry on top of
+// reading the directory, see `lsdir` below.
+//
+// NOTE: Like `lstat`, the type describes the entry itself: a symbolic
+// link has type `SYMLINK` regardless of what it points to.
+struct DirEntry
+{
+  enum class Type
+  {
+    DIRECTORY,
+    FILE, // A regular file.
+    SYMLINK,
+    OTHER // Devices, sockets, FIFOs, or entries we failed to type.
+  };
+
+  std::string name;
+  Type type;
+};
+
+
+// Returns the entries of the given directory (excluding `.` and `..`)
+// together with each entry's type, in a single pass over the
+// directory: on filesystems which fill in `d_type` no additional
+// system calls are made, and elsewhere the type is resolved with
+// `fstatat` against the already opened directory (which avoids
+// re-traversing the directory's path for every entry).
+inline Try<std::vector<DirEntry>> lsdir(const std::string& directory)
+{
+  DIR* dir = opendir(directory.c_str());
+
+  if (dir == nullptr) {
+    return ErrnoError("Failed to opendir '" + directory + "'");
+  }
+
+  std::vector<DirEntry> result;
+  struct dirent* entry;
+
+  // Zero `errno` before starting to call `readdir`. This is necessary
+  // to allow us to determine when `readdir` returns an error.
+  errno = 0;
+
+  while ((entry = readdir(dir)) != nullptr) {
+    if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+      continue;
+    }
+
+    DirEntry::Type type = DirEntry::Type::OTHER;
+    bool resolved = false;
+
+#ifdef DT_UNKNOWN
+    // `d_type` is not POSIX but comes for free with the directory
+    // scan where supported; `DT_UNKNOWN` means the filesystem does
+    // not provide the type and we have to resolve it ourselves.
+    switch (entry->d_type) {
+      case DT_DIR:
+        type = DirEntry::Type::DIRECTORY;
+        resolved = true;
+        break;
+      case DT_REG:
+        type = DirEntry::Type::FILE;
+        resolved = true;
+        break;
+      case DT_LNK:
+        type = DirEntry::Type::SYMLINK;
+        resolved = true;
+        break;
+      case DT_UNKNOWN:
+        break;
+      default:
+        resolved = true;
+        break;
+    }
+#endif
+
+    if (!resolved) {
+      struct ::stat s;
+
+      if (::fstatat(
+              dirfd(dir), entry->d_name, &s, AT_SYMLINK_NOFOLLOW) == 0) {
+        if (S_ISDIR(s.st_mode)) {
+          type = DirEntry::Type::DIRECTORY;
+        } else if (S_ISREG(s.st_mode)) {
+          type = DirEntry::Type::FILE;
+        } else if (S_ISLNK(s.st_mode)) {
+          type = DirEntry::Type::SYMLINK;
+        }
+      }
+
+      // NOTE: If `fstatat` failed (e.g. because the entry got removed
+      // concurrently) we still return the entry, typed as `OTHER`.
+    }
+
+    result.push_back(DirEntry{entry->d_name, type});
+
+    // Re-zero `errno`: the calls above may have clobbered it, which
+    // would break the error detection for `readdir` below.
+    errno = 0;
+  }
+
+  if (errno != 0) {
+    // Preserve `readdir` error.
+    Error error = ErrnoError("Failed to read directory");
+    closedir(dir);
+    return error;
+  }
+
+  if (closedir(dir) == -1) {
+    return ErrnoError("Failed to close directory");
+  }
+
+  return result;
+}
+
+} // namespace os {
+
+#endif // __STOUT_OS_POSIX_LSDIR_HPP__
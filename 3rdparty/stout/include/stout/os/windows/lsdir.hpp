@@ -0,0 +1,100 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __STOUT_OS_WINDOWS_LSDIR_HPP__
+#define __STOUT_OS_WINDOWS_LSDIR_HPP__
+
+#include <string>
+#include <vector>
+
+#include <stout/error.hpp>
+#include <stout/try.hpp>
+
+#include <stout/internal/windows/longpath.hpp>
+
+
+namespace os {
+
+// See the POSIX version of this header for API documentation. Note
+// that symbolic links (reparse points) are typed `SYMLINK` regardless
+// of what they point to, mirroring the `lstat` semantics there.
+struct DirEntry
+{
+  enum class Type
+  {
+    DIRECTORY,
+    FILE, // A regular file.
+    SYMLINK,
+    OTHER
+  };
+
+  std::string name;
+  Type type;
+};
+
+
+inline Try<std::vector<DirEntry>> lsdir(const std::string& directory)
+{
+  // Ensure the path ends with a backslash.
+  std::string path = directory;
+  if (!strings::endsWith(path, "\\")) {
+    path += "\\";
+  }
+
+  // Get first file matching pattern `X:\path\to\wherever\*`.
+  WIN32_FIND_DATAW found;
+  const std::wstring search_pattern =
+    ::internal::windows::longpath(path) + L"*";
+
+  const SharedHandle search_handle(
+      ::FindFirstFileW(search_pattern.data(), &found),
+      ::FindClose);
+
+  if (search_handle.get() == INVALID_HANDLE_VALUE) {
+    return WindowsError("Failed to search '" + directory + "'");
+  }
+
+  std::vector<DirEntry> result;
+
+  do {
+    // NOTE: do-while is appropriate here because folder is guaranteed to have
+    // at least a file called `.` (and probably also one called `..`).
+    const std::wstring current_file(found.cFileName);
+
+    const bool is_current_directory = current_file.compare(L".") == 0;
+    const bool is_parent_directory = current_file.compare(L"..") == 0;
+
+    // Ignore the `.` and `..` files in the directory.
+    if (is_current_directory || is_parent_directory) {
+      continue;
+    }
+
+    // `FindFirstFileW` already hands us each entry's attributes, so
+    // typing the entries requires no further system calls.
+    DirEntry::Type type;
+    if (found.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) {
+      type = DirEntry::Type::SYMLINK;
+    } else if (found.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+      type = DirEntry::Type::DIRECTORY;
+    } else {
+      type = DirEntry::Type::FILE;
+    }
+
+    result.push_back(DirEntry{stringify(current_file), type});
+  } while (::FindNextFileW(search_handle.get(), &found));
+
+  return result;
+}
+
+} // namespace os {
+
+#endif // __STOUT_OS_WINDOWS_LSDIR_HPP__
@@ -51,6 +51,18 @@ inline Try<double> usage(const std::string& path = "/")
 }
 
 
+// Returns the amount of disk space used on the file system that the
+// given path is mounted at.
+inline Try<Bytes> used(const std::string& path = "/")
+{
+  struct statvfs buf;
+  if (statvfs(path.c_str(), &buf) < 0) {
+    return ErrnoError("Error invoking statvfs on '" + path + "'");
+  }
+  return Bytes((buf.f_blocks - buf.f_bfree) * buf.f_frsize);
+}
+
+
 inline Try<Nothing> symlink(
     const std::string& original,
     const std::string& link)
@@ -16,6 +16,7 @@
 #include <assert.h>
 #include <errno.h>
 #include <stdint.h>
+#include <string.h>
 #ifndef __WINDOWS__
 #include <unistd.h>
 #endif // __WINDOWS__
@@ -33,6 +34,9 @@
 
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 
+#include <rapidjson/error/en.h>
+#include <rapidjson/reader.h>
+
 #include <stout/abort.hpp>
 #include <stout/base64.hpp>
 #include <stout/error.hpp>
@@ -772,6 +776,530 @@ struct Parse<google::protobuf::RepeatedPtrField<T>>
   }
 };
 
+
+// A SAX style handler for rapidjson's `Reader` that transcodes a JSON
+// document directly into a protobuf message, without materializing the
+// intermediate `JSON::Value` tree that `parse(message, object)` above
+// walks. The semantics mirror `Parser`: unknown fields are skipped,
+// 'null' leaves a field unset, strings are coerced into numeric,
+// boolean and enum fields, bytes fields are base64 decoded, and
+// unrecognized values for non-required enum fields are discarded.
+//
+// See: http://rapidjson.org/md_doc_sax.html
+class ParseHandler
+{
+public:
+  explicit ParseHandler(google::protobuf::Message* _root) : root(_root) {}
+
+  ParseHandler(const ParseHandler&) = delete;
+  ParseHandler& operator=(const ParseHandler&) = delete;
+
+  // Returns the semantic error encountered during the parse, if any.
+  // Only valid once the parse has finished (unsuccessfully).
+  const Option<Error>& parseError() const { return error; }
+
+  bool Null()
+  {
+    if (skipping()) {
+      return true;
+    }
+
+    if (frames.empty()) {
+      return fail("Expecting a JSON object");
+    }
+
+    // As in `Parser`, 'null' is treated as an unset field; the caller
+    // is responsible for checking `IsInitialized`.
+    consumed();
+    return true;
+  }
+
+  bool Bool(bool value)
+  {
+    if (skipping()) {
+      return true;
+    }
+
+    if (frames.empty()) {
+      return fail("Expecting a JSON object");
+    }
+
+    Frame& frame = frames.back();
+    if (!setBool(frame.message, frame.field, value)) {
+      return false;
+    }
+
+    consumed();
+    return true;
+  }
+
+  bool Int(int value) { return number(JSON::Number(value)); }
+  bool Int64(int64_t value) { return number(JSON::Number(value)); }
+  bool Uint(unsigned value) { return number(JSON::Number(value)); }
+  bool Uint64(uint64_t value) { return number(JSON::Number(value)); }
+  bool Double(double value) { return number(JSON::Number(value)); }
+
+  bool RawNumber(const char*, rapidjson::SizeType, bool)
+  {
+    // Only invoked when parsing with `kParseNumbersAsStringsFlag`.
+    UNREACHABLE();
+  }
+
+  bool String(const char* data, rapidjson::SizeType length, bool)
+  {
+    if (skipping()) {
+      return true;
+    }
+
+    if (frames.empty()) {
+      return fail("Expecting a JSON object");
+    }
+
+    Frame& frame = frames.back();
+    if (!setString(frame.message, frame.field, std::string(data, length))) {
+      return false;
+    }
+
+    consumed();
+    return true;
+  }
+
+  bool Key(const char* data, rapidjson::SizeType length, bool)
+  {
+    if (skipDepth > 0) {
+      return true;
+    }
+
+    Frame& frame = frames.back();
+
+    if (frame.mapField != nullptr) {
+      // Each key of a map starts a new entry, which is equivalent to:
+      //
+      //   message MapFieldEntry {
+      //     optional key_type key = 1;
+      //     optional value_type value = 2;
+      //   }
+      //
+      //   repeated MapFieldEntry map_field = N;
+      //
+      // See the link below for details:
+      // https://developers.google.com/protocol-buffers/docs/proto#maps
+      frame.message = frame.parent->GetReflection()->AddMessage(
+          frame.parent, frame.mapField);
+
+      const google::protobuf::Descriptor* descriptor =
+        frame.mapField->message_type();
+
+      if (!setString(
+              frame.message,
+              descriptor->FindFieldByNumber(1),
+              std::string(data, length))) {
+        return false;
+      }
+
+      frame.field = descriptor->FindFieldByNumber(2);
+      return true;
+    }
+
+    frame.field = frame.message->GetDescriptor()->FindFieldByName(
+        std::string(data, length));
+
+    if (frame.field == nullptr) {
+      // Unknown field: skip the value that follows.
+      skipValue = true;
+    }
+
+    return true;
+  }
+
+  bool StartObject()
+  {
+    if (depth == 0) {
+      return fail("Maximum JSON nesting depth exceeded");
+    }
+    --depth;
+
+    if (skipDepth > 0) {
+      ++skipDepth;
+      return true;
+    }
+
+    if (skipValue) {
+      skipValue = false;
+      skipDepth = 1;
+      return true;
+    }
+
+    // The top level object is the message itself.
+    if (frames.empty()) {
+      frames.push_back(Frame{root, nullptr, nullptr, nullptr, 0});
+      return true;
+    }
+
+    Frame& frame = frames.back();
+    const google::protobuf::FieldDescriptor* field = frame.field;
+
+    assert(field != nullptr);
+
+    if (field->type() != google::protobuf::FieldDescriptor::TYPE_MESSAGE) {
+      return fail(
+          "Not expecting a JSON object for field '" + field->name() + "'");
+    }
+
+    const google::protobuf::Reflection* reflection =
+      frame.message->GetReflection();
+
+    if (field->is_map()) {
+      frames.push_back(Frame{nullptr, frame.message, field, nullptr, 0});
+    } else if (field->is_repeated()) {
+      frames.push_back(Frame{
+          reflection->AddMessage(frame.message, field),
+          nullptr, nullptr, nullptr, 0});
+    } else {
+      frames.push_back(Frame{
+          reflection->MutableMessage(frame.message, field),
+          nullptr, nullptr, nullptr, 0});
+    }
+
+    return true;
+  }
+
+  bool EndObject(rapidjson::SizeType)
+  {
+    ++depth;
+
+    if (skipDepth > 0) {
+      --skipDepth;
+      return true;
+    }
+
+    frames.pop_back();
+
+    if (!frames.empty()) {
+      consumed();
+    }
+
+    return true;
+  }
+
+  bool StartArray()
+  {
+    if (depth == 0) {
+      return fail("Maximum JSON nesting depth exceeded");
+    }
+    --depth;
+
+    if (skipDepth > 0) {
+      ++skipDepth;
+      return true;
+    }
+
+    if (skipValue) {
+      skipValue = false;
+      skipDepth = 1;
+      return true;
+    }
+
+    if (frames.empty()) {
+      return fail("Expecting a JSON object");
+    }
+
+    Frame& frame = frames.back();
+
+    assert(frame.field != nullptr);
+
+    if (!frame.field->is_repeated()) {
+      return fail(
+          "Not expecting a JSON array for field '" +
+          frame.field->name() + "'");
+    }
+
+    ++frame.arrayDepth;
+    return true;
+  }
+
+  bool EndArray(rapidjson::SizeType)
+  {
+    ++depth;
+
+    if (skipDepth > 0) {
+      --skipDepth;
+      return true;
+    }
+
+    Frame& frame = frames.back();
+
+    --frame.arrayDepth;
+    consumed();
+
+    return true;
+  }
+
+private:
+  // The message (or map entry) currently being filled, along with the
+  // field the next value is destined for. A frame is pushed for every
+  // open JSON object: either a (possibly nested or repeated) message,
+  // or a map field, in which case values are routed into freshly
+  // added entries of `mapField` on `parent`.
+  struct Frame
+  {
+    google::protobuf::Message* message;
+    google::protobuf::Message* parent;
+    const google::protobuf::FieldDescriptor* mapField;
+    const google::protobuf::FieldDescriptor* field;
+    int arrayDepth;
+  };
+
+  bool fail(const std::string& message)
+  {
+    error = Error(message);
+    return false;
+  }
+
+  // Handles values of fields we do not know: any value directly
+  // following an unknown key ('skipValue') and everything inside a
+  // skipped object or array ('skipDepth').
+  bool skipping()
+  {
+    if (skipDepth > 0) {
+      return true;
+    }
+
+    if (skipValue) {
+      skipValue = false;
+      return true;
+    }
+
+    return false;
+  }
+
+  // Called after a value has been stored: outside of an array the
+  // field is complete, so clear it until the next key.
+  void consumed()
+  {
+    Frame& frame = frames.back();
+    if (frame.arrayDepth == 0) {
+      frame.field = nullptr;
+    }
+  }
+
+  bool number(const JSON::Number& value)
+  {
+    if (skipping()) {
+      return true;
+    }
+
+    if (frames.empty()) {
+      return fail("Expecting a JSON object");
+    }
+
+    Frame& frame = frames.back();
+    if (!setNumber(frame.message, frame.field, value)) {
+      return false;
+    }
+
+    consumed();
+    return true;
+  }
+
+  bool setNumber(
+      google::protobuf::Message* message,
+      const google::protobuf::FieldDescriptor* field,
+      const JSON::Number& number)
+  {
+    const google::protobuf::Reflection* reflection = message->GetReflection();
+
+    assert(field != nullptr);
+
+    switch (field->type()) {
+      case google::protobuf::FieldDescriptor::TYPE_DOUBLE:
+        if (field->is_repeated()) {
+          reflection->AddDouble(message, field, number.as<double>());
+        } else {
+          reflection->SetDouble(message, field, number.as<double>());
+        }
+        break;
+      case google::protobuf::FieldDescriptor::TYPE_FLOAT:
+        if (field->is_repeated()) {
+          reflection->AddFloat(message, field, number.as<float>());
+        } else {
+          reflection->SetFloat(message, field, number.as<float>());
+        }
+        break;
+      case google::protobuf::FieldDescriptor::TYPE_INT64:
+      case google::protobuf::FieldDescriptor::TYPE_SINT64:
+      case google::protobuf::FieldDescriptor::TYPE_SFIXED64:
+        if (field->is_repeated()) {
+          reflection->AddInt64(message, field, number.as<int64_t>());
+        } else {
+          reflection->SetInt64(message, field, number.as<int64_t>());
+        }
+        break;
+      case google::protobuf::FieldDescriptor::TYPE_UINT64:
+      case google::protobuf::FieldDescriptor::TYPE_FIXED64:
+        if (field->is_repeated()) {
+          reflection->AddUInt64(message, field, number.as<uint64_t>());
+        } else {
+          reflection->SetUInt64(message, field, number.as<uint64_t>());
+        }
+        break;
+      case google::protobuf::FieldDescriptor::TYPE_INT32:
+      case google::protobuf::FieldDescriptor::TYPE_SINT32:
+      case google::protobuf::FieldDescriptor::TYPE_SFIXED32:
+        if (field->is_repeated()) {
+          reflection->AddInt32(message, field, number.as<int32_t>());
+        } else {
+          reflection->SetInt32(message, field, number.as<int32_t>());
+        }
+        break;
+      case google::protobuf::FieldDescriptor::TYPE_UINT32:
+      case google::protobuf::FieldDescriptor::TYPE_FIXED32:
+        if (field->is_repeated()) {
+          reflection->AddUInt32(message, field, number.as<uint32_t>());
+        } else {
+          reflection->SetUInt32(message, field, number.as<uint32_t>());
+        }
+        break;
+      default:
+        return fail("Not expecting a JSON number for field '" +
+                    field->name() + "'");
+    }
+    return true;
+  }
+
+  bool setBool(
+      google::protobuf::Message* message,
+      const google::protobuf::FieldDescriptor* field,
+      bool value)
+  {
+    const google::protobuf::Reflection* reflection = message->GetReflection();
+
+    assert(field != nullptr);
+
+    switch (field->type()) {
+      case google::protobuf::FieldDescriptor::TYPE_BOOL:
+        if (field->is_repeated()) {
+          reflection->AddBool(message, field, value);
+        } else {
+          reflection->SetBool(message, field, value);
+        }
+        break;
+      default:
+        return fail("Not expecting a JSON boolean for field '" +
+                    field->name() + "'");
+    }
+    return true;
+  }
+
+  bool setString(
+      google::protobuf::Message* message,
+      const google::protobuf::FieldDescriptor* field,
+      std::string&& value)
+  {
+    const google::protobuf::Reflection* reflection = message->GetReflection();
+
+    assert(field != nullptr);
+
+    switch (field->type()) {
+      case google::protobuf::FieldDescriptor::TYPE_STRING:
+        if (field->is_repeated()) {
+          reflection->AddString(message, field, std::move(value));
+        } else {
+          reflection->SetString(message, field, std::move(value));
+        }
+        break;
+      case google::protobuf::FieldDescriptor::TYPE_BYTES: {
+        Try<std::string> decode = base64::decode(value);
+        if (decode.isError()) {
+          return fail("Failed to base64 decode bytes field"
+                      " '" + field->name() + "': " + decode.error());
+        }
+
+        if (field->is_repeated()) {
+          reflection->AddString(message, field, decode.get());
+        } else {
+          reflection->SetString(message, field, decode.get());
+        }
+        break;
+      }
+      case google::protobuf::FieldDescriptor::TYPE_ENUM: {
+        const google::protobuf::EnumValueDescriptor* descriptor =
+          field->enum_type()->FindValueByName(value);
+
+        if (descriptor == nullptr) {
+          if (field->is_required()) {
+            return fail("Failed to find enum for '" + value + "'");
+          }
+
+          // Unrecognized enum values are discarded for non-required
+          // enum fields, consistent with proto2 deserialization (see
+          // `Parser` above).
+          break;
+        }
+
+        if (field->is_repeated()) {
+          reflection->AddEnum(message, field, descriptor);
+        } else {
+          reflection->SetEnum(message, field, descriptor);
+        }
+        break;
+      }
+      case google::protobuf::FieldDescriptor::TYPE_DOUBLE:
+      case google::protobuf::FieldDescriptor::TYPE_FLOAT:
+      case google::protobuf::FieldDescriptor::TYPE_INT64:
+      case google::protobuf::FieldDescriptor::TYPE_SINT64:
+      case google::protobuf::FieldDescriptor::TYPE_SFIXED64:
+      case google::protobuf::FieldDescriptor::TYPE_UINT64:
+      case google::protobuf::FieldDescriptor::TYPE_FIXED64:
+      case google::protobuf::FieldDescriptor::TYPE_INT32:
+      case google::protobuf::FieldDescriptor::TYPE_SINT32:
+      case google::protobuf::FieldDescriptor::TYPE_SFIXED32:
+      case google::protobuf::FieldDescriptor::TYPE_UINT32:
+      case google::protobuf::FieldDescriptor::TYPE_FIXED32: {
+        Try<JSON::Number> number = JSON::parse<JSON::Number>(value);
+        if (number.isError()) {
+          return fail(
+              "Failed to parse '" + value + "' as a JSON number "
+              "for field '" + field->name() + "': " + number.error());
+        }
+
+        return setNumber(message, field, number.get());
+      }
+      case google::protobuf::FieldDescriptor::TYPE_BOOL: {
+        Try<JSON::Boolean> boolean = JSON::parse<JSON::Boolean>(value);
+        if (boolean.isError()) {
+          return fail(
+              "Failed to parse '" + value + "' as a JSON boolean "
+              "for field '" + field->name() + "': " + boolean.error());
+        }
+
+        return setBool(message, field, boolean->value);
+      }
+      default:
+        return fail("Not expecting a JSON string for field '" +
+                    field->name() + "'");
+    }
+    return true;
+  }
+
+  google::protobuf::Message* root;
+
+  // Stack of the open JSON objects being transcoded.
+  std::vector<Frame> frames;
+
+  // Non-zero while inside an object or array belonging to an unknown
+  // field; counts the nesting relative to the skipped value.
+  size_t skipDepth = 0;
+
+  // Set when the key just parsed has no corresponding field, meaning
+  // the next value is to be discarded.
+  bool skipValue = false;
+
+  size_t depth = JSON::internal::STOUT_JSON_MAX_DEPTH;
+
+  Option<Error> error;
+};
+
 } // namespace internal {
 
 // A dispatch wrapper which parses protobuf messages(s) from a given JSON value.
@@ -788,6 +1316,74 @@ Try<T> parse(const JSON::Value& value)
   return internal::Parse<T>()(value);
 }
 
+
+// Parses a single protobuf message of type T directly from the bytes
+// of a JSON document in one pass. This is semantically equivalent to
+// `parse<T>(JSON::parse(data, size).get())` but transcodes the JSON
+// straight into the message, avoiding the allocation and traversal of
+// the intermediate `JSON::Value` tree.
+template <typename T>
+Try<T> parse(const char* data, size_t size)
+{
+  static_assert(std::is_convertible<T*, google::protobuf::Message*>::value,
+                "T must be a protobuf message");
+
+  T message;
+
+  internal::ParseHandler handler(&message);
+
+  // We parse in situ (escaped strings get unescaped inside the
+  // buffer), which requires the input to be mutable and NUL
+  // terminated.
+  std::vector<char> buffer;
+  buffer.reserve(size + 1);
+  buffer.insert(buffer.end(), data, data + size);
+  buffer.push_back('\0');
+
+  rapidjson::Reader reader;
+  rapidjson::InsituStringStream stream(buffer.data());
+
+  rapidjson::ParseResult result = reader.Parse<
+      rapidjson::kParseInsituFlag |
+      rapidjson::kParseFullPrecisionFlag |
+      rapidjson::kParseValidateEncodingFlag>(stream, handler);
+
+  if (!result) {
+    // The handler terminates the parse when it encounters a semantic
+    // error; otherwise the JSON itself was malformed.
+    if (handler.parseError().isSome()) {
+      return handler.parseError().get();
+    }
+
+    return Error(
+        std::string(rapidjson::GetParseError_En(result.Code())) +
+        " at offset " + stringify(result.Offset()));
+  }
+
+  if (!message.IsInitialized()) {
+    return Error("Missing required fields: " +
+                 message.InitializationErrorString());
+  }
+
+  return message;
+}
+
+
+template <typename T>
+Try<T> parse(const std::string& value)
+{
+  return parse<T>(value.data(), value.size());
+}
+
+
+// NOTE: This overload disambiguates string literals, which otherwise
+// convert equally well to `std::string` and `JSON::Value`.
+template <typename T>
+Try<T> parse(const char* value)
+{
+  return parse<T>(value, ::strlen(value));
+}
+
 } // namespace protobuf {
 
 namespace JSON {
@@ -835,7 +1431,117 @@ inline void json(ObjectWriter* writer, const Protobuf& protobuf)
   }
 
   foreach (const FieldDescriptor* field, fields) {
-    if (field->is_repeated()) {
+    if (field->is_map()) {
+      writer->field(
+          field->name(),
+          [&field, &reflection, &message](JSON::ObjectWriter* writer) {
+            int fieldSize = reflection->FieldSize(message, field);
+            for (int i = 0; i < fieldSize; ++i) {
+              const google::protobuf::Message& entry =
+                reflection->GetRepeatedMessage(message, field, i);
+
+              // A map entry is a message holding the key as field 1
+              // and the value as field 2; see `JSON::protobuf()`
+              // below for details.
+              const google::protobuf::Reflection* entryReflection =
+                entry.GetReflection();
+
+              const FieldDescriptor* keyField =
+                entry.GetDescriptor()->FindFieldByNumber(1);
+
+              const FieldDescriptor* valueField =
+                entry.GetDescriptor()->FindFieldByNumber(2);
+
+              // Protobuf map keys are integral, boolean or string,
+              // while JSON object keys are always strings.
+              std::string key;
+              switch (keyField->cpp_type()) {
+                case FieldDescriptor::CPPTYPE_BOOL:
+                  key = entryReflection->GetBool(entry, keyField)
+                    ? "true" : "false";
+                  break;
+                case FieldDescriptor::CPPTYPE_INT32:
+                  key = stringify(
+                      entryReflection->GetInt32(entry, keyField));
+                  break;
+                case FieldDescriptor::CPPTYPE_INT64:
+                  key = stringify(
+                      entryReflection->GetInt64(entry, keyField));
+                  break;
+                case FieldDescriptor::CPPTYPE_UINT32:
+                  key = stringify(
+                      entryReflection->GetUInt32(entry, keyField));
+                  break;
+                case FieldDescriptor::CPPTYPE_UINT64:
+                  key = stringify(
+                      entryReflection->GetUInt64(entry, keyField));
+                  break;
+                case FieldDescriptor::CPPTYPE_STRING:
+                  key = entryReflection->GetStringReference(
+                      entry, keyField, nullptr);
+                  break;
+                case FieldDescriptor::CPPTYPE_FLOAT:
+                case FieldDescriptor::CPPTYPE_DOUBLE:
+                case FieldDescriptor::CPPTYPE_MESSAGE:
+                case FieldDescriptor::CPPTYPE_ENUM:
+                  ABORT("Unexpected protobuf map key type: " +
+                        stringify(keyField->type()));
+              }
+
+              switch (valueField->cpp_type()) {
+                case FieldDescriptor::CPPTYPE_BOOL:
+                  writer->field(
+                      key, entryReflection->GetBool(entry, valueField));
+                  break;
+                case FieldDescriptor::CPPTYPE_INT32:
+                  writer->field(
+                      key, entryReflection->GetInt32(entry, valueField));
+                  break;
+                case FieldDescriptor::CPPTYPE_INT64:
+                  writer->field(
+                      key, entryReflection->GetInt64(entry, valueField));
+                  break;
+                case FieldDescriptor::CPPTYPE_UINT32:
+                  writer->field(
+                      key, entryReflection->GetUInt32(entry, valueField));
+                  break;
+                case FieldDescriptor::CPPTYPE_UINT64:
+                  writer->field(
+                      key, entryReflection->GetUInt64(entry, valueField));
+                  break;
+                case FieldDescriptor::CPPTYPE_FLOAT:
+                  writer->field(
+                      key, entryReflection->GetFloat(entry, valueField));
+                  break;
+                case FieldDescriptor::CPPTYPE_DOUBLE:
+                  writer->field(
+                      key, entryReflection->GetDouble(entry, valueField));
+                  break;
+                case FieldDescriptor::CPPTYPE_MESSAGE:
+                  writer->field(
+                      key,
+                      Protobuf(
+                          entryReflection->GetMessage(entry, valueField)));
+                  break;
+                case FieldDescriptor::CPPTYPE_ENUM:
+                  writer->field(
+                      key,
+                      entryReflection->GetEnum(entry, valueField)->name());
+                  break;
+                case FieldDescriptor::CPPTYPE_STRING:
+                  const std::string& s =
+                    entryReflection->GetStringReference(
+                        entry, valueField, nullptr);
+                  if (valueField->type() == FieldDescriptor::TYPE_BYTES) {
+                    writer->field(key, base64::encode(s));
+                  } else {
+                    writer->field(key, s);
+                  }
+                  break;
+              }
+            }
+          });
+    } else if (field->is_repeated()) {
       writer->field(
           field->name(),
           [&field, &reflection, &message](JSON::ArrayWriter* writer) {
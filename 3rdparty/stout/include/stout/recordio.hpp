@@ -15,12 +15,14 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
 #include <deque>
 #include <functional>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 #include <stout/check.hpp>
-#include <stout/foreach.hpp>
 #include <stout/numify.hpp>
 #include <stout/option.hpp>
 #include <stout/stringify.hpp>
@@ -85,6 +87,34 @@ public:
   Decoder(std::function<Try<T>(const std::string&)> _deserialize)
     : state(HEADER), deserialize(_deserialize) {}
 
+  /**
+   * A decoder which deserializes each complete record directly from
+   * a slice of the data passed to `decode()`, rather than from a
+   * copy of the record. This eliminates a copy per record whenever
+   * the record does not straddle a `decode()` boundary, provided the
+   * deserialize function can consume unterminated `(const char*,
+   * size_t)` data (e.g. protobuf's `ParseFromArray()`). The slice is
+   * only valid for the duration of the call, so the deserialize
+   * function must not retain the pointer.
+   *
+   * NOTE: Ideally this would be an overload taking
+   * `std::function<Try<T>(const char*, size_t)>`, but callables such
+   * as `lambda::bind` expressions (which silently discard surplus
+   * arguments) can be convertible to both function types, which
+   * would make many existing constructions ambiguous. Hence this
+   * constructor only participates in overload resolution when the
+   * callable cannot be used with the constructor above.
+   */
+  template <
+      typename F,
+      typename std::enable_if<
+          !std::is_same<typename std::decay<F>::type, Decoder>::value &&
+            !std::is_convertible<
+                F, std::function<Try<T>(const std::string&)>>::value,
+          int>::type = 0>
+  Decoder(F&& _deserialize)
+    : state(HEADER), deserializeSlice(std::forward<F>(_deserialize)) {}
+
   /**
    * Decodes another chunk of data from the "Record-IO" stream
    * and returns the attempted decoding of any additional
@@ -105,14 +135,21 @@ public:
 
     std::deque<Try<T>> records;
 
-    foreach (char c, data) {
+    size_t offset = 0;
+
+    while (offset < data.size()) {
       if (state == HEADER) {
+        size_t index = data.find('\n', offset);
+
         // Keep reading until we have the entire header.
-        if (c != '\n') {
-          buffer += c;
-          continue;
+        if (index == std::string::npos) {
+          buffer.append(data, offset, std::string::npos);
+          break;
         }
 
+        buffer.append(data, offset, index - offset);
+        offset = index + 1;
+
         Try<size_t> numify = ::numify<size_t>(buffer);
 
         // If we were unable to decode the length header, do not
@@ -130,17 +167,39 @@ public:
 
         // Note that for 0 length records, we immediately decode.
         if (numify.get() <= 0) {
-          records.push_back(deserialize(buffer));
+          records.push_back(deserializeRecord(buffer.data(), 0));
           state = HEADER;
         }
-      } else if (state == RECORD) {
+      } else {
         CHECK_SOME(length);
         CHECK_LT(buffer.size(), length.get());
 
-        buffer += c;
+        // If the entire record is available in `data` there is no
+        // need to accumulate it in `buffer` first; in particular,
+        // this lets a slice based deserialize function parse the
+        // record in place without any copy of the payload.
+        if (buffer.empty() && data.size() - offset >= length.get()) {
+          records.push_back(
+              deserializeRecord(data.data() + offset, length.get()));
+          offset += length.get();
+          state = HEADER;
+          continue;
+        }
+
+        size_t remaining =
+          std::min(length.get() - buffer.size(), data.size() - offset);
+
+        buffer.append(data, offset, remaining);
+        offset += remaining;
 
         if (buffer.size() == length.get()) {
-          records.push_back(deserialize(buffer));
+          // Avoid the extra copy that `deserializeRecord` would
+          // perform when the decoder was constructed with a
+          // string based deserialize function.
+          records.push_back(
+              deserialize != nullptr
+                ? deserialize(buffer)
+                : deserializeSlice(buffer.data(), buffer.size()));
           buffer.clear();
           state = HEADER;
         }
@@ -151,6 +210,13 @@ public:
   }
 
 private:
+  Try<T> deserializeRecord(const char* record, size_t size)
+  {
+    return deserializeSlice != nullptr
+      ? deserializeSlice(record, size)
+      : deserialize(std::string(record, size));
+  }
+
   enum
   {
     HEADER,
@@ -163,7 +229,10 @@ private:
   std::string buffer;
   Option<size_t> length;
 
+  // Exactly one of these is set, depending on which constructor
+  // was used.
   std::function<Try<T>(const std::string&)> deserialize;
+  std::function<Try<T>(const char*, size_t)> deserializeSlice;
 };
 
 } // namespace recordio {
@@ -0,0 +1,262 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License
+
+#ifndef __STOUT_SHARDEDCACHE_HPP__
+#define __STOUT_SHARDEDCACHE_HPP__
+
+#include <stdint.h>
+
+#include <chrono>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <stout/duration.hpp>
+#include <stout/foreach.hpp>
+#include <stout/none.hpp>
+#include <stout/option.hpp>
+#include <stout/synchronized.hpp>
+
+// A thread-safe least-recently used (LRU) cache, unlike `Cache` which
+// must be confined to a single thread (or actor). The key space is
+// partitioned across a number of shards, each protected by its own
+// mutex and maintaining its own LRU order, so that concurrent callers
+// hashing to different shards do not contend.
+//
+// Entries can optionally be given a time-to-live (TTL): an entry older
+// than the TTL is treated as absent and removed when it is next looked
+// up (expiration is lazy; there is no background sweeper).
+//
+// The cache keeps hit/miss/eviction/expiration counters which callers
+// can poll via `statistics()`, e.g. from a `process::metrics::Gauge`,
+// to monitor cache effectiveness.
+template <typename Key, typename Value>
+class ShardedCache
+{
+public:
+  struct Statistics
+  {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint64_t expirations;
+  };
+
+  // Creates a cache holding at most approximately `capacity` entries,
+  // partitioned across `shards` shards (rounded up to a power of two).
+  // The capacity is divided evenly between the shards, so a skewed key
+  // distribution can cause evictions before the total capacity is
+  // reached. If a `ttl` is provided, entries expire that long after
+  // they were last stored.
+  explicit ShardedCache(
+      size_t capacity,
+      size_t shards = DEFAULT_SHARDS,
+      const Option<Duration>& ttl = None())
+    : ttl_(ttl), shards_(roundUp(shards))
+  {
+    // Divide the capacity between the shards, rounding up so that a
+    // nonzero capacity is never silently truncated to zero.
+    capacity_ = (capacity + shards_.size() - 1) / shards_.size();
+  }
+
+  void put(const Key& key, const Value& value)
+  {
+    Shard& shard = shards_[index(key)];
+
+    synchronized (shard.mutex) {
+      typename Shard::map::iterator entry = shard.entries.find(key);
+
+      if (entry != shard.entries.end()) {
+        entry->second.value = value;
+        entry->second.written = std::chrono::steady_clock::now();
+        use(shard, entry);
+        return;
+      }
+
+      if (shard.entries.size() >= capacity_) {
+        evict(shard);
+      }
+
+      // Insert a new list entry and hold on to a "pointer" to its
+      // location so that we can update the LRU order in O(1).
+      typename std::list<Key>::iterator position =
+        shard.keys.insert(shard.keys.end(), key);
+
+      // NOTE: `Entry` is an aggregate so that `Value` need not be
+      // default constructible.
+      Entry inserted = {value, position, std::chrono::steady_clock::now()};
+
+      shard.entries.insert(std::make_pair(key, inserted));
+    }
+  }
+
+  Option<Value> get(const Key& key)
+  {
+    Shard& shard = shards_[index(key)];
+
+    synchronized (shard.mutex) {
+      typename Shard::map::iterator entry = shard.entries.find(key);
+
+      if (entry == shard.entries.end()) {
+        ++shard.misses;
+        return None();
+      }
+
+      if (expired(entry->second)) {
+        shard.keys.erase(entry->second.position);
+        shard.entries.erase(entry);
+        ++shard.expirations;
+        ++shard.misses;
+        return None();
+      }
+
+      ++shard.hits;
+      use(shard, entry);
+      return entry->second.value;
+    }
+  }
+
+  Option<Value> erase(const Key& key)
+  {
+    Shard& shard = shards_[index(key)];
+
+    synchronized (shard.mutex) {
+      typename Shard::map::iterator entry = shard.entries.find(key);
+
+      if (entry == shard.entries.end()) {
+        return None();
+      }
+
+      Value value = entry->second.value;
+      shard.keys.erase(entry->second.position);
+      shard.entries.erase(entry);
+      return value;
+    }
+  }
+
+  // NOTE: The size is computed shard by shard, so a concurrent writer
+  // can make the result stale by the time it is returned; the same
+  // caveat applies to `statistics()`.
+  size_t size() const
+  {
+    size_t total = 0;
+    foreach (const Shard& shard, shards_) {
+      synchronized (shard.mutex) {
+        total += shard.entries.size();
+      }
+    }
+    return total;
+  }
+
+  Statistics statistics() const
+  {
+    Statistics total = {0, 0, 0, 0};
+    foreach (const Shard& shard, shards_) {
+      synchronized (shard.mutex) {
+        total.hits += shard.hits;
+        total.misses += shard.misses;
+        total.evictions += shard.evictions;
+        total.expirations += shard.expirations;
+      }
+    }
+    return total;
+  }
+
+private:
+  static constexpr size_t DEFAULT_SHARDS = 16;
+
+  struct Entry
+  {
+    Value value;
+    typename std::list<Key>::iterator position;
+    std::chrono::steady_clock::time_point written;
+  };
+
+  struct Shard
+  {
+    typedef std::unordered_map<Key, Entry> map;
+
+    Shard() : hits(0), misses(0), evictions(0), expirations(0) {}
+
+    mutable std::mutex mutex;
+
+    // The keys in least to most recently used order, together with the
+    // entries themselves (which point back into the LRU list).
+    std::list<Key> keys;
+    map entries;
+
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint64_t expirations;
+  };
+
+  static size_t roundUp(size_t shards)
+  {
+    size_t result = 1;
+    while (result < shards) {
+      result *= 2;
+    }
+    return result;
+  }
+
+  // Since the shard count is a power of two we can select the shard by
+  // masking the hash rather than with a (slower) modulo.
+  size_t index(const Key& key) const
+  {
+    return std::hash<Key>()(key) & (shards_.size() - 1);
+  }
+
+  bool expired(const Entry& entry) const
+  {
+    if (ttl_.isNone()) {
+      return false;
+    }
+
+    const std::chrono::steady_clock::duration age =
+      std::chrono::steady_clock::now() - entry.written;
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(age).count() >
+           ttl_->ns();
+  }
+
+  // Moves the entry to the most-recently used position. Must be called
+  // with the shard's mutex held.
+  void use(Shard& shard, typename Shard::map::iterator entry)
+  {
+    shard.keys.splice(shard.keys.end(), shard.keys, entry->second.position);
+  }
+
+  // Removes the least-recently used entry. Must be called with the
+  // shard's mutex held (and the shard must be non-empty).
+  void evict(Shard& shard)
+  {
+    shard.entries.erase(shard.keys.front());
+    shard.keys.pop_front();
+    ++shard.evictions;
+  }
+
+  // Not copyable, not assignable (the shards own mutexes).
+  ShardedCache(const ShardedCache&);
+  ShardedCache& operator=(const ShardedCache&);
+
+  const Option<Duration> ttl_;
+
+  // Per-shard capacity; the shard vector is sized in the constructor
+  // and never resized (`Shard` is neither copyable nor movable).
+  size_t capacity_;
+  std::vector<Shard> shards_;
+};
+
+#endif // __STOUT_SHARDEDCACHE_HPP__
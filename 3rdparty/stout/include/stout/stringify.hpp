@@ -13,6 +13,8 @@
 #ifndef __STOUT_STRINGIFY_HPP__
 #define __STOUT_STRINGIFY_HPP__
 
+#include <stdio.h> // For 'snprintf'.
+
 #include <iostream> // For 'std::cerr' and 'std::endl'.
 #include <list>
 #include <map>
@@ -86,6 +88,37 @@ inline std::string stringify(bool b)
 }
 
 
+// Overloads for arithmetic types which format the value directly
+// rather than through a `std::ostringstream`; `stringify` of numbers
+// shows up on logging and metrics hot paths. The output matches the
+// respective `operator<<`: integers print all their digits, floating
+// point values use the default stream precision of 6 significant
+// digits.
+//
+// NOTE: There are deliberately no overloads for the character types,
+// which streams format as characters rather than numbers.
+inline std::string stringify(int i) { return std::to_string(i); }
+inline std::string stringify(long i) { return std::to_string(i); }
+inline std::string stringify(long long i) { return std::to_string(i); }
+inline std::string stringify(unsigned int i) { return std::to_string(i); }
+inline std::string stringify(unsigned long i) { return std::to_string(i); }
+inline std::string stringify(unsigned long long i) { return std::to_string(i); }
+
+
+inline std::string stringify(double d)
+{
+  char buffer[32];
+  const int size = snprintf(buffer, sizeof(buffer), "%g", d);
+  return std::string(buffer, size);
+}
+
+
+inline std::string stringify(float f)
+{
+  return stringify(static_cast<double>(f));
+}
+
+
 template <typename T>
 std::string stringify(const std::set<T>& set)
 {
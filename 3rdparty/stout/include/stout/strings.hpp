@@ -38,6 +38,55 @@ enum Mode
 };
 
 
+// A non-owning reference to a range of characters, typically within
+// a larger string. Used by `tokenizeView` and `splitView` below to
+// return tokens without copying each one out of the input.
+//
+// NOTE: A `View` is only valid as long as the characters it points
+// into outlive it; in particular, do not keep a `View` of a temporary
+// string beyond the enclosing expression. Call `str()` to get an
+// owning copy when one is needed.
+class View
+{
+public:
+  View(const char* data, size_t size) : data_(data), size_(size) {}
+
+  // Implicit: lets a whole string be passed wherever a `View` is
+  // expected (e.g., to tokenize a token further).
+  View(const std::string& s) : data_(s.data()), size_(s.size()) {}
+
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  std::string str() const { return std::string(data_, size_); }
+
+  bool operator==(const View& that) const
+  {
+    return size_ == that.size_ &&
+           std::equal(data_, data_ + size_, that.data_);
+  }
+
+  bool operator==(const char* that) const
+  {
+    return *this == View(that, ::strlen(that));
+  }
+
+  bool operator!=(const View& that) const { return !(*this == that); }
+  bool operator!=(const char* that) const { return !(*this == that); }
+
+private:
+  const char* data_;
+  size_t size_;
+};
+
+
+inline std::ostream& operator<<(std::ostream& stream, const View& view)
+{
+  return stream.write(view.data(), view.size());
+}
+
+
 inline std::string remove(
     const std::string& from,
     const std::string& substring,
@@ -109,6 +158,31 @@ inline std::string trim(
 }
 
 
+// Trims a `View` by narrowing it, without copying any characters.
+inline View trim(
+    const View& from,
+    Mode mode = ANY,
+    const std::string& chars = WHITESPACE)
+{
+  const char* begin = from.data();
+  const char* end = from.data() + from.size();
+
+  if (mode == PREFIX || mode == ANY) {
+    while (begin < end && chars.find(*begin) != std::string::npos) {
+      ++begin;
+    }
+  }
+
+  if (mode == SUFFIX || mode == ANY) {
+    while (end > begin && chars.find(*(end - 1)) != std::string::npos) {
+      --end;
+    }
+  }
+
+  return View(begin, end - begin);
+}
+
+
 // Replaces all the occurrences of the 'from' string with the 'to' string.
 inline std::string replace(
     const std::string& s,
@@ -130,14 +204,18 @@ inline std::string replace(
 }
 
 
-// Tokenizes the string using the delimiters. Empty tokens will not be
-// included in the result.
+// Tokenizes the input using the delimiters, returning views into the
+// input rather than copying each token out of it. Empty tokens will
+// not be included in the result.
 //
 // Optionally, the maximum number of tokens to be returned can be
 // specified. If the maximum number of tokens is reached, the last
-// token returned contains the remainder of the input string.
-inline std::vector<std::string> tokenize(
-    const std::string& s,
+// token returned contains the remainder of the input.
+//
+// NOTE: The returned views are only valid while the characters
+// backing the input are alive, see `View`.
+inline std::vector<View> tokenizeView(
+    const View& s,
     const std::string& delims,
     const Option<size_t>& maxTokens = None())
 {
@@ -145,44 +223,59 @@ inline std::vector<std::string> tokenize(
     return {};
   }
 
-  std::vector<std::string> tokens;
+  std::vector<View> tokens;
+  const char* data = s.data();
+  const size_t size = s.size();
   size_t offset = 0;
 
+  auto isDelim = [&delims](char c) {
+    return delims.find(c) != std::string::npos;
+  };
+
   while (true) {
-    size_t nonDelim = s.find_first_not_of(delims, offset);
+    while (offset < size && isDelim(data[offset])) {
+      offset++;
+    }
 
-    if (nonDelim == std::string::npos) {
+    if (offset == size) {
       break; // Nothing left.
     }
 
-    size_t delim = s.find_first_of(delims, nonDelim);
+    const size_t nonDelim = offset;
+
+    while (offset < size && !isDelim(data[offset])) {
+      offset++;
+    }
 
     // Finish tokenizing if this is the last token,
     // or we've found enough tokens.
-    if (delim == std::string::npos ||
+    if (offset == size ||
         (maxTokens.isSome() && tokens.size() == maxTokens.get() - 1)) {
-      tokens.push_back(s.substr(nonDelim));
+      tokens.push_back(View(data + nonDelim, size - nonDelim));
       break;
     }
 
-    tokens.push_back(s.substr(nonDelim, delim - nonDelim));
-    offset = delim;
+    tokens.push_back(View(data + nonDelim, offset - nonDelim));
   }
 
   return tokens;
 }
 
 
-// Splits the string using the provided delimiters. The string is
-// split each time at the first character that matches any of the
-// characters specified in delims.  Empty tokens are allowed in the
+// Splits the input using the provided delimiters, returning views
+// into the input rather than copying each token out of it. The input
+// is split each time at the first character that matches any of the
+// characters specified in delims. Empty tokens are allowed in the
 // result.
 //
 // Optionally, the maximum number of tokens to be returned can be
 // specified. If the maximum number of tokens is reached, the last
-// token returned contains the remainder of the input string.
-inline std::vector<std::string> split(
-    const std::string& s,
+// token returned contains the remainder of the input.
+//
+// NOTE: The returned views are only valid while the characters
+// backing the input are alive, see `View`.
+inline std::vector<View> splitView(
+    const View& s,
     const std::string& delims,
     const Option<size_t>& maxTokens = None())
 {
@@ -190,21 +283,31 @@ inline std::vector<std::string> split(
     return {};
   }
 
-  std::vector<std::string> tokens;
+  std::vector<View> tokens;
+  const char* data = s.data();
+  const size_t size = s.size();
   size_t offset = 0;
 
+  auto isDelim = [&delims](char c) {
+    return delims.find(c) != std::string::npos;
+  };
+
   while (true) {
-    size_t next = s.find_first_of(delims, offset);
+    size_t next = offset;
+
+    while (next < size && !isDelim(data[next])) {
+      next++;
+    }
 
     // Finish splitting if this is the last token,
     // or we've found enough tokens.
-    if (next == std::string::npos ||
+    if (next == size ||
         (maxTokens.isSome() && tokens.size() == maxTokens.get() - 1)) {
-      tokens.push_back(s.substr(offset));
+      tokens.push_back(View(data + offset, size - offset));
       break;
     }
 
-    tokens.push_back(s.substr(offset, next - offset));
+    tokens.push_back(View(data + offset, next - offset));
     offset = next + 1;
   }
 
@@ -212,6 +315,56 @@ inline std::vector<std::string> split(
 }
 
 
+// Tokenizes the string using the delimiters. Empty tokens will not be
+// included in the result.
+//
+// Optionally, the maximum number of tokens to be returned can be
+// specified. If the maximum number of tokens is reached, the last
+// token returned contains the remainder of the input string.
+inline std::vector<std::string> tokenize(
+    const std::string& s,
+    const std::string& delims,
+    const Option<size_t>& maxTokens = None())
+{
+  const std::vector<View> views = tokenizeView(s, delims, maxTokens);
+
+  std::vector<std::string> tokens;
+  tokens.reserve(views.size());
+
+  foreach (const View& view, views) {
+    tokens.push_back(view.str());
+  }
+
+  return tokens;
+}
+
+
+// Splits the string using the provided delimiters. The string is
+// split each time at the first character that matches any of the
+// characters specified in delims.  Empty tokens are allowed in the
+// result.
+//
+// Optionally, the maximum number of tokens to be returned can be
+// specified. If the maximum number of tokens is reached, the last
+// token returned contains the remainder of the input string.
+inline std::vector<std::string> split(
+    const std::string& s,
+    const std::string& delims,
+    const Option<size_t>& maxTokens = None())
+{
+  const std::vector<View> views = splitView(s, delims, maxTokens);
+
+  std::vector<std::string> tokens;
+  tokens.reserve(views.size());
+
+  foreach (const View& view, views) {
+    tokens.push_back(view.str());
+  }
+
+  return tokens;
+}
+
+
 // Returns a map of strings to strings based on calling tokenize
 // twice. All non-pairs are discarded. For example:
 //
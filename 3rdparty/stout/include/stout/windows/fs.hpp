@@ -78,6 +78,31 @@ inline Try<double> usage(const std::string& path = "/")
 }
 
 
+// Returns the amount of disk space used on the file system that the
+// given path is mounted at.
+inline Try<Bytes> used(const std::string& path = "/")
+{
+  Result<std::string> real_path = os::realpath(path);
+  if (!real_path.isSome()) {
+    return Error(
+        "Failed to get realpath for '" + path + "': " +
+        (real_path.isError() ? real_path.error() : "No such directory"));
+  }
+
+  ULARGE_INTEGER free_bytes, total_bytes, total_free_bytes;
+  if (::GetDiskFreeSpaceExW(
+          internal::windows::longpath(real_path.get()).data(),
+          &free_bytes,
+          &total_bytes,
+          &total_free_bytes) == 0) {
+    return WindowsError(
+        "Error invoking 'GetDiskFreeSpaceEx' on '" + path + "'");
+  }
+
+  return Bytes(total_bytes.QuadPart - free_bytes.QuadPart);
+}
+
+
 inline Try<Nothing> symlink(
     const std::string& original,
     const std::string& link)
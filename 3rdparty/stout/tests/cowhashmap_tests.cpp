@@ -0,0 +1,147 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <stout/cowhashmap.hpp>
+#include <stout/cowhashset.hpp>
+#include <stout/gtest.hpp>
+
+using std::string;
+
+TEST(CowHashMapTest, PutGetErase)
+{
+  CowHashMap<string, int> map;
+
+  EXPECT_TRUE(map.empty());
+
+  map.put("foo", 1);
+  map.put("bar", 2);
+
+  EXPECT_EQ(2u, map.size());
+  EXPECT_TRUE(map.contains("foo"));
+  EXPECT_SOME_EQ(1, map.get("foo"));
+  EXPECT_SOME_EQ(2, map.get("bar"));
+
+  map.put("foo", 3);
+  EXPECT_SOME_EQ(3, map.get("foo"));
+  EXPECT_EQ(2u, map.size());
+
+  EXPECT_EQ(1u, map.erase("foo"));
+  EXPECT_EQ(0u, map.erase("foo"));
+  EXPECT_NONE(map.get("foo"));
+  EXPECT_EQ(1u, map.size());
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+}
+
+
+TEST(CowHashMapTest, Snapshot)
+{
+  CowHashMap<string, int> map;
+
+  map.put("foo", 1);
+  map.put("bar", 2);
+
+  // A copy is a point-in-time snapshot: subsequent mutations of the
+  // original must not be observed through it.
+  CowHashMap<string, int> snapshot = map;
+
+  map.put("foo", 3);
+  map.put("baz", 4);
+  map.erase("bar");
+
+  EXPECT_SOME_EQ(3, map.get("foo"));
+  EXPECT_SOME_EQ(4, map.get("baz"));
+  EXPECT_NONE(map.get("bar"));
+
+  EXPECT_EQ(2u, snapshot.size());
+  EXPECT_SOME_EQ(1, snapshot.get("foo"));
+  EXPECT_SOME_EQ(2, snapshot.get("bar"));
+  EXPECT_NONE(snapshot.get("baz"));
+}
+
+
+TEST(CowHashMapTest, SnapshotAfterClear)
+{
+  CowHashMap<string, int> map;
+
+  map.put("foo", 1);
+
+  CowHashMap<string, int> snapshot = map;
+
+  map.clear();
+
+  EXPECT_TRUE(map.empty());
+  EXPECT_SOME_EQ(1, snapshot.get("foo"));
+}
+
+
+TEST(CowHashMapTest, Iteration)
+{
+  CowHashMap<string, int> map;
+
+  map.put("foo", 1);
+  map.put("bar", 2);
+
+  int sum = 0;
+  foreachpair (const string& key, int value, map) {
+    EXPECT_TRUE(key == "foo" || key == "bar");
+    sum += value;
+  }
+
+  EXPECT_EQ(3, sum);
+}
+
+
+TEST(CowHashSetTest, InsertErase)
+{
+  CowHashSet<string> set;
+
+  EXPECT_TRUE(set.empty());
+
+  set.insert("foo");
+  set.insert("bar");
+  set.insert("foo");
+
+  EXPECT_EQ(2u, set.size());
+  EXPECT_TRUE(set.contains("foo"));
+  EXPECT_TRUE(set.contains("bar"));
+
+  EXPECT_EQ(1u, set.erase("foo"));
+  EXPECT_EQ(0u, set.erase("foo"));
+  EXPECT_FALSE(set.contains("foo"));
+  EXPECT_EQ(1u, set.size());
+}
+
+
+TEST(CowHashSetTest, Snapshot)
+{
+  CowHashSet<string> set;
+
+  set.insert("foo");
+
+  CowHashSet<string> snapshot = set;
+
+  set.insert("bar");
+  set.erase("foo");
+
+  EXPECT_FALSE(set.contains("foo"));
+  EXPECT_TRUE(set.contains("bar"));
+
+  EXPECT_EQ(1u, snapshot.size());
+  EXPECT_TRUE(snapshot.contains("foo"));
+  EXPECT_FALSE(snapshot.contains("bar"));
+}
@@ -0,0 +1,242 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License
+
+#include <ctype.h>
+
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <boost/functional/hash.hpp>
+
+#include <stout/flathashmap.hpp>
+#include <stout/gtest.hpp>
+#include <stout/stringify.hpp>
+
+using std::string;
+
+
+TEST(FlatHashMapTest, InitializerList)
+{
+  FlatHashMap<string, int> map{{"hello", 1}};
+  EXPECT_EQ(1u, map.size());
+
+  EXPECT_TRUE((FlatHashMap<int, int>{}.empty()));
+
+  FlatHashMap<int, int> map2{{1, 2}, {2, 3}, {3, 4}};
+  EXPECT_EQ(3u, map2.size());
+  EXPECT_SOME_EQ(2, map2.get(1));
+  EXPECT_SOME_EQ(3, map2.get(2));
+  EXPECT_SOME_EQ(4, map2.get(3));
+  EXPECT_NONE(map2.get(4));
+}
+
+
+TEST(FlatHashMapTest, Insert)
+{
+  FlatHashMap<string, int> map;
+  map["abc"] = 1;
+  map.put("def", 2);
+
+  ASSERT_SOME_EQ(1, map.get("abc"));
+  ASSERT_SOME_EQ(2, map.get("def"));
+
+  map.put("def", 4);
+  ASSERT_SOME_EQ(4, map.get("def"));
+  ASSERT_EQ(2u, map.size());
+
+  // `emplace` and `insert` do not overwrite an existing binding.
+  EXPECT_FALSE(map.emplace("def", 5).second);
+  ASSERT_SOME_EQ(4, map.get("def"));
+
+  EXPECT_TRUE(map.insert({"ghi", 6}).second);
+  ASSERT_SOME_EQ(6, map.get("ghi"));
+}
+
+
+TEST(FlatHashMapTest, Contains)
+{
+  FlatHashMap<string, int> map;
+  map["abc"] = 1;
+
+  ASSERT_TRUE(map.contains("abc"));
+  ASSERT_TRUE(map.containsValue(1));
+
+  ASSERT_FALSE(map.contains("def"));
+  ASSERT_FALSE(map.containsValue(2));
+}
+
+
+TEST(FlatHashMapTest, Erase)
+{
+  FlatHashMap<int, int> map;
+
+  for (int i = 0; i < 10; ++i) {
+    map[i] = i;
+  }
+
+  EXPECT_EQ(1u, map.erase(5));
+  EXPECT_EQ(0u, map.erase(5));
+  EXPECT_EQ(9u, map.size());
+  EXPECT_FALSE(map.contains(5));
+  EXPECT_NONE(map.get(5));
+
+  // Reinsertion after erasure reuses the tombstone.
+  map[5] = 42;
+  EXPECT_SOME_EQ(42, map.get(5));
+  EXPECT_EQ(10u, map.size());
+}
+
+
+TEST(FlatHashMapTest, Growth)
+{
+  FlatHashMap<int, int> map;
+
+  // Enough insertions to force several rehashes.
+  for (int i = 0; i < 1000; ++i) {
+    map[i] = i * 2;
+  }
+
+  EXPECT_EQ(1000u, map.size());
+
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_SOME_EQ(i * 2, map.get(i));
+  }
+
+  // Erase every other entry and make sure lookups (which now probe
+  // over tombstones) and further insertions still behave.
+  for (int i = 0; i < 1000; i += 2) {
+    ASSERT_EQ(1u, map.erase(i));
+  }
+
+  EXPECT_EQ(500u, map.size());
+
+  for (int i = 0; i < 1000; ++i) {
+    if (i % 2 == 0) {
+      ASSERT_FALSE(map.contains(i));
+    } else {
+      ASSERT_SOME_EQ(i * 2, map.get(i));
+    }
+  }
+
+  for (int i = 1000; i < 2000; ++i) {
+    map[i] = i * 2;
+  }
+
+  EXPECT_EQ(1500u, map.size());
+
+  for (int i = 1000; i < 2000; ++i) {
+    ASSERT_SOME_EQ(i * 2, map.get(i));
+  }
+}
+
+
+TEST(FlatHashMapTest, KeysAndValues)
+{
+  FlatHashMap<int, int> map{{1, 2}, {2, 3}, {3, 4}};
+
+  hashset<int> keys = map.keys();
+  EXPECT_EQ(3u, keys.size());
+  EXPECT_TRUE(keys.contains(1));
+  EXPECT_TRUE(keys.contains(2));
+  EXPECT_TRUE(keys.contains(3));
+
+  std::vector<int> values = map.values();
+  EXPECT_EQ(3u, values.size());
+}
+
+
+TEST(FlatHashMapTest, Iteration)
+{
+  FlatHashMap<int, int> map{{1, 2}, {2, 3}, {3, 4}};
+
+  int sum = 0;
+  foreachpair (int key, int value, map) {
+    EXPECT_EQ(key + 1, value);
+    sum += key;
+  }
+
+  EXPECT_EQ(6, sum);
+
+  // Mutation through an iterator.
+  map.find(1)->second = 42;
+  EXPECT_SOME_EQ(42, map.get(1));
+
+  EXPECT_TRUE(map.find(4) == map.end());
+}
+
+
+TEST(FlatHashMapTest, CopyAndMove)
+{
+  FlatHashMap<string, int> map{{"a", 1}, {"b", 2}};
+
+  FlatHashMap<string, int> copy(map);
+  EXPECT_EQ(2u, copy.size());
+  EXPECT_SOME_EQ(1, copy.get("a"));
+  EXPECT_SOME_EQ(2, copy.get("b"));
+
+  copy["c"] = 3;
+  EXPECT_FALSE(map.contains("c"));
+
+  FlatHashMap<string, int> moved(std::move(copy));
+  EXPECT_EQ(3u, moved.size());
+  EXPECT_SOME_EQ(3, moved.get("c"));
+}
+
+
+TEST(FlatHashMapTest, CustomHashAndEqual)
+{
+  struct CaseInsensitiveHash
+  {
+    size_t operator()(const string& key) const
+    {
+      size_t seed = 0;
+      foreach (const char c, key) {
+        boost::hash_combine(seed, ::tolower(c));
+      }
+      return seed;
+    }
+  };
+
+  struct CaseInsensitiveEqual
+  {
+    bool operator()(const string& left, const string& right) const
+    {
+      if (left.size() != right.size()) {
+        return false;
+      }
+      for (size_t i = 0; i < left.size(); ++i) {
+        if (::tolower(left[i]) != ::tolower(right[i])) {
+          return false;
+        }
+      }
+      return true;
+    }
+  };
+
+  FlatHashMap<string, int, CaseInsensitiveHash, CaseInsensitiveEqual> map;
+
+  map["abc"] = 1;
+  map.put("def", 2);
+  EXPECT_SOME_EQ(1, map.get("Abc"));
+  EXPECT_SOME_EQ(2, map.get("dEf"));
+
+  map.put("Abc", 3);
+  map["DEF"] = 4;
+  EXPECT_SOME_EQ(3, map.get("abc"));
+  EXPECT_SOME_EQ(4, map.get("def"));
+
+  EXPECT_EQ(2u, map.size());
+  EXPECT_TRUE(map.contains("abc"));
+  EXPECT_TRUE(map.contains("aBc"));
+}
@@ -0,0 +1,108 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License
+
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <stout/flathashset.hpp>
+#include <stout/gtest.hpp>
+
+using std::string;
+
+
+TEST(FlatHashSetTest, InitializerList)
+{
+  FlatHashSet<string> set{"hello"};
+  EXPECT_EQ(1u, set.size());
+  EXPECT_TRUE(set.contains("hello"));
+
+  EXPECT_TRUE((FlatHashSet<int>{}.empty()));
+
+  FlatHashSet<int> set2{1, 3, 5, 7, 11};
+  EXPECT_EQ(5u, set2.size());
+  EXPECT_TRUE(set2.contains(1));
+  EXPECT_TRUE(set2.contains(11));
+  EXPECT_FALSE(set2.contains(2));
+}
+
+
+TEST(FlatHashSetTest, Insert)
+{
+  FlatHashSet<string> set;
+
+  EXPECT_TRUE(set.insert("abc").second);
+  EXPECT_FALSE(set.insert("abc").second);
+  EXPECT_EQ(1u, set.size());
+
+  EXPECT_TRUE(set.insert("def").second);
+  EXPECT_EQ(2u, set.size());
+}
+
+
+TEST(FlatHashSetTest, Erase)
+{
+  FlatHashSet<int> set{1, 2, 3};
+
+  EXPECT_EQ(1u, set.erase(2));
+  EXPECT_EQ(0u, set.erase(2));
+  EXPECT_EQ(2u, set.size());
+  EXPECT_FALSE(set.contains(2));
+
+  set.insert(2);
+  EXPECT_TRUE(set.contains(2));
+  EXPECT_EQ(3u, set.size());
+}
+
+
+TEST(FlatHashSetTest, Growth)
+{
+  FlatHashSet<int> set;
+
+  for (int i = 0; i < 1000; ++i) {
+    set.insert(i);
+  }
+
+  EXPECT_EQ(1000u, set.size());
+
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_TRUE(set.contains(i));
+  }
+
+  for (int i = 0; i < 1000; i += 2) {
+    ASSERT_EQ(1u, set.erase(i));
+  }
+
+  EXPECT_EQ(500u, set.size());
+
+  for (int i = 1; i < 1000; i += 2) {
+    ASSERT_TRUE(set.contains(i));
+  }
+}
+
+
+TEST(FlatHashSetTest, Iteration)
+{
+  FlatHashSet<int> set{1, 2, 3};
+
+  int sum = 0;
+  foreach (int elem, set) {
+    sum += elem;
+  }
+
+  EXPECT_EQ(6, sum);
+
+  EXPECT_TRUE(set.find(4) == set.end());
+  EXPECT_FALSE(set.find(3) == set.end());
+  EXPECT_EQ(3, *set.find(3));
+}
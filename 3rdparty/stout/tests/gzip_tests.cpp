@@ -64,6 +64,61 @@ TEST(GzipTest, CompressDecompressString)
 }
 
 
+TEST(GzipTest, Compressor)
+{
+  string s =
+    "Lorem ipsum dolor sit amet, consectetur adipisicing elit, sed do "
+    "eiusmod tempor incididunt ut labore et dolore magna aliqua. Ut enim ad "
+    "minim veniam, quis nostrud exercitation ullamco laboris nisi ut "
+    "aliquip ex ea commodo consequat. Duis aute irure dolor in reprehenderit "
+    "in voluptate velit esse cillum dolore eu fugiat nulla pariatur. "
+    "Excepteur sint occaecat cupidatat non proident, sunt in culpa qui "
+    "officia deserunt mollit anim id est laborum.";
+
+  gzip::Compressor compressor;
+  gzip::Decompressor decompressor;
+
+  // Compress in chunks of 13 bytes. Since the compressor flushes
+  // each chunk, the output must be immediately decompressible,
+  // without waiting for the rest of the stream.
+  string compressed;
+  string decompressed;
+  size_t i = 0;
+
+  while (i < s.size()) {
+    string chunk = s.substr(i, 13);
+
+    Try<string> compressedChunk = compressor.compress(chunk);
+    ASSERT_SOME(compressedChunk);
+    compressed += compressedChunk.get();
+
+    Try<string> decompressedChunk = decompressor.decompress(
+        compressedChunk.get());
+    ASSERT_SOME(decompressedChunk);
+    decompressed += decompressedChunk.get();
+
+    i += chunk.size();
+
+    ASSERT_EQ(s.substr(0, i), decompressed);
+  }
+
+  EXPECT_FALSE(compressor.finished());
+
+  Try<string> remaining = compressor.finish();
+  ASSERT_SOME(remaining);
+  compressed += remaining.get();
+
+  EXPECT_TRUE(compressor.finished());
+
+  // No more data can be compressed once the stream is finished.
+  EXPECT_ERROR(compressor.compress("more"));
+  EXPECT_ERROR(compressor.finish());
+
+  // The concatenated output is a well formed gzip stream.
+  ASSERT_SOME_EQ(s, gzip::decompress(compressed));
+}
+
+
 TEST(GzipTest, Decompressor)
 {
   string s =
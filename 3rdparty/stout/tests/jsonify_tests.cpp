@@ -367,3 +367,28 @@ TEST(JsonifyTest, JSONNull)
   JSON::Array numbers = JSON::Array{1, JSON::Null(), 3};
   EXPECT_EQ("[1,null,3]", string(jsonify(numbers)));
 }
+
+
+// Tests that `stream` produces the same output as the string
+// conversion, delivered in chunks bounded by the chunk size.
+TEST(JsonifyTest, Stream)
+{
+  JSON::Object object = {{"first_name", "michael"}, {"last_name", "park"}};
+
+  string expected = string(jsonify(object));
+
+  string streamed;
+  size_t chunks = 0;
+
+  jsonify(object).stream(
+      [&](string&& chunk) {
+        EXPECT_FALSE(chunk.empty());
+        EXPECT_LE(chunk.size(), 8u);
+        streamed += chunk;
+        ++chunks;
+      },
+      8);
+
+  EXPECT_EQ(expected, streamed);
+  EXPECT_LT(1u, chunks);
+}
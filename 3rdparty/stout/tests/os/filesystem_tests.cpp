@@ -29,6 +29,7 @@
 #include <stout/os/getcwd.hpp>
 #include <stout/os/int_fd.hpp>
 #include <stout/os/ls.hpp>
+#include <stout/os/lsdir.hpp>
 #include <stout/os/lseek.hpp>
 #include <stout/os/mkdir.hpp>
 #include <stout/os/pipe.hpp>
@@ -407,6 +408,40 @@ TEST_F(FsTest, List)
 }
 
 
+TEST_F(FsTest, SYMLINK_LsDir)
+{
+  const string testdir =
+    path::join(os::getcwd(), id::UUID::random().toString());
+  ASSERT_SOME(os::mkdir(testdir));
+
+  const string file = path::join(testdir, "file.txt");
+  const string directory = path::join(testdir, "directory");
+  const string link = path::join(testdir, "link");
+
+  ASSERT_SOME(os::touch(file));
+  ASSERT_SOME(os::mkdir(directory));
+
+  // NOTE: The link points to a directory, but like `lstat` the
+  // entry's type describes the link itself.
+  ASSERT_SOME(fs::symlink(directory, link));
+
+  Try<std::vector<os::DirEntry>> entries = os::lsdir(testdir);
+  ASSERT_SOME(entries);
+  ASSERT_EQ(3u, entries->size());
+
+  std::map<string, os::DirEntry::Type> types;
+  foreach (const os::DirEntry& entry, entries.get()) {
+    types[entry.name] = entry.type;
+  }
+
+  EXPECT_EQ(os::DirEntry::Type::FILE, types.at("file.txt"));
+  EXPECT_EQ(os::DirEntry::Type::DIRECTORY, types.at("directory"));
+  EXPECT_EQ(os::DirEntry::Type::SYMLINK, types.at("link"));
+
+  EXPECT_ERROR(os::lsdir(path::join(testdir, "nonexistent")));
+}
+
+
 TEST_F(FsTest, Rename)
 {
   const string testdir =
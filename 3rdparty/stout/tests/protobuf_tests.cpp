@@ -456,6 +456,70 @@ TEST(ProtobufTest, ParseJSONNull)
 }
 
 
+// Tests the single pass parse of a protobuf message directly from the
+// bytes of a JSON document, which must behave like parsing via an
+// intermediate `JSON::Value`.
+TEST(ProtobufTest, ParseJSONString)
+{
+  tests::Message message;
+  message.set_b(true);
+  message.set_str("string");
+  message.set_bytes("bytes");
+  message.set_int32(-1);
+  message.set_int64(-1);
+  message.set_uint32(1);
+  message.set_uint64(1);
+  message.set_sint32(-1);
+  message.set_sint64(-1);
+  message.set_f(1.0);
+  message.set_d(1.0);
+  message.set_e(tests::ONE);
+  message.mutable_nested()->set_str("nested");
+  message.add_repeated_bool(true);
+  message.add_repeated_string("repeated_string");
+  message.add_repeated_bytes("repeated_bytes");
+  message.add_repeated_int32(-2);
+  message.add_repeated_enum(tests::TWO);
+  message.add_repeated_nested()->set_str("repeated_nested");
+
+  const string json = stringify(JSON::protobuf(message));
+
+  Try<tests::Message> parse = protobuf::parse<tests::Message>(json);
+  ASSERT_SOME(parse);
+
+  EXPECT_EQ(message.SerializeAsString(), parse->SerializeAsString());
+
+  // Unknown fields are skipped, including nested objects and arrays.
+  parse = protobuf::parse<tests::Message>(
+      R"~(
+      {
+        "b": true,
+        "str": "string",
+        "bytes": "Ynl0ZXM=",
+        "f": 1.0,
+        "d": 1.0,
+        "e": "ONE",
+        "int32": -1,
+        "int64": -1,
+        "uint32": 1,
+        "uint64": 1,
+        "sint32": -1,
+        "sint64": -1,
+        "unknown": {"nested": [1, {"deep": null}]}
+      })~");
+
+  ASSERT_SOME(parse);
+  EXPECT_EQ("string", parse->str());
+
+  // Errors surface just as they do when parsing a `JSON::Value`:
+  // type mismatches, missing required fields and malformed JSON.
+  EXPECT_ERROR(protobuf::parse<tests::Nested>(R"~({"str": 1})~"));
+  EXPECT_ERROR(protobuf::parse<tests::Nested>(R"~({"optional_str": "s"})~"));
+  EXPECT_ERROR(protobuf::parse<tests::Nested>(R"~({"str": )~"));
+  EXPECT_ERROR(protobuf::parse<tests::Nested>(R"~(["str"])~"));
+}
+
+
 TEST(ProtobufTest, ParseJSONNestedError)
 {
   // Here we trigger an error parsing the 'nested' message, i.e., set
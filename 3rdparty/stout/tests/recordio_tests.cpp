@@ -157,3 +157,82 @@ TEST(RecordIOTest, Decoder)
   EXPECT_ERROR(decoder.decode("not a number\n"));
   EXPECT_ERROR(decoder.decode("1\n"));
 }
+
+
+TEST(RecordIOTest, SliceDecoder)
+{
+  // A slice based deserialize function observes the record bytes
+  // directly, without them being copied into an `std::string`.
+  auto deserialize = [](const char* data, size_t size) -> Try<string> {
+    string record(data, size);
+    if (record == "error") {
+      return Error("error");
+    }
+    return strings::lower(record);
+  };
+
+  recordio::Decoder<string> decoder(deserialize);
+
+  deque<Try<string>> records;
+
+  // Empty data should not result in an error.
+  records.clear();
+
+  EXPECT_SOME_EQ(records, decoder.decode(""));
+
+  // Should decode more than 1 record when possible.
+  records.clear();
+  records.push_back("hello!");
+  records.push_back("");
+  records.push_back(" ");
+
+  EXPECT_SOME_EQ(records, decoder.decode("6\nHELLO!0\n1\n "));
+
+  // An entry which cannot be decoded should not
+  // fail the decoder permanently.
+  records.clear();
+  records.push_back(Error("error"));
+
+  EXPECT_SOME_EQ(records, decoder.decode("5\nerror"));
+
+  // Records which straddle a `decode()` boundary get accumulated
+  // and should only be decoded once complete.
+  records.clear();
+
+  EXPECT_SOME_EQ(records, decoder.decode("1"));
+  EXPECT_SOME_EQ(records, decoder.decode("3"));
+  EXPECT_SOME_EQ(records, decoder.decode("\n"));
+  EXPECT_SOME_EQ(records, decoder.decode("13 CHARACTER"));
+
+  records.clear();
+  records.push_back("13 characters");
+
+  EXPECT_SOME_EQ(records, decoder.decode("S"));
+
+  // If the format is bad, the decoder should fail permanently.
+  EXPECT_ERROR(decoder.decode("not a number\n"));
+  EXPECT_ERROR(decoder.decode("1\n"));
+}
+
+
+TEST(RecordIOTest, SliceDecoderZeroCopy)
+{
+  // When a complete record is available in the data passed to
+  // `decode()`, the deserialize function should be handed a slice
+  // of that data rather than a copy.
+  const char* slice = nullptr;
+
+  recordio::Decoder<string> decoder(
+      [&slice](const char* data, size_t size) -> Try<string> {
+        slice = data;
+        return string(data, size);
+      });
+
+  string data = "6\nhello!";
+
+  deque<Try<string>> records;
+  records.push_back("hello!");
+
+  EXPECT_SOME_EQ(records, decoder.decode(data));
+  EXPECT_EQ(data.data() + 2, slice);
+}
@@ -0,0 +1,161 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <stout/duration.hpp>
+#include <stout/gtest.hpp>
+#include <stout/os.hpp>
+#include <stout/shardedcache.hpp>
+
+
+TEST(ShardedCacheTest, Insert)
+{
+  ShardedCache<int, std::string> cache(1);
+  EXPECT_EQ(0u, cache.size());
+  cache.put(1, "a");
+  EXPECT_SOME_EQ("a", cache.get(1));
+  EXPECT_EQ(1u, cache.size());
+}
+
+
+TEST(ShardedCacheTest, Update)
+{
+  ShardedCache<int, std::string> cache(1);
+  cache.put(1, "a");
+  cache.put(1, "b");
+  EXPECT_SOME_EQ("b", cache.get(1));
+  EXPECT_EQ(1u, cache.size());
+}
+
+
+TEST(ShardedCacheTest, Erase)
+{
+  ShardedCache<int, std::string> cache(2);
+  cache.put(1, "a");
+  cache.put(2, "b");
+
+  EXPECT_NONE(cache.erase(44));
+
+  EXPECT_SOME_EQ("b", cache.erase(2));
+  EXPECT_EQ(1u, cache.size());
+
+  EXPECT_NONE(cache.erase(2));
+  EXPECT_EQ(1u, cache.size());
+
+  EXPECT_SOME_EQ("a", cache.erase(1));
+  EXPECT_EQ(0u, cache.size());
+}
+
+
+TEST(ShardedCacheTest, LRUEviction)
+{
+  // Use a single shard so that the capacity (and thus the eviction
+  // order) is deterministic regardless of how the keys hash.
+  ShardedCache<int, std::string> cache(2, 1);
+  cache.put(1, "a");
+  cache.put(2, "b");
+  cache.put(3, "c");
+
+  EXPECT_NONE(cache.get(1));
+
+  // 'Get' makes '2' the most-recently used (MRU) item.
+  cache.get(2);
+  cache.put(4, "d");
+  EXPECT_NONE(cache.get(3));
+  EXPECT_SOME_EQ("b", cache.get(2));
+  EXPECT_SOME_EQ("d", cache.get(4));
+
+  // 'Put' also makes '2' MRU.
+  cache.put(2, "x");
+  cache.put(5, "e");
+  EXPECT_NONE(cache.get(4));
+  EXPECT_SOME_EQ("x", cache.get(2));
+  EXPECT_SOME_EQ("e", cache.get(5));
+}
+
+
+TEST(ShardedCacheTest, TTL)
+{
+  ShardedCache<int, std::string> cache(2, 1, Milliseconds(50));
+  cache.put(1, "a");
+  EXPECT_SOME_EQ("a", cache.get(1));
+
+  os::sleep(Milliseconds(100));
+
+  EXPECT_NONE(cache.get(1));
+  EXPECT_EQ(0u, cache.size());
+
+  // Updating an entry refreshes its TTL.
+  cache.put(2, "b");
+  os::sleep(Milliseconds(30));
+  cache.put(2, "c");
+  os::sleep(Milliseconds(30));
+  EXPECT_SOME_EQ("c", cache.get(2));
+}
+
+
+TEST(ShardedCacheTest, Statistics)
+{
+  ShardedCache<int, std::string> cache(1, 1);
+
+  ShardedCache<int, std::string>::Statistics statistics = cache.statistics();
+  EXPECT_EQ(0u, statistics.hits);
+  EXPECT_EQ(0u, statistics.misses);
+  EXPECT_EQ(0u, statistics.evictions);
+  EXPECT_EQ(0u, statistics.expirations);
+
+  cache.put(1, "a");
+  cache.get(1);
+  cache.get(2);
+  cache.put(2, "b"); // Evicts '1'.
+
+  statistics = cache.statistics();
+  EXPECT_EQ(1u, statistics.hits);
+  EXPECT_EQ(1u, statistics.misses);
+  EXPECT_EQ(1u, statistics.evictions);
+  EXPECT_EQ(0u, statistics.expirations);
+}
+
+
+TEST(ShardedCacheTest, ConcurrentAccess)
+{
+  ShardedCache<int, int> cache(1024);
+
+  // Hammer the cache from multiple threads; correctness here means
+  // that every value read is the one written for its key (and that
+  // the test does not crash or race under the sanitizers).
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; i++) {
+    threads.push_back(std::thread([&cache, i]() {
+      for (int j = 0; j < 1000; j++) {
+        const int key = (i * 1000) + j;
+        cache.put(key, key * 2);
+
+        Option<int> value = cache.get(key);
+        if (value.isSome()) {
+          EXPECT_EQ(key * 2, value.get());
+        }
+
+        cache.erase((i * 1000) + (j / 2));
+      }
+    }));
+  }
+
+  foreach (std::thread& thread, threads) {
+    thread.join();
+  }
+}
@@ -433,6 +433,91 @@ TEST(StringsTest, SplitNWithMultipleDelims)
 }
 
 
+TEST(StringsTest, TokenizeView)
+{
+  const string s = "  hello world,  what's up?  ";
+
+  vector<strings::View> tokens = strings::tokenizeView(s, " ");
+  ASSERT_EQ(4u, tokens.size());
+  EXPECT_EQ("hello",  tokens[0].str());
+  EXPECT_EQ("world,", tokens[1].str());
+  EXPECT_EQ("what's", tokens[2].str());
+  EXPECT_EQ("up?",    tokens[3].str());
+
+  // The tokens point into the input rather than copies of it.
+  EXPECT_EQ(s.data() + 2, tokens[0].data());
+
+  // With a maximum number of tokens, the last token contains
+  // the remainder of the input.
+  tokens = strings::tokenizeView(s, " ", 2);
+  ASSERT_EQ(2u, tokens.size());
+  EXPECT_EQ("hello", tokens[0].str());
+  EXPECT_EQ("world,  what's up?  ", tokens[1].str());
+
+  // Tokens can be tokenized further without copying.
+  tokens = strings::tokenizeView(strings::tokenizeView(s, ",")[0], " ");
+  ASSERT_EQ(2u, tokens.size());
+  EXPECT_EQ("hello", tokens[0].str());
+  EXPECT_EQ("world", tokens[1].str());
+}
+
+
+TEST(StringsTest, SplitView)
+{
+  const string s = "foo,bar,,baz";
+
+  vector<strings::View> tokens = strings::splitView(s, ",");
+  ASSERT_EQ(4u, tokens.size());
+  EXPECT_EQ("foo", tokens[0].str());
+  EXPECT_EQ("bar", tokens[1].str());
+  EXPECT_EQ("",    tokens[2].str());
+  EXPECT_EQ("baz", tokens[3].str());
+
+  EXPECT_EQ(s.data(), tokens[0].data());
+
+  tokens = strings::splitView(s, ",", 2);
+  ASSERT_EQ(2u, tokens.size());
+  EXPECT_EQ("foo", tokens[0].str());
+  EXPECT_EQ("bar,,baz", tokens[1].str());
+}
+
+
+TEST(StringsTest, TrimView)
+{
+  const string s = " \t hello world\t  ";
+
+  strings::View trimmed = strings::trim(strings::View(s));
+  EXPECT_EQ("hello world", trimmed.str());
+  EXPECT_EQ(s.data() + 3, trimmed.data());
+
+  EXPECT_EQ("hello world\t  ",
+            strings::trim(strings::View(s), strings::PREFIX).str());
+  EXPECT_EQ(" \t hello world",
+            strings::trim(strings::View(s), strings::SUFFIX).str());
+
+  const string spaces = "    ";
+  EXPECT_TRUE(strings::trim(strings::View(spaces)).empty());
+}
+
+
+TEST(StringsTest, ViewEquality)
+{
+  const string s = "foo bar foo";
+
+  vector<strings::View> tokens = strings::tokenizeView(s, " ");
+  ASSERT_EQ(3u, tokens.size());
+
+  // Equal contents at different positions compare equal.
+  EXPECT_TRUE(tokens[0] == tokens[2]);
+  EXPECT_TRUE(tokens[0] != tokens[1]);
+  EXPECT_TRUE(tokens[0] == "foo");
+  EXPECT_TRUE(tokens[1] != "foo");
+  EXPECT_TRUE(tokens[1] == string("bar"));
+
+  EXPECT_EQ("foo", stringify(tokens[0]));
+}
+
+
 TEST(StringsTest, Pairs)
 {
   {
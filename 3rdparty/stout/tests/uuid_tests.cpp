@@ -57,6 +57,24 @@ TEST(UUIDTest, Test)
 }
 
 
+TEST(UUIDTest, Sequential)
+{
+  UUID uuid1 = UUID::sequential();
+  UUID uuid2 = UUID::sequential();
+
+  EXPECT_NE(uuid1, uuid2);
+
+  // Sequentially generated UUIDs share their random prefix and
+  // sort in generation order.
+  EXPECT_EQ(uuid1.toBytes().substr(0, 8), uuid2.toBytes().substr(0, 8));
+  EXPECT_LT(uuid1.toBytes(), uuid2.toBytes());
+
+  // They still round trip like any other UUID.
+  EXPECT_SOME_EQ(uuid1, UUID::fromBytes(uuid1.toBytes()));
+  EXPECT_SOME_EQ(uuid1, UUID::fromString(uuid1.toString()));
+}
+
+
 TEST(UUIDTest, MalformedUUID)
 {
   EXPECT_SOME(UUID::fromBytes(UUID::random().toBytes()));
@@ -39,8 +39,52 @@ namespace mesos {
 class Hook
 {
 public:
+  // Enumerates the hook points below. Used by the hook manager to
+  // precompile a per hook point invocation chain when modules are
+  // loaded, so that modules which do not implement a point are never
+  // consulted at it.
+  enum class HookPoint
+  {
+    MASTER_LAUNCH_TASK_LABEL_DECORATOR,
+    MASTER_SLAVE_LOST_HOOK,
+    SLAVE_RUN_TASK_LABEL_DECORATOR,
+    SLAVE_EXECUTOR_ENVIRONMENT_DECORATOR,
+    SLAVE_PRE_LAUNCH_DOCKER_TASK_EXECUTOR_DECORATOR,
+    SLAVE_POST_FETCH_HOOK,
+    SLAVE_REMOVE_EXECUTOR_HOOK,
+    SLAVE_TASK_STATUS_DECORATOR,
+    SLAVE_RESOURCES_DECORATOR,
+    SLAVE_ATTRIBUTES_DECORATOR,
+  };
+
   virtual ~Hook() {}
 
+  // Returns whether this module implements the given hook point. The
+  // default is deliberately conservative: a module that does not
+  // override this method is consulted at every hook point, matching
+  // the historical behavior. Modules should override this so that the
+  // hook manager can skip them entirely at the points they do not
+  // implement.
+  virtual bool implements(HookPoint hookPoint) const
+  {
+    return true;
+  }
+
+  // Returns whether the decorators implemented by this module are
+  // independent, i.e. they only inspect the original input and do not
+  // need to observe changes made by modules earlier in the chain.
+  // When every loaded module declares independence, the hook manager
+  // invokes each label decorator with the original input and unions
+  // the labels the modules add, in load order. Independent modules
+  // can therefore add labels but cannot remove or rewrite existing
+  // ones. The conservative default keeps the serial, chained
+  // execution, in which each module observes (and may replace) the
+  // labels left by its predecessors.
+  virtual bool independentDecorators() const
+  {
+    return false;
+  }
+
   // This label decorator hook is called from within master during
   // the launchTask routine. A module implementing the hook creates
   // and returns a set of labels. These labels overwrite the existing
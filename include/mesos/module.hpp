@@ -44,7 +44,9 @@
 
 #include <mesos/version.hpp>
 
-#define MESOS_MODULE_API_VERSION "2"
+// NOTE: Version 3 added the `implements` and `independentDecorators`
+// virtuals to `mesos::Hook`, changing the loaded-module interface.
+#define MESOS_MODULE_API_VERSION "3"
 
 namespace mesos {
 namespace modules {
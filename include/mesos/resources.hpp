@@ -712,6 +712,15 @@ private:
   // TODO(mzhu): Add move support.
   void add(const Resource_Unsafe& that);
 
+  // Returns a process-wide shared `Resource_` wrapping a resource
+  // that is structurally identical to the given one. Identical
+  // `Resource` protobufs (e.g. the "cpus" resource of every agent in
+  // a homogeneous cluster) are duplicated heavily across master
+  // state; interning lets all holders share a single refcounted
+  // instance. Must not be called with a shared resource, since those
+  // carry a mutable counter.
+  static Resource_Unsafe intern(const Resource_& resource_);
+
   void subtract(const Resource_& r);
 
   Resources& operator+=(const Resource_& that);
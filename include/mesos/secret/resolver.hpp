@@ -21,6 +21,8 @@
 
 #include <process/future.hpp>
 
+#include <stout/duration.hpp>
+
 namespace mesos {
 
 // This interface is used to resolve a `Secret` type into data bytes.
@@ -38,7 +40,17 @@ public:
   // `name` parameter is provided, the module is instantiated
   // using the `ModuleManager`. Otherwise, a "default" secret resolver
   // instance (defined in `src/secret/resolver.cpp`) is returned.
-  static Try<SecretResolver*> create(const Option<std::string>& name = None());
+  //
+  // If `cacheTtl` is provided, the resolver is wrapped in a cache that
+  // serves repeated resolutions of the same reference-type secret from
+  // memory for that duration, and coalesces concurrent resolutions of
+  // the same secret into a single backend round-trip. If additionally
+  // `negativeCacheTtl` is provided, failed resolutions are cached for
+  // that duration as well.
+  static Try<SecretResolver*> create(
+      const Option<std::string>& name = None(),
+      const Option<Duration>& cacheTtl = None(),
+      const Option<Duration>& negativeCacheTtl = None());
 
   virtual ~SecretResolver() {}
 
@@ -19,11 +19,15 @@
 
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <mesos/state/state.pb.h>
 
+#include <process/collect.hpp>
 #include <process/future.hpp>
 
+#include <stout/foreach.hpp>
 #include <stout/option.hpp>
 #include <stout/uuid.hpp>
 
@@ -46,6 +50,49 @@ public:
       const internal::state::Entry& entry,
       const id::UUID& uuid) = 0;
 
+  // Batched variants of 'get' and 'set' for callers that touch many
+  // entries at once. The default implementations simply issue the
+  // individual operations concurrently, so independent round trips
+  // to the backend get pipelined rather than paid sequentially, but
+  // implementations may override them to exploit backend support for
+  // multi-key operations instead.
+  virtual process::Future<std::vector<Option<internal::state::Entry>>> get(
+      const std::vector<std::string>& names)
+  {
+    std::vector<process::Future<Option<internal::state::Entry>>> futures;
+    futures.reserve(names.size());
+
+    foreach (const std::string& name, names) {
+      futures.push_back(get(name));
+    }
+
+    return process::collect(futures);
+  }
+
+  // Returns true only if every entry was stored. Note that the
+  // default implementation is not atomic: some of the entries may
+  // have been stored even when false is returned.
+  virtual process::Future<bool> set(
+      const std::vector<std::pair<internal::state::Entry, id::UUID>>& entries)
+  {
+    std::vector<process::Future<bool>> futures;
+    futures.reserve(entries.size());
+
+    for (size_t i = 0; i < entries.size(); i++) {
+      futures.push_back(set(entries[i].first, entries[i].second));
+    }
+
+    return process::collect(futures)
+      .then([](const std::vector<bool>& results) {
+        foreach (bool result, results) {
+          if (!result) {
+            return false;
+          }
+        }
+        return true;
+      });
+  }
+
   // Returns true if successfully expunged the variable from the state.
   virtual process::Future<bool> expunge(
       const internal::state::Entry& entry) = 0;
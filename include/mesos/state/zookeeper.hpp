@@ -19,6 +19,8 @@
 
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <mesos/zookeeper/authentication.hpp>
 
@@ -54,6 +56,13 @@ public:
   process::Future<bool> set(
       const internal::state::Entry& entry,
       const id::UUID& uuid) override;
+
+  // Stores the whole batch atomically using a ZooKeeper multi-op:
+  // either every entry is updated or none are.
+  process::Future<bool> set(
+      const std::vector<std::pair<internal::state::Entry, id::UUID>>& entries)
+      override;
+
   process::Future<bool> expunge(const internal::state::Entry& entry) override;
   process::Future<std::set<std::string>> names() override;
 
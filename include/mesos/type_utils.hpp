@@ -155,6 +155,14 @@ inline bool operator==(const DurationInfo& left, const DurationInfo& right)
 }
 
 
+inline bool operator==(const Unavailability& left, const Unavailability& right)
+{
+  return left.start() == right.start() &&
+    left.has_duration() == right.has_duration() &&
+    (!left.has_duration() || left.duration() == right.duration());
+}
+
+
 inline bool operator==(const ContainerID& left, const std::string& right)
 {
   return left.value() == right;
@@ -308,6 +316,12 @@ inline bool operator!=(const DurationInfo& left, const DurationInfo& right)
 }
 
 
+inline bool operator!=(const Unavailability& left, const Unavailability& right)
+{
+  return !(left == right);
+}
+
+
 inline bool operator!=(
     const DomainInfo::FaultDomain::RegionInfo& left,
     const DomainInfo::FaultDomain::RegionInfo& right)
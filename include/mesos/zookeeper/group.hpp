@@ -183,6 +183,11 @@ public:
 
   static const Duration RETRY_INTERVAL;
 
+  // Time to wait after a watch event before re-listing the
+  // memberships, so that a burst of events (e.g., many members
+  // joining or failing at once) coalesces into a single refresh.
+  static const Duration REFRESH_INTERVAL;
+
   // Helper function that returns the basename of the znode of
   // the membership.
   static std::string zkBasename(const Group::Membership& membership);
@@ -239,6 +244,11 @@ private:
   // Updates any pending watches.
   void update();
 
+  // Re-lists the memberships after watch events. Scheduled (with a
+  // delay) by 'updated' rather than run inline so that rapid
+  // successive watch events collapse into one refresh.
+  void refresh();
+
   // Generic retry method. This mechanism is "generic" in the sense
   // that it is not specific to any particular operation, but rather
   // attempts to perform all pending operations (including caching
@@ -331,6 +341,9 @@ private:
   // Indicates there is a pending delayed retry.
   bool retrying;
 
+  // Indicates there is a pending delayed refresh.
+  bool refreshing;
+
   // Expected ZooKeeper sequence numbers (either owned/created by this
   // group instance or not) and the promise we associate with their
   // "cancellation" (i.e., no longer part of the group).
@@ -341,6 +354,12 @@ private:
   // cache and 'Some' represents a valid cache.
   Option<std::set<Group::Membership>> memberships;
 
+  // Cache of membership data. Member znodes are created with their
+  // data and never rewritten, so data fetched once remains valid for
+  // as long as the member exists; entries are evicted when the
+  // membership goes away.
+  std::map<int32_t, std::string> datas;
+
   // A timer that controls when we should give up on waiting for the
   // current connection attempt to succeed and try to reconnect.
   Option<process::Timer> connectTimer;
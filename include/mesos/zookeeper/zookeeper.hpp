@@ -311,6 +311,34 @@ public:
    */
   int set(const std::string& path, const std::string& data, int version);
 
+  /**
+   * \brief a single conditional update, used by the multi-update
+   * overload of 'set' below.
+   */
+  struct Update
+  {
+    std::string path;
+    std::string data;
+    int version;
+  };
+
+  /**
+   * \brief sets the data associated with multiple nodes atomically.
+   *
+   * The updates are submitted to the server as a single multi-op
+   * round trip: either every update is applied or none are. Each
+   * update is conditioned on its expected version just like the
+   * single node 'set' above.
+   *
+   * \param updates the updates to apply. Must not be empty.
+   * \return the return code for the function call.
+   * ZOK every update completed successfully
+   * On failure, the return code of the first update that could not be
+   * applied (e.g., ZNONODE, ZBADVERSION), or a connection level error
+   * (e.g., ZINVALIDSTATE, ZMARSHALLINGERROR).
+   */
+  int set(const std::vector<Update>& updates);
+
   /**
    * \brief return a message describing the return code.
    *
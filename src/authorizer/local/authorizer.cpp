@@ -30,6 +30,7 @@
 #include <process/protobuf.hpp>
 
 #include <stout/foreach.hpp>
+#include <stout/hashmap.hpp>
 #include <stout/none.hpp>
 #include <stout/option.hpp>
 #include <stout/path.hpp>
@@ -1110,6 +1111,39 @@ public:
   Future<Owned<ObjectApprover>> getObjectApprover(
       const Option<authorization::Subject>& subject,
       const authorization::Action& action)
+  {
+    // Approvers are deterministic, stateless functions of the
+    // (subject, action) pair and the ACLs, and the ACLs of a local
+    // authorizer cannot change after construction, so we can memoize
+    // them: hot paths such as task launch and endpoint authorization
+    // repeatedly request approvers for the same few principals.
+    //
+    // The cache is bounded to guard against subjects of unbounded
+    // cardinality (e.g., claims-based subjects naming container IDs).
+    static const size_t limit = 10000;
+
+    string key = subject.isSome() ? subject->SerializeAsString() : "";
+    key += ':';
+    key += stringify(action);
+
+    Option<Owned<ObjectApprover>> cached = approverCache.get(key);
+    if (cached.isSome()) {
+      return cached.get();
+    }
+
+    Future<Owned<ObjectApprover>> approver =
+      _getObjectApprover(subject, action);
+
+    if (approver.isReady() && approverCache.size() < limit) {
+      approverCache.put(key, approver.get());
+    }
+
+    return approver;
+  }
+
+  Future<Owned<ObjectApprover>> _getObjectApprover(
+      const Option<authorization::Subject>& subject,
+      const authorization::Action& action)
   {
     // We return implicit object approvers only for subjects and actions
     // which comes from either the default executor or a local resource
@@ -1600,6 +1634,10 @@ private:
   }
 
   ACLs acls;
+
+  // Memoized object approvers, keyed on the serialized subject and
+  // the action. See `getObjectApprover()`.
+  hashmap<string, Owned<ObjectApprover>> approverCache;
 };
 
 
@@ -36,6 +36,7 @@
 #include <process/future.hpp>
 #include <process/io.hpp>
 #include <process/protobuf.hpp>
+#include <process/socket.hpp>
 #include <process/subprocess.hpp>
 #include <process/time.hpp>
 
@@ -43,6 +44,7 @@
 #include <stout/duration.hpp>
 #include <stout/error.hpp>
 #include <stout/foreach.hpp>
+#include <stout/ip.hpp>
 #include <stout/jsonify.hpp>
 #include <stout/nothing.hpp>
 #include <stout/option.hpp>
@@ -71,6 +73,7 @@
 #endif
 
 namespace http = process::http;
+namespace network = process::network;
 
 using process::Failure;
 using process::Future;
@@ -173,9 +176,10 @@ static Try<tuple<string, string>> decodeProcessIOData(const string& data)
 
   ::recordio::Decoder<v1::agent::ProcessIO> decoder(
       lambda::bind(
-          deserialize<v1::agent::ProcessIO>,
+          deserializeSlice<v1::agent::ProcessIO>,
           ContentType::PROTOBUF,
-          lambda::_1));
+          lambda::_1,
+          lambda::_2));
 
   Try<std::deque<Try<v1::agent::ProcessIO>>> records = decoder.decode(data);
 
@@ -597,6 +601,33 @@ Future<int> CheckerProcess::dockerCommandCheck(
 }
 
 
+Future<http::Connection> CheckerProcess::agentConnect(
+    const runtime::Nested& nested)
+{
+  if (agentConnection.isSome()) {
+    return agentConnection.get();
+  }
+
+  return http::connect(nested.agentURL)
+    .then(defer(self(), [this](http::Connection connection) {
+      agentConnection = connection;
+
+      // Evict the cached connection when it is closed, e.g., because
+      // the agent failed over or a check timeout forced a disconnect,
+      // so that the next probe establishes a fresh one.
+      connection.disconnected()
+        .onAny(defer(self(), [this, connection](const Future<Nothing>&) {
+          if (agentConnection.isSome() &&
+              agentConnection.get() == connection) {
+            agentConnection = None();
+          }
+        }));
+
+      return connection;
+    }));
+}
+
+
 Future<int> CheckerProcess::nestedCommandCheck(
     const check::Command& cmd,
     const runtime::Nested& nested)
@@ -626,6 +657,9 @@ Future<int> CheckerProcess::nestedCommandCheck(
 
     http::Request request;
     request.method = "POST";
+    // Keep the agent connection open so that it can be reused
+    // for subsequent probes.
+    request.keepAlive = true;
     request.url = nested.agentURL;
     request.body = serialize(ContentType::PROTOBUF, evolve(call));
     request.headers = {{"Accept", stringify(ContentType::PROTOBUF)},
@@ -635,7 +669,10 @@ Future<int> CheckerProcess::nestedCommandCheck(
       request.headers["Authorization"] = nested.authorizationHeader.get();
     }
 
-    http::request(request, false)
+    agentConnect(nested)
+      .then(defer(self(), [=](http::Connection connection) {
+        return connection.send(request, false);
+      }))
       .onFailed(defer(self(),
                       [this, promise, previousId](const string& failure) {
         LOG(WARNING) << "Connection to remove the nested container '"
@@ -681,7 +718,7 @@ void CheckerProcess::_nestedCommandCheck(
   const TaskID _taskId = taskId;
   const string _name = name;
 
-  http::connect(nested.agentURL)
+  agentConnect(nested)
     .onFailed(defer(self(), [_taskId, _name, promise](const string& failure) {
       LOG(WARNING) << "Unable to establish connection with the agent to launch "
                    << _name << " for task '" << _taskId << "'"
@@ -724,6 +761,9 @@ void CheckerProcess::__nestedCommandCheck(
 
   http::Request request;
   request.method = "POST";
+  // Keep the agent connection open so that it can be reused
+  // for subsequent probes.
+  request.keepAlive = true;
   request.url = nested.agentURL;
   request.body = serialize(ContentType::PROTOBUF, evolve(call));
   request.headers = {{"Accept", stringify(ContentType::RECORDIO)},
@@ -919,6 +959,9 @@ Future<Option<int>> CheckerProcess::waitNestedContainer(
 
   http::Request request;
   request.method = "POST";
+  // Keep the agent connection open so that it can be reused
+  // for subsequent probes.
+  request.keepAlive = true;
   request.url = nested.agentURL;
   request.body = serialize(ContentType::PROTOBUF, evolve(call));
   request.headers = {{"Accept", stringify(ContentType::PROTOBUF)},
@@ -932,7 +975,10 @@ Future<Option<int>> CheckerProcess::waitNestedContainer(
   // this cached value once it is available.
   const string _name = name;
 
-  return http::request(request, false)
+  return agentConnect(nested)
+    .then(defer(self(), [=](http::Connection connection) {
+      return connection.send(request, false);
+    }))
     .repair([containerId, _name](const Future<http::Response>& future) {
       return Failure(
           "Connection to wait for " + _name + " container '" +
@@ -1234,6 +1280,13 @@ Future<bool> CheckerProcess::tcpCheck(
     const check::Tcp& tcp,
     const Option<runtime::Plain>& plain)
 {
+  // If the check does not have to enter another network namespace,
+  // connect directly from this process instead of forking the
+  // `TCP_CHECK_COMMAND` helper binary for every probe.
+  if (plain.isNone() || plain->namespaces.empty()) {
+    return nativeTcpCheck(tcp);
+  }
+
   const string command = path::join(tcp.launcherDir, TCP_CHECK_COMMAND);
 
   const vector<string> argv =
@@ -1242,6 +1295,61 @@ Future<bool> CheckerProcess::tcpCheck(
   return _tcpCheck(argv, plain);
 }
 
+Future<bool> CheckerProcess::nativeTcpCheck(const check::Tcp& tcp)
+{
+  VLOG(1) << "Connecting to " << tcp.domain << ":" << tcp.port
+          << " for the " << name << " for task '" << taskId << "'";
+
+  // Mirror the `TCP_CHECK_COMMAND` helper binary: a malformed address
+  // or a socket error is indistinguishable from an actually failed
+  // connection, hence all of them are treated as connection failure.
+  Try<net::IP> ip = net::IP::parse(tcp.domain);
+  if (ip.isError()) {
+    LOG(WARNING) << "Cannot convert '" << tcp.domain << "' into a"
+                 << " network address: " << ip.error();
+    return false;
+  }
+
+  const network::inet::Address address(
+      ip.get(), static_cast<uint16_t>(tcp.port));
+
+  Try<network::Socket> socket =
+    network::Socket::create(network::Address(address).family());
+
+  if (socket.isError()) {
+    LOG(WARNING) << "Failed to create socket: " << socket.error();
+    return false;
+  }
+
+  // TODO(alexr): Use lambda named captures for
+  // these cached values once they are available.
+  const string _name = name;
+  const Duration timeout = checkTimeout;
+  const TaskID _taskId = taskId;
+
+  return socket->connect(address)
+    .then([socket]() -> Future<bool> {
+      // NOTE: We capture the socket to keep it open until the
+      // connection attempt has completed; dropping the last reference
+      // closes the underlying file descriptor.
+      return true;
+    })
+    .repair([socket, _name, _taskId](
+        const Future<bool>& future) -> Future<bool> {
+      VLOG(1) << "Connection failure during the " << _name << " for task '"
+              << _taskId << "': " << future.failure();
+
+      return false;
+    })
+    .after(timeout, [timeout](Future<bool> future) {
+      future.discard();
+
+      return Future<bool>(Failure(
+          "TCP connection timed out after " + stringify(timeout)));
+    });
+}
+
+
 Future<bool> CheckerProcess::_tcpCheck(
     const vector<string>& cmdArgv,
     const Option<runtime::Plain>& plain)
@@ -90,6 +90,11 @@ private:
       const check::Command& cmd,
       const runtime::Docker& docker);
 
+  // Returns a connection to the agent's v1 API, reusing the
+  // long-lived one from a previous call if it is still open.
+  process::Future<process::http::Connection> agentConnect(
+      const runtime::Nested& nested);
+
   process::Future<int> nestedCommandCheck(
       const check::Command& cmd,
       const runtime::Nested& nested);
@@ -151,6 +156,10 @@ private:
   process::Future<bool> tcpCheck(
       const check::Tcp& tcp,
       const Option<runtime::Plain>& plain);
+  // Performs the TCP check in-process. Only used when the check does
+  // not have to enter another network namespace, in which case forking
+  // a helper binary for every probe is unnecessary.
+  process::Future<bool> nativeTcpCheck(const check::Tcp& tcp);
   process::Future<bool> _tcpCheck(
       const std::vector<std::string>& cmdArgv,
       const Option<runtime::Plain>& plain);
@@ -187,6 +196,11 @@ private:
   // Contains the ID of the most recently terminated nested container
   // that was used to perform a COMMAND check.
   Option<ContainerID> previousCheckContainerId;
+
+  // A connection to the agent's v1 API that is kept open across
+  // probes of a COMMAND check in a nested container, so that each
+  // probe does not pay for establishing new agent connections.
+  Option<process::http::Connection> agentConnection;
 };
 
 } // namespace checks {
@@ -25,6 +25,7 @@
 #include <stout/unreachable.hpp>
 
 #include <stout/os/constants.hpp>
+#include <stout/os/which.hpp>
 
 #include "common/command_utils.hpp"
 #include "common/status_utils.hpp"
@@ -135,6 +136,10 @@ Future<Nothing> tar(
       case Compression::XZ:
         argv.emplace_back("-J");
         break;
+      case Compression::ZSTD:
+        // NOTE: Not all tar versions in use understand '--zstd'.
+        argv.emplace_back("--use-compress-program=zstd");
+        break;
       default:
         UNREACHABLE();
     }
@@ -147,6 +152,50 @@ Future<Nothing> tar(
 }
 
 
+// Returns the decompression command for the given archive based on
+// its magic number, or None to let tar extract the file as-is.
+//
+// We pick the decompressor ourselves rather than relying on tar's
+// auto-detection because:
+//   1. Zstandard archives are only auto-detected by recent tar
+//      versions.
+//   2. The parallel decompressors ('pigz', 'pzstd') overlap reading,
+//      decompression and checksumming on separate threads, which
+//      measurably speeds up image layer extraction; tar never picks
+//      them on its own.
+static Option<string> decompressor(const Path& input)
+{
+  static const string GZIP_MAGIC = string("\x1f\x8b", 2);
+  static const string ZSTD_MAGIC = string("\x28\xb5\x2f\xfd", 4);
+
+  Try<int_fd> fd = os::open(input, O_RDONLY | O_CLOEXEC);
+  if (fd.isError()) {
+    return None();
+  }
+
+  Result<string> magic = os::read(fd.get(), ZSTD_MAGIC.size());
+
+  os::close(fd.get());
+
+  if (!magic.isSome()) {
+    return None();
+  }
+
+  if (strings::startsWith(magic.get(), ZSTD_MAGIC)) {
+    return os::which("pzstd").isSome()
+      ? string("pzstd -d")
+      : string("zstd -d");
+  }
+
+  if (strings::startsWith(magic.get(), GZIP_MAGIC) &&
+      os::which("pigz").isSome()) {
+    return string("pigz -d");
+  }
+
+  return None();
+}
+
+
 Future<Nothing> untar(
     const Path& input,
     const Option<Path>& directory)
@@ -164,6 +213,11 @@ Future<Nothing> untar(
     argv.emplace_back(directory.get());
   }
 
+  Option<string> decompress = decompressor(input);
+  if (decompress.isSome()) {
+    argv.emplace_back("--use-compress-program=" + decompress.get());
+  }
+
   return launch("tar", argv)
     .then([]() { return Nothing(); });
 }
@@ -30,7 +30,8 @@ enum class Compression
 {
   GZIP,
   BZIP2,
-  XZ
+  XZ,
+  ZSTD
 };
 
 
@@ -52,6 +53,13 @@ process::Future<Nothing> tar(
 /**
  * Untar(unarchive) the given file.
  *
+ * The decompressor is selected from the magic number of the input,
+ * so compressed archives (including Zstandard ones, which older tar
+ * versions do not auto-detect) extract transparently. Decompression
+ * runs in a separate process from the disk writes performed by tar,
+ * and parallel decompressors ('pigz', 'pzstd') are preferred when
+ * installed.
+ *
  * @param input file or directory that will be unarchived.
  * @param directory change to this directory before unarchiving.
  */
@@ -0,0 +1,76 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __COMMON_EVENT_STREAM_HPP__
+#define __COMMON_EVENT_STREAM_HPP__
+
+#include <string>
+
+#include <process/shared.hpp>
+
+#include <stout/hashmap.hpp>
+#include <stout/lambda.hpp>
+#include <stout/recordio.hpp>
+
+#include "common/http.hpp"
+
+#include "internal/evolve.hpp"
+
+namespace mesos {
+namespace internal {
+
+/**
+ * Encodes an operator API event into the RecordIO format consumed by
+ * event-stream subscribers, at most once per content type.
+ *
+ * When an event is sent unmodified to every subscriber, a single
+ * encoder should be shared across the subscribers so that the number
+ * of serializations depends on the number of distinct content types
+ * in use rather than the number of subscribers. Events that are
+ * rewritten per subscriber (e.g., based on authorization results)
+ * must not share their encoding.
+ *
+ * The unversioned event is evolved to `V1Event` before encoding,
+ * matching what subscribers receive on the stream.
+ */
+template <typename Event, typename V1Event>
+class EventStreamEncoder
+{
+public:
+  explicit EventStreamEncoder(const process::Shared<Event>& _event)
+    : event(_event) {}
+
+  const std::string& encode(ContentType contentType)
+  {
+    if (!encodings.contains(contentType)) {
+      ::recordio::Encoder<V1Event> encoder(
+          lambda::bind(serialize, contentType, lambda::_1));
+
+      encodings.put(contentType, encoder.encode(evolve(*event)));
+    }
+
+    return encodings.at(contentType);
+  }
+
+private:
+  process::Shared<Event> event;
+  hashmap<ContentType, std::string> encodings;
+};
+
+} // namespace internal {
+} // namespace mesos {
+
+#endif // __COMMON_EVENT_STREAM_HPP__
@@ -14,6 +14,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <map>
 #include <ostream>
 #include <set>
@@ -37,6 +38,7 @@
 #include <process/future.hpp>
 #include <process/http.hpp>
 #include <process/pid.hpp>
+#include <process/protobuf.hpp>
 
 #include <stout/duration.hpp>
 #include <stout/foreach.hpp>
@@ -515,6 +517,49 @@ JSON::Object model(const quota::QuotaInfo& quotaInfo)
   return object;
 }
 
+
+JSON::Object modelMessageCensus()
+{
+  const hashmap<string, process::MessageCensus::Stats> statistics =
+    process::MessageCensus::instance()->snapshot();
+
+  // Rank the message types by sampled wire bytes so that the biggest
+  // bandwidth consumers come first.
+  vector<std::pair<string, process::MessageCensus::Stats>> ranked(
+      statistics.begin(), statistics.end());
+
+  std::sort(
+      ranked.begin(),
+      ranked.end(),
+      [](const std::pair<string, process::MessageCensus::Stats>& left,
+         const std::pair<string, process::MessageCensus::Stats>& right) {
+        return left.second.bytes > right.second.bytes;
+      });
+
+  JSON::Object object;
+
+  object.values["sample_interval"] =
+    static_cast<unsigned int>(process::MessageCensus::SAMPLE_INTERVAL);
+
+  JSON::Array array;
+  array.values.reserve(ranked.size());
+
+  foreach (const auto& entry, ranked) {
+    JSON::Object message;
+
+    message.values["type"] = entry.first;
+    message.values["count"] = entry.second.count;
+    message.values["bytes"] = entry.second.bytes;
+    message.values["parse_time_secs"] = entry.second.parse.secs();
+
+    array.values.push_back(std::move(message));
+  }
+
+  object.values["messages"] = std::move(array);
+
+  return object;
+}
+
 }  // namespace internal {
 
 void json(JSON::ObjectWriter* writer, const Attributes& attributes)
@@ -117,12 +117,47 @@ Try<Message> deserialize(
       return message;
     }
     case ContentType::JSON: {
-      Try<JSON::Value> value = JSON::parse(body);
-      if (value.isError()) {
-        return Error("Failed to parse body into JSON: " + value.error());
-      }
+      // Transcode the JSON directly into the message rather than
+      // materializing an intermediate `JSON::Value` tree.
+      return ::protobuf::parse<Message>(body);
+    }
+    case ContentType::RECORDIO: {
+      return Error("Deserializing a RecordIO stream is not supported");
+    }
+  }
 
-      return ::protobuf::parse<Message>(value.get());
+  UNREACHABLE();
+}
+
+
+// Deserializes a range of bytes into a protobuf message based on the
+// HTTP content type. Unlike `deserialize` above, this does not
+// require the caller to accumulate the bytes into an `std::string`
+// first, which lets streaming API readers parse each record directly
+// out of the input buffer (see the slice based `recordio::Decoder`
+// constructor).
+//
+// NOTE: This is deliberately not an overload of `deserialize`: many
+// call sites pass `deserialize<T>` to `lambda::bind`, which cannot
+// take the address of an overloaded function template.
+template <typename Message>
+Try<Message> deserializeSlice(
+    ContentType contentType,
+    const char* data,
+    size_t size)
+{
+  switch (contentType) {
+    case ContentType::PROTOBUF: {
+      Message message;
+      if (!message.ParseFromArray(data, static_cast<int>(size))) {
+        return Error("Failed to parse body into a protobuf object");
+      }
+      return message;
+    }
+    case ContentType::JSON: {
+      // Transcode the JSON directly into the message rather than
+      // materializing an intermediate `JSON::Value` tree.
+      return ::protobuf::parse<Message>(data, size);
     }
     case ContentType::RECORDIO: {
       return Error("Deserializing a RecordIO stream is not supported");
@@ -148,6 +183,13 @@ JSON::Object model(const Task& task);
 JSON::Object model(const FileInfo& fileInfo);
 JSON::Object model(const quota::QuotaInfo& quotaInfo);
 
+
+// Returns a snapshot of the protobuf message census with the
+// per-type entries ranked by sampled wire bytes, i.e. the biggest
+// bandwidth consumers first. Used by the master's and agent's
+// '/messages' endpoints.
+JSON::Object modelMessageCensus();
+
 void json(JSON::ObjectWriter* writer, const Task& task);
 
 } // namespace internal {
@@ -0,0 +1,85 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/interner.hpp"
+
+#include <stout/option.hpp>
+
+using std::shared_ptr;
+using std::string;
+using std::weak_ptr;
+
+namespace mesos {
+namespace internal {
+
+StringInterner& StringInterner::roles()
+{
+  // Deliberately leaked so that handles may safely be destructed
+  // during program teardown.
+  static StringInterner* interner = new StringInterner();
+  return *interner;
+}
+
+
+shared_ptr<const string> StringInterner::intern(const string& s)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  Option<weak_ptr<const string>> entry = table.get(s);
+  if (entry.isSome()) {
+    shared_ptr<const string> interned = entry->lock();
+    if (interned) {
+      return interned;
+    }
+  }
+
+  // The deleter erases the table entry once the last handle goes
+  // away; see `remove()`.
+  shared_ptr<const string> interned(
+      new string(s),
+      [this](const string* interned) {
+        remove(interned);
+        delete interned;
+      });
+
+  table[s] = interned;
+
+  return interned;
+}
+
+
+size_t StringInterner::size()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  return table.size();
+}
+
+
+void StringInterner::remove(const string* s)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  // Only erase if the entry has not been re-interned between the
+  // handle's reference count reaching zero and us taking the lock.
+  auto iterator = table.find(*s);
+  if (iterator != table.end() && iterator->second.expired()) {
+    table.erase(iterator);
+  }
+}
+
+} // namespace internal {
+} // namespace mesos {
@@ -0,0 +1,70 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __COMMON_INTERNER_HPP__
+#define __COMMON_INTERNER_HPP__
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <stout/hashmap.hpp>
+
+namespace mesos {
+namespace internal {
+
+// An intern table for frequently duplicated strings, e.g., role
+// paths, which tend to be long ("eng/team/service/instance") and held
+// in many places at once. Interning returns a shared, immutable copy:
+// all holders of handles to equal strings hold the same pointer, so
+// each distinct string is stored once and handle equality reduces to
+// a pointer comparison.
+//
+// A string is dropped from the table when the last handle to it goes
+// away, so the table only ever holds strings that are in use.
+//
+// The table is thread safe; interning performs a single hashed
+// lookup under a lock.
+class StringInterner
+{
+public:
+  // The process-wide interner for role (and role-like client) paths.
+  // The returned interner outlives all callers.
+  static StringInterner& roles();
+
+  StringInterner() {}
+
+  // Not copyable, not assignable: handles must come from a single
+  // table for pointer equality to be meaningful.
+  StringInterner(const StringInterner&) = delete;
+  StringInterner& operator=(const StringInterner&) = delete;
+
+  std::shared_ptr<const std::string> intern(const std::string& s);
+
+  // The number of distinct strings currently interned.
+  size_t size();
+
+private:
+  void remove(const std::string* s);
+
+  std::mutex mutex;
+  hashmap<std::string, std::weak_ptr<const std::string>> table;
+};
+
+} // namespace internal {
+} // namespace mesos {
+
+#endif // __COMMON_INTERNER_HPP__
@@ -1059,7 +1059,9 @@ bool operator==(const Capabilities& left, const Capabilities& right)
          left.hierarchicalRole == right.hierarchicalRole &&
          left.reservationRefinement == right.reservationRefinement &&
          left.resourceProvider == right.resourceProvider &&
-         left.resizeVolume == right.resizeVolume;
+         left.resizeVolume == right.resizeVolume &&
+         left.batchedStatusUpdateAcknowledgements ==
+           right.batchedStatusUpdateAcknowledgements;
 }
 
 
@@ -286,6 +286,9 @@ struct Capabilities
         case SlaveInfo::Capability::RESIZE_VOLUME:
           resizeVolume = true;
           break;
+        case SlaveInfo::Capability::BATCHED_STATUS_UPDATE_ACKNOWLEDGEMENTS:
+          batchedStatusUpdateAcknowledgements = true;
+          break;
         // If adding another case here be sure to update the
         // equality operator.
       }
@@ -298,6 +301,7 @@ struct Capabilities
   bool reservationRefinement = false;
   bool resourceProvider = false;
   bool resizeVolume = false;
+  bool batchedStatusUpdateAcknowledgements = false;
 
   google::protobuf::RepeatedPtrField<SlaveInfo::Capability>
   toRepeatedPtrField() const
@@ -318,6 +322,10 @@ struct Capabilities
     if (resizeVolume) {
       result.Add()->set_type(SlaveInfo::Capability::RESIZE_VOLUME);
     }
+    if (batchedStatusUpdateAcknowledgements) {
+      result.Add()->set_type(
+          SlaveInfo::Capability::BATCHED_STATUS_UPDATE_ACKNOWLEDGEMENTS);
+    }
 
     return result;
   }
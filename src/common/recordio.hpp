@@ -17,6 +17,8 @@
 #ifndef __COMMON_RECORDIO_HPP__
 #define __COMMON_RECORDIO_HPP__
 
+#include <atomic>
+#include <memory>
 #include <queue>
 #include <string>
 #include <utility>
@@ -97,6 +99,187 @@ private:
 };
 
 
+namespace internal {
+
+// Actor backing `Writer` below. Note that this is defined before the
+// public `Writer` class (unlike `ReaderProcess`) because `Writer` is
+// not a template and needs the complete type.
+class WriterProcess : public process::Process<WriterProcess>
+{
+public:
+  WriterProcess(
+      process::http::Pipe::Writer _writer,
+      const std::shared_ptr<std::atomic<bool>>& _open)
+    : process::ProcessBase(process::ID::generate("__writer__")),
+      writer(std::move(_writer)),
+      open(_open),
+      flushPending(false) {}
+
+  void write(std::string&& record)
+  {
+    buffer += record;
+
+    // Flush large buffers eagerly. Otherwise, wait until the writes
+    // already queued behind this one have been drained so that a
+    // burst of records goes out as a single chunk.
+    if (buffer.size() >= FLUSH_THRESHOLD) {
+      flush();
+    } else if (!flushPending) {
+      flushPending = true;
+      process::dispatch(this->self(), &WriterProcess::_flush);
+    }
+  }
+
+  Nothing flush()
+  {
+    if (!buffer.empty()) {
+      if (!writer.write(std::move(buffer))) {
+        open->store(false);
+      }
+      buffer.clear();
+    }
+
+    return Nothing();
+  }
+
+  void close()
+  {
+    flush();
+    writer.close();
+    open->store(false);
+  }
+
+private:
+  void _flush()
+  {
+    flushPending = false;
+    flush();
+  }
+
+  // Buffers larger than this are flushed without waiting for the
+  // write queue to drain, bounding both memory usage and the size
+  // of the chunks passed to the pipe.
+  static constexpr size_t FLUSH_THRESHOLD = 16 * 1024;
+
+  process::http::Pipe::Writer writer;
+  std::shared_ptr<std::atomic<bool>> open;
+  std::string buffer;
+  bool flushPending;
+};
+
+} // namespace internal {
+
+
+/**
+ * Provides coalescing writes on top of an http::Pipe::Writer.
+ *
+ * Writing one pipe chunk per record makes the HTTP response path emit
+ * one small chunked-encoding write (and often one syscall) per record.
+ * This wrapper buffers records and flushes them as a single chunk once
+ * the writes queued behind the current one have drained, or earlier if
+ * the buffer exceeds a size threshold. Ordering is preserved and no
+ * artificial latency is added: the flush runs as soon as the writer
+ * goes idle, so a solitary record is written out immediately.
+ *
+ * Copies share the same underlying writer; the backing actor is
+ * terminated when the last copy is destroyed.
+ */
+class Writer
+{
+public:
+  explicit Writer(const process::http::Pipe::Writer& _writer)
+    : writer(_writer),
+      open(std::make_shared<std::atomic<bool>>(true)),
+      data(std::make_shared<Data>(process::spawn(
+          new internal::WriterProcess(_writer, open), true)))
+  {
+    // Mirror the underlying pipe: once the reader goes away no
+    // subsequent write can succeed.
+    std::shared_ptr<std::atomic<bool>> open_ = open;
+    writer.readerClosed().onAny([open_]() { open_->store(false); });
+  }
+
+  /**
+   * Buffers the record for writing. As with `http::Pipe::Writer`,
+   * returns false if the writer has been closed or the read end of
+   * the pipe is gone.
+   */
+  bool write(std::string&& record)
+  {
+    if (!open->load()) {
+      return false;
+    }
+
+    process::dispatch(
+        data->pid, &internal::WriterProcess::write, std::move(record));
+
+    return true;
+  }
+
+  /**
+   * Flushes any buffered records and closes the write end of the
+   * pipe. Returns false if the writer was already closed.
+   */
+  bool close()
+  {
+    if (!open->load()) {
+      return false;
+    }
+
+    open->store(false);
+    process::dispatch(data->pid, &internal::WriterProcess::close);
+
+    return true;
+  }
+
+  /**
+   * Completes once the records buffered so far have been written to
+   * the pipe.
+   */
+  process::Future<Nothing> flush()
+  {
+    return process::dispatch(data->pid, &internal::WriterProcess::flush);
+  }
+
+  process::Future<Nothing> readerClosed() const
+  {
+    return writer.readerClosed();
+  }
+
+  /**
+   * Returns the number of unread bytes in the underlying pipe. Does
+   * not include records still being coalesced in the buffer.
+   */
+  size_t outstanding() const
+  {
+    return writer.outstanding();
+  }
+
+  bool operator==(const Writer& that) const { return writer == that.writer; }
+
+private:
+  struct Data
+  {
+    explicit Data(const process::PID<internal::WriterProcess>& _pid)
+      : pid(_pid) {}
+
+    ~Data()
+    {
+      // As with `Reader`, we avoid injecting the termination event at
+      // the front of the queue so that buffered writes and flushes
+      // are processed first.
+      process::terminate(pid, false);
+    }
+
+    process::PID<internal::WriterProcess> pid;
+  };
+
+  process::http::Pipe::Writer writer;
+  std::shared_ptr<std::atomic<bool>> open;
+  std::shared_ptr<Data> data;
+};
+
+
 /**
  * This is a helper function that reads records from a `Reader`, applies
  * a transformation to the records and writes to the pipe.
@@ -114,6 +297,10 @@ process::Future<Nothing> transform(
     const std::function<std::string(const T&)>& func,
     process::http::Pipe::Writer writer)
 {
+  // Coalesce records so that a burst read from `reader` results in a
+  // single chunk on the pipe rather than one chunk per record.
+  Writer coalescing(writer);
+
   return process::loop(
       None(),
       [=]() {
@@ -123,7 +310,12 @@ process::Future<Nothing> transform(
         -> process::Future<process::ControlFlow<Nothing>> {
         // This could happen if EOF is sent by the writer.
         if (record.isNone()) {
-          return process::Break();
+          // Make sure buffered records reach the pipe before the
+          // caller observes completion (and possibly closes it).
+          return coalescing.flush()
+            .then([]() -> process::ControlFlow<Nothing> {
+              return process::Break();
+            });
         }
 
         // This could happen if there is a de-serialization error.
@@ -133,7 +325,7 @@ process::Future<Nothing> transform(
 
         // TODO(vinod): Instead of detecting that the reader went away only
         // after attempting a write, leverage `writer.readerClosed` future.
-        if (!writer.write(func(record.get()))) {
+        if (!coalescing.write(func(record.get()))) {
           return process::Failure("Write failed to the pipe");
         }
 
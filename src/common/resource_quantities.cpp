@@ -73,9 +73,11 @@ Try<ResourceQuantities> ResourceQuantities::fromString(const string& text)
 
 ResourceQuantities::ResourceQuantities()
 {
-  // Pre-reserve space for first-class resources.
-  // [cpus, disk, gpus, mem, ports]
-  quantities.reserve(5u);
+  // NOTE: The capacity for first-class resources is reserved lazily
+  // upon the first insertion (see `operator[]`). Reserving it here
+  // would force a heap allocation for every instance, including the
+  // many that are default constructed and never filled (e.g. in the
+  // allocator's innermost loops).
 }
 
 
@@ -128,6 +130,15 @@ Value::Scalar& ResourceQuantities::operator[](const string& name)
     }
   }
 
+  if (quantities.empty()) {
+    // Pre-reserve space for first-class resources.
+    // [cpus, disk, gpus, mem, ports]
+    quantities.reserve(5u);
+
+    // `reserve()` invalidates iterators.
+    it = quantities.begin();
+  }
+
   it = quantities.insert(it, std::make_pair(name, Value::Scalar()));
 
   return it->second;
@@ -16,6 +16,8 @@
 
 #include <stdint.h>
 
+#include <algorithm>
+#include <mutex>
 #include <ostream>
 #include <set>
 #include <string>
@@ -32,10 +34,12 @@
 
 #include <stout/foreach.hpp>
 #include <stout/hashmap.hpp>
+#include <stout/hashset.hpp>
 #include <stout/json.hpp>
 #include <stout/lambda.hpp>
 #include <stout/protobuf.hpp>
 #include <stout/strings.hpp>
+#include <stout/synchronized.hpp>
 #include <stout/unreachable.hpp>
 
 #include "common/resource_quantities.hpp"
@@ -587,6 +591,56 @@ static bool contains(const Resource& left, const Resource& right)
 }
 
 
+// Returns a key with the property that two resources which are
+// addable or subtractable necessarily have equal keys. The converse
+// does NOT hold (e.g. two identical MOUNT disks are never addable),
+// so equal keys only designate merge candidates which still need to
+// be checked with `addable()` / `subtractable()`. This lets bulk
+// arithmetic bucket the resource objects by key and probe only the
+// candidates instead of scanning every object.
+static string mergeKey(const Resource& resource)
+{
+  string key = resource.name();
+
+  key += ';';
+  key += stringify(resource.type());
+
+  if (resource.has_allocation_info() &&
+      resource.allocation_info().has_role()) {
+    key += ";alloc:";
+    key += resource.allocation_info().role();
+  }
+
+  // Equal reservation stacks have equal role sequences, so the
+  // roles suffice here; the full `ReservationInfo` comparison is
+  // left to `addable()` / `subtractable()`.
+  foreach (const Resource::ReservationInfo& reservation,
+           resource.reservations()) {
+    key += ";resv:";
+    key += reservation.role();
+  }
+
+  if (resource.has_disk()) {
+    key += ";disk";
+  }
+
+  if (resource.has_revocable()) {
+    key += ";revocable";
+  }
+
+  if (resource.has_shared()) {
+    key += ";shared";
+  }
+
+  if (resource.has_provider_id()) {
+    key += ";provider:";
+    key += resource.provider_id().value();
+  }
+
+  return key;
+}
+
+
 /**
  * Checks that a Resources object is valid for command line specification.
  *
@@ -1146,6 +1200,36 @@ Option<Error> Resources::validate(const Resource& resource)
 
 Option<Error> Resources::validate(const RepeatedPtrField<Resource>& resources)
 {
+  // Byte-identical resource vectors (e.g. the resources of every
+  // task of a long-lived framework) arrive on the master's task
+  // launch path over and over, so we remember the serialized form of
+  // vectors that validated successfully and skip re-validating them.
+  // Only successes are cached: errors are rare and their messages
+  // depend on the offending resource. The cache is bounded so that
+  // high cardinality inputs cannot grow it without bound.
+  static const size_t limit = 10000;
+
+  // NOTE: Intentionally leaked to sidestep static destruction
+  // order issues at process teardown.
+  static std::mutex* mutex = new std::mutex();
+  static hashset<string>* validated = new hashset<string>();
+
+  // Each element is length-prefixed to keep the key unambiguous:
+  // plain concatenation could not distinguish the boundaries
+  // between the serialized messages.
+  string key;
+  foreach (const Resource& resource, resources) {
+    key += stringify(resource.ByteSize());
+    key += ':';
+    resource.AppendToString(&key);
+  }
+
+  synchronized (mutex) {
+    if (validated->contains(key)) {
+      return None();
+    }
+  }
+
   foreach (const Resource& resource, resources) {
     Option<Error> error = validate(resource);
     if (error.isSome()) {
@@ -1155,6 +1239,12 @@ Option<Error> Resources::validate(const RepeatedPtrField<Resource>& resources)
     }
   }
 
+  synchronized (mutex) {
+    if (validated->size() < limit) {
+      validated->insert(std::move(key));
+    }
+  }
+
   return None();
 }
 
@@ -2100,6 +2190,7 @@ Option<Resources> Resources::find(const Resource& target) const
 Resources::operator RepeatedPtrField<Resource>() const
 {
   RepeatedPtrField<Resource> all;
+  all.Reserve(static_cast<int>(size()));
   foreach (
       const Resource_Unsafe& resource_,
       resourcesNoMutationWithoutExclusiveOwnership) {
@@ -2186,6 +2277,44 @@ Resources Resources::operator+(Resources&& that) &&
 }
 
 
+Resources::Resource_Unsafe Resources::intern(const Resource_& resource_)
+{
+  // Shared resources carry a mutable counter and must not be interned.
+  CHECK(!resource_.isShared());
+
+  // The table is bounded so that workloads with high cardinality
+  // resource metadata (e.g. a unique volume ID per task) cannot grow
+  // it without bound. Entries are retained for the lifetime of the
+  // process; the retained reference also guarantees that an interned
+  // object's use count never drops to 1, which is what keeps the
+  // copy-on-write mutation paths from ever touching it in place.
+  static const size_t limit = 10000;
+
+  // NOTE: Intentionally leaked to sidestep static destruction
+  // order issues at process teardown.
+  static std::mutex* mutex = new std::mutex();
+  static hashmap<string, Resource_Unsafe>* table =
+    new hashmap<string, Resource_Unsafe>();
+
+  const string key = resource_.resource.SerializeAsString();
+
+  synchronized (mutex) {
+    Option<Resource_Unsafe> interned = table->get(key);
+    if (interned.isSome()) {
+      return interned.get();
+    }
+
+    Resource_Unsafe entry = make_shared<Resource_>(resource_);
+
+    if (table->size() < limit) {
+      table->put(key, entry);
+    }
+
+    return entry;
+  }
+}
+
+
 void Resources::add(const Resource_& that)
 {
   if (that.isEmpty()) {
@@ -2208,10 +2337,20 @@ void Resources::add(const Resource_& that)
     }
   }
 
-  // Cannot be combined with any existing Resource object.
+  // Cannot be combined with any existing Resource object, so a new
+  // one is inserted. Non-shared resources are interned: identical
+  // Resource protobufs recur across agents, frameworks and roles, so
+  // rather than giving each `Resources` its own copy we share one
+  // process-wide instance. The copy-on-write logic above keeps this
+  // safe: an interned object is never exclusively owned and hence is
+  // never mutated in place.
   if (!found) {
-    resourcesNoMutationWithoutExclusiveOwnership.push_back(
-        make_shared<Resource_>(that));
+    if (that.isShared()) {
+      resourcesNoMutationWithoutExclusiveOwnership.push_back(
+          make_shared<Resource_>(that));
+    } else {
+      resourcesNoMutationWithoutExclusiveOwnership.push_back(intern(that));
+    }
   }
 }
 
@@ -2240,10 +2379,15 @@ void Resources::add(Resource_&& that)
     }
   }
 
-  // Cannot be combined with any existing Resource object.
+  // Cannot be combined with any existing Resource object. See the
+  // comment in the copying `add()` above regarding interning.
   if (!found) {
-    resourcesNoMutationWithoutExclusiveOwnership.push_back(
-        make_shared<Resource_>(std::move(that)));
+    if (that.isShared()) {
+      resourcesNoMutationWithoutExclusiveOwnership.push_back(
+          make_shared<Resource_>(std::move(that)));
+    } else {
+      resourcesNoMutationWithoutExclusiveOwnership.push_back(intern(that));
+    }
   }
 }
 
@@ -2315,10 +2459,72 @@ Resources& Resources::operator+=(Resource&& that)
 
 Resources& Resources::operator+=(const Resources& that)
 {
+  // Adding each resource object with `add()` scans the whole vector
+  // looking for a merge target, which makes bulk addition quadratic
+  // in the number of resource objects (e.g. when summing the
+  // allocations of many roles in the allocator). For large enough
+  // operands we instead index the objects by their merge key and
+  // probe only the candidate buckets.
+  static const size_t threshold = 32;
+
+  if (size() < threshold || that.size() < threshold) {
+    foreach (
+        const Resource_Unsafe& resource_,
+        that.resourcesNoMutationWithoutExclusiveOwnership) {
+      add(resource_);
+    }
+
+    return *this;
+  }
+
+  // Maps the merge key of each of our resource objects to its
+  // position in the vector.
+  hashmap<string, vector<size_t>> index;
+
+  for (size_t i = 0;
+       i < resourcesNoMutationWithoutExclusiveOwnership.size();
+       i++) {
+    index[internal::mergeKey(
+        resourcesNoMutationWithoutExclusiveOwnership[i]->resource)]
+      .push_back(i);
+  }
+
   foreach (
-      const Resource_Unsafe& resource_,
+      const Resource_Unsafe& that_,
       that.resourcesNoMutationWithoutExclusiveOwnership) {
-    add(resource_);
+    if (that_->isEmpty()) {
+      continue;
+    }
+
+    const string key = internal::mergeKey(that_->resource);
+
+    bool found = false;
+    auto bucket = index.find(key);
+
+    if (bucket != index.end()) {
+      foreach (size_t i, bucket->second) {
+        Resource_Unsafe& resource_ =
+          resourcesNoMutationWithoutExclusiveOwnership[i];
+
+        if (internal::addable(resource_->resource, that_->resource)) {
+          // Copy-on-write (if more than 1 reference).
+          if (resource_.use_count() > 1) {
+            resource_ = make_shared<Resource_>(*resource_);
+          }
+
+          *resource_ += *that_;
+          found = true;
+          break;
+        }
+      }
+    }
+
+    // Cannot be combined with any existing Resource object.
+    if (!found) {
+      resourcesNoMutationWithoutExclusiveOwnership.push_back(that_);
+      index[key].push_back(
+          resourcesNoMutationWithoutExclusiveOwnership.size() - 1);
+    }
   }
 
   return *this;
@@ -2327,13 +2533,10 @@ Resources& Resources::operator+=(const Resources& that)
 
 Resources& Resources::operator+=(Resources&& that)
 {
-  foreach (
-      const Resource_Unsafe& resource_,
-      that.resourcesNoMutationWithoutExclusiveOwnership) {
-    add(std::move(resource_));
-  }
-
-  return *this;
+  // The resource objects are refcounted pointers, so adding them by
+  // copy only costs reference count bumps; forward to the copying
+  // version to pick up its indexed bulk path.
+  return *this += that;
 }
 
 
@@ -2421,10 +2624,92 @@ Resources& Resources::operator-=(const Resource& that)
 
 Resources& Resources::operator-=(const Resources& that)
 {
+  // See the comment in `operator+=(const Resources&)` regarding
+  // indexed bulk arithmetic.
+  static const size_t threshold = 32;
+
+  if (size() < threshold || that.size() < threshold) {
+    foreach (
+        const Resource_Unsafe& resource_,
+        that.resourcesNoMutationWithoutExclusiveOwnership) {
+      subtract(*resource_);
+    }
+
+    return *this;
+  }
+
+  // Maps the merge key of each of our resource objects to its
+  // position in the vector.
+  hashmap<string, vector<size_t>> index;
+
+  for (size_t i = 0;
+       i < resourcesNoMutationWithoutExclusiveOwnership.size();
+       i++) {
+    index[internal::mergeKey(
+        resourcesNoMutationWithoutExclusiveOwnership[i]->resource)]
+      .push_back(i);
+  }
+
   foreach (
-      const Resource_Unsafe& resource_,
+      const Resource_Unsafe& that_,
       that.resourcesNoMutationWithoutExclusiveOwnership) {
-    subtract(*resource_);
+    if (that_->isEmpty()) {
+      continue;
+    }
+
+    auto bucket = index.find(internal::mergeKey(that_->resource));
+
+    if (bucket == index.end()) {
+      continue;
+    }
+
+    foreach (size_t i, bucket->second) {
+      Resource_Unsafe& resource_ =
+        resourcesNoMutationWithoutExclusiveOwnership[i];
+
+      if (internal::subtractable(resource_->resource, that_->resource)) {
+        // Copy-on-write (if more than 1 reference).
+        if (resource_.use_count() > 1) {
+          resource_ = make_shared<Resource_>(*resource_);
+        }
+
+        *resource_ -= *that_;
+
+        // Remove the resource if it has become negative or empty,
+        // following the same semantics as `subtract()`.
+        bool negative =
+          (resource_->isShared() && resource_->sharedCount.get() < 0) ||
+          (resource_->resource.type() == Value::SCALAR &&
+           resource_->resource.scalar().value() < 0);
+
+        if (negative || resource_->isEmpty()) {
+          // Swap with the last element and shrink the vector by one
+          // (as in `subtract()`), fixing up the index entries of the
+          // removed element and of the element that moved into its
+          // slot.
+          const size_t last =
+            resourcesNoMutationWithoutExclusiveOwnership.size() - 1;
+
+          vector<size_t>& candidates = bucket->second;
+          candidates.erase(
+              std::find(candidates.begin(), candidates.end(), i));
+
+          if (i != last) {
+            resourcesNoMutationWithoutExclusiveOwnership[i] =
+              resourcesNoMutationWithoutExclusiveOwnership.back();
+
+            vector<size_t>& moved = index[internal::mergeKey(
+                resourcesNoMutationWithoutExclusiveOwnership[i]->resource)];
+
+            *std::find(moved.begin(), moved.end(), last) = i;
+          }
+
+          resourcesNoMutationWithoutExclusiveOwnership.pop_back();
+        }
+
+        break;
+      }
+    }
   }
 
   return *this;
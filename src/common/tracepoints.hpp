@@ -0,0 +1,59 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __COMMON_TRACEPOINTS_HPP__
+#define __COMMON_TRACEPOINTS_HPP__
+
+// Statically defined tracepoints (USDT probes) for the "mesos"
+// provider. These give tools like bpftrace, perf and SystemTap a
+// stable set of attach points on master and agent hot paths, so
+// operators do not have to chase mangled C++ symbols across releases.
+//
+// When <sys/sdt.h> is available the probes are compiled in
+// unconditionally: a disabled probe is a single `nop` instruction,
+// so there is no cost unless a tracer attaches. On platforms without
+// <sys/sdt.h> the macros expand to nothing.
+//
+// Probe arguments must be scalars or pointers; pass strings as
+// `c_str()` pointers and read them from the tracer with a string
+// helper (e.g. `str()` in bpftrace).
+
+#ifdef HAVE_SYS_SDT_H
+
+#include <sys/sdt.h>
+
+#define MESOS_TRACEPOINT(name) \
+  DTRACE_PROBE(mesos, name)
+
+#define MESOS_TRACEPOINT1(name, arg1) \
+  DTRACE_PROBE1(mesos, name, arg1)
+
+#define MESOS_TRACEPOINT2(name, arg1, arg2) \
+  DTRACE_PROBE2(mesos, name, arg1, arg2)
+
+#define MESOS_TRACEPOINT3(name, arg1, arg2, arg3) \
+  DTRACE_PROBE3(mesos, name, arg1, arg2, arg3)
+
+#else // HAVE_SYS_SDT_H
+
+#define MESOS_TRACEPOINT(name)
+#define MESOS_TRACEPOINT1(name, arg1)
+#define MESOS_TRACEPOINT2(name, arg1, arg2)
+#define MESOS_TRACEPOINT3(name, arg1, arg2, arg3)
+
+#endif // HAVE_SYS_SDT_H
+
+#endif // __COMMON_TRACEPOINTS_HPP__
@@ -508,6 +508,67 @@ Option<Error> validateCheckStatusInfo(const CheckStatusInfo& checkStatusInfo)
   return None();
 }
 
+// Validates a single status update carried by an UPDATE or
+// UPDATE_BATCH executor call.
+static Option<Error> validateExecutorCallUpdate(
+    const mesos::executor::Call& call,
+    const mesos::executor::Call::Update& update)
+{
+  const TaskStatus& status = update.status();
+
+  if (!status.has_uuid()) {
+    return Error("Expecting 'uuid' to be present");
+  }
+
+  Try<id::UUID> uuid = id::UUID::fromBytes(status.uuid());
+  if (uuid.isError()) {
+    return uuid.error();
+  }
+
+  if (status.has_executor_id() &&
+      status.executor_id().value()
+      != call.executor_id().value()) {
+    return Error("ExecutorID in Call: " +
+                 call.executor_id().value() +
+                 " does not match ExecutorID in TaskStatus: " +
+                 update.status().executor_id().value()
+                 );
+  }
+
+  if (status.source() != TaskStatus::SOURCE_EXECUTOR) {
+    return Error("Received Call from executor " +
+                 call.executor_id().value() +
+                 " of framework " +
+                 call.framework_id().value() +
+                 " with invalid source, expecting 'SOURCE_EXECUTOR'"
+                 );
+  }
+
+  if (status.state() == TASK_STAGING) {
+    return Error("Received TASK_STAGING from executor " +
+                 call.executor_id().value() +
+                 " of framework " +
+                 call.framework_id().value() +
+                 " which is not allowed"
+                 );
+  }
+
+  // TODO(alexr): Validate `check_status` is present if
+  // the corresponding `TaskInfo.check` has been defined.
+
+  if (status.has_check_status()) {
+    Option<Error> validate =
+      common::validation::validateCheckStatusInfo(status.check_status());
+
+    if (validate.isSome()) {
+      return validate.get();
+    }
+  }
+
+  return None();
+}
+
+
 Option<Error> validateExecutorCall(const mesos::executor::Call& call)
 {
   if (!call.IsInitialized()) {
@@ -541,54 +602,19 @@ Option<Error> validateExecutorCall(const mesos::executor::Call& call)
         return Error("Expecting 'update' to be present");
       }
 
-      const TaskStatus& status = call.update().status();
-
-      if (!status.has_uuid()) {
-        return Error("Expecting 'uuid' to be present");
-      }
-
-      Try<id::UUID> uuid = id::UUID::fromBytes(status.uuid());
-      if (uuid.isError()) {
-        return uuid.error();
-      }
-
-      if (status.has_executor_id() &&
-          status.executor_id().value()
-          != call.executor_id().value()) {
-        return Error("ExecutorID in Call: " +
-                     call.executor_id().value() +
-                     " does not match ExecutorID in TaskStatus: " +
-                     call.update().status().executor_id().value()
-                     );
-      }
-
-      if (status.source() != TaskStatus::SOURCE_EXECUTOR) {
-        return Error("Received Call from executor " +
-                     call.executor_id().value() +
-                     " of framework " +
-                     call.framework_id().value() +
-                     " with invalid source, expecting 'SOURCE_EXECUTOR'"
-                     );
-      }
+      return validateExecutorCallUpdate(call, call.update());
+    }
 
-      if (status.state() == TASK_STAGING) {
-        return Error("Received TASK_STAGING from executor " +
-                     call.executor_id().value() +
-                     " of framework " +
-                     call.framework_id().value() +
-                     " which is not allowed"
-                     );
+    case mesos::executor::Call::UPDATE_BATCH: {
+      if (!call.has_update_batch()) {
+        return Error("Expecting 'update_batch' to be present");
       }
 
-      // TODO(alexr): Validate `check_status` is present if
-      // the corresponding `TaskInfo.check` has been defined.
-
-      if (status.has_check_status()) {
-        Option<Error> validate =
-          common::validation::validateCheckStatusInfo(status.check_status());
-
-        if (validate.isSome()) {
-          return validate.get();
+      foreach (const mesos::executor::Call::Update& update,
+               call.update_batch().updates()) {
+        Option<Error> error = validateExecutorCallUpdate(call, update);
+        if (error.isSome()) {
+          return error;
         }
       }
 
@@ -400,27 +400,21 @@ bool operator==(const Value::Ranges& _left, const Value::Ranges& _right)
   Value::Ranges right;
   coalesce(&right, {_right});
 
-  if (left.range_size() == right.range_size()) {
-    for (int i = 0; i < left.range_size(); i++) {
-      // Make sure this range is equal to a range in the right.
-      bool found = false;
-      for (int j = 0; j < right.range_size(); j++) {
-        if (left.range(i).begin() == right.range(j).begin() &&
-            left.range(i).end() == right.range(j).end()) {
-          found = true;
-          break;
-        }
-      }
+  if (left.range_size() != right.range_size()) {
+    return false;
+  }
 
-      if (!found) {
-        return false;
-      }
+  // Coalesced ranges are sorted and disjoint, so equal range sets
+  // have identical representations and a single pairwise walk
+  // suffices (rather than searching the right side for each range).
+  for (int i = 0; i < left.range_size(); i++) {
+    if (left.range(i).begin() != right.range(i).begin() ||
+        left.range(i).end() != right.range(i).end()) {
+      return false;
     }
-
-    return true;
   }
 
-  return false;
+  return true;
 }
 
 
@@ -432,17 +426,21 @@ bool operator<=(const Value::Ranges& _left, const Value::Ranges& _right)
   Value::Ranges right;
   coalesce(&right, {_right});
 
+  // Coalesced ranges are sorted and disjoint, so each range on the
+  // left must be contained in a single range on the right, and the
+  // containing ranges appear in the same order. We advance a cursor
+  // over the right side instead of rescanning it for every range on
+  // the left.
+  int j = 0;
   for (int i = 0; i < left.range_size(); i++) {
-    // Make sure this range is a subset of a range in right.
-    bool matched = false;
-    for (int j = 0; j < right.range_size(); j++) {
-      if (left.range(i).begin() >= right.range(j).begin() &&
-          left.range(i).end() <= right.range(j).end()) {
-        matched = true;
-        break;
-      }
+    while (j < right.range_size() &&
+           right.range(j).end() < left.range(i).begin()) {
+      j++;
     }
-    if (!matched) {
+
+    if (j == right.range_size() ||
+        left.range(i).begin() < right.range(j).begin() ||
+        left.range(i).end() > right.range(j).end()) {
       return false;
     }
   }
@@ -469,6 +467,13 @@ Value::Ranges operator-(const Value::Ranges& left, const Value::Ranges& right)
 // TODO(mzhu): Make this consistent with how we do subtraction.
 Value::Ranges& operator+=(Value::Ranges& left, const Value::Ranges& right)
 {
+  // Adding an empty set of ranges cannot change the value, so we
+  // skip the re-coalescing pass. Ranges values are kept coalesced
+  // by parsing and arithmetic, so no normalization is lost here.
+  if (right.range_size() == 0) {
+    return left;
+  }
+
   coalesce(&left, {right});
   return left;
 }
@@ -671,18 +676,18 @@ Try<Value> parse(const string& text)
     // This is a Value::Ranges.
     value.set_type(Value::RANGES);
     Value::Ranges* ranges = value.mutable_ranges();
-    const vector<string> tokens = strings::tokenize(temp, "[]-,\n");
+    const vector<strings::View> tokens = strings::tokenizeView(temp, "[]-,\n");
     if (tokens.size() % 2 != 0) {
       return Error("Expecting one or more \"ranges\"");
     } else {
       for (size_t i = 0; i < tokens.size(); i += 2) {
         Value::Range* range = ranges->add_range();
 
-        Try<uint64_t> begin = numify<uint64_t>(tokens[i]);
-        Try<uint64_t> end = numify<uint64_t>(tokens[i + 1]);
+        Try<uint64_t> begin = numify<uint64_t>(tokens[i].str());
+        Try<uint64_t> end = numify<uint64_t>(tokens[i + 1].str());
         if (begin.isError() || end.isError()) {
           return Error(
-              "Expecting non-negative integers in '" + tokens[i] + "'");
+              "Expecting non-negative integers in '" + tokens[i].str() + "'");
         }
 
         range->set_begin(begin.get());
@@ -699,9 +704,11 @@ Try<Value> parse(const string& text)
       // This is a set.
       value.set_type(Value::SET);
       Value::Set* set = value.mutable_set();
-      const vector<string> tokens = strings::tokenize(temp, "{},\n");
+      // NOTE: Tokenizing with views lets each item be added to the
+      // protobuf directly, without an intermediate copy.
+      const vector<strings::View> tokens = strings::tokenizeView(temp, "{},\n");
       for (size_t i = 0; i < tokens.size(); i++) {
-        set->add_item(tokens[i]);
+        set->add_item(tokens[i].data(), tokens[i].size());
       }
       return value;
     } else if (index == string::npos) {
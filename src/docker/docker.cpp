@@ -38,8 +38,13 @@
 #include <stout/os/windows/jobobject.hpp>
 #endif // __WINDOWS__
 
+#ifndef __WINDOWS__
+#include <process/address.hpp>
+#endif // __WINDOWS__
+
 #include <process/check.hpp>
 #include <process/collect.hpp>
+#include <process/http.hpp>
 #include <process/io.hpp>
 
 #ifdef __WINDOWS__
@@ -73,6 +78,10 @@ using std::vector;
 
 using mesos::internal::ContainerDNSInfo;
 
+#ifndef __WINDOWS__
+namespace unix = process::network::unix;
+#endif // __WINDOWS__
+
 
 template <typename T>
 static Future<T> failure(
@@ -283,21 +292,32 @@ Try<Nothing> Docker::validateVersion(const Version& minVersion) const
 // TODO(josephw): Parse this string with a protobuf.
 Try<Docker::Container> Docker::Container::create(const string& output)
 {
-  Try<JSON::Array> parse = JSON::parse<JSON::Array>(output);
+  Try<JSON::Value> parse = JSON::parse(output);
   if (parse.isError()) {
     return Error("Failed to parse JSON: " + parse.error());
   }
 
-  // TODO(benh): Handle the case where the short container ID was
-  // not sufficiently unique and 'array.values.size() > 1'.
-  JSON::Array array = parse.get();
-  if (array.values.size() != 1) {
-    return Error("Failed to find container");
-  }
+  JSON::Object json;
 
-  CHECK(array.values.front().is<JSON::Object>());
+  // The CLI prints an array of containers while the daemon's
+  // '/containers/<name>/json' endpoint returns the container
+  // object directly; accept both.
+  if (parse->is<JSON::Array>()) {
+    // TODO(benh): Handle the case where the short container ID was
+    // not sufficiently unique and 'array.values.size() > 1'.
+    JSON::Array array = parse->as<JSON::Array>();
+    if (array.values.size() != 1) {
+      return Error("Failed to find container");
+    }
 
-  JSON::Object json = array.values.front().as<JSON::Object>();
+    CHECK(array.values.front().is<JSON::Object>());
+
+    json = array.values.front().as<JSON::Object>();
+  } else if (parse->is<JSON::Object>()) {
+    json = parse->as<JSON::Object>();
+  } else {
+    return Error("Failed to find container");
+  }
 
   Result<JSON::String> idValue = json.find<JSON::String>("Id");
   if (idValue.isNone()) {
@@ -1349,6 +1369,22 @@ Future<Docker::Container> Docker::inspect(
 {
   Owned<Promise<Docker::Container>> promise(new Promise<Docker::Container>());
 
+#ifndef __WINDOWS__
+  // Talk to the Docker daemon directly over its unix socket rather
+  // than forking the CLI: the containerizer polls 'inspect' to track
+  // container state, and an HTTP round trip is far cheaper than a
+  // fork/exec of the docker client for every poll.
+  if (strings::startsWith(socket, DEFAULT_DOCKER_HOST_PREFIX)) {
+    const string socketPath =
+      strings::remove(socket, DEFAULT_DOCKER_HOST_PREFIX, strings::PREFIX);
+
+    httpInspect(socketPath, containerName, promise, retryInterval);
+
+    return promise->future()
+      .onDiscard([promise]() { promise->discard(); });
+  }
+#endif // __WINDOWS__
+
   // Holds a callback used for cleanup in case this call to 'docker inspect' is
   // discarded, and a mutex to control access to the callback.
   auto callback = std::make_shared<pair<lambda::function<void()>, mutex>>();
@@ -1524,6 +1560,108 @@ void Docker::___inspect(
 }
 
 
+#ifndef __WINDOWS__
+void Docker::httpInspect(
+    const string& socketPath,
+    const string& containerName,
+    const Owned<Promise<Docker::Container>>& promise,
+    const Option<Duration>& retryInterval)
+{
+  if (promise->future().hasDiscard()) {
+    promise->discard();
+    return;
+  }
+
+  Try<unix::Address> address = unix::Address::create(socketPath);
+  if (address.isError()) {
+    promise->fail(
+        "Failed to create address from '" + socketPath + "': " +
+        address.error());
+    return;
+  }
+
+  VLOG(1) << "Inspecting container '" << containerName
+          << "' via '" << socketPath << "'";
+
+  http::connect(address.get(), http::Scheme::HTTP)
+    .then([containerName](http::Connection connection) {
+      http::Request request;
+      request.method = "GET";
+      request.url.domain = "";
+      request.url.path = "/containers/" + containerName + "/json";
+
+      // This is a non Keep-Alive request which means the connection
+      // will be closed when the response is received. Since the
+      // 'Connection' is reference-counted, we must maintain a copy
+      // until the disconnection occurs.
+      connection.disconnected()
+        .onAny([connection]() {});
+
+      return connection.send(request);
+    })
+    .onAny([=](const Future<http::Response>& response) {
+      _httpInspect(socketPath, containerName, promise, retryInterval, response);
+    });
+}
+
+
+void Docker::_httpInspect(
+    const string& socketPath,
+    const string& containerName,
+    const Owned<Promise<Docker::Container>>& promise,
+    const Option<Duration>& retryInterval,
+    const Future<http::Response>& response)
+{
+  if (promise->future().hasDiscard()) {
+    promise->discard();
+    return;
+  }
+
+  // Treat a failed connection (e.g., the daemon is restarting) or a
+  // non-OK response (e.g., the container has not been created yet)
+  // like a non-zero exit status of the CLI: retry if an interval was
+  // given, fail otherwise.
+  if (!response.isReady() || response->code != http::Status::OK) {
+    if (retryInterval.isSome()) {
+      VLOG(1) << "Retrying inspect of container '" << containerName
+              << "', interval: " << stringify(retryInterval.get());
+      Clock::timer(retryInterval.get(), [=]() {
+        httpInspect(socketPath, containerName, promise, retryInterval);
+      });
+      return;
+    }
+
+    promise->fail(
+        "Failed to inspect container '" + containerName + "': " +
+        (response.isReady()
+           ? response->status
+           : (response.isFailed() ? response.failure() : "future discarded")));
+    return;
+  }
+
+  Try<Docker::Container> container =
+    Docker::Container::create(response->body);
+
+  if (container.isError()) {
+    promise->fail("Unable to create container: " + container.error());
+    return;
+  }
+
+  if (retryInterval.isSome() && !container->started) {
+    VLOG(1) << "Retrying inspect since container '" << containerName
+            << "' not yet started, interval: "
+            << stringify(retryInterval.get());
+    Clock::timer(retryInterval.get(), [=]() {
+      httpInspect(socketPath, containerName, promise, retryInterval);
+    });
+    return;
+  }
+
+  promise->set(container.get());
+}
+#endif // __WINDOWS__
+
+
 Future<vector<Docker::Container>> Docker::ps(
     bool all,
     const Option<string>& prefix) const
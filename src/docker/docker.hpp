@@ -24,6 +24,7 @@
 #include <vector>
 
 #include <process/future.hpp>
+#include <process/http.hpp>
 #include <process/owned.hpp>
 #include <process/subprocess.hpp>
 
@@ -368,6 +369,24 @@ private:
       std::shared_ptr<std::pair<lambda::function<void()>, std::mutex>>
         callback);
 
+#ifndef __WINDOWS__
+  // Inspects a container by talking to the Docker daemon directly
+  // over its unix socket instead of forking the CLI. Mirrors the
+  // retry semantics of '_inspect()' above.
+  static void httpInspect(
+      const std::string& socketPath,
+      const std::string& containerName,
+      const process::Owned<process::Promise<Container>>& promise,
+      const Option<Duration>& retryInterval);
+
+  static void _httpInspect(
+      const std::string& socketPath,
+      const std::string& containerName,
+      const process::Owned<process::Promise<Container>>& promise,
+      const Option<Duration>& retryInterval,
+      const process::Future<process::http::Response>& response);
+#endif // __WINDOWS__
+
   static process::Future<std::vector<Container>> _ps(
       const Docker& docker,
       const std::string& cmd,
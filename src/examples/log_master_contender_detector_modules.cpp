@@ -0,0 +1,90 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <glog/logging.h>
+
+#include <mesos/mesos.hpp>
+#include <mesos/module.hpp>
+
+#include <mesos/master/contender.hpp>
+#include <mesos/master/detector.hpp>
+
+#include <mesos/module/contender.hpp>
+#include <mesos/module/detector.hpp>
+
+#include <stout/try.hpp>
+
+#include "master/contender/log.hpp"
+
+#include "master/detector/log.hpp"
+
+using namespace mesos;
+using namespace mesos::master;
+
+using mesos::master::contender::LogMasterContender;
+using mesos::master::contender::MasterContender;
+
+using mesos::master::detector::LogMasterDetector;
+using mesos::master::detector::MasterDetector;
+
+// Declares a MasterContender module named
+// 'org_apache_mesos_LogMasterContender' that elects through the
+// replicated log quorum; see master/contender/log.hpp for the
+// supported parameters.
+mesos::modules::Module<MasterContender> org_apache_mesos_LogMasterContender(
+    MESOS_MODULE_API_VERSION,
+    MESOS_VERSION,
+    "Apache Mesos",
+    "modules@mesos.apache.org",
+    "Replicated-log-based MasterContender module.",
+    nullptr,
+    [](const Parameters& parameters) -> MasterContender* {
+      Try<LogMasterContender*> contender =
+        LogMasterContender::create(parameters);
+
+      if (contender.isError()) {
+        LOG(ERROR) << "Failed to create the log master contender: "
+                   << contender.error();
+        return nullptr;
+      }
+
+      return contender.get();
+    });
+
+
+// Declares a MasterDetector module named
+// 'org_apache_mesos_LogMasterDetector', the counterpart of the
+// contender module above; see master/detector/log.hpp for the
+// supported parameters.
+mesos::modules::Module<MasterDetector> org_apache_mesos_LogMasterDetector(
+    MESOS_MODULE_API_VERSION,
+    MESOS_VERSION,
+    "Apache Mesos",
+    "modules@mesos.apache.org",
+    "Replicated-log-based MasterDetector module.",
+    nullptr,
+    [](const Parameters& parameters) -> MasterDetector* {
+      Try<LogMasterDetector*> detector =
+        LogMasterDetector::create(parameters);
+
+      if (detector.isError()) {
+        LOG(ERROR) << "Failed to create the log master detector: "
+                   << detector.error();
+        return nullptr;
+      }
+
+      return detector.get();
+    });
@@ -20,6 +20,7 @@
 #include <mesos/v1/executor.hpp>
 #include <mesos/v1/mesos.hpp>
 
+#include <process/address.hpp>
 #include <process/async.hpp>
 #include <process/clock.hpp>
 #include <process/delay.hpp>
@@ -60,6 +61,7 @@ using namespace mesos::internal;
 using std::ostream;
 using std::queue;
 using std::string;
+using std::vector;
 
 using mesos::internal::recordio::Reader;
 
@@ -159,7 +161,8 @@ public:
     : ProcessBase(generate("executor")),
       state(DISCONNECTED),
       contentType(_contentType),
-      callbacks {connected, disconnected, received}
+      callbacks {connected, disconnected, received},
+      updating(false)
   {
     GOOGLE_PROTOBUF_VERIFY_VERSION;
 
@@ -234,6 +237,22 @@ public:
         upid.id +
         "/api/v1/executor");
 
+#ifndef __WINDOWS__
+    // Prefer the agent's domain socket when one is advertised; this
+    // keeps node-local executor traffic off the TCP stack.
+    value = env.get("MESOS_DOMAIN_SOCKET");
+    if (value.isSome()) {
+      Try<process::network::unix::Address> address =
+        process::network::unix::Address::create(value.get());
+
+      CHECK_SOME(address)
+        << "Failed to parse MESOS_DOMAIN_SOCKET '" << value.get()
+        << "': " << address.error();
+
+      domainSocket = address.get();
+    }
+#endif // __WINDOWS__
+
     value = env.get("MESOS_EXECUTOR_AUTHENTICATION_TOKEN");
     if (value.isSome()) {
       authenticationToken = value.get();
@@ -320,6 +339,32 @@ public:
       return;
     }
 
+    // Queue status updates while a previous update request is in
+    // flight, and flush the queue (batched into a single UPDATE_BATCH
+    // call when several updates accumulated) once it completes; see
+    // `_send()`. A burst of updates (e.g., many short lived tasks
+    // terminating at once) then travels to the agent in one request
+    // instead of one request round trip per update.
+    if (call.type() == Call::UPDATE) {
+      updates.push_back(call);
+
+      if (updating) {
+        return;
+      }
+
+      Option<Call> flushed = flushUpdates();
+      CHECK_SOME(flushed);
+
+      updating = true;
+      post(flushed.get());
+      return;
+    }
+
+    post(call);
+  }
+
+  void post(const Call& call)
+  {
     VLOG(1) << "Sending " << call.type() << " call to " << agent;
 
     ::Request request;
@@ -378,12 +423,28 @@ protected:
     // second `http::connect()` gets called.
     id::UUID connectionId_ = connectionId.get();
 
+    // Lambda for connecting to the agent, over the domain socket if
+    // one was advertised and over TCP otherwise. Note that requests
+    // over the domain socket are always plain HTTP: the transport is
+    // node local, so there is nothing for TLS to protect.
+    auto connect_ = [this]() {
+#ifndef __WINDOWS__
+      if (domainSocket.isSome()) {
+        return process::http::connect(
+            domainSocket.get(),
+            process::http::Scheme::HTTP);
+      }
+#endif // __WINDOWS__
+
+      return process::http::connect(agent);
+    };
+
     // We create two persistent connections here, one for subscribe
     // call/streaming response and another for non-subscribe calls/responses.
-    process::http::connect(agent)
-      .onAny(defer(self(), [this, connectionId_](
+    connect_()
+      .onAny(defer(self(), [this, connectionId_, connect_](
                                const Future<Connection>& connection) {
-        process::http::connect(agent)
+        connect_()
           .onAny(defer(self(),
                        &Self::connected,
                        connectionId_,
@@ -581,6 +642,11 @@ protected:
     connections = None();
     connectionId = None();
     subscribed = None();
+
+    // Drop any queued updates; executors resend unacknowledged
+    // updates when they resubscribe.
+    updating = false;
+    updates.clear();
   }
 
   // Helper for injecting an ERROR event.
@@ -609,6 +675,18 @@ protected:
     CHECK(!response.isDiscarded());
     CHECK(state == SUBSCRIBING || state == SUBSCRIBED) << state;
 
+    if (call.type() == Call::UPDATE || call.type() == Call::UPDATE_BATCH) {
+      // The update request is no longer in flight; flush anything
+      // that queued up behind it.
+      updating = false;
+
+      Option<Call> flushed = flushUpdates();
+      if (flushed.isSome()) {
+        updating = true;
+        post(flushed.get());
+      }
+    }
+
     // This can happen if the agent process is restarted or a network blip
     // caused the socket to timeout. Eventually, the executor would
     // detect the socket disconnection via the disconnected callback.
@@ -628,8 +706,10 @@ protected:
 
       Pipe::Reader reader = response->reader.get();
 
-      auto deserializer =
-        lambda::bind(deserialize<Event>, contentType, lambda::_1);
+      // Deserialize each record in place from a slice of the pipe's
+      // data, avoiding a copy per streamed event.
+      auto deserializer = lambda::bind(
+          deserializeSlice<Event>, contentType, lambda::_1, lambda::_2);
 
       Owned<Reader<Event>> decoder(
           new Reader<Event>(Decoder<Event>(deserializer), reader));
@@ -779,6 +859,44 @@ protected:
   void drop(const Call& call, const string& message)
   {
     LOG(WARNING) << "Dropping " << call.type() << ": " << message;
+
+    if (call.type() == Call::UPDATE || call.type() == Call::UPDATE_BATCH) {
+      // Don't leave the update pipeline wedged on a dropped request.
+      // Anything queued behind it is dropped along with it; executors
+      // resend unacknowledged updates when they resubscribe.
+      updating = false;
+      updates.clear();
+    }
+  }
+
+  // Drains the queued status updates into a single call: the update
+  // itself if there is just one, or an UPDATE_BATCH call otherwise.
+  Option<Call> flushUpdates()
+  {
+    if (updates.empty()) {
+      return None();
+    }
+
+    Call call;
+
+    if (updates.size() == 1) {
+      call = std::move(updates.front());
+    } else {
+      VLOG(1) << "Batching " << updates.size() << " status updates";
+
+      call.set_type(Call::UPDATE_BATCH);
+      *call.mutable_executor_id() = updates.front().executor_id();
+      *call.mutable_framework_id() = updates.front().framework_id();
+
+      foreach (Call& update, updates) {
+        *call.mutable_update_batch()->add_updates() =
+          std::move(*update.mutable_update());
+      }
+    }
+
+    updates.clear();
+
+    return call;
   }
 
 private:
@@ -830,7 +948,21 @@ private:
   bool local;
   Option<Connections> connections;
   Option<SubscribedResponse> subscribed;
+
+  // Status updates queued while a previous update request is in
+  // flight, flushed when it completes.
+  vector<Call> updates;
+  bool updating; // Whether an update request is in flight.
+
   ::URL agent;
+
+#ifndef __WINDOWS__
+  // Domain socket serving the agent's executor API, advertised via
+  // the 'MESOS_DOMAIN_SOCKET' environment variable. When set, it is
+  // preferred over connecting to the agent's TCP endpoint.
+  Option<process::network::unix::Address> domainSocket;
+#endif // __WINDOWS__
+
   bool checkpoint;
   Option<Duration> recoveryTimeout;
   Option<Duration> maxBackoff;
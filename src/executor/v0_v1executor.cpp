@@ -224,6 +224,13 @@ public:
         break;
       }
 
+      case Call::UPDATE_BATCH: {
+        foreach (const Call::Update& update, call.update_batch().updates()) {
+          driver->sendStatusUpdate(devolve(update.status()));
+        }
+        break;
+      }
+
       case Call::MESSAGE: {
         driver->sendFrameworkMessage(call.message().data());
         break;
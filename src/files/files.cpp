@@ -27,6 +27,7 @@
 
 #include <boost/shared_array.hpp>
 
+#include <process/clock.hpp>
 #include <process/defer.hpp>
 #include <process/deferred.hpp> // TODO(benh): This is required by Clang.
 #include <process/dispatch.hpp>
@@ -35,8 +36,11 @@
 #include <process/http.hpp>
 #include <process/io.hpp>
 #include <process/mime.hpp>
+#include <process/owned.hpp>
 #include <process/process.hpp>
+#include <process/time.hpp>
 
+#include <stout/duration.hpp>
 #include <stout/error.hpp>
 #include <stout/hashmap.hpp>
 #include <stout/json.hpp>
@@ -75,11 +79,13 @@ using mesos::Authorizer;
 
 using process::AUTHENTICATION;
 using process::AUTHORIZATION;
+using process::Clock;
 using process::defer;
 using process::DESCRIPTION;
 using process::Failure;
 using process::Future;
 using process::HELP;
+using process::Owned;
 using process::Process;
 using process::TLDR;
 using process::wait; // Necessary on some OS's to disambiguate.
@@ -95,6 +101,26 @@ using std::vector;
 namespace mesos {
 namespace internal {
 
+// How long a cached directory listing may be served before the
+// entries are re-`stat`-ed. Listings are also invalidated when the
+// directory's modification time changes (i.e., entries are added or
+// removed), so this mainly bounds how stale the metadata of existing
+// entries (e.g., sizes of growing log files) can get.
+static const Duration BROWSE_CACHE_TTL = Seconds(5);
+
+
+#ifndef __WINDOWS__
+// Size of the window kept over the tail of a recently read file.
+// Reads that fall within the window are served with a synchronous
+// `pread` (the tail of a hot log is resident in the page cache),
+// skipping the seek and asynchronous read machinery below.
+static const size_t TAIL_WINDOW_LENGTH = 1024 * 1024;
+
+// How long a tail window is retained after its last use.
+static const Duration TAIL_WINDOW_TTL = Seconds(30);
+#endif // __WINDOWS__
+
+
 class FilesProcess : public Process<FilesProcess>
 {
 public:
@@ -196,6 +222,42 @@ private:
 
   hashmap<string, string> paths;
 
+  // A cached directory listing. Building a listing `stat`-s every
+  // entry, which for sandboxes with very many files makes each
+  // request expensive; the cache lets bursts of browse requests
+  // (e.g., from paginating clients) share one listing.
+  struct CachedListing
+  {
+    std::list<FileInfo> listing;
+    long mtime;
+    process::Time expiration;
+  };
+
+  // Cached listings, keyed by resolved directory path.
+  hashmap<string, CachedListing> cache;
+
+#ifndef __WINDOWS__
+  // The region [offset, offset + length) at the tail of a file: reads
+  // that fall within it are served with a synchronous `pread` rather
+  // than the one-off asynchronous read. Truncation (e.g., rotation)
+  // is caught by revalidating the file's length on every read.
+  //
+  // NOTE: The bytes are deliberately copied with `pread` instead of
+  // out of a shared mapping: a concurrent truncation (e.g., logrotate
+  // with 'copytruncate', or a task truncating its own stdout) would
+  // turn an access to mapped pages past the new end of the file into
+  // a SIGBUS, whereas `pread` simply returns short.
+  struct TailWindow
+  {
+    off_t offset;
+    size_t length;
+    process::Time expiration;
+  };
+
+  // Tail windows, keyed by resolved file path.
+  hashmap<string, Owned<TailWindow>> windows;
+#endif // __WINDOWS__
+
   // Set of authorization functions. They will be called whenever
   // access to the path used as key is requested, and will pass
   // as parameter the principal returned by the HTTP authenticator.
@@ -355,7 +417,10 @@ const string FilesProcess::BROWSE_HELP = HELP(
         "",
         "Query parameters:",
         "",
-        ">        path=VALUE          The path of directory to browse."),
+        ">        path=VALUE          The path of directory to browse.",
+        ">        offset=VALUE        Number of entries to skip (optional).",
+        ">        length=VALUE        Maximum number of entries to return "
+        "(optional)."),
     AUTHENTICATION(true),
     AUTHORIZATION(
         "Browsing files requires that the request principal is",
@@ -409,8 +474,34 @@ Future<http::Response> FilesProcess::_browse(
   string requestedPath = path.get();
   Option<string> jsonp = request.url.query.get("jsonp");
 
+  // Paginate the listing if the client asked for it: skip the first
+  // 'offset' entries and return at most 'length' of the remainder.
+  size_t offset = 0;
+
+  if (request.url.query.get("offset").isSome()) {
+    Try<size_t> result = numify<size_t>(request.url.query.get("offset").get());
+
+    if (result.isError()) {
+      return BadRequest("Failed to parse offset: " + result.error() + ".\n");
+    }
+
+    offset = result.get();
+  }
+
+  Option<size_t> length;
+
+  if (request.url.query.get("length").isSome()) {
+    Try<size_t> result = numify<size_t>(request.url.query.get("length").get());
+
+    if (result.isError()) {
+      return BadRequest("Failed to parse length: " + result.error() + ".\n");
+    }
+
+    length = result.get();
+  }
+
   return browse(requestedPath, principal)
-    .then([jsonp](const Try<list<FileInfo>, FilesError>& result)
+    .then([offset, length, jsonp](const Try<list<FileInfo>, FilesError>& result)
       -> Future<http::Response> {
       if (result.isError()) {
         const FilesError& error = result.error();
@@ -433,7 +524,16 @@ Future<http::Response> FilesProcess::_browse(
       }
 
       JSON::Array listing;
+      size_t index = 0;
       foreach (const FileInfo& fileInfo, result.get()) {
+        if (index++ < offset) {
+          continue;
+        }
+
+        if (length.isSome() && listing.values.size() >= length.get()) {
+          break;
+        }
+
         listing.values.push_back(model(fileInfo));
       }
 
@@ -465,6 +565,30 @@ Future<Try<list<FileInfo>, FilesError>> FilesProcess::browse(
         return FilesError(FilesError::Type::NOT_FOUND);
       }
 
+      // Serve a cached listing if the directory hasn't changed since
+      // the listing was built and the cache entry hasn't expired.
+      Try<long> mtime = os::stat::mtime(resolvedPath.get());
+
+      if (cache.contains(resolvedPath.get())) {
+        const CachedListing& cached = cache.at(resolvedPath.get());
+
+        if (Clock::now() < cached.expiration &&
+            mtime.isSome() &&
+            mtime.get() == cached.mtime) {
+          return cached.listing;
+        }
+
+        cache.erase(resolvedPath.get());
+      }
+
+      // Prune any expired entries (done lazily to avoid a timer);
+      // the cache otherwise holds onto large listings indefinitely.
+      foreach (const string& key, cache.keys()) {
+        if (Clock::now() >= cache.at(key).expiration) {
+          cache.erase(key);
+        }
+      }
+
       // The result will be a sorted (on convertedPath) list of files and dirs.
       map<string, FileInfo> files;
       Try<list<string>> entries = os::ls(resolvedPath.get());
@@ -488,6 +612,11 @@ Future<Try<list<FileInfo>, FilesError>> FilesProcess::browse(
         listing.push_back(fileInfo);
       }
 
+      if (mtime.isSome()) {
+        cache[resolvedPath.get()] =
+          CachedListing{listing, mtime.get(), Clock::now() + BROWSE_CACHE_TTL};
+      }
+
       return listing;
     }));
 }
@@ -698,6 +827,87 @@ Future<Try<tuple<size_t, string>, FilesError>> FilesProcess::_read(
   // Cap the read length at 16 pages.
   length = std::min(length.get(), os::pagesize() * 16);
 
+#ifndef __WINDOWS__
+  // Retire windows that haven't been read from for a while (done
+  // lazily to avoid a timer).
+  foreach (const string& key, windows.keys()) {
+    if (Clock::now() >= windows.at(key)->expiration) {
+      windows.erase(key);
+    }
+  }
+
+  // What a read served from a window would return: a read extending
+  // past the end of the file comes back short, just as it would from
+  // the one-off read below.
+  const size_t length_ =
+    std::min(length.get(), static_cast<size_t>(size) - offset);
+
+  if (windows.contains(resolvedPath.get())) {
+    const Owned<TailWindow>& window = windows.at(resolvedPath.get());
+
+    if (window->offset + static_cast<off_t>(window->length) > size) {
+      // The file shrank (e.g., it was rotated) so the window is
+      // stale.
+      windows.erase(resolvedPath.get());
+    } else if (static_cast<off_t>(offset) >= window->offset &&
+               offset + length_ <=
+                 static_cast<size_t>(window->offset) + window->length) {
+      window->expiration = Clock::now() + TAIL_WINDOW_TTL;
+
+      string data(length_, '\0');
+
+      // A truncation between the `lseek` above and here comes back
+      // as a short (or empty) read, just like the one-off read.
+      ssize_t result =
+        ::pread(fd.get(), &data[0], length_, static_cast<off_t>(offset));
+
+      if (result >= 0) {
+        os::close(fd.get());
+
+        data.resize(result);
+
+        return std::make_tuple(size, std::move(data));
+      }
+
+      // On failure fall through to the one-off read below.
+    }
+  }
+
+  if (!windows.contains(resolvedPath.get())) {
+    // Track a window over the tail of the file if the read falls
+    // within it. Reads of older regions (which tailing clients
+    // don't issue) fall through to the one-off read below.
+    off_t windowOffset = 0;
+
+    if (static_cast<size_t>(size) > TAIL_WINDOW_LENGTH) {
+      windowOffset = size - TAIL_WINDOW_LENGTH;
+      windowOffset -= windowOffset % static_cast<off_t>(os::pagesize());
+    }
+
+    const size_t windowLength = size - windowOffset;
+
+    if (static_cast<off_t>(offset) >= windowOffset) {
+      string data(length_, '\0');
+
+      ssize_t result =
+        ::pread(fd.get(), &data[0], length_, static_cast<off_t>(offset));
+
+      if (result >= 0) {
+        windows[resolvedPath.get()] = Owned<TailWindow>(new TailWindow{
+            windowOffset,
+            windowLength,
+            Clock::now() + TAIL_WINDOW_TTL});
+
+        os::close(fd.get());
+
+        data.resize(result);
+
+        return std::make_tuple(size, std::move(data));
+      }
+    }
+  }
+#endif // __WINDOWS__
+
   // Seek to the offset we want to read from.
   lseek = os::lseek(fd.get(), static_cast<off_t>(offset), SEEK_SET);
   if (lseek.isError()) {
@@ -739,6 +949,9 @@ const string FilesProcess::DOWNLOAD_HELP = HELP(
         "This endpoint will return the raw file contents for the",
         "given path.",
         "",
+        "HTTP 'Range' requests (single byte ranges) are supported,",
+        "so clients can resume or window large downloads.",
+        "",
         "Query parameters:",
         "",
         ">        path=VALUE          The path of directory to browse."),
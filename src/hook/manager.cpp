@@ -14,8 +14,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <memory>
 #include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <mesos/hook.hpp>
@@ -36,6 +38,8 @@
 #include "module/manager.hpp"
 
 using std::map;
+using std::pair;
+using std::shared_ptr;
 using std::string;
 using std::vector;
 
@@ -51,6 +55,123 @@ static std::mutex mutex;
 static LinkedHashMap<string, Hook*> availableHooks;
 
 
+// Per hook point invocation chains, precompiled whenever modules are
+// loaded or unloaded. Each chain holds just the modules implementing
+// that point, in load order. Invocations grab an immutable snapshot
+// and run without holding `mutex`, so a hook point with no
+// implementing modules costs a single atomic load and concurrent
+// invocations of slow hooks no longer serialize on the lock.
+//
+// NOTE: An invocation already in flight when `unload` rebuilds the
+// chains may still consult the unloaded module. This is safe because
+// hook module instances are never destroyed.
+struct HookChains
+{
+  vector<pair<string, Hook*>> masterLaunchTaskLabelDecorator;
+  vector<pair<string, Hook*>> masterSlaveLostHook;
+  vector<pair<string, Hook*>> slaveRunTaskLabelDecorator;
+  vector<pair<string, Hook*>> slaveExecutorEnvironmentDecorator;
+  vector<pair<string, Hook*>> slavePreLaunchDockerTaskExecutorDecorator;
+  vector<pair<string, Hook*>> slavePostFetchHook;
+  vector<pair<string, Hook*>> slaveRemoveExecutorHook;
+  vector<pair<string, Hook*>> slaveTaskStatusDecorator;
+  vector<pair<string, Hook*>> slaveResourcesDecorator;
+  vector<pair<string, Hook*>> slaveAttributesDecorator;
+};
+
+static shared_ptr<const HookChains> hookChains =
+  std::make_shared<HookChains>();
+
+
+// Returns the modules implementing the given hook point, in load
+// order. Must be called with `mutex` held.
+static vector<pair<string, Hook*>> chain(Hook::HookPoint hookPoint)
+{
+  vector<pair<string, Hook*>> chain_;
+
+  foreachpair (const string& name, Hook* hook, availableHooks) {
+    if (hook->implements(hookPoint)) {
+      chain_.push_back({name, hook});
+    }
+  }
+
+  return chain_;
+}
+
+
+// Rebuilds the precompiled hook chains from `availableHooks`. Must be
+// called with `mutex` held.
+static void recompile()
+{
+  shared_ptr<HookChains> chains(new HookChains());
+
+  chains->masterLaunchTaskLabelDecorator =
+    chain(Hook::HookPoint::MASTER_LAUNCH_TASK_LABEL_DECORATOR);
+  chains->masterSlaveLostHook =
+    chain(Hook::HookPoint::MASTER_SLAVE_LOST_HOOK);
+  chains->slaveRunTaskLabelDecorator =
+    chain(Hook::HookPoint::SLAVE_RUN_TASK_LABEL_DECORATOR);
+  chains->slaveExecutorEnvironmentDecorator =
+    chain(Hook::HookPoint::SLAVE_EXECUTOR_ENVIRONMENT_DECORATOR);
+  chains->slavePreLaunchDockerTaskExecutorDecorator =
+    chain(Hook::HookPoint::SLAVE_PRE_LAUNCH_DOCKER_TASK_EXECUTOR_DECORATOR);
+  chains->slavePostFetchHook =
+    chain(Hook::HookPoint::SLAVE_POST_FETCH_HOOK);
+  chains->slaveRemoveExecutorHook =
+    chain(Hook::HookPoint::SLAVE_REMOVE_EXECUTOR_HOOK);
+  chains->slaveTaskStatusDecorator =
+    chain(Hook::HookPoint::SLAVE_TASK_STATUS_DECORATOR);
+  chains->slaveResourcesDecorator =
+    chain(Hook::HookPoint::SLAVE_RESOURCES_DECORATOR);
+  chains->slaveAttributesDecorator =
+    chain(Hook::HookPoint::SLAVE_ATTRIBUTES_DECORATOR);
+
+  std::atomic_store(
+      &hookChains, shared_ptr<const HookChains>(std::move(chains)));
+}
+
+
+// Appends the labels in `additions` that are not already present in
+// `labels`. Used to merge the results of independent label decorator
+// modules, each of which ran against the original input: a module's
+// result is treated as additions, so labels it merely copied through
+// (or that an earlier module already added) are not repeated.
+static void unionLabels(const Labels& additions, Labels* labels)
+{
+  foreach (const Label& label, additions.labels()) {
+    bool present = false;
+
+    foreach (const Label& existing, labels->labels()) {
+      if (existing.key() == label.key() &&
+          existing.has_value() == label.has_value() &&
+          (!label.has_value() || existing.value() == label.value())) {
+        present = true;
+        break;
+      }
+    }
+
+    if (!present) {
+      labels->add_labels()->CopyFrom(label);
+    }
+  }
+}
+
+
+// Returns whether every module in the chain declares its decorators
+// independent, in which case each module runs against the original
+// input and the labels it adds are unioned in load order.
+static bool independent(const vector<pair<string, Hook*>>& chain)
+{
+  foreachvalue (Hook* hook, chain) {
+    if (!hook->independentDecorators()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
 Try<Nothing> HookManager::initialize(const string& hookList)
 {
   synchronized (mutex) {
@@ -75,6 +196,8 @@ Try<Nothing> HookManager::initialize(const string& hookList)
       // Add the hook module to the list of available hooks.
       availableHooks[hook] = module.get();
     }
+
+    recompile();
   }
 
   return Nothing();
@@ -91,6 +214,8 @@ Try<Nothing> HookManager::unload(const string& hookName)
 
     // Now remove the hook from the list of available hooks.
     availableHooks.erase(hookName);
+
+    recompile();
   }
 
   return Nothing();
@@ -110,37 +235,74 @@ Labels HookManager::masterLaunchTaskLabelDecorator(
     const FrameworkInfo& frameworkInfo,
     const SlaveInfo& slaveInfo)
 {
-  synchronized (mutex) {
-    // We need a mutable copy of the task info and set the new
-    // labels after each hook invocation. Otherwise, the last hook
-    // will be the only effective hook setting the labels.
-    TaskInfo taskInfo_ = taskInfo;
+  const shared_ptr<const HookChains> chains = std::atomic_load(&hookChains);
 
-    foreachpair (const string& name, Hook* hook, availableHooks) {
+  if (chains->masterLaunchTaskLabelDecorator.empty()) {
+    return taskInfo.labels();
+  }
+
+  // If every module declares its decorators independent, each runs
+  // against the original task info and the labels it adds are
+  // unioned in load order, so no module needs to re-serialize on the
+  // labels left by its predecessors.
+  //
+  // NOTE: We deliberately do not fan the hooks out via
+  // `process::async` and block on the result here: this runs on a
+  // libprocess worker thread, and waiting on work scheduled on the
+  // same shared pool can deadlock when the pool is saturated.
+  if (chains->masterLaunchTaskLabelDecorator.size() > 1 &&
+      independent(chains->masterLaunchTaskLabelDecorator)) {
+    Labels labels = taskInfo.labels();
+
+    foreachpair (const string& name, Hook* hook,
+                 chains->masterLaunchTaskLabelDecorator) {
       const Result<Labels> result =
         hook->masterLaunchTaskLabelDecorator(
-            taskInfo_,
-            frameworkInfo,
-            slaveInfo);
+            taskInfo, frameworkInfo, slaveInfo);
 
-      // NOTE: If the hook returns None(), the task labels won't be
-      // changed.
       if (result.isSome()) {
-        taskInfo_.mutable_labels()->CopyFrom(result.get());
+        unionLabels(result.get(), &labels);
       } else if (result.isError()) {
         LOG(WARNING) << "Master label decorator hook failed for module '"
-                    << name << "': " << result.error();
+                     << name << "': " << result.error();
       }
     }
 
-    return taskInfo_.labels();
+    return labels;
+  }
+
+  // We need a mutable copy of the task info and set the new
+  // labels after each hook invocation. Otherwise, the last hook
+  // will be the only effective hook setting the labels.
+  TaskInfo taskInfo_ = taskInfo;
+
+  foreachpair (const string& name, Hook* hook,
+               chains->masterLaunchTaskLabelDecorator) {
+    const Result<Labels> result =
+      hook->masterLaunchTaskLabelDecorator(
+          taskInfo_,
+          frameworkInfo,
+          slaveInfo);
+
+    // NOTE: If the hook returns None(), the task labels won't be
+    // changed.
+    if (result.isSome()) {
+      taskInfo_.mutable_labels()->CopyFrom(result.get());
+    } else if (result.isError()) {
+      LOG(WARNING) << "Master label decorator hook failed for module '"
+                  << name << "': " << result.error();
+    }
   }
+
+  return taskInfo_.labels();
 }
 
 
 void HookManager::masterSlaveLostHook(const SlaveInfo& slaveInfo)
 {
-  foreachpair (const string& name, Hook* hook, availableHooks) {
+  const shared_ptr<const HookChains> chains = std::atomic_load(&hookChains);
+
+  foreachpair (const string& name, Hook* hook, chains->masterSlaveLostHook) {
     Try<Nothing> result = hook->masterSlaveLostHook(slaveInfo);
     if (result.isError()) {
       LOG(WARNING) << "Master agent-lost hook failed for module '"
@@ -156,49 +318,77 @@ Labels HookManager::slaveRunTaskLabelDecorator(
     const FrameworkInfo& frameworkInfo,
     const SlaveInfo& slaveInfo)
 {
-  synchronized (mutex) {
-    TaskInfo taskInfo_ = taskInfo;
+  const shared_ptr<const HookChains> chains = std::atomic_load(&hookChains);
+
+  if (chains->slaveRunTaskLabelDecorator.empty()) {
+    return taskInfo.labels();
+  }
 
-    foreachpair (const string& name, Hook* hook, availableHooks) {
+  // As above, independent decorators each run against the original
+  // task info with their label additions unioned in load order.
+  if (chains->slaveRunTaskLabelDecorator.size() > 1 &&
+      independent(chains->slaveRunTaskLabelDecorator)) {
+    Labels labels = taskInfo.labels();
+
+    foreachpair (const string& name, Hook* hook,
+                 chains->slaveRunTaskLabelDecorator) {
       const Result<Labels> result = hook->slaveRunTaskLabelDecorator(
-          taskInfo_, executorInfo, frameworkInfo, slaveInfo);
+          taskInfo, executorInfo, frameworkInfo, slaveInfo);
 
-      // NOTE: If the hook returns None(), the task labels won't be
-      // changed.
       if (result.isSome()) {
-        taskInfo_.mutable_labels()->CopyFrom(result.get());
+        unionLabels(result.get(), &labels);
       } else if (result.isError()) {
         LOG(WARNING) << "Agent label decorator hook failed for module '"
-                    << name << "': " << result.error();
+                     << name << "': " << result.error();
       }
     }
 
-    return taskInfo_.labels();
+    return labels;
+  }
+
+  TaskInfo taskInfo_ = taskInfo;
+
+  foreachpair (const string& name, Hook* hook,
+               chains->slaveRunTaskLabelDecorator) {
+    const Result<Labels> result = hook->slaveRunTaskLabelDecorator(
+        taskInfo_, executorInfo, frameworkInfo, slaveInfo);
+
+    // NOTE: If the hook returns None(), the task labels won't be
+    // changed.
+    if (result.isSome()) {
+      taskInfo_.mutable_labels()->CopyFrom(result.get());
+    } else if (result.isError()) {
+      LOG(WARNING) << "Agent label decorator hook failed for module '"
+                  << name << "': " << result.error();
+    }
   }
+
+  return taskInfo_.labels();
 }
 
 
 Environment HookManager::slaveExecutorEnvironmentDecorator(
     ExecutorInfo executorInfo)
 {
-  synchronized (mutex) {
-    foreachpair (const string& name, Hook* hook, availableHooks) {
-      const Result<Environment> result =
-        hook->slaveExecutorEnvironmentDecorator(executorInfo);
-
-      // NOTE: If the hook returns None(), the environment won't be
-      // changed.
-      if (result.isSome()) {
-        executorInfo.mutable_command()->mutable_environment()->CopyFrom(
-            result.get());
-      } else if (result.isError()) {
-        LOG(WARNING) << "Agent environment decorator hook failed for module '"
-                    << name << "': " << result.error();
-      }
+  const shared_ptr<const HookChains> chains = std::atomic_load(&hookChains);
+
+  foreachpair (const string& name, Hook* hook,
+               chains->slaveExecutorEnvironmentDecorator) {
+    const Result<Environment> result =
+      hook->slaveExecutorEnvironmentDecorator(executorInfo);
+
+    // NOTE: If the hook returns None(), the environment won't be
+    // changed.
+    if (result.isSome()) {
+      executorInfo.mutable_command()->mutable_environment()->CopyFrom(
+          result.get());
+    } else if (result.isError()) {
+      LOG(WARNING) << "Agent environment decorator hook failed for module '"
+                  << name << "': " << result.error();
     }
-
-    return executorInfo.command().environment();
   }
+
+  return executorInfo.command().environment();
 }
 
 
@@ -211,13 +401,15 @@ Future<DockerTaskExecutorPrepareInfo>
       const string& mappedSandboxDirectory,
       const Option<map<string, string>>& env)
 {
+  const shared_ptr<const HookChains> chains = std::atomic_load(&hookChains);
+
   // We execute these hooks according to their ordering so any conflicting
   // `DockerTaskExecutorPrepareInfo` can be deterministically resolved
   // (the last hook takes priority).
   vector<Future<Option<DockerTaskExecutorPrepareInfo>>> futures;
-  futures.reserve(availableHooks.size());
+  futures.reserve(chains->slavePreLaunchDockerTaskExecutorDecorator.size());
 
-  foreachvalue (Hook* hook, availableHooks) {
+  foreachvalue (Hook* hook, chains->slavePreLaunchDockerTaskExecutorDecorator) {
     // Chain together each hook.
     futures.push_back(
         hook->slavePreLaunchDockerTaskExecutorDecorator(
@@ -249,7 +441,9 @@ void HookManager::slavePostFetchHook(
     const ContainerID& containerId,
     const string& directory)
 {
-  foreachpair (const string& name, Hook* hook, availableHooks) {
+  const shared_ptr<const HookChains> chains = std::atomic_load(&hookChains);
+
+  foreachpair (const string& name, Hook* hook, chains->slavePostFetchHook) {
     Try<Nothing> result = hook->slavePostFetchHook(containerId, directory);
     if (result.isError()) {
       LOG(WARNING) << "Agent post fetch hook failed for module "
@@ -263,7 +457,10 @@ void HookManager::slaveRemoveExecutorHook(
     const FrameworkInfo& frameworkInfo,
     const ExecutorInfo& executorInfo)
 {
-  foreachpair (const string& name, Hook* hook, availableHooks) {
+  const shared_ptr<const HookChains> chains = std::atomic_load(&hookChains);
+
+  foreachpair (const string& name, Hook* hook,
+               chains->slaveRemoveExecutorHook) {
     const Try<Nothing> result =
       hook->slaveRemoveExecutorHook(frameworkInfo, executorInfo);
     if (result.isError()) {
@@ -278,86 +475,89 @@ TaskStatus HookManager::slaveTaskStatusDecorator(
     const FrameworkID& frameworkId,
     TaskStatus status)
 {
-  synchronized (mutex) {
-    foreachpair (const string& name, Hook* hook, availableHooks) {
-      const Result<TaskStatus> result =
-        hook->slaveTaskStatusDecorator(frameworkId, status);
-
-      // NOTE: Labels/ContainerStatus remain unchanged if the hook returns
-      // None().
-      if (result.isSome()) {
-        if (result->has_labels()) {
-          status.mutable_labels()->CopyFrom(result->labels());
-        }
+  const shared_ptr<const HookChains> chains = std::atomic_load(&hookChains);
+
+  foreachpair (const string& name, Hook* hook,
+               chains->slaveTaskStatusDecorator) {
+    const Result<TaskStatus> result =
+      hook->slaveTaskStatusDecorator(frameworkId, status);
+
+    // NOTE: Labels/ContainerStatus remain unchanged if the hook returns
+    // None().
+    if (result.isSome()) {
+      if (result->has_labels()) {
+        status.mutable_labels()->CopyFrom(result->labels());
+      }
 
-        if (result->has_container_status()) {
-          status.mutable_container_status()->CopyFrom(
-              result->container_status());
-        }
-      } else if (result.isError()) {
-        LOG(WARNING) << "Agent TaskStatus decorator hook failed for "
-                     << "module '" << name << "': " << result.error();
+      if (result->has_container_status()) {
+        status.mutable_container_status()->CopyFrom(
+            result->container_status());
       }
+    } else if (result.isError()) {
+      LOG(WARNING) << "Agent TaskStatus decorator hook failed for "
+                   << "module '" << name << "': " << result.error();
     }
-
-    return status;
   }
+
+  return status;
 }
 
 
 Resources HookManager::slaveResourcesDecorator(
     const SlaveInfo& slaveInfo)
 {
+  const shared_ptr<const HookChains> chains = std::atomic_load(&hookChains);
+
   // We need a mutable copy of the Resources object. Each hook will
   // see the changes made by previous hooks, so the order of execution
   // matters. Hooks are executed in the order they are specified by
-  // the user (note that `availableHooks` is a LinkedHashMap).
+  // the user (note that the chain preserves the load order).
   SlaveInfo slaveInfo_ = slaveInfo;
 
-  synchronized (mutex) {
-    foreachpair (const string& name, Hook* hook, availableHooks) {
-      const Result<Resources> result =
-        hook->slaveResourcesDecorator(slaveInfo_);
-
-      // NOTE: Resources remain unchanged if the hook returns None().
-      if (result.isSome()) {
-        slaveInfo_.mutable_resources()->CopyFrom(result.get());
-      } else if (result.isError()) {
-        LOG(WARNING) << "Agent Resources decorator hook failed for "
-                     << "module '" << name << "': " << result.error();
-      }
+  foreachpair (const string& name, Hook* hook,
+               chains->slaveResourcesDecorator) {
+    const Result<Resources> result =
+      hook->slaveResourcesDecorator(slaveInfo_);
+
+    // NOTE: Resources remain unchanged if the hook returns None().
+    if (result.isSome()) {
+      slaveInfo_.mutable_resources()->CopyFrom(result.get());
+    } else if (result.isError()) {
+      LOG(WARNING) << "Agent Resources decorator hook failed for "
+                   << "module '" << name << "': " << result.error();
     }
-
-    return slaveInfo_.resources();
   }
+
+  return slaveInfo_.resources();
 }
 
 
 Attributes HookManager::slaveAttributesDecorator(
     const SlaveInfo& slaveInfo)
 {
+  const shared_ptr<const HookChains> chains = std::atomic_load(&hookChains);
+
   // We need a mutable copy of the Attributes object. Each hook will
   // see the changes made by previous hooks, so the order of execution
   // matters. Hooks are executed in the order they are specified by
-  // the user (note that `availableHooks` is a LinkedHashMap).
+  // the user (note that the chain preserves the load order).
   SlaveInfo slaveInfo_ = slaveInfo;
 
-  synchronized (mutex) {
-    foreachpair (const string& name, Hook* hook, availableHooks) {
-      const Result<Attributes> result =
-        hook->slaveAttributesDecorator(slaveInfo_);
-
-      // NOTE: Attributes remain unchanged if the hook returns None().
-      if (result.isSome()) {
-        slaveInfo_.mutable_attributes()->CopyFrom(result.get());
-      } else if (result.isError()) {
-        LOG(WARNING) << "Agent Attributes decorator hook failed for "
-                     << "module '" << name << "': " << result.error();
-      }
+  foreachpair (const string& name, Hook* hook,
+               chains->slaveAttributesDecorator) {
+    const Result<Attributes> result =
+      hook->slaveAttributesDecorator(slaveInfo_);
+
+    // NOTE: Attributes remain unchanged if the hook returns None().
+    if (result.isSome()) {
+      slaveInfo_.mutable_attributes()->CopyFrom(result.get());
+    } else if (result.isError()) {
+      LOG(WARNING) << "Agent Attributes decorator hook failed for "
+                   << "module '" << name << "': " << result.error();
     }
-
-    return slaveInfo_.attributes();
   }
+
+  return slaveInfo_.attributes();
 }
 
 } // namespace internal {
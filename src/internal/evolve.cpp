@@ -48,19 +48,22 @@ static T evolve(const google::protobuf::Message& message)
 {
   T t;
 
-  string data;
+  // Reuse a per-thread buffer for the serialized bytes: this runs
+  // for every v1 API call and event, and allocating a fresh string
+  // each time is measurable on the event stream.
+  static thread_local string* data = new string();
 
   // NOTE: We need to use 'SerializePartialToString' instead of
   // 'SerializeToString' because some required fields might not be set
   // and we don't want an exception to get thrown.
-  CHECK(message.SerializePartialToString(&data))
+  CHECK(message.SerializePartialToString(data))
     << "Failed to serialize " << message.GetTypeName()
     << " while evolving to " << t.GetTypeName();
 
   // NOTE: We need to use 'ParsePartialFromString' instead of
   // 'ParseFromString' because some required fields might not
   // be set and we don't want an exception to get thrown.
-  CHECK(t.ParsePartialFromString(data))
+  CHECK(t.ParsePartialFromString(*data))
     << "Failed to parse " << t.GetTypeName()
     << " while evolving from " << message.GetTypeName();
 
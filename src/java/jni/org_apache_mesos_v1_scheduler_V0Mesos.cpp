@@ -638,6 +638,20 @@ void V0ToV1AdapterProcess::send(SchedulerDriver* driver, const Call& _call)
       break;
     }
 
+    case scheduler::Call::ACKNOWLEDGE_BATCH: {
+      foreach (const scheduler::Call::Acknowledge& acknowledge,
+               call.acknowledge_batch().acknowledgements()) {
+        TaskStatus status;
+        status.mutable_task_id()->CopyFrom(acknowledge.task_id());
+        status.mutable_slave_id()->CopyFrom(acknowledge.slave_id());
+        status.set_uuid(acknowledge.uuid());
+
+        driver->acknowledgeStatusUpdate(status);
+      }
+
+      break;
+    }
+
     // TODO(greggomann): Implement operation status acknowledgement.
     case scheduler::Call::ACKNOWLEDGE_OPERATION_STATUS:
       break;
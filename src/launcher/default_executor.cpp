@@ -359,13 +359,21 @@ protected:
   {
     CHECK_EQ(SUBSCRIBED, state);
 
-    process::http::connect(agent)
+    // Open a separate connection for each `LAUNCH_NESTED_CONTAINER`
+    // call so that a slow launch does not hold up the responses for
+    // its siblings behind it on a single pipelined connection.
+    vector<Future<Connection>> connections;
+    for (int i = 0; i < taskGroup.tasks().size(); i++) {
+      connections.push_back(process::http::connect(agent));
+    }
+
+    process::collect(connections)
       .onAny(defer(self(), &Self::_launchGroup, taskGroup, lambda::_1));
   }
 
   void _launchGroup(
       const TaskGroupInfo& taskGroup,
-      const Future<Connection>& connection)
+      const Future<vector<Connection>>& connections)
   {
     if (shuttingDown) {
       LOG(WARNING) << "Ignoring the launch group operation as the "
@@ -373,11 +381,11 @@ protected:
       return;
     }
 
-    if (!connection.isReady()) {
-      LOG(WARNING) << "Unable to establish connection with the agent to "
+    if (!connections.isReady()) {
+      LOG(WARNING) << "Unable to establish connections with the agent to "
                    << "complete the launch group operation: "
-                   << (connection.isFailed() ? connection.failure()
-                                             : "discarded");
+                   << (connections.isFailed() ? connections.failure()
+                                              : "discarded");
       dropTaskGroup(taskGroup);
 
       // Shutdown the executor if all the active child containers have
@@ -430,6 +438,7 @@ protected:
     vector<ContainerID> containerIds;
     vector<Future<Response>> responses;
 
+    auto connectionIterator = connections->begin();
     foreach (const TaskInfo& task, taskGroup.tasks()) {
       ContainerID containerId;
       containerId.set_value(id::UUID::random().toString());
@@ -513,7 +522,7 @@ protected:
       CommandInfo *command = launch->mutable_command();
       command->mutable_environment()->add_variables()->CopyFrom(containerIP);
 
-      responses.push_back(post(connection.get(), call));
+      responses.push_back(post(*(connectionIterator++), call));
     }
 
     process::collect(responses)
@@ -521,14 +530,12 @@ protected:
                    &Self::__launchGroup,
                    taskGroup,
                    containerIds,
-                   connection.get(),
                    lambda::_1));
   }
 
   void __launchGroup(
       const TaskGroupInfo& taskGroup,
       const vector<ContainerID>& containerIds,
-      const Connection& connection,
       const Future<vector<Response>>& responses)
   {
     if (shuttingDown) {
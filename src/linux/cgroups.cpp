@@ -18,6 +18,7 @@
 #include <fts.h>
 #include <signal.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
 
@@ -805,6 +806,69 @@ bool exists(
 }
 
 
+ControlFile::ControlFile(
+    const string& hierarchy,
+    const string& cgroup,
+    const string& control)
+  : path(path::join(hierarchy, cgroup, control)),
+    fd(new Option<int_fd>(),
+       [](Option<int_fd>* fd) {
+         if (fd->isSome()) {
+           os::close(fd->get());
+         }
+         delete fd;
+       }) {}
+
+
+Try<string> ControlFile::read()
+{
+  if (fd->isSome()) {
+    Try<off_t> seek = os::lseek(fd->get(), 0, SEEK_SET);
+    if (seek.isError()) {
+      os::close(fd->get());
+      *fd = None();
+    }
+  }
+
+  if (fd->isNone()) {
+    Try<int_fd> open = os::open(path, O_RDONLY | O_CLOEXEC);
+    if (open.isError()) {
+      return Error("Failed to open '" + path + "': " + open.error());
+    }
+
+    *fd = open.get();
+  }
+
+  string contents;
+  char buffer[BUFSIZ];
+
+  while (true) {
+    ssize_t length = ::read(fd->get(), buffer, sizeof(buffer));
+
+    if (length < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+
+      // Force a re-open on the next read, e.g., in case the cgroup
+      // has been recreated.
+      ErrnoError error("Failed to read '" + path + "'");
+
+      os::close(fd->get());
+      *fd = None();
+
+      return error;
+    } else if (length == 0) {
+      break;
+    }
+
+    contents.append(buffer, length);
+  }
+
+  return contents;
+}
+
+
 namespace internal {
 
 // Return a set of tasks (schedulable entities) for the cgroup.
@@ -1686,9 +1750,17 @@ Try<hashmap<string, uint64_t>> stat(
     return Error(contents.error());
   }
 
+  return stat(file, contents.get());
+}
+
+
+Try<hashmap<string, uint64_t>> stat(
+    const string& file,
+    const string& contents)
+{
   hashmap<string, uint64_t> result;
 
-  foreach (const string& line, strings::split(contents.get(), "\n")) {
+  foreach (const string& line, strings::split(contents, "\n")) {
     // Skip empty lines.
     if (strings::trim(line).empty()) {
       continue;
@@ -20,6 +20,7 @@
 #include <stdint.h>
 #include <stdlib.h>
 
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -36,6 +37,8 @@
 #include <stout/option.hpp>
 #include <stout/try.hpp>
 
+#include <stout/os/int_fd.hpp>
+
 namespace cgroups {
 
 // Freezing a cgroup may get stuck (see MESOS-1689 for details). To
@@ -263,6 +266,31 @@ Try<std::string> read(
     const std::string& control);
 
 
+// Reads a control file like `read` above, but keeps the file open
+// across reads so that repeated collection (e.g., statistics read on
+// every polling interval) only performs a seek and a read instead of
+// re-resolving the full cgroup path on each pass. The file is opened
+// lazily on the first read and re-opened after a failed read.
+class ControlFile
+{
+public:
+  ControlFile(
+      const std::string& hierarchy,
+      const std::string& cgroup,
+      const std::string& control);
+
+  // Returns the current contents of the control file.
+  Try<std::string> read();
+
+private:
+  const std::string path;
+
+  // Shared so that `ControlFile` is copyable; the file is closed
+  // when the last reference goes away.
+  std::shared_ptr<Option<int_fd>> fd;
+};
+
+
 // Write a control file. This function assumes the cgroups virtual
 // file systems are properly mounted on the given hierarchy, and the
 // given cgroup has been already created properly. The given control
@@ -418,6 +446,14 @@ Try<hashmap<std::string, uint64_t>> stat(
     const std::string& file);
 
 
+// Parses stat information out of the given contents of a stat file
+// (e.g., read through a `ControlFile`). The file name is only used
+// in error messages.
+Try<hashmap<std::string, uint64_t>> stat(
+    const std::string& file,
+    const std::string& contents);
+
+
 // Blkio subsystem.
 namespace blkio {
 
@@ -0,0 +1,339 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <sys/statfs.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <stout/error.hpp>
+#include <stout/foreach.hpp>
+#include <stout/none.hpp>
+#include <stout/numify.hpp>
+#include <stout/os.hpp>
+#include <stout/path.hpp>
+#include <stout/strings.hpp>
+
+#include "linux/cgroups2.hpp"
+#include "linux/fs.hpp"
+
+using namespace mesos::internal;
+
+using std::istringstream;
+using std::set;
+using std::string;
+using std::vector;
+
+// Magic number of the cgroup2 filesystem, from <linux/magic.h> (which
+// may predate cgroups v2 on build machines).
+#ifndef CGROUP2_SUPER_MAGIC
+#define CGROUP2_SUPER_MAGIC 0x63677270
+#endif
+
+namespace cgroups2 {
+
+bool enabled()
+{
+  Try<string> filesystems = os::read("/proc/filesystems");
+  if (filesystems.isError()) {
+    return false;
+  }
+
+  foreach (const string& line, strings::tokenize(filesystems.get(), "\n")) {
+    vector<string> tokens = strings::tokenize(line, " \t");
+    if (!tokens.empty() && tokens.back() == "cgroup2") {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+
+Try<bool> mounted(const string& path)
+{
+  struct statfs buf;
+  if (::statfs(path.c_str(), &buf) < 0) {
+    if (errno == ENOENT) {
+      return false;
+    }
+
+    return ErrnoError("Failed to stat filesystem at '" + path + "'");
+  }
+
+  return buf.f_type == CGROUP2_SUPER_MAGIC;
+}
+
+
+Result<string> hierarchy()
+{
+  Try<fs::MountTable> table = fs::MountTable::read("/proc/mounts");
+  if (table.isError()) {
+    return Error("Failed to read mount table: " + table.error());
+  }
+
+  foreach (const fs::MountTable::Entry& entry, table->entries) {
+    if (entry.type == "cgroup2") {
+      return entry.dir;
+    }
+  }
+
+  return None();
+}
+
+
+Try<Nothing> create(
+    const string& hierarchy,
+    const string& cgroup,
+    bool recursive)
+{
+  string path = path::join(hierarchy, cgroup);
+  Try<Nothing> mkdir = os::mkdir(path, recursive);
+  if (mkdir.isError()) {
+    return Error(
+        "Failed to create directory '" + path + "': " + mkdir.error());
+  }
+
+  return Nothing();
+}
+
+
+Try<Nothing> remove(const string& hierarchy, const string& cgroup)
+{
+  string path = path::join(hierarchy, cgroup);
+
+  // Do NOT recursively remove cgroups.
+  Try<Nothing> rmdir = os::rmdir(path, false);
+  if (rmdir.isError()) {
+    return Error(
+        "Failed to remove cgroup '" + path + "': " + rmdir.error());
+  }
+
+  return rmdir;
+}
+
+
+bool exists(const string& hierarchy, const string& cgroup)
+{
+  return os::exists(path::join(hierarchy, cgroup));
+}
+
+
+Try<string> read(
+    const string& hierarchy,
+    const string& cgroup,
+    const string& control)
+{
+  string path = path::join(hierarchy, cgroup, control);
+  return os::read(path);
+}
+
+
+Try<Nothing> write(
+    const string& hierarchy,
+    const string& cgroup,
+    const string& control,
+    const string& value)
+{
+  string path = path::join(hierarchy, cgroup, control);
+  return os::write(path, value);
+}
+
+
+Try<set<string>> controllers(const string& hierarchy, const string& cgroup)
+{
+  Try<string> contents = read(hierarchy, cgroup, "cgroup.controllers");
+  if (contents.isError()) {
+    return Error(
+        "Failed to read 'cgroup.controllers': " + contents.error());
+  }
+
+  set<string> results;
+  foreach (const string& controller,
+           strings::tokenize(contents.get(), " \n")) {
+    results.insert(controller);
+  }
+
+  return results;
+}
+
+
+Try<Nothing> enable(
+    const string& hierarchy,
+    const string& cgroup,
+    const set<string>& controllers)
+{
+  vector<string> tokens;
+  foreach (const string& controller, controllers) {
+    tokens.push_back("+" + controller);
+  }
+
+  return write(
+      hierarchy,
+      cgroup,
+      "cgroup.subtree_control",
+      strings::join(" ", tokens));
+}
+
+
+Try<set<pid_t>> processes(const string& hierarchy, const string& cgroup)
+{
+  Try<string> value = read(hierarchy, cgroup, "cgroup.procs");
+  if (value.isError()) {
+    return Error("Failed to read 'cgroup.procs': " + value.error());
+  }
+
+  set<pid_t> pids;
+  foreach (const string& token, strings::tokenize(value.get(), "\n")) {
+    Try<pid_t> pid = numify<pid_t>(token);
+    if (pid.isError()) {
+      return Error("Failed to parse '" + token + "': " + pid.error());
+    }
+
+    pids.insert(pid.get());
+  }
+
+  return pids;
+}
+
+
+Try<Nothing> assign(const string& hierarchy, const string& cgroup, pid_t pid)
+{
+  return write(hierarchy, cgroup, "cgroup.procs", stringify(pid));
+}
+
+
+Try<hashmap<string, uint64_t>> stat(
+    const string& hierarchy,
+    const string& cgroup,
+    const string& control)
+{
+  Try<string> contents = read(hierarchy, cgroup, control);
+  if (contents.isError()) {
+    return Error(contents.error());
+  }
+
+  hashmap<string, uint64_t> result;
+
+  foreach (const string& line, strings::split(contents.get(), "\n")) {
+    // Skip empty lines.
+    if (strings::trim(line).empty()) {
+      continue;
+    }
+
+    string name;
+    uint64_t value;
+
+    // Expected line format: "%s %llu".
+    istringstream stream(line);
+    stream >> name >> value;
+
+    if (stream.fail()) {
+      return Error("Unexpected line format in " + control + ": " + line);
+    }
+
+    result[name] = value;
+  }
+
+  return result;
+}
+
+
+namespace pressure {
+
+Try<Statistics> parse(const string& contents, Type type)
+{
+  const string prefix = (type == Type::SOME) ? "some" : "full";
+
+  foreach (const string& line, strings::tokenize(contents, "\n")) {
+    // Expected line format:
+    //   some avg10=0.00 avg60=0.00 avg300=0.00 total=0
+    vector<string> tokens = strings::tokenize(line, " ");
+    if (tokens.empty() || tokens.front() != prefix) {
+      continue;
+    }
+
+    Option<double> avg10, avg60, avg300;
+    Option<uint64_t> total;
+
+    foreach (const string& token, tokens) {
+      vector<string> pair = strings::split(token, "=");
+      if (pair.size() != 2) {
+        continue;
+      }
+
+      if (pair[0] == "total") {
+        Try<uint64_t> value = numify<uint64_t>(pair[1]);
+        if (value.isError()) {
+          return Error(
+              "Failed to parse '" + token + "': " + value.error());
+        }
+
+        total = value.get();
+      } else {
+        Try<double> value = numify<double>(pair[1]);
+        if (value.isError()) {
+          return Error(
+              "Failed to parse '" + token + "': " + value.error());
+        }
+
+        if (pair[0] == "avg10") {
+          avg10 = value.get();
+        } else if (pair[0] == "avg60") {
+          avg60 = value.get();
+        } else if (pair[0] == "avg300") {
+          avg300 = value.get();
+        }
+      }
+    }
+
+    if (avg10.isNone() || avg60.isNone() ||
+        avg300.isNone() || total.isNone()) {
+      return Error("Incomplete PSI line: " + line);
+    }
+
+    Statistics statistics;
+    statistics.avg10 = avg10.get();
+    statistics.avg60 = avg60.get();
+    statistics.avg300 = avg300.get();
+    statistics.total = Microseconds(static_cast<int64_t>(total.get()));
+
+    return statistics;
+  }
+
+  return Error("Failed to find the '" + prefix + "' PSI line");
+}
+
+
+Try<Statistics> read(
+    const string& hierarchy,
+    const string& cgroup,
+    const string& control,
+    Type type)
+{
+  Try<string> contents = cgroups2::read(hierarchy, cgroup, control);
+  if (contents.isError()) {
+    return Error(
+        "Failed to read '" + control + "': " + contents.error());
+  }
+
+  return parse(contents.get(), type);
+}
+
+} // namespace pressure {
+
+} // namespace cgroups2 {
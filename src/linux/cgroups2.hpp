@@ -0,0 +1,174 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __CGROUPS2_HPP__
+#define __CGROUPS2_HPP__
+
+#include <stdint.h>
+
+#include <sys/types.h>
+
+#include <set>
+#include <string>
+
+#include <stout/duration.hpp>
+#include <stout/hashmap.hpp>
+#include <stout/nothing.hpp>
+#include <stout/result.hpp>
+#include <stout/try.hpp>
+
+// Support for the cgroups v2 unified hierarchy.
+//
+// Unlike cgroups v1 (see cgroups.hpp), where every subsystem can be
+// mounted as a separate hierarchy, v2 exposes all controllers
+// through a single mount. Accounting is consolidated into flat keyed
+// per-resource stat files ('cpu.stat', 'memory.stat') and PSI
+// pressure files ('cpu.pressure', 'memory.pressure', 'io.pressure'),
+// so a full set of container statistics can be collected with a
+// handful of single-file reads.
+namespace cgroups2 {
+
+// Default mount point of the unified hierarchy on modern systems.
+constexpr char MOUNT_POINT[] = "/sys/fs/cgroup";
+
+
+// Checks whether the kernel supports the cgroups v2 unified
+// hierarchy.
+bool enabled();
+
+
+// Checks whether the unified hierarchy is mounted at the given path.
+Try<bool> mounted(const std::string& path = MOUNT_POINT);
+
+
+// Returns the mount point of the unified hierarchy, or None if it is
+// not mounted.
+Result<std::string> hierarchy();
+
+
+// Creates a cgroup in the unified hierarchy. The cgroup will NOT be
+// created recursively unless 'recursive' is set.
+Try<Nothing> create(
+    const std::string& hierarchy,
+    const std::string& cgroup,
+    bool recursive = false);
+
+
+// Removes a cgroup. The cgroup must have no processes and no
+// children; removal is NOT recursive.
+Try<Nothing> remove(const std::string& hierarchy, const std::string& cgroup);
+
+
+// Checks whether a given cgroup exists.
+bool exists(const std::string& hierarchy, const std::string& cgroup);
+
+
+// Reads a control file of a cgroup (e.g., 'memory.max').
+Try<std::string> read(
+    const std::string& hierarchy,
+    const std::string& cgroup,
+    const std::string& control);
+
+
+// Writes a control file of a cgroup.
+Try<Nothing> write(
+    const std::string& hierarchy,
+    const std::string& cgroup,
+    const std::string& control,
+    const std::string& value);
+
+
+// Returns the controllers available to a cgroup (the contents of its
+// 'cgroup.controllers' file).
+Try<std::set<std::string>> controllers(
+    const std::string& hierarchy,
+    const std::string& cgroup);
+
+
+// Enables the given controllers in the children of a cgroup by
+// writing them to its 'cgroup.subtree_control' file. Controllers
+// must be available in the cgroup (see 'controllers()' above).
+Try<Nothing> enable(
+    const std::string& hierarchy,
+    const std::string& cgroup,
+    const std::set<std::string>& controllers);
+
+
+// Returns the processes in a cgroup.
+Try<std::set<pid_t>> processes(
+    const std::string& hierarchy,
+    const std::string& cgroup);
+
+
+// Assigns a given process to a cgroup.
+Try<Nothing> assign(
+    const std::string& hierarchy,
+    const std::string& cgroup,
+    pid_t pid);
+
+
+// Reads a flat keyed stat file of a cgroup (e.g., 'cpu.stat',
+// 'memory.stat') and returns a map from key to value. In contrast to
+// v1, where equivalent information is scattered over many control
+// files, one such read covers a whole resource.
+Try<hashmap<std::string, uint64_t>> stat(
+    const std::string& hierarchy,
+    const std::string& cgroup,
+    const std::string& control);
+
+
+namespace pressure {
+
+// Whether a PSI line describes the time in which at least one
+// ("some") runnable task stalled on the resource, or in which all
+// ("full") of them did.
+enum class Type
+{
+  SOME,
+  FULL,
+};
+
+
+// One line of PSI (pressure stall information) data: the share of
+// wall-clock time, in percent, during which tasks stalled on the
+// resource over the trailing 10, 60 and 300 seconds, and the
+// cumulative stall time.
+struct Statistics
+{
+  double avg10;
+  double avg60;
+  double avg300;
+  Duration total;
+};
+
+
+// Parses the contents of a PSI pressure file (e.g., 'cpu.pressure').
+Try<Statistics> parse(const std::string& contents, Type type);
+
+
+// Reads the PSI pressure file of a cgroup for the given control
+// (e.g., 'cpu.pressure', 'memory.pressure', 'io.pressure').
+Try<Statistics> read(
+    const std::string& hierarchy,
+    const std::string& cgroup,
+    const std::string& control,
+    Type type);
+
+} // namespace pressure {
+
+} // namespace cgroups2 {
+
+#endif // __CGROUPS2_HPP__
@@ -14,14 +14,20 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <fcntl.h>
 #include <signal.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 
+#include <sys/ioctl.h>
 #include <sys/prctl.h>
+#include <sys/syscall.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 
+#include <linux/perf_event.h>
+
 #include <list>
 #include <sstream>
 #include <string>
@@ -36,7 +42,12 @@
 #include <process/process.hpp>
 #include <process/subprocess.hpp>
 
+#include <stout/foreach.hpp>
+#include <stout/none.hpp>
+#include <stout/numify.hpp>
+#include <stout/option.hpp>
 #include <stout/os.hpp>
+#include <stout/path.hpp>
 #include <stout/strings.hpp>
 
 #include <stout/os/signals.hpp>
@@ -56,6 +67,16 @@ using std::string;
 using std::tuple;
 using std::vector;
 
+// These perf_event_open(2) flags may be missing from older kernel
+// headers even though the running kernel supports them.
+#ifndef PERF_FLAG_PID_CGROUP
+#define PERF_FLAG_PID_CGROUP (1U << 2)
+#endif
+
+#ifndef PERF_FLAG_FD_CLOEXEC
+#define PERF_FLAG_FD_CLOEXEC (1U << 3)
+#endif
+
 namespace perf {
 
 // Delimiter for fields in perf stat output.
@@ -72,6 +93,145 @@ inline string normalize(const string& s)
 }
 
 
+// Maps a perf event name to the type and config accepted by
+// perf_event_open(2). Only the symbolic hardware, software and
+// hardware cache events that have a corresponding PerfStatistics
+// field are supported; dynamic (PMU-specific) and raw events are
+// not.
+static Try<perf_event_attr> attribute(const string& event)
+{
+  static const hashmap<string, uint64_t> hardware = {
+    {"cycles", PERF_COUNT_HW_CPU_CYCLES},
+    {"stalled-cycles-frontend", PERF_COUNT_HW_STALLED_CYCLES_FRONTEND},
+    {"stalled-cycles-backend", PERF_COUNT_HW_STALLED_CYCLES_BACKEND},
+    {"instructions", PERF_COUNT_HW_INSTRUCTIONS},
+    {"cache-references", PERF_COUNT_HW_CACHE_REFERENCES},
+    {"cache-misses", PERF_COUNT_HW_CACHE_MISSES},
+    {"branches", PERF_COUNT_HW_BRANCH_INSTRUCTIONS},
+    {"branch-misses", PERF_COUNT_HW_BRANCH_MISSES},
+    {"bus-cycles", PERF_COUNT_HW_BUS_CYCLES},
+    {"ref-cycles", PERF_COUNT_HW_REF_CPU_CYCLES},
+  };
+
+  static const hashmap<string, uint64_t> software = {
+    {"cpu-clock", PERF_COUNT_SW_CPU_CLOCK},
+    {"task-clock", PERF_COUNT_SW_TASK_CLOCK},
+    {"page-faults", PERF_COUNT_SW_PAGE_FAULTS},
+    {"minor-faults", PERF_COUNT_SW_PAGE_FAULTS_MIN},
+    {"major-faults", PERF_COUNT_SW_PAGE_FAULTS_MAJ},
+    {"context-switches", PERF_COUNT_SW_CONTEXT_SWITCHES},
+    {"cpu-migrations", PERF_COUNT_SW_CPU_MIGRATIONS},
+    {"alignment-faults", PERF_COUNT_SW_ALIGNMENT_FAULTS},
+    {"emulation-faults", PERF_COUNT_SW_EMULATION_FAULTS},
+  };
+
+  static const hashmap<string, uint64_t> caches = {
+    {"L1-dcache", PERF_COUNT_HW_CACHE_L1D},
+    {"L1-icache", PERF_COUNT_HW_CACHE_L1I},
+    {"LLC", PERF_COUNT_HW_CACHE_LL},
+    {"dTLB", PERF_COUNT_HW_CACHE_DTLB},
+    {"iTLB", PERF_COUNT_HW_CACHE_ITLB},
+    {"branch", PERF_COUNT_HW_CACHE_BPU},
+    {"node", PERF_COUNT_HW_CACHE_NODE},
+  };
+
+  // Cache operations, encoded into bits 8-23 of the config.
+  static const hashmap<string, uint64_t> operations = {
+    {"loads", PERF_COUNT_HW_CACHE_OP_READ << 8 |
+              PERF_COUNT_HW_CACHE_RESULT_ACCESS << 16},
+    {"load-misses", PERF_COUNT_HW_CACHE_OP_READ << 8 |
+                    PERF_COUNT_HW_CACHE_RESULT_MISS << 16},
+    {"stores", PERF_COUNT_HW_CACHE_OP_WRITE << 8 |
+               PERF_COUNT_HW_CACHE_RESULT_ACCESS << 16},
+    {"store-misses", PERF_COUNT_HW_CACHE_OP_WRITE << 8 |
+                     PERF_COUNT_HW_CACHE_RESULT_MISS << 16},
+    {"prefetches", PERF_COUNT_HW_CACHE_OP_PREFETCH << 8 |
+                   PERF_COUNT_HW_CACHE_RESULT_ACCESS << 16},
+    {"prefetch-misses", PERF_COUNT_HW_CACHE_OP_PREFETCH << 8 |
+                        PERF_COUNT_HW_CACHE_RESULT_MISS << 16},
+  };
+
+  perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+
+  if (hardware.contains(event)) {
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = hardware.at(event);
+    return attr;
+  }
+
+  if (software.contains(event)) {
+    attr.type = PERF_TYPE_SOFTWARE;
+    attr.config = software.at(event);
+    return attr;
+  }
+
+  foreachpair (const string& cache, uint64_t config, caches) {
+    if (strings::startsWith(event, cache + "-")) {
+      const string operation = event.substr(cache.size() + 1);
+
+      if (operations.contains(operation)) {
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = config | operations.at(operation);
+        return attr;
+      }
+    }
+  }
+
+  return Error("Unsupported perf event '" + event + "'");
+}
+
+
+// Returns the set of online CPUs, parsed from the range list in
+// sysfs (e.g., '0-2,4').
+static Try<vector<unsigned int>> cpus()
+{
+  Try<string> online = os::read("/sys/devices/system/cpu/online");
+  if (online.isError()) {
+    return Error("Failed to read the set of online CPUs: " + online.error());
+  }
+
+  vector<unsigned int> cpus;
+
+  foreach (const string& range,
+           strings::tokenize(strings::trim(online.get()), ",")) {
+    vector<string> bounds = strings::split(range, "-");
+
+    Option<Error> error = None();
+
+    if (bounds.size() == 1) {
+      Try<unsigned int> cpu = numify<unsigned int>(bounds[0]);
+      if (cpu.isError()) {
+        error = Error(cpu.error());
+      } else {
+        cpus.push_back(cpu.get());
+      }
+    } else if (bounds.size() == 2) {
+      Try<unsigned int> begin = numify<unsigned int>(bounds[0]);
+      Try<unsigned int> end = numify<unsigned int>(bounds[1]);
+
+      if (begin.isError() || end.isError()) {
+        error = Error(begin.isError() ? begin.error() : end.error());
+      } else {
+        for (unsigned int cpu = begin.get(); cpu <= end.get(); cpu++) {
+          cpus.push_back(cpu);
+        }
+      }
+    } else {
+      error = Error("Malformed range");
+    }
+
+    if (error.isSome()) {
+      return Error(
+          "Failed to parse CPU range '" + range + "': " + error->message);
+    }
+  }
+
+  return cpus;
+}
+
+
 // Executes the 'perf' command using the supplied arguments, and
 // returns stdout as the value of the future or a failure if calling
 // the command fails or the command returns a non-zero exit code.
@@ -192,6 +352,196 @@ private:
 } // namespace internal {
 
 
+Try<Owned<Counters>> Counters::create(
+    const set<string>& events,
+    const string& hierarchy,
+    const string& cgroup)
+{
+  vector<string> names;
+  vector<perf_event_attr> attributes;
+
+  foreach (const string& event, events) {
+    Try<perf_event_attr> attribute = internal::attribute(event);
+    if (attribute.isError()) {
+      return Error(attribute.error());
+    }
+
+    names.push_back(internal::normalize(event));
+    attributes.push_back(attribute.get());
+  }
+
+  if (names.empty()) {
+    return Error("No perf events provided");
+  }
+
+  Try<vector<unsigned int>> cpus = internal::cpus();
+  if (cpus.isError()) {
+    return Error(cpus.error());
+  }
+
+  Try<int> cgroupFd = os::open(
+      path::join(hierarchy, cgroup),
+      O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+  if (cgroupFd.isError()) {
+    return Error(
+        "Failed to open perf_event cgroup '" + cgroup + "'"
+        ": " + cgroupFd.error());
+  }
+
+  vector<int> leaders;
+  vector<int> fds;
+
+  auto cleanup = [&fds, &cgroupFd]() {
+    foreach (int fd, fds) {
+      os::close(fd);
+    }
+    os::close(cgroupFd.get());
+  };
+
+  foreach (unsigned int cpu, cpus.get()) {
+    int leader = -1;
+
+    for (size_t i = 0; i < attributes.size(); i++) {
+      perf_event_attr attribute = attributes[i];
+
+      // The group leader starts disabled and reads the whole group,
+      // along with the times the group was enabled and was actually
+      // on the PMU so counts can be scaled for multiplexing.
+      if (leader == -1) {
+        attribute.disabled = 1;
+        attribute.read_format =
+          PERF_FORMAT_GROUP |
+          PERF_FORMAT_TOTAL_TIME_ENABLED |
+          PERF_FORMAT_TOTAL_TIME_RUNNING;
+      }
+
+      int fd = ::syscall(
+          SYS_perf_event_open,
+          &attribute,
+          cgroupFd.get(),
+          cpu,
+          leader,
+          PERF_FLAG_PID_CGROUP | PERF_FLAG_FD_CLOEXEC);
+
+      if (fd == -1) {
+        ErrnoError error(
+            "Failed to open perf event '" + names[i] + "'"
+            " on CPU " + stringify(cpu));
+
+        cleanup();
+
+        return error;
+      }
+
+      if (leader == -1) {
+        leader = fd;
+        leaders.push_back(fd);
+      }
+
+      fds.push_back(fd);
+    }
+
+    // Start all counters in the group atomically.
+    if (::ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) == -1) {
+      ErrnoError error("Failed to enable perf counter group");
+
+      cleanup();
+
+      return error;
+    }
+  }
+
+  os::close(cgroupFd.get());
+
+  return Owned<Counters>(new Counters(names, leaders, fds));
+}
+
+
+Counters::~Counters()
+{
+  foreach (int fd, fds) {
+    os::close(fd);
+  }
+}
+
+
+Try<mesos::PerfStatistics> Counters::sample()
+{
+  vector<double> current(events.size(), 0.0);
+
+  foreach (int leader, leaders) {
+    // With the read format used by create() the kernel returns:
+    //   u64 nr; u64 time_enabled; u64 time_running; u64 values[nr];
+    vector<uint64_t> buffer(3 + events.size());
+
+    ssize_t size =
+      ::read(leader, buffer.data(), buffer.size() * sizeof(uint64_t));
+
+    if (size == -1) {
+      return ErrnoError("Failed to read perf counter group");
+    } else if (
+        size != static_cast<ssize_t>(buffer.size() * sizeof(uint64_t)) ||
+        buffer[0] != events.size()) {
+      return Error("Unexpected perf counter group layout");
+    }
+
+    // Scale the counts by the fraction of time the group was
+    // actually counting to correct for multiplexing.
+    double scale = 1.0;
+    if (buffer[2] != 0 && buffer[2] < buffer[1]) {
+      scale = static_cast<double>(buffer[1]) / buffer[2];
+    }
+
+    for (size_t i = 0; i < events.size(); i++) {
+      current[i] += buffer[3 + i] * scale;
+    }
+  }
+
+  Time now = Clock::now();
+
+  mesos::PerfStatistics statistics;
+  statistics.set_timestamp(previous.secs());
+  statistics.set_duration((now - previous).secs());
+
+  const google::protobuf::Reflection* reflection = statistics.GetReflection();
+  const google::protobuf::Descriptor* descriptor = statistics.GetDescriptor();
+
+  for (size_t i = 0; i < events.size(); i++) {
+    const google::protobuf::FieldDescriptor* field =
+      descriptor->FindFieldByName(events[i]);
+
+    if (field == nullptr) {
+      return Error("Unexpected perf event '" + events[i] + "'");
+    }
+
+    // The counters count monotonically; report the delta since the
+    // previous sample.
+    double value = current[i] - totals[i];
+
+    switch (field->type()) {
+      case google::protobuf::FieldDescriptor::TYPE_DOUBLE:
+        // The software clock events count nanoseconds; report
+        // milliseconds for consistency with 'perf stat' output.
+        reflection->SetDouble(&statistics, field, value / 1000000.0);
+        break;
+      case google::protobuf::FieldDescriptor::TYPE_UINT64:
+        reflection->SetUInt64(
+            &statistics, field, static_cast<uint64_t>(value));
+        break;
+      default:
+        return Error(
+            "Unsupported perf field type for event '" + events[i] + "'");
+    }
+  }
+
+  totals = current;
+  previous = now;
+
+  return statistics;
+}
+
+
 Future<Version> version()
 {
   internal::Perf* perf = new internal::Perf({"--version"});
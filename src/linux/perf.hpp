@@ -21,11 +21,16 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
+#include <process/clock.hpp>
 #include <process/future.hpp>
+#include <process/owned.hpp>
+#include <process/time.hpp>
 
 #include <stout/duration.hpp>
 #include <stout/hashmap.hpp>
+#include <stout/try.hpp>
 #include <stout/version.hpp>
 
 // For PerfStatistics protobuf.
@@ -33,6 +38,63 @@
 
 namespace perf {
 
+// In-process counting of perf events for the processes in a
+// perf_event cgroup, via the perf_event_open(2) system call. All
+// events are opened as a single counter group per online CPU, so
+// refreshing the counts costs one read(2) per CPU instead of forking
+// 'perf stat' for every sampling interval.
+class Counters
+{
+public:
+  // Opens counters for the given events, counting the processes in
+  // the given cgroup (relative to the perf_event hierarchy mount).
+  // Only the symbolic hardware, software and hardware cache events
+  // that have a corresponding PerfStatistics field are supported.
+  static Try<process::Owned<Counters>> create(
+      const std::set<std::string>& events,
+      const std::string& hierarchy,
+      const std::string& cgroup);
+
+  ~Counters();
+
+  Counters(const Counters&) = delete;
+  Counters& operator=(const Counters&) = delete;
+
+  // Returns statistics covering the interval since the previous call
+  // (or since the counters were opened). Counts are scaled by the
+  // fraction of time each group was actually on the PMU to correct
+  // for multiplexing.
+  Try<mesos::PerfStatistics> sample();
+
+private:
+  Counters(
+      const std::vector<std::string>& _events,
+      const std::vector<int>& _leaders,
+      const std::vector<int>& _fds)
+    : events(_events),
+      leaders(_leaders),
+      fds(_fds),
+      totals(_events.size(), 0.0),
+      previous(process::Clock::now()) {}
+
+  // Normalized event names, in the order in which their values
+  // appear in a group read.
+  const std::vector<std::string> events;
+
+  // Group leader file descriptor for each CPU.
+  const std::vector<int> leaders;
+
+  // All counter file descriptors, including the leaders.
+  const std::vector<int> fds;
+
+  // Cumulative (scaled) counts at the previous sample.
+  std::vector<double> totals;
+
+  // Time of the previous sample.
+  process::Time previous;
+};
+
+
 // Sample the perf events for process(es) in the perf_event cgroups
 // for duration. The returned hashmap is keyed by cgroup.
 // NOTE: cgroups should be relative to the perf_event subsystem mount,
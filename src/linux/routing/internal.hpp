@@ -26,6 +26,8 @@
 #include <string>
 
 #include <stout/error.hpp>
+#include <stout/none.hpp>
+#include <stout/option.hpp>
 #include <stout/try.hpp>
 
 namespace routing {
@@ -87,9 +89,23 @@ private:
 // socket is needed for most of the operations. The default protocol
 // of the netlink socket is NETLINK_ROUTE, but you can optionally
 // provide a different one.
+//
+// The NETLINK_ROUTE socket is allocated once per thread and shared
+// by all subsequent operations on that thread: allocating, binding
+// and tearing down a socket for every single operation dominates the
+// cost of callers that issue many operations in a row (e.g., the
+// port mapping isolator during container network setup). Netlink
+// sequence numbers make reuse within a thread safe, and the socket
+// is never shared across threads.
 // TODO(chzhcn): Consider renaming 'routing' to 'netlink'.
 inline Try<Netlink<struct nl_sock>> socket(int protocol = NETLINK_ROUTE)
 {
+  static thread_local Option<Netlink<struct nl_sock>> cached = None();
+
+  if (protocol == NETLINK_ROUTE && cached.isSome()) {
+    return cached.get();
+  }
+
   struct nl_sock* s = nl_socket_alloc();
   if (s == nullptr) {
     return Error("Failed to allocate netlink socket");
@@ -104,6 +120,10 @@ inline Try<Netlink<struct nl_sock>> socket(int protocol = NETLINK_ROUTE)
         std::string(nl_geterror(error)));
   }
 
+  if (protocol == NETLINK_ROUTE) {
+    cached = sock;
+  }
+
   return sock;
 }
 
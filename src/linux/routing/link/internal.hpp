@@ -61,18 +61,17 @@ inline Result<Netlink<struct rtnl_link>> get(const std::string& link)
     return Error(socket.error());
   }
 
-  // Dump all the netlink link objects from kernel. Note that the flag
-  // AF_UNSPEC means all available families.
-  struct nl_cache* c = nullptr;
-  int error = rtnl_link_alloc_cache(socket->get(), AF_UNSPEC, &c);
+  // Query just this link rather than dumping all the link objects
+  // from the kernel: this lookup is on the critical path of every
+  // routing library operation.
+  struct rtnl_link* l = nullptr;
+  int error = rtnl_link_get_kernel(socket->get(), 0, link.c_str(), &l);
   if (error != 0) {
-    return Error(nl_geterror(error));
-  }
+    if (error == -NLE_OBJ_NOTFOUND || error == -NLE_NODEV) {
+      return None();
+    }
 
-  Netlink<struct nl_cache> cache(c);
-  struct rtnl_link* l = rtnl_link_get_by_name(cache.get(), link.c_str());
-  if (l == nullptr) {
-    return None();
+    return Error(nl_geterror(error));
   }
 
   return Netlink<struct rtnl_link>(l);
@@ -88,18 +87,16 @@ inline Result<Netlink<struct rtnl_link>> get(int index)
     return Error(socket.error());
   }
 
-  // Dump all the netlink link objects from kernel. Note that the flag
-  // AF_UNSPEC means all available families.
-  struct nl_cache* c = nullptr;
-  int error = rtnl_link_alloc_cache(socket->get(), AF_UNSPEC, &c);
+  // Query just this link rather than dumping all the link objects
+  // from the kernel; see above.
+  struct rtnl_link* l = nullptr;
+  int error = rtnl_link_get_kernel(socket->get(), index, nullptr, &l);
   if (error != 0) {
-    return Error(nl_geterror(error));
-  }
+    if (error == -NLE_OBJ_NOTFOUND || error == -NLE_NODEV) {
+      return None();
+    }
 
-  Netlink<struct nl_cache> cache(c);
-  struct rtnl_link* l = rtnl_link_get(cache.get(), index);
-  if (l == nullptr) {
-    return None();
+    return Error(nl_geterror(error));
   }
 
   return Netlink<struct rtnl_link>(l);
@@ -497,7 +497,10 @@ PID<Master> launch(const Flags& flags, Allocator* _allocator)
 
     // Initialize SecretResolver.
     Try<SecretResolver*> secretResolver =
-      mesos::SecretResolver::create(slaveFlags.secret_resolver);
+      mesos::SecretResolver::create(
+          slaveFlags.secret_resolver,
+          slaveFlags.secret_resolver_cache_ttl,
+          slaveFlags.secret_resolver_negative_cache_ttl);
 
     if (secretResolver.isError()) {
       EXIT(EXIT_FAILURE)
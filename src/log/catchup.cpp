@@ -16,6 +16,7 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <list>
 
 #include <process/collect.hpp>
@@ -23,6 +24,7 @@
 #include <process/process.hpp>
 #include <process/timer.hpp>
 
+#include <stout/hashmap.hpp>
 #include <stout/lambda.hpp>
 #include <stout/stringify.hpp>
 
@@ -166,10 +168,20 @@ static Future<uint64_t> catchup(
 }
 
 
-// TODO(jieyu): Our current implementation catches-up each position in
-// the set sequentially. In the future, we may want to parallelize it
-// to improve the performance. Also, we may want to implement rate
-// control here so that we don't saturate the network or disk.
+// Maximum number of positions that are caught-up concurrently during
+// bulk catch-up. This bounds the load we put on the network and on
+// the replicas' disks while a recovering replica rejoins.
+static const size_t WINDOW = 16;
+
+
+// Catches-up a contiguous range of positions using a bounded sliding
+// window of concurrent per-position catch-ups, so that the time taken
+// is dominated by overlapped (rather than summed) round trips to the
+// replicas. The window also serves as rate control so that we don't
+// saturate the network or disk. Positions that have already been
+// learned locally complete without going to the network at all;
+// contested positions go through a full per-position Paxos round (see
+// 'log::fill').
 class BulkCatchUpProcess : public Process<BulkCatchUpProcess>
 {
 public:
@@ -199,17 +211,18 @@ protected:
     promise.future().onDiscard(lambda::bind(
         static_cast<void(*)(const UPID&, bool)>(terminate), self(), true));
 
-    // Catch-up sequentially.
-    current = positions.lower();
+    next = positions.lower();
 
     catchup();
   }
 
   void finalize() override
   {
-    catching.discard();
+    foreachvalue (Future<uint64_t> catching, catchings) {
+      catching.discard();
+    }
 
-    // TODO(benh): Discard our promise only after 'catching' has
+    // TODO(benh): Discard our promise only after all 'catchings' have
     // completed (ready, failed, or discarded).
     promise.discard();
   }
@@ -222,52 +235,62 @@ private:
 
   void catchup()
   {
-    if (current >= positions.upper()) {
+    // Fill up the window of concurrent per-position catch-ups.
+    while (next < positions.upper() && catchings.size() < WINDOW) {
+      launch(next++);
+    }
+
+    if (catchings.empty()) {
       // Stop the process if there is nothing left to catch-up. This
       // also handles the case where the input interval is empty.
       promise.set(Nothing());
       terminate(self());
-      return;
     }
+  }
 
+  void launch(uint64_t position)
+  {
     // Store the future so that we can discard it if the user wants to
     // cancel the catch-up operation.
-    catching = log::catchup(quorum, replica, network, proposal, current)
-      .onDiscarded(defer(self(), &Self::discarded))
-      .onFailed(defer(self(), &Self::failed))
-      .onReady(defer(self(), &Self::succeeded));
+    Future<uint64_t> catching =
+      log::catchup(quorum, replica, network, proposal, position)
+        .onDiscarded(defer(self(), &Self::discarded, position))
+        .onFailed(defer(self(), &Self::failed, position))
+        .onReady(defer(self(), &Self::succeeded, position));
+
+    catchings.put(position, catching);
 
     Clock::timer(timeout, lambda::bind(&Self::timedout, catching));
   }
 
-
-  void discarded()
+  void discarded(uint64_t position)
   {
-    LOG(INFO) << "Unable to catch-up position " << current
+    LOG(INFO) << "Unable to catch-up position " << position
               << " in " << timeout << ", retrying";
 
-    catchup();
+    launch(position);
   }
 
-  void failed()
+  void failed(uint64_t position)
   {
     promise.fail(
-        "Failed to catch-up position " + stringify(current) +
-        ": " + catching.failure());
+        "Failed to catch-up position " + stringify(position) +
+        ": " + catchings[position].failure());
 
     terminate(self());
   }
 
-  void succeeded()
+  void succeeded(uint64_t position)
   {
-    ++current;
-
     // The single position catch-up function: 'log::catchup' will
     // return the highest proposal number seen so far. We use this
-    // proposal number for the next 'catchup' as it is highly likely
+    // proposal number for subsequent catch-ups as it is highly likely
     // that this number is high enough, saving potentially unnecessary
-    // proposal number bumps.
-    proposal = catching.get();
+    // proposal number bumps. Note that concurrent catch-ups can
+    // complete in any order, so we only ever raise the number.
+    proposal = std::max(proposal, catchings[position].get());
+
+    catchings.erase(position);
 
     catchup();
   }
@@ -279,10 +302,14 @@ private:
   const Duration timeout;
 
   uint64_t proposal;
-  uint64_t current;
+
+  // The next position to launch a catch-up for.
+  uint64_t next;
 
   process::Promise<Nothing> promise;
-  Future<uint64_t> catching;
+
+  // Catch-ups currently in flight, keyed by position.
+  hashmap<uint64_t, Future<uint64_t>> catchings;
 };
 
 
@@ -25,6 +25,8 @@
 #include <process/id.hpp>
 #include <process/process.hpp>
 
+#include <stout/foreach.hpp>
+#include <stout/hashmap.hpp>
 #include <stout/none.hpp>
 
 #include "log/catchup.hpp"
@@ -68,7 +70,10 @@ protected:
   void finalize() override
   {
     electing.discard();
-    writing.discard();
+
+    foreachvalue (Future<Option<uint64_t>> writing, writings) {
+      writing.discard();
+    }
   }
 
 private:
@@ -99,10 +104,10 @@ private:
       const WriteResponse& response);
   Future<Nothing> runLearnPhase(const Action& action);
   Future<bool> checkLearnPhase(const Action& action);
-  Future<Option<uint64_t>> updateIndexAfterWritten(bool missing);
-  void writingFinished();
-  void writingFailed();
-  void writingAborted();
+  Future<Option<uint64_t>> checkWritten(uint64_t position, bool missing);
+  void writingFinished(uint64_t position);
+  void writingFailed(uint64_t position);
+  void writingAborted(uint64_t position);
 
   const size_t quorum;
   const Shared<Replica> replica;
@@ -121,7 +126,7 @@ private:
     INITIAL,
     ELECTING,
     ELECTED,
-    WRITING,
+    WRITING, // At least one write (append or truncate) is in flight.
   } state;
 
   // The current proposal number used by this coordinator.
@@ -131,7 +136,12 @@ private:
   uint64_t index;
 
   Future<Option<uint64_t>> electing;
-  Future<Option<uint64_t>> writing;
+
+  // In-flight writes, keyed by position. Each position is an
+  // independent Paxos instance, so multiple writes can safely be
+  // pipelined: a new write does not need to wait for the previous
+  // round trip to the replicas to finish.
+  hashmap<uint64_t, Future<Option<uint64_t>>> writings;
 };
 
 
@@ -307,8 +317,6 @@ Future<Option<uint64_t>> CoordinatorProcess::append(const string& bytes)
 {
   if (state == INITIAL || state == ELECTING) {
     return None();
-  } else if (state == WRITING) {
-    return Failure("Coordinator is currently writing");
   }
 
   Action action;
@@ -327,8 +335,6 @@ Future<Option<uint64_t>> CoordinatorProcess::truncate(uint64_t to)
 {
   if (state == INITIAL || state == ELECTING) {
     return None();
-  } else if (state == WRITING) {
-    return Failure("Coordinator is currently writing");
   }
 
   Action action;
@@ -348,16 +354,27 @@ Future<Option<uint64_t>> CoordinatorProcess::write(const Action& action)
   LOG(INFO) << "Coordinator attempting to write " << action.type()
             << " action at position " << action.position();
 
-  CHECK_EQ(state, ELECTED);
+  CHECK(state == ELECTED || state == WRITING) << "Unexpected state " << state;
   CHECK(action.has_performed() && action.has_type());
 
   state = WRITING;
 
-  writing = runWritePhase(action)
-    .then(defer(self(), &Self::checkWritePhase, action, lambda::_1))
-    .onReady(defer(self(), &Self::writingFinished))
-    .onFailed(defer(self(), &Self::writingFailed))
-    .onDiscarded(defer(self(), &Self::writingAborted));
+  // Reserve the position now so that a subsequent write can be
+  // pipelined at the next position without waiting for this round
+  // trip to the replicas to finish.
+  const uint64_t position = action.position();
+  CHECK_EQ(position, index);
+  index++;
+
+  Future<Option<uint64_t>> writing = runWritePhase(action)
+    .then(defer(self(), &Self::checkWritePhase, action, lambda::_1));
+
+  writings.put(position, writing);
+
+  writing
+    .onReady(defer(self(), &Self::writingFinished, position))
+    .onFailed(defer(self(), &Self::writingFailed, position))
+    .onDiscarded(defer(self(), &Self::writingAborted, position));
 
   return writing;
 }
@@ -374,16 +391,18 @@ Future<Option<uint64_t>> CoordinatorProcess::checkWritePhase(
     const WriteResponse& response)
 {
   if (!response.okay()) {
-    // Received a NACK. Save the proposal number.
-    CHECK_LE(proposal, response.proposal());
-    proposal = response.proposal();
+    // Received a NACK. Save the proposal number. Note that with
+    // pipelined writes, NACKs for multiple in-flight positions may
+    // arrive in any order, so a later NACK may carry a smaller
+    // proposal number than one we have already saved.
+    proposal = std::max(proposal, response.proposal());
 
     return None();
   }
 
   return runLearnPhase(action)
     .then(defer(self(), &Self::checkLearnPhase, action))
-    .then(defer(self(), &Self::updateIndexAfterWritten, lambda::_1));
+    .then(defer(self(), &Self::checkWritten, action.position(), lambda::_1));
 }
 
 
@@ -402,39 +421,54 @@ Future<bool> CoordinatorProcess::checkLearnPhase(const Action& action)
 }
 
 
-Future<Option<uint64_t>> CoordinatorProcess::updateIndexAfterWritten(
+Future<Option<uint64_t>> CoordinatorProcess::checkWritten(
+    uint64_t position,
     bool missing)
 {
   CHECK(!missing) << "Not expecting local replica to be missing position "
-                  << index << " after the writing is done";
+                  << position << " after the writing is done";
 
-  return index++;
+  return Option<uint64_t>(position);
 }
 
 
-void CoordinatorProcess::writingFinished()
+void CoordinatorProcess::writingFinished(uint64_t position)
 {
-  CHECK_EQ(state, WRITING);
-  state = ELECTED;
+  writings.erase(position);
+
+  // An earlier pipelined write may have failed or been aborted (and
+  // demoted the coordinator), in which case we should not transition
+  // back to ELECTED.
+  if (state == WRITING && writings.empty()) {
+    state = ELECTED;
+  }
 }
 
 
-void CoordinatorProcess::writingFailed()
+void CoordinatorProcess::writingFailed(uint64_t position)
 {
-  CHECK_EQ(state, WRITING);
-  state = INITIAL;
+  writings.erase(position);
+
+  // Demote the coordinator. Note that we ignore stale failures that
+  // arrive after the coordinator has already been demoted (and has
+  // possibly started a new election).
+  if (state == WRITING) {
+    state = INITIAL;
+  }
 }
 
 
-void CoordinatorProcess::writingAborted()
+void CoordinatorProcess::writingAborted(uint64_t position)
 {
-  CHECK_EQ(state, WRITING);
+  writings.erase(position);
 
   // Demote the coordinator if a write operation is discarded since we
   // don't actually know the write was successful or not and we really
   // need to "catch-up" that position before we try and do another
   // write (see MESOS-1038 for more details).
-  state = INITIAL;
+  if (state == WRITING) {
+    state = INITIAL;
+  }
 }
 
 
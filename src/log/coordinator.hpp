@@ -60,7 +60,10 @@ public:
 
   // Appends the specified bytes to the end of the log. Returns the
   // position of the appended entry if the operation succeeds or none
-  // if the coordinator was demoted.
+  // if the coordinator was demoted. Writes are pipelined: an append
+  // issued while earlier writes are still in flight is assigned the
+  // next position immediately, so throughput is bounded by overlapped
+  // (rather than summed) round trips to the replicas.
   process::Future<Option<uint64_t>> append(const std::string& bytes);
 
   // Removes all log entries preceding the log entry at the given
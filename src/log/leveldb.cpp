@@ -23,8 +23,11 @@
 
 #include <stdint.h>
 
+#include <list>
+
 #include <stout/check.hpp>
 #include <stout/error.hpp>
+#include <stout/foreach.hpp>
 #include <stout/numify.hpp>
 #include <stout/stopwatch.hpp>
 #include <stout/strings.hpp>
@@ -32,6 +35,7 @@
 
 #include "log/leveldb.hpp"
 
+using std::list;
 using std::string;
 
 namespace mesos {
@@ -126,8 +130,8 @@ static string encode(uint64_t position, bool adjust = true)
 // }
 
 
-LevelDBStorage::LevelDBStorage()
-  : db(nullptr), first(None())
+LevelDBStorage::LevelDBStorage(bool _sync)
+  : db(nullptr), sync(_sync), first(None())
 {
   // Nothing to see here.
 }
@@ -289,7 +293,7 @@ Try<Nothing> LevelDBStorage::persist(const Metadata& metadata)
   stopwatch.start();
 
   leveldb::WriteOptions options;
-  options.sync = true;
+  options.sync = sync;
 
   Record record;
   record.set_type(Record::METADATA);
@@ -316,23 +320,47 @@ Try<Nothing> LevelDBStorage::persist(const Metadata& metadata)
 
 Try<Nothing> LevelDBStorage::persist(const Action& action)
 {
+  list<Action> actions;
+  actions.push_back(action);
+
+  return persist(actions);
+}
+
+
+Try<Nothing> LevelDBStorage::persist(const list<Action>& actions)
+{
+  CHECK(!actions.empty());
+
   Stopwatch stopwatch;
   stopwatch.start();
 
-  Record record;
-  record.set_type(Record::ACTION);
-  record.mutable_action()->MergeFrom(action);
+  // Accumulate all the records into a single batch so that the whole
+  // group becomes durable with one sync, amortizing the fsync cost
+  // across the actions in the group.
+  leveldb::WriteBatch writes;
 
-  string value;
+  size_t bytes = 0;
 
-  if (!record.SerializeToString(&value)) {
-    return Error("Failed to serialize record");
+  foreach (const Action& action, actions) {
+    Record record;
+    record.set_type(Record::ACTION);
+    record.mutable_action()->MergeFrom(action);
+
+    string value;
+
+    if (!record.SerializeToString(&value)) {
+      return Error("Failed to serialize record");
+    }
+
+    bytes += value.size();
+
+    writes.Put(encode(action.position()), value);
   }
 
   leveldb::WriteOptions options;
-  options.sync = true;
+  options.sync = sync;
 
-  leveldb::Status status = db->Put(options, encode(action.position()), value);
+  leveldb::Status status = db->Write(options, &writes);
 
   if (!status.ok()) {
     return Error(status.ToString());
@@ -342,30 +370,34 @@ Try<Nothing> LevelDBStorage::persist(const Action& action)
   // of checking 'isNone()' because it's likely that log entries are
   // written out of order during catch-up (e.g. if a random bulk
   // catch-up policy is used).
-  first = min(first, action.position());
+  foreach (const Action& action, actions) {
+    first = min(first, action.position());
+  }
 
-  VLOG(1) << "Persisting action (" << value.size()
+  VLOG(1) << "Persisting " << actions.size() << " action(s) (" << bytes
           << " bytes) to leveldb took " << stopwatch.elapsed();
 
   Option<uint64_t> truncateTo;
 
-  // Delete positions if a truncate action has been *learned*.
-  if (action.has_type() && action.type() == Action::TRUNCATE &&
-      action.has_learned() && action.learned()) {
-    CHECK(action.has_truncate());
-    truncateTo = action.truncate().to();
-  }
+  foreach (const Action& action, actions) {
+    // Delete positions if a truncate action has been *learned*.
+    if (action.has_type() && action.type() == Action::TRUNCATE &&
+        action.has_learned() && action.learned()) {
+      CHECK(action.has_truncate());
+      truncateTo = max(truncateTo, action.truncate().to());
+    }
 
-  // Delete positions if a tombstone NOP action has been *learned*.
-  if (action.has_type() && action.type() == Action::NOP &&
-      action.nop().has_tombstone() && action.nop().tombstone() &&
-      action.has_learned() && action.learned()) {
-    // We truncate the log up to the tombstone position instead of the
-    // next one to allow the recovery code to see the tombstone and
-    // learn about the truncation. It's OK to persist a tombstone NOP,
-    // because eventually we'll remove it once we see the actual
-    // TRUNCATE action.
-    truncateTo = action.position();
+    // Delete positions if a tombstone NOP action has been *learned*.
+    if (action.has_type() && action.type() == Action::NOP &&
+        action.nop().has_tombstone() && action.nop().tombstone() &&
+        action.has_learned() && action.learned()) {
+      // We truncate the log up to the tombstone position instead of the
+      // next one to allow the recovery code to see the tombstone and
+      // learn about the truncation. It's OK to persist a tombstone NOP,
+      // because eventually we'll remove it once we see the actual
+      // TRUNCATE action.
+      truncateTo = max(truncateTo, action.position());
+    }
   }
 
   // Delete truncated positions. Note that we do this in a best-effort
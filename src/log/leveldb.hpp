@@ -21,6 +21,8 @@
 
 #include <stdint.h>
 
+#include <list>
+
 #include <stout/option.hpp>
 
 #include "log/storage.hpp"
@@ -33,17 +35,24 @@ namespace log {
 class LevelDBStorage : public Storage
 {
 public:
-  LevelDBStorage();
+  // If 'sync' is false, writes are acknowledged without being synced
+  // to disk first. This trades durability for speed and is only
+  // intended for benchmarking (see 'mesos-log benchmark').
+  explicit LevelDBStorage(bool sync = true);
   ~LevelDBStorage() override;
 
   Try<State> restore(const std::string& path) override;
   Try<Nothing> persist(const Metadata& metadata) override;
   Try<Nothing> persist(const Action& action) override;
+  Try<Nothing> persist(const std::list<Action>& actions) override;
   Try<Action> read(uint64_t position) override;
 
 private:
   leveldb::DB* db;
 
+  // Whether to sync writes to disk before acknowledging them.
+  const bool sync;
+
   // First position still in leveldb, used during truncation.
   Option<uint64_t> first;
 };
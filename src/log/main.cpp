@@ -26,6 +26,7 @@
 
 #include "log/tool.hpp"
 #include "log/tool/benchmark.hpp"
+#include "log/tool/compact.hpp"
 #include "log/tool/initialize.hpp"
 #include "log/tool/read.hpp"
 #include "log/tool/replica.hpp"
@@ -68,6 +69,7 @@ int main(int argc, char** argv)
 {
   // Register log tools.
   add(Owned<tool::Tool>(new tool::Benchmark()));
+  add(Owned<tool::Tool>(new tool::Compact()));
   add(Owned<tool::Tool>(new tool::Initialize()));
   add(Owned<tool::Tool>(new tool::Read()));
   add(Owned<tool::Tool>(new tool::Replica()));
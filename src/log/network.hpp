@@ -242,16 +242,27 @@ public:
       const M& m,
       const std::set<process::UPID>& filter)
   {
+    // Serialize the message once rather than once per member.
+    std::string data;
+    m.SerializeToString(&data);
+
+    std::set<process::UPID> members;
+
     std::set<process::UPID>::const_iterator iterator;
     for (iterator = pids.begin(); iterator != pids.end(); ++iterator) {
       const process::UPID& pid = *iterator;
       if (filter.count(pid) == 0) {
-        // NOTE: Just send this message as the network process itself
-        // since we don't need to deliver responses back to the caller.
-        // Incoming messages addressed to the network are simply dropped.
-        send(pid, m);
+        members.insert(pid);
       }
     }
+
+    // NOTE: Just send this message as the network process itself
+    // since we don't need to deliver responses back to the caller.
+    // Incoming messages addressed to the network are simply dropped.
+    // All the members share a single refcounted copy of the
+    // serialized message.
+    send(members, m.GetTypeName(), data.data(), data.size());
+
     return Nothing();
   }
 
@@ -62,8 +62,10 @@ class ReplicaProcess : public ProtobufProcess<ReplicaProcess>
 {
 public:
   // Constructs a new replica process using specified path to a
-  // directory for storing the underlying log.
-  explicit ReplicaProcess(const string& path);
+  // directory for storing the underlying log. Takes ownership of
+  // 'storage'; if 'storage' is null the default storage engine
+  // (leveldb) is used.
+  ReplicaProcess(const string& path, Storage* storage);
 
   ~ReplicaProcess() override;
 
@@ -117,10 +119,22 @@ private:
   // Handles a message notifying of a learned action.
   void learned(const UPID& from, const Action& action);
 
-  // Persists the specified action to storage. Returns true on success
-  // and false otherwise.
+  // Persists the specified action to storage, together with any
+  // learned actions that are still waiting to be written (so that the
+  // whole group shares a single sync). Returns true on success and
+  // false otherwise.
   bool persist(const Action& action);
 
+  // Writes all enqueued learned actions (if any) to storage with a
+  // single sync. This is invoked before reading any replica state so
+  // that enqueued actions are never observable as missing. Returns
+  // true on success and false otherwise.
+  bool flush();
+
+  // Updates the in-memory bookkeeping (holes, unlearned positions,
+  // beginning and ending positions) to reflect a persisted action.
+  void updatePositions(const Action& action);
+
   // Updates the highest promise this replica has given. The update
   // will be persisted to storage. Returns true on success and false
   // otherwise.
@@ -147,16 +161,24 @@ private:
 
   // Unlearned positions in the log.
   IntervalSet<uint64_t> unlearned;
+
+  // Learned actions that have been received but not yet written to
+  // storage. See the comment in 'learned' for why deferring these
+  // writes is safe.
+  list<Action> pending;
 };
 
 
-ReplicaProcess::ReplicaProcess(const string& path)
+ReplicaProcess::ReplicaProcess(const string& path, Storage* _storage)
   : ProcessBase(ID::generate("log-replica")),
     begin(0),
     end(0)
 {
-  // TODO(benh): Factor out and expose storage.
-  storage = new LevelDBStorage();
+  if (_storage != nullptr) {
+    storage = _storage;
+  } else {
+    storage = new LevelDBStorage();
+  }
 
   restore(path);
 
@@ -207,6 +229,8 @@ Result<Action> ReplicaProcess::read(uint64_t position)
 // the future semantics to not include failures.
 Future<list<Action>> ReplicaProcess::read(uint64_t from, uint64_t to)
 {
+  flush(); // Make sure any enqueued learned actions are observable.
+
   if (to < from) {
     process::Promise<list<Action>> promise;
     promise.fail("Bad read range (to < from)");
@@ -244,6 +268,8 @@ Future<list<Action>> ReplicaProcess::read(uint64_t from, uint64_t to)
 
 bool ReplicaProcess::missing(uint64_t position)
 {
+  flush(); // Make sure any enqueued learned actions are observable.
+
   if (position < begin) {
     return false; // Truncated positions are treated as learned.
   } else if (position > end) {
@@ -257,6 +283,8 @@ bool ReplicaProcess::missing(uint64_t position)
 // TODO(jieyu): Allow this method to take an Interval.
 IntervalSet<uint64_t> ReplicaProcess::missing(uint64_t from, uint64_t to)
 {
+  flush(); // Make sure any enqueued learned actions are observable.
+
   if (from > to) {
     // Empty interval.
     return IntervalSet<uint64_t>();
@@ -284,12 +312,16 @@ IntervalSet<uint64_t> ReplicaProcess::missing(uint64_t from, uint64_t to)
 
 uint64_t ReplicaProcess::beginning()
 {
+  flush(); // Make sure any enqueued learned actions are observable.
+
   return begin;
 }
 
 
 uint64_t ReplicaProcess::ending()
 {
+  flush(); // Make sure any enqueued learned actions are observable.
+
   return end;
 }
 
@@ -308,6 +340,9 @@ uint64_t ReplicaProcess::promised()
 
 bool ReplicaProcess::update(const Metadata::Status& status)
 {
+  // Preserve the ordering of writes to storage.
+  flush();
+
   Metadata metadata_;
   metadata_.set_status(status);
   metadata_.set_promised(promised());
@@ -373,6 +408,10 @@ bool ReplicaProcess::updatePromised(uint64_t promised)
 
 void ReplicaProcess::promise(const UPID& from, const PromiseRequest& request)
 {
+  // Make sure any enqueued learned actions are observable before we
+  // read replica state below.
+  flush();
+
   // Ignore promise requests if this replica is not in VOTING status;
   // we also inform the requester, so that they can retry promptly.
   if (status() != Metadata::VOTING) {
@@ -523,6 +562,10 @@ void ReplicaProcess::promise(const UPID& from, const PromiseRequest& request)
 
 void ReplicaProcess::write(const UPID& from, const WriteRequest& request)
 {
+  // Make sure any enqueued learned actions are observable before we
+  // read replica state below.
+  flush();
+
   // Ignore write requests if this replica is not in VOTING status; we
   // also inform the requester, so that they can retry promptly.
   if (status() != Metadata::VOTING) {
@@ -674,6 +717,8 @@ void ReplicaProcess::write(const UPID& from, const WriteRequest& request)
 
 void ReplicaProcess::recover(const UPID& from, const RecoverRequest& request)
 {
+  flush(); // Make sure any enqueued learned actions are observable.
+
   LOG(INFO) << "Replica in " << status()
             << " status received a broadcasted recover request from "
             << from;
@@ -696,22 +741,61 @@ void ReplicaProcess::learned(const UPID& from, const Action& action)
             << action.position() << " from " << from;
 
   CHECK(action.learned());
-  persist(action);
+
+  // Rather than writing each learned action to storage as it
+  // arrives, we enqueue it and write the whole group out with a
+  // single sync once the mailbox has drained (or earlier, if a
+  // subsequent request needs to observe the action). Learned notices
+  // require no response and arrive in large bursts during catch-up,
+  // where one fsync per action is the dominant cost. Deferring them
+  // is safe because an enqueued action that is lost (e.g., if we
+  // terminate before flushing) is indistinguishable from a learned
+  // message lost in transit, which the protocol already tolerates.
+  if (pending.empty()) {
+    dispatch(self(), &ReplicaProcess::flush);
+  }
+
+  pending.push_back(action);
 }
 
 
 bool ReplicaProcess::persist(const Action& action)
 {
-  Try<Nothing> persisted = storage->persist(action);
+  pending.push_back(action);
+
+  return flush();
+}
+
+
+bool ReplicaProcess::flush()
+{
+  if (pending.empty()) {
+    return true; // An earlier request has already forced a flush.
+  }
+
+  list<Action> actions;
+  actions.swap(pending);
+
+  Try<Nothing> persisted = storage->persist(actions);
 
   if (persisted.isError()) {
     LOG(ERROR) << "Error writing to log: " << persisted.error();
     return false;
   }
 
-  VLOG(1) << "Persisted action " << action.type()
-          << " at position " << action.position();
+  foreach (const Action& action, actions) {
+    VLOG(1) << "Persisted action " << action.type()
+            << " at position " << action.position();
+
+    updatePositions(action);
+  }
+
+  return true;
+}
 
+
+void ReplicaProcess::updatePositions(const Action& action)
+{
   // No longer a hole here (if there even was one).
   holes -= action.position();
 
@@ -761,8 +845,6 @@ bool ReplicaProcess::persist(const Action& action)
 
   // And update the end position.
   end = std::max(end, action.position());
-
-  return true;
 }
 
 
@@ -800,8 +882,12 @@ void ReplicaProcess::restore(const string& path)
 
 
 Replica::Replica(const string& path)
+  : Replica(path, nullptr) {}
+
+
+Replica::Replica(const string& path, Storage* storage)
 {
-  process = new ReplicaProcess(path);
+  process = new ReplicaProcess(path, storage);
   spawn(process);
 }
 
@@ -44,8 +44,9 @@ extern Protocol<RecoverRequest, RecoverResponse> recover;
 } // namespace protocol {
 
 
-// Forward declaration.
+// Forward declarations.
 class ReplicaProcess;
+class Storage;
 
 
 class Replica
@@ -58,6 +59,10 @@ public:
   // process will later decide if this replica can be re-allowed to
   // vote depending on the status of other replicas.
   explicit Replica(const std::string& path);
+
+  // Same as above, but uses the specified storage engine rather than
+  // the default (leveldb). Takes ownership of 'storage'.
+  Replica(const std::string& path, Storage* storage);
   virtual ~Replica();
 
   // Returns all the actions between the specified positions, unless
@@ -19,6 +19,7 @@
 
 #include <stdint.h>
 
+#include <list>
 #include <string>
 
 #include <stout/interval.hpp>
@@ -53,6 +54,13 @@ public:
   virtual Try<State> restore(const std::string& path) = 0;
   virtual Try<Nothing> persist(const Metadata& metadata) = 0;
   virtual Try<Nothing> persist(const Action& action) = 0;
+
+  // Persists the specified group of actions atomically, syncing to
+  // the underlying storage only once for the entire group. Callers
+  // that have multiple actions available should prefer this over
+  // persisting the actions one at a time in order to amortize the
+  // cost of the sync. The group must not be empty.
+  virtual Try<Nothing> persist(const std::list<Action>& actions) = 0;
   virtual Try<Action> read(uint64_t position) = 0;
 };
 
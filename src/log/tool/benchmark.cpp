@@ -14,6 +14,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -36,6 +37,9 @@
 #include <stout/strings.hpp>
 #include <stout/os/read.hpp>
 
+#include "log/leveldb.hpp"
+#include "log/storage.hpp"
+
 #include "log/tool/initialize.hpp"
 #include "log/tool/benchmark.hpp"
 
@@ -78,7 +82,9 @@ Benchmark::Flags::Flags()
   add(&Flags::input,
       "input",
       "Path to the input trace file. Each line in the trace file\n"
-      "specifies the size of the append (e.g. 100B, 2MB, etc.)");
+      "specifies the size of the append (e.g. 100B, 2MB, etc.).\n"
+      "If not specified, append sizes are generated from --appends\n"
+      "and --distribution instead");
 
   add(&Flags::output,
       "output",
@@ -96,6 +102,47 @@ Benchmark::Flags::Flags()
       "initialize",
       "Whether to initialize the log",
       true);
+
+  add(&Flags::appends,
+      "appends",
+      "Number of appends to perform when no trace file is given");
+
+  add(&Flags::distribution,
+      "distribution",
+      "Distribution of the append sizes when no trace file is\n"
+      "given (fixed, uniform)\n"
+      "  fixed:   all appends are --size bytes\n"
+      "  uniform: sizes are drawn uniformly between --min_size\n"
+      "           and --max_size\n",
+      "fixed");
+
+  add(&Flags::size,
+      "size",
+      "Size of each append for the 'fixed' distribution",
+      Kilobytes(1));
+
+  add(&Flags::min_size,
+      "min_size",
+      "Smallest append size for the 'uniform' distribution",
+      Bytes(1));
+
+  add(&Flags::max_size,
+      "max_size",
+      "Largest append size for the 'uniform' distribution",
+      Megabytes(1));
+
+  add(&Flags::storage_only,
+      "storage_only",
+      "Whether to benchmark the local storage layer directly,\n"
+      "bypassing quorum writes. In this mode only --path is\n"
+      "required and --sync controls the write durability",
+      false);
+
+  add(&Flags::sync,
+      "sync",
+      "Whether writes are synced to disk before being acknowledged.\n"
+      "Only applies with --storage_only",
+      true);
 }
 
 
@@ -131,86 +178,77 @@ Try<Nothing> Benchmark::execute(int argc, char** argv)
     }
   }
 
-  if (flags.quorum.isNone()) {
-    return Error(flags.usage("Missing required option --quorum"));
-  }
-
   if (flags.path.isNone()) {
     return Error(flags.usage("Missing required option --path"));
   }
 
-  if (flags.servers.isNone()) {
-    return Error(flags.usage("Missing required option --servers"));
-  }
+  if (!flags.storage_only) {
+    if (flags.quorum.isNone()) {
+      return Error(flags.usage("Missing required option --quorum"));
+    }
+
+    if (flags.servers.isNone()) {
+      return Error(flags.usage("Missing required option --servers"));
+    }
 
-  if (flags.znode.isNone()) {
-    return Error(flags.usage("Missing required option --znode"));
+    if (flags.znode.isNone()) {
+      return Error(flags.usage("Missing required option --znode"));
+    }
   }
 
-  if (flags.input.isNone()) {
-    return Error(flags.usage("Missing required option --input"));
+  if (flags.input.isNone() && flags.appends.isNone()) {
+    return Error(flags.usage("One of --input or --appends is required"));
   }
 
   if (flags.output.isNone()) {
     return Error(flags.usage("Missing required option --output"));
   }
 
-  // Initialize the log.
-  if (flags.initialize) {
-    Initialize initialize;
-    initialize.flags.path = flags.path;
-
-    Try<Nothing> execution = initialize.execute();
-    if (execution.isError()) {
-      return Error(execution.error());
-    }
-  }
-
-  // Create the log.
-  Log log(
-      flags.quorum.get(),
-      flags.path.get(),
-      flags.servers.get(),
-      Seconds(10),
-      flags.znode.get());
-
-  // Create the log writer.
-  Log::Writer writer(&log);
-
-  Future<Option<Log::Position>> position = writer.start();
-
-  if (!position.await(Seconds(15))) {
-    return Error("Failed to start a log writer: timed out");
-  } else if (!position.isReady()) {
-    return Error("Failed to start a log writer: " +
-                 (position.isFailed()
-                  ? position.failure()
-                  : "Discarded future"));
-  }
-
   // Statistics to output.
   vector<Bytes> sizes;
   vector<Duration> durations;
   vector<Time> timestamps;
 
-  // Read sizes from the input trace file.
-  ifstream input(flags.input->c_str());
-  if (!input.is_open()) {
-    return Error("Failed to open the trace file " + flags.input.get());
-  }
+  if (flags.input.isSome()) {
+    // Read sizes from the input trace file.
+    ifstream input(flags.input->c_str());
+    if (!input.is_open()) {
+      return Error("Failed to open the trace file " + flags.input.get());
+    }
 
-  string line;
-  while (getline(input, line)) {
-    Try<Bytes> size = Bytes::parse(strings::trim(line));
-    if (size.isError()) {
-      return Error("Failed to parse the trace file: " + size.error());
+    string line;
+    while (getline(input, line)) {
+      Try<Bytes> size = Bytes::parse(strings::trim(line));
+      if (size.isError()) {
+        return Error("Failed to parse the trace file: " + size.error());
+      }
+
+      sizes.push_back(size.get());
     }
 
-    sizes.push_back(size.get());
+    input.close();
+  } else {
+    // Generate sizes from the configured distribution.
+    if (flags.distribution == "uniform") {
+      if (flags.max_size < flags.min_size) {
+        return Error(flags.usage("--max_size must be >= --min_size"));
+      }
+
+      uint64_t range = flags.max_size.bytes() - flags.min_size.bytes() + 1;
+
+      for (size_t i = 0; i < flags.appends.get(); i++) {
+        sizes.push_back(Bytes(flags.min_size.bytes() + os::random() % range));
+      }
+    } else if (flags.distribution == "fixed") {
+      for (size_t i = 0; i < flags.appends.get(); i++) {
+        sizes.push_back(flags.size);
+      }
+    } else {
+      return Error(flags.usage(
+          "Unknown distribution '" + flags.distribution + "'"));
+    }
   }
 
-  input.close();
-
   // Generate the data to be written.
   vector<string> data;
   for (size_t i = 0; i < sizes.size(); i++) {
@@ -226,25 +264,93 @@ Try<Nothing> Benchmark::execute(int argc, char** argv)
   Stopwatch stopwatch;
   stopwatch.start();
 
-  for (size_t i = 0; i < sizes.size(); i++) {
-    Stopwatch stopwatch;
-    stopwatch.start();
+  if (flags.storage_only) {
+    // Benchmark the local storage layer directly: build learned
+    // append actions and persist them one at a time, the way a
+    // replica does when a write is replicated to it.
+    LevelDBStorage storage(flags.sync);
+
+    Try<Storage::State> state = storage.restore(flags.path.get());
+    if (state.isError()) {
+      return Error("Failed to restore the storage: " + state.error());
+    }
+
+    uint64_t next = state->end;
+
+    for (size_t i = 0; i < sizes.size(); i++) {
+      Action action;
+      action.set_position(++next);
+      action.set_promised(1);
+      action.set_performed(1);
+      action.set_learned(true);
+      action.set_type(Action::APPEND);
+      action.mutable_append()->set_bytes(data[i]);
 
-    position = writer.append(data[i]);
+      Stopwatch stopwatch;
+      stopwatch.start();
 
-    if (!position.await(Seconds(10))) {
-      return Error("Failed to append: timed out");
+      Try<Nothing> persist = storage.persist(action);
+      if (persist.isError()) {
+        return Error("Failed to persist action: " + persist.error());
+      }
+
+      durations.push_back(stopwatch.elapsed());
+      timestamps.push_back(Clock::now());
+    }
+  } else {
+    // Initialize the log.
+    if (flags.initialize) {
+      Initialize initialize;
+      initialize.flags.path = flags.path;
+
+      Try<Nothing> execution = initialize.execute();
+      if (execution.isError()) {
+        return Error(execution.error());
+      }
+    }
+
+    // Create the log.
+    Log log(
+        flags.quorum.get(),
+        flags.path.get(),
+        flags.servers.get(),
+        Seconds(10),
+        flags.znode.get());
+
+    // Create the log writer.
+    Log::Writer writer(&log);
+
+    Future<Option<Log::Position>> position = writer.start();
+
+    if (!position.await(Seconds(15))) {
+      return Error("Failed to start a log writer: timed out");
     } else if (!position.isReady()) {
-      return Error("Failed to append: " +
+      return Error("Failed to start a log writer: " +
                    (position.isFailed()
                     ? position.failure()
                     : "Discarded future"));
-    } else if (position->isNone()) {
-      return Error("Failed to append: exclusive write promise lost");
     }
 
-    durations.push_back(stopwatch.elapsed());
-    timestamps.push_back(Clock::now());
+    for (size_t i = 0; i < sizes.size(); i++) {
+      Stopwatch stopwatch;
+      stopwatch.start();
+
+      position = writer.append(data[i]);
+
+      if (!position.await(Seconds(10))) {
+        return Error("Failed to append: timed out");
+      } else if (!position.isReady()) {
+        return Error("Failed to append: " +
+                     (position.isFailed()
+                      ? position.failure()
+                      : "Discarded future"));
+      } else if (position->isNone()) {
+        return Error("Failed to append: exclusive write promise lost");
+      }
+
+      durations.push_back(stopwatch.elapsed());
+      timestamps.push_back(Clock::now());
+    }
   }
 
   cout << "Total number of appends: " << sizes.size() << endl;
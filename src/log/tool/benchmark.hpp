@@ -17,6 +17,7 @@
 #ifndef __LOG_TOOL_BENCHMARK_HPP__
 #define __LOG_TOOL_BENCHMARK_HPP__
 
+#include <stout/bytes.hpp>
 #include <stout/flags.hpp>
 #include <stout/option.hpp>
 
@@ -45,6 +46,13 @@ public:
     Option<std::string> output;
     std::string type;
     bool initialize;
+    Option<size_t> appends;
+    std::string distribution;
+    Bytes size;
+    Bytes min_size;
+    Bytes max_size;
+    bool storage_only;
+    bool sync;
     bool help;
   };
 
@@ -0,0 +1,186 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+
+#include <iostream>
+#include <list>
+
+#include <process/process.hpp>
+
+#include <stout/error.hpp>
+#include <stout/os.hpp>
+
+#include "log/leveldb.hpp"
+#include "log/storage.hpp"
+#include "log/tool/compact.hpp"
+
+#include "logging/logging.hpp"
+
+using std::cout;
+using std::endl;
+using std::list;
+
+namespace mesos {
+namespace internal {
+namespace log {
+namespace tool {
+
+// The number of actions accumulated into a single write so that the
+// copy is not bounded by per-record sync costs.
+static const size_t BATCH_SIZE = 1024;
+
+
+Compact::Flags::Flags()
+{
+  add(&Flags::path,
+      "path",
+      "Path to the log");
+
+  add(&Flags::output,
+      "output",
+      "Path to which the compacted log is written.\n"
+      "Must not exist yet");
+}
+
+
+Try<Nothing> Compact::execute(int argc, char** argv)
+{
+  flags.setUsageMessage(
+      "Usage: " + name() + " [options]\n"
+      "\n"
+      "This command is used to compact the log offline. It\n"
+      "recovers the replica under --path, drops the positions\n"
+      "that have been truncated, and rewrites the remaining\n"
+      "records into a fresh replica under --output. The replica\n"
+      "must not be in use while this command runs; swapping the\n"
+      "directories afterwards is left to the operator.\n"
+      "\n");
+
+  // Configure the tool by parsing command line arguments.
+  if (argc > 0 && argv != nullptr) {
+    Try<flags::Warnings> load = flags.load(None(), argc, argv);
+    if (load.isError()) {
+      return Error(flags.usage(load.error()));
+    }
+
+    if (flags.help) {
+      return Error(flags.usage());
+    }
+
+    process::initialize();
+    logging::initialize(argv[0], false, flags);
+
+    // Log any flag warnings (after logging is initialized).
+    foreach (const flags::Warning& warning, load->warnings) {
+      LOG(WARNING) << warning.message;
+    }
+  }
+
+  if (flags.path.isNone()) {
+    return Error(flags.usage("Missing required flag --path"));
+  }
+
+  if (flags.output.isNone()) {
+    return Error(flags.usage("Missing required flag --output"));
+  }
+
+  if (os::exists(flags.output.get())) {
+    return Error("Output path '" + flags.output.get() + "' already exists");
+  }
+
+  // Recover the source replica. Note that restoring the storage also
+  // compacts the underlying leveldb database.
+  LevelDBStorage source;
+
+  Try<Storage::State> state = source.restore(flags.path.get());
+  if (state.isError()) {
+    return Error("Failed to recover the log: " + state.error());
+  }
+
+  LOG(INFO) << "Recovered log with beginning position " << state->begin
+            << " and ending position " << state->end;
+
+  LevelDBStorage target;
+
+  Try<Storage::State> empty = target.restore(flags.output.get());
+  if (empty.isError()) {
+    return Error("Failed to create the compacted log: " + empty.error());
+  }
+
+  // Persist the replica status and the implicit promise.
+  Try<Nothing> persist = target.persist(state->metadata);
+  if (persist.isError()) {
+    return Error("Failed to persist the metadata: " + persist.error());
+  }
+
+  // Copy the records that have not been truncated. Any position
+  // between the beginning and the ending that is neither learned nor
+  // unlearned is a hole (e.g., the replica crashed during catch-up)
+  // and has nothing to copy.
+  uint64_t copied = 0;
+  list<Action> batch;
+
+  for (uint64_t position = state->begin;
+       position <= state->end;
+       position++) {
+    if (!state->learned.contains(position) &&
+        !state->unlearned.contains(position)) {
+      continue;
+    }
+
+    Try<Action> action = source.read(position);
+    if (action.isError()) {
+      return Error(
+          "Failed to read position " + stringify(position) + ": " +
+          action.error());
+    }
+
+    batch.push_back(action.get());
+    copied++;
+
+    if (batch.size() >= BATCH_SIZE) {
+      persist = target.persist(batch);
+      if (persist.isError()) {
+        return Error(
+            "Failed to persist actions to the compacted log: " +
+            persist.error());
+      }
+
+      batch.clear();
+    }
+  }
+
+  if (!batch.empty()) {
+    persist = target.persist(batch);
+    if (persist.isError()) {
+      return Error(
+          "Failed to persist actions to the compacted log: " +
+          persist.error());
+    }
+  }
+
+  cout << "Copied " << copied << " action(s) between positions "
+       << state->begin << " and " << state->end
+       << " to '" << flags.output.get() << "'" << endl;
+
+  return Nothing();
+}
+
+} // namespace tool {
+} // namespace log {
+} // namespace internal {
+} // namespace mesos {
@@ -0,0 +1,159 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "logging/async_logger.hpp"
+
+#include <utility>
+
+#include <stout/foreach.hpp>
+#include <stout/stringify.hpp>
+
+using std::deque;
+using std::string;
+
+namespace mesos {
+namespace internal {
+namespace logging {
+
+AsyncLogger::AsyncLogger(google::base::Logger* _wrapped, size_t _capacity)
+  : wrapped(CHECK_NOTNULL(_wrapped)),
+    capacity(_capacity),
+    pendingBytes(0),
+    dropped(0),
+    flushRequested(false),
+    terminating(false),
+    thread(&AsyncLogger::run, this) {}
+
+
+AsyncLogger::~AsyncLogger()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    terminating = true;
+  }
+
+  wake.notify_one();
+  thread.join();
+}
+
+
+void AsyncLogger::Write(
+    bool force_flush,
+    time_t timestamp,
+    const char* message,
+    int message_len)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Never block: losing log messages behind a stalled disk is
+    // preferable to stalling every thread that logs.
+    if (pendingBytes + message_len > capacity) {
+      ++dropped;
+      return;
+    }
+
+    Entry entry;
+    entry.flush = force_flush;
+    entry.timestamp = timestamp;
+    entry.message = string(message, message_len);
+
+    pending.push_back(std::move(entry));
+    pendingBytes += message_len;
+  }
+
+  wake.notify_one();
+}
+
+
+void AsyncLogger::Flush()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+
+  flushRequested = true;
+  wake.notify_one();
+
+  drained.wait(lock, [this] { return pending.empty() && !flushRequested; });
+}
+
+
+google::uint32 AsyncLogger::LogSize()
+{
+  return wrapped->LogSize();
+}
+
+
+void AsyncLogger::run()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+
+  for (;;) {
+    wake.wait(lock, [this] {
+      return terminating || flushRequested || !pending.empty();
+    });
+
+    deque<Entry> batch;
+    batch.swap(pending);
+    pendingBytes = 0;
+
+    const size_t droppedBatch = dropped;
+    dropped = 0;
+
+    const bool flush = flushRequested;
+    const bool terminate = terminating;
+
+    // Perform the I/O without holding the lock, so that loggers can
+    // keep appending to the buffer in the meantime.
+    lock.unlock();
+
+    foreach (const Entry& entry, batch) {
+      wrapped->Write(
+          entry.flush,
+          entry.timestamp,
+          entry.message.data(),
+          static_cast<int>(entry.message.size()));
+    }
+
+    if (droppedBatch > 0) {
+      const string warning =
+        "W Dropped " + stringify(droppedBatch) +
+        " log messages because the logging buffer was full\n";
+
+      wrapped->Write(
+          true, time(nullptr), warning.data(),
+          static_cast<int>(warning.size()));
+    }
+
+    if (flush || terminate) {
+      wrapped->Flush();
+    }
+
+    lock.lock();
+
+    if (flush || terminate) {
+      flushRequested = false;
+      drained.notify_all();
+    }
+
+    if (terminate && pending.empty()) {
+      break;
+    }
+  }
+}
+
+} // namespace logging {
+} // namespace internal {
+} // namespace mesos {
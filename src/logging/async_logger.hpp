@@ -0,0 +1,96 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __LOGGING_ASYNC_LOGGER_HPP__
+#define __LOGGING_ASYNC_LOGGER_HPP__
+
+#include <time.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <glog/logging.h>
+
+namespace mesos {
+namespace internal {
+namespace logging {
+
+// Decorates a glog `Logger` so that `Write` only appends the message
+// to a bounded in-memory buffer, while a dedicated writer thread
+// performs the actual (potentially blocking) file I/O. If the disk
+// stalls for long enough to fill the buffer, further messages are
+// dropped, and the number of dropped messages is logged once the disk
+// catches up. Either way a thread that logs never blocks on disk I/O.
+class AsyncLogger : public google::base::Logger
+{
+public:
+  // Does not take ownership of the wrapped logger, mirroring
+  // `google::base::SetLogger`. `capacity` bounds the number of
+  // buffered message bytes.
+  AsyncLogger(google::base::Logger* _wrapped, size_t _capacity);
+
+  // Drains the buffer and stops the writer thread.
+  ~AsyncLogger() override;
+
+  // Appends the message to the buffer. Never blocks on I/O.
+  void Write(
+      bool force_flush,
+      time_t timestamp,
+      const char* message,
+      int message_len) override;
+
+  // Blocks until all currently buffered messages have been written
+  // and flushed by the wrapped logger.
+  void Flush() override;
+
+  google::uint32 LogSize() override;
+
+private:
+  struct Entry
+  {
+    bool flush;
+    time_t timestamp;
+    std::string message;
+  };
+
+  // The writer thread's main loop.
+  void run();
+
+  google::base::Logger* const wrapped;
+  const size_t capacity;
+
+  std::mutex mutex;
+  std::condition_variable wake;     // Signals the writer thread.
+  std::condition_variable drained;  // Signals `Flush` completion.
+
+  // The fields below are all protected by `mutex`.
+  std::deque<Entry> pending;
+  size_t pendingBytes;
+  size_t dropped;
+  bool flushRequested;
+  bool terminating;
+
+  std::thread thread;
+};
+
+} // namespace logging {
+} // namespace internal {
+} // namespace mesos {
+
+#endif // __LOGGING_ASYNC_LOGGER_HPP__
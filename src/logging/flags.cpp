@@ -46,6 +46,16 @@ mesos::internal::logging::Flags::Flags()
       "By default, logs are flushed immediately.",
       0);
 
+  add(&Flags::async_logging,
+      "async_logging",
+      "If true, log messages are written to disk by a dedicated writer\n"
+      "thread through a bounded in-memory buffer, so that a stalling\n"
+      "disk cannot block threads that log. If the disk stalls for long\n"
+      "enough to fill the buffer, log messages are dropped and the\n"
+      "number of dropped messages is logged once the disk catches up.\n"
+      "FATAL messages are always written synchronously.",
+      false);
+
   add(&Flags::initialize_driver_logging,
       "initialize_driver_logging",
       "Whether the master/agent should initialize Google logging for the\n"
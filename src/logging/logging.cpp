@@ -34,6 +34,7 @@
 
 #include <stout/os/signals.hpp>
 
+#include "logging/async_logger.hpp"
 #include "logging/logging.hpp"
 
 #ifdef __linux__
@@ -78,6 +79,11 @@ namespace logging {
 string argv0;
 
 
+// The maximum number of message bytes buffered by each severity's
+// `AsyncLogger` before messages are dropped, see `--async_logging`.
+constexpr size_t ASYNC_LOG_BUFFER_CAPACITY = 8 * 1024 * 1024;
+
+
 // NOTE: We use RAW_LOG instead of LOG because RAW_LOG doesn't
 // allocate any memory or grab locks. And according to
 // https://code.google.com/p/google-glog/issues/detail?id=161
@@ -194,6 +200,23 @@ void initialize(
 #endif
 
   google::InitGoogleLogging(argv0.c_str());
+
+  if (flags.async_logging) {
+    // Route INFO, WARNING and ERROR file writes through a bounded
+    // in-memory buffer serviced by a dedicated writer thread, so that
+    // a stalling disk cannot block threads that log. FATAL stays
+    // synchronous so that crash logs are not lost.
+    //
+    // NOTE: The loggers (and the wrapped originals) intentionally
+    // outlive `main` since logging continues until process exit.
+    for (int severity = google::INFO; severity < google::FATAL; severity++) {
+      google::base::SetLogger(
+          severity,
+          new AsyncLogger(
+              google::base::GetLogger(severity), ASYNC_LOG_BUFFER_CAPACITY));
+    }
+  }
+
   if (flags.log_dir.isSome()) {
     // Log this message in order to create the log file; this is because GLOG
     // creates the log file once the first log message occurs; also recreate
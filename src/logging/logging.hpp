@@ -17,16 +17,48 @@
 #ifndef __LOGGING_LOGGING_HPP__
 #define __LOGGING_LOGGING_HPP__
 
+#include <atomic>
+#include <chrono>
 #include <string>
 
 #include <glog/logging.h> // Includes LOG(*), PLOG(*), CHECK, etc.
 
+#include <stout/duration.hpp>
+
 #include "logging/flags.hpp"
 
 namespace mesos {
 namespace internal {
 namespace logging {
 
+// Used to implement `LOG_RATELIMITED` below; see there for details.
+class CallSiteRateLimiter
+{
+public:
+  explicit CallSiteRateLimiter(const Duration& interval)
+    : intervalNs(interval.ns()), deadlineNs(0) {}
+
+  // Returns true at most once per interval. Thread safe and
+  // non-blocking; when multiple threads race, only one is permitted.
+  bool permit()
+  {
+    const int64_t now =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    int64_t deadline = deadlineNs.load(std::memory_order_relaxed);
+
+    return now >= deadline &&
+           deadlineNs.compare_exchange_strong(
+               deadline, now + intervalNs, std::memory_order_relaxed);
+  }
+
+private:
+  const int64_t intervalNs;
+  std::atomic<int64_t> deadlineNs;
+};
+
+
 void initialize(
     const std::string& argv0,
     bool installFailureSignalHandler,
@@ -45,4 +77,25 @@ google::LogSeverity getLogSeverity(const std::string& logging_level);
 } // namespace internal {
 } // namespace mesos {
 
+
+#define LOG_RATELIMITED_CONCAT_(a, b) a##b
+#define LOG_RATELIMITED_CONCAT(a, b) LOG_RATELIMITED_CONCAT_(a, b)
+
+// Logs via `LOG(severity)` at most once per `interval` for each call
+// site; messages in between are silently dropped. Use this on hot
+// paths where a misbehaving peer or input could otherwise flood the
+// log, e.g.:
+//
+//   LOG_RATELIMITED(WARNING, Seconds(10))
+//     << "Dropping message from " << from;
+//
+// NOTE: Like glog's `LOG_EVERY_N` this declares a static at the call
+// site, so it cannot be used twice on the same line and must be
+// braced when used as the body of an `if` or loop.
+#define LOG_RATELIMITED(severity, interval)                               \
+  static ::mesos::internal::logging::CallSiteRateLimiter                  \
+    LOG_RATELIMITED_CONCAT(_logRateLimiter, __LINE__)(interval);          \
+  if (LOG_RATELIMITED_CONCAT(_logRateLimiter, __LINE__).permit())         \
+    LOG(severity)
+
 #endif // __LOGGING_LOGGING_HPP__
@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <set>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -42,6 +43,7 @@
 
 #include "common/protobuf_utils.hpp"
 #include "common/resource_quantities.hpp"
+#include "common/tracepoints.hpp"
 
 using std::set;
 using std::string;
@@ -73,13 +75,23 @@ public:
   virtual ~OfferFilter() {}
 
   virtual bool filter(const Resources& resources) const = 0;
+
+  // The scalar quantities of the refused resources. The allocator
+  // uses these for a cheap dominance pre-check before the exact
+  // (and significantly more expensive) `filter()` evaluation.
+  virtual const ResourceQuantities& quantities() const = 0;
 };
 
 
 class RefusedOfferFilter : public OfferFilter
 {
 public:
-  RefusedOfferFilter(const Resources& _resources) : resources(_resources) {}
+  RefusedOfferFilter(const Resources& _resources) : resources(_resources)
+  {
+    foreach (const Resource& resource, resources.scalars()) {
+      refusedQuantities[resource.name()] += resource.scalar();
+    }
+  }
 
   bool filter(const Resources& _resources) const override
   {
@@ -91,8 +103,14 @@ public:
     return resources.contains(_resources); // Refused resources are superset.
   }
 
+  const ResourceQuantities& quantities() const override
+  {
+    return refusedQuantities;
+  }
+
 private:
   const Resources resources;
+  ResourceQuantities refusedQuantities;
 };
 
 
@@ -133,6 +151,30 @@ private:
 };
 
 
+// Compiles the framework's offer constraints, if it has any.
+//
+// NOTE: Malformed constraints are rejected during `FrameworkInfo`
+// validation; dropping them here is defensive.
+static Option<OfferConstraintsFilter> createOfferConstraintsFilter(
+    const FrameworkInfo& frameworkInfo)
+{
+  if (!frameworkInfo.has_offer_constraints()) {
+    return None();
+  }
+
+  Try<OfferConstraintsFilter> filter =
+    OfferConstraintsFilter::create(frameworkInfo.offer_constraints());
+
+  if (filter.isError()) {
+    LOG(WARNING) << "Ignoring invalid offer constraints of framework '"
+                 << frameworkInfo.name() << "': " << filter.error();
+    return None();
+  }
+
+  return filter.get();
+}
+
+
 HierarchicalAllocatorProcess::Framework::Framework(
     const FrameworkInfo& frameworkInfo,
     const set<string>& _suppressedRoles,
@@ -140,6 +182,7 @@ HierarchicalAllocatorProcess::Framework::Framework(
   : roles(protobuf::framework::getRoles(frameworkInfo)),
     suppressedRoles(_suppressedRoles),
     capabilities(frameworkInfo.capabilities()),
+    offerConstraints(createOfferConstraintsFilter(frameworkInfo)),
     active(_active),
     metrics(new FrameworkMetrics(frameworkInfo)) {}
 
@@ -170,6 +213,7 @@ void HierarchicalAllocatorProcess::initialize(
   minAllocatableResources = _minAllocatableResources;
   initialized = true;
   paused = false;
+  cyclesSinceFullSweep = 0;
 
   completedFrameworkMetrics =
     BoundedHashMap<FrameworkID, process::Owned<FrameworkMetrics>>(
@@ -192,7 +236,7 @@ void HierarchicalAllocatorProcess::initialize(
         return after(_allocationInterval);
       },
       [_self](const Nothing&) {
-        return dispatch(_self, &HierarchicalAllocatorProcess::allocate)
+        return dispatch(_self, &HierarchicalAllocatorProcess::batch)
           .then([]() -> ControlFlow<Nothing> { return Continue(); });
       });
 }
@@ -519,6 +563,7 @@ void HierarchicalAllocatorProcess::updateFramework(
   framework.roles = newRoles;
   framework.suppressedRoles = suppressedRoles;
   framework.capabilities = frameworkInfo.capabilities();
+  framework.offerConstraints = createOfferConstraintsFilter(frameworkInfo);
 }
 
 
@@ -638,6 +683,7 @@ void HierarchicalAllocatorProcess::removeSlave(
 
   slaves.erase(slaveId);
   allocationCandidates.erase(slaveId);
+  dirtySlaves.erase(slaveId);
 
   // Note that we DO NOT actually delete any filters associated with
   // this slave, that will occur when the delayed
@@ -684,6 +730,7 @@ void HierarchicalAllocatorProcess::updateSlave(
     // to reregister with a different hostname) inside the allocator it
     // doesn't matter, as the algorithm will work correctly either way.
     slave.info = info;
+    slave.attributes = CompiledAttributes(info.attributes());
   }
 
   // Update agent capabilities.
@@ -811,17 +858,40 @@ void HierarchicalAllocatorProcess::updateWhitelist(
 {
   CHECK(initialized);
 
-  whitelist = _whitelist;
+  if (_whitelist.isSome()) {
+    // Log the delta rather than the full contents; the whitelist may
+    // contain tens of thousands of hostnames.
+    if (whitelist.isSome()) {
+      hashset<string> added;
+      foreach (const string& hostname, _whitelist.get()) {
+        if (!whitelist->contains(hostname)) {
+          added.insert(hostname);
+        }
+      }
 
-  if (whitelist.isSome()) {
-    LOG(INFO) << "Updated agent whitelist: " << stringify(whitelist.get());
+      hashset<string> removed;
+      foreach (const string& hostname, whitelist.get()) {
+        if (!_whitelist->contains(hostname)) {
+          removed.insert(hostname);
+        }
+      }
 
-    if (whitelist->empty()) {
+      LOG(INFO) << "Updated agent whitelist (" << _whitelist->size()
+                << " entries): added " << stringify(added)
+                << ", removed " << stringify(removed);
+    } else {
+      LOG(INFO) << "Updated agent whitelist with "
+                << _whitelist->size() << " entries";
+    }
+
+    if (_whitelist->empty()) {
       LOG(WARNING) << "Whitelist is empty, no offers will be made!";
     }
   } else {
     LOG(INFO) << "Advertising offers for all agents";
   }
+
+  whitelist = _whitelist;
 }
 
 
@@ -911,6 +981,13 @@ void HierarchicalAllocatorProcess::updateAllocation(
         updatedOfferedResources.nonRevocable());
   }
 
+  // Conversions (e.g. RESERVE / UNRESERVE) can change which portion
+  // of the allocation is reserved without going through
+  // `trackAllocatedResources()`, so adjust the incremental quota
+  // accounting here as well.
+  untrackQuotaConsumption(role, offeredResources);
+  trackQuotaConsumption(role, updatedOfferedResources);
+
   // Update the agent total resources so they are consistent with the updated
   // allocation. We do not directly use `updatedOfferedResources` here because
   // the agent's total resources shouldn't contain:
@@ -1239,6 +1316,11 @@ void HierarchicalAllocatorProcess::recoverResources(
 
     slave.unallocate(resources);
 
+    // Mark the agent dirty so that the next periodic allocation
+    // cycle re-evaluates it without waiting for a full sweep over
+    // all agents (MESOS-3078).
+    dirtySlaves.insert(slaveId);
+
     VLOG(1) << "Recovered " << resources
             << " (total: " << slave.getTotal()
             << ", allocated: " << slave.getAllocated() << ")"
@@ -1504,6 +1586,13 @@ void HierarchicalAllocatorProcess::resume()
     VLOG(1) << "Allocation resumed";
 
     paused = false;
+
+    // Events that arrived while allocation was paused (e.g. the
+    // agent re-registration storm during master failover recovery)
+    // were applied to the allocator state without triggering any
+    // allocation work. Now that the batch has been applied, perform
+    // a single full allocation to reflect all of it in one pass.
+    allocate();
   }
 }
 
@@ -1514,6 +1603,39 @@ Future<Nothing> HierarchicalAllocatorProcess::allocate()
 }
 
 
+Future<Nothing> HierarchicalAllocatorProcess::batch()
+{
+  // How many periodic allocation cycles may pass between two full
+  // sweeps over all agents. The full sweep acts as a safety net for
+  // state changes that dirty tracking cannot observe, most notably
+  // offer filter expiration.
+  //
+  // TODO(alexr): Consider exposing this constant.
+  const size_t ALLOCATION_FULL_SWEEP_CYCLES = 10;
+
+  ++cyclesSinceFullSweep;
+
+  if (cyclesSinceFullSweep >= ALLOCATION_FULL_SWEEP_CYCLES ||
+      dirtySlaves.size() >= slaves.size()) {
+    cyclesSinceFullSweep = 0;
+    dirtySlaves.clear();
+
+    return allocate();
+  }
+
+  if (dirtySlaves.empty()) {
+    VLOG(2) << "Skipped periodic allocation cycle: no agents are dirty";
+
+    return Nothing();
+  }
+
+  hashset<SlaveID> dirty;
+  std::swap(dirty, dirtySlaves);
+
+  return allocate(dirty);
+}
+
+
 Future<Nothing> HierarchicalAllocatorProcess::allocate(
     const SlaveID& slaveId)
 {
@@ -1533,6 +1655,13 @@ Future<Nothing> HierarchicalAllocatorProcess::allocate(
 
   allocationCandidates |= slaveIds;
 
+  // NOTE: Allocation triggers coalesce naturally here: the
+  // `_allocate()` dispatch below is enqueued *behind* any events
+  // already queued on the allocator (e.g. a burst of `addSlave()` /
+  // `addFramework()` dispatches during master failover), so those
+  // mutations are all applied before the single allocation run
+  // evaluates the accumulated candidates. Triggers that arrive while
+  // a run is already pending just grow the candidate set.
   if (allocation.isNone() || !allocation->isPending()) {
     metrics.allocation_run_latency.start();
     allocation = dispatch(self(), &Self::_allocate);
@@ -1542,7 +1671,7 @@ Future<Nothing> HierarchicalAllocatorProcess::allocate(
 }
 
 
-Nothing HierarchicalAllocatorProcess::_allocate()
+Future<Nothing> HierarchicalAllocatorProcess::_allocate()
 {
   metrics.allocation_run_latency.stop();
 
@@ -1558,6 +1687,33 @@ Nothing HierarchicalAllocatorProcess::_allocate()
   stopwatch.start();
   metrics.allocation_run.start();
 
+  // The maximum number of agents evaluated in a single allocation
+  // pass. Bounding the pass keeps the time during which the actor
+  // is blocked (and hence the latency of queued events) roughly
+  // constant regardless of cluster size; the remaining candidates
+  // are processed by a chained dispatch below, which lets any events
+  // queued in the interim run first.
+  //
+  // TODO(alexr): Consider exposing this constant, or deriving it
+  // from a time budget using recent per-agent allocation timings.
+  const size_t ALLOCATION_SLICE_SIZE = 1000;
+
+  hashset<SlaveID> remaining;
+
+  if (allocationCandidates.size() > ALLOCATION_SLICE_SIZE) {
+    hashset<SlaveID> slice;
+
+    foreach (const SlaveID& slaveId, allocationCandidates) {
+      if (slice.size() < ALLOCATION_SLICE_SIZE) {
+        slice.insert(slaveId);
+      } else {
+        remaining.insert(slaveId);
+      }
+    }
+
+    allocationCandidates = std::move(slice);
+  }
+
   __allocate();
 
   // NOTE: For now, we implement maintenance inverse offers within the
@@ -1570,9 +1726,25 @@ Nothing HierarchicalAllocatorProcess::_allocate()
   VLOG(1) << "Performed allocation for " << allocationCandidates.size()
           << " agents in " << stopwatch.elapsed();
 
-  // Clear the candidates on completion of the allocation run.
+  // Clear the candidates on completion of the allocation run. Any
+  // candidate we just evaluated is no longer dirty.
+  foreach (const SlaveID& slaveId, allocationCandidates) {
+    dirtySlaves.erase(slaveId);
+  }
+
   allocationCandidates.clear();
 
+  // If the candidate set was sliced, chain a dispatch for the rest.
+  // Going through a dispatch (rather than looping here) yields the
+  // actor to any events that queued up during this pass.
+  if (!remaining.empty()) {
+    allocationCandidates = std::move(remaining);
+
+    metrics.allocation_run_latency.start();
+
+    return dispatch(self(), &Self::_allocate);
+  }
+
   return Nothing();
 }
 
@@ -1580,6 +1752,8 @@ Nothing HierarchicalAllocatorProcess::_allocate()
 // TODO(alexr): Consider factoring out the quota allocation logic.
 void HierarchicalAllocatorProcess::__allocate()
 {
+  MESOS_TRACEPOINT1(allocator_run_begin, allocationCandidates.size());
+
   // Compute the offerable resources, per framework:
   //   (1) For reserved resources on the slave, allocate these to a
   //       framework having the corresponding role.
@@ -1609,6 +1783,8 @@ void HierarchicalAllocatorProcess::__allocate()
   // TODO(vinod): Implement a smarter sorting algorithm.
   std::random_shuffle(slaveIds.begin(), slaveIds.end());
 
+  metrics.allocation_agents_evaluated += slaveIds.size();
+
   // Returns the __quantity__ of resources allocated to a role with
   // non-default quota. Since we account for reservations and persistent
   // volumes toward quota, we strip reservation and persistent volumes
@@ -1617,12 +1793,6 @@ void HierarchicalAllocatorProcess::__allocate()
   // also to determine how many resources the role would need in
   // order to meet its quota guarantee.
   //
-  // NOTE: Revocable resources are excluded in `quotaRoleSorter`.
-  auto getQuotaRoleAllocatedScalarQuantities = [this](const string& role) {
-    CHECK(quotas.contains(role));
-    return quotaRoleSorter->allocationScalarQuantities(role);
-  };
-
   // Returns the result of shrinking the provided resources down to the
   // target scalar quantities. If a resource does not have a target
   // quantity provided, it will not be shrunk.
@@ -1662,6 +1832,8 @@ void HierarchicalAllocatorProcess::__allocate()
     return result;
   };
 
+  metrics.allocation_run_headroom.start();
+
   // To enforce quota, we keep track of consumed quota for roles with a
   // non-default quota.
   //
@@ -1699,16 +1871,13 @@ void HierarchicalAllocatorProcess::__allocate()
     rolesConsumedQuotaScalarQuantites[role] +=
       reservationScalarQuantities.get(role).getOrElse(Resources());
 
-    // Then add allocated resoruces.
+    // Then add the unreserved allocation, which is maintained
+    // incrementally as allocations are tracked and untracked. This
+    // avoids walking every agent's allocation for each quota'ed
+    // role on every allocation cycle.
     rolesConsumedQuotaScalarQuantites[role] +=
-      getQuotaRoleAllocatedScalarQuantities(role);
-
-    // Lastly subtract allocated reservations on each agent.
-    foreachvalue (
-        const Resources& resources, quotaRoleSorter->allocation(role)) {
-      rolesConsumedQuotaScalarQuantites[role] -=
-        resources.reserved().createStrippedScalarQuantity();
-    }
+      roleUnreservedAllocationScalarQuantities.get(role)
+        .getOrElse(Resources());
   }
 
   // We need to constantly make sure that we are holding back enough
@@ -1749,37 +1918,90 @@ void HierarchicalAllocatorProcess::__allocate()
     availableHeadroom -= roleSorter->allocationScalarQuantities(role);
   }
 
-  // Calculate total allocated reservations. Note that we need to ensure
-  // we count a reservation for "a" being allocated to "a/b", therefore
-  // we cannot simply loop over the reservations' roles.
-  Resources totalAllocatedReservationScalarQuantities;
-  foreachkey (const string& role, roles) {
-    const hashmap<SlaveID, Resources>* allocations;
-    if (quotaRoleSorter->contains(role)) {
-      allocations = &quotaRoleSorter->allocation(role);
-    } else if (roleSorter->contains(role)) {
-      allocations = &roleSorter->allocation(role);
-    } else {
-      continue; // This role has no allocation.
+  // Subtract total unallocated reservations. The total allocated
+  // reservation quantities are maintained incrementally as
+  // allocations are tracked and untracked, so no sweep over the
+  // roles' allocations is needed here.
+  availableHeadroom -=
+    Resources::sum(reservationScalarQuantities) -
+    allocatedReservationScalarQuantities;
+
+  // Subtract revocable resources.
+  //
+  // This walks every agent in the cluster (not just the allocation
+  // candidates) and the per-agent work is independent and read-only,
+  // so for large clusters we shard it across worker threads instead
+  // of computing it serially on the allocator actor. Note that the
+  // allocation loops below remain serial: they mutate the sorters as
+  // allocations are made, so evaluating agents concurrently there
+  // would change the DRF semantics.
+  //
+  // TODO(bmahler): Consider persisting this quantity across
+  // allocation cycles instead of recomputing it each time.
+  const size_t PARALLEL_HEADROOM_THRESHOLD = 1000;
+
+  if (slaves.size() < PARALLEL_HEADROOM_THRESHOLD) {
+    foreachvalue (const Slave& slave, slaves) {
+      availableHeadroom -=
+        slave.getAvailable().revocable().createStrippedScalarQuantity();
     }
+  } else {
+    vector<const Slave*> slavePointers;
+    slavePointers.reserve(slaves.size());
 
-    foreachvalue (const Resources& resources, *CHECK_NOTNULL(allocations)) {
-      totalAllocatedReservationScalarQuantities +=
-        resources.reserved().createStrippedScalarQuantity();
+    foreachvalue (const Slave& slave, slaves) {
+      slavePointers.push_back(&slave);
     }
-  }
 
-  // Subtract total unallocated reservations.
-  availableHeadroom -=
-    Resources::sum(reservationScalarQuantities) -
-    totalAllocatedReservationScalarQuantities;
+    const size_t shardCount = std::max(
+        static_cast<size_t>(1),
+        std::min(
+            static_cast<size_t>(std::thread::hardware_concurrency()),
+            slavePointers.size()));
+
+    const size_t shardSize =
+      (slavePointers.size() + shardCount - 1) / shardCount;
+
+    // Run the shards on dedicated threads and join them. We
+    // deliberately do not use `process::async` and block on the
+    // collected result here: that waits on work scheduled on the
+    // same shared worker pool this actor occupies, which can
+    // deadlock when the pool is saturated. Joining threads we own
+    // only ever waits on work that is actually running.
+    std::vector<Resources> shardResults(shardCount);
+    std::vector<std::thread> shardThreads;
+    shardThreads.reserve(shardCount);
+
+    for (size_t shard = 0; shard < shardCount; ++shard) {
+      const size_t begin = shard * shardSize;
+      const size_t end = std::min(begin + shardSize, slavePointers.size());
+
+      if (begin >= end) {
+        break;
+      }
 
-  // Subtract revocable resources.
-  foreachvalue (const Slave& slave, slaves) {
-    availableHeadroom -=
-      slave.getAvailable().revocable().createStrippedScalarQuantity();
+      shardThreads.emplace_back(
+          [begin, end, shard, &slavePointers, &shardResults]() {
+            Resources revocable;
+            for (size_t i = begin; i < end; ++i) {
+              revocable += slavePointers[i]
+                ->getAvailable().revocable().createStrippedScalarQuantity();
+            }
+            shardResults[shard] = std::move(revocable);
+          });
+    }
+
+    foreach (std::thread& thread, shardThreads) {
+      thread.join();
+    }
+
+    foreach (const Resources& revocable, shardResults) {
+      availableHeadroom -= revocable;
+    }
   }
 
+  metrics.allocation_run_headroom.stop();
+
   // Due to the two stages in the allocation algorithm and the nature of
   // shared resources being re-offerable even if already allocated, the
   // same shared resources can appear in two (and not more due to the
@@ -1804,6 +2026,8 @@ void HierarchicalAllocatorProcess::__allocate()
   // we try to satisfy the quota guarantee in this first stage so that those
   // roles with unsatisfied guarantee can have more choices and higher
   // probability in getting their guarantee satisfied.
+  metrics.allocation_run_quota_stage.start();
+
   foreach (const SlaveID& slaveId, slaveIds) {
     CHECK(slaves.contains(slaveId));
     Slave& slave = slaves.at(slaveId);
@@ -1853,6 +2077,13 @@ void HierarchicalAllocatorProcess::__allocate()
           continue;
         }
 
+        // Skip agents whose attributes do not match the framework's
+        // offer constraints; the framework would only decline them.
+        if (framework.offerConstraints.isSome() &&
+            !framework.offerConstraints->matches(slave.attributes)) {
+          continue;
+        }
+
         available = stripIncapableResources(available, framework.capabilities);
 
         // In this first stage, we allocate the role's reservations as well as
@@ -2011,6 +2242,8 @@ void HierarchicalAllocatorProcess::__allocate()
     }
   }
 
+  metrics.allocation_run_quota_stage.stop();
+
   // Similar to the first stage, we will allocate resources while ensuring
   // that the required unreserved non-revocable headroom is still available
   // for unsastified quota guarantees. Otherwise, we will not be able to
@@ -2018,6 +2251,7 @@ void HierarchicalAllocatorProcess::__allocate()
   // revocable resources will always be included in the offers since these
   // are not part of the headroom (and therefore can't be used to satisfy
   // quota guarantees).
+  metrics.allocation_run_share_stage.start();
 
   foreach (const SlaveID& slaveId, slaveIds) {
     CHECK(slaves.contains(slaveId));
@@ -2062,6 +2296,13 @@ void HierarchicalAllocatorProcess::__allocate()
           continue;
         }
 
+        // Skip agents whose attributes do not match the framework's
+        // offer constraints; the framework would only decline them.
+        if (framework.offerConstraints.isSome() &&
+            !framework.offerConstraints->matches(slave.attributes)) {
+          continue;
+        }
+
         available = stripIncapableResources(available, framework.capabilities);
 
         // The resources we offer are the unreserved resources as well as the
@@ -2115,14 +2356,24 @@ void HierarchicalAllocatorProcess::__allocate()
     }
   }
 
+  metrics.allocation_run_share_stage.stop();
+
   if (offerable.empty()) {
     VLOG(2) << "No allocations performed";
   } else {
     // Now offer the resources to each framework.
     foreachkey (const FrameworkID& frameworkId, offerable) {
+      foreachvalue (const hashmap<SlaveID, Resources>& allocation,
+                    offerable.at(frameworkId)) {
+        metrics.allocation_offers_generated += allocation.size();
+      }
+
       offerCallback(frameworkId, offerable.at(frameworkId));
     }
   }
+
+  MESOS_TRACEPOINT2(
+      allocator_run_end, allocationCandidates.size(), offerable.size());
 }
 
 
@@ -2250,7 +2501,11 @@ void HierarchicalAllocatorProcess::_expire(
 
       if (agentFilters != roleFilters->second.end()) {
         // Erase the filter (may be a no-op per the comment above).
-        agentFilters->second.erase(offerFilter);
+        if (agentFilters->second.erase(offerFilter) > 0) {
+          // The agent may now be offerable to this framework again,
+          // so mark it dirty for the next periodic allocation cycle.
+          dirtySlaves.insert(slaveId);
+        }
 
         if (agentFilters->second.empty()) {
           roleFilters->second.erase(slaveId);
@@ -2299,7 +2554,10 @@ void HierarchicalAllocatorProcess::expire(
 
     auto filters = framework.inverseOfferFilters.find(slaveId);
     if (filters != framework.inverseOfferFilters.end()) {
-      filters->second.erase(inverseOfferFilter);
+      // See the comment in `_expire()` regarding dirtying the agent.
+      if (filters->second.erase(inverseOfferFilter) > 0) {
+        dirtySlaves.insert(slaveId);
+      }
 
       if (filters->second.empty()) {
         framework.inverseOfferFilters.erase(slaveId);
@@ -2373,7 +2631,36 @@ bool HierarchicalAllocatorProcess::isFiltered(
     return false;
   }
 
+  // Compute the offered scalar quantities once so that each filter
+  // can be cheaply pruned: the refused resources can only contain
+  // the offered resources if, for every scalar resource, the refused
+  // quantity is at least the offered quantity. The exact `filter()`
+  // check (which performs `Resources` superset arithmetic) only runs
+  // for filters that pass this dominance test, so agents that have
+  // accumulated many narrow filters are no longer quadratic to check.
+  ResourceQuantities offeredQuantities;
+  foreach (const Resource& resource, resources.scalars()) {
+    offeredQuantities[resource.name()] += resource.scalar();
+  }
+
   foreach (OfferFilter* offerFilter, agentFilters->second) {
+    bool dominated = true;
+
+    foreachpair (const string& name,
+                 const Value::Scalar& scalar,
+                 offeredQuantities) {
+      Option<Value::Scalar> refused = offerFilter->quantities().get(name);
+
+      if (refused.isNone() || !(scalar <= refused.get())) {
+        dominated = false;
+        break;
+      }
+    }
+
+    if (!dominated) {
+      continue;
+    }
+
     if (offerFilter->filter(resources)) {
       VLOG(1) << "Filtered offer with " << resources
               << " on agent " << slaveId
@@ -2782,7 +3069,59 @@ void HierarchicalAllocatorProcess::trackAllocatedResources(
       // See comment at `quotaRoleSorter` declaration regarding non-revocable.
       quotaRoleSorter->allocated(role, slaveId, allocation.nonRevocable());
     }
+
+    trackQuotaConsumption(role, allocation);
+  }
+}
+
+
+void HierarchicalAllocatorProcess::trackQuotaConsumption(
+    const string& role,
+    const Resources& allocation)
+{
+  const Resources unreservedQuantities =
+    allocation.unreserved().nonRevocable().createStrippedScalarQuantity();
+
+  if (!unreservedQuantities.empty()) {
+    roleUnreservedAllocationScalarQuantities[role] += unreservedQuantities;
+  }
+
+  allocatedReservationScalarQuantities +=
+    allocation.reserved().createStrippedScalarQuantity();
+}
+
+
+void HierarchicalAllocatorProcess::untrackQuotaConsumption(
+    const string& role,
+    const Resources& allocation)
+{
+  const Resources unreservedQuantities =
+    allocation.unreserved().nonRevocable().createStrippedScalarQuantity();
+
+  if (!unreservedQuantities.empty()) {
+    CHECK(roleUnreservedAllocationScalarQuantities.contains(role));
+
+    Resources& currentQuantities =
+      roleUnreservedAllocationScalarQuantities.at(role);
+
+    CHECK(currentQuantities.contains(unreservedQuantities))
+      << currentQuantities << " does not contain " << unreservedQuantities;
+
+    currentQuantities -= unreservedQuantities;
+
+    if (currentQuantities.empty()) {
+      roleUnreservedAllocationScalarQuantities.erase(role);
+    }
   }
+
+  const Resources reservedQuantities =
+    allocation.reserved().createStrippedScalarQuantity();
+
+  CHECK(allocatedReservationScalarQuantities.contains(reservedQuantities))
+    << allocatedReservationScalarQuantities
+    << " does not contain " << reservedQuantities;
+
+  allocatedReservationScalarQuantities -= reservedQuantities;
 }
 
 
@@ -2817,6 +3156,8 @@ void HierarchicalAllocatorProcess::untrackAllocatedResources(
       // See comment at `quotaRoleSorter` declaration regarding non-revocable.
       quotaRoleSorter->unallocated(role, slaveId, allocation.nonRevocable());
     }
+
+    untrackQuotaConsumption(role, allocation);
   }
 }
 
@@ -37,6 +37,7 @@
 
 #include "master/allocator/mesos/allocator.hpp"
 #include "master/allocator/mesos/metrics.hpp"
+#include "master/allocator/mesos/offer_constraints.hpp"
 
 #include "master/allocator/sorter/drf/sorter.hpp"
 #include "master/allocator/sorter/random/sorter.hpp"
@@ -241,6 +242,14 @@ protected:
   // Allocate any allocatable resources from all known agents.
   process::Future<Nothing> allocate();
 
+  // Trigger the periodic allocation. Agents marked dirty by events
+  // that do not trigger an event-driven allocation themselves (e.g.
+  // `recoverResources()`) are evaluated on every cycle; a full sweep
+  // over all agents is still performed periodically as a fallback
+  // for changes that dirty tracking cannot observe (e.g. expired
+  // offer filters).
+  process::Future<Nothing> batch();
+
   // Allocate resources from the specified agent.
   process::Future<Nothing> allocate(const SlaveID& slaveId);
 
@@ -248,8 +257,12 @@ protected:
   // is deferred and batched with other allocation requests.
   process::Future<Nothing> allocate(const hashset<SlaveID>& slaveIds);
 
-  // Method that performs allocation work.
-  Nothing _allocate();
+  // Method that performs allocation work. Large candidate sets are
+  // time-sliced: at most a bounded number of agents is evaluated per
+  // invocation and the remainder is handled by a chained dispatch,
+  // so that queued events (e.g. `recoverResources()`) are not starved
+  // behind a long allocation run.
+  process::Future<Nothing> _allocate();
 
   // Helper for `_allocate()` that allocates resources for offers.
   void __allocate();
@@ -331,6 +344,11 @@ protected:
 
     protobuf::framework::Capabilities capabilities;
 
+    // The framework's attribute-based offer constraints, compiled
+    // when the framework is added or updated. `None` if the framework
+    // has no (valid) constraints, in which case every agent matches.
+    Option<OfferConstraintsFilter> offerConstraints;
+
     // Active offer and inverse offer filters for the framework.
     // Offer filters are tied to the role the filtered resources
     // were allocated to.
@@ -377,6 +395,7 @@ protected:
         const Resources& _total,
         const Resources& _allocated)
       : info(_info),
+        attributes(_info.attributes()),
         capabilities(_capabilities),
         activated(_activated),
         total(_total),
@@ -419,6 +438,10 @@ protected:
     // scheduling.
     SlaveInfo info;
 
+    // The agent's attributes compiled into a hashed representation,
+    // against which framework offer constraints are evaluated.
+    CompiledAttributes attributes;
+
     protobuf::slave::Capabilities capabilities;
 
     bool activated; // Whether to offer resources.
@@ -524,6 +547,16 @@ protected:
   // processed, the set of candidates is cleared.
   hashset<SlaveID> allocationCandidates;
 
+  // A set of agents whose allocatable resources changed since they
+  // were last evaluated (e.g. due to recovered resources). These are
+  // picked up by the next periodic allocation cycle, so that the
+  // cycle does not need to sweep over every agent in the cluster.
+  hashset<SlaveID> dirtySlaves;
+
+  // The number of periodic allocation cycles performed since the
+  // last full sweep over all agents.
+  size_t cyclesSinceFullSweep;
+
   // Future for the dispatched allocation that becomes
   // ready after the allocation run is complete.
   Option<process::Future<Nothing>> allocation;
@@ -546,6 +579,21 @@ protected:
   // be stored in the map.
   hashmap<std::string, Resources> reservationScalarQuantities;
 
+  // The unreserved, non-revocable scalar quantities allocated to
+  // each role, maintained incrementally by
+  // `trackAllocatedResources()` / `untrackAllocatedResources()`.
+  // Combined with `reservationScalarQuantities` this yields each
+  // role's consumed quota, so `__allocate()` does not need to sweep
+  // the cluster to derive it.
+  //
+  // Only roles with non-empty quantities are stored in the map.
+  hashmap<std::string, Resources> roleUnreservedAllocationScalarQuantities;
+
+  // The scalar quantities of allocated reservations across all roles
+  // and agents, likewise maintained incrementally. Used in the quota
+  // headroom computation in `__allocate()`.
+  Resources allocatedReservationScalarQuantities;
+
   // Slaves to send offers for.
   Option<hashset<std::string>> whitelist;
 
@@ -705,6 +753,18 @@ private:
       const FrameworkID& frameworkId,
       const Resources& allocated);
 
+  // Helpers that keep the incrementally maintained quota accounting
+  // (`roleUnreservedAllocationScalarQuantities` and
+  // `allocatedReservationScalarQuantities`) consistent when an
+  // allocation for `role` is tracked, untracked or converted.
+  void trackQuotaConsumption(
+      const std::string& role,
+      const Resources& allocation);
+
+  void untrackQuotaConsumption(
+      const std::string& role,
+      const Resources& allocation);
+
   // Helper that removes all existing offer filters for the given slave
   // id.
   void removeFilters(const SlaveID& slaveId);
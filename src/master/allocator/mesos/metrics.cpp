@@ -55,13 +55,28 @@ Metrics::Metrics(const HierarchicalAllocatorProcess& _allocator)
             allocator, &HierarchicalAllocatorProcess::_event_queue_dispatches)),
     allocation_runs("allocator/mesos/allocation_runs"),
     allocation_run("allocator/mesos/allocation_run", Hours(1)),
-    allocation_run_latency("allocator/mesos/allocation_run_latency", Hours(1))
+    allocation_run_latency("allocator/mesos/allocation_run_latency", Hours(1)),
+    allocation_run_headroom(
+        "allocator/mesos/allocation_run_headroom", Hours(1)),
+    allocation_run_quota_stage(
+        "allocator/mesos/allocation_run_quota_stage", Hours(1)),
+    allocation_run_share_stage(
+        "allocator/mesos/allocation_run_share_stage", Hours(1)),
+    allocation_agents_evaluated(
+        "allocator/mesos/allocation_agents_evaluated"),
+    allocation_offers_generated(
+        "allocator/mesos/allocation_offers_generated")
 {
   process::metrics::add(event_queue_dispatches);
   process::metrics::add(event_queue_dispatches_);
   process::metrics::add(allocation_runs);
   process::metrics::add(allocation_run);
   process::metrics::add(allocation_run_latency);
+  process::metrics::add(allocation_run_headroom);
+  process::metrics::add(allocation_run_quota_stage);
+  process::metrics::add(allocation_run_share_stage);
+  process::metrics::add(allocation_agents_evaluated);
+  process::metrics::add(allocation_offers_generated);
 
   // Create and install gauges for the total and allocated
   // amount of standard scalar resources.
@@ -101,6 +116,11 @@ Metrics::~Metrics()
   process::metrics::remove(allocation_runs);
   process::metrics::remove(allocation_run);
   process::metrics::remove(allocation_run_latency);
+  process::metrics::remove(allocation_run_headroom);
+  process::metrics::remove(allocation_run_quota_stage);
+  process::metrics::remove(allocation_run_share_stage);
+  process::metrics::remove(allocation_agents_evaluated);
+  process::metrics::remove(allocation_offers_generated);
 
   foreach (const PullGauge& gauge, resources_total) {
     process::metrics::remove(gauge);
@@ -73,6 +73,22 @@ struct Metrics
   // The latency of allocation runs due to the batching of allocation requests.
   process::metrics::Timer<Milliseconds> allocation_run_latency;
 
+  // Time spent computing quota consumption and headroom at the
+  // start of an allocation run.
+  process::metrics::Timer<Milliseconds> allocation_run_headroom;
+
+  // Time spent in the quota guarantee (first) allocation stage.
+  process::metrics::Timer<Milliseconds> allocation_run_quota_stage;
+
+  // Time spent in the fair share (second) allocation stage.
+  process::metrics::Timer<Milliseconds> allocation_run_share_stage;
+
+  // Total number of agents evaluated by allocation runs.
+  process::metrics::Counter allocation_agents_evaluated;
+
+  // Total number of offers generated by allocation runs.
+  process::metrics::Counter allocation_offers_generated;
+
   // PullGauges for the total amount of each resource in the cluster.
   std::vector<process::metrics::PullGauge> resources_total;
 
@@ -0,0 +1,151 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "master/allocator/mesos/offer_constraints.hpp"
+
+#include <stout/error.hpp>
+#include <stout/foreach.hpp>
+#include <stout/stringify.hpp>
+
+using std::string;
+
+namespace mesos {
+namespace internal {
+namespace master {
+namespace allocator {
+
+CompiledAttributes::CompiledAttributes(
+    const google::protobuf::RepeatedPtrField<Attribute>& attributes)
+{
+  foreach (const Attribute& attribute, attributes) {
+    names.insert(attribute.name());
+
+    if (attribute.type() == Value::TEXT) {
+      texts[attribute.name()].insert(attribute.text().value());
+    }
+  }
+}
+
+
+bool CompiledAttributes::exists(const string& name) const
+{
+  return names.contains(name);
+}
+
+
+bool CompiledAttributes::textEquals(
+    const string& name, const string& text) const
+{
+  return texts.contains(name) && texts.at(name).contains(text);
+}
+
+
+Try<OfferConstraintsFilter> OfferConstraintsFilter::create(
+    const FrameworkInfo::OfferConstraints& constraints)
+{
+  typedef FrameworkInfo::OfferConstraints::Predicate Predicate;
+
+  foreach (
+      const FrameworkInfo::OfferConstraints::Group& group,
+      constraints.groups()) {
+    foreach (const Predicate& predicate, group.predicates()) {
+      if (predicate.name().empty()) {
+        return Error("A predicate has an empty attribute name");
+      }
+
+      switch (predicate.type()) {
+        case Predicate::EXISTS:
+        case Predicate::NOT_EXISTS:
+          break;
+
+        case Predicate::TEXT_EQUALS:
+        case Predicate::TEXT_NOT_EQUALS:
+          if (!predicate.has_text()) {
+            return Error(
+                "The predicate on attribute '" + predicate.name() +
+                "' requires 'text' to be set");
+          }
+          break;
+
+        case Predicate::UNKNOWN:
+          return Error(
+              "The predicate on attribute '" + predicate.name() +
+              "' has an unknown type");
+      }
+    }
+  }
+
+  return OfferConstraintsFilter(constraints);
+}
+
+
+bool OfferConstraintsFilter::matches(
+    const CompiledAttributes& attributes) const
+{
+  typedef FrameworkInfo::OfferConstraints::Predicate Predicate;
+
+  // An agent with no constraint groups matches trivially.
+  if (constraints.groups().empty()) {
+    return true;
+  }
+
+  foreach (
+      const FrameworkInfo::OfferConstraints::Group& group,
+      constraints.groups()) {
+    bool matched = true;
+
+    foreach (const Predicate& predicate, group.predicates()) {
+      switch (predicate.type()) {
+        case Predicate::EXISTS:
+          matched = attributes.exists(predicate.name());
+          break;
+
+        case Predicate::NOT_EXISTS:
+          matched = !attributes.exists(predicate.name());
+          break;
+
+        case Predicate::TEXT_EQUALS:
+          matched = attributes.textEquals(predicate.name(), predicate.text());
+          break;
+
+        case Predicate::TEXT_NOT_EQUALS:
+          matched =
+            !attributes.textEquals(predicate.name(), predicate.text());
+          break;
+
+        case Predicate::UNKNOWN:
+          // Rejected by `create`.
+          matched = false;
+          break;
+      }
+
+      if (!matched) {
+        break;
+      }
+    }
+
+    if (matched) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+} // namespace allocator {
+} // namespace master {
+} // namespace internal {
+} // namespace mesos {
@@ -0,0 +1,97 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __MASTER_ALLOCATOR_MESOS_OFFER_CONSTRAINTS_HPP__
+#define __MASTER_ALLOCATOR_MESOS_OFFER_CONSTRAINTS_HPP__
+
+#include <string>
+
+#include <google/protobuf/repeated_field.h>
+
+#include <mesos/mesos.hpp>
+
+#include <stout/hashmap.hpp>
+#include <stout/hashset.hpp>
+#include <stout/try.hpp>
+
+namespace mesos {
+namespace internal {
+namespace master {
+namespace allocator {
+
+// An agent's attributes compiled into a typed, hashed representation,
+// so that evaluating constraint predicates against them does not
+// re-scan the attribute list and re-compare strings per predicate.
+// This is done once when the agent is added to (or updated in) the
+// allocator, rather than on every allocation cycle.
+class CompiledAttributes
+{
+public:
+  CompiledAttributes() {}
+
+  explicit CompiledAttributes(
+      const google::protobuf::RepeatedPtrField<Attribute>& attributes);
+
+  // Returns true if an attribute with the given name exists,
+  // regardless of its type.
+  bool exists(const std::string& name) const;
+
+  // Returns true if a TEXT attribute with the given name exists and
+  // has a value equal to `text`.
+  bool textEquals(const std::string& name, const std::string& text) const;
+
+private:
+  hashset<std::string> names;
+
+  // The values of TEXT attributes keyed by name. Since attribute
+  // names are not (yet) enforced to be unique (MESOS-1215), all
+  // values of a duplicated name are kept.
+  hashmap<std::string, hashset<std::string>> texts;
+};
+
+
+// A framework's offer constraints compiled when the framework is
+// added to (or updated in) the allocator. The allocator evaluates the
+// constraints against each agent's `CompiledAttributes` before
+// offering, so that agents the framework would never accept are
+// skipped without an offer/decline round-trip.
+class OfferConstraintsFilter
+{
+public:
+  // Returns an error if the constraints are malformed, e.g., a
+  // predicate has an unknown type, an empty attribute name, or lacks
+  // the `text` required by its type.
+  static Try<OfferConstraintsFilter> create(
+      const FrameworkInfo::OfferConstraints& constraints);
+
+  // Returns true if the agent's attributes match the constraints,
+  // i.e., all predicates of at least one group hold.
+  bool matches(const CompiledAttributes& attributes) const;
+
+private:
+  explicit OfferConstraintsFilter(
+      const FrameworkInfo::OfferConstraints& _constraints)
+    : constraints(_constraints) {}
+
+  FrameworkInfo::OfferConstraints constraints;
+};
+
+} // namespace allocator {
+} // namespace master {
+} // namespace internal {
+} // namespace mesos {
+
+#endif // __MASTER_ALLOCATOR_MESOS_OFFER_CONSTRAINTS_HPP__
@@ -19,6 +19,7 @@
 #include <iterator>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <mesos/mesos.hpp>
@@ -66,6 +67,7 @@ void DRFSorter::initialize(
     const Option<set<string>>& _fairnessExcludeResourceNames)
 {
   fairnessExcludeResourceNames = _fairnessExcludeResourceNames;
+  shareTotals = None();
 }
 
 
@@ -111,17 +113,18 @@ void DRFSorter::add(const string& clientPath)
       parent->addChild(internal);
       internal->allocation = current->allocation;
 
-      CHECK_EQ(current->path, internal->path);
+      CHECK_EQ(*current->path, *internal->path);
 
       // Update `current` to become a virtual leaf node and a child of
       // `internal`.
       current->name = ".";
       current->parent = internal;
-      current->path = strings::join("/", parent->path, current->name);
+      current->path = StringInterner::roles().intern(
+          strings::join("/", *parent->path, current->name));
 
       internal->addChild(current);
 
-      CHECK_EQ(internal->path, current->clientPath());
+      CHECK_EQ(*internal->path, current->clientPath());
 
       current = internal;
     }
@@ -232,8 +235,8 @@ void DRFSorter::remove(const string& clientPath)
 
       if (child->name == ".") {
         CHECK(child->isLeaf());
-        CHECK(clients.contains(current->path));
-        CHECK_EQ(child, clients.at(current->path));
+        CHECK(clients.contains(*current->path));
+        CHECK_EQ(child, clients.at(*current->path));
 
         current->kind = child->kind;
         current->removeChild(child);
@@ -248,7 +251,7 @@ void DRFSorter::remove(const string& clientPath)
           current->parent->addChild(current);
         }
 
-        clients[current->path] = current;
+        clients[*current->path] = current;
 
         delete child;
       }
@@ -328,7 +331,7 @@ void DRFSorter::updateWeight(const string& path, double weight)
     node = CHECK_NOTNULL(node->parent);
   }
 
-  CHECK_EQ(path, node->path);
+  CHECK_EQ(path, *node->path);
 
   node->weight = weight;
 }
@@ -355,33 +358,7 @@ void DRFSorter::allocated(
     // nodes. See the comment on `Node::children`.
     if (!dirty && current->kind != Node::INACTIVE_LEAF) {
       current->share = calculateShare(current);
-
-      vector<Node*>& children = current->parent->children;
-
-      // Locate the node position in the parent's children
-      // and shift it into its sorted position.
-      //
-      // TODO(bmahler): Consider storing the node's position
-      // in the parent's children to avoid scanning.
-      auto position = std::find(children.begin(), children.end(), current);
-      CHECK(position != children.end());
-
-      // Shift left until done (if needed).
-      while (position != children.begin() &&
-             DRFSorter::Node::compareDRF(current, *std::prev(position))) {
-        std::swap(*position, *std::prev(position));
-        --position;
-      }
-
-      // Or, shift right until done (if needed). Note that when
-      // shifting right, we need to stop once we reach the
-      // inactive leaves (see `Node::children`).
-      while (std::next(position) != children.end() &&
-             (*std::next(position))->kind != Node::INACTIVE_LEAF &&
-             DRFSorter::Node::compareDRF(*std::next(position), current)) {
-        std::swap(*position, *std::next(position));
-        ++position;
-      }
+      reposition(current);
     }
 
     current = CHECK_NOTNULL(current->parent);
@@ -395,10 +372,6 @@ void DRFSorter::update(
     const Resources& oldAllocation,
     const Resources& newAllocation)
 {
-  // TODO(bmahler): Check if the quantities of resources between the old and new
-  // allocations are the same. If not, we need to re-calculate the shares, as is
-  // being currently done, for safety.
-
   Node* current = CHECK_NOTNULL(find(clientPath));
 
   // NOTE: We don't currently update the `allocation` for the root
@@ -409,8 +382,14 @@ void DRFSorter::update(
     current = CHECK_NOTNULL(current->parent);
   }
 
-  // Just assume the total has changed, per the TODO above.
-  dirty = true;
+  // Updates only replace resources on the same agent with resources
+  // of equal size (e.g. reservation and volume operations), in which
+  // case the shares are unchanged and no re-sorting is necessary.
+  // Re-sort for safety if the scalar quantities did change.
+  if (oldAllocation.createStrippedScalarQuantity() !=
+      newAllocation.createStrippedScalarQuantity()) {
+    dirty = true;
+  }
 }
 
 
@@ -421,19 +400,24 @@ void DRFSorter::unallocated(
 {
   Node* current = CHECK_NOTNULL(find(clientPath));
 
+  // Walk up the tree adjusting allocations. As in `allocated()`,
+  // if the tree is sorted we keep it sorted by shifting each
+  // affected node into its new position, rather than marking the
+  // whole tree dirty and re-sorting all clients.
+  //
   // NOTE: We don't currently update the `allocation` for the root
   // node. This is debatable, but the current implementation doesn't
   // require looking at the allocation of the root node.
   while (current != root) {
     current->allocation.subtract(slaveId, resources);
+
+    if (!dirty && current->kind != Node::INACTIVE_LEAF) {
+      current->share = calculateShare(current);
+      reposition(current);
+    }
+
     current = CHECK_NOTNULL(current->parent);
   }
-
-  // TODO(bmahler): Similar to `allocated()`, avoid dirtying the
-  // tree here in favor of adjusting the node positions. This
-  // hasn't been critical to do since we don't allocate upon
-  // resource recovery in the allocator.
-  dirty = true;
 }
 
 
@@ -525,6 +509,7 @@ void DRFSorter::add(const SlaveID& slaveId, const Resources& resources)
     // something else changes before the next allocation we don't
     // recalculate everything twice.
     dirty = true;
+    shareTotals = None();
   }
 }
 
@@ -560,6 +545,7 @@ void DRFSorter::remove(const SlaveID& slaveId, const Resources& resources)
     }
 
     dirty = true;
+    shareTotals = None();
   }
 }
 
@@ -652,40 +638,84 @@ size_t DRFSorter::count() const
 
 double DRFSorter::calculateShare(const Node* node) const
 {
-  double share = 0.0;
-
   // TODO(benh): This implementation of "dominant resource fairness"
   // currently does not take into account resources that are not
   // scalars.
 
-  foreachpair (const string& resourceName,
-               const Value::Scalar& scalar,
-               total_.totals) {
-    // Filter out the resources excluded from fair sharing.
-    if (fairnessExcludeResourceNames.isSome() &&
-        fairnessExcludeResourceNames->count(resourceName) > 0) {
-      continue;
-    }
+  // Rebuild the cached totals that participate in fair sharing if
+  // the total has changed since the last rebuild. This filtering is
+  // done once per total change rather than once per client.
+  if (shareTotals.isNone()) {
+    std::vector<std::pair<string, double>> totals;
+
+    foreachpair (const string& resourceName,
+                 const Value::Scalar& scalar,
+                 total_.totals) {
+      // Filter out the resources excluded from fair sharing.
+      if (fairnessExcludeResourceNames.isSome() &&
+          fairnessExcludeResourceNames->count(resourceName) > 0) {
+        continue;
+      }
 
-    if (scalar.value() <= 0.0) {
-      continue;
+      if (scalar.value() <= 0.0) {
+        continue;
+      }
+
+      totals.push_back({resourceName, scalar.value()});
     }
 
+    shareTotals = std::move(totals);
+  }
+
+  double share = 0.0;
+
+  foreach (const auto& total, shareTotals.get()) {
     Value::Scalar allocation =
-      node->allocation.totals.get(resourceName)
+      node->allocation.totals.get(total.first)
         .getOrElse(Value::Scalar()); // Absent means zero.
 
-    share = std::max(share, allocation.value() / scalar.value());
+    share = std::max(share, allocation.value() / total.second);
   }
 
   return share / getWeight(node);
 }
 
 
+void DRFSorter::reposition(Node* current)
+{
+  vector<Node*>& children = current->parent->children;
+
+  // Locate the node position in the parent's children
+  // and shift it into its sorted position.
+  //
+  // TODO(bmahler): Consider storing the node's position
+  // in the parent's children to avoid scanning.
+  auto position = std::find(children.begin(), children.end(), current);
+  CHECK(position != children.end());
+
+  // Shift left until done (if needed).
+  while (position != children.begin() &&
+         DRFSorter::Node::compareDRF(current, *std::prev(position))) {
+    std::swap(*position, *std::prev(position));
+    --position;
+  }
+
+  // Or, shift right until done (if needed). Note that when
+  // shifting right, we need to stop once we reach the
+  // inactive leaves (see `Node::children`).
+  while (std::next(position) != children.end() &&
+         (*std::next(position))->kind != Node::INACTIVE_LEAF &&
+         DRFSorter::Node::compareDRF(*std::next(position), current)) {
+    std::swap(*position, *std::next(position));
+    ++position;
+  }
+}
+
+
 double DRFSorter::getWeight(const Node* node) const
 {
   if (node->weight.isNone()) {
-    node->weight = weights.get(node->path).getOrElse(1.0);
+    node->weight = weights.get(*node->path).getOrElse(1.0);
   }
 
   return CHECK_NOTNONE(node->weight);
@@ -18,8 +18,10 @@
 #define __MASTER_ALLOCATOR_SORTER_DRF_SORTER_HPP__
 
 #include <algorithm>
+#include <memory>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <mesos/mesos.hpp>
@@ -30,6 +32,7 @@
 #include <stout/hashmap.hpp>
 #include <stout/option.hpp>
 
+#include "common/interner.hpp"
 #include "common/resource_quantities.hpp"
 
 #include "master/allocator/sorter/drf/metrics.hpp"
@@ -115,6 +118,12 @@ private:
   // Returns the dominant resource share for the node.
   double calculateShare(const Node* node) const;
 
+  // Shifts the node into its sorted position among its parent's
+  // children after the node's share has changed. This restores
+  // ordering invariant (2) on `Node::children` incrementally,
+  // rather than re-sorting the entire tree.
+  void reposition(Node* node);
+
   // Returns the weight associated with the node. If no weight has
   // been configured for the node's path, the default weight (1.0) is
   // returned.
@@ -180,6 +189,14 @@ private:
     ResourceQuantities totals;
   } total_;
 
+  // Cached subset of `total_.totals` that participates in fair
+  // sharing, i.e. with fairness-excluded resources and non-positive
+  // quantities filtered out. Rebuilt lazily by `calculateShare()`
+  // whenever the total changes, so that the hot sort path does not
+  // re-filter the totals for every client. Marked mutable since the
+  // caching writes to this are logically const.
+  mutable Option<std::vector<std::pair<std::string, double>>> shareTotals;
+
   // Metrics are optionally exposed by the sorter.
   friend Metrics;
   Option<Metrics> metrics;
@@ -217,11 +234,12 @@ struct DRFSorter::Node
     //  (2) If a child of the root node, use the child's name
     //  (3) Otherwise, use the parent's name, "/", and the child's name.
     if (parent == nullptr) {
-      path = "";
+      path = StringInterner::roles().intern("");
     } else if (parent->parent == nullptr) {
-      path = name;
+      path = StringInterner::roles().intern(name);
     } else {
-      path = strings::join("/", parent->path, name);
+      path = StringInterner::roles().intern(
+          strings::join("/", *parent->path, name));
     }
   }
 
@@ -240,8 +258,11 @@ struct DRFSorter::Node
   std::string name;
 
   // Complete path from root to node. This includes the trailing "."
-  // label for virtual leaf nodes.
-  std::string path;
+  // label for virtual leaf nodes. The path is interned: nodes for
+  // the same role in different sorters (e.g., the role sorter and
+  // the quota role sorter) share one copy of the string, and nodes
+  // with equal paths compare equal by pointer.
+  std::shared_ptr<const std::string> path;
 
   double share;
 
@@ -278,14 +299,14 @@ struct DRFSorter::Node
   // (virtual leaf), and "a/b". The `clientPath()` of "a/." is "a",
   // because that is the name of the client associated with that
   // virtual leaf node.
-  std::string clientPath() const
+  const std::string& clientPath() const
   {
     if (name == ".") {
       CHECK(kind == ACTIVE_LEAF || kind == INACTIVE_LEAF);
-      return CHECK_NOTNULL(parent)->path;
+      return *CHECK_NOTNULL(parent)->path;
     }
 
-    return path;
+    return *path;
   }
 
   bool isLeaf() const
@@ -457,7 +478,13 @@ struct DRFSorter::Node
       return left->allocation.count < right->allocation.count;
     }
 
-    return left->path < right->path;
+    // Interned paths are pointer-equal when the strings are equal,
+    // so only distinct paths are compared byte-wise.
+    if (left->path == right->path) {
+      return false;
+    }
+
+    return *left->path < *right->path;
   }
 };
 
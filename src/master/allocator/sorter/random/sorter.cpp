@@ -107,17 +107,18 @@ void RandomSorter::add(const string& clientPath)
       parent->addChild(internal);
       internal->allocation = current->allocation;
 
-      CHECK_EQ(current->path, internal->path);
+      CHECK_EQ(*current->path, *internal->path);
 
       // Update `current` to become a virtual leaf node and a child of
       // `internal`.
       current->name = ".";
       current->parent = internal;
-      current->path = strings::join("/", parent->path, current->name);
+      current->path = StringInterner::roles().intern(
+          strings::join("/", *parent->path, current->name));
 
       internal->addChild(current);
 
-      CHECK_EQ(internal->path, current->clientPath());
+      CHECK_EQ(*internal->path, current->clientPath());
 
       current = internal;
     }
@@ -165,6 +166,8 @@ void RandomSorter::add(const string& clientPath)
   CHECK(!clients.contains(clientPath));
 
   clients[clientPath] = current;
+
+  shuffled = None();
 }
 
 
@@ -221,8 +224,8 @@ void RandomSorter::remove(const string& clientPath)
 
       if (child->name == ".") {
         CHECK(child->isLeaf());
-        CHECK(clients.contains(current->path));
-        CHECK_EQ(child, clients.at(current->path));
+        CHECK(clients.contains(*current->path));
+        CHECK_EQ(child, clients.at(*current->path));
 
         current->kind = child->kind;
         current->removeChild(child);
@@ -237,7 +240,7 @@ void RandomSorter::remove(const string& clientPath)
           current->parent->addChild(current);
         }
 
-        clients[current->path] = current;
+        clients[*current->path] = current;
 
         delete child;
       }
@@ -245,6 +248,8 @@ void RandomSorter::remove(const string& clientPath)
 
     current = parent;
   }
+
+  shuffled = None();
 }
 
 
@@ -261,6 +266,8 @@ void RandomSorter::activate(const string& clientPath)
 
     client->parent->removeChild(client);
     client->parent->addChild(client);
+
+    shuffled = None();
   }
 }
 
@@ -278,6 +285,8 @@ void RandomSorter::deactivate(const string& clientPath)
 
     client->parent->removeChild(client);
     client->parent->addChild(client);
+
+    shuffled = None();
   }
 }
 
@@ -286,6 +295,8 @@ void RandomSorter::updateWeight(const string& path, double weight)
 {
   weights[path] = weight;
 
+  shuffled = None();
+
   // Update the weight of the corresponding internal node,
   // if it exists (this client may not exist despite there
   // being a weight).
@@ -300,7 +311,7 @@ void RandomSorter::updateWeight(const string& path, double weight)
     node = CHECK_NOTNULL(node->parent);
   }
 
-  CHECK_EQ(path, node->path);
+  CHECK_EQ(path, *node->path);
 
   node->weight = weight;
 }
@@ -320,6 +331,10 @@ void RandomSorter::allocated(
     current->allocation.add(slaveId, resources);
     current = CHECK_NOTNULL(current->parent);
   }
+
+  // Re-shuffle on the next `sort()` so that each allocation sees a
+  // fresh random order; until then the cached order is looped over.
+  shuffled = None();
 }
 
 
@@ -483,6 +498,16 @@ void RandomSorter::remove(const SlaveID& slaveId, const Resources& resources)
 
 vector<string> RandomSorter::sort()
 {
+  // Re-use the cached shuffle if nothing changed since it was
+  // computed. The cache is invalidated by allocations, weight
+  // updates and client changes; this means that the allocator's
+  // per-agent `sort()` calls loop through a single weighted shuffle
+  // until an allocation is actually made, rather than re-shuffling
+  // all clients for every agent.
+  if (shuffled.isSome()) {
+    return shuffled.get();
+  }
+
   std::function<void (Node*)> shuffleTree = [this, &shuffleTree](Node* node) {
     // Inactive leaves are always stored at the end of the
     // `children` vector; this means that we should only shuffle
@@ -542,6 +567,8 @@ vector<string> RandomSorter::sort()
 
   listClients(root);
 
+  shuffled = result;
+
   return result;
 }
 
@@ -561,7 +588,7 @@ size_t RandomSorter::count() const
 double RandomSorter::getWeight(const Node* node) const
 {
   if (node->weight.isNone()) {
-    node->weight = weights.get(node->path).getOrElse(1.0);
+    node->weight = weights.get(*node->path).getOrElse(1.0);
   }
 
   return CHECK_NOTNONE(node->weight);
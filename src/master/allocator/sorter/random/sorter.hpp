@@ -18,6 +18,7 @@
 #define __MASTER_ALLOCATOR_SORTER_RANDOM_SORTER_HPP__
 
 #include <algorithm>
+#include <memory>
 #include <random>
 #include <set>
 #include <string>
@@ -31,6 +32,7 @@
 #include <stout/hashmap.hpp>
 #include <stout/option.hpp>
 
+#include "common/interner.hpp"
 #include "common/resource_quantities.hpp"
 
 #include "master/allocator/sorter/sorter.hpp"
@@ -101,11 +103,13 @@ public:
 
   void remove(const SlaveID& slaveId, const Resources& resources) override;
 
-  // This will perform a weighted random shuffle on each call.
-  //
-  // TODO(bmahler): Unlike the DRF sorter, the allocator ideally would
-  // not call `sort()` for every agent, but rather loop through a single
-  // weighted shuffle before re-shuffling..
+  // This performs a weighted random shuffle, however the shuffled
+  // order is cached and re-used across calls until an allocation or
+  // a client change invalidates it. This means that within an
+  // allocation cycle the clients are looped through in a single
+  // shuffled order until one of them is actually allocated to,
+  // rather than paying for a full O(n log n) re-shuffle on every
+  // agent evaluated.
   std::vector<std::string> sort() override;
 
   bool contains(const std::string& clientPath) const override;
@@ -129,6 +133,12 @@ private:
   // Used for random number generation.
   std::mt19937 generator;
 
+  // Cached result of the last weighted shuffle. `sort()` re-uses the
+  // cached order until the next allocation or client change, rather
+  // than re-shuffling every client for every agent evaluated in an
+  // allocation cycle; see the comment on `sort()`.
+  Option<std::vector<std::string>> shuffled;
+
   // The root node in the sorter tree.
   Node* root;
 
@@ -211,11 +221,12 @@ struct RandomSorter::Node
     //  (2) If a child of the root node, use the child's name
     //  (3) Otherwise, use the parent's name, "/", and the child's name.
     if (parent == nullptr) {
-      path = "";
+      path = StringInterner::roles().intern("");
     } else if (parent->parent == nullptr) {
-      path = name;
+      path = StringInterner::roles().intern(name);
     } else {
-      path = strings::join("/", parent->path, name);
+      path = StringInterner::roles().intern(
+          strings::join("/", *parent->path, name));
     }
   }
 
@@ -234,8 +245,11 @@ struct RandomSorter::Node
   std::string name;
 
   // Complete path from root to node. This includes the trailing "."
-  // label for virtual leaf nodes.
-  std::string path;
+  // label for virtual leaf nodes. The path is interned: nodes for
+  // the same role in different sorters (e.g., the role sorter and
+  // the quota role sorter) share one copy of the string, and nodes
+  // with equal paths compare equal by pointer.
+  std::shared_ptr<const std::string> path;
 
   // Cached weight of the node, access this through `getWeight()`.
   // The value is cached by `getWeight()` and updated by
@@ -266,14 +280,14 @@ struct RandomSorter::Node
   // (virtual leaf), and "a/b". The `clientPath()` of "a/." is "a",
   // because that is the name of the client associated with that
   // virtual leaf node.
-  std::string clientPath() const
+  const std::string& clientPath() const
   {
     if (name == ".") {
       CHECK(kind == ACTIVE_LEAF || kind == INACTIVE_LEAF);
-      return CHECK_NOTNULL(parent)->path;
+      return *CHECK_NOTNULL(parent)->path;
     }
 
-    return path;
+    return *path;
   }
 
   bool isLeaf() const
@@ -59,6 +59,12 @@ constexpr Duration DEFAULT_AUTHENTICATION_V0_TIMEOUT = Seconds(15);
 // scheduler.
 constexpr Duration DEFAULT_HEARTBEAT_INTERVAL = Seconds(15);
 
+// Maximum number of bytes of serialized events the master buffers
+// for a single subscriber to the 'api/vX' endpoint. Subscribers
+// that fall further behind than this are disconnected so that slow
+// consumers cannot make the master buffer events unboundedly.
+constexpr Bytes MAX_SUBSCRIBER_EVENT_BACKLOG = Megabytes(16);
+
 // Amount of time within which a slave PING should be received.
 // NOTE: The slave uses these PING constants to determine when
 // the master has stopped sending pings. If these are made
@@ -108,6 +114,12 @@ constexpr Duration WHITELIST_WATCH_INTERVAL = Seconds(5);
 // Default number of tasks (limit) for /master/tasks endpoint.
 constexpr size_t TASK_LIMIT = 100;
 
+// Maximum number of tasks, unreachable tasks or executors removed in
+// one batch while tearing down a framework. The teardown yields to
+// other queued events between batches so that removing a framework
+// with a very large number of tasks does not stall the master.
+constexpr size_t TEARDOWN_BATCH_SIZE = 1000;
+
 constexpr Duration DEFAULT_REGISTRY_GC_INTERVAL = Minutes(15);
 
 constexpr Duration DEFAULT_REGISTRY_MAX_AGENT_AGE = Weeks(2);
@@ -0,0 +1,348 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "master/contender/log.hpp"
+
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include <mesos/log/log.hpp>
+
+#include <process/clock.hpp>
+#include <process/defer.hpp>
+#include <process/delay.hpp>
+#include <process/dispatch.hpp>
+#include <process/id.hpp>
+#include <process/owned.hpp>
+#include <process/process.hpp>
+
+#include <stout/check.hpp>
+#include <stout/hashmap.hpp>
+#include <stout/json.hpp>
+#include <stout/lambda.hpp>
+#include <stout/numify.hpp>
+#include <stout/option.hpp>
+#include <stout/os.hpp>
+#include <stout/protobuf.hpp>
+#include <stout/stringify.hpp>
+#include <stout/strings.hpp>
+#include <stout/synchronized.hpp>
+
+using namespace process;
+
+using mesos::log::Log;
+
+using std::set;
+using std::string;
+
+namespace mesos {
+namespace master {
+namespace contender {
+
+const Duration MASTER_CONTENDER_LOG_LEASE_DURATION = Seconds(2);
+const Duration MASTER_CONTENDER_LOG_RENEW_INTERVAL = Milliseconds(500);
+
+
+std::shared_ptr<Log> sharedLog(
+    size_t quorum,
+    const string& path,
+    const set<UPID>& pids)
+{
+  // NOTE: Intentionally leaked to sidestep static destruction order
+  // issues at process teardown.
+  static std::mutex* mutex = new std::mutex();
+  static hashmap<string, std::weak_ptr<Log>>* logs =
+    new hashmap<string, std::weak_ptr<Log>>();
+
+  synchronized (mutex) {
+    Option<std::weak_ptr<Log>> log = logs->get(path);
+    if (log.isSome()) {
+      std::shared_ptr<Log> shared = log->lock();
+      if (shared != nullptr) {
+        return shared;
+      }
+    }
+
+    std::shared_ptr<Log> shared(new Log(quorum, path, pids, true));
+    logs->put(path, shared);
+    return shared;
+  }
+}
+
+
+class LogMasterContenderProcess : public Process<LogMasterContenderProcess>
+{
+public:
+  LogMasterContenderProcess(
+      size_t quorum,
+      const string& path,
+      const set<UPID>& pids)
+    : ProcessBase(ID::generate("log-master-contender")),
+      log(sharedLog(quorum, path, pids)),
+      reader(log.get()),
+      leading(false) {}
+
+  ~LogMasterContenderProcess() override
+  {
+    if (candidacyLost.get() != nullptr) {
+      candidacyLost->discard();
+    }
+  }
+
+  void initialize(const MasterInfo& _masterInfo)
+  {
+    masterInfo = _masterInfo;
+
+    // Serialize the MasterInfo to JSON, matching the format the
+    // ZooKeeper contender stores in the leader znode.
+    data = stringify(JSON::protobuf(_masterInfo));
+  }
+
+  Future<Future<Nothing>> contend()
+  {
+    if (masterInfo.isNone()) {
+      return Failure("Initialize the contender first");
+    }
+
+    // Should not recontend if the last candidacy is still active.
+    if (candidacyLost.get() != nullptr &&
+        candidacyLost->future().isPending()) {
+      return Future<Nothing>(candidacyLost->future());
+    }
+
+    candidacyLost.reset(new Promise<Nothing>());
+    leading = false;
+
+    observe();
+
+    return Future<Nothing>(candidacyLost->future());
+  }
+
+private:
+  // Starts (or restarts) an observation pass: remember the current
+  // tail of the log and wait out a lease before deciding whether a
+  // live leader is renewing it.
+  void observe()
+  {
+    reader.ending()
+      .onAny(defer(self(), &Self::_observe, lambda::_1));
+  }
+
+  void _observe(const Future<Log::Position>& ending)
+  {
+    if (!ending.isReady()) {
+      fail("Failed to read the log tail: " +
+           (ending.isFailed() ? ending.failure() : "discarded"));
+      return;
+    }
+
+    observed = ending.get();
+
+    // Jitter the wait so contenders don't probe (and potentially
+    // grab for the coordinatorship) in lockstep.
+    const Duration wait = MASTER_CONTENDER_LOG_LEASE_DURATION *
+      (1.0 + static_cast<double>(os::random()) / RAND_MAX);
+
+    delay(wait, self(), &Self::__observe);
+  }
+
+  void __observe()
+  {
+    reader.ending()
+      .onAny(defer(self(), &Self::___observe, lambda::_1));
+  }
+
+  void ___observe(const Future<Log::Position>& ending)
+  {
+    if (!ending.isReady()) {
+      fail("Failed to read the log tail: " +
+           (ending.isFailed() ? ending.failure() : "discarded"));
+      return;
+    }
+
+    if (observed.isSome() && ending.get() > observed.get()) {
+      // The tail advanced: a live leader is renewing its lease, so
+      // keep observing.
+      _observe(ending);
+      return;
+    }
+
+    // The tail has been static for a full lease: attempt to take
+    // over the coordinatorship.
+    writer.reset(new Log::Writer(log.get()));
+
+    writer->start()
+      .onAny(defer(self(), &Self::started, lambda::_1));
+  }
+
+  void started(const Future<Option<Log::Position>>& position)
+  {
+    if (!position.isReady()) {
+      fail("Failed to start the log writer: " +
+           (position.isFailed() ? position.failure() : "discarded"));
+      return;
+    }
+
+    if (position->isNone()) {
+      // Lost the race for the coordinatorship; back to observing.
+      observe();
+      return;
+    }
+
+    // We are the coordinator: record our MasterInfo as the lease.
+    writer->append(data)
+      .onAny(defer(self(), &Self::renewed, lambda::_1));
+  }
+
+  void renewed(const Future<Option<Log::Position>>& position)
+  {
+    if (!position.isReady()) {
+      fail("Failed to append to the log: " +
+           (position.isFailed() ? position.failure() : "discarded"));
+      return;
+    }
+
+    if (position->isNone()) {
+      // Another contender took over the coordinatorship. If we were
+      // leading, our leadership (and hence candidacy) is over; the
+      // caller decides whether to recontend.
+      if (leading) {
+        LOG(INFO) << "Lost the log coordinatorship while leading";
+        leading = false;
+        candidacyLost->set(Nothing());
+      } else {
+        observe();
+      }
+      return;
+    }
+
+    if (!leading) {
+      leading = true;
+      LOG(INFO) << "Elected as the leading master via the replicated log";
+    }
+
+    // Bound log growth: everything before the latest lease entry is
+    // obsolete. A lost coordinatorship here surfaces at the next
+    // renewal, so the result can be ignored.
+    writer->truncate(position->get());
+
+    delay(MASTER_CONTENDER_LOG_RENEW_INTERVAL, self(), &Self::renew);
+  }
+
+  void renew()
+  {
+    writer->append(data)
+      .onAny(defer(self(), &Self::renewed, lambda::_1));
+  }
+
+  void fail(const string& message)
+  {
+    LOG(ERROR) << message;
+    leading = false;
+    candidacyLost->fail(message);
+  }
+
+  std::shared_ptr<Log> log;
+  Log::Reader reader;
+  Owned<Log::Writer> writer;
+
+  Option<MasterInfo> masterInfo;
+  string data;
+
+  // The tail position at the start of the current observation pass.
+  Option<Log::Position> observed;
+
+  bool leading;
+  Owned<Promise<Nothing>> candidacyLost;
+};
+
+
+Try<LogMasterContender*> LogMasterContender::create(
+    const Parameters& parameters)
+{
+  Option<size_t> quorum;
+  Option<string> path;
+  set<UPID> pids;
+
+  foreach (const Parameter& parameter, parameters.parameter()) {
+    if (parameter.key() == "quorum") {
+      Try<size_t> numified = numify<size_t>(parameter.value());
+      if (numified.isError() || numified.get() == 0) {
+        return Error(
+            "Failed to parse 'quorum=" + parameter.value() +
+            "' as a positive integer");
+      }
+      quorum = numified.get();
+    } else if (parameter.key() == "log_path") {
+      path = parameter.value();
+    } else if (parameter.key() == "replicas") {
+      foreach (const string& replica,
+               strings::tokenize(parameter.value(), ";")) {
+        UPID pid(replica);
+        if (!pid) {
+          return Error("Failed to parse replica pid '" + replica + "'");
+        }
+        pids.insert(pid);
+      }
+    }
+  }
+
+  if (quorum.isNone()) {
+    return Error("Missing required parameter 'quorum'");
+  }
+
+  if (path.isNone()) {
+    return Error("Missing required parameter 'log_path'");
+  }
+
+  return new LogMasterContender(quorum.get(), path.get(), pids);
+}
+
+
+LogMasterContender::LogMasterContender(
+    size_t quorum,
+    const string& path,
+    const set<UPID>& pids)
+{
+  process = new LogMasterContenderProcess(quorum, path, pids);
+  spawn(process);
+}
+
+
+LogMasterContender::~LogMasterContender()
+{
+  terminate(process);
+  process::wait(process);
+  delete process;
+}
+
+
+void LogMasterContender::initialize(const MasterInfo& masterInfo)
+{
+  dispatch(process, &LogMasterContenderProcess::initialize, masterInfo);
+}
+
+
+Future<Future<Nothing>> LogMasterContender::contend()
+{
+  return dispatch(process, &LogMasterContenderProcess::contend);
+}
+
+} // namespace contender {
+} // namespace master {
+} // namespace mesos {
@@ -0,0 +1,117 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __MASTER_CONTENDER_LOG_HPP__
+#define __MASTER_CONTENDER_LOG_HPP__
+
+#include <memory>
+#include <set>
+#include <string>
+
+#include <mesos/mesos.hpp>
+
+#include <mesos/log/log.hpp>
+
+#include <mesos/master/contender.hpp>
+
+#include <process/future.hpp>
+#include <process/pid.hpp>
+
+#include <stout/duration.hpp>
+#include <stout/nothing.hpp>
+#include <stout/try.hpp>
+
+namespace mesos {
+namespace master {
+namespace contender {
+
+// How long a leadership lease lasts without being renewed, and how
+// often the leading contender renews it by appending to the log.
+// Detectors declare the leader gone once the log tail has been
+// static for a full lease duration, so failover detection is bounded
+// by these constants rather than by a ZooKeeper session timeout.
+extern const Duration MASTER_CONTENDER_LOG_LEASE_DURATION;
+extern const Duration MASTER_CONTENDER_LOG_RENEW_INTERVAL;
+
+
+// Returns the process-wide replicated log instance backing leader
+// election for `path`, creating it on first use. A master runs both
+// a contender and a detector: sharing one instance (and hence one
+// local replica) between them avoids opening the on-disk storage
+// twice and keeps the number of replicas acking quorum writes
+// consistent with the quorum size. The quorum and peer pids of the
+// first caller win; subsequent callers for the same path are
+// expected to pass the same values.
+std::shared_ptr<mesos::log::Log> sharedLog(
+    size_t quorum,
+    const std::string& path,
+    const std::set<process::UPID>& pids);
+
+
+class LogMasterContenderProcess;
+
+
+// A contender that elects a leading master through the replicated
+// log quorum itself, removing the need for a ZooKeeper ensemble.
+//
+// The election piggybacks on the log's exclusive writer promise: a
+// contender that acquires the coordinatorship appends its MasterInfo
+// and keeps renewing this "lease" by re-appending it. Contenders
+// that observe the log tail advancing back off, and only attempt to
+// take over the coordinatorship once the tail has been static for a
+// full lease duration (plus jitter, so contenders don't ping-pong
+// the coordinatorship between each other).
+//
+// NOTE: This is intended for masters, which already host replicas of
+// the log: every instance's replica acks quorum writes, so it must
+// not be run on nodes outside the replica ensemble (e.g. agents).
+// It is consumable through the '--master_contender_module' machinery
+// in MasterContender::create().
+class LogMasterContender : public MasterContender
+{
+public:
+  // Creates a contender from module parameters: 'quorum' (required,
+  // a positive integer), 'log_path' (required) and 'replicas'
+  // (optional, a semicolon separated list of peer replica pids).
+  // This is the entry point used by the
+  // 'org_apache_mesos_LogMasterContender' module.
+  static Try<LogMasterContender*> create(const Parameters& parameters);
+
+  // Creates a contender electing through the replicated log at
+  // `path` with the given quorum size, coordinating with the peer
+  // replicas via `pids` (a static ensemble, i.e. no ZooKeeper). The
+  // log instance is shared with other contenders and detectors on
+  // the same path; see `sharedLog()`.
+  LogMasterContender(
+      size_t quorum,
+      const std::string& path,
+      const std::set<process::UPID>& pids);
+
+  ~LogMasterContender() override;
+
+  // MasterContender implementation.
+  void initialize(const MasterInfo& masterInfo) override;
+  process::Future<process::Future<Nothing>> contend() override;
+
+private:
+  LogMasterContenderProcess* process;
+};
+
+} // namespace contender {
+} // namespace master {
+} // namespace mesos {
+
+#endif // __MASTER_CONTENDER_LOG_HPP__
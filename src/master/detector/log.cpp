@@ -0,0 +1,282 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "master/detector/log.hpp"
+
+#include <list>
+#include <memory>
+#include <set>
+#include <string>
+
+#include <mesos/type_utils.hpp>
+
+#include <mesos/log/log.hpp>
+
+#include <process/clock.hpp>
+#include <process/defer.hpp>
+#include <process/delay.hpp>
+#include <process/dispatch.hpp>
+#include <process/id.hpp>
+#include <process/owned.hpp>
+#include <process/process.hpp>
+
+#include <stout/json.hpp>
+#include <stout/lambda.hpp>
+#include <stout/numify.hpp>
+#include <stout/protobuf.hpp>
+#include <stout/strings.hpp>
+
+#include "master/contender/log.hpp"
+
+using namespace process;
+
+using mesos::log::Log;
+
+using std::list;
+using std::set;
+using std::string;
+
+namespace mesos {
+namespace master {
+namespace detector {
+
+const Duration MASTER_DETECTOR_LOG_POLL_INTERVAL = Milliseconds(250);
+
+
+class LogMasterDetectorProcess : public Process<LogMasterDetectorProcess>
+{
+public:
+  LogMasterDetectorProcess(
+      size_t quorum,
+      const string& path,
+      const set<UPID>& pids)
+    : ProcessBase(ID::generate("log-master-detector")),
+      log(contender::sharedLog(quorum, path, pids)),
+      reader(log.get()),
+      leader(None()) {}
+
+  ~LogMasterDetectorProcess() override
+  {
+    discardPromises(&promises);
+  }
+
+  void initialize() override
+  {
+    poll();
+  }
+
+  Future<Option<MasterInfo>> detect(const Option<MasterInfo>& previous)
+  {
+    if (leader != previous) {
+      return leader;
+    }
+
+    Promise<Option<MasterInfo>>* promise = new Promise<Option<MasterInfo>>();
+
+    promise->future()
+      .onDiscard(defer(self(), &Self::discard, promise->future()));
+
+    promises.insert(promise);
+    return promise->future();
+  }
+
+private:
+  void discard(const Future<Option<MasterInfo>>& future)
+  {
+    // Discard the promise holding this future.
+    discardPromises(&promises, future);
+  }
+
+  void poll()
+  {
+    reader.ending()
+      .onAny(defer(self(), &Self::_poll, lambda::_1));
+  }
+
+  void _poll(const Future<Log::Position>& ending)
+  {
+    if (!ending.isReady()) {
+      // Transient failure reading the local replica; the staleness
+      // check below eventually demotes the leader if this persists.
+      LOG(WARNING) << "Failed to read the log tail: "
+                   << (ending.isFailed() ? ending.failure() : "discarded");
+
+      repoll();
+      return;
+    }
+
+    if (lastEnding.isNone() || ending.get() > lastEnding.get()) {
+      // The tail advanced: read the latest lease entry.
+      lastEnding = ending.get();
+      lastAdvance = Clock::now();
+
+      reader.read(ending.get(), ending.get())
+        .onAny(defer(self(), &Self::fetched, lambda::_1));
+      return;
+    }
+
+    // No tail movement: the leader is gone once the lease expires.
+    if (leader.isSome() &&
+        lastAdvance.isSome() &&
+        Clock::now() - lastAdvance.get() >
+          contender::MASTER_CONTENDER_LOG_LEASE_DURATION) {
+      LOG(INFO) << "The leading master's lease expired";
+
+      leader = None();
+      setPromises(&promises, leader);
+
+      // Learn any in-flight entries from the quorum; a lease the
+      // local replica simply missed will surface on the next poll.
+      reader.catchup();
+    }
+
+    repoll();
+  }
+
+  void fetched(const Future<list<Log::Entry>>& entries)
+  {
+    // A read can fail transiently, e.g. when the entry is truncated
+    // or not yet learned locally; keep the previous leader and let a
+    // subsequent poll pick up the tail.
+    if (entries.isReady() && !entries->empty()) {
+      parse(entries->back().data);
+    }
+
+    repoll();
+  }
+
+  void parse(const string& data)
+  {
+    // An empty entry is a log artifact (e.g. from initialization),
+    // not a lease.
+    if (data.empty()) {
+      return;
+    }
+
+    Try<JSON::Object> object = JSON::parse<JSON::Object>(data);
+
+    if (object.isError()) {
+      LOG(WARNING) << "Failed to parse the lease entry as JSON: "
+                   << object.error();
+      return;
+    }
+
+    Try<mesos::MasterInfo> info =
+      ::protobuf::parse<mesos::MasterInfo>(object.get());
+
+    if (info.isError()) {
+      LOG(WARNING) << "Failed to parse the lease entry into a MasterInfo"
+                   << " protocol buffer: " << info.error();
+      return;
+    }
+
+    if (leader.isNone() || !(leader.get() == info.get())) {
+      leader = info.get();
+
+      LOG(INFO) << "A new leading master (UPID="
+                << UPID(leader->pid()) << ") is detected";
+
+      setPromises(&promises, leader);
+    }
+  }
+
+  void repoll()
+  {
+    delay(MASTER_DETECTOR_LOG_POLL_INTERVAL, self(), &Self::poll);
+  }
+
+  std::shared_ptr<Log> log;
+  Log::Reader reader;
+
+  // The leading Master.
+  Option<MasterInfo> leader;
+  set<Promise<Option<MasterInfo>>*> promises;
+
+  // The last observed tail position and when it last advanced.
+  Option<Log::Position> lastEnding;
+  Option<Time> lastAdvance;
+};
+
+
+Try<LogMasterDetector*> LogMasterDetector::create(
+    const Parameters& parameters)
+{
+  Option<size_t> quorum;
+  Option<string> path;
+  set<UPID> pids;
+
+  foreach (const Parameter& parameter, parameters.parameter()) {
+    if (parameter.key() == "quorum") {
+      Try<size_t> numified = numify<size_t>(parameter.value());
+      if (numified.isError() || numified.get() == 0) {
+        return Error(
+            "Failed to parse 'quorum=" + parameter.value() +
+            "' as a positive integer");
+      }
+      quorum = numified.get();
+    } else if (parameter.key() == "log_path") {
+      path = parameter.value();
+    } else if (parameter.key() == "replicas") {
+      foreach (const string& replica,
+               strings::tokenize(parameter.value(), ";")) {
+        UPID pid(replica);
+        if (!pid) {
+          return Error("Failed to parse replica pid '" + replica + "'");
+        }
+        pids.insert(pid);
+      }
+    }
+  }
+
+  if (quorum.isNone()) {
+    return Error("Missing required parameter 'quorum'");
+  }
+
+  if (path.isNone()) {
+    return Error("Missing required parameter 'log_path'");
+  }
+
+  return new LogMasterDetector(quorum.get(), path.get(), pids);
+}
+
+
+LogMasterDetector::LogMasterDetector(
+    size_t quorum,
+    const string& path,
+    const set<UPID>& pids)
+{
+  process = new LogMasterDetectorProcess(quorum, path, pids);
+  spawn(process);
+}
+
+
+LogMasterDetector::~LogMasterDetector()
+{
+  terminate(process);
+  process::wait(process);
+  delete process;
+}
+
+
+Future<Option<MasterInfo>> LogMasterDetector::detect(
+    const Option<MasterInfo>& previous)
+{
+  return dispatch(process, &LogMasterDetectorProcess::detect, previous);
+}
+
+} // namespace detector {
+} // namespace master {
+} // namespace mesos {
@@ -0,0 +1,93 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __MASTER_DETECTOR_LOG_HPP__
+#define __MASTER_DETECTOR_LOG_HPP__
+
+#include <set>
+#include <string>
+
+#include <mesos/mesos.hpp>
+
+#include <mesos/master/detector.hpp>
+
+#include <process/future.hpp>
+#include <process/pid.hpp>
+
+#include <stout/duration.hpp>
+#include <stout/option.hpp>
+#include <stout/try.hpp>
+
+namespace mesos {
+namespace master {
+namespace detector {
+
+// How often the detector polls the local replica for lease renewals
+// appended by the leading contender.
+extern const Duration MASTER_DETECTOR_LOG_POLL_INTERVAL;
+
+
+class LogMasterDetectorProcess;
+
+
+// A detector that determines the leading master from the replicated
+// log, the counterpart of LogMasterContender: the leader renews its
+// lease by appending its MasterInfo to the log, so the latest entry
+// identifies the leader and a tail that has been static for a full
+// lease duration means there is none. Since liveness is judged by
+// locally observed tail movement, no clock synchronization between
+// masters is required.
+//
+// NOTE: Like the contender, this is intended for masters, which
+// already host replicas of the log; it must not be run on nodes
+// outside the replica ensemble (e.g. agents). It is consumable
+// through the '--master_detector_module' machinery in
+// MasterDetector::create().
+class LogMasterDetector : public MasterDetector
+{
+public:
+  // Creates a detector from module parameters: 'quorum' (required,
+  // a positive integer), 'log_path' (required) and 'replicas'
+  // (optional, a semicolon separated list of peer replica pids).
+  // This is the entry point used by the
+  // 'org_apache_mesos_LogMasterDetector' module.
+  static Try<LogMasterDetector*> create(const Parameters& parameters);
+
+  // Creates a detector reading from the replicated log at `path`
+  // with the given quorum size, coordinating with the peer replicas
+  // via `pids` (a static ensemble, i.e. no ZooKeeper). The log
+  // instance is shared with other contenders and detectors on the
+  // same path; see `contender::sharedLog()`.
+  LogMasterDetector(
+      size_t quorum,
+      const std::string& path,
+      const std::set<process::UPID>& pids);
+
+  ~LogMasterDetector() override;
+
+  // MasterDetector implementation.
+  process::Future<Option<MasterInfo>> detect(
+      const Option<MasterInfo>& previous = None()) override;
+
+private:
+  LogMasterDetectorProcess* process;
+};
+
+} // namespace detector {
+} // namespace master {
+} // namespace mesos {
+
+#endif // __MASTER_DETECTOR_LOG_HPP__
@@ -16,6 +16,7 @@
 
 #include "master/detector/zookeeper.hpp"
 
+#include <algorithm>
 #include <set>
 #include <string>
 
@@ -25,7 +26,9 @@
 #include <mesos/zookeeper/group.hpp>
 #include <mesos/zookeeper/url.hpp>
 
+#include <process/clock.hpp>
 #include <process/defer.hpp>
+#include <process/delay.hpp>
 #include <process/dispatch.hpp>
 #include <process/future.hpp>
 #include <process/id.hpp>
@@ -34,6 +37,7 @@
 
 #include <stout/duration.hpp>
 #include <stout/lambda.hpp>
+#include <stout/os.hpp>
 #include <stout/protobuf.hpp>
 
 #include "common/protobuf_utils.hpp"
@@ -52,6 +56,17 @@ namespace detector {
 
 const Duration MASTER_DETECTOR_ZK_SESSION_TIMEOUT = Seconds(10);
 
+// During a ZooKeeper session flap every client sees the same burst of
+// group events, and tens of thousands of detectors fetching the
+// leader znode (and subsequently re-registering with the new master)
+// at the same instant can stampede both the ensemble and the master.
+// When leadership changes arrive within a session timeout of one
+// another we therefore delay the fetch by a random fraction of a
+// backoff that doubles per consecutive change, bounded below and
+// above by these constants.
+const Duration MASTER_DETECTOR_MIN_FETCH_BACKOFF = Milliseconds(500);
+const Duration MASTER_DETECTOR_MAX_FETCH_BACKOFF = Seconds(10);
+
 class ZooKeeperMasterDetectorProcess
   : public Process<ZooKeeperMasterDetectorProcess>
 {
@@ -72,6 +87,11 @@ private:
   // Invoked when the group leadership has changed.
   void detected(const Future<Option<Group::Membership>>& leader);
 
+  // Invoked (possibly after a backoff) to fetch the data associated
+  // with the leader. A no-op if another group event has superseded
+  // this fetch in the meantime.
+  void fetch(const Group::Membership& membership, uint64_t sequence);
+
   // Invoked when we have fetched the data associated with the leader.
   void fetched(
       const Group::Membership& membership,
@@ -84,6 +104,20 @@ private:
   Option<MasterInfo> leader;
   set<Promise<Option<MasterInfo>>*> promises;
 
+  // The membership whose data is cached in `leader`. A leader znode
+  // is created once and never rewritten, so as long as the leading
+  // membership id is unchanged there is no need to re-fetch.
+  Option<int32_t> fetchedMembership;
+
+  // Incremented on every group event; lets a pending (backed off)
+  // fetch detect that it has been superseded.
+  uint64_t sequence;
+
+  // State for debouncing leader fetches, see the comment above
+  // `MASTER_DETECTOR_MIN_FETCH_BACKOFF`.
+  Duration fetchBackoff;
+  Option<Time> lastLeaderChange;
+
   // Potential non-retryable error.
   Option<Error> error;
 };
@@ -104,7 +138,9 @@ ZooKeeperMasterDetectorProcess::ZooKeeperMasterDetectorProcess(
   : ProcessBase(ID::generate("zookeeper-master-detector")),
     group(_group),
     detector(group.get()),
-    leader(None()) {}
+    leader(None()),
+    sequence(0),
+    fetchBackoff(Duration::zero()) {}
 
 
 ZooKeeperMasterDetectorProcess::~ZooKeeperMasterDetectorProcess()
@@ -170,14 +206,48 @@ void ZooKeeperMasterDetectorProcess::detected(
     return;
   }
 
+  ++sequence;
+
   if (_leader->isNone()) {
     leader = None();
+    fetchedMembership = None();
 
     setPromises(&promises, leader);
+  } else if (fetchedMembership.isSome() &&
+             fetchedMembership.get() == _leader->get().id()) {
+    // The same znode is still leading and its data is immutable, so
+    // the cached `leader` remains valid: don't re-fetch, and don't
+    // wake waiters for whom nothing has changed.
+    VLOG(1) << "Ignoring group event for unchanged leading membership "
+            << _leader->get().id();
   } else {
-    // Fetch the data associated with the leader.
-    group->data(_leader->get())
-      .onAny(defer(self(), &Self::fetched, _leader->get(), lambda::_1));
+    // Debounce the fetch: back off if this change arrived hot on the
+    // heels of the previous one (i.e. the session is flapping).
+    const Time now = Clock::now();
+
+    if (lastLeaderChange.isSome() &&
+        (now - lastLeaderChange.get()) < MASTER_DETECTOR_ZK_SESSION_TIMEOUT) {
+      fetchBackoff = std::min(
+          std::max(fetchBackoff * 2, MASTER_DETECTOR_MIN_FETCH_BACKOFF),
+          MASTER_DETECTOR_MAX_FETCH_BACKOFF);
+    } else {
+      fetchBackoff = Duration::zero();
+    }
+
+    lastLeaderChange = now;
+
+    if (fetchBackoff > Duration::zero()) {
+      // Spread the fetches of all detectors over the backoff window.
+      const Duration jitter =
+        fetchBackoff * (static_cast<double>(os::random()) / RAND_MAX);
+
+      VLOG(1) << "Delaying fetch of leading membership "
+              << _leader->get().id() << " by " << jitter;
+
+      delay(jitter, self(), &Self::fetch, _leader->get(), sequence);
+    } else {
+      fetch(_leader->get(), sequence);
+    }
   }
 
   // Keep trying to detect leadership changes.
@@ -186,6 +256,21 @@ void ZooKeeperMasterDetectorProcess::detected(
 }
 
 
+void ZooKeeperMasterDetectorProcess::fetch(
+    const Group::Membership& membership, uint64_t sequence)
+{
+  if (sequence != this->sequence) {
+    // Another group event superseded this fetch while it was waiting
+    // out the backoff.
+    return;
+  }
+
+  // Fetch the data associated with the leader.
+  group->data(membership)
+    .onAny(defer(self(), &Self::fetched, membership, lambda::_1));
+}
+
+
 void ZooKeeperMasterDetectorProcess::fetched(
     const Group::Membership& membership,
     const Future<Option<string>>& data)
@@ -194,11 +279,13 @@ void ZooKeeperMasterDetectorProcess::fetched(
 
   if (data.isFailed()) {
     leader = None();
+    fetchedMembership = None();
     failPromises(&promises, data.failure());
     return;
   } else if (data->isNone()) {
     // Membership is gone before we can read its data.
     leader = None();
+    fetchedMembership = None();
     setPromises(&promises, leader);
     return;
   }
@@ -217,6 +304,7 @@ void ZooKeeperMasterDetectorProcess::fetched(
     MasterInfo info;
     if (!info.ParseFromString(data->get())) {
       leader = None();
+    fetchedMembership = None();
       failPromises(&promises,
           "Failed to parse data into MasterInfo");
       return;
@@ -232,6 +320,7 @@ void ZooKeeperMasterDetectorProcess::fetched(
 
     if (object.isError()) {
       leader = None();
+    fetchedMembership = None();
       failPromises(
           &promises,
           "Failed to parse data into valid JSON: " + object.error());
@@ -243,6 +332,7 @@ void ZooKeeperMasterDetectorProcess::fetched(
 
     if (info.isError()) {
       leader = None();
+    fetchedMembership = None();
       failPromises(
           &promises,
           "Failed to parse JSON into a valid MasterInfo protocol buffer: " +
@@ -253,12 +343,15 @@ void ZooKeeperMasterDetectorProcess::fetched(
     leader = info.get();
   } else {
     leader = None();
+    fetchedMembership = None();
     failPromises(
         &promises,
         "Failed to parse data of unknown label '" + label.get() + "'");
     return;
   }
 
+  fetchedMembership = membership.id();
+
   LOG(INFO) << "A new leading master (UPID="
             << UPID(leader->pid()) << ") is detected";
 
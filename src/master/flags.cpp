@@ -593,6 +593,17 @@ mesos::internal::master::Flags::Flags()
       "Maximum number of unreachable tasks per framework to store in memory.",
       DEFAULT_MAX_UNREACHABLE_TASKS_PER_FRAMEWORK);
 
+  add(&Flags::completed_archive_dir,
+      "completed_archive_dir",
+      "Directory in which completed tasks and frameworks evicted from the\n"
+      "in-memory caches (see `--max_completed_frameworks` and\n"
+      "`--max_completed_tasks_per_framework`) are appended to an on-disk\n"
+      "archive. Archived frameworks are served lazily by the `/frameworks`\n"
+      "endpoint when queried by framework ID. This allows the in-memory\n"
+      "caches to be sized down without losing history. If unset (default),\n"
+      "evicted entities are discarded. Note that the archive is not\n"
+      "garbage collected by the master.");
+
   add(&Flags::master_contender,
       "master_contender",
       "The symbol name of the master contender to use.\n"
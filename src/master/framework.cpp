@@ -96,11 +96,7 @@ Framework::~Framework()
 
 Task* Framework::getTask(const TaskID& taskId)
 {
-  if (tasks.count(taskId) > 0) {
-    return tasks[taskId];
-  }
-
-  return nullptr;
+  return tasks.get(taskId).getOrElse(nullptr);
 }
 
 
@@ -116,7 +112,7 @@ void Framework::addTask(Task* task)
     CHECK(resource.has_allocation_info());
   }
 
-  tasks[task->task_id()] = task;
+  tasks.put(task->task_id(), task);
 
   // Unreachable tasks should be added via `addUnreachableTask`.
   CHECK(task->state() != TASK_UNREACHABLE)
@@ -156,6 +152,10 @@ void Framework::addTask(Task* task)
 
   metrics.incrementTaskState(task->state());
 
+  // Bump outside the subscriber guard below: the cached '/state'
+  // responses must be invalidated even without event subscribers.
+  ++master->stateVersions.tasks;
+
   if (!master->subscribers.subscribed.empty()) {
     master->subscribers.send(
         protobuf::master::event::createTaskAdded(*task),
@@ -202,6 +202,20 @@ void Framework::addCompletedTask(Task&& task)
   // means that there might be multiple completed tasks with the
   // same task ID. We should consider rejecting attempts to reuse
   // task IDs (MESOS-6779).
+
+  // If the in-memory buffer is full, the oldest completed task (or,
+  // if the buffer has zero capacity, the new task itself) is about to
+  // be dropped from memory; spill it to the on-disk archive instead
+  // (if enabled).
+  if (completedTasks.full()) {
+    Archive::Framework record;
+    record.mutable_framework_info()->CopyFrom(info);
+    record.add_tasks()->CopyFrom(
+        completedTasks.empty() ? task : *completedTasks.front());
+
+    master->archiveCompleted(record);
+  }
+
   completedTasks.push_back(process::Owned<Task>(new Task(std::move(task))));
 }
 
@@ -15,6 +15,7 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <deque>
 #include <iomanip>
 #include <map>
 #include <memory>
@@ -59,6 +60,7 @@
 #include <stout/numify.hpp>
 #include <stout/option.hpp>
 #include <stout/os.hpp>
+#include <stout/path.hpp>
 #include <stout/protobuf.hpp>
 #include <stout/representation.hpp>
 #include <stout/result.hpp>
@@ -1114,6 +1116,15 @@ Future<Response> Master::Http::scheduler(
 
     case scheduler::Call::ACKNOWLEDGE:
       master->acknowledge(framework, std::move(*call.mutable_acknowledge()));
+      master->flushStatusUpdateAcknowledgements();
+      return Accepted();
+
+    case scheduler::Call::ACKNOWLEDGE_BATCH:
+      foreach (scheduler::Call::Acknowledge& acknowledge_,
+               *call.mutable_acknowledge_batch()->mutable_acknowledgements()) {
+        master->acknowledge(framework, std::move(acknowledge_));
+      }
+      master->flushStatusUpdateAcknowledgements();
       return Accepted();
 
     case scheduler::Call::ACKNOWLEDGE_OPERATION_STATUS:
@@ -1658,9 +1669,51 @@ string Master::Http::FRAMEWORKS_HELP()
 }
 
 
+// Reads the records of the given framework from the on-disk archive
+// of completed tasks and frameworks. Malformed records and records of
+// other frameworks are skipped. See the `--completed_archive_dir` flag.
+static vector<Archive::Framework> readArchivedFrameworks(
+    const string& path,
+    const string& frameworkId)
+{
+  Try<string> data = os::read(path);
+  if (data.isError()) {
+    LOG(WARNING) << "Failed to read the completed archive '" << path
+                 << "': " << data.error();
+    return {};
+  }
+
+  ::recordio::Decoder<Archive::Framework> decoder(
+      [](const char* data, size_t size) -> Try<Archive::Framework> {
+        Archive::Framework record;
+        if (!record.ParseFromArray(data, static_cast<int>(size))) {
+          return Error("Failed to parse Archive::Framework record");
+        }
+        return record;
+      });
+
+  Try<std::deque<Try<Archive::Framework>>> records = decoder.decode(data.get());
+  if (records.isError()) {
+    LOG(WARNING) << "Failed to decode the completed archive '" << path
+                 << "': " << records.error();
+    return {};
+  }
+
+  vector<Archive::Framework> result;
+  foreach (const Try<Archive::Framework>& record, records.get()) {
+    if (record.isSome() &&
+        record->framework_info().id().value() == frameworkId) {
+      result.push_back(record.get());
+    }
+  }
+
+  return result;
+}
+
+
 Future<Response> Master::Http::frameworks(
     const Request& request,
-    const Option<Principal>& principal) const
+    const Option<Principal>& principal)
 {
   // TODO(greggomann): Remove this check once the `Principal` type is used in
   // `ReservationInfo`, `DiskInfo`, and within the master's `principals` map.
@@ -1676,63 +1729,142 @@ Future<Response> Master::Http::frameworks(
     return redirect(request);
   }
 
+  Option<string> frameworkId = request.url.query.get("framework_id");
+
+  // When a specific framework is requested with the completed archive
+  // enabled, matching records are lazily read from the on-disk archive
+  // and the request bypasses the read-only request batch. The archive
+  // is append-only, so it is safe to scan it from a worker thread
+  // while the master keeps appending to it; at worst a scan misses the
+  // most recent records.
+  if (frameworkId.isSome() &&
+      master->flags.completed_archive_dir.isSome()) {
+    Future<vector<Archive::Framework>> archived = process::async(
+        &readArchivedFrameworks,
+        path::join(
+            master->flags.completed_archive_dir.get(), "completed.recordio"),
+        frameworkId.get());
+
+    return process::collect(
+        ObjectApprovers::create(
+            master->authorizer,
+            principal,
+            {VIEW_FRAMEWORK, VIEW_TASK, VIEW_EXECUTOR}),
+        archived)
+      .then(defer(
+          master->self(),
+          [this, request](
+              const tuple<Owned<ObjectApprovers>,
+                          vector<Archive::Framework>>& result) -> Response {
+            return processFrameworksRequest(
+                request, std::get<0>(result), std::get<1>(result));
+          }));
+  }
+
   return ObjectApprovers::create(
       master->authorizer,
       principal,
       {VIEW_FRAMEWORK, VIEW_TASK, VIEW_EXECUTOR})
     .then(defer(
         master->self(),
-        [this, request](const Owned<ObjectApprovers>& approvers) -> Response {
-          IDAcceptor<FrameworkID> selectFrameworkId(
-              request.url.query.get("framework_id"));
-          // This lambda is consumed before the outer lambda
-          // returns, hence capture by reference is fine here.
-          auto frameworks = [this, &approvers, &selectFrameworkId](
-              JSON::ObjectWriter* writer) {
-            // Model all of the frameworks.
-            writer->field(
-                "frameworks",
-                [this, &approvers, &selectFrameworkId](
-                    JSON::ArrayWriter* writer) {
-                  foreachvalue (
-                      Framework* framework, master->frameworks.registered) {
-                    // Skip unauthorized frameworks or frameworks
-                    // without a matching ID.
-                    if (!selectFrameworkId.accept(framework->id()) ||
-                        !approvers->approved<VIEW_FRAMEWORK>(framework->info)) {
-                      continue;
-                    }
+        [this, request, principal](const Owned<ObjectApprovers>& approvers) {
+          return deferBatchedRequest(
+              ReadOnlyRequestHandler::FRAMEWORKS,
+              request,
+              principal,
+              approvers);
+        }));
+}
 
-                    writer->element(FullFrameworkWriter(approvers, framework));
-                  }
-                });
 
-            // Model all of the completed frameworks.
-            writer->field(
-                "completed_frameworks",
-                [this, &approvers, &selectFrameworkId](
-                    JSON::ArrayWriter* writer) {
-                  foreachvalue (const Owned<Framework>& framework,
-                                master->frameworks.completed) {
-                    // Skip unauthorized frameworks or frameworks
-                    // without a matching ID.
-                    if (!selectFrameworkId.accept(framework->id()) ||
-                        !approvers->approved<VIEW_FRAMEWORK>(framework->info)) {
-                      continue;
-                    }
+Response Master::Http::processFrameworksRequest(
+    const Request& request,
+    const Owned<ObjectApprovers>& approvers,
+    const vector<Archive::Framework>& archived) const
+{
+  IDAcceptor<FrameworkID> selectFrameworkId(
+      request.url.query.get("framework_id"));
+
+  // This lambda is consumed before this function returns,
+  // hence capture by reference is fine here.
+  auto frameworks = [this, &approvers, &selectFrameworkId, &archived](
+      JSON::ObjectWriter* writer) {
+    // Model all of the frameworks.
+    writer->field(
+        "frameworks",
+        [this, &approvers, &selectFrameworkId](
+            JSON::ArrayWriter* writer) {
+          foreachvalue (
+              Framework* framework, master->frameworks.registered) {
+            // Skip unauthorized frameworks or frameworks
+            // without a matching ID.
+            if (!selectFrameworkId.accept(framework->id()) ||
+                !approvers->approved<VIEW_FRAMEWORK>(framework->info)) {
+              continue;
+            }
 
-                    writer->element(
-                        FullFrameworkWriter(approvers, framework.get()));
-                  }
-                });
+            writer->element(FullFrameworkWriter(approvers, framework));
+          }
+        });
 
-            // Unregistered frameworks are no longer possible. We emit an
-            // empty array for the sake of backward compatibility.
-            writer->field("unregistered_frameworks", [](JSON::ArrayWriter*) {});
-          };
+    // Model all of the completed frameworks.
+    writer->field(
+        "completed_frameworks",
+        [this, &approvers, &selectFrameworkId, &archived](
+            JSON::ArrayWriter* writer) {
+          foreachvalue (const Owned<Framework>& framework,
+                        master->frameworks.completed) {
+            // Skip unauthorized frameworks or frameworks
+            // without a matching ID.
+            if (!selectFrameworkId.accept(framework->id()) ||
+                !approvers->approved<VIEW_FRAMEWORK>(framework->info)) {
+              continue;
+            }
 
-          return OK(jsonify(frameworks), request.url.query.get("jsonp"));
-        }));
+            writer->element(
+                FullFrameworkWriter(approvers, framework.get()));
+          }
+
+          // Model the frameworks read from the on-disk archive.
+          // Frameworks that are still held in memory have been
+          // modeled above and are skipped here; their archived
+          // records only exist to survive eviction.
+          foreach (const Archive::Framework& record, archived) {
+            const FrameworkID& frameworkId =
+              record.framework_info().id();
+
+            if (master->frameworks.registered.contains(frameworkId) ||
+                master->frameworks.completed.contains(frameworkId) ||
+                !approvers->approved<VIEW_FRAMEWORK>(
+                    record.framework_info())) {
+              continue;
+            }
+
+            writer->element([&](JSON::ObjectWriter* writer) {
+              writer->field("id", frameworkId.value());
+              writer->field("name", record.framework_info().name());
+              writer->field("user", record.framework_info().user());
+
+              writer->field(
+                  "tasks",
+                  [&](JSON::ArrayWriter* writer) {
+                    foreach (const Task& task, record.tasks()) {
+                      if (approvers->approved<VIEW_TASK>(
+                              task, record.framework_info())) {
+                        writer->element(model(task));
+                      }
+                    }
+                  });
+            });
+          }
+        });
+
+    // Unregistered frameworks are no longer possible. We emit an
+    // empty array for the sake of backward compatibility.
+    writer->field("unregistered_frameworks", [](JSON::ArrayWriter*) {});
+  };
+
+  return OK(jsonify(frameworks), request.url.query.get("jsonp"));
 }
 
 
@@ -1927,6 +2059,16 @@ Future<Response> Master::Http::getState(
     .then(defer(
         master->self(),
         [=](const Owned<ObjectApprovers>& approvers) -> Response {
+          // Without an authorizer every client is shown the same
+          // state, so we can serve a cached serialization (refreshed
+          // per section as the state changes) instead of rebuilding
+          // and re-serializing the entire state for every request.
+          if (master->authorizer.isNone()) {
+            return OK(
+                serializeGetState(approvers, contentType),
+                stringify(contentType));
+          }
+
           mesos::master::Response response;
           response.set_type(mesos::master::Response::GET_STATE);
 
@@ -1938,6 +2080,96 @@ Future<Response> Master::Http::getState(
 }
 
 
+string Master::Http::serializeGetState(
+    const Owned<ObjectApprovers>& approvers,
+    ContentType contentType) const
+{
+  const uint64_t tasksVersion = master->stateVersions.tasks;
+  const uint64_t frameworksVersion = master->stateVersions.frameworks;
+  const uint64_t agentsVersion = master->stateVersions.agents;
+
+  if (contentType == ContentType::PROTOBUF) {
+    // Refresh whichever per-section fragments have gone stale. Each
+    // fragment is the serialization of a `Response` containing only
+    // that section of `get_state`.
+    //
+    // NOTE: executors come and go with the tasks that (implicitly)
+    // launch them, plus `Master::removeExecutor()`, so the executors
+    // fragment shares the tasks version.
+    if (stateCache.tasks.version != tasksVersion) {
+      mesos::master::Response fragment;
+      *fragment.mutable_get_state()->mutable_get_tasks() =
+        _getTasks(approvers);
+
+      stateCache.tasks.serialized = fragment.SerializeAsString();
+      stateCache.tasks.version = tasksVersion;
+    }
+
+    if (stateCache.executors.version != tasksVersion) {
+      mesos::master::Response fragment;
+      *fragment.mutable_get_state()->mutable_get_executors() =
+        _getExecutors(approvers);
+
+      stateCache.executors.serialized = fragment.SerializeAsString();
+      stateCache.executors.version = tasksVersion;
+    }
+
+    if (stateCache.frameworks.version != frameworksVersion) {
+      mesos::master::Response fragment;
+      *fragment.mutable_get_state()->mutable_get_frameworks() =
+        _getFrameworks(approvers);
+
+      stateCache.frameworks.serialized = fragment.SerializeAsString();
+      stateCache.frameworks.version = frameworksVersion;
+    }
+
+    if (stateCache.agents.version != agentsVersion) {
+      mesos::master::Response fragment;
+      *fragment.mutable_get_state()->mutable_get_agents() =
+        _getAgents(approvers);
+
+      stateCache.agents.serialized = fragment.SerializeAsString();
+      stateCache.agents.version = agentsVersion;
+    }
+
+    mesos::master::Response response;
+    response.set_type(mesos::master::Response::GET_STATE);
+
+    // Parsers merge repeated occurrences of the embedded `get_state`
+    // field, so concatenating the fragments produces a valid
+    // serialization of the full response.
+    //
+    // NOTE: `evolve()` is a serialize/parse round trip between wire
+    // compatible messages, so serializing the unevolved response
+    // yields the same bytes the v1 response would.
+    return response.SerializeAsString() +
+           stateCache.tasks.serialized +
+           stateCache.executors.serialized +
+           stateCache.frameworks.serialized +
+           stateCache.agents.serialized;
+  }
+
+  // JSON bodies cannot be stitched together from fragments, so the
+  // entire body is cached and rebuilt whenever any section changes.
+  if (stateCache.json.isNone() ||
+      stateCache.jsonTasks != tasksVersion ||
+      stateCache.jsonFrameworks != frameworksVersion ||
+      stateCache.jsonAgents != agentsVersion) {
+    mesos::master::Response response;
+    response.set_type(mesos::master::Response::GET_STATE);
+
+    *response.mutable_get_state() = _getState(approvers);
+
+    stateCache.json = serialize(contentType, evolve(response));
+    stateCache.jsonTasks = tasksVersion;
+    stateCache.jsonFrameworks = frameworksVersion;
+    stateCache.jsonAgents = agentsVersion;
+  }
+
+  return stateCache.json.get();
+}
+
+
 mesos::master::Response::GetState Master::Http::_getState(
     const Owned<ObjectApprovers>& approvers) const
 {
@@ -2120,6 +2352,27 @@ Future<Response> Master::Http::health(const Request& request) const
 }
 
 
+string Master::Http::MESSAGES_HELP()
+{
+  return HELP(
+    TLDR(
+        "Statistics on the protobuf messages received by the master."),
+    DESCRIPTION(
+        "Returns the sampled per-message-type count, wire bytes and",
+        "parse time of the protobuf messages received by the master,",
+        "ranked by wire bytes, i.e. the biggest bandwidth consumers",
+        "first. Only every 'sample_interval'-th message is measured;",
+        "scale the reported figures accordingly to estimate totals."),
+    AUTHENTICATION(false));
+}
+
+
+Future<Response> Master::Http::messages(const Request& request) const
+{
+  return OK(modelMessageCensus(), request.url.query.get("jsonp"));
+}
+
+
 Future<Response> Master::Http::getHealth(
     const mesos::master::Call& call,
     const Option<Principal>& principal,
@@ -2519,30 +2772,35 @@ string Master::Http::SLAVES_HELP()
 
 Future<Response> Master::Http::slaves(
     const Request& request,
-    const Option<Principal>& principal) const
+    const Option<Principal>& principal)
 {
   // When current master is not the leader, redirect to the leading master.
   if (!master->elected()) {
     return redirect(request);
   }
 
-  Option<string> slaveId = request.url.query.get("slave_id");
-  Option<string> jsonp = request.url.query.get("jsonp");
-
   return ObjectApprovers::create(master->authorizer, principal, {VIEW_ROLE})
     .then(defer(
         master->self(),
-        [this, slaveId, jsonp](const Owned<ObjectApprovers>& approvers)
-            -> Response {
-          IDAcceptor<SlaveID> selectSlaveId(slaveId);
-
-          return OK(
-              jsonify(SlavesWriter(master->slaves, approvers, selectSlaveId)),
-              jsonp);
+        [this, request, principal](const Owned<ObjectApprovers>& approvers) {
+          return deferBatchedRequest(
+              ReadOnlyRequestHandler::SLAVES, request, principal, approvers);
         }));
 }
 
 
+Response Master::Http::processSlavesRequest(
+    const Request& request,
+    const Owned<ObjectApprovers>& approvers) const
+{
+  IDAcceptor<SlaveID> selectSlaveId(request.url.query.get("slave_id"));
+
+  return OK(
+      jsonify(SlavesWriter(master->slaves, approvers, selectSlaveId)),
+      request.url.query.get("jsonp"));
+}
+
+
 Future<Response> Master::Http::getAgents(
     const mesos::master::Call& call,
     const Option<Principal>& principal,
@@ -2736,6 +2994,14 @@ string Master::Http::STATE_HELP()
         "The information shown might be filtered based on the user",
         "accessing the endpoint.",
         "",
+        "Query parameters:",
+        ">        since=VALUE          The `state_version` of a previous",
+        ">                             response. Sections that have not",
+        ">                             changed since that version are",
+        ">                             omitted from the response and the",
+        ">                             client keeps the copies it already",
+        ">                             holds (JSON merge patch semantics).",
+        "",
         "Example (**Note**: this is not exhaustive):",
         "",
         "```",
@@ -2832,38 +3098,38 @@ Future<Response> Master::Http::state(
     return redirect(request);
   }
 
-  // TODO(alexr): De-duplicate response processing when the principal is
-  // identical, e.g., if "bob" asks for state three times in one batch,
-  // ideally we only compute the response for "bob" once since they're all
-  // identical within a principal.
   return ObjectApprovers::create(
       master->authorizer,
       principal,
       {VIEW_ROLE, VIEW_FRAMEWORK, VIEW_TASK, VIEW_EXECUTOR, VIEW_FLAGS})
     .then(defer(
         master->self(),
-        [this, request](const Owned<ObjectApprovers>& approvers) {
-          return deferStateRequest(request, approvers);
+        [this, request, principal](const Owned<ObjectApprovers>& approvers) {
+          return deferBatchedRequest(
+              ReadOnlyRequestHandler::STATE, request, principal, approvers);
         }));
 }
 
 
-Future<Response> Master::Http::deferStateRequest(
+Future<Response> Master::Http::deferBatchedRequest(
+    ReadOnlyRequestHandler handler,
     const Request& request,
+    const Option<Principal>& principal,
     const Owned<ObjectApprovers>& approvers)
 {
-  bool scheduleBatch = batchedStateRequests.empty();
+  bool scheduleBatch = batchedRequests.empty();
 
-  // Add an element to the batched state requests.
+  // Add an element to the batched requests.
   Promise<Response> promise;
   Future<Response> future = promise.future();
-  batchedStateRequests.push_back(
-      BatchedStateRequest{request, approvers, std::move(promise)});
+  batchedRequests.push_back(
+      BatchedRequest{handler, request, principal, approvers,
+                     std::move(promise)});
 
   // Schedule processing of batched requests if not yet scheduled.
   if (scheduleBatch) {
     dispatch(master->self(), [this]() {
-      processStateRequestsBatch();
+      processRequestsBatch();
     });
   }
 
@@ -2871,89 +3137,137 @@ Future<Response> Master::Http::deferStateRequest(
 }
 
 
-void Master::Http::processStateRequestsBatch()
+Response Master::Http::processStateRequest(
+    const Request& request,
+    const Owned<ObjectApprovers>& approvers) const
 {
-  CHECK(!batchedStateRequests.empty())
-    << "Bug in state batching logic: No requests to process";
+  const string stateVersion =
+    stringify(master->stateVersions.tasks) + "-" +
+    stringify(master->stateVersions.frameworks) + "-" +
+    stringify(master->stateVersions.agents);
+
+  // A client that presents the `state_version` of its previous
+  // response via the 'since' parameter receives a delta: sections
+  // whose entities have not changed since that version are omitted
+  // and the client keeps the copies it already holds (JSON merge
+  // patch semantics). This makes steady-state polling, e.g., by the
+  // webui, cheap on an otherwise idle cluster.
+  bool writeFrameworks = true;
+  bool writeAgents = true;
+
+  Option<string> since = request.url.query.get("since");
+  if (since.isSome()) {
+    vector<string> versions = strings::split(since.get(), "-");
+
+    Option<Error> error = None();
+    if (versions.size() != 3) {
+      error = Error("Expected 3 '-' separated components");
+    } else {
+      foreach (const string& version, versions) {
+        Try<uint64_t> numified = numify<uint64_t>(version);
+        if (numified.isError()) {
+          error = Error(numified.error());
+          break;
+        }
+      }
+    }
 
-  // This lambda is consumed before the enclosed function returns,
-  // hence capturing `this` is fine here.
-  auto produceResponse = [this](
-      const Request& request,
-      const Owned<ObjectApprovers>& approvers) -> Response {
-    // This lambda is consumed before the outer lambda returns,
-    // hence capturing a reference is fine here.
-    auto calculateState = [this, &approvers](JSON::ObjectWriter* writer) {
-      writer->field("version", MESOS_VERSION);
+    if (error.isSome()) {
+      return BadRequest(
+          "Failed to parse 'since=" + since.get() + "' as a state"
+          " version of the form '<tasks>-<frameworks>-<agents>': " +
+          error->message);
+    }
 
-      if (build::GIT_SHA.isSome()) {
-        writer->field("git_sha", build::GIT_SHA.get());
-      }
+    // Tasks and executors are nested within the framework sections,
+    // so a task change invalidates those sections as well.
+    writeFrameworks =
+      versions[0] != stringify(master->stateVersions.tasks) ||
+      versions[1] != stringify(master->stateVersions.frameworks);
 
-      if (build::GIT_BRANCH.isSome()) {
-        writer->field("git_branch", build::GIT_BRANCH.get());
-      }
+    writeAgents = versions[2] != stringify(master->stateVersions.agents);
+  }
 
-      if (build::GIT_TAG.isSome()) {
-        writer->field("git_tag", build::GIT_TAG.get());
-      }
+  // This lambda is consumed before the enclosing function returns,
+  // hence capturing a reference is fine here.
+  auto calculateState = [this, &approvers, &stateVersion, writeFrameworks,
+                         writeAgents](JSON::ObjectWriter* writer) {
+    writer->field("version", MESOS_VERSION);
 
-      writer->field("build_date", build::DATE);
-      writer->field("build_time", build::TIME);
-      writer->field("build_user", build::USER);
-      writer->field("start_time", master->startTime.secs());
+    if (build::GIT_SHA.isSome()) {
+      writer->field("git_sha", build::GIT_SHA.get());
+    }
 
-      if (master->electedTime.isSome()) {
-        writer->field("elected_time", master->electedTime->secs());
-      }
+    if (build::GIT_BRANCH.isSome()) {
+      writer->field("git_branch", build::GIT_BRANCH.get());
+    }
 
-      writer->field("id", master->info().id());
-      writer->field("pid", string(master->self()));
-      writer->field("hostname", master->info().hostname());
-      writer->field("capabilities", master->info().capabilities());
-      writer->field("activated_slaves", master->_slaves_active());
-      writer->field("deactivated_slaves", master->_slaves_inactive());
-      writer->field("unreachable_slaves", master->_slaves_unreachable());
+    if (build::GIT_TAG.isSome()) {
+      writer->field("git_tag", build::GIT_TAG.get());
+    }
 
-      if (master->info().has_domain()) {
-        writer->field("domain", master->info().domain());
-      }
+    writer->field("build_date", build::DATE);
+    writer->field("build_time", build::TIME);
+    writer->field("build_user", build::USER);
+    writer->field("start_time", master->startTime.secs());
 
-      // TODO(haosdent): Deprecated this in favor of `leader_info` below.
-      if (master->leader.isSome()) {
-        writer->field("leader", master->leader->pid());
-      }
+    if (master->electedTime.isSome()) {
+      writer->field("elected_time", master->electedTime->secs());
+    }
 
-      if (master->leader.isSome()) {
-        writer->field("leader_info", [this](JSON::ObjectWriter* writer) {
-          json(writer, master->leader.get());
-        });
-      }
+    writer->field("id", master->info().id());
+    writer->field("pid", string(master->self()));
+    writer->field("hostname", master->info().hostname());
+    writer->field("capabilities", master->info().capabilities());
+    writer->field("activated_slaves", master->_slaves_active());
+    writer->field("deactivated_slaves", master->_slaves_inactive());
+    writer->field("unreachable_slaves", master->_slaves_unreachable());
 
-      if (approvers->approved<VIEW_FLAGS>()) {
-        if (master->flags.cluster.isSome()) {
-          writer->field("cluster", master->flags.cluster.get());
-        }
+    if (master->info().has_domain()) {
+      writer->field("domain", master->info().domain());
+    }
 
-        if (master->flags.log_dir.isSome()) {
-          writer->field("log_dir", master->flags.log_dir.get());
-        }
+    // TODO(haosdent): Deprecated this in favor of `leader_info` below.
+    if (master->leader.isSome()) {
+      writer->field("leader", master->leader->pid());
+    }
 
-        if (master->flags.external_log_file.isSome()) {
-          writer->field("external_log_file",
-                        master->flags.external_log_file.get());
-        }
+    if (master->leader.isSome()) {
+      writer->field("leader_info", [this](JSON::ObjectWriter* writer) {
+        json(writer, master->leader.get());
+      });
+    }
 
-        writer->field("flags", [this](JSON::ObjectWriter* writer) {
-            foreachvalue (const flags::Flag& flag, master->flags) {
-              Option<string> value = flag.stringify(master->flags);
-              if (value.isSome()) {
-                writer->field(flag.effective_name().value, value.get());
-              }
-            }
-          });
+    if (approvers->approved<VIEW_FLAGS>()) {
+      if (master->flags.cluster.isSome()) {
+        writer->field("cluster", master->flags.cluster.get());
+      }
+
+      if (master->flags.log_dir.isSome()) {
+        writer->field("log_dir", master->flags.log_dir.get());
+      }
+
+      if (master->flags.external_log_file.isSome()) {
+        writer->field("external_log_file",
+                      master->flags.external_log_file.get());
       }
 
+      writer->field("flags", [this](JSON::ObjectWriter* writer) {
+          foreachvalue (const flags::Flag& flag, master->flags) {
+            Option<string> value = flag.stringify(master->flags);
+            if (value.isSome()) {
+              writer->field(flag.effective_name().value, value.get());
+            }
+          }
+        });
+    }
+
+    // Lets clients poll for changes: a client that presents this
+    // version via the 'since' parameter on its next request receives
+    // only the sections that changed in between.
+    writer->field("state_version", stateVersion);
+
+    if (writeAgents) {
       // Model all of the registered slaves.
       writer->field(
           "slaves",
@@ -2974,7 +3288,9 @@ void Master::Http::processStateRequestsBatch()
               });
             }
           });
+    }
 
+    if (writeFrameworks) {
       // Model all of the frameworks.
       writer->field(
           "frameworks",
@@ -3006,44 +3322,132 @@ void Master::Http::processStateRequestsBatch()
                   FullFrameworkWriter(approvers, framework.get()));
             }
           });
+    }
+
+    // Orphan tasks are no longer possible. We emit an empty array
+    // for the sake of backward compatibility.
+    writer->field("orphan_tasks", [](JSON::ArrayWriter*) {});
+
+    // Unregistered frameworks are no longer possible. We emit an
+    // empty array for the sake of backward compatibility.
+    writer->field("unregistered_frameworks", [](JSON::ArrayWriter*) {});
+  };
+
+  // Serialize the response into a pipe in bounded chunks rather than
+  // into a single string: state responses can reach hundreds of MB
+  // on large clusters and materializing them in one allocation (plus
+  // the copy made when encoding a `BODY` response) dominates peak
+  // memory. With a pipe, chunks are freed as the client reads them.
+  //
+  // NOTE: Serialization still completes before the response is
+  // returned (and hence before the master actor is unblocked), since
+  // the writers read the master's state.
+  Pipe pipe;
+  OK ok;
+  ok.type = Response::PIPE;
+  ok.reader = pipe.reader();
 
-      // Orphan tasks are no longer possible. We emit an empty array
-      // for the sake of backward compatibility.
-      writer->field("orphan_tasks", [](JSON::ArrayWriter*) {});
+  Pipe::Writer writer = pipe.writer();
+
+  Option<string> jsonp = request.url.query.get("jsonp");
+  if (jsonp.isSome()) {
+    ok.headers["Content-Type"] = "text/javascript";
+    writer.write(jsonp.get() + "(");
+  } else {
+    ok.headers["Content-Type"] = "application/json";
+  }
+
+  jsonify(calculateState).stream([&writer](string&& chunk) {
+    writer.write(std::move(chunk));
+  });
+
+  if (jsonp.isSome()) {
+    writer.write(")");
+  }
 
-      // Unregistered frameworks are no longer possible. We emit an
-      // empty array for the sake of backward compatibility.
-      writer->field("unregistered_frameworks", [](JSON::ArrayWriter*) {});
-    };
+  writer.close();
 
-    return OK(jsonify(calculateState), request.url.query.get("jsonp"));
+  return ok;
+}
+
+
+void Master::Http::processRequestsBatch()
+{
+  CHECK(!batchedRequests.empty())
+    << "Bug in read-only request batching logic: No requests to process";
+
+  // This lambda is consumed before the enclosing function returns,
+  // hence capturing `this` is fine here.
+  auto produceResponse = [this](
+      ReadOnlyRequestHandler handler,
+      const Request& request,
+      const Owned<ObjectApprovers>& approvers) -> Response {
+    switch (handler) {
+      case ReadOnlyRequestHandler::FRAMEWORKS:
+        return processFrameworksRequest(request, approvers);
+      case ReadOnlyRequestHandler::SLAVES:
+        return processSlavesRequest(request, approvers);
+      case ReadOnlyRequestHandler::STATE:
+        return processStateRequest(request, approvers);
+      case ReadOnlyRequestHandler::STATE_SUMMARY:
+        return processStateSummaryRequest(request, approvers);
+      case ReadOnlyRequestHandler::TASKS:
+        return processTasksRequest(request, approvers);
+    }
+
+    UNREACHABLE();
   };
 
   // Produce the responses in parallel.
   //
+  // If the same principal asks for the same endpoint several times in one
+  // batch, we compute the response only once and share it between the
+  // duplicates: within a batch the response depends solely on the handler,
+  // the principal (via the object approvers) and the query parameters
+  // (e.g., "jsonp", ID filters, pagination), since the master's state
+  // cannot change while the batch is being processed.
+  //
   // TODO(alexr): Consider abstracting this into `parallel_async` or
   // `foreach_parallel`, see MESOS-8587.
   //
-  // TODO(alexr): Consider moving `BatchedStateRequest`'s fields into
+  // TODO(alexr): Consider moving `BatchedRequest`'s fields into
   // `process::async` once it supports moving.
-  foreach (BatchedStateRequest& request, batchedStateRequests) {
-    request.promise.associate(process::async(
-        produceResponse, request.request, request.approvers));
+  for (size_t i = 0; i < batchedRequests.size(); ++i) {
+    BatchedRequest& request = batchedRequests[i];
+
+    Option<Future<Response>> identical;
+    for (size_t j = 0; j < i; ++j) {
+      const BatchedRequest& earlier = batchedRequests[j];
+      if (earlier.handler == request.handler &&
+          earlier.principal == request.principal &&
+          earlier.request.url.query == request.request.url.query) {
+        identical = earlier.promise.future();
+        break;
+      }
+    }
+
+    if (identical.isSome()) {
+      request.promise.associate(identical.get());
+    } else {
+      request.promise.associate(process::async(
+          produceResponse, request.handler, request.request,
+          request.approvers));
+    }
   }
 
-  // Block the master actor until all workers have generated state responses.
+  // Block the master actor until all workers have generated responses.
   // It is crucial not to allow the master actor to continue and possibly
   // modify its state while a worker is reading it.
   //
   // NOTE: There is the potential for deadlock since we are blocking 1 working
   // thread here, see MESOS-8256.
   vector<Future<Response>> responses;
-  foreach (const BatchedStateRequest& request, batchedStateRequests) {
+  foreach (const BatchedRequest& request, batchedRequests) {
     responses.push_back(request.promise.future());
   }
   process::await(responses).await();
 
-  batchedStateRequests.clear();
+  batchedRequests.clear();
 }
 
 
@@ -3302,7 +3706,7 @@ string Master::Http::STATESUMMARY_HELP()
 
 Future<Response> Master::Http::stateSummary(
     const Request& request,
-    const Option<Principal>& principal) const
+    const Option<Principal>& principal)
 {
   // TODO(greggomann): Remove this check once the `Principal` type is used in
   // `ReservationInfo`, `DiskInfo`, and within the master's `principals` map.
@@ -3324,147 +3728,159 @@ Future<Response> Master::Http::stateSummary(
       {VIEW_ROLE, VIEW_FRAMEWORK})
     .then(defer(
         master->self(),
-        [this, request](const Owned<ObjectApprovers>& approvers) -> Response {
-          auto stateSummary = [this, &approvers](JSON::ObjectWriter* writer) {
-            writer->field("hostname", master->info().hostname());
+        [this, request, principal](const Owned<ObjectApprovers>& approvers) {
+          return deferBatchedRequest(
+              ReadOnlyRequestHandler::STATE_SUMMARY,
+              request,
+              principal,
+              approvers);
+        }));
+}
 
-            if (master->flags.cluster.isSome()) {
-              writer->field("cluster", master->flags.cluster.get());
-            }
 
-            // We use the tasks in the 'Frameworks' struct to compute summaries
-            // for this endpoint. This is done 1) for consistency between the
-            // 'slaves' and 'frameworks' subsections below 2) because we want to
-            // provide summary information for frameworks that are currently
-            // registered 3) the frameworks keep a circular buffer of completed
-            // tasks that we can use to keep a limited view on the history of
-            // recent completed / failed tasks.
-
-            // Generate mappings from 'slave' to 'framework' and reverse.
-            SlaveFrameworkMapping slaveFrameworkMapping(
-                master->frameworks.registered);
-
-            // Generate 'TaskState' summaries for all framework and slave ids.
-            TaskStateSummaries taskStateSummaries(
-                master->frameworks.registered);
-
-            // Model all of the slaves.
-            writer->field(
-                "slaves",
-                [this,
+Response Master::Http::processStateSummaryRequest(
+    const Request& request,
+    const Owned<ObjectApprovers>& approvers) const
+{
+  auto stateSummary = [this, &approvers](JSON::ObjectWriter* writer) {
+    writer->field("hostname", master->info().hostname());
+
+    if (master->flags.cluster.isSome()) {
+      writer->field("cluster", master->flags.cluster.get());
+    }
+
+    // We use the tasks in the 'Frameworks' struct to compute summaries
+    // for this endpoint. This is done 1) for consistency between the
+    // 'slaves' and 'frameworks' subsections below 2) because we want to
+    // provide summary information for frameworks that are currently
+    // registered 3) the frameworks keep a circular buffer of completed
+    // tasks that we can use to keep a limited view on the history of
+    // recent completed / failed tasks.
+
+    // Generate mappings from 'slave' to 'framework' and reverse.
+    SlaveFrameworkMapping slaveFrameworkMapping(
+        master->frameworks.registered);
+
+    // Generate 'TaskState' summaries for all framework and slave ids.
+    TaskStateSummaries taskStateSummaries(
+        master->frameworks.registered);
+
+    // Model all of the slaves.
+    writer->field(
+        "slaves",
+        [this,
+         &slaveFrameworkMapping,
+         &taskStateSummaries,
+         &approvers](JSON::ArrayWriter* writer) {
+          foreachvalue (Slave* slave, master->slaves.registered) {
+            writer->element(
+                [&slave,
                  &slaveFrameworkMapping,
                  &taskStateSummaries,
-                 &approvers](JSON::ArrayWriter* writer) {
-                  foreachvalue (Slave* slave, master->slaves.registered) {
-                    writer->element(
-                        [&slave,
-                         &slaveFrameworkMapping,
-                         &taskStateSummaries,
-                         &approvers](JSON::ObjectWriter* writer) {
-                          SlaveWriter slaveWriter(*slave, approvers);
-                          slaveWriter(writer);
-
-                          // Add the 'TaskState' summary for this slave.
-                          const TaskStateSummary& summary =
-                              taskStateSummaries.slave(slave->id);
-
-                          // Certain per-agent status totals will always be zero
-                          // (e.g., TASK_ERROR, TASK_UNREACHABLE). We report
-                          // them here anyway, for completeness.
-                          //
-                          // TODO(neilc): Update for TASK_GONE and
-                          // TASK_GONE_BY_OPERATOR.
-                          writer->field("TASK_STAGING", summary.staging);
-                          writer->field("TASK_STARTING", summary.starting);
-                          writer->field("TASK_RUNNING", summary.running);
-                          writer->field("TASK_KILLING", summary.killing);
-                          writer->field("TASK_FINISHED", summary.finished);
-                          writer->field("TASK_KILLED", summary.killed);
-                          writer->field("TASK_FAILED", summary.failed);
-                          writer->field("TASK_LOST", summary.lost);
-                          writer->field("TASK_ERROR", summary.error);
-                          writer->field(
-                              "TASK_UNREACHABLE",
-                              summary.unreachable);
-
-                          // Add the ids of all the frameworks running on this
-                          // slave.
-                          const hashset<FrameworkID>& frameworks =
-                              slaveFrameworkMapping.frameworks(slave->id);
-
-                          writer->field(
-                              "framework_ids",
-                              [&frameworks](JSON::ArrayWriter* writer) {
-                                foreach (
-                                    const FrameworkID& frameworkId,
-                                    frameworks) {
-                                  writer->element(frameworkId.value());
-                                }
-                              });
-                        });
-                  }
+                 &approvers](JSON::ObjectWriter* writer) {
+                  SlaveWriter slaveWriter(*slave, approvers);
+                  slaveWriter(writer);
+
+                  // Add the 'TaskState' summary for this slave.
+                  const TaskStateSummary& summary =
+                      taskStateSummaries.slave(slave->id);
+
+                  // Certain per-agent status totals will always be zero
+                  // (e.g., TASK_ERROR, TASK_UNREACHABLE). We report
+                  // them here anyway, for completeness.
+                  //
+                  // TODO(neilc): Update for TASK_GONE and
+                  // TASK_GONE_BY_OPERATOR.
+                  writer->field("TASK_STAGING", summary.staging);
+                  writer->field("TASK_STARTING", summary.starting);
+                  writer->field("TASK_RUNNING", summary.running);
+                  writer->field("TASK_KILLING", summary.killing);
+                  writer->field("TASK_FINISHED", summary.finished);
+                  writer->field("TASK_KILLED", summary.killed);
+                  writer->field("TASK_FAILED", summary.failed);
+                  writer->field("TASK_LOST", summary.lost);
+                  writer->field("TASK_ERROR", summary.error);
+                  writer->field(
+                      "TASK_UNREACHABLE",
+                      summary.unreachable);
+
+                  // Add the ids of all the frameworks running on this
+                  // slave.
+                  const hashset<FrameworkID>& frameworks =
+                      slaveFrameworkMapping.frameworks(slave->id);
+
+                  writer->field(
+                      "framework_ids",
+                      [&frameworks](JSON::ArrayWriter* writer) {
+                        foreach (
+                            const FrameworkID& frameworkId,
+                            frameworks) {
+                          writer->element(frameworkId.value());
+                        }
+                      });
                 });
+          }
+        });
 
-            // Model all of the frameworks.
-            writer->field(
-                "frameworks",
-                [this,
-                 &slaveFrameworkMapping,
-                 &taskStateSummaries,
-                 &approvers](JSON::ArrayWriter* writer) {
-                  foreachpair (const FrameworkID& frameworkId,
-                               Framework* framework,
-                               master->frameworks.registered) {
-                    // Skip unauthorized frameworks.
-                    if (!approvers->approved<VIEW_FRAMEWORK>(framework->info)) {
-                      continue;
-                    }
+    // Model all of the frameworks.
+    writer->field(
+        "frameworks",
+        [this,
+         &slaveFrameworkMapping,
+         &taskStateSummaries,
+         &approvers](JSON::ArrayWriter* writer) {
+          foreachpair (const FrameworkID& frameworkId,
+                       Framework* framework,
+                       master->frameworks.registered) {
+            // Skip unauthorized frameworks.
+            if (!approvers->approved<VIEW_FRAMEWORK>(framework->info)) {
+              continue;
+            }
 
-                    writer->element(
-                        [&frameworkId,
-                         &framework,
-                         &slaveFrameworkMapping,
-                         &taskStateSummaries](JSON::ObjectWriter* writer) {
-                          json(writer, Summary<Framework>(*framework));
-
-                          // Add the 'TaskState' summary for this framework.
-                          const TaskStateSummary& summary =
-                              taskStateSummaries.framework(frameworkId);
-
-                          // TODO(neilc): Update for TASK_GONE and
-                          // TASK_GONE_BY_OPERATOR.
-                          writer->field("TASK_STAGING", summary.staging);
-                          writer->field("TASK_STARTING", summary.starting);
-                          writer->field("TASK_RUNNING", summary.running);
-                          writer->field("TASK_KILLING", summary.killing);
-                          writer->field("TASK_FINISHED", summary.finished);
-                          writer->field("TASK_KILLED", summary.killed);
-                          writer->field("TASK_FAILED", summary.failed);
-                          writer->field("TASK_LOST", summary.lost);
-                          writer->field("TASK_ERROR", summary.error);
-                          writer->field(
-                              "TASK_UNREACHABLE",
-                              summary.unreachable);
-
-                          // Add the ids of all the slaves running
-                          // this framework.
-                          const hashset<SlaveID>& slaves =
-                              slaveFrameworkMapping.slaves(frameworkId);
-
-                          writer->field(
-                              "slave_ids",
-                              [&slaves](JSON::ArrayWriter* writer) {
-                                foreach (const SlaveID& slaveId, slaves) {
-                                  writer->element(slaveId.value());
-                                }
-                              });
-                        });
-                  }
+            writer->element(
+                [&frameworkId,
+                 &framework,
+                 &slaveFrameworkMapping,
+                 &taskStateSummaries](JSON::ObjectWriter* writer) {
+                  json(writer, Summary<Framework>(*framework));
+
+                  // Add the 'TaskState' summary for this framework.
+                  const TaskStateSummary& summary =
+                      taskStateSummaries.framework(frameworkId);
+
+                  // TODO(neilc): Update for TASK_GONE and
+                  // TASK_GONE_BY_OPERATOR.
+                  writer->field("TASK_STAGING", summary.staging);
+                  writer->field("TASK_STARTING", summary.starting);
+                  writer->field("TASK_RUNNING", summary.running);
+                  writer->field("TASK_KILLING", summary.killing);
+                  writer->field("TASK_FINISHED", summary.finished);
+                  writer->field("TASK_KILLED", summary.killed);
+                  writer->field("TASK_FAILED", summary.failed);
+                  writer->field("TASK_LOST", summary.lost);
+                  writer->field("TASK_ERROR", summary.error);
+                  writer->field(
+                      "TASK_UNREACHABLE",
+                      summary.unreachable);
+
+                  // Add the ids of all the slaves running
+                  // this framework.
+                  const hashset<SlaveID>& slaves =
+                      slaveFrameworkMapping.slaves(frameworkId);
+
+                  writer->field(
+                      "slave_ids",
+                      [&slaves](JSON::ArrayWriter* writer) {
+                        foreach (const SlaveID& slaveId, slaves) {
+                          writer->element(slaveId.value());
+                        }
+                      });
                 });
-          };
+          }
+        });
+  };
 
-          return OK(jsonify(stateSummary), request.url.query.get("jsonp"));
-        }));
+  return OK(jsonify(stateSummary), request.url.query.get("jsonp"));
 }
 
 
@@ -4003,6 +4419,8 @@ string Master::Http::TASKS_HELP()
         "",
         "Query parameters:",
         "",
+        ">        agent_id=VALUE       Only return tasks placed on the "
+        "agent with this ID.",
         ">        framework_id=VALUE   Only return tasks belonging to the "
         "framework with this ID.",
         ">        limit=VALUE          Maximum number of tasks returned "
@@ -4010,6 +4428,8 @@ string Master::Http::TASKS_HELP()
         ">        offset=VALUE         Starts task list at offset.",
         ">        order=(asc|desc)     Ascending or descending sort order "
         "(default is descending).",
+        ">        state=VALUE          Only return tasks in this state, "
+        "e.g., 'TASK_RUNNING'.",
         ">        task_id=VALUE        Only return tasks with this ID "
         "(should be used together with parameter 'framework_id')."
         ""),
@@ -4024,7 +4444,7 @@ string Master::Http::TASKS_HELP()
 
 Future<Response> Master::Http::tasks(
     const Request& request,
-    const Option<Principal>& principal) const
+    const Option<Principal>& principal)
 {
   // TODO(greggomann): Remove this check once the `Principal` type is used in
   // `ReservationInfo`, `DiskInfo`, and within the master's `principals` map.
@@ -4040,6 +4460,23 @@ Future<Response> Master::Http::tasks(
     return redirect(request);
   }
 
+  return ObjectApprovers::create(
+      master->authorizer,
+      principal,
+      {VIEW_FRAMEWORK, VIEW_TASK})
+    .then(defer(
+        master->self(),
+        [this, request, principal](const Owned<ObjectApprovers>& approvers) {
+          return deferBatchedRequest(
+              ReadOnlyRequestHandler::TASKS, request, principal, approvers);
+        }));
+}
+
+
+Response Master::Http::processTasksRequest(
+    const Request& request,
+    const Owned<ObjectApprovers>& approvers) const
+{
   // Get list options (limit and offset).
   Result<int> result = numify<int>(request.url.query.get("limit"));
   size_t limit = result.isSome() ? result.get() : TASK_LIMIT;
@@ -4052,104 +4489,144 @@ Future<Response> Master::Http::tasks(
 
   Option<string> frameworkId = request.url.query.get("framework_id");
   Option<string> taskId = request.url.query.get("task_id");
+  Option<string> agentId = request.url.query.get("agent_id");
+  Option<string> state = request.url.query.get("state");
 
-  return ObjectApprovers::create(
-      master->authorizer,
-      principal,
-      {VIEW_FRAMEWORK, VIEW_TASK})
-    .then(defer(
-        master->self(),
-        [=](const Owned<ObjectApprovers>& approvers) -> Response {
-          IDAcceptor<FrameworkID> selectFrameworkId(frameworkId);
-          IDAcceptor<TaskID> selectTaskId(taskId);
-
-          // Construct framework list with both active and completed frameworks.
-          vector<const Framework*> frameworks;
-          foreachvalue (Framework* framework, master->frameworks.registered) {
-            // Skip unauthorized frameworks or frameworks without matching
-            // framework ID.
-            if (!selectFrameworkId.accept(framework->id()) ||
-                !approvers->approved<VIEW_FRAMEWORK>(framework->info)) {
-              continue;
-            }
+  IDAcceptor<FrameworkID> selectFrameworkId(frameworkId);
+  IDAcceptor<TaskID> selectTaskId(taskId);
+  IDAcceptor<SlaveID> selectSlaveId(agentId);
 
-            frameworks.push_back(framework);
-          }
+  Option<TaskState> taskState;
+  if (state.isSome()) {
+    TaskState parsed;
+    if (!TaskState_Parse(state.get(), &parsed)) {
+      return BadRequest(
+          "Invalid 'state' query parameter '" + state.get() + "'");
+    }
 
-          foreachvalue (const Owned<Framework>& framework,
-                        master->frameworks.completed) {
-            // Skip unauthorized frameworks or frameworks without matching
-            // framework ID.
-            if (!selectFrameworkId.accept(framework->id()) ||
-                !approvers->approved<VIEW_FRAMEWORK>(framework->info)) {
-             continue;
-            }
+    taskState = parsed;
+  }
 
-            frameworks.push_back(framework.get());
-          }
+  // Whether a task passes the state and agent filters.
+  auto selected = [&taskState, &selectSlaveId](const Task& task) {
+    return (taskState.isNone() || task.state() == taskState.get()) &&
+           selectSlaveId.accept(task.slave_id());
+  };
 
-          // Construct task list with both running,
-          // completed and unreachable tasks.
-          vector<const Task*> tasks;
-          foreach (const Framework* framework, frameworks) {
-            foreachvalue (Task* task, framework->tasks) {
-              CHECK_NOTNULL(task);
-              // Skip unauthorized tasks or tasks without matching task ID.
-              if (!selectTaskId.accept(task->task_id()) ||
-                  !approvers->approved<VIEW_TASK>(*task, framework->info)) {
-                continue;
-              }
+  // Construct framework list with both active and completed frameworks.
+  vector<const Framework*> frameworks;
+  foreachvalue (Framework* framework, master->frameworks.registered) {
+    // Skip unauthorized frameworks or frameworks without matching
+    // framework ID.
+    if (!selectFrameworkId.accept(framework->id()) ||
+        !approvers->approved<VIEW_FRAMEWORK>(framework->info)) {
+      continue;
+    }
 
-              tasks.push_back(task);
-            }
+    frameworks.push_back(framework);
+  }
 
-            foreachvalue (
-                const Owned<Task>& task,
-                framework->unreachableTasks) {
-              // Skip unauthorized tasks or tasks without matching task ID.
-              if (!selectTaskId.accept(task->task_id()) ||
-                  !approvers->approved<VIEW_TASK>(*task, framework->info)) {
-                continue;
-              }
+  foreachvalue (const Owned<Framework>& framework,
+                master->frameworks.completed) {
+    // Skip unauthorized frameworks or frameworks without matching
+    // framework ID.
+    if (!selectFrameworkId.accept(framework->id()) ||
+        !approvers->approved<VIEW_FRAMEWORK>(framework->info)) {
+     continue;
+    }
 
-              tasks.push_back(task.get());
-            }
+    frameworks.push_back(framework.get());
+  }
 
-            foreach (const Owned<Task>& task, framework->completedTasks) {
-              // Skip unauthorized tasks or tasks without matching task ID.
-              if (!selectTaskId.accept(task->task_id()) ||
-                  !approvers->approved<VIEW_TASK>(*task, framework->info)) {
-                continue;
-              }
+  // Construct task list with both running,
+  // completed and unreachable tasks.
+  vector<const Task*> tasks;
+  foreach (const Framework* framework, frameworks) {
+    if (taskId.isSome()) {
+      // A point lookup: use the keyed task maps rather than
+      // enumerating every task of the framework. Completed
+      // tasks are handled below since task IDs are not unique
+      // within the completed tasks cache.
+      TaskID taskId_;
+      taskId_.set_value(taskId.get());
+
+      Option<Task*> task = framework->tasks.get(taskId_);
+      if (task.isSome() &&
+          selected(*task.get()) &&
+          approvers->approved<VIEW_TASK>(
+              *task.get(), framework->info)) {
+        tasks.push_back(task.get());
+      }
 
-              tasks.push_back(task.get());
-            }
-          }
+      Option<Owned<Task>> unreachableTask =
+        framework->unreachableTasks.get(taskId_);
+      if (unreachableTask.isSome() &&
+          selected(*unreachableTask.get()) &&
+          approvers->approved<VIEW_TASK>(
+              *unreachableTask.get(), framework->info)) {
+        tasks.push_back(unreachableTask->get());
+      }
+    } else {
+      foreachvalue (Task* task, framework->tasks) {
+        CHECK_NOTNULL(task);
+        // Skip unauthorized or filtered out tasks.
+        if (!selected(*task) ||
+            !approvers->approved<VIEW_TASK>(*task, framework->info)) {
+          continue;
+        }
 
-          // Sort tasks by task status timestamp. Default order is descending.
-          // The earliest timestamp is chosen for comparison when
-          // multiple are present.
-          if (_order == "asc") {
-            sort(tasks.begin(), tasks.end(), TaskComparator::ascending);
-          } else {
-            sort(tasks.begin(), tasks.end(), TaskComparator::descending);
-          }
+        tasks.push_back(task);
+      }
 
-          auto tasksWriter =
-            [&tasks, limit, offset](JSON::ObjectWriter* writer) {
-              writer->field(
-                  "tasks",
-                  [&tasks, limit, offset](JSON::ArrayWriter* writer) {
-                    // Collect 'limit' number of tasks starting from 'offset'.
-                    size_t end = std::min(offset + limit, tasks.size());
-                    for (size_t i = offset; i < end; i++) {
-                      writer->element(*tasks[i]);
-                    }
-                  });
-          };
+      foreachvalue (
+          const Owned<Task>& task,
+          framework->unreachableTasks) {
+        // Skip unauthorized or filtered out tasks.
+        if (!selected(*task) ||
+            !approvers->approved<VIEW_TASK>(*task, framework->info)) {
+          continue;
+        }
 
-          return OK(jsonify(tasksWriter), request.url.query.get("jsonp"));
-  }));
+        tasks.push_back(task.get());
+      }
+    }
+
+    foreach (const Owned<Task>& task, framework->completedTasks) {
+      // Skip unauthorized, filtered out tasks or tasks without
+      // matching task ID.
+      if (!selectTaskId.accept(task->task_id()) ||
+          !selected(*task) ||
+          !approvers->approved<VIEW_TASK>(*task, framework->info)) {
+        continue;
+      }
+
+      tasks.push_back(task.get());
+    }
+  }
+
+  // Sort tasks by task status timestamp. Default order is descending.
+  // The earliest timestamp is chosen for comparison when
+  // multiple are present.
+  if (_order == "asc") {
+    sort(tasks.begin(), tasks.end(), TaskComparator::ascending);
+  } else {
+    sort(tasks.begin(), tasks.end(), TaskComparator::descending);
+  }
+
+  auto tasksWriter =
+    [&tasks, limit, offset](JSON::ObjectWriter* writer) {
+      writer->field(
+          "tasks",
+          [&tasks, limit, offset](JSON::ArrayWriter* writer) {
+            // Collect 'limit' number of tasks starting from 'offset'.
+            size_t end = std::min(offset + limit, tasks.size());
+            for (size_t i = offset; i < end; i++) {
+              writer->element(*tasks[i]);
+            }
+          });
+  };
+
+  return OK(jsonify(tasksWriter), request.url.query.get("jsonp"));
 }
 
 
@@ -4170,7 +4647,11 @@ Future<Response> Master::Http::getTasks(
           mesos::master::Response response;
           response.set_type(mesos::master::Response::GET_TASKS);
 
-          *response.mutable_get_tasks() = _getTasks(approvers);
+          *response.mutable_get_tasks() = _getTasks(
+              approvers,
+              call.has_get_tasks()
+                ? Option<mesos::master::Call::GetTasks>(call.get_tasks())
+                : None());
 
           return OK(
               serialize(contentType, evolve(response)), stringify(contentType));
@@ -4179,13 +4660,66 @@ Future<Response> Master::Http::getTasks(
 
 
 mesos::master::Response::GetTasks Master::Http::_getTasks(
-    const Owned<ObjectApprovers>& approvers) const
+    const Owned<ObjectApprovers>& approvers,
+    const Option<mesos::master::Call::GetTasks>& options) const
 {
+  // Narrowing requested by the client (see `Call::GetTasks`). The
+  // filters and the limit/offset window are evaluated against the
+  // task index here, before anything gets copied into the response.
+  Option<FrameworkID> frameworkId;
+  Option<TaskState> state;
+  Option<SlaveID> slaveId;
+  Option<size_t> limit;
+  size_t offset = 0;
+
+  if (options.isSome()) {
+    if (options->has_framework_id()) {
+      frameworkId = options->framework_id();
+    }
+    if (options->has_state()) {
+      state = options->state();
+    }
+    if (options->has_slave_id()) {
+      slaveId = options->slave_id();
+    }
+    if (options->has_limit()) {
+      limit = options->limit();
+    }
+    offset = options->offset();
+  }
+
+  // Whether a task passes the state and agent filters.
+  auto selected = [&state, &slaveId](
+      const TaskState& taskState, const SlaveID& taskSlaveId) {
+    return (state.isNone() || taskState == state.get()) &&
+           (slaveId.isNone() || taskSlaveId == slaveId.get());
+  };
+
+  // Whether a task that passed the filters falls into the
+  // offset/limit window. Must be called once per matching task.
+  size_t skipped = 0;
+  size_t added = 0;
+  auto within = [&skipped, &added, &offset]() {
+    if (skipped < offset) {
+      ++skipped;
+      return false;
+    }
+
+    ++added;
+    return true;
+  };
+
+  auto full = [&added, &limit]() {
+    return limit.isSome() && added >= limit.get();
+  };
+
   // Construct framework list with both active and completed frameworks.
   vector<const Framework*> frameworks;
   foreachvalue (Framework* framework, master->frameworks.registered) {
-    // Skip unauthorized frameworks.
-    if (!approvers->approved<VIEW_FRAMEWORK>(framework->info)) {
+    // Skip unauthorized frameworks or frameworks without matching
+    // framework ID.
+    if ((frameworkId.isSome() && framework->id() != frameworkId.get()) ||
+        !approvers->approved<VIEW_FRAMEWORK>(framework->info)) {
       continue;
     }
 
@@ -4194,8 +4728,10 @@ mesos::master::Response::GetTasks Master::Http::_getTasks(
 
   foreachvalue (const Owned<Framework>& framework,
                 master->frameworks.completed) {
-    // Skip unauthorized frameworks.
-    if (!approvers->approved<VIEW_FRAMEWORK>(framework->info)) {
+    // Skip unauthorized frameworks or frameworks without matching
+    // framework ID.
+    if ((frameworkId.isSome() && framework->id() != frameworkId.get()) ||
+        !approvers->approved<VIEW_FRAMEWORK>(framework->info)) {
       continue;
     }
 
@@ -4206,10 +4742,20 @@ mesos::master::Response::GetTasks Master::Http::_getTasks(
 
   vector<const Task*> tasks;
   foreach (const Framework* framework, frameworks) {
+    if (full()) {
+      break;
+    }
+
     // Pending tasks.
     foreachvalue (const TaskInfo& taskInfo, framework->pendingTasks) {
-      // Skip unauthorized tasks.
-      if (!approvers->approved<VIEW_TASK>(taskInfo, framework->info)) {
+      if (full()) {
+        break;
+      }
+
+      // Skip unauthorized or filtered out tasks.
+      if (!selected(TASK_STAGING, taskInfo.slave_id()) ||
+          !approvers->approved<VIEW_TASK>(taskInfo, framework->info) ||
+          !within()) {
         continue;
       }
 
@@ -4220,8 +4766,15 @@ mesos::master::Response::GetTasks Master::Http::_getTasks(
     // Active tasks.
     foreachvalue (Task* task, framework->tasks) {
       CHECK_NOTNULL(task);
-      // Skip unauthorized tasks.
-      if (!approvers->approved<VIEW_TASK>(*task, framework->info)) {
+
+      if (full()) {
+        break;
+      }
+
+      // Skip unauthorized or filtered out tasks.
+      if (!selected(task->state(), task->slave_id()) ||
+          !approvers->approved<VIEW_TASK>(*task, framework->info) ||
+          !within()) {
         continue;
       }
 
@@ -4230,8 +4783,14 @@ mesos::master::Response::GetTasks Master::Http::_getTasks(
 
     // Unreachable tasks.
     foreachvalue (const Owned<Task>& task, framework->unreachableTasks) {
-      // Skip unauthorized tasks.
-      if (!approvers->approved<VIEW_TASK>(*task, framework->info)) {
+      if (full()) {
+        break;
+      }
+
+      // Skip unauthorized or filtered out tasks.
+      if (!selected(task->state(), task->slave_id()) ||
+          !approvers->approved<VIEW_TASK>(*task, framework->info) ||
+          !within()) {
         continue;
       }
 
@@ -4240,8 +4799,14 @@ mesos::master::Response::GetTasks Master::Http::_getTasks(
 
     // Completed tasks.
     foreach (const Owned<Task>& task, framework->completedTasks) {
-      // Skip unauthorized tasks.
-      if (!approvers->approved<VIEW_TASK>(*task, framework->info)) {
+      if (full()) {
+        break;
+      }
+
+      // Skip unauthorized or filtered out tasks.
+      if (!selected(task->state(), task->slave_id()) ||
+          !approvers->approved<VIEW_TASK>(*task, framework->info) ||
+          !within()) {
         continue;
       }
 
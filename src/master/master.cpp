@@ -25,6 +25,7 @@
 #include <memory>
 #include <set>
 #include <sstream>
+#include <thread>
 #include <tuple>
 #include <utility>
 
@@ -43,6 +44,8 @@
 
 #include <mesos/scheduler/scheduler.hpp>
 
+#include <process/after.hpp>
+#include <process/async.hpp>
 #include <process/check.hpp>
 #include <process/collect.hpp>
 #include <process/defer.hpp>
@@ -67,6 +70,7 @@
 #include <stout/nothing.hpp>
 #include <stout/numify.hpp>
 #include <stout/option.hpp>
+#include <stout/os.hpp>
 #include <stout/path.hpp>
 #include <stout/stringify.hpp>
 #include <stout/unreachable.hpp>
@@ -80,6 +84,7 @@
 #include "common/protobuf_utils.hpp"
 #include "common/resource_quantities.hpp"
 #include "common/status_utils.hpp"
+#include "common/tracepoints.hpp"
 
 #include "credentials/credentials.hpp"
 
@@ -391,18 +396,76 @@ Master::Master(
 Master::~Master() {}
 
 
+// A token bucket (with a burst size of one) that permits messages
+// inline, in O(1), as long as the sender stays within the configured
+// rate: permits are spaced at least 1 / qps apart and a message that
+// cannot get a permit immediately is delayed until the time the next
+// permit becomes available. Compared to `process::RateLimiter` this
+// avoids a round trip to a separate limiter actor (and the associated
+// promise allocation) for every message, which matters when the
+// master is being flooded.
+//
 // TODO(vinod): Update this interface to return failed futures when
 // capacity is reached.
 struct BoundedRateLimiter
 {
   BoundedRateLimiter(double qps, Option<uint64_t> _capacity)
-    : limiter(new process::RateLimiter(qps)),
+    : interval(Seconds(1) / qps),
       capacity(_capacity),
+      next(Time::epoch()),
+      queued(0),
       messages(0) {}
 
-  process::Owned<process::RateLimiter> limiter;
+  // Attempts to consume a permit without waiting. Returns true if a
+  // permit is available and no earlier message is still waiting for
+  // one (which would otherwise be overtaken), i.e., the message can
+  // be processed inline.
+  bool permit()
+  {
+    const Time now = Clock::now();
+
+    if (queued == 0 && now >= next) {
+      next = now + interval;
+      return true;
+    }
+
+    return false;
+  }
+
+  // Consumes the next available permit and returns how long the
+  // caller must delay the message. The caller must call `release()`
+  // once the delayed message is finally processed.
+  Duration acquire()
+  {
+    const Time now = Clock::now();
+
+    if (now > next) {
+      next = now;
+    }
+
+    const Duration wait = next - now;
+    next += interval;
+    queued++;
+    return wait;
+  }
+
+  void release()
+  {
+    CHECK_GT(queued, 0u);
+    queued--;
+  }
+
+  // The minimum time between two permits, i.e., 1 / qps.
+  const Duration interval;
+
   const Option<uint64_t> capacity;
 
+  // The time at which the next permit becomes available.
+  Time next;
+
+  // Number of delayed events that have not yet been processed.
+  uint64_t queued;
+
   // Number of outstanding messages for this RateLimiter.
   // NOTE: ExitedEvents are throttled but not counted towards
   // the capacity here.
@@ -772,12 +835,45 @@ void Master::initialize()
       });
   spawn(whitelistWatcher);
 
+  // Open the on-disk archive of completed tasks and frameworks,
+  // if enabled.
+  if (flags.completed_archive_dir.isSome()) {
+    Try<Nothing> mkdir = os::mkdir(flags.completed_archive_dir.get());
+    if (mkdir.isError()) {
+      EXIT(EXIT_FAILURE)
+        << "Failed to create completed archive directory '"
+        << flags.completed_archive_dir.get() << "': " << mkdir.error();
+    }
+
+    const string path =
+      path::join(flags.completed_archive_dir.get(), "completed.recordio");
+
+    Try<int_fd> open = os::open(
+        path,
+        O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC,
+        S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+
+    if (open.isError()) {
+      EXIT(EXIT_FAILURE)
+        << "Failed to open completed archive '" << path
+        << "': " << open.error();
+    }
+
+    completedArchive = open.get();
+  }
+
   nextFrameworkId = 0;
   nextSlaveId = 0;
   nextOfferId = 0;
 
   startTime = Clock::now();
 
+  // Seed the state versions with the boot time so that a 'since'
+  // version obtained from a previous master incarnation (whose
+  // counters also started from zero) never coincides with ours.
+  stateVersions.tasks = stateVersions.frameworks = stateVersions.agents =
+    static_cast<uint64_t>(startTime.duration().ns());
+
   install<scheduler::Call>(&Master::receive);
 
   // Install handler functions for certain messages.
@@ -918,6 +1014,12 @@ void Master::initialize()
         [this](const process::http::Request& request) {
           return http.health(request);
         });
+  route("/messages",
+        Http::MESSAGES_HELP(),
+        [this](const process::http::Request& request) {
+          logRequest(request);
+          return http.messages(request);
+        });
   route("/redirect",
         Http::REDIRECT_HELP(),
         [this](const process::http::Request& request) {
@@ -1229,6 +1331,11 @@ void Master::finalize()
   wait(whitelistWatcher);
   delete whitelistWatcher;
 
+  if (completedArchive.isSome()) {
+    os::close(completedArchive.get());
+    completedArchive = None();
+  }
+
   if (authenticator.isSome()) {
     delete authenticator.get();
   }
@@ -1498,6 +1605,10 @@ void Master::consume(MessageEvent&& event)
   // 1) the default RateLimiter is not configured to handle case 2)
   //    above. (or)
   // 2) the principal exists in RateLimits but 'qps' is not set.
+
+  // Necessary to disambiguate below.
+  typedef void(Self::*M)(MessageEvent&&, const Option<string>&);
+
   if (principal.isSome() &&
       frameworks.limiters.contains(principal.get()) &&
       frameworks.limiters[principal.get()].isSome()) {
@@ -1506,9 +1617,23 @@ void Master::consume(MessageEvent&& event)
 
     if (limiter->capacity.isNone() ||
         limiter->messages < limiter->capacity.get()) {
-      limiter->messages++;
-      limiter->limiter->acquire()
-        .onReady(defer(self(), &Self::throttled, std::move(event), principal));
+      if (limiter->permit()) {
+        // A permit is available so the message is processed inline
+        // without any additional queueing or allocation.
+        _consume(std::move(event));
+      } else {
+        limiter->messages++;
+
+        // If the framework has a principal, the counter must exist.
+        Counter messages_throttled =
+          metrics->frameworks.get(principal.get()).get()->messages_throttled;
+        ++messages_throttled;
+
+        process::after(limiter->acquire())
+          .onReady(
+              defer(self(), static_cast<M>(&Self::throttled),
+                    std::move(event), principal));
+      }
     } else {
       exceededCapacity(
           event,
@@ -1522,9 +1647,23 @@ void Master::consume(MessageEvent&& event)
     if (frameworks.defaultLimiter.get()->capacity.isNone() ||
         frameworks.defaultLimiter.get()->messages <
           frameworks.defaultLimiter.get()->capacity.get()) {
-      frameworks.defaultLimiter.get()->messages++;
-      frameworks.defaultLimiter.get()->limiter->acquire()
-        .onReady(defer(self(), &Self::throttled, std::move(event), None()));
+      if (frameworks.defaultLimiter.get()->permit()) {
+        _consume(std::move(event));
+      } else {
+        frameworks.defaultLimiter.get()->messages++;
+
+        // If the framework has a principal, the counter must exist.
+        if (principal.isSome()) {
+          Counter messages_throttled =
+            metrics->frameworks.get(principal.get()).get()->messages_throttled;
+          ++messages_throttled;
+        }
+
+        process::after(frameworks.defaultLimiter.get()->acquire())
+          .onReady(
+              defer(self(), static_cast<M>(&Self::throttled),
+                    std::move(event), None()));
+      }
     } else {
       exceededCapacity(
           event,
@@ -1551,19 +1690,34 @@ void Master::consume(ExitedEvent&& event)
     : Option<string>::none();
 
   // Necessary to disambiguate below.
-  typedef void(Self::*F)(ExitedEvent&&);
+  typedef void(Self::*F)(ExitedEvent&&, const Option<string>&);
 
   if (principal.isSome() &&
       frameworks.limiters.contains(principal.get()) &&
       frameworks.limiters[principal.get()].isSome()) {
-    frameworks.limiters[principal.get()].get()->limiter->acquire().onReady(
-        defer(self(), static_cast<F>(&Self::_consume), std::move(event)));
+    const Owned<BoundedRateLimiter>& limiter =
+      frameworks.limiters[principal.get()].get();
+
+    if (limiter->permit()) {
+      _consume(std::move(event));
+    } else {
+      process::after(limiter->acquire())
+        .onReady(
+            defer(self(), static_cast<F>(&Self::throttled),
+                  std::move(event), principal));
+    }
   } else if ((principal.isNone() ||
               !frameworks.limiters.contains(principal.get())) &&
              isRegisteredFramework &&
              frameworks.defaultLimiter.isSome()) {
-    frameworks.defaultLimiter.get()->limiter->acquire().onReady(
-        defer(self(), static_cast<F>(&Self::_consume), std::move(event)));
+    if (frameworks.defaultLimiter.get()->permit()) {
+      _consume(std::move(event));
+    } else {
+      process::after(frameworks.defaultLimiter.get()->acquire())
+        .onReady(
+            defer(self(), static_cast<F>(&Self::throttled),
+                  std::move(event), None()));
+    }
   } else {
     _consume(std::move(event));
   }
@@ -1581,9 +1735,29 @@ void Master::throttled(
   if (principal.isSome()) {
     CHECK_SOME(frameworks.limiters[principal.get()]);
     frameworks.limiters[principal.get()].get()->messages--;
+    frameworks.limiters[principal.get()].get()->release();
   } else {
     CHECK_SOME(frameworks.defaultLimiter);
     frameworks.defaultLimiter.get()->messages--;
+    frameworks.defaultLimiter.get()->release();
+  }
+
+  _consume(std::move(event));
+}
+
+
+void Master::throttled(
+    ExitedEvent&& event,
+    const Option<string>& principal)
+{
+  // We already know a RateLimiter is used to throttle this event so
+  // here we only need to determine which.
+  if (principal.isSome()) {
+    CHECK_SOME(frameworks.limiters[principal.get()]);
+    frameworks.limiters[principal.get()].get()->release();
+  } else {
+    CHECK_SOME(frameworks.defaultLimiter);
+    frameworks.defaultLimiter.get()->release();
   }
 
   _consume(std::move(event));
@@ -1671,16 +1845,39 @@ Future<Nothing> Master::recover()
 
 Future<Nothing> Master::_recover(const Registry& registry)
 {
-  foreach (const Registry::Slave& slave, registry.slaves().slaves()) {
-    SlaveInfo slaveInfo = slave.info();
+  // Upgrade the recovered agents' `SlaveInfo`s on worker threads in
+  // parallel. We store the `SlaveInfo`'s resources in the
+  // `pre-reservation-refinement` format in order to support
+  // downgrades, and converting them back to `post-` format (to keep
+  // our invariant of working with `post-` format resources within
+  // master memory) is CPU-bound and dominates failover recovery time
+  // for large registries.
+  const int numSlaves = registry.slaves().slaves().size();
+
+  const int parallelism =
+    static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+  const int chunkSize = numSlaves / parallelism + 1;
+
+  vector<Future<vector<SlaveInfo>>> upgrades;
 
-    // We store the `SlaveInfo`'s resources in the `pre-reservation-refinement`
-    // in order to support downgrades. We convert them back to `post-` format
-    // here so that we can keep our invariant of working with `post-` format
-    // resources within master memory.
-    upgradeResources(&slaveInfo);
+  for (int start = 0; start < numSlaves; start += chunkSize) {
+    const int end = std::min(start + chunkSize, numSlaves);
 
-    slaves.recovered.put(slaveInfo.id(), slaveInfo);
+    vector<SlaveInfo> chunk;
+    chunk.reserve(end - start);
+    for (int i = start; i < end; i++) {
+      chunk.push_back(registry.slaves().slaves(i).info());
+    }
+
+    upgrades.push_back(process::async(
+        [](vector<SlaveInfo> chunk) {
+          foreach (SlaveInfo& slaveInfo, chunk) {
+            upgradeResources(&slaveInfo);
+          }
+          return chunk;
+        },
+        std::move(chunk)));
   }
 
   foreach (const Registry::UnreachableSlave& unreachable,
@@ -1697,12 +1894,15 @@ Future<Nothing> Master::_recover(const Registry& registry)
   // Set up a timer for age-based registry GC.
   scheduleRegistryGc();
 
-  // Set up a timeout for slaves to reregister.
+  // Set up a timeout for slaves to reregister. Note that we pass the
+  // number of recovered agents rather than the registry itself, so
+  // that the timer does not hold a copy of a potentially very large
+  // registry for the duration of the reregistration timeout.
   slaves.recoveredTimer =
     delay(flags.agent_reregister_timeout,
           self(),
           &Self::recoveredSlavesTimeout,
-          registry);
+          static_cast<size_t>(numSlaves));
 
   // Save the maintenance schedule.
   foreach (const mesos::maintenance::Schedule& schedule, registry.schedules()) {
@@ -1772,13 +1972,28 @@ Future<Nothing> Master::_recover(const Registry& registry)
 
   allocator->updateWeights(weightInfos);
 
-  // Recovery is now complete!
-  LOG(INFO) << "Recovered " << registry.slaves().slaves().size() << " agents"
-            << " from the registry (" << Bytes(registry.ByteSize()) << ")"
-            << "; allowing " << flags.agent_reregister_timeout
-            << " for agents to reregister";
+  const size_t registryBytes = registry.ByteSize();
+
+  // Recovery completes once the upgraded `SlaveInfo`s have been
+  // collected into `slaves.recovered`; agents cannot reregister
+  // until then.
+  return process::collect(upgrades)
+    .then(defer(self(), [this, numSlaves, registryBytes](
+        const vector<vector<SlaveInfo>>& chunks) -> Future<Nothing> {
+      foreach (const vector<SlaveInfo>& chunk, chunks) {
+        foreach (const SlaveInfo& slaveInfo, chunk) {
+          slaves.recovered.put(slaveInfo.id(), slaveInfo);
+        }
+      }
+
+      // Recovery is now complete!
+      LOG(INFO) << "Recovered " << numSlaves << " agents"
+                << " from the registry (" << Bytes(registryBytes) << ")"
+                << "; allowing " << flags.agent_reregister_timeout
+                << " for agents to reregister";
 
-  return Nothing();
+      return Nothing();
+    }));
 }
 
 
@@ -1943,7 +2158,7 @@ void Master::_doRegistryGc(
 }
 
 
-void Master::recoveredSlavesTimeout(const Registry& registry)
+void Master::recoveredSlavesTimeout(size_t totalRecoveredAgents)
 {
   CHECK(elected());
 
@@ -1962,7 +2177,7 @@ void Master::recoveredSlavesTimeout(const Registry& registry)
   // safety-net limit, bail!
   double removalPercentage =
     (1.0 * slaves.recovered.size()) /
-    (1.0 * registry.slaves().slaves().size());
+    (1.0 * totalRecoveredAgents);
 
   if (removalPercentage > limit) {
     EXIT(EXIT_FAILURE)
@@ -1977,14 +2192,13 @@ void Master::recoveredSlavesTimeout(const Registry& registry)
   }
 
   // Remove the slaves in a rate limited manner, similar to how the
-  // SlaveObserver removes slaves.
-  foreach (const Registry::Slave& slave, registry.slaves().slaves()) {
-    // The slave is removed from `recovered` when it completes the
-    // re-registration process. If the slave is in `reregistering`, it
-    // has started but not yet finished reregistering. In either
-    // case, we don't want to try to remove it.
-    if (!slaves.recovered.contains(slave.info().id()) ||
-        slaves.reregistering.contains(slave.info().id())) {
+  // SlaveObserver removes slaves. The slave is removed from
+  // `recovered` when it completes the re-registration process, so
+  // everything still in `recovered` is a removal candidate unless it
+  // is in `reregistering`, i.e., it has started but not yet finished
+  // reregistering.
+  foreachvalue (const SlaveInfo& slave, slaves.recovered) {
+    if (slaves.reregistering.contains(slave.id())) {
       continue;
     }
 
@@ -1992,7 +2206,7 @@ void Master::recoveredSlavesTimeout(const Registry& registry)
 
     if (slaves.limiter.isSome()) {
       LOG(INFO) << "Scheduling removal of agent "
-                << slave.info().id() << " (" << slave.info().hostname() << ")"
+                << slave.id() << " (" << slave.hostname() << ")"
                 << "; did not reregister within "
                 << flags.agent_reregister_timeout << " after master failover";
 
@@ -2014,7 +2228,7 @@ void Master::recoveredSlavesTimeout(const Registry& registry)
       .onDiscarded(lambda::bind(fail, failure, "discarded"))
       .then(defer(self(),
                   &Self::markUnreachable,
-                  slave.info(),
+                  slave,
                   true,
                   "did not reregister within"
                   " " + stringify(flags.agent_reregister_timeout) +
@@ -2437,6 +2651,16 @@ void Master::receive(
 
     case scheduler::Call::ACKNOWLEDGE: {
       acknowledge(framework, std::move(*call.mutable_acknowledge()));
+      flushStatusUpdateAcknowledgements();
+      break;
+    }
+
+    case scheduler::Call::ACKNOWLEDGE_BATCH: {
+      foreach (scheduler::Call::Acknowledge& acknowledge_,
+               *call.mutable_acknowledge_batch()->mutable_acknowledgements()) {
+        acknowledge(framework, std::move(acknowledge_));
+      }
+      flushStatusUpdateAcknowledgements();
       break;
     }
 
@@ -2613,6 +2837,14 @@ void Master::subscribe(
     validationError = Error("Framework has been removed");
   }
 
+  if (validationError.isNone() && frameworkInfo.has_id() &&
+      frameworks.tearingDown.contains(frameworkInfo.id())) {
+    // The framework's tasks are still being removed in batches; let
+    // it subscribe once the teardown has completed, at which point it
+    // will be refused as a completed framework.
+    validationError = Error("Framework is currently being torn down");
+  }
+
   if (validationError.isNone() && !isValidFailoverTimeout(frameworkInfo)) {
     validationError = Error("The framework failover_timeout (" +
                             stringify(frameworkInfo.failover_timeout()) +
@@ -2708,6 +2940,10 @@ void Master::_subscribe(
     // Start the heartbeat after sending SUBSCRIBED event.
     framework->heartbeat();
 
+    // Bump outside the subscriber guard below: the cached '/state'
+    // responses must be invalidated even without event subscribers.
+    ++stateVersions.frameworks;
+
     if (!subscribers.subscribed.empty()) {
       subscribers.send(
           protobuf::master::event::createFrameworkAdded(*framework));
@@ -2761,6 +2997,8 @@ void Master::_subscribe(
     }
   }
 
+  ++stateVersions.frameworks;
+
   if (!subscribers.subscribed.empty()) {
     subscribers.send(
         protobuf::master::event::createFrameworkUpdated(*framework));
@@ -2878,6 +3116,14 @@ void Master::subscribe(
     validationError = Error("Framework has been removed");
   }
 
+  if (validationError.isNone() && frameworkInfo.has_id() &&
+      frameworks.tearingDown.contains(frameworkInfo.id())) {
+    // The framework's tasks are still being removed in batches; let
+    // it subscribe once the teardown has completed, at which point it
+    // will be refused as a completed framework.
+    validationError = Error("Framework is currently being torn down");
+  }
+
   if (validationError.isNone() && !isValidFailoverTimeout(frameworkInfo)) {
     validationError = Error("The framework failover_timeout (" +
                             stringify(frameworkInfo.failover_timeout()) +
@@ -3017,6 +3263,8 @@ void Master::_subscribe(
     message.mutable_master_info()->MergeFrom(info_);
     framework->send(message);
 
+    ++stateVersions.frameworks;
+
     if (!subscribers.subscribed.empty()) {
       subscribers.send(
           protobuf::master::event::createFrameworkAdded(*framework));
@@ -3095,6 +3343,8 @@ void Master::_subscribe(
       LOG(INFO) << "Framework " << *framework << " failed over";
       failoverFramework(framework, from);
 
+      ++stateVersions.frameworks;
+
       if (!subscribers.subscribed.empty()) {
         subscribers.send(
             protobuf::master::event::createFrameworkUpdated(*framework));
@@ -3147,6 +3397,8 @@ void Master::_subscribe(
       message.mutable_master_info()->MergeFrom(info_);
       framework->send(message);
 
+      ++stateVersions.frameworks;
+
       if (!subscribers.subscribed.empty()) {
         subscribers.send(
             protobuf::master::event::createFrameworkUpdated(*framework));
@@ -3168,6 +3420,8 @@ void Master::_subscribe(
       return;
     }
 
+    ++stateVersions.frameworks;
+
     if (!subscribers.subscribed.empty()) {
       subscribers.send(
           protobuf::master::event::createFrameworkUpdated(*framework));
@@ -3280,6 +3534,10 @@ void Master::deactivate(Framework* framework, bool rescind)
 
   framework->setFrameworkState(Framework::State::INACTIVE);
 
+  // There is no operator API event for framework (de)activation, so
+  // bump the framework state version here.
+  ++stateVersions.frameworks;
+
   // Tell the allocator to stop allocating resources to this framework.
   allocator->deactivateFramework(framework->id());
 
@@ -3336,6 +3594,10 @@ void Master::deactivate(Slave* slave)
 
   slave->active = false;
 
+  // There is no operator API event for agent (de)activation, so bump
+  // the agent state version here.
+  ++stateVersions.agents;
+
   allocator->deactivateSlave(slave->id);
 
   // Remove and rescind offers.
@@ -6339,12 +6601,63 @@ void Master::acknowledge(
   *message.mutable_task_id() = std::move(*acknowledge.mutable_task_id());
   *message.mutable_uuid() = std::move(*acknowledge.mutable_uuid());
 
-  send(slave->pid, message);
+  // Buffer the acknowledgement so that acknowledgements from a single
+  // batched call destined for the same agent are coalesced into one
+  // message. The caller flushes the buffer once the call has been
+  // processed; see `flushStatusUpdateAcknowledgements()`.
+  //
+  // NOTE: We cannot use `slaveId` here since the slave id was moved
+  // into `message` above.
+  BatchedStatusUpdateAcknowledgementsMessage& batched =
+    pendingStatusUpdateAcknowledgements[message.slave_id()];
+
+  if (batched.acknowledgements().empty()) {
+    *batched.mutable_slave_id() = message.slave_id();
+  }
+
+  *batched.add_acknowledgements() = std::move(message);
 
   metrics->valid_status_update_acknowledgements++;
 }
 
 
+void Master::flushStatusUpdateAcknowledgements()
+{
+  foreachvalue (const BatchedStatusUpdateAcknowledgementsMessage& batched,
+                pendingStatusUpdateAcknowledgements) {
+    Slave* slave = slaves.registered.get(batched.slave_id());
+
+    // `acknowledge()` only buffers acknowledgements for registered,
+    // connected agents and the buffer is flushed before control is
+    // returned to the actor, so the agent cannot have disappeared in
+    // between. Be defensive regardless: the agent retries updates
+    // that are not acknowledged.
+    if (slave == nullptr || !slave->connected) {
+      LOG(WARNING) << "Dropping " << batched.acknowledgements_size()
+                   << " buffered status update acknowledgements for agent "
+                   << batched.slave_id() << " because the agent is "
+                   << (slave == nullptr ? "not registered" : "disconnected");
+      continue;
+    }
+
+    // Send a single acknowledgement in the plain message format: it
+    // is understood by all agents and keeps the common case identical
+    // to the unbatched protocol.
+    if (!slave->capabilities.batchedStatusUpdateAcknowledgements ||
+        batched.acknowledgements_size() == 1) {
+      foreach (const StatusUpdateAcknowledgementMessage& message,
+               batched.acknowledgements()) {
+        send(slave->pid, message);
+      }
+    } else {
+      send(slave->pid, batched);
+    }
+  }
+
+  pendingStatusUpdateAcknowledgements.clear();
+}
+
+
 void Master::acknowledgeOperationStatus(
     Framework* framework,
     scheduler::Call::AcknowledgeOperationStatus&& acknowledge)
@@ -7011,17 +7324,6 @@ void Master::reregisterSlave(
     return;
   }
 
-  Option<Error> error =
-    validation::master::message::reregisterSlave(reregisterSlaveMessage);
-
-  if (error.isSome()) {
-    LOG(WARNING) << "Dropping re-registration of agent at " << from
-                 << " because it sent an invalid re-registration: "
-                 << error->message;
-
-    return;
-  }
-
   LOG(INFO) << "Received reregister agent message from agent "
             << slaveInfo.id() << " at " << from << " ("
             << slaveInfo.hostname() << ")";
@@ -7030,32 +7332,67 @@ void Master::reregisterSlave(
   // and `erase()` in its destructor, to avoid the manual bookkeeping.
   slaves.reregistering.insert(slaveInfo.id());
 
-  // Update all resources passed by the agent to `POST_RESERVATION_REFINEMENT`
-  // format. We do this as early as possible so that we only use a single
-  // format inside master, and downgrade again if necessary when they leave the
-  // master (e.g. when writing to the registry).
-  upgradeResources(&reregisterSlaveMessage);
-
   // Note that the principal may be empty if authentication is not
   // required. Also it is passed along because it may be removed from
-  // `authenticated` while the authorization is pending.
+  // `authenticated` while the re-registration is in progress.
   Option<Principal> principal = authenticated.contains(from)
       ? Principal(authenticated.at(from))
       : Option<Principal>::none();
 
-  // Calling the `onAny` continuation below separately so we can move
-  // `reregisterSlaveMessage` without it being evaluated before it's used
-  // by `authorizeSlave`.
-  Future<bool> authorization =
-    authorizeSlave(reregisterSlaveMessage.slave(), principal);
+  // Validating the message and upgrading the resources it contains to
+  // `POST_RESERVATION_REFINEMENT` format scales with the number of tasks
+  // and executors on the agent, but does not depend on master state.
+  // Perform this work on a worker thread so that an agent
+  // re-registration storm after a master failover does not monopolize
+  // the master actor. The message is shared with the worker thread via
+  // `Owned` to avoid copying it back and forth.
+  //
+  // Note that we upgrade the resources as early as possible so that we
+  // only use a single format inside master, and downgrade again if
+  // necessary when they leave the master (e.g. when writing to the
+  // registry).
+  Owned<ReregisterSlaveMessage> message(
+      new ReregisterSlaveMessage(std::move(reregisterSlaveMessage)));
 
-  authorization
-    .onAny(defer(self(),
-                 &Self::_reregisterSlave,
-                 from,
-                 std::move(reregisterSlaveMessage),
-                 principal,
-                 lambda::_1));
+  process::async([message]() {
+    Option<Error> error =
+      validation::master::message::reregisterSlave(*message);
+
+    if (error.isNone()) {
+      upgradeResources(message.get());
+    }
+
+    return error;
+  })
+  .onAny(defer(
+      self(),
+      [this, from, principal, message](const Future<Option<Error>>& error) {
+        CHECK_READY(error);
+
+        const SlaveInfo& slaveInfo = message->slave();
+
+        if (error->isSome()) {
+          LOG(WARNING) << "Dropping re-registration of agent at " << from
+                       << " because it sent an invalid re-registration: "
+                       << error->get().message;
+
+          slaves.reregistering.erase(slaveInfo.id());
+          return;
+        }
+
+        // Calling the `onAny` continuation below separately so we can
+        // move the message without it being evaluated before it's used
+        // by `authorizeSlave`.
+        Future<bool> authorization = authorizeSlave(slaveInfo, principal);
+
+        authorization
+          .onAny(defer(self(),
+                       &Self::_reregisterSlave,
+                       from,
+                       std::move(*message),
+                       principal,
+                       lambda::_1));
+      }));
 }
 
 
@@ -7688,6 +8025,8 @@ void Master::___reregisterSlave(
 
     slave->active = true;
     allocator->activateSlave(slave->id);
+
+    ++stateVersions.agents;
   }
 
   CHECK(slave->active)
@@ -8008,6 +8347,10 @@ void Master::updateSlave(UpdateSlaveMessage&& message)
     return;
   }
 
+  // There is no operator API event for agent resource updates, so
+  // bump the agent state version here.
+  ++stateVersions.agents;
+
   // Check invariants of the received update.
   {
     foreach (
@@ -8325,6 +8668,20 @@ void Master::updateUnavailability(
     const MachineID& machineId,
     const Option<Unavailability>& unavailability)
 {
+  // Skip the update if the unavailability is unchanged: there is
+  // nothing to update in the allocator, and rescinding offers would
+  // needlessly churn (inverse) offers for every machine in a
+  // mostly-unchanged maintenance schedule.
+  if (machines.contains(machineId)) {
+    const MachineInfo& info = machines[machineId].info;
+
+    if (unavailability.isSome() == info.has_unavailability() &&
+        (unavailability.isNone() ||
+         unavailability.get() == info.unavailability())) {
+      return;
+    }
+  }
+
   if (unavailability.isSome()) {
     machines[machineId].info.mutable_unavailability()->CopyFrom(
         unavailability.get());
@@ -8332,8 +8689,6 @@ void Master::updateUnavailability(
     machines[machineId].info.clear_unavailability();
   }
 
-  // TODO(jmlvanre): Only update allocator and rescind offers if the
-  // unavailability has actually changed.
   if (machines.contains(machineId)) {
     // For every slave on this machine, update the allocator.
     foreach (const SlaveID& slaveId, machines[machineId].slaves) {
@@ -8404,6 +8759,12 @@ void Master::statusUpdate(StatusUpdateMessage&& statusUpdateMessage)
 
   ++metrics->messages_status_update;
 
+  MESOS_TRACEPOINT3(
+      master_status_update,
+      update.framework_id().value().c_str(),
+      update.status().task_id().value().c_str(),
+      update.status().state());
+
   if (slaves.removed.get(update.slave_id()).isSome()) {
     // If the slave has been removed, drop the status update. The
     // master is no longer trying to health check this slave; when the
@@ -9460,7 +9821,6 @@ void Master::offer(
       offer->mutable_slave_id()->MergeFrom(slave->id);
       offer->set_hostname(slave->info.hostname());
       offer->mutable_url()->MergeFrom(url);
-      offer->mutable_resources()->MergeFrom(offered);
       offer->mutable_attributes()->MergeFrom(slave->info.attributes());
       offer->mutable_allocation_info()->set_role(role);
 
@@ -9485,11 +9845,44 @@ void Master::offer(
             machines[slave->machineId].info.unavailability());
       }
 
+      // Copy the offer for the outgoing message before filling in the
+      // resources, so that we don't copy every resource only to strip
+      // some of them out again below.
+      //
+      // TODO(jieyu): For now, we strip 'ephemeral_ports' resource from
+      // offers so that frameworks do not see this resource. This is a
+      // short term workaround. Revisit this once we resolve MESOS-1654.
+      Offer offer_ = *offer;
+
+      foreach (const Resource& resource, offered) {
+        // NOTE: We add the resources directly rather than merging in
+        // the repeated field conversion of `offered`, which would
+        // copy every resource twice.
+        offer->add_resources()->CopyFrom(resource);
+
+        if (resource.name() != "ephemeral_ports") {
+          offer_.add_resources()->CopyFrom(resource);
+        }
+      }
+
       offers[offer->id()] = offer;
+      offerTimestamps[offer->id()] = Clock::now();
+
+      // If resources were previously recovered from this agent, the
+      // cycle back to an offer completes here.
+      if (reofferTimestamps.contains(slaveId)) {
+        metrics->time_to_reoffer.update(
+            Milliseconds(Clock::now() - reofferTimestamps.at(slaveId)));
+        reofferTimestamps.erase(slaveId);
+      }
 
       framework->addOffer(offer);
       slave->addOffer(offer);
 
+      // Offers are visible in the framework sections of '/state' but
+      // produce no operator API event, so bump the version here.
+      ++stateVersions.frameworks;
+
       if (flags.offer_timeout.isSome()) {
         // Rescind the offer after the timeout elapses.
         offerTimers[offer->id()] =
@@ -9499,18 +9892,6 @@ void Master::offer(
                 offer->id());
       }
 
-      // TODO(jieyu): For now, we strip 'ephemeral_ports' resource from
-      // offers so that frameworks do not see this resource. This is a
-      // short term workaround. Revisit this once we resolve MESOS-1654.
-      Offer offer_ = *offer;
-      offer_.clear_resources();
-
-      foreach (const Resource& resource, offered) {
-        if (resource.name() != "ephemeral_ports") {
-          offer_.add_resources()->CopyFrom(resource);
-        }
-      }
-
       // Per MESOS-8237, it is problematic to show the
       // `Resource.allocation_info` for pre-MULTI_ROLE schedulers.
       // Pre-MULTI_ROLE schedulers are not `AllocationInfo` aware,
@@ -9553,6 +9934,12 @@ void Master::offer(
   LOG(INFO) << "Sending offers " << offerIds << " to framework " << *framework;
 
   framework->metrics.offers_sent += message.offers().size();
+
+  MESOS_TRACEPOINT2(
+      master_offer,
+      frameworkId.value().c_str(),
+      message.offers().size());
+
   framework->send(message);
 }
 
@@ -10103,6 +10490,8 @@ Try<Nothing> Master::activateRecoveredFramework(
   framework->setFrameworkState(Framework::State::ACTIVE);
   allocator->activateFramework(framework->id());
 
+  ++stateVersions.frameworks;
+
   // Export framework metrics if a principal is specified in `FrameworkInfo`.
   Option<string> principal = framework->info.has_principal()
     ? Option<string>(framework->info.principal())
@@ -10252,6 +10641,8 @@ void Master::_failoverFramework(Framework* framework)
   if (!framework->active()) {
     framework->setFrameworkState(Framework::State::ACTIVE);
     allocator->activateFramework(framework->id());
+
+    ++stateVersions.frameworks;
   }
 
   // The scheduler driver safely ignores any duplicate registration
@@ -10275,10 +10666,41 @@ void Master::teardown(Framework* framework)
 }
 
 
+void Master::archiveCompleted(const Archive::Framework& record)
+{
+  if (completedArchive.isNone()) {
+    return;
+  }
+
+  // Length-prefix the serialized record so that the archive can be
+  // decoded with `::recordio`.
+  ::recordio::Encoder<Archive::Framework> encoder(
+      [](const Archive::Framework& record) {
+        return record.SerializeAsString();
+      });
+
+  Try<Nothing> write = os::write(completedArchive.get(), encoder.encode(record));
+
+  if (write.isError()) {
+    LOG(ERROR) << "Failed to write to the completed archive: " << write.error()
+               << "; no further records will be archived";
+
+    os::close(completedArchive.get());
+    completedArchive = None();
+  }
+}
+
+
 void Master::removeFramework(Framework* framework)
 {
   CHECK_NOTNULL(framework);
 
+  if (frameworks.tearingDown.contains(framework->id())) {
+    LOG(INFO) << "Ignoring removal of framework " << *framework
+              << " because its teardown is already in progress";
+    return;
+  }
+
   LOG(INFO) << "Removing framework " << *framework;
 
   if (framework->active()) {
@@ -10305,98 +10727,184 @@ void Master::removeFramework(Framework* framework)
   // Remove the pending tasks from the framework.
   framework->pendingTasks.clear();
 
+  // Remove the framework's tasks, unreachable tasks and executors in
+  // batches that are interleaved with normal event processing, so
+  // that tearing down a framework with a very large number of tasks
+  // does not stall the master. The framework was deactivated above
+  // and is thus already hidden from offers; resubscription is
+  // rejected until the teardown completes.
+  frameworks.tearingDown.insert(framework->id());
+
+  _removeFramework(framework->id());
+}
+
+
+void Master::_removeFramework(const FrameworkID& frameworkId)
+{
+  // The master is the only actor that removes frameworks and the
+  // framework remains registered until its teardown completes, so it
+  // must still be present.
+  CHECK(frameworks.tearingDown.contains(frameworkId));
+
+  Framework* framework = getFramework(frameworkId);
+  CHECK_NOTNULL(framework);
+
   // Remove pointers to the framework's tasks in slaves and mark those
   // tasks as completed.
-  foreachvalue (Task* task, utils::copy(framework->tasks)) {
-    Slave* slave = slaves.registered.get(task->slave_id());
+  if (!framework->tasks.empty()) {
+    vector<Task*> batch;
+    batch.reserve(std::min(framework->tasks.size(), TEARDOWN_BATCH_SIZE));
 
-    // Since we only find out about tasks when the slave reregisters,
-    // it must be the case that the slave exists!
-    CHECK(slave != nullptr)
-      << "Unknown agent " << task->slave_id()
-      << " for task " << task->task_id();
-
-    // The task is implicitly killed, and TASK_KILLED is the closest
-    // state we have by now. We mark the task and remove it, without
-    // sending the update. However, a task may finish during the
-    // executor graceful shutdown period. By marking such task as
-    // killed and moving it to completed, we lose the opportunity to
-    // collect the possible finished status. We tolerate this,
-    // because we expect that if the framework has been asked to shut
-    // down, its user is not interested in results anymore.
-    //
-    // TODO(alex): Consider a more descriptive state, e.g. TASK_ABANDONED.
-    //
-    // TODO(neilc): Marking the task KILLED before it has actually
-    // terminated is misleading. Instead, we should consider leaving
-    // the task in its current state at the master; if/when the agent
-    // shuts down the framework, we should arrange for a terminal
-    // status update to be delivered to the master and update the
-    // state of the task at that time (MESOS-6608).
-    const StatusUpdate& update = protobuf::createStatusUpdate(
-        task->framework_id(),
-        task->slave_id(),
-        task->task_id(),
-        TASK_KILLED,
-        TaskStatus::SOURCE_MASTER,
-        None(),
-        "Framework " + framework->id().value() + " removed",
-        TaskStatus::REASON_FRAMEWORK_REMOVED,
-        (task->has_executor_id()
-         ? Option<ExecutorID>(task->executor_id())
-         : None()));
+    foreachvalue (Task* task, framework->tasks) {
+      batch.push_back(task);
+      if (batch.size() == TEARDOWN_BATCH_SIZE) {
+        break;
+      }
+    }
 
-    updateTask(task, update);
-    removeTask(task);
+    foreach (Task* task, batch) {
+      Slave* slave = slaves.registered.get(task->slave_id());
+
+      // Since we only find out about tasks when the slave reregisters,
+      // it must be the case that the slave exists!
+      CHECK(slave != nullptr)
+        << "Unknown agent " << task->slave_id()
+        << " for task " << task->task_id();
+
+      // The task is implicitly killed, and TASK_KILLED is the closest
+      // state we have by now. We mark the task and remove it, without
+      // sending the update. However, a task may finish during the
+      // executor graceful shutdown period. By marking such task as
+      // killed and moving it to completed, we lose the opportunity to
+      // collect the possible finished status. We tolerate this,
+      // because we expect that if the framework has been asked to shut
+      // down, its user is not interested in results anymore.
+      //
+      // TODO(alex): Consider a more descriptive state, e.g. TASK_ABANDONED.
+      //
+      // TODO(neilc): Marking the task KILLED before it has actually
+      // terminated is misleading. Instead, we should consider leaving
+      // the task in its current state at the master; if/when the agent
+      // shuts down the framework, we should arrange for a terminal
+      // status update to be delivered to the master and update the
+      // state of the task at that time (MESOS-6608).
+      const StatusUpdate& update = protobuf::createStatusUpdate(
+          task->framework_id(),
+          task->slave_id(),
+          task->task_id(),
+          TASK_KILLED,
+          TaskStatus::SOURCE_MASTER,
+          None(),
+          "Framework " + framework->id().value() + " removed",
+          TaskStatus::REASON_FRAMEWORK_REMOVED,
+          (task->has_executor_id()
+           ? Option<ExecutorID>(task->executor_id())
+           : None()));
+
+      updateTask(task, update);
+      removeTask(task);
+    }
+
+    dispatch(self(), &Master::_removeFramework, frameworkId);
+    return;
   }
 
   // Mark the framework's unreachable tasks as completed.
-  foreach (const TaskID& taskId, framework->unreachableTasks.keys()) {
-    const Owned<Task>& task = framework->unreachableTasks.at(taskId);
+  if (!framework->unreachableTasks.empty()) {
+    vector<TaskID> batch;
 
-    // TODO(neilc): Per comment above, using TASK_KILLED here is not
-    // ideal. It would be better to use TASK_UNREACHABLE here and only
-    // transition it to a terminal state when the agent reregisters
-    // and the task is shutdown (MESOS-6608).
-    const StatusUpdate& update = protobuf::createStatusUpdate(
-        task->framework_id(),
-        task->slave_id(),
-        task->task_id(),
-        TASK_KILLED,
-        TaskStatus::SOURCE_MASTER,
-        None(),
-        "Framework " + framework->id().value() + " removed",
-        TaskStatus::REASON_FRAMEWORK_REMOVED,
-        (task->has_executor_id()
-         ? Option<ExecutorID>(task->executor_id())
-         : None()));
+    foreach (const TaskID& taskId, framework->unreachableTasks.keys()) {
+      batch.push_back(taskId);
+      if (batch.size() == TEARDOWN_BATCH_SIZE) {
+        break;
+      }
+    }
 
-    updateTask(task.get(), update);
+    foreach (const TaskID& taskId, batch) {
+      const Owned<Task>& task = framework->unreachableTasks.at(taskId);
 
-    // We don't need to remove the task from the slave, because the
-    // task was removed when the agent was marked unreachable.
-    CHECK(!slaves.registered.contains(task->slave_id()))
-      << "Unreachable task " << task->task_id()
-      << " of framework " << task->framework_id()
-      << " was found on registered agent " << task->slave_id();
+      // TODO(neilc): Per comment above, using TASK_KILLED here is not
+      // ideal. It would be better to use TASK_UNREACHABLE here and only
+      // transition it to a terminal state when the agent reregisters
+      // and the task is shutdown (MESOS-6608).
+      const StatusUpdate& update = protobuf::createStatusUpdate(
+          task->framework_id(),
+          task->slave_id(),
+          task->task_id(),
+          TASK_KILLED,
+          TaskStatus::SOURCE_MASTER,
+          None(),
+          "Framework " + framework->id().value() + " removed",
+          TaskStatus::REASON_FRAMEWORK_REMOVED,
+          (task->has_executor_id()
+           ? Option<ExecutorID>(task->executor_id())
+           : None()));
+
+      updateTask(task.get(), update);
+
+      // We don't need to remove the task from the slave, because the
+      // task was removed when the agent was marked unreachable.
+      CHECK(!slaves.registered.contains(task->slave_id()))
+        << "Unreachable task " << task->task_id()
+        << " of framework " << task->framework_id()
+        << " was found on registered agent " << task->slave_id();
+
+      // Move task from unreachable map to completed map.
+      framework->addCompletedTask(std::move(*task));
+      framework->unreachableTasks.erase(taskId);
+    }
 
-    // Move task from unreachable map to completed map.
-    framework->addCompletedTask(std::move(*task));
-    framework->unreachableTasks.erase(taskId);
+    dispatch(self(), &Master::_removeFramework, frameworkId);
+    return;
   }
 
   // Remove the framework's executors for correct resource accounting.
-  foreachkey (const SlaveID& slaveId, utils::copy(framework->executors)) {
-    Slave* slave = slaves.registered.get(slaveId);
+  if (!framework->executors.empty()) {
+    vector<std::pair<SlaveID, ExecutorID>> batch;
 
-    if (slave != nullptr) {
+    foreachkey (const SlaveID& slaveId, framework->executors) {
       foreachkey (const ExecutorID& executorId,
-                  utils::copy(framework->executors[slaveId])) {
-        removeExecutor(slave, framework->id(), executorId);
+                  framework->executors.at(slaveId)) {
+        batch.push_back(std::make_pair(slaveId, executorId));
+        if (batch.size() == TEARDOWN_BATCH_SIZE) {
+          break;
+        }
+      }
+      if (batch.size() == TEARDOWN_BATCH_SIZE) {
+        break;
+      }
+    }
+
+    typedef std::pair<SlaveID, ExecutorID> SlaveExecutorPair;
+    foreach (const SlaveExecutorPair& executor, batch) {
+      Slave* slave = slaves.registered.get(executor.first);
+
+      if (slave != nullptr) {
+        removeExecutor(slave, frameworkId, executor.second);
+      } else {
+        // The agent is gone (e.g., marked unreachable); drop the
+        // executor from the framework's bookkeeping so that the
+        // teardown can make progress.
+        framework->removeExecutor(executor.first, executor.second);
       }
     }
+
+    dispatch(self(), &Master::_removeFramework, frameworkId);
+    return;
   }
 
+  __removeFramework(framework);
+}
+
+
+void Master::__removeFramework(Framework* framework)
+{
+  CHECK_NOTNULL(framework);
+
+  CHECK(framework->tasks.empty());
+  CHECK(framework->unreachableTasks.empty());
+  CHECK(framework->executors.empty());
+
   foreachvalue (Operation* operation, utils::copy(framework->operations)) {
     framework->removeOperation(operation);
   }
@@ -10437,12 +10945,36 @@ void Master::removeFramework(Framework* framework)
   }
 
   // Remove the framework.
+  frameworks.tearingDown.erase(framework->id());
   frameworks.registered.erase(framework->id());
   allocator->removeFramework(framework->id());
 
+  // Spill the completed framework to the on-disk archive (if enabled)
+  // now, so that it remains available after it is eventually evicted
+  // from the bounded in-memory cache of completed frameworks. Note
+  // that tasks evicted from `completedTasks` earlier have already
+  // been archived individually.
+  if (completedArchive.isSome()) {
+    Archive::Framework record;
+    record.mutable_framework_info()->CopyFrom(framework->info);
+    if (framework->pid.isSome()) {
+      record.set_pid(string(framework->pid.get()));
+    }
+    foreach (const Owned<Task>& task, framework->completedTasks) {
+      record.add_tasks()->CopyFrom(*task);
+    }
+
+    archiveCompleted(record);
+  }
+
   // The framework pointer is now owned by `frameworks.completed`.
   frameworks.completed.set(framework->id(), Owned<Framework>(framework));
 
+  // A removal takes the framework's tasks and executors with it, so
+  // bump the task version as well.
+  ++stateVersions.frameworks;
+  ++stateVersions.tasks;
+
   if (!subscribers.subscribed.empty()) {
     subscribers.send(
         protobuf::master::event::createFrameworkRemoved(framework->info));
@@ -10614,6 +11146,8 @@ void Master::addSlave(
       slave->totalResources,
       slave->usedResources);
 
+  ++stateVersions.agents;
+
   if (!subscribers.subscribed.empty()) {
     subscribers.send(protobuf::master::event::createAgentAdded(*slave));
   }
@@ -10793,6 +11327,11 @@ void Master::_removeSlave(
 
   sendSlaveLost(slave->info);
 
+  // A removal takes the agent's tasks and executors with it, so bump
+  // the task version as well.
+  ++stateVersions.agents;
+  ++stateVersions.tasks;
+
   if (!subscribers.subscribed.empty()) {
     subscribers.send(protobuf::master::event::createAgentRemoved(slave->id));
   }
@@ -10896,6 +11435,10 @@ void Master::__removeSlave(
     removeInverseOffer(inverseOffer, true); // Rescind!
   }
 
+  // This agent's resources will never be offered again, so drop the
+  // re-offer timestamp (re-)set while removing its offers above.
+  reofferTimestamps.erase(slave->id);
+
   // Mark the slave as being removed.
   slaves.registered.remove(slave);
   slaves.removed.put(slave->id, Nothing());
@@ -11000,6 +11543,10 @@ void Master::updateTask(Task* task, const StatusUpdate& update)
   // MESOS-1746.
   task->mutable_statuses(task->statuses_size() - 1)->clear_data();
 
+  if (sendSubscribersUpdate) {
+    ++stateVersions.tasks;
+  }
+
   if (sendSubscribersUpdate && !subscribers.subscribed.empty()) {
     // If the framework has been removed, the task would have already
     // transitioned to `TASK_KILLED` by `removeFramework()`, thus
@@ -11156,6 +11703,11 @@ void Master::removeExecutor(
   }
 
   slave->removeExecutor(frameworkId, executorId);
+
+  // No operator API event is sent for an executor exiting on its own
+  // (i.e., without a task status update), so invalidate the cached
+  // executors here; they are versioned together with tasks.
+  ++stateVersions.tasks;
 }
 
 
@@ -11533,6 +12085,24 @@ void Master::removeOffer(Offer* offer, bool rescind)
 
   slave->removeOffer(offer);
 
+  if (offerTimestamps.contains(offer->id())) {
+    const Milliseconds turnaround(
+        Clock::now() - offerTimestamps.at(offer->id()));
+
+    metrics->offer_turnaround.update(turnaround);
+    framework->metrics.offer_turnaround.update(turnaround);
+
+    offerTimestamps.erase(offer->id());
+  }
+
+  // The removed offer's resources head back to the allocator (or into
+  // running tasks); either way the clock for re-offering this agent's
+  // resources starts now. Only stamp the first recovery so that a
+  // string of removed offers doesn't keep resetting it.
+  if (!reofferTimestamps.contains(offer->slave_id())) {
+    reofferTimestamps[offer->slave_id()] = Clock::now();
+  }
+
   if (rescind) {
     RescindResourceOfferMessage message;
     message.mutable_offer_id()->MergeFrom(offer->id());
@@ -11551,6 +12121,8 @@ void Master::removeOffer(Offer* offer, bool rescind)
   LOG(INFO) << "Removing offer " << offer->id();
   offers.erase(offer->id());
   delete offer;
+
+  ++stateVersions.frameworks;
 }
 
 
@@ -11775,6 +12347,27 @@ double Master::_frameworks_inactive()
 }
 
 
+double Master::_teardown_backlog()
+{
+  double backlog = 0.0;
+
+  foreach (const FrameworkID& frameworkId, frameworks.tearingDown) {
+    Framework* framework = getFramework(frameworkId);
+    CHECK_NOTNULL(framework);
+
+    backlog += framework->tasks.size();
+    backlog += framework->unreachableTasks.size();
+
+    typedef hashmap<ExecutorID, ExecutorInfo> Executors;
+    foreachvalue (const Executors& executors, framework->executors) {
+      backlog += executors.size();
+    }
+  }
+
+  return backlog;
+}
+
+
 double Master::_tasks_staging()
 {
   double count = 0.0;
@@ -11984,10 +12577,41 @@ void Master::Subscribers::send(
   VLOG(1) << "Notifying all active subscribers about " << event.type()
           << " event";
 
+  // NOTE: The state versions are bumped at the mutation sites rather
+  // than here: every caller is guarded by a check that some subscriber
+  // exists, so bumping here would leave the cached serialized responses
+  // served by `Http::getState()` stale on masters without any event
+  // subscribers.
+
+  // Disconnect subscribers that are consuming the event stream too
+  // slowly, rather than buffering events for them unboundedly.
+  vector<id::UUID> slow;
+  foreachvalue (const Owned<Subscriber>& subscriber, subscribed) {
+    size_t backlog = subscriber->http.writer.outstanding();
+    if (backlog > MAX_SUBSCRIBER_EVENT_BACKLOG.bytes()) {
+      LOG(WARNING) << "Disconnecting subscriber " << subscriber->http.streamId
+                   << " because it has " << Bytes(backlog)
+                   << " of unconsumed events, which exceeds the maximum"
+                   << " of " << MAX_SUBSCRIBER_EVENT_BACKLOG;
+      slow.push_back(subscriber->http.streamId);
+    }
+  }
+
+  foreach (const id::UUID& id, slow) {
+    subscribed.erase(id);
+  }
+
   // Create a single copy of the event for all subscribers to share.
   Shared<mesos::master::Event> sharedEvent(
       new mesos::master::Event(std::move(event)));
 
+  // Events that are sent unmodified are serialized at most once per
+  // content type and the encoded bytes are shared by all subscribers,
+  // rather than serializing the event again for each of them.
+  Owned<EventStreamEncoder<mesos::master::Event, v1::master::Event>> encoder(
+      new EventStreamEncoder<mesos::master::Event, v1::master::Event>(
+          sharedEvent));
+
   // Create a single copy of `FrameworkInfo` and `Task` for all
   // subscribers to share.
   Shared<FrameworkInfo> sharedFrameworkInfo(
@@ -12007,7 +12631,8 @@ void Master::Subscribers::send(
                 sharedEvent,
                 approvers,
                 sharedFrameworkInfo,
-                sharedTask);
+                sharedTask,
+                encoder);
 
             return Nothing();
           }));
@@ -12019,8 +12644,19 @@ void Master::Subscribers::Subscriber::send(
     const Shared<mesos::master::Event>& event,
     const Owned<ObjectApprovers>& approvers,
     const Shared<FrameworkInfo>& frameworkInfo,
-    const Shared<Task>& task)
-{
+    const Shared<Task>& task,
+    const Owned<EventStreamEncoder<mesos::master::Event, v1::master::Event>>&
+      encoder)
+{
+  // Returns the event encoded for this subscriber's content type,
+  // serializing it only if no earlier subscriber used the same
+  // content type. Only used for events that are sent unmodified;
+  // events that are rewritten per subscriber based on authorization
+  // cannot share their encoding.
+  auto encoded = [this, &encoder]() -> const string& {
+    return encoder->encode(http.contentType);
+  };
+
   switch (event->type()) {
     case mesos::master::Event::TASK_ADDED: {
       CHECK_NOTNULL(frameworkInfo.get());
@@ -12028,7 +12664,7 @@ void Master::Subscribers::Subscriber::send(
       if (approvers->approved<VIEW_TASK>(
               event->task_added().task(), *frameworkInfo) &&
           approvers->approved<VIEW_FRAMEWORK>(*frameworkInfo)) {
-        http.send<mesos::master::Event, v1::master::Event>(*event);
+        http.send(encoded());
       }
       break;
     }
@@ -12038,7 +12674,7 @@ void Master::Subscribers::Subscriber::send(
 
       if (approvers->approved<VIEW_TASK>(*task, *frameworkInfo) &&
           approvers->approved<VIEW_FRAMEWORK>(*frameworkInfo)) {
-        http.send<mesos::master::Event, v1::master::Event>(*event);
+        http.send(encoded());
       }
       break;
     }
@@ -12107,7 +12743,7 @@ void Master::Subscribers::Subscriber::send(
     case mesos::master::Event::FRAMEWORK_REMOVED: {
       if (approvers->approved<VIEW_FRAMEWORK>(
               event->framework_removed().framework_info())) {
-        http.send<mesos::master::Event, v1::master::Event>(*event);
+        http.send(encoded());
       }
       break;
     }
@@ -12132,7 +12768,7 @@ void Master::Subscribers::Subscriber::send(
     case mesos::master::Event::SUBSCRIBED:
     case mesos::master::Event::HEARTBEAT:
     case mesos::master::Event::UNKNOWN:
-      http.send<mesos::master::Event, v1::master::Event>(*event);
+      http.send(encoded());
       break;
   }
 }
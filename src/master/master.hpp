@@ -64,6 +64,7 @@
 
 #include <stout/boundedhashmap.hpp>
 #include <stout/cache.hpp>
+#include <stout/cowhashmap.hpp>
 #include <stout/foreach.hpp>
 #include <stout/hashmap.hpp>
 #include <stout/hashset.hpp>
@@ -72,10 +73,13 @@
 #include <stout/nothing.hpp>
 #include <stout/option.hpp>
 #include <stout/recordio.hpp>
+#include <stout/os/int_fd.hpp>
 #include <stout/try.hpp>
 #include <stout/uuid.hpp>
 
+#include "common/event_stream.hpp"
 #include "common/http.hpp"
+#include "common/recordio.hpp"
 #include "common/resources_utils.hpp"
 
 #include "files/files.hpp"
@@ -358,6 +362,14 @@ struct HttpConnection
     return writer.write(encoder.encode(evolve(message)));
   }
 
+  // Sends bytes that have already been encoded for this connection's
+  // content type. This allows the encoding of an event to be shared
+  // across connections rather than repeated for each of them.
+  bool send(const std::string& encoded)
+  {
+    return writer.write(std::string(encoded));
+  }
+
   bool close()
   {
     return writer.close();
@@ -368,7 +380,9 @@ struct HttpConnection
     return writer.readerClosed();
   }
 
-  process::http::Pipe::Writer writer;
+  // Coalescing writer so that bursts of events result in a single
+  // chunked-encoding write on the response rather than one per event.
+  recordio::Writer writer;
   ContentType contentType;
   id::UUID streamId;
 };
@@ -591,6 +605,12 @@ public:
   // Made public for testing purposes.
   process::Future<Nothing> _recover(const Registry& registry);
 
+  // Removes one batch of the framework's tasks, unreachable tasks
+  // and executors, re-dispatching to itself while entities remain
+  // and completing the removal via `__removeFramework()` otherwise.
+  // Made public for testing purposes.
+  void _removeFramework(const FrameworkID& frameworkId);
+
   MasterInfo info() const
   {
     return info_;
@@ -620,6 +640,9 @@ protected:
   void throttled(
       process::MessageEvent&& event,
       const Option<std::string>& principal);
+  void throttled(
+      process::ExitedEvent&& event,
+      const Option<std::string>& principal);
 
   // Continuations of consume().
   void _consume(process::MessageEvent&& event);
@@ -634,7 +657,13 @@ protected:
 
   // Recovers state from the registrar.
   process::Future<Nothing> recover();
-  void recoveredSlavesTimeout(const Registry& registry);
+
+  // Marks agents that did not reregister within the reregistration
+  // timeout as unreachable. `totalRecoveredAgents` is the number of
+  // agents that were recovered from the registry; we don't retain the
+  // registry itself to avoid holding a (potentially very large) copy
+  // for the duration of the timeout.
+  void recoveredSlavesTimeout(size_t totalRecoveredAgents);
 
   void _registerSlave(
       const process::UPID& pid,
@@ -725,13 +754,26 @@ protected:
   void _failoverFramework(Framework* framework);
 
   // Kill all of a framework's tasks, delete the framework object, and
-  // reschedule offers that were assigned to this framework.
+  // reschedule offers that were assigned to this framework. The
+  // framework is deactivated immediately, but its tasks, unreachable
+  // tasks and executors are removed incrementally in batches of
+  // `TEARDOWN_BATCH_SIZE`, interleaved with normal event processing.
   void removeFramework(Framework* framework);
 
+  // Completes the removal of a framework whose tasks and executors
+  // have already been removed.
+  void __removeFramework(Framework* framework);
+
   // Remove a framework from the slave, i.e., remove its tasks and
   // executors and recover the resources.
   void removeFramework(Slave* slave, Framework* framework);
 
+  // Appends the given record to the on-disk archive of completed
+  // tasks and frameworks, if archiving is enabled (see the
+  // `--completed_archive_dir` flag). A failure to write to the
+  // archive disables further archiving.
+  void archiveCompleted(const Archive::Framework& record);
+
   void updateFramework(
       Framework* framework,
       const FrameworkInfo& frameworkInfo,
@@ -1149,6 +1191,12 @@ private:
       Framework* framework,
       scheduler::Call::Acknowledge&& acknowledge);
 
+  // Sends the status update acknowledgements buffered by
+  // `acknowledge()`, coalescing the acknowledgements destined for the
+  // same agent into a single message. Callers must flush after each
+  // processed call; acknowledgements are never buffered across calls.
+  void flushStatusUpdateAcknowledgements();
+
   void acknowledgeOperationStatus(
       Framework* framework,
       scheduler::Call::AcknowledgeOperationStatus&& acknowledge);
@@ -1432,15 +1480,21 @@ private:
             principal) const;
 
     // /master/frameworks
+    //
+    // NOTE: Requests to this endpoint are batched.
     process::Future<process::http::Response> frameworks(
         const process::http::Request& request,
         const Option<process::http::authentication::Principal>&
-            principal) const;
+            principal);
 
     // /master/health
     process::Future<process::http::Response> health(
         const process::http::Request& request) const;
 
+    // /master/messages
+    process::Future<process::http::Response> messages(
+        const process::http::Request& request) const;
+
     // /master/redirect
     process::Future<process::http::Response> redirect(
         const process::http::Request& request) const;
@@ -1464,10 +1518,12 @@ private:
             principal) const;
 
     // /master/slaves
+    //
+    // NOTE: Requests to this endpoint are batched.
     process::Future<process::http::Response> slaves(
         const process::http::Request& request,
         const Option<process::http::authentication::Principal>&
-            principal) const;
+            principal);
 
     // /master/state
     //
@@ -1481,13 +1537,15 @@ private:
     process::Future<process::http::Response> stateSummary(
         const process::http::Request& request,
         const Option<process::http::authentication::Principal>&
-            principal) const;
+            principal);
 
     // /master/tasks
+    //
+    // NOTE: Requests to this endpoint are batched.
     process::Future<process::http::Response> tasks(
         const process::http::Request& request,
         const Option<process::http::authentication::Principal>&
-            principal) const;
+            principal);
 
     // /master/maintenance/schedule
     process::Future<process::http::Response> maintenanceSchedule(
@@ -1536,6 +1594,7 @@ private:
     static std::string FLAGS_HELP();
     static std::string FRAMEWORKS_HELP();
     static std::string HEALTH_HELP();
+    static std::string MESSAGES_HELP();
     static std::string REDIRECT_HELP();
     static std::string ROLES_HELP();
     static std::string TEARDOWN_HELP();
@@ -1563,16 +1622,63 @@ private:
         const Option<process::http::authentication::Principal>&
             principal) const;
 
-    // A continuation for `state()`. Schedules request processing in a batch
-    // of other '/state' requests.
-    process::Future<process::http::Response> deferStateRequest(
+    // Identifies which heavy read-only endpoint a batched request is
+    // for. Responses can only be shared between requests for the same
+    // endpoint, hence this also serves as a deduplication key (see
+    // `processRequestsBatch()`).
+    enum class ReadOnlyRequestHandler
+    {
+      FRAMEWORKS,
+      SLAVES,
+      STATE,
+      STATE_SUMMARY,
+      TASKS
+    };
+
+    // A continuation for heavy read-only endpoints (e.g., `state()`).
+    // Schedules request processing in a batch of other read-only requests.
+    process::Future<process::http::Response> deferBatchedRequest(
+        ReadOnlyRequestHandler handler,
         const process::http::Request& request,
+        const Option<process::http::authentication::Principal>& principal,
         const process::Owned<ObjectApprovers>& approvers);
 
-    // A helper that responds to batched, i.e., accumulated, '/state'
-    // requests in parallel, i.e., a continuation for `deferStateRequest()`.
-    // See also `BatchedStateRequest`.
-    void processStateRequestsBatch();
+    // A helper that responds to batched, i.e., accumulated, read-only
+    // requests in parallel, i.e., a continuation for
+    // `deferBatchedRequest()`. See also `BatchedRequest`.
+    void processRequestsBatch();
+
+    // Serializes the response for a single batched '/state' request;
+    // executed on a worker thread while the master actor is blocked in
+    // `processRequestsBatch()`.
+    process::http::Response processStateRequest(
+        const process::http::Request& request,
+        const process::Owned<ObjectApprovers>& approvers) const;
+
+    // Ditto for a single batched '/state-summary' request.
+    process::http::Response processStateSummaryRequest(
+        const process::http::Request& request,
+        const process::Owned<ObjectApprovers>& approvers) const;
+
+    // Ditto for a single batched '/frameworks' request. When a
+    // specific framework is requested with the completed archive
+    // enabled, the request bypasses the batch and the records read
+    // from the archive are passed in `archived` (see `frameworks()`).
+    process::http::Response processFrameworksRequest(
+        const process::http::Request& request,
+        const process::Owned<ObjectApprovers>& approvers,
+        const std::vector<Archive::Framework>& archived =
+          std::vector<Archive::Framework>()) const;
+
+    // Ditto for a single batched '/slaves' request.
+    process::http::Response processSlavesRequest(
+        const process::http::Request& request,
+        const process::Owned<ObjectApprovers>& approvers) const;
+
+    // Ditto for a single batched '/tasks' request.
+    process::http::Response processTasksRequest(
+        const process::http::Request& request,
+        const process::Owned<ObjectApprovers>& approvers) const;
 
     process::Future<std::vector<const Task*>> _tasks(
         const size_t limit,
@@ -1759,7 +1865,8 @@ private:
         ContentType contentType) const;
 
     mesos::master::Response::GetTasks _getTasks(
-        const process::Owned<ObjectApprovers>& approvers) const;
+        const process::Owned<ObjectApprovers>& approvers,
+        const Option<mesos::master::Call::GetTasks>& options = None()) const;
 
     process::Future<process::http::Response> createVolumes(
         const mesos::master::Call& call,
@@ -1815,6 +1922,48 @@ private:
     mesos::master::Response::GetState _getState(
         const process::Owned<ObjectApprovers>& approvers) const;
 
+    // Serialized `GET_STATE` responses cached across requests, tagged
+    // with the state versions (see `Master::stateVersions`) they were
+    // built from. Only consulted when no authorizer is configured,
+    // since then every client is shown the same state.
+    //
+    // For protobuf responses each top-level section is cached as an
+    // independently serialized fragment: since protobuf parsers merge
+    // repeated occurrences of an embedded message field, concatenating
+    // the fragments yields a valid serialization of the full response,
+    // and under steady state a `GET_STATE` is mostly a copy of
+    // unchanged fragments. JSON does not concatenate, so the entire
+    // body is cached instead.
+    struct StateCache
+    {
+      struct Fragment
+      {
+        Option<uint64_t> version;
+        std::string serialized;
+      };
+
+      Fragment tasks;
+      Fragment executors; // Shares the tasks version, see `serializeGetState`.
+      Fragment frameworks;
+      Fragment agents;
+
+      // The fully assembled JSON body, along with the versions of all
+      // three sections at the time it was built.
+      Option<std::string> json;
+      uint64_t jsonTasks;
+      uint64_t jsonFrameworks;
+      uint64_t jsonAgents;
+    };
+
+    mutable StateCache stateCache;
+
+    // Returns the serialized `GET_STATE` response, reusing (and
+    // refreshing) `stateCache`. Must only be used when no authorizer
+    // is configured.
+    std::string serializeGetState(
+        const process::Owned<ObjectApprovers>& approvers,
+        ContentType contentType) const;
+
     process::Future<process::http::Response> subscribe(
         const mesos::master::Call& call,
         const Option<process::http::authentication::Principal>& principal,
@@ -1853,16 +2002,19 @@ private:
     // out into this separate class.
     WeightsHandler weightsHandler;
 
-    // TODO(alexr): Consider adding a `type` or `handler` field to expand
-    // batching to other heavy read-only requests, e.g., '/state-summary'.
-    struct BatchedStateRequest
+    // A read-only request which is accumulated for batched processing
+    // together with other read-only requests (see
+    // `deferBatchedRequest()` and `processRequestsBatch()`).
+    struct BatchedRequest
     {
+      ReadOnlyRequestHandler handler;
       process::http::Request request;
+      Option<process::http::authentication::Principal> principal;
       process::Owned<ObjectApprovers> approvers;
       process::Promise<process::http::Response> promise;
     };
 
-    std::vector<BatchedStateRequest> batchedStateRequests;
+    std::vector<BatchedRequest> batchedRequests;
   };
 
   Master(const Master&);              // No copying.
@@ -1897,6 +2049,11 @@ private:
   Registrar* registrar;
   Files* files;
 
+  // Open file descriptor of the on-disk archive of completed tasks
+  // and frameworks, if archiving is enabled and healthy. See the
+  // `--completed_archive_dir` flag.
+  Option<int_fd> completedArchive;
+
   mesos::master::contender::MasterContender* contender;
   mesos::master::detector::MasterDetector* detector;
 
@@ -1979,8 +2136,8 @@ private:
       void put(Slave* slave)
       {
         CHECK_NOTNULL(slave);
-        ids[slave->id] = slave;
-        pids[slave->pid] = slave;
+        ids.put(slave->id, slave);
+        pids.put(slave->pid, slave);
       }
 
       void remove(Slave* slave)
@@ -1998,18 +2155,22 @@ private:
 
       size_t size() const { return ids.size(); }
 
-      typedef hashmap<SlaveID, Slave*>::iterator iterator;
-      typedef hashmap<SlaveID, Slave*>::const_iterator const_iterator;
+      // Returns a point-in-time snapshot of the registered agents
+      // indexed by SlaveID. Since the index is a copy-on-write map,
+      // taking the snapshot is O(1).
+      CowHashMap<SlaveID, Slave*> snapshot() const { return ids; }
 
-      iterator begin() { return ids.begin(); }
-      iterator end()   { return ids.end();   }
+      // NOTE: Iteration is const-only since the copy-on-write map
+      // does not hand out mutable references into its storage.
+      typedef CowHashMap<SlaveID, Slave*>::const_iterator iterator;
+      typedef CowHashMap<SlaveID, Slave*>::const_iterator const_iterator;
 
       const_iterator begin() const { return ids.begin(); }
       const_iterator end()   const { return ids.end();   }
 
     private:
-      hashmap<SlaveID, Slave*> ids;
-      hashmap<process::UPID, Slave*> pids;
+      CowHashMap<SlaveID, Slave*> ids;
+      CowHashMap<process::UPID, Slave*> pids;
     } registered;
 
     // Slaves that are in the process of being removed from the
@@ -2064,6 +2225,13 @@ private:
     Option<std::shared_ptr<process::RateLimiter>> limiter;
   } slaves;
 
+  // Status update acknowledgements buffered per agent while a
+  // scheduler call is being processed, so that the acknowledgements
+  // of a batched call destined for the same agent are coalesced into
+  // a single message. See `flushStatusUpdateAcknowledgements()`.
+  hashmap<SlaveID, BatchedStatusUpdateAcknowledgementsMessage>
+    pendingStatusUpdateAcknowledgements;
+
   struct Frameworks
   {
     Frameworks(const Flags& masterFlags)
@@ -2071,6 +2239,12 @@ private:
 
     hashmap<FrameworkID, Framework*> registered;
 
+    // Frameworks in the process of being incrementally torn down.
+    // They remain in `registered` (deactivated) until the teardown
+    // completes; resubscription is rejected in the interim. See
+    // `Master::removeFramework()`.
+    hashset<FrameworkID> tearingDown;
+
     BoundedHashMap<FrameworkID, process::Owned<Framework>> completed;
 
     // Principals of frameworks keyed by PID.
@@ -2135,7 +2309,10 @@ private:
           const process::Shared<mesos::master::Event>& event,
           const process::Owned<ObjectApprovers>& approvers,
           const process::Shared<FrameworkInfo>& frameworkInfo,
-          const process::Shared<Task>& task);
+          const process::Shared<Task>& task,
+          const process::Owned<
+              EventStreamEncoder<mesos::master::Event, v1::master::Event>>&
+            encoder);
 
       ~Subscriber()
       {
@@ -2170,9 +2347,31 @@ private:
 
   Subscribers subscribers;
 
+  // Monotonic versions of the parts of the master's state exposed via
+  // `GET_STATE` and '/state', bumped alongside the corresponding
+  // operator API events (see `Subscribers::send()`) as well as at
+  // mutations that do not produce an event (offer churn, framework
+  // and agent (de)activations, agent resource updates).
+  // `Http::getState()` uses them to tell whether its cached
+  // serialized responses are still fresh, and '/state' returns them
+  // so that clients polling with the 'since' parameter receive only
+  // the sections that changed in between.
+  struct StateVersions
+  {
+    uint64_t tasks = 0;
+    uint64_t frameworks = 0;
+    uint64_t agents = 0;
+  } stateVersions;
+
   hashmap<OfferID, Offer*> offers;
   hashmap<OfferID, process::Timer> offerTimers;
 
+  // Timestamps for the offer lifecycle metrics: when each outstanding
+  // offer was sent, and when resources were last recovered from an
+  // agent without having been offered again yet.
+  hashmap<OfferID, process::Time> offerTimestamps;
+  hashmap<SlaveID, process::Time> reofferTimestamps;
+
   hashmap<OfferID, InverseOffer*> inverseOffers;
   hashmap<OfferID, process::Timer> inverseOfferTimers;
 
@@ -2235,11 +2434,20 @@ private:
   double _slaves_inactive();
   double _slaves_unreachable();
 
+  double _slaves_reregistering()
+  {
+    return static_cast<double>(slaves.reregistering.size());
+  }
+
   double _frameworks_connected();
   double _frameworks_disconnected();
   double _frameworks_active();
   double _frameworks_inactive();
 
+  // Number of tasks, unreachable tasks and executors still to be
+  // removed by in-progress framework teardowns.
+  double _teardown_backlog();
+
   double _outstanding_offers()
   {
     return static_cast<double>(offers.size());
@@ -2454,7 +2662,11 @@ struct Framework
 
   // TODO(bmahler): Make this private to enforce that `addTask()` and
   // `removeTask()` are used, and provide a const view into the tasks.
-  hashmap<TaskID, Task*> tasks;
+  //
+  // NOTE: This is a copy-on-write map so that point-in-time snapshots
+  // of a framework's tasks (e.g., for building endpoint responses)
+  // are O(1) instead of deep copies.
+  CowHashMap<TaskID, Task*> tasks;
 
   // Tasks launched by this framework that have reached a terminal
   // state and have had all their updates acknowledged. We only keep a
@@ -65,6 +65,9 @@ Metrics::Metrics(const Master& master)
     slaves_unreachable(
         "master/slaves_unreachable",
         defer(master, &Master::_slaves_unreachable)),
+    slaves_reregistering(
+        "master/slaves_reregistering",
+        defer(master, &Master::_slaves_reregistering)),
     frameworks_connected(
         "master/frameworks_connected",
         defer(master, &Master::_frameworks_connected)),
@@ -77,9 +80,18 @@ Metrics::Metrics(const Master& master)
     frameworks_inactive(
         "master/frameworks_inactive",
         defer(master, &Master::_frameworks_inactive)),
+    teardown_backlog(
+        "master/teardown_backlog",
+        defer(master, &Master::_teardown_backlog)),
     outstanding_offers(
         "master/outstanding_offers",
         defer(master, &Master::_outstanding_offers)),
+    offer_turnaround(
+        "master/offer_turnaround",
+        Hours(1)),
+    time_to_reoffer(
+        "master/time_to_reoffer",
+        Hours(1)),
     tasks_staging(
         "master/tasks_staging",
         defer(master, &Master::_tasks_staging)),
@@ -224,13 +236,17 @@ Metrics::Metrics(const Master& master)
   process::metrics::add(slaves_active);
   process::metrics::add(slaves_inactive);
   process::metrics::add(slaves_unreachable);
+  process::metrics::add(slaves_reregistering);
 
   process::metrics::add(frameworks_connected);
   process::metrics::add(frameworks_disconnected);
   process::metrics::add(frameworks_active);
   process::metrics::add(frameworks_inactive);
+  process::metrics::add(teardown_backlog);
 
   process::metrics::add(outstanding_offers);
+  process::metrics::add(offer_turnaround);
+  process::metrics::add(time_to_reoffer);
 
   process::metrics::add(tasks_staging);
   process::metrics::add(tasks_starting);
@@ -375,13 +391,17 @@ Metrics::~Metrics()
   process::metrics::remove(slaves_active);
   process::metrics::remove(slaves_inactive);
   process::metrics::remove(slaves_unreachable);
+  process::metrics::remove(slaves_reregistering);
 
   process::metrics::remove(frameworks_connected);
   process::metrics::remove(frameworks_disconnected);
   process::metrics::remove(frameworks_active);
   process::metrics::remove(frameworks_inactive);
+  process::metrics::remove(teardown_backlog);
 
   process::metrics::remove(outstanding_offers);
+  process::metrics::remove(offer_turnaround);
+  process::metrics::remove(time_to_reoffer);
 
   process::metrics::remove(tasks_staging);
   process::metrics::remove(tasks_starting);
@@ -506,7 +526,8 @@ Metrics::~Metrics()
 
 
 void Metrics::incrementInvalidSchedulerCalls(const scheduler::Call& call) {
-  if (call.type() == scheduler::Call::ACKNOWLEDGE) {
+  if (call.type() == scheduler::Call::ACKNOWLEDGE ||
+      call.type() == scheduler::Call::ACKNOWLEDGE_BATCH) {
     invalid_status_update_acknowledgements++;
   }
 
@@ -568,6 +589,9 @@ FrameworkMetrics::FrameworkMetrics(const FrameworkInfo& _frameworkInfo)
         getFrameworkMetricPrefix(frameworkInfo) + "offers/declined"),
     offers_rescinded(
         getFrameworkMetricPrefix(frameworkInfo) + "offers/rescinded"),
+    offer_turnaround(
+        getFrameworkMetricPrefix(frameworkInfo) + "offers/turnaround",
+        Hours(1)),
     operations(
         getFrameworkMetricPrefix(frameworkInfo) + "operations")
 {
@@ -577,6 +601,7 @@ FrameworkMetrics::FrameworkMetrics(const FrameworkInfo& _frameworkInfo)
   process::metrics::add(offers_accepted);
   process::metrics::add(offers_declined);
   process::metrics::add(offers_rescinded);
+  process::metrics::add(offer_turnaround);
 
   // Add metrics for scheduler calls.
   process::metrics::add(calls);
@@ -691,6 +716,7 @@ FrameworkMetrics::~FrameworkMetrics()
   process::metrics::remove(offers_accepted);
   process::metrics::remove(offers_declined);
   process::metrics::remove(offers_rescinded);
+  process::metrics::remove(offer_turnaround);
 
   foreachvalue (const Counter& counter, terminal_task_states) {
     process::metrics::remove(counter);
@@ -25,8 +25,10 @@
 #include <process/metrics/counter.hpp>
 #include <process/metrics/pull_gauge.hpp>
 #include <process/metrics/push_gauge.hpp>
+#include <process/metrics/timer.hpp>
 #include <process/metrics/metrics.hpp>
 
+#include <stout/duration.hpp>
 #include <stout/hashmap.hpp>
 
 #include "mesos/mesos.hpp"
@@ -52,14 +54,26 @@ struct Metrics
   process::metrics::PullGauge slaves_active;
   process::metrics::PullGauge slaves_inactive;
   process::metrics::PullGauge slaves_unreachable;
+  process::metrics::PullGauge slaves_reregistering;
 
   process::metrics::PullGauge frameworks_connected;
   process::metrics::PullGauge frameworks_disconnected;
   process::metrics::PullGauge frameworks_active;
   process::metrics::PullGauge frameworks_inactive;
 
+  // Number of tasks, unreachable tasks and executors still to be
+  // removed by in-progress framework teardowns.
+  process::metrics::PullGauge teardown_backlog;
+
   process::metrics::PullGauge outstanding_offers;
 
+  // Offer lifecycle timings: the time from an offer being sent to it
+  // being removed (accepted, declined, rescinded or timed out), and
+  // the time from resources being recovered from an agent until that
+  // agent's resources are offered again.
+  process::metrics::Timer<Milliseconds> offer_turnaround;
+  process::metrics::Timer<Milliseconds> time_to_reoffer;
+
   // Task state metrics.
   process::metrics::PullGauge tasks_staging;
   process::metrics::PullGauge tasks_starting;
@@ -107,18 +121,26 @@ struct Metrics
     // requested by this message has finished.
     process::metrics::Counter messages_processed;
 
+    // Framework messages whose processing was delayed because the
+    // principal exceeded its configured rate. Useful to identify
+    // which principal is generating excess load.
+    process::metrics::Counter messages_throttled;
+
     explicit Frameworks(const std::string& principal)
       : messages_received("frameworks/" + principal + "/messages_received"),
-        messages_processed("frameworks/" + principal + "/messages_processed")
+        messages_processed("frameworks/" + principal + "/messages_processed"),
+        messages_throttled("frameworks/" + principal + "/messages_throttled")
     {
       process::metrics::add(messages_received);
       process::metrics::add(messages_processed);
+      process::metrics::add(messages_throttled);
     }
 
     ~Frameworks()
     {
       process::metrics::remove(messages_received);
       process::metrics::remove(messages_processed);
+      process::metrics::remove(messages_throttled);
     }
   };
 
@@ -262,6 +284,9 @@ struct FrameworkMetrics
   process::metrics::Counter offers_declined;
   process::metrics::Counter offers_rescinded;
 
+  // Time from an offer being sent to this framework until its removal.
+  process::metrics::Timer<Milliseconds> offer_turnaround;
+
   hashmap<TaskState, process::metrics::Counter> terminal_task_states;
 
   hashmap<TaskState, process::metrics::PushGauge> active_task_states;
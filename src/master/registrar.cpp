@@ -21,6 +21,7 @@
 
 #include <mesos/state/state.hpp>
 
+#include <process/async.hpp>
 #include <process/defer.hpp>
 #include <process/dispatch.hpp>
 #include <process/future.hpp>
@@ -39,7 +40,6 @@
 #include <stout/nothing.hpp>
 #include <stout/option.hpp>
 #include <stout/protobuf.hpp>
-#include <stout/stopwatch.hpp>
 
 #include "master/registrar.hpp"
 #include "master/registry.hpp"
@@ -148,13 +148,17 @@ private:
             "registrar/registry_size_bytes",
             defer(process, &RegistrarProcess::_registry_size_bytes)),
         state_fetch("registrar/state_fetch"),
-        state_store("registrar/state_store", Days(1))
+        state_store("registrar/state_store", Days(1)),
+        operations_apply("registrar/operations_apply", Days(1)),
+        registry_serialize("registrar/registry_serialize", Days(1))
     {
       process::metrics::add(queued_operations);
       process::metrics::add(registry_size_bytes);
 
       process::metrics::add(state_fetch);
       process::metrics::add(state_store);
+      process::metrics::add(operations_apply);
+      process::metrics::add(registry_serialize);
     }
 
     ~Metrics()
@@ -164,19 +168,33 @@ private:
 
       process::metrics::remove(state_fetch);
       process::metrics::remove(state_store);
+      process::metrics::remove(operations_apply);
+      process::metrics::remove(registry_serialize);
     }
 
     PullGauge queued_operations;
     PullGauge registry_size_bytes;
 
+    // Per-phase timers: applying the operations to the in-memory
+    // registry, serializing the result, and storing it ('state_store'
+    // now covers only the store itself) so that a latency spike can
+    // be attributed to the phase responsible.
     Timer<Milliseconds> state_fetch;
     Timer<Milliseconds> state_store;
+    Timer<Milliseconds> operations_apply;
+    Timer<Milliseconds> registry_serialize;
   } metrics;
 
   // PullGauge handlers.
   double _queued_operations()
   {
-    return static_cast<double>(operations.size());
+    size_t count = operations.size();
+
+    if (prepared.isSome()) {
+      count += prepared->operations.size();
+    }
+
+    return static_cast<double>(count);
   }
 
   Future<double> _registry_size_bytes()
@@ -192,14 +210,21 @@ private:
   void _recover(
       const MasterInfo& info,
       const Future<Variable>& recovery);
-  void __recover(const Future<bool>& recover);
+  void __recover(
+      const MasterInfo& info,
+      const Variable& recovery,
+      const Future<Try<Owned<Registry>>>& deserialized);
+  void ___recover(const Future<bool>& recover);
   Future<bool> _apply(Owned<RegistryOperation> operation);
 
+  // Applies the queued operations to the in-memory registry and
+  // serializes the result, producing the next batch to store.
+  void prepare();
+
   // Helper for updating state (performing store).
   void update();
   void _update(
       const Future<Option<Variable>>& store,
-      const Owned<Registry>& updatedRegistry,
       deque<Owned<RegistryOperation>> operations);
 
   // Fails all pending operations and transitions the Registrar
@@ -222,9 +247,28 @@ private:
   Option<Variable> variable;
   Option<Registry> registry;
 
+  // The 'slaveIDs' accumulator handed to the operations. This is built
+  // once upon recovery and incrementally maintained by the operations
+  // themselves, rather than being rebuilt from the registry (an O(agents)
+  // scan) on every update.
+  hashset<SlaveID> slaveIDs;
+
   deque<Owned<RegistryOperation>> operations;
   bool updating; // Used to signify fetching (recovering) or storing.
 
+  // A batch of operations that has been applied to the in-memory
+  // registry and serialized, but whose store has not yet been issued.
+  // Keeping (at most) one batch prepared while another store is in
+  // flight lets registry mutation and serialization overlap with the
+  // log write instead of alternating with it.
+  struct Batch
+  {
+    string serialized;
+    deque<Owned<RegistryOperation>> operations;
+  };
+
+  Option<Batch> prepared;
+
   const Flags flags;
 
   // Used to compose our operations with recovery.
@@ -369,39 +413,70 @@ void RegistrarProcess::_recover(
     return;
   }
 
-  // Deserialize the registry.
-  Try<Registry> deserialized =
-    ::protobuf::deserialize<Registry>(recovery->value());
-  if (deserialized.isError()) {
+  // Deserialize the registry on a worker thread: parsing a registry
+  // that can be hundreds of MB would otherwise block the registrar
+  // actor (and thus any queued operations) for its duration. The
+  // parsed registry is heap-allocated so that it can be adopted
+  // below without a transient copy.
+  process::async(
+      [](const string& value) -> Try<Owned<Registry>> {
+        Try<Registry> deserialized = ::protobuf::deserialize<Registry>(value);
+        if (deserialized.isError()) {
+          return Error(deserialized.error());
+        }
+
+        // Workaround for immovable protobuf messages.
+        Owned<Registry> registry(new Registry());
+        registry->Swap(&deserialized.get());
+        return registry;
+      },
+      recovery->value())
+    .onAny(defer(self(), &Self::__recover, info, recovery.get(), lambda::_1));
+}
+
+
+void RegistrarProcess::__recover(
+    const MasterInfo& info,
+    const Variable& recovery,
+    const Future<Try<Owned<Registry>>>& deserialized)
+{
+  CHECK(deserialized.isReady()); // `async` futures are never failed.
+
+  if (deserialized->isError()) {
     recovered.get()->fail("Failed to recover registrar: " +
-                          deserialized.error());
+                          deserialized->error());
     return;
   }
 
   Duration elapsed = metrics.state_fetch.stop();
 
   LOG(INFO) << "Successfully fetched the registry"
-            << " (" << Bytes(deserialized->ByteSize()) << ")"
+            << " (" << Bytes(deserialized->get()->ByteSize()) << ")"
             << " in " << elapsed;
 
   // Save the registry.
-  variable = recovery.get();
+  variable = recovery;
 
-  // Workaround for immovable protobuf messages.
   registry = Option<Registry>(Registry());
-  registry->Swap(&deserialized.get());
+  registry->Swap(deserialized->get().get());
+
+  // Build the 'slaveIDs' accumulator; it is incrementally maintained
+  // by the operations applied in `update()` from here on.
+  foreach (const Registry::Slave& slave, registry->slaves().slaves()) {
+    slaveIDs.insert(slave.info().id());
+  }
 
   // Perform the Recover operation to add the new MasterInfo.
   Owned<RegistryOperation> operation(new Recover(info));
   operations.push_back(operation);
   operation->future()
-    .onAny(defer(self(), &Self::__recover, lambda::_1));
+    .onAny(defer(self(), &Self::___recover, lambda::_1));
 
   update();
 }
 
 
-void RegistrarProcess::__recover(const Future<bool>& recover)
+void RegistrarProcess::___recover(const Future<bool>& recover)
 {
   CHECK(!recover.isPending());
 
@@ -448,50 +523,50 @@ Future<bool> RegistrarProcess::_apply(Owned<RegistryOperation> operation)
   Future<bool> future = operation->future();
   if (!updating) {
     update();
+  } else {
+    // A store is in flight; if no batch is prepared yet, prepare one
+    // now so that its application and serialization overlap with the
+    // in-flight store. Operations arriving once a batch is prepared
+    // simply queue up for the batch after it.
+    prepare();
   }
   return future;
 }
 
 
-void RegistrarProcess::update()
+void RegistrarProcess::prepare()
 {
-  if (operations.empty()) {
+  if (operations.empty() || prepared.isSome()) {
     return; // No-op.
   }
 
-  CHECK(!updating);
   CHECK_NONE(error);
-  CHECK_SOME(variable);
+  CHECK_SOME(registry);
 
   // Time how long it takes to apply the operations.
-  Stopwatch stopwatch;
-  stopwatch.start();
-
-  updating = true;
-
-  // Create a snapshot of the current registry. We use an `Owned` here
-  // to avoid copying, since protobuf doesn't suppport move construction.
-  auto updatedRegistry = Owned<Registry>(new Registry(registry.get()));
-
-  // Create the 'slaveIDs' accumulator.
-  hashset<SlaveID> slaveIDs;
-  foreach (const Registry::Slave& slave, updatedRegistry->slaves().slaves()) {
-    slaveIDs.insert(slave.info().id());
-  }
-
+  metrics.operations_apply.start();
+
+  // Apply the operations directly to the in-memory registry rather
+  // than to a snapshot: there is no rollback path to worry about since
+  // any failure to store below transitions the registrar into a
+  // permanent error state via `abort()`. This avoids copying the
+  // entire registry (which can measure tens of MB with many agents)
+  // on every update.
+  //
+  // NOTE: As a consequence, the '/registry' endpoint and the registry
+  // size gauge may briefly reflect an update whose store is still in
+  // flight.
   foreach (Owned<RegistryOperation>& operation, operations) {
     // No need to process the result of the operation.
-    (*operation)(updatedRegistry.get(), &slaveIDs);
+    (*operation)(&registry.get(), &slaveIDs);
   }
 
-  LOG(INFO) << "Applied " << operations.size() << " operations in "
-            << stopwatch.elapsed() << "; attempting to update the registry";
+  Duration applied = metrics.operations_apply.stop();
 
-  // Perform the store, and time the operation.
-  metrics.state_store.start();
+  // Serialize the updated registry, and time the serialization.
+  metrics.registry_serialize.start();
 
-  // Serialize updated registry.
-  Try<string> serialized = ::protobuf::serialize(*updatedRegistry);
+  Try<string> serialized = ::protobuf::serialize(registry.get());
   if (serialized.isError()) {
     string message = "Failed to update registry: " + serialized.error();
     fail(&operations, message);
@@ -499,24 +574,66 @@ void RegistrarProcess::update()
     return;
   }
 
-  state->store(variable->mutate(serialized.get()))
+  Duration serialize = metrics.registry_serialize.stop();
+
+  LOG(INFO) << "Applied " << operations.size() << " operations in "
+            << applied << " and serialized the registry in " << serialize;
+
+  Batch batch;
+  batch.serialized = serialized.get();
+  batch.operations.swap(operations);
+
+  prepared = batch;
+}
+
+
+void RegistrarProcess::update()
+{
+  if (updating) {
+    return; // A store is already in flight.
+  }
+
+  CHECK_NONE(error);
+  CHECK_SOME(variable);
+
+  if (prepared.isNone()) {
+    prepare();
+  }
+
+  if (prepared.isNone()) {
+    return; // Nothing to store (or `prepare()` aborted).
+  }
+
+  updating = true;
+
+  LOG(INFO) << "Attempting to update the registry";
+
+  // Perform the store, and time the operation.
+  metrics.state_store.start();
+
+  deque<Owned<RegistryOperation>> batch;
+  batch.swap(prepared->operations);
+
+  state->store(variable->mutate(prepared->serialized))
     .after(flags.registry_store_timeout,
            lambda::bind(
                &timeout<Option<Variable>>,
                "store",
                flags.registry_store_timeout,
                lambda::_1))
-    .onAny(defer(
-        self(), &Self::_update, lambda::_1, updatedRegistry, operations));
+    .onAny(defer(self(), &Self::_update, lambda::_1, batch));
+
+  prepared = None();
 
-  // Clear the operations, _update will transition the Promises!
-  operations.clear();
+  // Prepare the next batch (if operations have queued up in the
+  // meantime) while the store is in flight, so that the follow-up
+  // store can be issued as soon as this one completes.
+  prepare();
 }
 
 
 void RegistrarProcess::_update(
     const Future<Option<Variable>>& store,
-    const Owned<Registry>& updatedRegistry,
     deque<Owned<RegistryOperation>> applied)
 {
   updating = false;
@@ -544,7 +661,6 @@ void RegistrarProcess::_update(
   LOG(INFO) << "Successfully updated the registry in " << elapsed;
 
   variable = store->get();
-  registry->Swap(updatedRegistry.get());
 
   // Remove the operations.
   while (!applied.empty()) {
@@ -554,7 +670,7 @@ void RegistrarProcess::_update(
     operation->set();
   }
 
-  if (!operations.empty()) {
+  if (prepared.isSome() || !operations.empty()) {
     update();
   }
 }
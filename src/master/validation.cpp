@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -29,12 +30,14 @@
 
 #include <process/authenticator.hpp>
 
+#include <stout/boundedhashmap.hpp>
 #include <stout/foreach.hpp>
 #include <stout/hashmap.hpp>
 #include <stout/hashset.hpp>
 #include <stout/lambda.hpp>
 #include <stout/none.hpp>
 #include <stout/stringify.hpp>
+#include <stout/synchronized.hpp>
 
 #include "checks/checker.hpp"
 #include "checks/health_checker.hpp"
@@ -44,6 +47,8 @@
 
 #include "master/master.hpp"
 
+#include "master/allocator/mesos/offer_constraints.hpp"
+
 using process::http::authentication::Principal;
 
 using std::pair;
@@ -500,11 +505,35 @@ Option<Error> validateRoles(const FrameworkInfo& frameworkInfo)
   return None();
 }
 
+
+Option<Error> validateOfferConstraints(const mesos::FrameworkInfo& frameworkInfo)
+{
+  if (!frameworkInfo.has_offer_constraints()) {
+    return None();
+  }
+
+  Try<allocator::OfferConstraintsFilter> filter =
+    allocator::OfferConstraintsFilter::create(
+        frameworkInfo.offer_constraints());
+
+  if (filter.isError()) {
+    return Error(
+        "'FrameworkInfo.offer_constraints' is invalid: " + filter.error());
+  }
+
+  return None();
+}
+
 } // namespace internal {
 
 Option<Error> validate(const mesos::FrameworkInfo& frameworkInfo)
 {
-  return internal::validateRoles(frameworkInfo);
+  Option<Error> error = internal::validateRoles(frameworkInfo);
+  if (error.isSome()) {
+    return error;
+  }
+
+  return internal::validateOfferConstraints(frameworkInfo);
 }
 
 } // namespace framework {
@@ -620,6 +649,21 @@ Option<Error> validate(
       return None();
     }
 
+    case mesos::scheduler::Call::ACKNOWLEDGE_BATCH: {
+      if (!call.has_acknowledge_batch()) {
+        return Error("Expecting 'acknowledge_batch' to be present");
+      }
+
+      foreach (const mesos::scheduler::Call::Acknowledge& acknowledge,
+               call.acknowledge_batch().acknowledgements()) {
+        Try<id::UUID> uuid = id::UUID::fromBytes(acknowledge.uuid());
+        if (uuid.isError()) {
+          return uuid.error();
+        }
+      }
+      return None();
+    }
+
     case mesos::scheduler::Call::ACKNOWLEDGE_OPERATION_STATUS: {
       if (!call.has_acknowledge_operation_status()) {
         return Error("Expecting 'acknowledge_operation_status' to be present");
@@ -1344,6 +1388,86 @@ Option<Error> validateContainerInfo(const TaskInfo& task)
 }
 
 
+// The number of task "shapes" for which validation results are
+// memoized, see `validateCachedTaskShape` below.
+constexpr size_t TASK_SHAPE_CACHE_CAPACITY = 100;
+
+
+// Runs the validators that only depend on the contents of the task
+// itself, not on framework or agent state.
+//
+// NOTE: The order in which the following validate functions are
+// executed does matter!
+Option<Error> validateTaskShape(const TaskInfo& task)
+{
+  vector<lambda::function<Option<Error>(const TaskInfo&)>> validators = {
+    internal::validateKillPolicy,
+    internal::validateMaxCompletionTime,
+    internal::validateCheck,
+    internal::validateHealthCheck,
+    internal::validateResources,
+    internal::validateCommandInfo,
+    internal::validateContainerInfo
+  };
+
+  foreach (const auto& validator, validators) {
+    Option<Error> error = validator(task);
+    if (error.isSome()) {
+      return error;
+    }
+  }
+
+  return None();
+}
+
+
+// Memoizes `validateTaskShape`: the tasks of a large `LAUNCH` or
+// `LAUNCH_GROUP` accept typically differ only in fields that the shape
+// validators do not inspect (e.g., task ID, name, data), so tasks of a
+// shape validated before short-circuit to the memoized result. The key
+// is the serialized task with these variant fields cleared, so that a
+// hash collision cannot make distinct shapes share a result. The error
+// messages produced by the shape validators do not mention any of the
+// cleared fields and thus can be returned verbatim.
+//
+// NOTE: The cache is shared across master actors (e.g., multiple
+// masters in tests run on different worker threads), so accesses
+// are guarded by a mutex.
+Option<Error> validateCachedTaskShape(const TaskInfo& task)
+{
+  // NOTE: Intentionally leaked to sidestep static destruction order
+  // issues at process teardown.
+  static std::mutex* mutex = new std::mutex();
+  static BoundedHashMap<string, Option<Error>>* cache =
+    new BoundedHashMap<string, Option<Error>>(TASK_SHAPE_CACHE_CAPACITY);
+
+  TaskInfo shape = task;
+  shape.clear_task_id();
+  shape.clear_name();
+  shape.clear_slave_id();
+  shape.clear_data();
+  shape.clear_labels();
+  shape.clear_discovery();
+
+  const string key = shape.SerializeAsString();
+
+  synchronized (mutex) {
+    Option<Option<Error>> memoized = cache->get(key);
+    if (memoized.isSome()) {
+      return memoized.get();
+    }
+  }
+
+  Option<Error> error = validateTaskShape(task);
+
+  synchronized (mutex) {
+    cache->set(key, error);
+  }
+
+  return error;
+}
+
+
 // Validates task specific fields except its executor (if it exists).
 Option<Error> validateTask(
     const TaskInfo& task,
@@ -1354,18 +1478,14 @@ Option<Error> validateTask(
   CHECK_NOTNULL(slave);
 
   // NOTE: The order in which the following validate functions are
-  // executed does matter!
+  // executed does matter! The framework- and agent-dependent checks
+  // come first; the remaining checks are shared across tasks of the
+  // same shape through `validateCachedTaskShape`.
   vector<lambda::function<Option<Error>()>> validators = {
     lambda::bind(internal::validateTaskID, task),
     lambda::bind(internal::validateUniqueTaskID, task, framework),
     lambda::bind(internal::validateSlaveID, task, slave),
-    lambda::bind(internal::validateKillPolicy, task),
-    lambda::bind(internal::validateMaxCompletionTime, task),
-    lambda::bind(internal::validateCheck, task),
-    lambda::bind(internal::validateHealthCheck, task),
-    lambda::bind(internal::validateResources, task),
-    lambda::bind(internal::validateCommandInfo, task),
-    lambda::bind(internal::validateContainerInfo, task)
+    lambda::bind(validateCachedTaskShape, task)
   };
 
   foreach (const lambda::function<Option<Error>()>& validator, validators) {
@@ -26,6 +26,7 @@
 #include <stout/json.hpp>
 #include <stout/numify.hpp>
 #include <stout/os.hpp>
+#include <stout/stopwatch.hpp>
 #include <stout/strings.hpp>
 #include <stout/stringify.hpp>
 #include <stout/version.hpp>
@@ -384,11 +385,17 @@ Try<Nothing> ModuleManager::load(const string& modulesDir)
           modules.error());
     }
 
+    Stopwatch watch;
+    watch.start();
+
     Try<Nothing> result = loadManifest(modules.get());
     if (result.isError()) {
       return Error(
           "Error loading modules from '" + filepath + "': " + result.error());
     }
+
+    VLOG(1) << "Loaded module manifest from '" << filepath << "' in "
+            << watch.elapsed();
   }
 
   return Nothing();
@@ -368,8 +368,10 @@ protected:
 
       process::http::Pipe::Reader reader = response.reader.get();
 
-      auto deserializer =
-        lambda::bind(deserialize<Event>, contentType, lambda::_1);
+      // Deserialize each record in place from a slice of the pipe's
+      // data, avoiding a copy per streamed event.
+      auto deserializer = lambda::bind(
+          deserializeSlice<Event>, contentType, lambda::_1, lambda::_2);
 
       process::Owned<recordio::Reader<Event>> decoder(
           new recordio::Reader<Event>(
@@ -29,13 +29,16 @@
 #include <mesos/v1/resource_provider/resource_provider.hpp>
 
 #include <process/collect.hpp>
+#include <process/delay.hpp>
 #include <process/dispatch.hpp>
 #include <process/id.hpp>
 #include <process/process.hpp>
 
+#include <process/metrics/counter.hpp>
 #include <process/metrics/pull_gauge.hpp>
 #include <process/metrics/metrics.hpp>
 
+#include <stout/duration.hpp>
 #include <stout/hashmap.hpp>
 #include <stout/nothing.hpp>
 #include <stout/protobuf.hpp>
@@ -75,6 +78,7 @@ using process::Promise;
 using process::Queue;
 
 using process::collect;
+using process::delay;
 using process::dispatch;
 using process::spawn;
 using process::terminate;
@@ -91,11 +95,17 @@ using process::http::UnsupportedMediaType;
 
 using process::http::authentication::Principal;
 
+using process::metrics::Counter;
 using process::metrics::PullGauge;
 
 namespace mesos {
 namespace internal {
 
+// The window during which `UPDATE_STATE` messages from a resource
+// provider are coalesced before being forwarded, see `updateState()`.
+constexpr Duration UPDATE_STATE_COALESCE_WINDOW = Milliseconds(100);
+
+
 mesos::resource_provider::registry::ResourceProvider
 createRegistryResourceProvider(const ResourceProviderInfo& resourceProviderInfo)
 {
@@ -212,6 +222,10 @@ private:
       ResourceProvider* resourceProvider,
       const Call::UpdateState& update);
 
+  // Forwards the staged `UPDATE_STATE` messages once the coalescing
+  // window closes.
+  void flushUpdateStates();
+
   void updatePublishResourcesStatus(
       ResourceProvider* resourceProvider,
       const Call::UpdatePublishResourcesStatus& update);
@@ -240,11 +254,27 @@ private:
     ~Metrics();
 
     PullGauge subscribed;
+
+    // The difference between these counters measures how effectively
+    // `UPDATE_STATE` messages are coalesced before being forwarded.
+    Counter state_updates_received;
+    Counter state_updates_forwarded;
   };
 
   Owned<Registrar> registrar;
   Promise<Nothing> recovered;
 
+  // Staged `UPDATE_STATE` messages keyed by resource provider. Since
+  // each `UPDATE_STATE` carries the full provider state, only the
+  // latest staged message per provider needs to be forwarded when the
+  // coalescing window closes. This bounds the rate of
+  // `UpdateSlaveMessage` round trips to the master to one per window
+  // per provider, no matter how quickly a provider reports new state.
+  hashmap<ResourceProviderID, ResourceProviderMessage> pendingUpdateStates;
+
+  // Whether a flush of `pendingUpdateStates` has been scheduled.
+  bool updateStateFlushScheduled;
+
   Metrics metrics;
 };
 
@@ -253,6 +283,7 @@ ResourceProviderManagerProcess::ResourceProviderManagerProcess(
     Owned<Registrar> _registrar)
   : ProcessBase(process::ID::generate("resource-provider-manager")),
     registrar(std::move(_registrar)),
+    updateStateFlushScheduled(false),
     metrics(*this)
 {
   CHECK_NOTNULL(registrar.get());
@@ -781,6 +812,11 @@ void ResourceProviderManagerProcess::_subscribe(
         resourceProviders.subscribed.erase(resourceProviderId);
       }
 
+      // Drop any staged state update of the disconnected resource
+      // provider: flushing it after the disconnect would resurrect
+      // the provider's resources on the agent.
+      pendingUpdateStates.erase(resourceProviderId);
+
       ResourceProviderMessage::Disconnect disconnect{resourceProviderId};
 
       ResourceProviderMessage message;
@@ -866,7 +902,30 @@ void ResourceProviderManagerProcess::updateState(
   message.type = ResourceProviderMessage::Type::UPDATE_STATE;
   message.updateState = std::move(updateState);
 
-  messages.put(std::move(message));
+  ++metrics.state_updates_received;
+
+  // Coalesce state updates: since each `UPDATE_STATE` carries the
+  // full provider state, only the latest one per provider needs to be
+  // forwarded once the window closes.
+  pendingUpdateStates[resourceProvider->info.id()] = std::move(message);
+
+  if (!updateStateFlushScheduled) {
+    updateStateFlushScheduled = true;
+    delay(UPDATE_STATE_COALESCE_WINDOW, self(), &Self::flushUpdateStates);
+  }
+}
+
+
+void ResourceProviderManagerProcess::flushUpdateStates()
+{
+  updateStateFlushScheduled = false;
+
+  foreachvalue (ResourceProviderMessage& message, pendingUpdateStates) {
+    ++metrics.state_updates_forwarded;
+    messages.put(std::move(message));
+  }
+
+  pendingUpdateStates.clear();
 }
 
 
@@ -921,15 +980,23 @@ ResourceProviderManagerProcess::Metrics::Metrics(
     const ResourceProviderManagerProcess& manager)
   : subscribed(
       "resource_provider_manager/subscribed",
-      defer(manager, &ResourceProviderManagerProcess::gaugeSubscribed))
+      defer(manager, &ResourceProviderManagerProcess::gaugeSubscribed)),
+    state_updates_received(
+        "resource_provider_manager/state_updates_received"),
+    state_updates_forwarded(
+        "resource_provider_manager/state_updates_forwarded")
 {
   process::metrics::add(subscribed);
+  process::metrics::add(state_updates_received);
+  process::metrics::add(state_updates_forwarded);
 }
 
 
 ResourceProviderManagerProcess::Metrics::~Metrics()
 {
   process::metrics::remove(subscribed);
+  process::metrics::remove(state_updates_received);
+  process::metrics::remove(state_updates_forwarded);
 }
 
 
@@ -154,6 +154,15 @@ namespace internal {
 constexpr Duration CSI_ENDPOINT_CREATION_TIMEOUT = Minutes(1);
 
 
+// The maximum number of entries requested per `ListVolumes` call during
+// reconciliation. Paging bounds the size of each response so that a
+// plugin managing many volumes does not have to serialize all of them
+// at once.
+//
+// TODO(chhsiao): Make the page size configurable.
+constexpr int LIST_VOLUMES_MAX_ENTRIES = 100;
+
+
 // Returns true if the string is a valid Java identifier.
 static bool isValidName(const string& s)
 {
@@ -2791,40 +2800,61 @@ Future<Resources> StorageLocalResourceProviderProcess::listVolumes()
 
   CHECK_SOME(controllerContainerId);
 
-  // TODO(chhsiao): Set the max entries and use a loop to do
-  // multiple `ListVolumes` calls.
-  return call<csi::v0::LIST_VOLUMES>(
-      controllerContainerId.get(), csi::v0::ListVolumesRequest())
-    .then(defer(self(), [=](const csi::v0::ListVolumesResponse& response) {
-      Resources resources;
+  // Concurrent reconciliations share the in-flight call sequence
+  // instead of issuing duplicate `ListVolumes` calls to the plugin.
+  if (pendingListVolumes.isSome() && pendingListVolumes->isPending()) {
+    return pendingListVolumes.get();
+  }
 
-      // Recover disk profiles from the checkpointed state.
-      hashmap<string, string> volumesToProfiles;
-      foreach (const Resource& resource, totalResources) {
-        if (resource.disk().source().has_id() &&
-            resource.disk().source().has_profile()) {
-          volumesToProfiles.put(
-              resource.disk().source().id(),
-              resource.disk().source().profile());
+  // Recover disk profiles from the checkpointed state.
+  hashmap<string, string> volumesToProfiles;
+  foreach (const Resource& resource, totalResources) {
+    if (resource.disk().source().has_id() &&
+        resource.disk().source().has_profile()) {
+      volumesToProfiles.put(
+          resource.disk().source().id(),
+          resource.disk().source().profile());
+    }
+  }
+
+  shared_ptr<string> startingToken(new string());
+  shared_ptr<Resources> resources(new Resources());
+
+  pendingListVolumes = loop(
+      self(),
+      [=] {
+        csi::v0::ListVolumesRequest request;
+        request.set_max_entries(LIST_VOLUMES_MAX_ENTRIES);
+        request.set_starting_token(*startingToken);
+
+        return call<csi::v0::LIST_VOLUMES>(
+            controllerContainerId.get(), std::move(request));
+      },
+      [=](const csi::v0::ListVolumesResponse& response)
+          -> ControlFlow<Resources> {
+        foreach (const auto& entry, response.entries()) {
+          *resources += createRawDiskResource(
+              info,
+              Bytes(entry.volume().capacity_bytes()),
+              volumesToProfiles.contains(entry.volume().id())
+                ? volumesToProfiles.at(entry.volume().id())
+                : Option<string>::none(),
+              vendor,
+              entry.volume().id(),
+              entry.volume().attributes().empty()
+                ? Option<Labels>::none()
+                : convertStringMapToLabels(entry.volume().attributes()));
         }
-      }
 
-      foreach (const auto& entry, response.entries()) {
-        resources += createRawDiskResource(
-            info,
-            Bytes(entry.volume().capacity_bytes()),
-            volumesToProfiles.contains(entry.volume().id())
-              ? volumesToProfiles.at(entry.volume().id())
-              : Option<string>::none(),
-            vendor,
-            entry.volume().id(),
-            entry.volume().attributes().empty()
-              ? Option<Labels>::none()
-              : convertStringMapToLabels(entry.volume().attributes()));
-      }
+        if (response.next_token().empty()) {
+          return Break(std::move(*resources));
+        }
 
-      return resources;
-    }));
+        *startingToken = response.next_token();
+        return Continue();
+      });
+
+  return pendingListVolumes.get();
 }
 
 
@@ -2844,22 +2874,43 @@ Future<Resources> StorageLocalResourceProviderProcess::getCapacities()
   foreachpair (const string& profile,
                const DiskProfileAdaptor::ProfileInfo& profileInfo,
                profileInfos) {
+    // Concurrent reconciliations share the in-flight call for each
+    // profile instead of issuing duplicate `GetCapacity` calls.
+    if (pendingGetCapacities.contains(profile) &&
+        pendingGetCapacities.at(profile).isPending()) {
+      futures.push_back(pendingGetCapacities.at(profile));
+      continue;
+    }
+
     csi::v0::GetCapacityRequest request;
     *request.add_volume_capabilities() = profileInfo.capability;
     *request.mutable_parameters() = profileInfo.parameters;
 
-    futures.push_back(
-        call<csi::v0::GET_CAPACITY>(
-            controllerContainerId.get(), std::move(request))
-          .then(defer(self(), [=](
-              const csi::v0::GetCapacityResponse& response) -> Resources {
-            if (response.available_capacity() == 0) {
-              return Resources();
-            }
+    Future<Resources> capacity =
+      call<csi::v0::GET_CAPACITY>(
+          controllerContainerId.get(), std::move(request))
+        .then(defer(self(), [=](
+            const csi::v0::GetCapacityResponse& response) -> Resources {
+          if (response.available_capacity() == 0) {
+            return Resources();
+          }
+
+          return createRawDiskResource(
+              info, Bytes(response.available_capacity()), profile, vendor);
+        }));
+
+    // Drop the entry once the call finishes so that the map does not
+    // grow with profiles that are no longer known.
+    capacity
+      .onAny(defer(self(), [=](const Future<Resources>&) {
+        if (pendingGetCapacities.contains(profile) &&
+            !pendingGetCapacities.at(profile).isPending()) {
+          pendingGetCapacities.erase(profile);
+        }
+      }));
 
-            return createRawDiskResource(
-                info, Bytes(response.available_capacity()), profile, vendor);
-          })));
+    pendingGetCapacities.put(profile, capacity);
+    futures.push_back(capacity);
   }
 
   return collect(futures)
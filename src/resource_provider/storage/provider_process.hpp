@@ -389,6 +389,11 @@ private:
   id::UUID resourceVersion;
   hashmap<std::string, VolumeData> volumes;
 
+  // In-flight reconciliation RPCs. Concurrent reconciliations share
+  // these futures instead of issuing duplicate calls to the plugin.
+  Option<process::Future<Resources>> pendingListVolumes;
+  hashmap<std::string, process::Future<Resources>> pendingGetCapacities;
+
   // If pending, it means that the storage pools are being reconciled, and all
   // incoming operations that disallow reconciliation will be dropped.
   process::Future<Nothing> reconciled;
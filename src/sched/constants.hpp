@@ -53,6 +53,12 @@ constexpr Duration DEFAULT_AUTHENTICATION_TIMEOUT_MIN = Seconds(5);
 // time the scheduler waits before retrying authenticating with the master.
 constexpr Duration DEFAULT_AUTHENTICATION_TIMEOUT_MAX = Minutes(1);
 
+// Number of workers used to invoke the 'statusUpdate' callback when
+// the `--concurrent_callbacks` flag is set. Updates are assigned to
+// workers by a hash of the task id, so this bounds the callback
+// parallelism while keeping updates for a given task in order.
+constexpr size_t CONCURRENT_UPDATE_CALLBACK_WORKERS = 4;
+
 } // namespace scheduler {
 } // namespace internal {
 } // namespace mesos {
@@ -136,6 +136,17 @@ public:
       "authenticating with the master. See `authentication_backoff_factor`\n"
       "for more details",
       DEFAULT_AUTHENTICATION_TIMEOUT_MAX);
+
+    add(&Flags::concurrent_callbacks,
+        "concurrent_callbacks",
+        "If true, the driver invokes independent classes of scheduler\n"
+        "callbacks from separate actors: offer-related callbacks and\n"
+        "status update callbacks each get their own, so that e.g. a slow\n"
+        "'statusUpdate' callback does not block offer delivery. Status\n"
+        "updates for the same task are still delivered in order. Only\n"
+        "enable this if the scheduler's callbacks are thread safe with\n"
+        "respect to each other.",
+        false);
   }
 
   Duration authentication_backoff_factor;
@@ -145,6 +156,7 @@ public:
   std::string authenticatee;
   Duration authentication_timeout_min;
   Duration authentication_timeout_max;
+  bool concurrent_callbacks;
 };
 
 } // namespace scheduler {
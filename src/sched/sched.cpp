@@ -30,6 +30,7 @@
 #endif // __WINDOWS__
 
 #include <cmath>
+#include <functional>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -180,6 +181,25 @@ private:
   }
 };
 
+// When the '--concurrent_callbacks' driver flag is set, scheduler
+// callbacks are invoked from dedicated worker actors instead of from
+// the scheduler process itself, so that a slow callback of one class
+// (e.g., 'statusUpdate') does not delay callbacks of another (e.g.,
+// 'resourceOffers'). Each worker runs its closures serially, in
+// dispatch order.
+class CallbackProcess : public Process<CallbackProcess>
+{
+public:
+  CallbackProcess() : ProcessBase(process::ID::generate("scheduler-callback"))
+  {}
+
+  void invoke(const lambda::function<void()>& callback)
+  {
+    callback();
+  }
+};
+
+
 // The scheduler process (below) is responsible for interacting with
 // the master and responding to Mesos API calls from scheduler
 // drivers. In order to allow a message to be sent back to the master
@@ -235,11 +255,38 @@ public:
   ~SchedulerProcess() override
   {
     delete authenticatee;
+
+    // Wait for the callback workers (if any) so that the scheduler
+    // is not invoked after the driver has been destroyed.
+    if (offerCallbackWorker.isSome()) {
+      process::terminate(offerCallbackWorker.get());
+      process::wait(offerCallbackWorker.get());
+    }
+
+    foreach (const process::PID<CallbackProcess>& worker,
+             updateCallbackWorkers) {
+      process::terminate(worker);
+      process::wait(worker);
+    }
   }
 
 protected:
   void initialize() override
   {
+    if (flags.concurrent_callbacks) {
+      // One worker is shared by the offer related callbacks so that
+      // 'resourceOffers' and 'offerRescinded' keep their relative
+      // order; status updates get a pool, selected by a hash of the
+      // task id so that updates for a given task remain in order.
+      offerCallbackWorker = process::spawn(new CallbackProcess(), true);
+
+      for (size_t i = 0; i < scheduler::CONCURRENT_UPDATE_CALLBACK_WORKERS;
+           i++) {
+        updateCallbackWorkers.push_back(
+            process::spawn(new CallbackProcess(), true));
+      }
+    }
+
     install<Event>(&SchedulerProcess::receive);
 
     // TODO(benh): Get access to flags so that we can decide whether
@@ -904,6 +951,31 @@ protected:
       }
     }
 
+    if (offerCallbackWorker.isSome()) {
+      // NOTE: The closure only touches state that is immutable after
+      // construction ('scheduler', 'driver'); all driver state was
+      // updated above, on this process.
+      Scheduler* scheduler = this->scheduler;
+      MesosSchedulerDriver* driver = this->driver;
+
+      dispatch(
+          offerCallbackWorker.get(),
+          &CallbackProcess::invoke,
+          lambda::function<void()>([=]() {
+            Stopwatch stopwatch;
+            if (FLAGS_v >= 1) {
+              stopwatch.start();
+            }
+
+            scheduler->resourceOffers(driver, offers);
+
+            VLOG(1) << "Scheduler::resourceOffers took "
+                    << stopwatch.elapsed();
+          }));
+
+      return;
+    }
+
     Stopwatch stopwatch;
     if (FLAGS_v >= 1) {
       stopwatch.start();
@@ -941,6 +1013,28 @@ protected:
 
     savedOffers.erase(offerId);
 
+    if (offerCallbackWorker.isSome()) {
+      Scheduler* scheduler = this->scheduler;
+      MesosSchedulerDriver* driver = this->driver;
+
+      dispatch(
+          offerCallbackWorker.get(),
+          &CallbackProcess::invoke,
+          lambda::function<void()>([=]() {
+            Stopwatch stopwatch;
+            if (FLAGS_v >= 1) {
+              stopwatch.start();
+            }
+
+            scheduler->offerRescinded(driver, offerId);
+
+            VLOG(1) << "Scheduler::offerRescinded took "
+                    << stopwatch.elapsed();
+          }));
+
+      return;
+    }
+
     Stopwatch stopwatch;
     if (FLAGS_v >= 1) {
       stopwatch.start();
@@ -1012,6 +1106,39 @@ protected:
       status.set_uuid(update.uuid());
     }
 
+    if (!updateCallbackWorkers.empty()) {
+      const process::PID<CallbackProcess>& worker = updateCallbackWorkers[
+          std::hash<string>()(status.task_id().value()) %
+          updateCallbackWorkers.size()];
+
+      Scheduler* scheduler = this->scheduler;
+      MesosSchedulerDriver* driver = this->driver;
+
+      // The acknowledgment must be sent from this process (it reads
+      // the connection state and uses 'send'), so the worker defers
+      // back here once the callback has returned.
+      process::Deferred<void()> acknowledge =
+        defer(self(), &Self::acknowledgeStatusUpdate, update, from, pid);
+
+      dispatch(
+          worker,
+          &CallbackProcess::invoke,
+          lambda::function<void()>([=]() {
+            Stopwatch stopwatch;
+            if (FLAGS_v >= 1) {
+              stopwatch.start();
+            }
+
+            scheduler->statusUpdate(driver, status);
+
+            VLOG(1) << "Scheduler::statusUpdate took " << stopwatch.elapsed();
+
+            acknowledge();
+          }));
+
+      return;
+    }
+
     Stopwatch stopwatch;
     if (FLAGS_v >= 1) {
       stopwatch.start();
@@ -1021,40 +1148,57 @@ protected:
 
     VLOG(1) << "Scheduler::statusUpdate took " << stopwatch.elapsed();
 
-    if (implicitAcknowledgements) {
-      // Note that we need to look at the atomic 'running' here
-      // so that we don't acknowledge the update if the driver was
-      // aborted during the processing of the update.
-      if (!running.load()) {
+    acknowledgeStatusUpdate(update, from, pid);
+  }
+
+  void acknowledgeStatusUpdate(
+      const StatusUpdate& update,
+      const UPID& from,
+      const UPID& pid)
+  {
+    if (!implicitAcknowledgements) {
+      return;
+    }
+
+    // Note that we need to look at the atomic 'running' here
+    // so that we don't acknowledge the update if the driver was
+    // aborted during the processing of the update.
+    if (!running.load()) {
+      VLOG(1) << "Not sending status update acknowledgment message because "
+              << "the driver is not running!";
+      return;
+    }
+
+    // See 'statusUpdate()' for when we don't need to acknowledge.
+    if ((update.has_uuid() && update.uuid() != "") ||
+        (from != UPID() && pid != UPID())) {
+      // We drop updates while we're disconnected. Note that this can
+      // only be observed here with concurrent callbacks, where the
+      // driver may disconnect between the 'statusUpdate' callback and
+      // this (deferred) acknowledgment.
+      if (!connected) {
         VLOG(1) << "Not sending status update acknowledgment message because "
-                << "the driver is not running!";
+                << "the driver is disconnected!";
         return;
       }
 
-      // See above for when we don't need to acknowledge.
-      if ((update.has_uuid() && update.uuid() != "") ||
-          (from != UPID() && pid != UPID())) {
-        // We drop updates while we're disconnected.
-        CHECK(connected);
-        CHECK_SOME(master);
+      CHECK_SOME(master);
 
-        VLOG(2) << "Sending ACK for status update " << update
-                << " to " << master->pid();
+      VLOG(2) << "Sending ACK for status update " << update
+              << " to " << master->pid();
 
-        Call call;
+      Call call;
 
-        CHECK(framework.has_id());
-        call.mutable_framework_id()->CopyFrom(framework.id());
-        call.set_type(Call::ACKNOWLEDGE);
+      CHECK(framework.has_id());
+      call.mutable_framework_id()->CopyFrom(framework.id());
+      call.set_type(Call::ACKNOWLEDGE);
 
-        Call::Acknowledge* acknowledge = call.mutable_acknowledge();
-        acknowledge->mutable_slave_id()->CopyFrom(update.slave_id());
-        acknowledge->mutable_task_id()->CopyFrom(update.status().task_id());
-        acknowledge->set_uuid(update.uuid());
+      Call::Acknowledge* acknowledge = call.mutable_acknowledge();
+      acknowledge->mutable_slave_id()->CopyFrom(update.slave_id());
+      acknowledge->mutable_task_id()->CopyFrom(update.status().task_id());
+      acknowledge->set_uuid(update.uuid());
 
-        CHECK_SOME(master);
-        send(master->pid(), call);
-      }
+      send(master->pid(), call);
     }
   }
 
@@ -1658,6 +1802,13 @@ private:
   hashmap<OfferID, hashmap<SlaveID, UPID>> savedOffers;
   hashmap<SlaveID, UPID> savedSlavePids;
 
+  // Workers used to invoke scheduler callbacks when the
+  // '--concurrent_callbacks' flag is set: one shared by the offer
+  // related callbacks and a pool for status updates. Unset/empty in
+  // the default serial mode.
+  Option<process::PID<CallbackProcess>> offerCallbackWorker;
+  vector<process::PID<CallbackProcess>> updateCallbackWorkers;
+
   // The driver optionally provides implicit acknowledgements
   // for frameworks. If disabled, the framework must send its
   // own acknowledgements through the driver, when the 'uuid'
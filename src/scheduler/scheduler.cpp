@@ -162,6 +162,8 @@ public:
       callbacks {connected, disconnected, received},
       credential(_credential),
       local(false),
+      acknowledging(false),
+      batching(true),
       flags(_flags)
   {
     GOOGLE_PROTOBUF_VERIFY_VERSION;
@@ -231,6 +233,32 @@ public:
       return;
     }
 
+    // Queue status update acknowledgements while a previous
+    // acknowledgement request is in flight, and flush the queue
+    // (batched into a single ACKNOWLEDGE_BATCH call when several
+    // acknowledgements accumulated) once it completes; see
+    // `__send()`. This keeps a high rate of acknowledgements from
+    // paying one HTTP request round trip per status update.
+    if (call.type() == Call::ACKNOWLEDGE && batching) {
+      acknowledgements.push_back(call);
+
+      if (acknowledging) {
+        return;
+      }
+
+      Option<Call> flushed = flushAcknowledgements();
+      CHECK_SOME(flushed);
+
+      acknowledging = true;
+      post(flushed.get());
+      return;
+    }
+
+    post(call);
+  }
+
+  void post(const Call& call)
+  {
     // TODO(vinod): Add support for sending MESSAGE calls directly
     // to the slave, instead of relaying it through the master, as
     // the scheduler driver does.
@@ -473,6 +501,13 @@ protected:
     connections = None();
     connectionId = None();
     subscribed = None();
+
+    // Drop any queued acknowledgements; the agent retries
+    // unacknowledged status updates after the failover. The new
+    // master may support batching even if the old one did not.
+    acknowledging = false;
+    batching = true;
+    acknowledgements.clear();
   }
 
   void detected(const Future<Option<mesos::MasterInfo>>& future)
@@ -566,6 +601,46 @@ protected:
   void drop(const Call& call, const string& message)
   {
     LOG(WARNING) << "Dropping " << call.type() << ": " << message;
+
+    if (call.type() == Call::ACKNOWLEDGE ||
+        call.type() == Call::ACKNOWLEDGE_BATCH) {
+      // Don't leave the acknowledgement pipeline wedged on a dropped
+      // request. Anything queued behind it is dropped along with it;
+      // the agent retries unacknowledged status updates.
+      acknowledging = false;
+      acknowledgements.clear();
+    }
+  }
+
+  // Drains the queued acknowledgements into a single call: the
+  // acknowledgement itself if there is just one, or an
+  // ACKNOWLEDGE_BATCH call otherwise.
+  Option<Call> flushAcknowledgements()
+  {
+    if (acknowledgements.empty()) {
+      return None();
+    }
+
+    Call call;
+
+    if (acknowledgements.size() == 1) {
+      call = std::move(acknowledgements.front());
+    } else {
+      VLOG(1) << "Batching " << acknowledgements.size()
+              << " status update acknowledgements";
+
+      call.set_type(Call::ACKNOWLEDGE_BATCH);
+      *call.mutable_framework_id() = acknowledgements.front().framework_id();
+
+      foreach (Call& acknowledgement, acknowledgements) {
+        *call.mutable_acknowledge_batch()->add_acknowledgements() =
+          std::move(*acknowledgement.mutable_acknowledge());
+      }
+    }
+
+    acknowledgements.clear();
+
+    return call;
   }
 
   void _send(const Call& call, const Future<process::http::Request>& future)
@@ -636,6 +711,51 @@ protected:
     CHECK(!response.isDiscarded());
     CHECK(state == SUBSCRIBING || state == SUBSCRIBED) << state;
 
+    if (call.type() == Call::ACKNOWLEDGE ||
+        call.type() == Call::ACKNOWLEDGE_BATCH) {
+      // The acknowledgement request is no longer in flight; flush
+      // anything that queued up behind it.
+      acknowledging = false;
+
+      // A master that predates the ACKNOWLEDGE_BATCH call does not
+      // recognize its type and fails the request, so fall back to
+      // sending each acknowledgement individually and stop batching
+      // for the lifetime of this connection.
+      if (call.type() == Call::ACKNOWLEDGE_BATCH &&
+          response.isReady() &&
+          response->code == process::http::Status::BAD_REQUEST) {
+        LOG(WARNING) << "Received '" << response->status << "' ("
+                     << response->body << ") for " << call.type()
+                     << "; falling back to individual acknowledgements";
+
+        batching = false;
+
+        foreach (const Call::Acknowledge& acknowledge,
+                 call.acknowledge_batch().acknowledgements()) {
+          Call acknowledgement;
+          acknowledgement.set_type(Call::ACKNOWLEDGE);
+          *acknowledgement.mutable_framework_id() = call.framework_id();
+          *acknowledgement.mutable_acknowledge() = acknowledge;
+
+          post(acknowledgement);
+        }
+
+        foreach (const Call& acknowledgement, acknowledgements) {
+          post(acknowledgement);
+        }
+
+        acknowledgements.clear();
+
+        return;
+      }
+
+      Option<Call> flushed = flushAcknowledgements();
+      if (flushed.isSome()) {
+        acknowledging = true;
+        post(flushed.get());
+      }
+    }
+
     // This can happen during a master failover or a network blip
     // causing the socket to timeout. Eventually, the scheduler would
     // detect the disconnection via ZK(disconnect()) or lack of heartbeats.
@@ -655,8 +775,10 @@ protected:
 
       Pipe::Reader reader = response->reader.get();
 
-      auto deserializer =
-        lambda::bind(deserialize<Event>, contentType, lambda::_1);
+      // Deserialize each record in place from a slice of the pipe's
+      // data, avoiding a copy per streamed event.
+      auto deserializer = lambda::bind(
+          deserializeSlice<Event>, contentType, lambda::_1, lambda::_2);
 
       Owned<Reader<Event>> decoder(
           new Reader<Event>(Decoder<Event>(deserializer), reader));
@@ -951,6 +1073,12 @@ private:
   bool local; // Whether or not we launched a local cluster.
   shared_ptr<MasterDetector> detector;
   queue<Event> events;
+
+  // Status update acknowledgements queued while a previous
+  // acknowledgement request is in flight, flushed when it completes.
+  vector<Call> acknowledgements;
+  bool acknowledging; // Whether an acknowledgement request is in flight.
+  bool batching; // Whether the master supports ACKNOWLEDGE_BATCH.
   Option<::URL> master;
   Option<id::UUID> streamId;
   const Flags flags;
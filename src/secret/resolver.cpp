@@ -22,8 +22,18 @@
 
 #include <mesos/secret/resolver.hpp>
 
+#include <process/defer.hpp>
+#include <process/dispatch.hpp>
 #include <process/future.hpp>
-
+#include <process/id.hpp>
+#include <process/owned.hpp>
+#include <process/process.hpp>
+#include <process/timeout.hpp>
+
+#include <stout/duration.hpp>
+#include <stout/hashmap.hpp>
+#include <stout/lambda.hpp>
+#include <stout/option.hpp>
 #include <stout/try.hpp>
 
 #include "module/manager.hpp"
@@ -32,7 +42,10 @@ using std::string;
 
 using process::Failure;
 using process::Future;
+using process::Owned;
+using process::Process;
 using process::Shared;
+using process::Timeout;
 
 namespace mesos {
 namespace internal {
@@ -60,26 +73,154 @@ public:
   }
 };
 
+
+// Serves repeated resolutions of the same reference-type secret from
+// memory, so that a burst of container launches does not pay one
+// backend round-trip per secret. Concurrent resolutions of the same
+// secret share a single in-flight backend call. Value-type secrets
+// never involve a backend and bypass the cache.
+class CachingSecretResolverProcess
+  : public Process<CachingSecretResolverProcess>
+{
+public:
+  CachingSecretResolverProcess(
+      const Owned<SecretResolver>& _resolver,
+      const Duration& _ttl,
+      const Option<Duration>& _negativeTtl)
+    : ProcessBase(process::ID::generate("caching-secret-resolver")),
+      resolver(_resolver),
+      ttl(_ttl),
+      negativeTtl(_negativeTtl) {}
+
+  Future<Secret::Value> resolve(const Secret& secret)
+  {
+    if (!secret.has_reference()) {
+      return resolver->resolve(secret);
+    }
+
+    const string key = secret.reference().SerializeAsString();
+
+    if (entries.contains(key)) {
+      const Entry& entry = entries.at(key);
+
+      // An entry without an expiration is still in flight.
+      if (entry.expiry.isNone() || !entry.expiry->expired()) {
+        return entry.resolution;
+      }
+
+      entries.erase(key);
+    }
+
+    Entry entry;
+    entry.resolution = resolver->resolve(secret)
+      .onAny(defer(self(), &Self::_resolve, key, lambda::_1));
+
+    entries.put(key, entry);
+
+    return entry.resolution;
+  }
+
+private:
+  struct Entry
+  {
+    Future<Secret::Value> resolution;
+
+    // Set once the resolution completes; `None` while in flight.
+    Option<Timeout> expiry;
+  };
+
+  void _resolve(const string& key, const Future<Secret::Value>& resolution)
+  {
+    // The entry might have been replaced after expiring while this
+    // resolution was still in flight.
+    if (!entries.contains(key) ||
+        !(entries.at(key).resolution == resolution)) {
+      return;
+    }
+
+    if (resolution.isReady()) {
+      entries.at(key).expiry = Timeout::in(ttl);
+    } else if (resolution.isFailed() && negativeTtl.isSome()) {
+      // Cache the failure to protect the backend from retry storms.
+      entries.at(key).expiry = Timeout::in(negativeTtl.get());
+    } else {
+      entries.erase(key);
+    }
+  }
+
+  const Owned<SecretResolver> resolver;
+  const Duration ttl;
+  const Option<Duration> negativeTtl;
+
+  // Cached resolutions, keyed by the serialized secret reference.
+  hashmap<string, Entry> entries;
+};
+
+
+class CachingSecretResolver : public SecretResolver
+{
+public:
+  CachingSecretResolver(
+      const Owned<SecretResolver>& resolver,
+      const Duration& ttl,
+      const Option<Duration>& negativeTtl)
+    : process(new CachingSecretResolverProcess(resolver, ttl, negativeTtl))
+  {
+    spawn(CHECK_NOTNULL(process.get()));
+  }
+
+  ~CachingSecretResolver() override
+  {
+    terminate(process.get());
+    process::wait(process.get());
+  }
+
+  Future<Secret::Value> resolve(const Secret& secret) const override
+  {
+    return dispatch(
+        process.get(), &CachingSecretResolverProcess::resolve, secret);
+  }
+
+private:
+  Owned<CachingSecretResolverProcess> process;
+};
+
 } // namespace internal {
 
 
-Try<SecretResolver*> SecretResolver::create(const Option<string>& moduleName)
+Try<SecretResolver*> SecretResolver::create(
+    const Option<string>& moduleName,
+    const Option<Duration>& cacheTtl,
+    const Option<Duration>& negativeCacheTtl)
 {
+  SecretResolver* resolver = nullptr;
+
   if (moduleName.isNone()) {
     LOG(INFO) << "Creating default secret resolver";
-    return new internal::DefaultSecretResolver();
-  }
+    resolver = new internal::DefaultSecretResolver();
+  } else {
+    LOG(INFO) << "Creating secret resolver '" << moduleName.get() << "'";
+
+    Try<SecretResolver*> result =
+      modules::ModuleManager::create<SecretResolver>(moduleName.get());
 
-  LOG(INFO) << "Creating secret resolver '" << moduleName.get() << "'";
+    if (result.isError()) {
+      return Error("Failed to initialize secret resolver: " + result.error());
+    }
+
+    resolver = result.get();
+  }
 
-  Try<SecretResolver*> result =
-    modules::ModuleManager::create<SecretResolver>(moduleName.get());
+  if (cacheTtl.isSome()) {
+    LOG(INFO) << "Caching resolved secrets for " << cacheTtl.get();
 
-  if (result.isError()) {
-    return Error("Failed to initialize secret resolver: " + result.error());
+    resolver = new internal::CachingSecretResolver(
+        process::Owned<SecretResolver>(resolver),
+        cacheTtl.get(),
+        negativeCacheTtl);
   }
 
-  return result;
+  return resolver;
 }
 
 } // namespace mesos {
@@ -80,9 +80,22 @@ constexpr Duration DEFAULT_AUTHENTICATION_TIMEOUT_MAX = Minutes(1);
 constexpr Duration GC_DELAY = Weeks(1);
 constexpr Duration DISK_WATCH_INTERVAL = Minutes(1);
 
+// Maximum time to wait for a container's resource statistics to be
+// collected before giving up and serving partial results.
+constexpr Duration CONTAINER_USAGE_COLLECTION_TIMEOUT = Seconds(10);
+
+// Window during which collected per-container resource statistics
+// are reused, so that multiple monitoring requests arriving close
+// together share a single collection.
+constexpr Duration CONTAINER_USAGE_CACHE_WINDOW = Seconds(1);
+
 // Minimum free disk capacity enforced by the garbage collector.
 constexpr double GC_DISK_HEADROOM = 0.1;
 
+// Default number of workers that remove garbage collected
+// directories in parallel.
+constexpr size_t GC_WORKERS = 1;
+
 // Maximum number of completed frameworks to store in memory.
 constexpr size_t MAX_COMPLETED_FRAMEWORKS = 50;
 
@@ -26,6 +26,7 @@
 #include <process/id.hpp>
 #include <process/io.hpp>
 #include <process/process.hpp>
+#include <process/subprocess.hpp>
 
 #include <stout/bytes.hpp>
 #include <stout/error.hpp>
@@ -35,8 +36,8 @@
 #include <stout/stringify.hpp>
 #include <stout/try.hpp>
 
+#include <stout/os/constants.hpp>
 #include <stout/os/pagesize.hpp>
-#include <stout/os/shell.hpp>
 #include <stout/os/su.hpp>
 #include <stout/os/write.hpp>
 
@@ -56,7 +57,8 @@ public:
     : ProcessBase(process::ID::generate("logrotate-logger")),
       flags(_flags),
       leading(None()),
-      bytesWritten(0)
+      bytesWritten(0),
+      rotating(false)
   {
     // Prepare a buffer for reading from the `incoming` pipe.
     length = os::pagesize();
@@ -185,6 +187,14 @@ public:
   // Calls `logrotate` on the leading log file and resets the `bytesWritten`.
   void rotate()
   {
+    // A rotation (possibly including compression, depending on the
+    // `--logrotate_options`) may still be in flight. Don't pile up
+    // `logrotate` invocations; the next write exceeding the max size
+    // will trigger another rotation.
+    if (rotating) {
+      return;
+    }
+
     if (leading.isSome()) {
       os::close(leading.get());
       leading = None();
@@ -195,10 +205,40 @@ public:
     // the error and continue logging.  In case the leading log file
     // is not renamed, we will continue appending to the existing
     // leading log file.
-    os::shell(
-        flags.logrotate_path +
-        " --state \"" + flags.log_filename.get() + STATE_SUFFIX + "\" \"" +
-        flags.log_filename.get() + CONF_SUFFIX + "\"");
+    //
+    // NOTE: We run `logrotate` asynchronously so that draining the
+    // input pipe (and hence the container's writes) does not stall
+    // for the duration of the rotation, e.g., when the options
+    // enable compression. Bytes arriving while the rotation is in
+    // flight may end up in the rotated file rather than the fresh
+    // leading log file; we prefer this over blocking the container.
+    Try<Subprocess> s = subprocess(
+        flags.logrotate_path,
+        {flags.logrotate_path,
+         "--state", flags.log_filename.get() + STATE_SUFFIX,
+         flags.log_filename.get() + CONF_SUFFIX},
+        Subprocess::PATH(os::DEV_NULL),
+        Subprocess::PATH(os::DEV_NULL),
+        Subprocess::FD(STDERR_FILENO));
+
+    if (s.isSome()) {
+      rotating = true;
+
+      s->status()
+        .onAny(defer(self(), [this](const Future<Option<int>>&) {
+          rotating = false;
+
+          // `logrotate` may have renamed the file we are currently
+          // appending to; close it so that the next write reopens
+          // the fresh leading log file.
+          if (leading.isSome()) {
+            os::close(leading.get());
+            leading = None();
+          }
+        }));
+    } else {
+      std::cerr << "Failed to run logrotate: " << s.error() << std::endl;
+    }
 
     // Reset the number of bytes written.
     bytesWritten = 0;
@@ -215,6 +255,9 @@ private:
   Option<int> leading;
   size_t bytesWritten;
 
+  // Whether a `logrotate` invocation is currently in flight.
+  bool rotating;
+
   // Used to capture when log rotation has completed because the
   // underlying process/input has terminated.
   Promise<Nothing> promise;
@@ -254,6 +254,9 @@ void Fetcher::kill(const ContainerID& containerId)
 FetcherProcess::Metrics::Metrics(FetcherProcess *fetcher)
   : task_fetches_succeeded("containerizer/fetcher/task_fetches_succeeded"),
     task_fetches_failed("containerizer/fetcher/task_fetches_failed"),
+    cache_hits("containerizer/fetcher/cache_hits"),
+    cache_misses("containerizer/fetcher/cache_misses"),
+    cache_inserted_bytes("containerizer/fetcher/cache_inserted_bytes"),
     cache_size_total_bytes(
         "containerizer/fetcher/cache_size_total_bytes",
         [=]() {
@@ -269,6 +272,9 @@ FetcherProcess::Metrics::Metrics(FetcherProcess *fetcher)
 {
   process::metrics::add(task_fetches_succeeded);
   process::metrics::add(task_fetches_failed);
+  process::metrics::add(cache_hits);
+  process::metrics::add(cache_misses);
+  process::metrics::add(cache_inserted_bytes);
   process::metrics::add(cache_size_total_bytes);
   process::metrics::add(cache_size_used_bytes);
 }
@@ -278,6 +284,9 @@ FetcherProcess::Metrics::~Metrics()
 {
   process::metrics::remove(task_fetches_succeeded);
   process::metrics::remove(task_fetches_failed);
+  process::metrics::remove(cache_hits);
+  process::metrics::remove(cache_misses);
+  process::metrics::remove(cache_inserted_bytes);
 
   // Wait for the metrics to be removed before we allow the destructor
   // to complete.
@@ -418,6 +427,8 @@ Future<Nothing> FetcherProcess::fetch(
       cache.get(commandUser, uri.value());
 
     if (entry.isSome()) {
+      ++metrics.cache_hits;
+
       entry.get()->reference();
 
       // Wait for the URI to be downloaded into the cache (or fail)
@@ -426,6 +437,8 @@ Future<Nothing> FetcherProcess::fetch(
           return Future<shared_ptr<Cache::Entry>>(entry.get());
         }));
     } else {
+      ++metrics.cache_misses;
+
       shared_ptr<Cache::Entry> newEntry =
         cache.create(cacheDirectory, commandUser, uri);
 
@@ -600,6 +613,8 @@ Future<Nothing> FetcherProcess::__fetch(
 
             Try<Nothing> adjust = cache.adjust(entry.get());
             if (adjust.isSome()) {
+              metrics.cache_inserted_bytes += entry.get()->size.bytes();
+
               entry.get()->complete();
             } else {
               LOG(WARNING) << "Failed to adjust the cache size for entry '"
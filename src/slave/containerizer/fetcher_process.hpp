@@ -261,6 +261,18 @@ private:
     process::metrics::Counter task_fetches_succeeded;
     process::metrics::Counter task_fetches_failed;
 
+    // NOTE: Unlike the task fetch metrics above, these metrics are
+    // incremented once per cachable URI: a fetch counts as a hit if
+    // a cache entry for the URI already exists (even if it is still
+    // being downloaded by a concurrent fetch) and as a miss
+    // otherwise.
+    process::metrics::Counter cache_hits;
+    process::metrics::Counter cache_misses;
+
+    // Total number of bytes inserted into the cache by successful
+    // downloads of cachable URIs.
+    process::metrics::Counter cache_inserted_bytes;
+
     process::metrics::PullGauge cache_size_total_bytes;
     process::metrics::PullGauge cache_size_used_bytes;
   } metrics;
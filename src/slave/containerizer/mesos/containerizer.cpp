@@ -24,6 +24,7 @@
 
 #include <mesos/slave/isolator.hpp>
 
+#include <process/async.hpp>
 #include <process/collect.hpp>
 #include <process/defer.hpp>
 #include <process/http.hpp>
@@ -52,6 +53,7 @@
 #include <stout/os/wait.hpp>
 
 #include "common/protobuf_utils.hpp"
+#include "common/tracepoints.hpp"
 
 #include "hook/manager.hpp"
 
@@ -1218,6 +1220,8 @@ Future<Containerizer::LaunchResult> MesosContainerizerProcess::launch(
     const map<string, string>& environment,
     const Option<std::string>& pidCheckpointPath)
 {
+  MESOS_TRACEPOINT1(containerizer_launch, stringify(containerId).c_str());
+
   if (containers_.contains(containerId)) {
     return Containerizer::LaunchResult::ALREADY_LAUNCHED;
   }
@@ -1477,6 +1481,8 @@ Future<Nothing> MesosContainerizerProcess::prepare(
   // Captured for lambdas below.
   ContainerConfig containerConfig = container->config.get();
 
+  transition(containerId, PREPARING);
+
   // Checkpoint the `ContainerConfig` which includes all information to launch a
   // container. Critical information (e.g., `ContainerInfo`) can be used for
   // tracking container image usage.
@@ -1484,23 +1490,24 @@ Future<Nothing> MesosContainerizerProcess::prepare(
       containerizer::paths::getRuntimePath(flags.runtime_dir, containerId),
       containerizer::paths::CONTAINER_CONFIG_FILE);
 
-  Try<Nothing> configCheckpointed =
-    slave::state::checkpoint(configPath, containerConfig);
-
-  if (configCheckpointed.isError()) {
-    return Failure("Failed to checkpoint the container config to '" +
-                   configPath + "': " + configCheckpointed.error());
-  }
-
-  VLOG(1) << "Checkpointed ContainerConfig at '" << configPath << "'";
+  // The checkpoint is performed on a worker thread so that the disk
+  // write does not block the containerizer actor, allowing launches of
+  // sibling containers to proceed while the config is being written.
+  Future<vector<Option<ContainerLaunchInfo>>> f =
+    process::async([configPath, containerConfig]() {
+      return slave::state::checkpoint(configPath, containerConfig);
+    })
+    .then([configPath](const Try<Nothing>& checkpointed)
+        -> Future<vector<Option<ContainerLaunchInfo>>> {
+      if (checkpointed.isError()) {
+        return Failure("Failed to checkpoint the container config to '" +
+                       configPath + "': " + checkpointed.error());
+      }
 
-  transition(containerId, PREPARING);
+      VLOG(1) << "Checkpointed ContainerConfig at '" << configPath << "'";
 
-  // We prepare the isolators sequentially according to their ordering
-  // to permit basic dependency specification, e.g., preparing a
-  // filesystem isolator before other isolators.
-  Future<vector<Option<ContainerLaunchInfo>>> f =
-    vector<Option<ContainerLaunchInfo>>();
+      return vector<Option<ContainerLaunchInfo>>();
+    });
 
   foreach (const Owned<Isolator>& isolator, isolators) {
     if (!isSupportedByIsolator(
@@ -1547,6 +1554,18 @@ Future<Nothing> MesosContainerizerProcess::fetch(
 
   const string directory = container->config->directory();
 
+  // If there is nothing to fetch, skip the fetcher entirely: it forks
+  // a `mesos-fetcher` subprocess even for an empty URI set, which
+  // measurably slows down launches of nested containers (which rarely
+  // specify URIs) on the critical path.
+  if (container->config->command_info().uris().empty()) {
+    if (HookManager::hooksAvailable()) {
+      HookManager::slavePostFetchHook(containerId, directory);
+    }
+
+    return Nothing();
+  }
+
   return fetcher->fetch(
       containerId,
       container->config->command_info(),
@@ -2077,7 +2096,7 @@ Future<Containerizer::LaunchResult> MesosContainerizerProcess::_launch(
   argv[0] = path::join(flags.launcher_dir, MESOS_CONTAINERIZER);
   argv[1] = MesosContainerizerLaunch::NAME;
 
-  Try<pid_t> forked = launcher->fork(
+  return launcher->fork(
       containerId,
       initPath,
       argv,
@@ -2088,18 +2107,57 @@ Future<Containerizer::LaunchResult> MesosContainerizerProcess::_launch(
       _enterNamespaces,
       // 'cloneNamespaces' will be ignored by SubprocessLauncher.
       _cloneNamespaces,
-      whitelistFds);
+      whitelistFds)
+    .repair([pipes](const Future<pid_t>& future) -> Future<pid_t> {
+      os::close(pipes[0]);
+      os::close(pipes[1]);
+
+      return Failure("Failed to fork: " + future.failure());
+    })
+    .then(defer(
+        self(),
+        &Self::__launch,
+        containerId,
+        pidCheckpointPath,
+        pipes,
+        lambda::_1));
+}
+
+
+Future<Containerizer::LaunchResult> MesosContainerizerProcess::__launch(
+    const ContainerID& containerId,
+    const Option<string>& pidCheckpointPath,
+    const std::array<int_fd, 2>& pipes,
+    pid_t pid)
+{
+  // The container may have been destroyed while the launcher was
+  // forking, in which case we must not leak the child process.
+  if (!containers_.contains(containerId)) {
+    process::reap(pid);
 
-  if (forked.isError()) {
     os::close(pipes[0]);
     os::close(pipes[1]);
 
-    return Failure("Failed to fork: " + forked.error());
+    return Failure("Container destroyed during forking");
   }
 
-  pid_t pid = forked.get();
+  const Owned<Container>& container = containers_.at(containerId);
+
   container->pid = pid;
 
+  if (container->state == DESTROYING) {
+    // Monitor the child so that the destroy path can wait for its
+    // exit status. Closing the pipes without writing the synchronize
+    // byte makes the child exit on its own.
+    container->status = reap(containerId, pid);
+    container->status->onAny(defer(self(), &Self::reaped, containerId));
+
+    os::close(pipes[0]);
+    os::close(pipes[1]);
+
+    return Failure("Container is being destroyed during forking");
+  }
+
   // Checkpoint the forked pid if requested by the agent.
   if (pidCheckpointPath.isSome()) {
     LOG_BASED_ON_CLASS(container->containerClass())
@@ -2136,7 +2194,8 @@ Future<Containerizer::LaunchResult> MesosContainerizerProcess::_launch(
       containerizer::paths::getRuntimePath(flags.runtime_dir, containerId),
       containerizer::paths::PID_FILE);
 
-  checkpointed = slave::state::checkpoint(pidPath, stringify(pid));
+  Try<Nothing> checkpointed =
+    slave::state::checkpoint(pidPath, stringify(pid));
 
   if (checkpointed.isError()) {
     os::close(pipes[0]);
@@ -3184,6 +3243,11 @@ void MesosContainerizerProcess::transition(
     << "Transitioning the state of container " << containerId << " from "
     << container->state << " to " << state;
 
+  MESOS_TRACEPOINT2(
+      containerizer_transition,
+      stringify(containerId).c_str(),
+      static_cast<int>(state));
+
   container->state = state;
 }
 
@@ -17,6 +17,7 @@
 #ifndef __MESOS_CONTAINERIZER_HPP__
 #define __MESOS_CONTAINERIZER_HPP__
 
+#include <array>
 #include <vector>
 
 #include <mesos/secret/resolver.hpp>
@@ -262,6 +263,13 @@ private:
       const std::map<std::string, std::string>& environment,
       const Option<std::string>& pidCheckpointPath);
 
+  // Continues '_launch()' once the launcher has forked the container.
+  process::Future<Containerizer::LaunchResult> __launch(
+      const ContainerID& containerId,
+      const Option<std::string>& pidCheckpointPath,
+      const std::array<int_fd, 2>& pipes,
+      pid_t pid);
+
   process::Future<Nothing> isolate(
       const ContainerID& containerId,
       pid_t _pid);
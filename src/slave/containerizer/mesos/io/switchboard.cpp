@@ -17,6 +17,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <array>
 #include <list>
 #include <map>
 #include <string>
@@ -40,6 +41,7 @@
 #include <process/socket.hpp>
 #include <process/subprocess.hpp>
 
+#include <stout/abort.hpp>
 #include <stout/hashmap.hpp>
 #include <stout/option.hpp>
 #include <stout/os.hpp>
@@ -47,6 +49,7 @@
 #include <stout/recordio.hpp>
 
 #include <stout/os/constants.hpp>
+#include <stout/os/signals.hpp>
 
 #ifndef __WINDOWS__
 #include <stout/posix/os.hpp>
@@ -64,6 +67,8 @@
 #include "common/recordio.hpp"
 #include "common/status_utils.hpp"
 
+#include "logging/logging.hpp"
+
 #ifdef __linux__
 #include "linux/systemd.hpp"
 #endif // __linux__
@@ -71,6 +76,7 @@
 #include "slave/flags.hpp"
 #include "slave/state.hpp"
 
+#include "slave/containerizer/mesos/constants.hpp"
 #include "slave/containerizer/mesos/paths.hpp"
 
 #include "slave/containerizer/mesos/io/switchboard.hpp"
@@ -587,9 +593,13 @@ Future<Option<ContainerLaunchInfo>> IOSwitchboard::_prepare(
   // switchboard process itself. In this way, the io switchboard
   // process simply needs to write to its own `stdout` and
   // `stderr` in order to send output to the logger files.
+  //
+  // NOTE: We run the server as a subcommand of the multi-call
+  // 'mesos-containerizer' helper (whose pages are already resident
+  // from the launch helper) rather than as a separate binary.
   Try<Subprocess> child = subprocess(
-      path::join(flags.launcher_dir, IOSwitchboardServer::NAME),
-      {IOSwitchboardServer::NAME},
+      path::join(flags.launcher_dir, MESOS_CONTAINERIZER),
+      {MESOS_CONTAINERIZER, IOSwitchboardServerSubcommand::NAME},
       Subprocess::PATH(os::DEV_NULL),
       loggerIO.out,
       loggerIO.err,
@@ -956,6 +966,119 @@ void IOSwitchboard::reaped(
 const char IOSwitchboardServer::NAME[] = "mesos-io-switchboard";
 
 
+const char IOSwitchboardServerSubcommand::NAME[] = "io-switchboard";
+
+
+// We use a pipe to forcibly unblock an io switchboard server and
+// cause it to gracefully shutdown after receiving a SIGTERM signal.
+//
+// TODO(klueska): Ideally we would use `libevent` or `libev`s built in
+// support to defer a signal handler to a thread, but we currently
+// don't expose this through libprocess. Once we do expose this, we
+// should change this logic to use it.
+static std::array<int_fd, 2> unblockFds;
+
+static void sigtermHandler(int sig)
+{
+  int write = -1;
+  do {
+    write = ::write(unblockFds[1], "\0", 1);
+  } while (write == -1 && errno == EINTR);
+
+  ::close(unblockFds[1]);
+
+  if (write == -1) {
+    ABORT("Failed to terminate io switchboard gracefully");
+  }
+}
+
+
+int IOSwitchboardServerSubcommand::run(const IOSwitchboardServer::Flags& flags)
+{
+  mesos::internal::logging::initialize(IOSwitchboardServer::NAME, false);
+
+  // Verify non-optional flags have valid values.
+  if (flags.stdin_to_fd.isNone()) {
+    EXIT(EXIT_FAILURE) << flags.usage("'--stdin_to_fd' is missing");
+  }
+
+  if (flags.stdout_from_fd.isNone()) {
+    EXIT(EXIT_FAILURE) << flags.usage("'--stdout_from_fd' is missing");
+  }
+
+  if (flags.stdout_to_fd.isNone()) {
+    EXIT(EXIT_FAILURE) << flags.usage("'--stdout_to_fd' is missing");
+  }
+
+  if (flags.stderr_from_fd.isNone()) {
+    EXIT(EXIT_FAILURE) << flags.usage("'--stderr_from_fd' is missing");
+  }
+
+  if (flags.stderr_to_fd.isNone()) {
+    EXIT(EXIT_FAILURE) << flags.usage("'--stderr_to_fd' is missing");
+  }
+
+  if (flags.socket_path.isNone()) {
+    EXIT(EXIT_FAILURE) << flags.usage("'--socket_path' is missing");
+  }
+
+  Try<std::array<int_fd, 2>> pipe = os::pipe();
+  if (pipe.isError()) {
+    EXIT(EXIT_FAILURE) << "Failed to create pipe for signaling unblock:"
+                       << " " + pipe.error();
+  }
+
+  unblockFds = pipe.get();
+
+  if (os::signals::install(SIGTERM, sigtermHandler) != 0) {
+    EXIT(EXIT_FAILURE) << "Failed to register signal"
+                       << " '" + stringify(strsignal(SIGTERM)) << "'";
+  }
+
+  Try<Owned<IOSwitchboardServer>> server = IOSwitchboardServer::create(
+      flags.tty,
+      flags.stdin_to_fd.get(),
+      flags.stdout_from_fd.get(),
+      flags.stdout_to_fd.get(),
+      flags.stderr_from_fd.get(),
+      flags.stderr_to_fd.get(),
+      flags.socket_path.get(),
+      flags.wait_for_connection,
+      flags.heartbeat_interval);
+
+  if (server.isError()) {
+    EXIT(EXIT_FAILURE) << "Failed to create the io switchboard server:"
+                          " " << server.error();
+  }
+
+  process::io::poll(unblockFds[0], process::io::READ)
+    .onAny([server](const Future<short>& future) {
+      os::close(unblockFds[0]);
+
+      if (!future.isReady()) {
+        EXIT(EXIT_FAILURE) << "Failed while polling on 'unblockFds[0]': "
+                           << (future.isFailed() ?
+                               future.failure() :
+                               "discarded");
+      }
+
+      server.get()->unblock();
+    });
+
+  Future<Nothing> run = server.get()->run();
+  run.await();
+
+  server->reset();
+
+  if (!run.isReady()) {
+    EXIT(EXIT_FAILURE) << "The io switchboard server failed: "
+                       << (run.isFailed() ? run.failure() : "discarded");
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
 class IOSwitchboardServerProcess : public Process<IOSwitchboardServerProcess>
 {
 public:
@@ -1484,9 +1607,10 @@ Future<http::Response> IOSwitchboardServerProcess::handler(
     Owned<recordio::Reader<agent::Call>> reader(
         new recordio::Reader<agent::Call>(
             ::recordio::Decoder<agent::Call>(lambda::bind(
-                deserialize<agent::Call>,
+                deserializeSlice<agent::Call>,
                 messageContentType.get(),
-                lambda::_1)),
+                lambda::_1,
+                lambda::_2)),
             request.reader.get()));
 
     return reader->read()
@@ -24,6 +24,7 @@
 #include <process/owned.hpp>
 #include <process/socket.hpp>
 
+#include <stout/subcommand.hpp>
 #include <stout/try.hpp>
 
 #include <mesos/slave/containerizer.hpp>
@@ -269,6 +270,31 @@ private:
 
   process::Owned<IOSwitchboardServerProcess> process;
 };
+
+
+// Subcommand of 'mesos-containerizer' that runs the io switchboard
+// server. Folding the server into the multi-call helper means a
+// container launch execs a single helper binary whose text pages
+// and library dependencies are already resident from the launch
+// subcommand, instead of paying the load cost of a separate binary.
+class IOSwitchboardServerSubcommand : public Subcommand
+{
+public:
+  static const char NAME[];
+
+  // Runs the server until it exits. Also used by the standalone
+  // 'mesos-io-switchboard' binary, which is kept around for
+  // backwards compatibility.
+  static int run(const IOSwitchboardServer::Flags& flags);
+
+  IOSwitchboardServerSubcommand() : Subcommand(NAME) {}
+
+  IOSwitchboardServer::Flags flags;
+
+protected:
+  int execute() override { return run(flags); }
+  flags::FlagsBase* getFlags() override { return &flags; }
+};
 #endif // __WINDOWS__
 
 } // namespace slave {
@@ -28,6 +28,7 @@
 #include <stout/option.hpp>
 #include <stout/os.hpp>
 #include <stout/result.hpp>
+#include <stout/strings.hpp>
 
 #include "common/protobuf_utils.hpp"
 
@@ -313,10 +314,30 @@ Future<ResourceStatistics> MemorySubsystemProcess::usage(
 
   ResourceStatistics result;
 
+  // Keep the statistics files open across collection passes so that
+  // the (deep) cgroup paths are not re-resolved on every pass.
+  if (info->usageFile.isNone()) {
+    info->usageFile =
+      cgroups::ControlFile(hierarchy, cgroup, "memory.usage_in_bytes");
+
+    info->statFile = cgroups::ControlFile(hierarchy, cgroup, "memory.stat");
+
+    if (flags.cgroups_limit_swap) {
+      info->memswUsageFile =
+        cgroups::ControlFile(hierarchy, cgroup, "memory.memsw.usage_in_bytes");
+    }
+  }
+
   // The rss from memory.stat is wrong in two dimensions:
   //   1. It does not include child cgroups.
   //   2. It does not include any file backed pages.
-  Try<Bytes> usage = cgroups::memory::usage_in_bytes(hierarchy, cgroup);
+  Try<string> read = info->usageFile->read();
+
+  if (read.isError()) {
+    return Failure("Failed to read 'memory.usage_in_bytes': " + read.error());
+  }
+
+  Try<Bytes> usage = Bytes::parse(strings::trim(read.get()) + "B");
 
   if (usage.isError()) {
     return Failure("Failed to parse 'memory.usage_in_bytes': " + usage.error());
@@ -325,7 +346,14 @@ Future<ResourceStatistics> MemorySubsystemProcess::usage(
   result.set_mem_total_bytes(usage->bytes());
 
   if (flags.cgroups_limit_swap) {
-    Try<Bytes> usage = cgroups::memory::memsw_usage_in_bytes(hierarchy, cgroup);
+    Try<string> read = info->memswUsageFile->read();
+
+    if (read.isError()) {
+      return Failure(
+        "Failed to read 'memory.memsw.usage_in_bytes': " + read.error());
+    }
+
+    Try<Bytes> usage = Bytes::parse(strings::trim(read.get()) + "B");
 
     if (usage.isError()) {
       return Failure(
@@ -335,15 +363,19 @@ Future<ResourceStatistics> MemorySubsystemProcess::usage(
     result.set_mem_total_memsw_bytes(usage->bytes());
   }
 
+  read = info->statFile->read();
+
+  if (read.isError()) {
+    return Failure("Failed to read 'memory.stat': " + read.error());
+  }
+
   // TODO(bmahler): Add namespacing to cgroups to enforce the expected
   // structure, e.g, cgroups::memory::stat.
-  Try<hashmap<string, uint64_t>> stat = cgroups::stat(
-      hierarchy,
-      cgroup,
-      "memory.stat");
+  Try<hashmap<string, uint64_t>> stat =
+    cgroups::stat("memory.stat", read.get());
 
   if (stat.isError()) {
-    return Failure("Failed to read 'memory.stat': " + stat.error());
+    return Failure("Failed to parse 'memory.stat': " + stat.error());
   }
 
   Option<uint64_t> total_cache = stat->get("total_cache");
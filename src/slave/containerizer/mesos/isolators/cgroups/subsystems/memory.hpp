@@ -91,6 +91,12 @@ private:
         process::Owned<cgroups::memory::pressure::Counter>> pressureCounters;
 
     process::Promise<mesos::slave::ContainerLimitation> limitation;
+
+    // Statistics files, kept open across collection passes (see
+    // `cgroups::ControlFile`). Opened on the first `usage()` call.
+    Option<cgroups::ControlFile> usageFile;
+    Option<cgroups::ControlFile> memswUsageFile;
+    Option<cgroups::ControlFile> statFile;
   };
 
   MemorySubsystemProcess(const Flags& flags, const std::string& hierarchy);
@@ -14,10 +14,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <process/defer.hpp>
 #include <process/delay.hpp>
 #include <process/id.hpp>
-#include <process/reap.hpp>
 
 #include <stout/duration.hpp>
 #include <stout/error.hpp>
@@ -26,12 +24,10 @@
 
 #include "slave/containerizer/mesos/isolators/cgroups/subsystems/perf_event.hpp"
 
-using process::Clock;
 using process::Failure;
 using process::Future;
 using process::Owned;
 using process::PID;
-using process::Time;
 
 using std::set;
 using std::string;
@@ -51,29 +47,24 @@ Try<Owned<SubsystemProcess>> PerfEventSubsystemProcess::create(
         new PerfEventSubsystemProcess(flags, hierarchy, set<string>{}));
   }
 
-  if (!perf::supported()) {
-    return Error("Perf is not supported");
-  }
-
-  if (flags.perf_duration > flags.perf_interval) {
-    return Error(
-        "Sampling perf for duration (" + stringify(flags.perf_duration) + ") > "
-        "interval (" + stringify(flags.perf_interval) + ") is not supported.");
-  }
-
   set<string> events;
   foreach (const string& event,
            strings::tokenize(flags.perf_events.get(), ",")) {
     events.insert(event);
   }
 
-  if (!perf::valid(events)) {
-    return Error("Invalid perf events: " + stringify(events));
+  // Verify that the events are supported and that the kernel lets us
+  // open cgroup-scoped counters by opening (and promptly discarding)
+  // a counter group against the root of the hierarchy.
+  Try<Owned<perf::Counters>> counters =
+    perf::Counters::create(events, hierarchy, "/");
+
+  if (counters.isError()) {
+    return Error("Failed to open perf counters: " + counters.error());
   }
 
-  LOG(INFO) << "perf_event subsystem will profile for "
-            << "'" << flags.perf_duration << "' "
-            << "every '" << flags.perf_interval << "' "
+  LOG(INFO) << "perf_event subsystem will sample every "
+            << "'" << flags.perf_interval << "' "
             << "for events: " << stringify(events);
 
   return Owned<SubsystemProcess>(
@@ -107,7 +98,23 @@ Future<Nothing> PerfEventSubsystemProcess::recover(
     return Failure("The subsystem '" + name() + "' has already been recovered");
   }
 
-  infos.put(containerId, Owned<Info>(new Info(cgroup)));
+  Owned<Info> info(new Info(cgroup));
+
+  // Counters that cannot be reopened should not fail agent recovery;
+  // the container simply reports no further perf statistics.
+  if (!events.empty()) {
+    Try<Owned<perf::Counters>> counters =
+      perf::Counters::create(events, hierarchy, cgroup);
+
+    if (counters.isError()) {
+      LOG(WARNING) << "Failed to open perf counters for recovered cgroup "
+                   << "'" << cgroup << "': " << counters.error();
+    } else {
+      info->counters = counters.get();
+    }
+  }
+
+  infos.put(containerId, info);
 
   return Nothing();
 }
@@ -121,7 +128,22 @@ Future<Nothing> PerfEventSubsystemProcess::prepare(
     return Failure("The subsystem '" + name() + "' has already been prepared");
   }
 
-  infos.put(containerId, Owned<Info>(new Info(cgroup)));
+  Owned<Info> info(new Info(cgroup));
+
+  if (!events.empty()) {
+    Try<Owned<perf::Counters>> counters =
+      perf::Counters::create(events, hierarchy, cgroup);
+
+    if (counters.isError()) {
+      return Failure(
+          "Failed to open perf counters for cgroup '" + cgroup + "'"
+          ": " + counters.error());
+    }
+
+    info->counters = counters.get();
+  }
+
+  infos.put(containerId, info);
 
   return Nothing();
 }
@@ -163,59 +185,29 @@ Future<Nothing> PerfEventSubsystemProcess::cleanup(
 
 void PerfEventSubsystemProcess::sample()
 {
-  // Collect a perf sample for all cgroups that are not being
-  // destroyed. Since destroyal is asynchronous, 'perf stat' may
-  // fail if the cgroup is destroyed before running perf.
-  set<string> cgroups;
-
+  // Refresh the statistics of every container from its counters.
+  // Each refresh is a single read(2) per CPU, so unlike the former
+  // 'perf stat' subprocess there is no need for a timeout.
   foreachvalue (const Owned<Info>& info, infos) {
-    cgroups.insert(info->cgroup);
-  }
+    if (info->counters.get() == nullptr) {
+      continue;
+    }
 
-  // The discard timeout includes an allowance of twice the
-  // reaper interval to ensure we see the perf process exit.
-  Duration timeout = flags.perf_duration + process::MAX_REAP_INTERVAL() * 2;
-  Duration duration = flags.perf_duration;
-
-  perf::sample(events, cgroups, flags.perf_duration)
-    .after(timeout, [=](Future<hashmap<string, PerfStatistics>> future) {
-      LOG(ERROR) << "Perf sample of " << stringify(duration)
-                 << " failed to complete within " << stringify(timeout)
-                 << "; sampling will be halted";
-
-      future.discard();
-
-      return future;
-    })
-    .onAny(defer(PID<PerfEventSubsystemProcess>(this),
-                 &PerfEventSubsystemProcess::_sample,
-                 Clock::now() + flags.perf_interval,
-                 lambda::_1));
-}
+    Try<PerfStatistics> statistics = info->counters->sample();
 
+    if (statistics.isError()) {
+      // In case the failure is transient, we continue sampling.
+      LOG(ERROR) << "Failed to sample perf counters for cgroup "
+                 << "'" << info->cgroup << "': " << statistics.error();
 
-void PerfEventSubsystemProcess::_sample(
-    const Time& next,
-    const Future<hashmap<string, PerfStatistics>>& statistics)
-{
-  if (!statistics.isReady()) {
-    // In case the failure is transient or this is due to a timeout,
-    // we continue sampling. Note that since sampling is done on an
-    // interval, it should be ok if this is a non-transient failure.
-    LOG(ERROR) << "Failed to get the perf sample: "
-               << (statistics.isFailed() ? statistics.failure() : "timeout");
-  } else {
-    // Store the latest statistics, note that cgroups added in the
-    // interim will be picked up by the next sample.
-    foreachvalue (const Owned<Info>& info, infos) {
-      if (statistics->contains(info->cgroup)) {
-        info->statistics = statistics->get(info->cgroup).get();
-      }
+      continue;
     }
+
+    info->statistics = statistics.get();
   }
 
   // Schedule sample for the next time.
-  delay(next - Clock::now(),
+  delay(flags.perf_interval,
         PID<PerfEventSubsystemProcess>(this),
         &PerfEventSubsystemProcess::sample);
 }
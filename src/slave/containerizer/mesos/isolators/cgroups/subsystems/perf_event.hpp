@@ -25,10 +25,11 @@
 #include <process/clock.hpp>
 #include <process/future.hpp>
 #include <process/owned.hpp>
-#include <process/time.hpp>
 
 #include <stout/hashmap.hpp>
 
+#include "linux/perf.hpp"
+
 #include "slave/flags.hpp"
 
 #include "slave/containerizer/mesos/isolators/cgroups/constants.hpp"
@@ -95,14 +96,14 @@ private:
 
     const std::string cgroup;
     PerfStatistics statistics;
+
+    // In-process counters for the cgroup; remains unset if the
+    // counters could not be opened during recovery.
+    process::Owned<perf::Counters> counters;
   };
 
   void sample();
 
-  void _sample(
-      const process::Time& next,
-      const process::Future<hashmap<std::string, PerfStatistics>>& statistics);
-
   // Set of events to sample.
   std::set<std::string> events;
 
@@ -106,6 +106,7 @@ static Try<set<Gpu>> enumerateGpus(
     Gpu gpu;
     gpu.major = NVIDIA_MAJOR_DEVICE;
     gpu.minor = minor.get();
+    gpu.handle = handle.get();
 
     gpus.insert(gpu);
   }
@@ -17,6 +17,8 @@
 #ifndef __NVIDIA_GPU_ALLOCATOR_HPP__
 #define __NVIDIA_GPU_ALLOCATOR_HPP__
 
+#include <nvidia/gdk/nvml.h>
+
 #include <iosfwd>
 #include <memory>
 #include <set>
@@ -43,6 +45,11 @@ struct Gpu
 {
   unsigned int major;
   unsigned int minor;
+
+  // Cached NVML device handle. Handles remain valid as long as the
+  // NVML library stays loaded, so we look them up once during GPU
+  // enumeration rather than on every NVML query.
+  nvmlDevice_t handle;
 };
 
 
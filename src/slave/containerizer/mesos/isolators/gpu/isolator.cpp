@@ -32,6 +32,7 @@ extern "C" {
 #include <string>
 #include <vector>
 
+#include <process/async.hpp>
 #include <process/collect.hpp>
 #include <process/defer.hpp>
 #include <process/future.hpp>
@@ -530,10 +531,47 @@ Future<ResourceStatistics> NvidiaGpuIsolatorProcess::usage(
     return Failure("Unknown container");
   }
 
-  // TODO(rtodd): Obtain usage information from NVML.
+  const set<Gpu> allocated = infos.at(containerId)->allocated;
 
-  ResourceStatistics result;
-  return result;
+  if (allocated.empty()) {
+    return ResourceStatistics();
+  }
+
+  // Query NVML on a worker thread using the device handles cached
+  // during GPU enumeration: the queries are blocking library calls
+  // and would otherwise add jitter to the usage collection of every
+  // container sharing this actor. NVML is thread-safe.
+  //
+  // NOTE: GPUs are allocated to containers exclusively, so the
+  // device-wide memory usage reported by NVML is attributable to
+  // the container.
+  return process::async([allocated]() -> Try<ResourceStatistics> {
+    ResourceStatistics result;
+
+    uint64_t memoryUsed = 0;
+
+    foreach (const Gpu& gpu, allocated) {
+      Try<nvmlMemory_t> memory = nvml::deviceGetMemoryInfo(gpu.handle);
+      if (memory.isError()) {
+        return Error(
+            "Failed to nvml::deviceGetMemoryInfo: " + memory.error());
+      }
+
+      memoryUsed += memory->used;
+    }
+
+    result.set_gpu_mem_used_bytes(memoryUsed);
+
+    return result;
+  })
+  .then([](const Try<ResourceStatistics>& result)
+      -> Future<ResourceStatistics> {
+    if (result.isError()) {
+      return Failure(result.error());
+    }
+
+    return result.get();
+  });
 }
 
 
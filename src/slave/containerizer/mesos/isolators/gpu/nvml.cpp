@@ -55,17 +55,20 @@ struct NvidiaManagementLibrary
       nvmlReturn_t (*_deviceGetCount)(unsigned int*),
       nvmlReturn_t (*_deviceGetHandleByIndex)(unsigned int, nvmlDevice_t*),
       nvmlReturn_t (*_deviceGetMinorNumber)(nvmlDevice_t, unsigned int*),
+      nvmlReturn_t (*_deviceGetMemoryInfo)(nvmlDevice_t, nvmlMemory_t*),
       const char* (*_errorString)(nvmlReturn_t))
     : systemGetDriverVersion(_systemGetDriverVersion),
       deviceGetCount(_deviceGetCount),
       deviceGetHandleByIndex(_deviceGetHandleByIndex),
       deviceGetMinorNumber(_deviceGetMinorNumber),
+      deviceGetMemoryInfo(_deviceGetMemoryInfo),
       errorString(_errorString) {}
 
   nvmlReturn_t (*systemGetDriverVersion)(char *, unsigned int);
   nvmlReturn_t (*deviceGetCount)(unsigned int*);
   nvmlReturn_t (*deviceGetHandleByIndex)(unsigned int, nvmlDevice_t*);
   nvmlReturn_t (*deviceGetMinorNumber)(nvmlDevice_t, unsigned int*);
+  nvmlReturn_t (*deviceGetMemoryInfo)(nvmlDevice_t, nvmlMemory_t*);
   const char* (*errorString)(nvmlReturn_t);
 };
 
@@ -107,6 +110,7 @@ Try<Nothing> initialize()
       { "nvmlDeviceGetCount", nullptr },
       { "nvmlDeviceGetHandleByIndex", nullptr },
       { "nvmlDeviceGetMinorNumber", nullptr },
+      { "nvmlDeviceGetMemoryInfo", nullptr },
       { "nvmlErrorString", nullptr },
   };
 
@@ -142,6 +146,8 @@ Try<Nothing> initialize()
           symbols.at("nvmlDeviceGetHandleByIndex"),
       (nvmlReturn_t (*)(nvmlDevice_t, unsigned int*))
           symbols.at("nvmlDeviceGetMinorNumber"),
+      (nvmlReturn_t (*)(nvmlDevice_t, nvmlMemory_t*))
+          symbols.at("nvmlDeviceGetMemoryInfo"),
       (const char* (*)(nvmlReturn_t))
           symbols.at("nvmlErrorString"));
 
@@ -247,4 +253,19 @@ Try<unsigned int> deviceGetMinorNumber(nvmlDevice_t handle)
   return minor;
 }
 
+
+Try<nvmlMemory_t> deviceGetMemoryInfo(nvmlDevice_t handle)
+{
+  if (nvml == nullptr) {
+    return Error("NVML has not been initialized");
+  }
+
+  nvmlMemory_t memory;
+  nvmlReturn_t result = nvml->deviceGetMemoryInfo(handle, &memory);
+  if (result != NVML_SUCCESS) {
+    return Error(nvml->errorString(result));
+  }
+  return memory;
+}
+
 } // namespace nvml {
@@ -51,6 +51,7 @@ Try<std::string> systemGetDriverVersion();
 Try<unsigned int> deviceGetCount();
 Try<nvmlDevice_t> deviceGetHandleByIndex(unsigned int index);
 Try<unsigned int> deviceGetMinorNumber(nvmlDevice_t handle);
+Try<nvmlMemory_t> deviceGetMemoryInfo(nvmlDevice_t handle);
 
 } // namespace nvml {
 
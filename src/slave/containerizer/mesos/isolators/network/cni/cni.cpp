@@ -1328,7 +1328,33 @@ Future<Nothing> NetworkCniIsolatorProcess::attach(
         plugin.get() + "': " + s.error());
   }
 
-  return await(s->status(), io::read(s->out().get()), io::read(s->err().get()))
+  Future<tuple<Future<Option<int>>, Future<string>, Future<string>>> invocation =
+    await(s->status(), io::read(s->out().get()), io::read(s->err().get()));
+
+  // A plugin that hangs would otherwise block the container launch
+  // indefinitely; all 'attach()' invocations run concurrently, so the
+  // timeout bounds the network setup phase as a whole.
+  if (flags.network_cni_plugin_timeout.isSome()) {
+    const Duration timeout = flags.network_cni_plugin_timeout.get();
+    const pid_t pid = s->pid();
+    const string _plugin = plugin.get();
+
+    invocation = invocation.after(
+        timeout,
+        [timeout, pid, _plugin, networkName](
+            Future<tuple<Future<Option<int>>, Future<string>, Future<string>>>
+              future) {
+          future.discard();
+          os::killtree(pid, SIGKILL);
+
+          return Failure(
+              "The CNI plugin '" + _plugin + "' did not finish attaching to"
+              " network '" + networkName + "' within " + stringify(timeout) +
+              " and was killed");
+        });
+  }
+
+  return invocation
     .then(defer(
         PID<NetworkCniIsolatorProcess>(this),
         &NetworkCniIsolatorProcess::_attach,
@@ -1848,10 +1874,34 @@ Future<Nothing> NetworkCniIsolatorProcess::detach(
         "': " + s.error());
   }
 
-  return await(
-      s->status(),
-      io::read(s->out().get()),
-      io::read(s->err().get()))
+  Future<tuple<Future<Option<int>>, Future<string>, Future<string>>> invocation =
+    await(
+        s->status(),
+        io::read(s->out().get()),
+        io::read(s->err().get()));
+
+  // See the corresponding timeout in 'attach()'.
+  if (flags.network_cni_plugin_timeout.isSome()) {
+    const Duration timeout = flags.network_cni_plugin_timeout.get();
+    const pid_t pid = s->pid();
+    const string _plugin = plugin.get();
+
+    invocation = invocation.after(
+        timeout,
+        [timeout, pid, _plugin, networkName](
+            Future<tuple<Future<Option<int>>, Future<string>, Future<string>>>
+              future) {
+          future.discard();
+          os::killtree(pid, SIGKILL);
+
+          return Failure(
+              "The CNI plugin '" + _plugin + "' did not finish detaching from"
+              " network '" + networkName + "' within " + stringify(timeout) +
+              " and was killed");
+        });
+  }
+
+  return invocation
     .then(defer(
         PID<NetworkCniIsolatorProcess>(this),
         &NetworkCniIsolatorProcess::_detach,
@@ -1898,6 +1948,23 @@ Future<Nothing> NetworkCniIsolatorProcess::_detach(
           ifDir + "': " + rmdir.error());
     }
 
+    // While DEL is idempotent per the CNI spec, there is no need to
+    // invoke the plugin for this network again should the cleanup of
+    // another network fail and the container cleanup be retried:
+    // removing the checkpointed network configuration makes a retried
+    // 'detach()' skip this network.
+    const string networkConfigPath = paths::getNetworkConfigPath(
+        rootDir.get(),
+        containerId,
+        networkName);
+
+    Try<Nothing> rm = os::rm(networkConfigPath);
+    if (rm.isError()) {
+      return Failure(
+          "Failed to remove the network configuration file '" +
+          networkConfigPath + "': " + rm.error());
+    }
+
     return Nothing();
   }
 
@@ -413,31 +413,49 @@ void XfsDiskIsolatorProcess::check()
 {
   CHECK(quotaPolicy == xfs::QuotaPolicy::ENFORCING_ACTIVE);
 
-  foreachpair(const ContainerID& containerId, const Owned<Info>& info, infos) {
-    Result<xfs::QuotaInfo> quotaInfo = xfs::getProjectQuota(
-        info->directory, info->projectId);
+  if (infos.empty()) {
+    return;
+  }
+
+  IntervalSet<prid_t> projectIds;
+
+  foreachvalue (const Owned<Info>& info, infos) {
+    projectIds += info->projectId;
+  }
 
-    if (quotaInfo.isError()) {
-      LOG(WARNING) << "Failed to check disk usage for container '"
-                   << containerId  << "': " << quotaInfo.error();
+  // Read the quota records for all the project IDs we have assigned
+  // in a single scan of the quota file, rather than issuing one
+  // quotactl(2) per container each time we poll.
+  Try<hashmap<prid_t, xfs::QuotaInfo>> quotaInfos =
+    xfs::getProjectQuotas(workDir, projectIds);
 
+  if (quotaInfos.isError()) {
+    LOG(WARNING) << "Failed to check disk usage: " << quotaInfos.error();
+    return;
+  }
+
+  foreachvalue (const Owned<Info>& info, infos) {
+    // Any project ID without a quota record has no usage to enforce.
+    if (!quotaInfos->contains(info->projectId)) {
       continue;
     }
 
+    const xfs::QuotaInfo& quotaInfo = quotaInfos->at(info->projectId);
+
     // If the soft limit is exceeded the container should be killed.
-    if (quotaInfo->used > quotaInfo->softLimit) {
+    if (quotaInfo.used > quotaInfo.softLimit) {
       Resource resource;
       resource.set_name("disk");
       resource.set_type(Value::SCALAR);
       resource.mutable_scalar()->set_value(
-        quotaInfo->used.bytes() / Bytes::MEGABYTES);
+        quotaInfo.used.bytes() / Bytes::MEGABYTES);
 
       info->limitation.set(
           protobuf::slave::createContainerLimitation(
               Resources(resource),
-              "Disk usage (" + stringify(quotaInfo->used) +
+              "Disk usage (" + stringify(quotaInfo.used) +
               ") exceeds quota (" +
-              stringify(quotaInfo->softLimit) + ")",
+              stringify(quotaInfo.softLimit) + ")",
               TaskStatus::REASON_CONTAINER_LIMITATION_DISK));
     }
   }
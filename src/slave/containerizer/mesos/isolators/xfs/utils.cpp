@@ -39,6 +39,8 @@
 
 #include <stout/check.hpp>
 #include <stout/error.hpp>
+#include <stout/foreach.hpp>
+#include <stout/hashmap.hpp>
 #include <stout/numify.hpp>
 #include <stout/path.hpp>
 
@@ -55,6 +57,13 @@ using std::string;
 #define PRJQUOTA 2
 #endif
 
+// Manually define this for old xfsprogs headers. Supported by the
+// kernel since Linux 4.6; older kernels fail the quotactl(2) with
+// EINVAL and we fall back to per-ID queries.
+#ifndef Q_XGETNEXTQUOTA
+#define Q_XGETNEXTQUOTA XQM_CMD(9)
+#endif
+
 namespace mesos {
 namespace internal {
 namespace xfs {
@@ -251,6 +260,98 @@ Result<QuotaInfo> getProjectQuota(
 }
 
 
+Try<hashmap<prid_t, QuotaInfo>> getProjectQuotas(
+    const string& path,
+    const IntervalSet<prid_t>& projectIds)
+{
+  hashmap<prid_t, QuotaInfo> quotas;
+
+  if (projectIds.empty()) {
+    return quotas;
+  }
+
+  if (projectIds.contains(NON_PROJECT_ID)) {
+    return nonProjectError();
+  }
+
+  Try<string> devname = getDeviceForPath(path);
+  if (devname.isError()) {
+    return Error(devname.error());
+  }
+
+  // Walk the quota file with Q_XGETNEXTQUOTA, which returns the record
+  // for the next project ID at or above the requested one that has a
+  // quota record. This visits only the project IDs that are actually
+  // in use, so the cost of the scan is proportional to the number of
+  // assigned quotas, not to the size of the configured project range.
+  prid_t nextProjectId = projectIds.begin()->lower();
+
+  for (;;) {
+    fs_disk_quota_t quota = {0};
+
+    quota.d_version = FS_DQUOT_VERSION;
+    quota.d_flags = FS_PROJ_QUOTA;
+
+    if (::quotactl(QCMD(Q_XGETNEXTQUOTA, PRJQUOTA),
+                   devname->c_str(),
+                   nextProjectId,
+                   reinterpret_cast<caddr_t>(&quota)) == -1) {
+      // ENOENT (or ESRCH, depending on the kernel version) means that
+      // there are no further quota records to visit.
+      if (errno == ENOENT || errno == ESRCH) {
+        break;
+      }
+
+      // Kernels prior to Linux 4.6 don't implement Q_XGETNEXTQUOTA.
+      // Fall back to querying each project ID individually.
+      if (errno == EINVAL || errno == ENOSYS) {
+        foreach (const Interval<prid_t>& interval, projectIds) {
+          for (prid_t projectId = interval.lower();
+               projectId < interval.upper();
+               projectId++) {
+            Result<QuotaInfo> info = getProjectQuota(path, projectId);
+            if (info.isError()) {
+              return Error(info.error());
+            }
+
+            if (info.isSome()) {
+              quotas.put(projectId, info.get());
+            }
+          }
+        }
+
+        return quotas;
+      }
+
+      return ErrnoError("Failed to get quota record for project ID " +
+                        stringify(nextProjectId));
+    }
+
+    // The kernel scans upwards from the requested project ID, so once
+    // the returned ID passes the end of the range we care about there
+    // is nothing left to collect.
+    if (quota.d_id >= projectIds.rbegin()->upper()) {
+      break;
+    }
+
+    // Zero quota means that no quota is assigned.
+    if (projectIds.contains(quota.d_id) &&
+        (quota.d_blk_hardlimit != 0 || quota.d_bcount != 0)) {
+      QuotaInfo info;
+      info.softLimit = BasicBlocks(quota.d_blk_softlimit).bytes();
+      info.hardLimit = BasicBlocks(quota.d_blk_hardlimit).bytes();
+      info.used = BasicBlocks(quota.d_bcount).bytes();
+
+      quotas.put(quota.d_id, info);
+    }
+
+    nextProjectId = quota.d_id + 1;
+  }
+
+  return quotas;
+}
+
+
 Try<Nothing> setProjectQuota(
     const string& path,
     prid_t projectId,
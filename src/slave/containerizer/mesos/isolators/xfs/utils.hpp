@@ -20,6 +20,7 @@
 #include <string>
 
 #include <stout/bytes.hpp>
+#include <stout/hashmap.hpp>
 #include <stout/interval.hpp>
 #include <stout/nothing.hpp>
 #include <stout/try.hpp>
@@ -103,6 +104,15 @@ Result<QuotaInfo> getProjectQuota(
     prid_t projectId);
 
 
+// Read the quota records for all the project IDs in the given set by
+// scanning the quota file in a single pass, rather than issuing one
+// quotactl(2) call per project ID. Project IDs that have no quota
+// assigned and no usage are omitted from the result.
+Try<hashmap<prid_t, QuotaInfo>> getProjectQuotas(
+    const std::string& path,
+    const IntervalSet<prid_t>& projectIds);
+
+
 Try<Nothing> setProjectQuota(
     const std::string& path,
     prid_t projectId,
@@ -80,7 +80,7 @@ Future<hashset<ContainerID>> SubprocessLauncher::recover(
 }
 
 
-Try<pid_t> SubprocessLauncher::fork(
+Future<pid_t> SubprocessLauncher::fork(
     const ContainerID& containerId,
     const string& path,
     const vector<string>& argv,
@@ -92,16 +92,16 @@ Try<pid_t> SubprocessLauncher::fork(
     const vector<int_fd>& whitelistFds)
 {
   if (enterNamespaces.isSome() && enterNamespaces.get() != 0) {
-    return Error("Subprocess launcher does not support entering namespaces");
+    return Failure("Subprocess launcher does not support entering namespaces");
   }
 
   if (cloneNamespaces.isSome() && cloneNamespaces.get() != 0) {
-    return Error("Subprocess launcher does not support cloning namespaces");
+    return Failure("Subprocess launcher does not support cloning namespaces");
   }
 
   if (pids.contains(containerId)) {
-    return Error("Process has already been forked for container " +
-                 stringify(containerId));
+    return Failure("Process has already been forked for container " +
+                   stringify(containerId));
   }
 
   vector<process::Subprocess::ParentHook> parentHooks;
@@ -139,7 +139,7 @@ Try<pid_t> SubprocessLauncher::fork(
       whitelistFds);
 
   if (child.isError()) {
-    return Error("Failed to fork a child process: " + child.error());
+    return Failure("Failed to fork a child process: " + child.error());
   }
 
   LOG(INFO) << "Forked child with pid '" << child->pid()
@@ -59,9 +59,11 @@ public:
   // exec the binary at the given path with the given argv, flags and
   // environment. The I/O of the child will be redirected according to
   // the specified I/O descriptors. The parentHooks will be executed
-  // in the parent process before the child execs. The parent will return
-  // the child's pid if the fork is successful.
-  virtual Try<pid_t> fork(
+  // in the parent process before the child execs. The returned future
+  // contains the child's pid if the fork is successful. Note that the
+  // fork is performed asynchronously so that callers (in particular,
+  // the containerizer actor) are not blocked for its duration.
+  virtual process::Future<pid_t> fork(
       const ContainerID& containerId,
       const std::string& path,
       const std::vector<std::string>& argv,
@@ -98,7 +100,7 @@ public:
   process::Future<hashset<ContainerID>> recover(
       const std::vector<mesos::slave::ContainerState>& states) override;
 
-  Try<pid_t> fork(
+  process::Future<pid_t> fork(
       const ContainerID& containerId,
       const std::string& path,
       const std::vector<std::string>& argv,
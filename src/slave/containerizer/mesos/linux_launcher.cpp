@@ -67,7 +67,7 @@ public:
   virtual process::Future<hashset<ContainerID>> recover(
       const vector<mesos::slave::ContainerState>& states);
 
-  virtual Try<pid_t> fork(
+  virtual process::Future<pid_t> fork(
       const ContainerID& containerId,
       const string& path,
       const vector<string>& argv,
@@ -231,7 +231,7 @@ Future<hashset<ContainerID>> LinuxLauncher::recover(
 }
 
 
-Try<pid_t> LinuxLauncher::fork(
+Future<pid_t> LinuxLauncher::fork(
     const ContainerID& containerId,
     const string& path,
     const vector<string>& argv,
@@ -253,7 +253,7 @@ Try<pid_t> LinuxLauncher::fork(
       environment,
       enterNamespaces,
       cloneNamespaces,
-      whitelistFds).get();
+      whitelistFds);
 }
 
 
@@ -443,7 +443,7 @@ Future<hashset<ContainerID>> LinuxLauncherProcess::recover(
 }
 
 
-Try<pid_t> LinuxLauncherProcess::fork(
+Future<pid_t> LinuxLauncherProcess::fork(
     const ContainerID& containerId,
     const string& path,
     const vector<string>& argv,
@@ -456,7 +456,8 @@ Try<pid_t> LinuxLauncherProcess::fork(
 {
   // Make sure this container (nested or not) is unique.
   if (containers.contains(containerId)) {
-    return Error("Container '" + stringify(containerId) + "' already exists");
+    return Failure(
+        "Container '" + stringify(containerId) + "' already exists");
   }
 
   Option<pid_t> target = None();
@@ -465,7 +466,7 @@ Try<pid_t> LinuxLauncherProcess::fork(
   if (containerId.has_parent()) {
     Option<Container> container = containers.get(containerId.parent());
     if (container.isNone()) {
-      return Error("Unknown parent container");
+      return Failure("Unknown parent container");
     }
 
     if (container->pid.isNone()) {
@@ -473,7 +474,8 @@ Try<pid_t> LinuxLauncherProcess::fork(
       // that in order to enter the namespaces? This would be best
       // effort because we don't know the namespaces that had been
       // created for the original pid.
-      return Error("Unknown parent container pid, can not enter namespaces");
+      return Failure(
+          "Unknown parent container pid, can not enter namespaces");
     }
 
     target = container->pid.get();
@@ -482,7 +484,7 @@ Try<pid_t> LinuxLauncherProcess::fork(
   // Ensure we didn't pass `enterNamespaces`
   // if we aren't forking a nested container.
   if (!containerId.has_parent() && enterNamespaces.isSome()) {
-    return Error("Cannot enter parent namespaces for non-nested container");
+    return Failure("Cannot enter parent namespaces for non-nested container");
   }
 
   int enterFlags = enterNamespaces.isSome() ? enterNamespaces.get() : 0;
@@ -558,7 +560,7 @@ Try<pid_t> LinuxLauncherProcess::fork(
       whitelistFds);
 
   if (child.isError()) {
-    return Error("Failed to clone child process: " + child.error());
+    return Failure("Failed to clone child process: " + child.error());
   }
 
   Container container;
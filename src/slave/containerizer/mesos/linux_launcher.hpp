@@ -48,7 +48,7 @@ public:
   process::Future<hashset<ContainerID>> recover(
       const std::vector<mesos::slave::ContainerState>& states) override;
 
-  Try<pid_t> fork(
+  process::Future<pid_t> fork(
       const ContainerID& containerId,
       const std::string& path,
       const std::vector<std::string>& argv,
@@ -22,6 +22,10 @@
 #include "slave/containerizer/mesos/launch.hpp"
 #include "slave/containerizer/mesos/mount.hpp"
 
+#ifndef __WINDOWS__
+#include "slave/containerizer/mesos/io/switchboard.hpp"
+#endif
+
 #ifdef __linux__
 #include "slave/containerizer/mesos/isolators/network/cni/cni.hpp"
 #endif
@@ -38,21 +42,30 @@ int main(int argc, char** argv)
   }
 #endif // __WINDOWS__
 
-#ifdef __linux__
+#if defined(__linux__)
   int success = Subcommand::dispatch(
       "MESOS_CONTAINERIZER_",
       argc,
       argv,
       new MesosContainerizerLaunch(),
       new MesosContainerizerMount(),
-      new NetworkCniIsolatorSetup());
-#else
+      new NetworkCniIsolatorSetup(),
+      new IOSwitchboardServerSubcommand());
+#elif defined(__WINDOWS__)
   int success = Subcommand::dispatch(
       "MESOS_CONTAINERIZER_",
       argc,
       argv,
       new MesosContainerizerLaunch(),
       new MesosContainerizerMount());
+#else
+  int success = Subcommand::dispatch(
+      "MESOS_CONTAINERIZER_",
+      argc,
+      argv,
+      new MesosContainerizerLaunch(),
+      new MesosContainerizerMount(),
+      new IOSwitchboardServerSubcommand());
 #endif
 
 #ifdef __WINDOWS__
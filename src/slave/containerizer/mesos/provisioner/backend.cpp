@@ -64,6 +64,8 @@ hashmap<string, Owned<Backend>> Backend::create(const Flags& flags)
   } else if (overlayfsSupported.get()) {
     creators.put(OVERLAY_BACKEND, &OverlayBackend::create);
   }
+
+  creators.put(REFLINK_BACKEND, &ReflinkBackend::create);
 #endif // __linux__
 
   creators.put(COPY_BACKEND, &CopyBackend::create);
@@ -47,8 +47,9 @@ namespace slave {
 class CopyBackendProcess : public Process<CopyBackendProcess>
 {
 public:
-  CopyBackendProcess()
-    : ProcessBase(process::ID::generate("copy-provisioner-backend")) {}
+  explicit CopyBackendProcess(bool _reflink = false)
+    : ProcessBase(process::ID::generate("copy-provisioner-backend")),
+      reflink(_reflink) {}
 
   Future<Nothing> provision(const vector<string>& layers, const string& rootfs);
 
@@ -56,6 +57,10 @@ public:
 
 private:
   Future<Nothing> _provision(string layer, const string& rootfs);
+
+  // Whether to copy the layers with copy-on-write clones (reflinks)
+  // where the underlying filesystem supports them.
+  const bool reflink;
 };
 
 
@@ -98,6 +103,47 @@ Future<bool> CopyBackend::destroy(
 }
 
 
+#ifdef __linux__
+Try<Owned<Backend>> ReflinkBackend::create(const Flags&)
+{
+  return Owned<Backend>(new ReflinkBackend(
+      Owned<CopyBackendProcess>(new CopyBackendProcess(true))));
+}
+
+
+ReflinkBackend::~ReflinkBackend()
+{
+  terminate(process.get());
+  wait(process.get());
+}
+
+
+ReflinkBackend::ReflinkBackend(Owned<CopyBackendProcess> _process)
+  : process(_process)
+{
+  spawn(CHECK_NOTNULL(process.get()));
+}
+
+
+Future<Nothing> ReflinkBackend::provision(
+    const vector<string>& layers,
+    const string& rootfs,
+    const string& backendDir)
+{
+  return dispatch(
+      process.get(), &CopyBackendProcess::provision, layers, rootfs);
+}
+
+
+Future<bool> ReflinkBackend::destroy(
+    const string& rootfs,
+    const string& backendDir)
+{
+  return dispatch(process.get(), &CopyBackendProcess::destroy, rootfs);
+}
+#endif // __linux__
+
+
 Future<Nothing> CopyBackendProcess::provision(
     const vector<string>& layers,
     const string& rootfs)
@@ -262,6 +308,12 @@ Future<Nothing> CopyBackendProcess::_provision(
   vector<string> args{"cp", "-a", layer, rootfs};
 #else
   vector<string> args{"cp", "-aT", layer, rootfs};
+
+  if (reflink) {
+    // Clone each file if the underlying filesystem supports it and
+    // let `cp` fall back to a regular copy otherwise.
+    args.insert(args.begin() + 1, "--reflink=auto");
+  }
 #endif // __APPLE__ || __FreeBSD__
 
   Try<Subprocess> s = subprocess(
@@ -63,6 +63,46 @@ private:
   process::Owned<CopyBackendProcess> process;
 };
 
+
+#ifdef __linux__
+// A variant of the copy backend that copies the layers with
+// copy-on-write clones (reflinks) where the underlying filesystem
+// supports them (e.g., XFS with reflink support, btrfs), falling
+// back to a regular copy per file otherwise. Cloned files share
+// data blocks with the layer store until modified, so provisioning
+// is nearly instant and uses almost no additional disk space, while
+// writes into the rootfs remain isolated from the layers. The
+// implications listed for `CopyBackend` apply to this backend as
+// well.
+class ReflinkBackend : public Backend
+{
+public:
+  ~ReflinkBackend() override;
+
+  // ReflinkBackend doesn't use any flag.
+  static Try<process::Owned<Backend>> create(const Flags&);
+
+  // Provisions a rootfs given the layers' paths and target rootfs
+  // path.
+  process::Future<Nothing> provision(
+      const std::vector<std::string>& layers,
+      const std::string& rootfs,
+      const std::string& backendDir) override;
+
+  process::Future<bool> destroy(
+      const std::string& rootfs,
+      const std::string& backendDir) override;
+
+private:
+  explicit ReflinkBackend(process::Owned<CopyBackendProcess> process);
+
+  ReflinkBackend(const ReflinkBackend&); // Not copyable.
+  ReflinkBackend& operator=(const ReflinkBackend&); // Not assignable.
+
+  process::Owned<CopyBackendProcess> process;
+};
+#endif // __linux__
+
 } // namespace slave {
 } // namespace internal {
 } // namespace mesos {
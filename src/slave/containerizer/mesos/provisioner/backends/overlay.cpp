@@ -21,6 +21,7 @@
 #include <stout/adaptor.hpp>
 #include <stout/foreach.hpp>
 #include <stout/fs.hpp>
+#include <stout/hashmap.hpp>
 #include <stout/os.hpp>
 
 #include <stout/os/realpath.hpp>
@@ -60,6 +61,25 @@ public:
   Future<bool> destroy(
       const string& rootfs,
       const string& backendDir);
+
+private:
+  // A shared symlink farm giving each layer of one particular layer
+  // chain a short path, so that long chains do not overflow the
+  // kernel's limit on mount option length. Containers provisioned
+  // from the same image reuse the same assembly, so only the first
+  // one pays for creating the per-layer symlinks.
+  //
+  // NOTE: Overlayfs resolves the 'lowerdir' paths at mount time, so
+  // removing an assembly does not affect rootfses that are already
+  // mounted.
+  struct Assembly
+  {
+    string directory;
+    size_t references;
+  };
+
+  // Assemblies keyed by the colon-joined layer chain they link to.
+  hashmap<string, Assembly> assemblies;
 };
 
 
@@ -149,43 +169,65 @@ Future<Nothing> OverlayBackendProcess::provision(
         workdir + "': " + mkdir.error());
   }
 
-  // We create symlink with shorter path to each of the base layers.
-  Try<string> mktemp = os::mkdtemp();
-  if (mktemp.isError()) {
-    return Failure(
-      "Failed to create temporary directory for symlinks to layers: " +
-      mktemp.error());
+  // Reuse the symlink assembly of a previous provision with the
+  // same layer chain if there is one; otherwise create it.
+  const string chain = strings::join(":", layers);
+
+  if (assemblies.contains(chain) &&
+      !os::exists(assemblies.at(chain).directory)) {
+    assemblies.erase(chain);
+  }
+
+  if (!assemblies.contains(chain)) {
+    Try<string> mktemp = os::mkdtemp();
+    if (mktemp.isError()) {
+      return Failure(
+        "Failed to create temporary directory for symlinks to layers: " +
+        mktemp.error());
+    }
+
+    const string tempDir = mktemp.get();
+
+    // We create symlinks with file name 0, 1, ..., N-1 in tempDir
+    // which points to the corresponding layers in the same order.
+    size_t idx = 0;
+    foreach (const string& layer, layers) {
+      const string link = path::join(tempDir, std::to_string(idx++));
+
+      Try<Nothing> symlink = ::fs::symlink(layer, link);
+      if (symlink.isError()) {
+        return Failure(
+            "Failed to create symlink at '" + link +
+            "' -> '" + layer + "': " + symlink.error());
+      }
+    }
+
+    assemblies.put(chain, Assembly{tempDir, 0u});
   }
 
-  const string tempDir = mktemp.get();
+  Assembly& assembly = assemblies.at(chain);
+
+  // The per-container 'links' symlink is what destroy() follows to
+  // find the assembly, and acts as this rootfs' reference to it.
   const string tempLink = path::join(scratchDir, "links");
 
-  Try<Nothing> symlink = ::fs::symlink(tempDir, tempLink);
+  Try<Nothing> symlink = ::fs::symlink(assembly.directory, tempLink);
   if (symlink.isError()) {
     return Failure(
         "Failed to create symlink '" + tempLink +
-        "' -> '" + tempDir + "': " + symlink.error());
+        "' -> '" + assembly.directory + "': " + symlink.error());
   }
 
-  VLOG(1) << "Created symlink '" << tempLink << "' -> '" << tempDir << "'";
+  assembly.references++;
+
+  VLOG(1) << "Created symlink '" << tempLink << "' -> '"
+          << assembly.directory << "'";
 
   vector<string> links;
   links.reserve(layers.size());
 
-  // We create symlinks with file name 0, 1, ..., N-1 in tempDir which
-  // points to the corresponding layers in the same order.
-  size_t idx = 0;
-  foreach (const string& layer, layers) {
-    const string link = path::join(tempDir, std::to_string(idx++));
-
-    Try<Nothing> symlink = ::fs::symlink(layer, link);
-    if (symlink.isError()) {
-      return Failure(
-          "Failed to create symlink at '" + link +
-          "' -> '" + layer + "': " + symlink.error());
-    }
-
-    links.push_back(link);
+  for (size_t i = 0; i < layers.size(); i++) {
+    links.push_back(path::join(assembly.directory, std::to_string(i)));
   }
 
   // For overlayfs, the specified lower directories will be stacked
@@ -300,13 +342,44 @@ Future<bool> OverlayBackendProcess::destroy(
       // This is possible if agent crashes after we remove the temp
       // directory but before we remove the symlink itself.
       if (realpath.isSome()) {
-        Try<Nothing> rmdir = os::rmdir(realpath.get());
-        if (rmdir.isError()) {
-          return Failure("");
+        // The assembly may be shared with other rootfses provisioned
+        // from the same layer chain; only remove it when the last
+        // reference is gone. Assemblies of rootfses provisioned
+        // before an agent restart are not tracked and are removed
+        // right away, which is safe since live mounts do not depend
+        // on the symlinks.
+        Option<string> chain = None();
+
+        foreachpair (const string& key, const Assembly& assembly, assemblies) {
+          if (assembly.directory == realpath.get()) {
+            chain = key;
+            break;
+          }
         }
 
-        VLOG(1) << "Removed temporary directory '" << realpath.get()
-                << "' pointed by '" << tempLink << "'";
+        bool remove = true;
+
+        if (chain.isSome()) {
+          Assembly& assembly = assemblies.at(chain.get());
+
+          if (--assembly.references > 0) {
+            remove = false;
+          } else {
+            assemblies.erase(chain.get());
+          }
+        }
+
+        if (remove) {
+          Try<Nothing> rmdir = os::rmdir(realpath.get());
+          if (rmdir.isError()) {
+            return Failure(
+                "Failed to remove layer links directory '" +
+                realpath.get() + "': " + rmdir.error());
+          }
+
+          VLOG(1) << "Removed temporary directory '" << realpath.get()
+                  << "' pointed by '" << tempLink << "'";
+        }
       }
 
       Try<Nothing> rm = os::rm(tempLink);
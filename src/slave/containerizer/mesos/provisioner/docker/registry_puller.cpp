@@ -23,6 +23,9 @@
 #include <process/dispatch.hpp>
 #include <process/http.hpp>
 
+#include <stout/hashmap.hpp>
+#include <stout/hashset.hpp>
+
 #include <stout/os/exists.hpp>
 #include <stout/os/mkdir.hpp>
 #include <stout/os/rm.hpp>
@@ -85,19 +88,15 @@ private:
       const string& backend,
       const Option<Secret::Value>& config);
 
-  Future<vector<string>> ___pull(
-    const spec::ImageReference& reference,
+  Future<Nothing> extractLayer(
     const string& directory,
-    const spec::v2::ImageManifest& manifest,
-    const hashset<string>& blobSums,
+    const spec::v1::ImageManifest& v1,
+    const string& blobSum,
     const string& backend);
 
-  Future<hashset<string>> fetchBlobs(
+  Try<URI> getBlobUri(
     const spec::ImageReference& reference,
-    const string& directory,
-    const spec::v2::ImageManifest& manifest,
-    const string& backend,
-    const Option<Secret::Value>& config);
+    const string& blobSum);
 
   RegistryPullerProcess(const RegistryPullerProcess&) = delete;
   RegistryPullerProcess& operator=(const RegistryPullerProcess&) = delete;
@@ -320,24 +319,6 @@ Future<vector<string>> RegistryPullerProcess::__pull(
     return Failure("'fsLayers' and 'history' have different size in manifest");
   }
 
-  return fetchBlobs(reference, directory, manifest.get(), backend, config)
-    .then(defer(self(),
-                &Self::___pull,
-                reference,
-                directory,
-                manifest.get(),
-                lambda::_1,
-                backend));
-}
-
-
-Future<vector<string>> RegistryPullerProcess::___pull(
-    const spec::ImageReference& reference,
-    const string& directory,
-    const spec::v2::ImageManifest& manifest,
-    const hashset<string>& blobSums,
-    const string& backend)
-{
   // Docker reads the layer ids from the disk:
   // https://github.com/docker/docker/blob/v1.13.0/layer/filestore.go#L310
   //
@@ -358,6 +339,18 @@ Future<vector<string>> RegistryPullerProcess::___pull(
   // sure ids are unique.
   hashset<string> uniqueIds;
   vector<string> layerIds;
+
+  // Fetches of layer blobs in progress, keyed by blob sum.
+  //
+  // NOTE: There might exist duplicated blob sums in 'fsLayers'. We
+  // just need to fetch each blob once; the extraction of all the
+  // layers sharing it is chained on the same fetch.
+  hashmap<string, Future<Nothing>> fetching;
+
+  // One future per layer that needs to be pulled. Each layer is
+  // extracted as soon as its blob has been fetched, so downloads
+  // and extractions are pipelined rather than separated by a
+  // barrier waiting for all downloads to finish.
   vector<Future<Nothing>> futures;
 
   // The order of `fslayers` should be [child, parent, ...].
@@ -365,10 +358,10 @@ Future<vector<string>> RegistryPullerProcess::___pull(
   // The content in the parent will be overwritten by the child if
   // there is a conflict. Therefore, backends expect the following
   // order: [parent, child, ...].
-  for (int i = 0; i < manifest.fslayers_size(); i++) {
-    CHECK(manifest.history(i).has_v1());
-    const spec::v1::ImageManifest& v1 = manifest.history(i).v1();
-    const string& blobSum = manifest.fslayers(i).blobsum();
+  for (int i = 0; i < manifest->fslayers_size(); i++) {
+    CHECK(manifest->history(i).has_v1());
+    const spec::v1::ImageManifest& v1 = manifest->history(i).v1();
+    const string& blobSum = manifest->fslayers(i).blobsum();
 
     // Skip duplicate layer ids.
     if (uniqueIds.contains(v1.id())) {
@@ -386,32 +379,27 @@ Future<vector<string>> RegistryPullerProcess::___pull(
       continue;
     }
 
-    const string layerPath = path::join(directory, v1.id());
-    const string tar = path::join(directory, blobSum);
-    const string rootfs = paths::getImageLayerRootfsPath(layerPath, backend);
-    const string json = paths::getImageLayerManifestPath(layerPath);
-
-    VLOG(1) << "Extracting layer tar ball '" << tar
-            << " to rootfs '" << rootfs << "'";
+    if (!fetching.contains(blobSum)) {
+      VLOG(1) << "Fetching blob '" << blobSum << "' for layer '"
+              << v1.id() << "' of image '" << reference << "'";
 
-    // NOTE: This will create 'layerPath' as well.
-    Try<Nothing> mkdir = os::mkdir(rootfs, true);
-    if (mkdir.isError()) {
-      return Failure(
-          "Failed to create rootfs directory '" + rootfs + "' "
-          "for layer '" + v1.id() + "': " + mkdir.error());
-    }
+      Try<URI> blobUri = getBlobUri(reference, blobSum);
+      if (blobUri.isError()) {
+        return Failure(blobUri.error());
+      }
 
-    Try<Nothing> write = os::write(json, stringify(JSON::protobuf(v1)));
-    if (write.isError()) {
-      return Failure(
-          "Failed to save the layer manifest for layer '" +
-          v1.id() + "': " + write.error());
+      fetching[blobSum] = fetcher->fetch(
+          blobUri.get(),
+          directory,
+          config.isSome() ? config->data() : Option<string>());
     }
 
-    futures.push_back(command::untar(Path(tar), Path(rootfs)));
+    futures.push_back(fetching.at(blobSum)
+      .then(defer(self(), &Self::extractLayer, directory, v1, blobSum, backend)));
   }
 
+  const hashset<string> blobSums = fetching.keys();
+
   return collect(futures)
     .then([=]() -> Future<vector<string>> {
       // Remove the tarballs after the extraction.
@@ -431,89 +419,79 @@ Future<vector<string>> RegistryPullerProcess::___pull(
 }
 
 
-Future<hashset<string>> RegistryPullerProcess::fetchBlobs(
-    const spec::ImageReference& reference,
+Future<Nothing> RegistryPullerProcess::extractLayer(
     const string& directory,
-    const spec::v2::ImageManifest& manifest,
-    const string& backend,
-    const Option<Secret::Value>& config)
+    const spec::v1::ImageManifest& v1,
+    const string& blobSum,
+    const string& backend)
 {
-  // First, find all the blobs that need to be fetched.
-  //
-  // NOTE: There might exist duplicated blob sums in 'fsLayers'. We
-  // just need to fetch one of them.
-  hashset<string> blobSums;
-
-  for (int i = 0; i < manifest.fslayers_size(); i++) {
-    CHECK(manifest.history(i).has_v1());
-    const spec::v1::ImageManifest& v1 = manifest.history(i).v1();
-
-    // Check if the layer is in the store or not. If yes, skip the
-    // unnecessary fetching.
-    if (os::exists(
-        paths::getImageLayerRootfsPath(storeDir, v1.id(), backend))) {
-      continue;
-    }
-
-    const string& blobSum = manifest.fslayers(i).blobsum();
-
-    VLOG(1) << "Fetching blob '" << blobSum << "' for layer '"
-            << v1.id() << "' of image '" << reference << "'";
+  const string layerPath = path::join(directory, v1.id());
+  const string tar = path::join(directory, blobSum);
+  const string rootfs = paths::getImageLayerRootfsPath(layerPath, backend);
+  const string json = paths::getImageLayerManifestPath(layerPath);
+
+  VLOG(1) << "Extracting layer tar ball '" << tar
+          << " to rootfs '" << rootfs << "'";
+
+  // NOTE: This will create 'layerPath' as well.
+  Try<Nothing> mkdir = os::mkdir(rootfs, true);
+  if (mkdir.isError()) {
+    return Failure(
+        "Failed to create rootfs directory '" + rootfs + "' "
+        "for layer '" + v1.id() + "': " + mkdir.error());
+  }
 
-    blobSums.insert(blobSum);
+  Try<Nothing> write = os::write(json, stringify(JSON::protobuf(v1)));
+  if (write.isError()) {
+    return Failure(
+        "Failed to save the layer manifest for layer '" +
+        v1.id() + "': " + write.error());
   }
 
-  // Now, actually fetch the blobs.
-  vector<Future<Nothing>> futures;
+  return command::untar(Path(tar), Path(rootfs));
+}
 
-  foreach (const string& blobSum, blobSums) {
-    URI blobUri;
 
-    if (reference.has_registry()) {
-      Result<int> port = spec::getRegistryPort(reference.registry());
-      if (port.isError()) {
-        return Failure("Failed to get registry port: " + port.error());
-      }
-
-      Try<string> scheme = spec::getRegistryScheme(reference.registry());
-      if (scheme.isError()) {
-        return Failure("Failed to get registry scheme: " + scheme.error());
-      }
+Try<URI> RegistryPullerProcess::getBlobUri(
+    const spec::ImageReference& reference,
+    const string& blobSum)
+{
+  if (reference.has_registry()) {
+    Result<int> port = spec::getRegistryPort(reference.registry());
+    if (port.isError()) {
+      return Error("Failed to get registry port: " + port.error());
+    }
 
-      // If users want to use the registry specified in '--docker_image',
-      // an URL scheme must be specified in '--docker_registry', because
-      // there is no scheme allowed in docker image name.
-      blobUri = uri::docker::blob(
-          reference.repository(),
-          blobSum,
-          spec::getRegistryHost(reference.registry()),
-          scheme.get(),
-          port.isSome() ? port.get() : Option<int>());
-    } else {
-      const string registry = defaultRegistryUrl.domain.isSome()
-        ? defaultRegistryUrl.domain.get()
-        : stringify(defaultRegistryUrl.ip.get());
-
-      const Option<int> port = defaultRegistryUrl.port.isSome()
-        ? static_cast<int>(defaultRegistryUrl.port.get())
-        : Option<int>();
-
-      blobUri = uri::docker::blob(
-          reference.repository(),
-          blobSum,
-          registry,
-          defaultRegistryUrl.scheme,
-          port);
+    Try<string> scheme = spec::getRegistryScheme(reference.registry());
+    if (scheme.isError()) {
+      return Error("Failed to get registry scheme: " + scheme.error());
     }
 
-    futures.push_back(fetcher->fetch(
-        blobUri,
-        directory,
-        config.isSome() ? config->data() : Option<string>()));
+    // If users want to use the registry specified in '--docker_image',
+    // an URL scheme must be specified in '--docker_registry', because
+    // there is no scheme allowed in docker image name.
+    return uri::docker::blob(
+        reference.repository(),
+        blobSum,
+        spec::getRegistryHost(reference.registry()),
+        scheme.get(),
+        port.isSome() ? port.get() : Option<int>());
   }
 
-  return collect(futures)
-    .then([blobSums]() -> hashset<string> { return blobSums; });
+  const string registry = defaultRegistryUrl.domain.isSome()
+    ? defaultRegistryUrl.domain.get()
+    : stringify(defaultRegistryUrl.ip.get());
+
+  const Option<int> port = defaultRegistryUrl.port.isSome()
+    ? static_cast<int>(defaultRegistryUrl.port.get())
+    : Option<int>();
+
+  return uri::docker::blob(
+      reference.repository(),
+      blobSum,
+      registry,
+      defaultRegistryUrl.scheme,
+      port);
 }
 
 } // namespace docker {
@@ -14,6 +14,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -28,6 +29,7 @@
 #include <stout/json.hpp>
 #include <stout/os.hpp>
 
+#include <process/clock.hpp>
 #include <process/collect.hpp>
 #include <process/defer.hpp>
 #include <process/dispatch.hpp>
@@ -53,6 +55,7 @@ using std::list;
 using std::string;
 using std::vector;
 
+using process::Clock;
 using process::Failure;
 using process::Future;
 using process::Owned;
@@ -144,6 +147,14 @@ private:
   Owned<Puller> puller;
   hashmap<string, Owned<Promise<Image>>> pulling;
 
+  // Layers present in the store, mapped to the last time each was
+  // used to provision a container (in seconds since the epoch, seeded
+  // from the layer directory's modification time during recovery).
+  // Maintaining this index incrementally lets `prune` avoid scanning
+  // the store while provisioning is paused, and lets unreferenced
+  // layers be evicted in least-recently-used order.
+  hashmap<string, double> layers;
+
   // For executing path removals in a separated actor.
   process::Executor executor;
 
@@ -262,6 +273,20 @@ Future<Nothing> Store::prune(
 
 Future<Nothing> StoreProcess::recover()
 {
+  Try<list<string>> layerIds = paths::listLayers(flags.docker_store_dir);
+  if (layerIds.isError()) {
+    return Failure("Failed to list layers in store: " + layerIds.error());
+  }
+
+  // Seed the layer index. This is the only full scan of the store,
+  // and it happens during recovery rather than on the image GC path.
+  foreach (const string& layerId, layerIds.get()) {
+    Try<long> mtime = os::stat::mtime(
+        paths::getImageLayerPath(flags.docker_store_dir, layerId));
+
+    layers[layerId] = mtime.isSome() ? static_cast<double>(mtime.get()) : 0;
+  }
+
   return metadataManager->recover();
 }
 
@@ -385,8 +410,13 @@ Future<ImageInfo> StoreProcess::__get(
 {
   CHECK_LT(0, image.layer_ids_size());
 
+  const double now = Clock::now().secs();
+
   vector<string> layerPaths;
   foreach (const string& layerId, image.layer_ids()) {
+    // Mark the layer as recently used for eviction ordering.
+    layers[layerId] = now;
+
     layerPaths.push_back(paths::getImageLayerRootfsPath(
         flags.docker_store_dir,
         layerId,
@@ -441,6 +471,10 @@ Future<Nothing> StoreProcess::moveLayer(
 {
   const string source = path::join(staging, layerId);
 
+  // Record the layer in the index regardless of whether it still
+  // needs to be moved into the store below.
+  layers[layerId] = Clock::now().secs();
+
   // This is the case where the puller skips the pulling of the layer
   // because the layer already exists in the store.
   //
@@ -543,11 +577,6 @@ Future<Nothing> StoreProcess::_prune(
     const hashset<string>& activeLayerRootfses,
     const hashset<string>& retainedLayerIds)
 {
-  Try<list<string>> allLayers = paths::listLayers(flags.docker_store_dir);
-  if (allLayers.isError()) {
-    return Failure("Failed to find all layer paths: " + allLayers.error());
-  }
-
   // Paths in provisioner are layer rootfs. Normalize them to layer
   // path.
   hashset<string> activeLayerPaths;
@@ -556,7 +585,12 @@ Future<Nothing> StoreProcess::_prune(
     activeLayerPaths.insert(Path(rootfsPath).dirname());
   }
 
-  foreach (const string& layerId, allLayers.get()) {
+  // Collect the unreferenced layers from the in-memory index rather
+  // than scanning the store: only layers that are actually evicted
+  // require disk operations below.
+  vector<string> unreferenced;
+
+  foreachkey (const string& layerId, layers) {
     if (retainedLayerIds.contains(layerId)) {
       VLOG(1) << "Layer '" << layerId << "' is retained by image store cache";
       continue;
@@ -570,6 +604,32 @@ Future<Nothing> StoreProcess::_prune(
       continue;
     }
 
+    unreferenced.push_back(layerId);
+  }
+
+  // Evict least recently used layers first, so that layers more
+  // likely to be provisioned again survive the longest if the
+  // deletion pass below is interrupted.
+  std::sort(
+      unreferenced.begin(),
+      unreferenced.end(),
+      [this](const string& left, const string& right) {
+        return layers.at(left) < layers.at(right);
+      });
+
+  vector<string> targets;
+
+  foreach (const string& layerId, unreferenced) {
+    const string layerPath =
+      paths::getImageLayerPath(flags.docker_store_dir, layerId);
+
+    if (!os::exists(layerPath)) {
+      // The index may contain a layer whose pull did not complete;
+      // drop the stale entry.
+      layers.erase(layerId);
+      continue;
+    }
+
     const string target =
       paths::getGcLayerPath(flags.docker_store_dir, layerId);
 
@@ -586,19 +646,32 @@ Future<Nothing> StoreProcess::_prune(
           "Failed to move layer from '" + layerPath +
           "' to '" + target + "': " + rename.error());
     }
+
+    layers.erase(layerId);
+    targets.push_back(target);
   }
 
   const string gcDir = paths::getGcDir(flags.docker_store_dir);
-  auto rmdirs = [gcDir]() {
-    Try<list<string>> targets = os::ls(gcDir);
-    if (targets.isError()) {
+  auto rmdirs = [gcDir, targets]() {
+    // Delete the layers marked above in least-recently-used order,
+    // followed by anything left over in the gc directory from a
+    // previously interrupted pass.
+    list<string> removals(targets.begin(), targets.end());
+
+    Try<list<string>> entries = os::ls(gcDir);
+    if (entries.isError()) {
       LOG(WARNING) << "Error when listing gcDir '" << gcDir
-                   << "': " << targets.error();
-      return Nothing();
+                   << "': " << entries.error();
+    } else {
+      foreach (const string& entry, entries.get()) {
+        const string path = path::join(gcDir, entry);
+        if (std::find(targets.begin(), targets.end(), path) == targets.end()) {
+          removals.push_back(path);
+        }
+      }
     }
 
-    foreach (const string& target, targets.get()) {
-      const string path = path::join(gcDir, target);
+    foreach (const string& path, removals) {
       // Run the removal operation with 'continueOnError = false'.
       // A possible situation is that we incorrectly marked a layer
       // which is still used by certain layer based backends (aufs, overlay).
@@ -136,7 +136,10 @@ Try<hashset<ContainerID>> listContainers(
       return hashset<ContainerID>();
     }
 
-    Try<list<string>> containerIds = os::ls(containersDir);
+    // NOTE: We use `os::lsdir` so that filtering out non-directory
+    // entries does not cost a `stat` call per entry; provisioner
+    // recovery can scan a large number of containers here.
+    Try<std::vector<os::DirEntry>> containerIds = os::lsdir(containersDir);
     if (containerIds.isError()) {
       return Error(
           "Unable to list the containers under directory: '" +
@@ -145,10 +148,10 @@ Try<hashset<ContainerID>> listContainers(
 
     hashset<ContainerID> results;
 
-    foreach (const string& entry, containerIds.get()) {
-      const string containerPath = path::join(containersDir, entry);
+    foreach (const os::DirEntry& entry, containerIds.get()) {
+      const string containerPath = path::join(containersDir, entry.name);
 
-      if (!os::stat::isdir(containerPath)) {
+      if (entry.type != os::DirEntry::Type::DIRECTORY) {
         LOG(WARNING) << "Ignoring unexpected container entry at "
                      << "'" << containerPath << "' when listing "
                      << "containers in provisioner";
@@ -156,7 +159,7 @@ Try<hashset<ContainerID>> listContainers(
       }
 
       ContainerID containerId;
-      containerId.set_value(entry);
+      containerId.set_value(entry.name);
 
       if (parentContainerId.isSome()) {
         containerId.mutable_parent()->CopyFrom(parentContainerId.get());
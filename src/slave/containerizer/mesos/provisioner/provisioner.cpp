@@ -64,6 +64,7 @@ using mesos::internal::slave::AUFS_BACKEND;
 using mesos::internal::slave::BIND_BACKEND;
 using mesos::internal::slave::COPY_BACKEND;
 using mesos::internal::slave::OVERLAY_BACKEND;
+using mesos::internal::slave::REFLINK_BACKEND;
 
 using mesos::slave::ContainerLayers;
 using mesos::slave::ContainerState;
@@ -81,6 +82,7 @@ namespace slave {
 // | overlay | ext4 xfs     | btrfs aufs overlay overlay2 zfs eCryptfs |
 // | bind    |              | N/A(`--sandbox_directory' must exist)    |
 // | copy    |              | N/A                                      |
+// | reflink |              | N/A                                      |
 // +---------+--------------+------------------------------------------+
 static Try<Nothing> validateBackend(
     const string& backend,
@@ -97,6 +99,13 @@ static Try<Nothing> validateBackend(
     return Nothing();
   }
 
+  // The reflink backend clones layers where the underlying
+  // filesystem supports it and falls back to copying otherwise, so
+  // it is supported on all underlying filesystems.
+  if (backend == REFLINK_BACKEND) {
+    return Nothing();
+  }
+
   Try<uint32_t> fsType = fs::type(directory);
   if (fsType.isError()) {
     return Error(
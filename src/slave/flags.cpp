@@ -164,7 +164,7 @@ mesos::internal::slave::Flags::Flags()
   add(&Flags::image_provisioner_backend,
       "image_provisioner_backend",
       "Strategy for provisioning container rootfs from images,\n"
-      "e.g., `aufs`, `bind`, `copy`, `overlay`.");
+      "e.g., `aufs`, `bind`, `copy`, `overlay`, `reflink`.");
 
   add(&Flags::image_gc_config,
       "image_gc_config",
@@ -488,6 +488,14 @@ mesos::internal::slave::Flags::Flags()
       "and can still be used.",
       false);
 
+  add(&Flags::gc_workers,
+      "gc_workers",
+      "Number of workers that remove garbage collected directories\n"
+      "in parallel. Raising this can help churn-heavy agents whose\n"
+      "sandbox removal falls behind disk usage, at the cost of\n"
+      "additional I/O load.",
+      GC_WORKERS);
+
   add(&Flags::disk_watch_interval,
       "disk_watch_interval",
       "Periodic time interval (e.g., 10secs, 2mins, etc)\n"
@@ -1173,6 +1181,15 @@ mesos::internal::slave::Flags::Flags()
       "the operator should install a network configuration file in JSON\n"
       "format in the specified directory.");
 
+  add(&Flags::network_cni_plugin_timeout,
+      "network_cni_plugin_timeout",
+      "Maximum amount of time to wait for a CNI plugin invocation to\n"
+      "finish. The invocations for the networks a container joins run\n"
+      "concurrently, so this also bounds the duration of the container's\n"
+      "network setup and teardown phases as a whole. A plugin that does\n"
+      "not finish within the timeout is killed and the container launch\n"
+      "or cleanup fails. If unset, the isolator waits indefinitely.");
+
   add(&Flags::network_cni_root_dir_persist,
       "network_cni_root_dir_persist",
       "This setting controls whether the CNI root directory\n"
@@ -1332,6 +1349,20 @@ mesos::internal::slave::Flags::Flags()
       "the default behavior is to resolve value-based secrets and error on\n"
       "reference-based secrets.");
 
+  add(&Flags::secret_resolver_cache_ttl,
+      "secret_resolver_cache_ttl",
+      "If set, reference-based secrets resolved by the secret resolver\n"
+      "are cached for the given duration, so that a burst of container\n"
+      "launches does not pay one backend round-trip per secret. Only set\n"
+      "this if serving a secret that is up to this much stale is\n"
+      "acceptable.");
+
+  add(&Flags::secret_resolver_negative_cache_ttl,
+      "secret_resolver_negative_cache_ttl",
+      "If set together with `--secret_resolver_cache_ttl`, failed secret\n"
+      "resolutions are also cached for the given duration, protecting\n"
+      "the secret backend from retry storms.");
+
   add(&Flags::resource_estimator,
       "resource_estimator",
       "The name of the resource estimator to use for oversubscription.");
@@ -1385,6 +1416,26 @@ mesos::internal::slave::Flags::Flags()
       "production yet.",
       false);
 
+#ifndef __WINDOWS__
+  add(&Flags::http_executor_domain_sockets,
+      "http_executor_domain_sockets",
+      "If `true`, the agent serves the v1 executor API over a local domain\n"
+      "socket in addition to its TCP port, and advertises the socket to\n"
+      "executors via the `MESOS_DOMAIN_SOCKET` environment variable. This\n"
+      "avoids the TCP stack for node-local executor traffic. Requests over\n"
+      "the socket bypass HTTP authentication (access is controlled by the\n"
+      "socket's filesystem permissions), so this flag cannot be combined\n"
+      "with `--authenticate_http_executors`.",
+      false);
+
+  add(&Flags::domain_socket_location,
+      "domain_socket_location",
+      "Location where the domain socket serving the executor API is\n"
+      "created when `--http_executor_domain_sockets` is set. The path\n"
+      "must be shorter than 108 characters. By default,\n"
+      "`<runtime_dir>/agent.sock` is used.");
+#endif // __WINDOWS__
+
   add(&Flags::ip,
       "ip",
       "IP address to listen on. This cannot be used in conjunction\n"
@@ -92,6 +92,7 @@ public:
   Duration gc_delay;
   double gc_disk_headroom;
   bool gc_non_executor_container_sandboxes;
+  size_t gc_workers;
   Duration disk_watch_interval;
 
   Option<std::string> container_logger;
@@ -161,6 +162,7 @@ public:
 
   Option<std::string> network_cni_plugins_dir;
   Option<std::string> network_cni_config_dir;
+  Option<Duration> network_cni_plugin_timeout;
   bool network_cni_root_dir_persist;
   bool network_cni_metrics;
   Duration container_disk_watch_interval;
@@ -178,6 +180,8 @@ public:
   Option<Path> http_credentials;
   Option<std::string> hooks;
   Option<std::string> secret_resolver;
+  Option<Duration> secret_resolver_cache_ttl;
+  Option<Duration> secret_resolver_negative_cache_ttl;
   Option<std::string> resource_estimator;
   Option<std::string> qos_controller;
   Duration qos_correction_interval_min;
@@ -188,6 +192,10 @@ public:
   bool xfs_kill_containers;
 #endif
   bool http_command_executor;
+#ifndef __WINDOWS__
+  bool http_executor_domain_sockets;
+  Option<std::string> domain_socket_location;
+#endif // __WINDOWS__
   Option<SlaveCapabilities> agent_features;
   Option<DomainInfo> domain;
 
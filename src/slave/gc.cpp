@@ -28,7 +28,12 @@
 #include <stout/adaptor.hpp>
 #include <stout/foreach.hpp>
 #include <stout/lambda.hpp>
+#include <stout/path.hpp>
+#include <stout/uuid.hpp>
 
+#include <stout/os/exists.hpp>
+#include <stout/os/mkdir.hpp>
+#include <stout/os/rename.hpp>
 #include <stout/os/rmdir.hpp>
 
 #include "logging/logging.hpp"
@@ -88,6 +93,33 @@ GarbageCollectorProcess::~GarbageCollectorProcess()
 }
 
 
+void GarbageCollectorProcess::initialize()
+{
+  const string _trashDir = trashDir;
+
+  // Create the trash area, first removing anything that a previous
+  // run left behind. Until the directory exists renames into it fail
+  // and paths are simply removed in place.
+  auto prepare = [_trashDir]() {
+    if (os::exists(_trashDir)) {
+      Try<Nothing> rmdir = os::rmdir(_trashDir, true, true, true);
+      if (rmdir.isError()) {
+        LOG(WARNING) << "Failed to clean up trash directory '" << _trashDir
+                     << "': " << rmdir.error();
+      }
+    }
+
+    Try<Nothing> mkdir = os::mkdir(_trashDir);
+    if (mkdir.isError()) {
+      LOG(WARNING) << "Failed to create trash directory '" << _trashDir
+                   << "': " << mkdir.error();
+    }
+  };
+
+  executors.front()->execute(prepare);
+}
+
+
 Future<Nothing> GarbageCollectorProcess::schedule(
     const Duration& d,
     const string& path)
@@ -181,7 +213,10 @@ void GarbageCollectorProcess::reset()
 void GarbageCollectorProcess::remove(const Timeout& removalTime)
 {
   if (paths.count(removalTime) > 0) {
-    list<Owned<PathInfo>> infos;
+    // Partition the paths to delete across the worker executors so
+    // that large batches are removed in parallel.
+    std::vector<list<Owned<PathInfo>>> partitions(executors.size());
+    size_t total = 0;
 
     foreach (const Owned<PathInfo> info, paths.get(removalTime)) {
       if (info->removing) {
@@ -190,116 +225,149 @@ void GarbageCollectorProcess::remove(const Timeout& removalTime)
         continue;
       }
 
-      infos.push_back(info);
+      partitions[total++ % partitions.size()].push_back(info);
 
       // Set `removing` to signify that the path is being cleaned up.
       info->removing = true;
     }
 
+    if (total == 0) {
+      // All paths under this removal time are already being removed.
+      reset();
+      return;
+    }
+
     Counter _succeeded = metrics.path_removals_succeeded;
     Counter _failed = metrics.path_removals_failed;
     const string _workDir = workDir;
+    const string _trashDir = trashDir;
+
+    for (size_t i = 0; i < partitions.size(); i++) {
+      const list<Owned<PathInfo>>& infos = partitions[i];
+
+      if (infos.empty()) {
+        continue;
+      }
 
-    auto rmdirs =
-      [_succeeded, _failed, _workDir, infos]() mutable -> Future<Nothing> {
-      // Make mutable copies of the counters to work around MESOS-7907.
-      Counter succeeded = _succeeded;
-      Counter failed = _failed;
+      auto rmdirs = [_succeeded, _failed, _workDir, _trashDir, infos]() mutable
+          -> Future<Nothing> {
+        // Make mutable copies of the counters to work around MESOS-7907.
+        Counter succeeded = _succeeded;
+        Counter failed = _failed;
 
 #ifdef __linux__
-      // Clear any possible persistent volume mount points in `infos`. See
-      // MESOS-8830.
-      Try<fs::MountInfoTable> mountTable = fs::MountInfoTable::read();
-      if (mountTable.isError()) {
-        LOG(ERROR) << "Skipping any path deletion because of failure on read "
-                      "MountInfoTable for agent process: "
-                   << mountTable.error();
+        // Clear any possible persistent volume mount points in `infos`. See
+        // MESOS-8830.
+        Try<fs::MountInfoTable> mountTable = fs::MountInfoTable::read();
+        if (mountTable.isError()) {
+          LOG(ERROR) << "Skipping any path deletion because of failure on read "
+                        "MountInfoTable for agent process: "
+                     << mountTable.error();
+
+          foreach (const Owned<PathInfo>& info, infos) {
+            info->promise.fail(mountTable.error());
+            ++failed;
+          }
 
-        foreach (const Owned<PathInfo>& info, infos) {
-          info->promise.fail(mountTable.error());
-          ++failed;
+          return Failure(mountTable.error());
         }
 
-        return Failure(mountTable.error());
-      }
+        foreach (const fs::MountInfoTable::Entry& entry,
+                 adaptor::reverse(mountTable->entries)) {
+          // Ignore mounts whose targets are not under `workDir`.
+          if (!strings::startsWith(
+                  path::join(entry.target, ""),
+                  path::join(_workDir, ""))) {
+                  continue;
+          }
 
-      foreach (const fs::MountInfoTable::Entry& entry,
-               adaptor::reverse(mountTable->entries)) {
-        // Ignore mounts whose targets are not under `workDir`.
-        if (!strings::startsWith(
-                path::join(entry.target, ""),
-                path::join(_workDir, ""))) {
+          for (auto it = infos.begin(); it != infos.end(); ) {
+            const Owned<PathInfo>& info = *it;
+            // TODO(zhitao): Validate that both `info->path` and `workDir` are
+            // real paths.
+            if (strings::startsWith(
+                  path::join(entry.target, ""), path::join(info->path, ""))) {
+              LOG(WARNING)
+                  << "Unmounting dangling mount point '" << entry.target
+                  << "' of persistent volume '" << entry.root
+                  << "' inside garbage collected path '" << info->path << "'";
+
+              Try<Nothing> unmount = fs::unmount(entry.target);
+              if (unmount.isError()) {
+                LOG(WARNING) << "Skipping deletion of '"
+                             << info->path << "' because unmount failed on '"
+                             << entry.target << "': " << unmount.error();
+
+                info->promise.fail(unmount.error());
+                ++failed;
+                it = infos.erase(it);
                 continue;
+              } else {
+                break;
+              }
+            }
+
+            it++;
+          }
         }
+#endif // __linux__
 
-        for (auto it = infos.begin(); it != infos.end(); ) {
-          const Owned<PathInfo>& info = *it;
-          // TODO(zhitao): Validate that both `info->path` and `workDir` are
-          // real paths.
-          if (strings::startsWith(
-                path::join(entry.target, ""), path::join(info->path, ""))) {
-            LOG(WARNING)
-                << "Unmounting dangling mount point '" << entry.target
-                << "' of persistent volume '" << entry.root
-                << "' inside garbage collected path '" << info->path << "'";
-
-            Try<Nothing> unmount = fs::unmount(entry.target);
-            if (unmount.isError()) {
-              LOG(WARNING) << "Skipping deletion of '"
-                           << info->path << "' because unmount failed on '"
-                           << entry.target << "': " << unmount.error();
-
-              info->promise.fail(unmount.error());
-              ++failed;
-              it = infos.erase(it);
-              continue;
-            } else {
-              break;
+        foreach (const Owned<PathInfo>& info, infos) {
+          // Run the removal operation with 'continueOnError = true'.
+          // It's possible for tasks and isolators to lay down files
+          // that are not deletable by GC. In the face of such errors
+          // GC needs to free up disk space wherever it can because the
+          // disk space has already been re-offered to frameworks.
+          LOG(INFO) << "Deleting " << info->path;
+
+          // First try to move the directory into the trash area so
+          // that its path is reclaimed immediately and the (slow) walk
+          // and unlink operates on the renamed directory instead. The
+          // rename can fail legitimately, e.g., if the path still
+          // contains mount points; in that case remove in place.
+          string removalPath = info->path;
+
+          if (os::exists(_trashDir)) {
+            const string trashPath =
+              path::join(_trashDir, id::UUID::random().toString());
+
+            if (os::rename(info->path, trashPath).isSome()) {
+              removalPath = trashPath;
             }
           }
 
-          it++;
-        }
-      }
-#endif // __linux__
+          Try<Nothing> rmdir = os::rmdir(removalPath, true, true, true);
+
+          if (rmdir.isError()) {
+            // TODO(zhitao): Change return value type of `rmdir` to
+            // `Try<Nothing, ErrnoError>` and check error type instead.
+            if (rmdir.error() == ErrnoError(ENOENT).message) {
+              LOG(INFO) << "Skipped '" << info->path
+                        << "' which does not exist";
+            } else {
+              LOG(WARNING) << "Failed to delete '" << info->path << "': "
+                           << rmdir.error();
+              info->promise.fail(rmdir.error());
 
-      foreach (const Owned<PathInfo>& info, infos) {
-        // Run the removal operation with 'continueOnError = true'.
-        // It's possible for tasks and isolators to lay down files
-        // that are not deletable by GC. In the face of such errors
-        // GC needs to free up disk space wherever it can because the
-        // disk space has already been re-offered to frameworks.
-        LOG(INFO) << "Deleting " << info->path;
-        Try<Nothing> rmdir = os::rmdir(info->path, true, true, true);
-
-        if (rmdir.isError()) {
-          // TODO(zhitao): Change return value type of `rmdir` to
-          // `Try<Nothing, ErrnoError>` and check error type instead.
-          if (rmdir.error() == ErrnoError(ENOENT).message) {
-            LOG(INFO) << "Skipped '" << info->path << "' which does not exist";
+              ++failed;
+            }
           } else {
-            LOG(WARNING) << "Failed to delete '" << info->path << "': "
-                         << rmdir.error();
-            info->promise.fail(rmdir.error());
+            LOG(INFO) << "Deleted '" << info->path << "'";
+            info->promise.set(rmdir.get());
 
-            ++failed;
+            ++succeeded;
           }
-        } else {
-          LOG(INFO) << "Deleted '" << info->path << "'";
-          info->promise.set(rmdir.get());
-
-          ++succeeded;
         }
-      }
 
-      return Nothing();
-    };
+        return Nothing();
+      };
 
-    // NOTE: All `rmdirs` calls are dispatched to one executor so that:
-    //   1. They do not block other dispatches (MESOS-6549).
-    //   2. They do not occupy all worker threads (MESOS-7964).
-    executor.execute(rmdirs)
-      .onAny(defer(self(), &Self::_remove, lambda::_1, infos));
+      // NOTE: `rmdirs` calls are dispatched to dedicated executors so that:
+      //   1. They do not block other dispatches (MESOS-6549).
+      //   2. They do not occupy all worker threads (MESOS-7964).
+      executors[i]->execute(rmdirs)
+        .onAny(defer(self(), &Self::_remove, lambda::_1, infos));
+    }
   } else {
     // This occurs when either:
     //   1. The path(s) has already been removed (e.g. by prune()).
@@ -336,9 +404,9 @@ void GarbageCollectorProcess::prune(const Duration& d)
 }
 
 
-GarbageCollector::GarbageCollector(const string& workDir)
+GarbageCollector::GarbageCollector(const string& workDir, size_t workers)
 {
-  process = new GarbageCollectorProcess(workDir);
+  process = new GarbageCollectorProcess(workDir, workers);
   spawn(process);
 }
 
@@ -25,6 +25,8 @@
 #include <stout/duration.hpp>
 #include <stout/nothing.hpp>
 
+#include "slave/constants.hpp"
+
 namespace mesos {
 namespace internal {
 namespace slave {
@@ -42,7 +44,9 @@ class GarbageCollectorProcess;
 class GarbageCollector
 {
 public:
-  explicit GarbageCollector(const std::string& workDir);
+  explicit GarbageCollector(
+      const std::string& workDir,
+      size_t workers = GC_WORKERS);
   virtual ~GarbageCollector();
 
   // Schedules the specified path for removal after the specified
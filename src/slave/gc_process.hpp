@@ -17,8 +17,10 @@
 #ifndef __SLAVE_GC_PROCESS_HPP__
 #define __SLAVE_GC_PROCESS_HPP__
 
+#include <algorithm>
 #include <list>
 #include <string>
+#include <vector>
 
 #include <process/executor.hpp>
 #include <process/future.hpp>
@@ -35,6 +37,7 @@
 #include <stout/hashmap.hpp>
 #include <stout/multimap.hpp>
 #include <stout/nothing.hpp>
+#include <stout/path.hpp>
 #include <stout/try.hpp>
 
 namespace mesos {
@@ -45,10 +48,18 @@ class GarbageCollectorProcess :
     public process::Process<GarbageCollectorProcess>
 {
 public:
-  explicit GarbageCollectorProcess(const std::string& _workDir)
+  GarbageCollectorProcess(const std::string& _workDir, size_t workers)
     : ProcessBase(process::ID::generate("agent-garbage-collector")),
       metrics(this),
-      workDir(_workDir) {}
+      workDir(_workDir),
+      trashDir(path::join(_workDir, "gc_trash"))
+  {
+    // Always use at least one worker.
+    for (size_t i = 0; i < std::max<size_t>(workers, 1u); i++) {
+      executors.push_back(
+          process::Owned<process::Executor>(new process::Executor()));
+    }
+  }
 
   ~GarbageCollectorProcess() override;
 
@@ -61,6 +72,8 @@ public:
   void prune(const Duration& d);
 
 private:
+  void initialize() override;
+
   void reset();
 
   void remove(const process::Timeout& removalTime);
@@ -100,6 +113,11 @@ private:
 
   const std::string workDir;
 
+  // Doomed directories are first renamed into this directory so that
+  // their paths are reclaimed immediately; the actual removal then
+  // operates on the renamed directories.
+  const std::string trashDir;
+
   // Store all the timeouts and corresponding paths to delete.
   // NOTE: We are using Multimap here instead of Multihashmap, because
   // we need the keys of the map (deletion time) to be sorted.
@@ -111,8 +129,11 @@ private:
 
   process::Timer timer;
 
-  // For executing path removals in a separate actor.
-  process::Executor executor;
+  // For executing path removals in separate actors. Batches of
+  // removals are partitioned round-robin across the executors so
+  // that they proceed in parallel without blocking other dispatches
+  // (MESOS-6549) or occupying all worker threads (MESOS-7964).
+  std::vector<process::Owned<process::Executor>> executors;
 };
 
 } // namespace slave {
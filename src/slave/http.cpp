@@ -853,6 +853,19 @@ Future<Response> Http::executor(
       return Accepted();
     }
 
+    case executor::Call::UPDATE_BATCH: {
+      foreach (const executor::Call::Update& update,
+               call.update_batch().updates()) {
+        slave->statusUpdate(protobuf::createStatusUpdate(
+            call.framework_id(),
+            update.status(),
+            slave->info.id()),
+            None());
+      }
+
+      return Accepted();
+    }
+
     case executor::Call::MESSAGE: {
       slave->executorMessage(
           slave->info.id(),
@@ -1001,6 +1014,27 @@ Future<Response> Http::health(const Request& request) const
 }
 
 
+string Http::MESSAGES_HELP()
+{
+  return HELP(
+    TLDR(
+        "Statistics on the protobuf messages received by the agent."),
+    DESCRIPTION(
+        "Returns the sampled per-message-type count, wire bytes and",
+        "parse time of the protobuf messages received by the agent,",
+        "ranked by wire bytes, i.e. the biggest bandwidth consumers",
+        "first. Only every 'sample_interval'-th message is measured;",
+        "scale the reported figures accordingly to estimate totals."),
+    AUTHENTICATION(false));
+}
+
+
+Future<Response> Http::messages(const Request& request) const
+{
+  return OK(modelMessageCensus(), request.url.query.get("jsonp"));
+}
+
+
 Future<Response> Http::getHealth(
     const mesos::agent::Call& call,
     ContentType acceptType,
@@ -2176,7 +2210,7 @@ Future<JSON::Array> Http::__containers(
 
           metadata->push_back(entry);
           statusFutures.push_back(slave->containerizer->status(containerId));
-          statsFutures.push_back(slave->containerizer->usage(containerId));
+          statsFutures.push_back(slave->containerUsage(containerId));
         }
       }
 
@@ -2234,7 +2268,7 @@ Future<JSON::Array> Http::__containers(
 
         metadata->push_back(entry);
         statusFutures.push_back(slave->containerizer->status(containerId));
-        statsFutures.push_back(slave->containerizer->usage(containerId));
+        statsFutures.push_back(slave->containerUsage(containerId));
       }
 
       return await(await(statusFutures), await(statsFutures)).then(
@@ -3538,7 +3572,10 @@ Future<Response> Http::_attachContainerOutput(
           Pipe::Reader reader = response.reader.get();
 
           auto deserializer = lambda::bind(
-              deserialize<ProcessIO>, messageContentType, lambda::_1);
+              deserializeSlice<ProcessIO>,
+              messageContentType,
+              lambda::_1,
+              lambda::_2);
 
           Owned<Reader<ProcessIO>> decoder(new Reader<ProcessIO>(
               Decoder<ProcessIO>(deserializer), reader));
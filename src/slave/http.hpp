@@ -65,6 +65,10 @@ public:
   process::Future<process::http::Response> health(
       const process::http::Request& request) const;
 
+  // /slave/messages
+  process::Future<process::http::Response> messages(
+      const process::http::Request& request) const;
+
   // /slave/state
   process::Future<process::http::Response> state(
       const process::http::Request& request,
@@ -85,6 +89,7 @@ public:
   static std::string RESOURCE_PROVIDER_HELP();
   static std::string FLAGS_HELP();
   static std::string HEALTH_HELP();
+  static std::string MESSAGES_HELP();
   static std::string STATE_HELP();
   static std::string STATISTICS_HELP();
   static std::string CONTAINERS_HELP();
@@ -48,6 +48,7 @@
 #include <stout/proc.hpp>
 #endif // __linux__
 
+#include <stout/stopwatch.hpp>
 #include <stout/stringify.hpp>
 #include <stout/try.hpp>
 #include <stout/version.hpp>
@@ -383,6 +384,22 @@ int main(int argc, char** argv)
 
   spawn(new VersionProcess(), true);
 
+  // Agents can take a long time to reach recovery, which multiplies
+  // across rolling restarts, so log the elapsed time of each
+  // initialization phase to make regressions in the cold-start
+  // latency budget visible and deferral work targetable.
+  Stopwatch startup;
+  startup.start();
+
+  Stopwatch phase;
+  phase.start();
+
+  auto logPhaseTime = [&phase](const string& name) {
+    LOG(INFO) << "Agent initialization phase '" << name << "' took "
+              << phase.elapsed();
+    phase.start();
+  };
+
   if (flags.firewall_rules.isSome()) {
     vector<Owned<FirewallRule>> rules;
 
@@ -438,6 +455,8 @@ int main(int argc, char** argv)
     // terminating.
   }
 
+  logPhaseTime("modules");
+
   // Initialize hooks.
   if (flags.hooks.isSome()) {
     Try<Nothing> result = HookManager::initialize(flags.hooks.get());
@@ -446,6 +465,8 @@ int main(int argc, char** argv)
     }
   }
 
+  logPhaseTime("hooks");
+
 #ifdef __linux__
   // Initialize systemd if it exists.
   if (flags.systemd_enable_support && systemd::exists()) {
@@ -465,11 +486,15 @@ int main(int argc, char** argv)
 #endif // __linux__
 
   Fetcher* fetcher = new Fetcher(flags);
-  GarbageCollector* gc = new GarbageCollector(flags.work_dir);
+  GarbageCollector* gc =
+    new GarbageCollector(flags.work_dir, flags.gc_workers);
 
   // Initialize SecretResolver.
   Try<SecretResolver*> secretResolver =
-    mesos::SecretResolver::create(flags.secret_resolver);
+    mesos::SecretResolver::create(
+        flags.secret_resolver,
+        flags.secret_resolver_cache_ttl,
+        flags.secret_resolver_negative_cache_ttl);
 
   if (secretResolver.isError()) {
     EXIT(EXIT_FAILURE)
@@ -484,6 +509,8 @@ int main(int argc, char** argv)
       << "Failed to create a containerizer: " << containerizer.error();
   }
 
+  logPhaseTime("containerizer");
+
   Try<MasterDetector*> detector_ = MasterDetector::create(
       flags.master.isSome() ? flags.master->value : Option<string>::none(),
       flags.master_detector,
@@ -592,6 +619,10 @@ int main(int argc, char** argv)
       secretGenerator,
       authorizer_);
 
+  logPhaseTime("slave");
+
+  LOG(INFO) << "Agent initialization took " << startup.elapsed();
+
   process::spawn(slave);
   process::wait(slave->self());
 
@@ -247,6 +247,10 @@ Metrics::~Metrics()
   if (recovery_time_secs.isSome()) {
     process::metrics::remove(recovery_time_secs.get());
   }
+
+  if (state_recovery_time_secs.isSome()) {
+    process::metrics::remove(state_recovery_time_secs.get());
+  }
 }
 
 
@@ -263,6 +267,20 @@ void Metrics::setRecoveryTime(const Duration& duration)
   process::metrics::add(recovery_time_secs.get());
 }
 
+
+void Metrics::setStateRecoveryTime(const Duration& duration)
+{
+  CHECK_NONE(state_recovery_time_secs);
+
+  const double recovery_seconds = duration.secs();
+
+  state_recovery_time_secs = process::metrics::PullGauge(
+        "slave/state_recovery_time_secs",
+        [recovery_seconds]() { return recovery_seconds;});
+
+  process::metrics::add(state_recovery_time_secs.get());
+}
+
 } // namespace slave {
 } // namespace internal {
 } // namespace mesos {
@@ -37,12 +37,18 @@ struct Metrics
 
   void setRecoveryTime(const Duration& duration);
 
+  void setStateRecoveryTime(const Duration& duration);
+
   process::metrics::PullGauge uptime_secs;
   process::metrics::PullGauge registered;
 
   process::metrics::Counter recovery_errors;
   Option<process::metrics::PullGauge> recovery_time_secs;
 
+  // Time to read the checkpointed state from the meta directory,
+  // i.e., the `state::recover()` phase of recovery.
+  Option<process::metrics::PullGauge> state_recovery_time_secs;
+
   process::metrics::PullGauge frameworks_active;
 
   process::metrics::PullGauge tasks_staging;
@@ -65,6 +65,7 @@ const char FORKED_PID_FILE[] = "forked.pid";
 const char TASK_INFO_FILE[] = "task.info";
 const char TASK_UPDATES_FILE[] = "task.updates";
 const char RESOURCES_INFO_FILE[] = "resources.info";
+const char DOMAIN_SOCKET_FILE[] = "agent.sock";
 const char RESOURCES_TARGET_FILE[] = "resources.target";
 const char RESOURCE_PROVIDER_STATE_FILE[] = "resource_provider.state";
 const char OPERATION_UPDATES_FILE[] = "operation.updates";
@@ -151,6 +152,12 @@ string getCsiRootDir(const string& workDir)
 }
 
 
+string getDomainSocketPath(const string& runtimeDir)
+{
+  return path::join(runtimeDir, DOMAIN_SOCKET_FILE);
+}
+
+
 string getBootIdPath(const string& rootDir)
 {
   return path::join(rootDir, BOOT_ID_FILE);
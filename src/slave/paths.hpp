@@ -149,6 +149,9 @@ std::string getProvisionerDir(const std::string& rootDir);
 std::string getCsiRootDir(const std::string& workDir);
 
 
+std::string getDomainSocketPath(const std::string& runtimeDir);
+
+
 std::string getLatestSlavePath(const std::string& rootDir);
 
 
@@ -86,6 +86,7 @@
 #include "common/protobuf_utils.hpp"
 #include "common/resources_utils.hpp"
 #include "common/status_utils.hpp"
+#include "common/tracepoints.hpp"
 #include "common/validation.hpp"
 
 #include "credentials/credentials.hpp"
@@ -120,6 +121,7 @@
 #endif // __WINDOWS__
 
 namespace http = process::http;
+namespace network = process::network;
 
 using google::protobuf::RepeatedPtrField;
 
@@ -225,6 +227,8 @@ Slave::Slave(const string& id,
     qosController(_qosController),
     secretGenerator(_secretGenerator),
     authorizer(_authorizer),
+    containerUsageCacheTime(Time::epoch()),
+    usageCacheTime(Time::epoch()),
     resourceVersion(protobuf::createUUID()) {}
 
 
@@ -713,6 +717,9 @@ void Slave::initialize()
       &StatusUpdateAcknowledgementMessage::task_id,
       &StatusUpdateAcknowledgementMessage::uuid);
 
+  install<BatchedStatusUpdateAcknowledgementsMessage>(
+      &Slave::batchedStatusUpdateAcknowledgements);
+
   install<AcknowledgeOperationStatusMessage>(
       &Slave::operationStatusAcknowledgement);
 
@@ -772,6 +779,98 @@ void Slave::initialize()
           logRequest(request);
           return http.executor(request, principal);
         });
+
+#ifndef __WINDOWS__
+  if (flags.http_executor_domain_sockets) {
+    // Requests arriving over the domain socket bypass the libprocess
+    // HTTP authentication routing; access is controlled by the
+    // socket's filesystem permissions instead.
+#ifdef USE_SSL_SOCKET
+    if (flags.authenticate_http_executors) {
+      EXIT(EXIT_FAILURE)
+        << "--http_executor_domain_sockets cannot be combined with"
+        << " --authenticate_http_executors";
+    }
+#endif // USE_SSL_SOCKET
+
+    const string socketPath = flags.domain_socket_location.getOrElse(
+        paths::getDomainSocketPath(flags.runtime_dir));
+
+    Try<network::unix::Address> address =
+      network::unix::Address::create(socketPath);
+
+    if (address.isError()) {
+      EXIT(EXIT_FAILURE)
+        << "Failed to create domain socket address from '" << socketPath
+        << "': " << address.error();
+    }
+
+    // Remove a stale socket left behind by a previous run; executors
+    // from that run will reconnect over the new socket.
+    if (os::exists(socketPath)) {
+      Try<Nothing> rm = os::rm(socketPath);
+      if (rm.isError()) {
+        EXIT(EXIT_FAILURE)
+          << "Failed to remove stale domain socket '" << socketPath
+          << "': " << rm.error();
+      }
+    }
+
+    Try<http::Server> server = http::Server::create(
+        address.get(),
+        [this](const network::Socket&, http::Request request)
+            -> Future<http::Response> {
+          // Only the executor API is offered on this socket.
+          if (!strings::endsWith(request.url.path, "/api/v1/executor")) {
+            return http::NotFound();
+          }
+
+          // The server always streams requests to its handler, but
+          // the executor handler expects the body to have been read.
+          CHECK_EQ(http::Request::PIPE, request.type);
+          CHECK_SOME(request.reader);
+
+          http::Pipe::Reader reader = request.reader.get();
+
+          return reader.readAll()
+            .then(defer(self(), [this, request](const string& body) {
+              http::Request request_ = request;
+              request_.type = http::Request::BODY;
+              request_.body = body;
+              request_.reader = None();
+
+              logRequest(request_);
+              return http.executor(request_, None());
+            }));
+        });
+
+    if (server.isError()) {
+      EXIT(EXIT_FAILURE)
+        << "Failed to create domain socket server on '" << socketPath
+        << "': " << server.error();
+    }
+
+    // Executors may run as arbitrary task users, so they need to be
+    // able to connect to (i.e., write to) the socket.
+    Try<Nothing> chmod = os::chmod(socketPath, 0666);
+    if (chmod.isError()) {
+      EXIT(EXIT_FAILURE)
+        << "Failed to set permissions on domain socket '" << socketPath
+        << "': " << chmod.error();
+    }
+
+    LOG(INFO) << "Serving the executor API on domain socket '"
+              << socketPath << "'";
+
+    executorSocketServer.reset(new http::Server(std::move(server.get())));
+
+    executorSocketServer->run()
+      .onFailed([socketPath](const string& failure) {
+        LOG(ERROR) << "Domain socket server on '" << socketPath
+                   << "' failed: " << failure;
+      });
+  }
+#endif // __WINDOWS__
   route(
       "/api/v1/resource_provider",
       RESOURCE_PROVIDER_HTTP_AUTHENTICATION_REALM,
@@ -818,6 +917,12 @@ void Slave::initialize()
         [this](const http::Request& request) {
           return http.health(request);
         });
+  route("/messages",
+        Http::MESSAGES_HELP(),
+        [this](const http::Request& request) {
+          logRequest(request);
+          return http.messages(request);
+        });
   route("/monitor/statistics",
         READONLY_HTTP_AUTHENTICATION_REALM,
         Http::STATISTICS_HELP(),
@@ -1693,7 +1798,7 @@ void Slave::reregistered(
             taskId,
             taskState,
             TaskStatus::SOURCE_SLAVE,
-            id::UUID::random(),
+            id::UUID::sequential(),
             "Reconciliation: task unknown to the agent",
             TaskStatus::REASON_RECONCILIATION);
 
@@ -1931,6 +2036,11 @@ void Slave::runTask(
     << "Task " << task.task_id()
     << " should have either CommandInfo or ExecutorInfo set but not both";
 
+  MESOS_TRACEPOINT2(
+      slave_run_task,
+      frameworkId.value().c_str(),
+      task.task_id().value().c_str());
+
   if (master != from) {
     LOG(WARNING) << "Ignoring run task message from " << from
                  << " because it is not the expected master: "
@@ -2198,7 +2308,7 @@ void Slave::run(
             _task.task_id(),
             taskState,
             TaskStatus::SOURCE_SLAVE,
-            id::UUID::random(),
+            id::UUID::sequential(),
             "Could not launch the task because we failed to unschedule"
             " directories scheduled for gc",
             TaskStatus::REASON_GC_ERROR);
@@ -2430,7 +2540,7 @@ Future<Nothing> Slave::_run(
             _task.task_id(),
             TASK_ERROR,
             TaskStatus::SOURCE_SLAVE,
-            id::UUID::random(),
+            id::UUID::sequential(),
             error,
             reason);
 
@@ -2566,7 +2676,7 @@ void Slave::__run(
             _task.task_id(),
             taskState,
             TaskStatus::SOURCE_SLAVE,
-            id::UUID::random(),
+            id::UUID::sequential(),
             message,
             reason,
             executorId);
@@ -3016,7 +3126,7 @@ void Slave::__run(
             _task.task_id(),
             taskState,
             TaskStatus::SOURCE_SLAVE,
-            id::UUID::random(),
+            id::UUID::sequential(),
             "Executor " + executorState,
             TaskStatus::REASON_EXECUTOR_TERMINATED);
 
@@ -3027,9 +3137,7 @@ void Slave::__run(
     }
     case Executor::REGISTERING:
       if (executor->checkpoint) {
-        foreach (const TaskInfo& _task, tasks) {
-          executor->checkpointTask(_task);
-        }
+        executor->checkpointTasks(tasks);
       }
 
       if (taskGroup.isSome()) {
@@ -3046,9 +3154,7 @@ void Slave::__run(
       break;
     case Executor::RUNNING: {
       if (executor->checkpoint) {
-        foreach (const TaskInfo& _task, tasks) {
-          executor->checkpointTask(_task);
-        }
+        executor->checkpointTasks(tasks);
       }
 
       // Queue tasks until the containerizer is updated
@@ -3686,7 +3792,7 @@ void Slave::killTask(
             task.task_id(),
             TASK_KILLED,
             TaskStatus::SOURCE_SLAVE,
-            id::UUID::random(),
+            id::UUID::sequential(),
             "A task within the task group was killed before"
             " delivery to the executor",
             TaskStatus::REASON_TASK_KILLED_DURING_LAUNCH,
@@ -3700,7 +3806,7 @@ void Slave::killTask(
           taskId,
           TASK_KILLED,
           TaskStatus::SOURCE_SLAVE,
-          id::UUID::random(),
+          id::UUID::sequential(),
           "Killed before delivery to the executor",
           TaskStatus::REASON_TASK_KILLED_DURING_LAUNCH,
           CHECK_NOTNONE(
@@ -3738,7 +3844,7 @@ void Slave::killTask(
         taskId,
         taskState,
         TaskStatus::SOURCE_SLAVE,
-        id::UUID::random(),
+        id::UUID::sequential(),
         "Cannot find executor",
         TaskStatus::REASON_EXECUTOR_TERMINATED);
 
@@ -3765,7 +3871,7 @@ void Slave::killTask(
               task.task_id(),
               TASK_KILLED,
               TaskStatus::SOURCE_SLAVE,
-              id::UUID::random(),
+              id::UUID::sequential(),
               "A task within the task group was killed before"
               " delivery to the executor",
               TaskStatus::REASON_TASK_KILLED_DURING_LAUNCH,
@@ -3778,7 +3884,7 @@ void Slave::killTask(
             taskId,
             TASK_KILLED,
             TaskStatus::SOURCE_SLAVE,
-            id::UUID::random(),
+            id::UUID::sequential(),
             "Killed before delivery to the executor",
             TaskStatus::REASON_TASK_KILLED_DURING_LAUNCH,
             executor->id));
@@ -3827,7 +3933,7 @@ void Slave::killTask(
                 task.task_id(),
                 TASK_KILLED,
                 TaskStatus::SOURCE_SLAVE,
-                id::UUID::random(),
+                id::UUID::sequential(),
                 "Killed before delivery to the executor",
                 TaskStatus::REASON_TASK_KILLED_DURING_LAUNCH,
                 executor->id));
@@ -3839,7 +3945,7 @@ void Slave::killTask(
               taskId,
               TASK_KILLED,
               TaskStatus::SOURCE_SLAVE,
-              id::UUID::random(),
+              id::UUID::sequential(),
               "Killed before delivery to the executor",
               TaskStatus::REASON_TASK_KILLED_DURING_LAUNCH,
               executor->id));
@@ -4523,6 +4629,25 @@ void Slave::statusUpdateAcknowledgement(
 }
 
 
+void Slave::batchedStatusUpdateAcknowledgements(
+    const UPID& from,
+    const BatchedStatusUpdateAcknowledgementsMessage& message)
+{
+  VLOG(1) << "Received " << message.acknowledgements_size()
+          << " batched status update acknowledgements from " << from;
+
+  foreach (const StatusUpdateAcknowledgementMessage& acknowledgement,
+           message.acknowledgements()) {
+    statusUpdateAcknowledgement(
+        from,
+        acknowledgement.slave_id(),
+        acknowledgement.framework_id(),
+        acknowledgement.task_id(),
+        acknowledgement.uuid());
+  }
+}
+
+
 void Slave::_statusUpdateAcknowledgement(
     const Future<bool>& future,
     const TaskID& taskId,
@@ -4760,7 +4885,7 @@ void Slave::subscribe(
               task->task_id(),
               newTaskState,
               TaskStatus::SOURCE_SLAVE,
-              id::UUID::random(),
+              id::UUID::sequential(),
               "Task launched during agent restart",
               TaskStatus::REASON_SLAVE_RESTARTED,
               executor->id);
@@ -5153,7 +5278,7 @@ void Slave::reregisterExecutor(
               task->task_id(),
               newTaskState,
               TaskStatus::SOURCE_SLAVE,
-              id::UUID::random(),
+              id::UUID::sequential(),
               "Task launched during agent restart",
               TaskStatus::REASON_SLAVE_RESTARTED,
               executorId);
@@ -6945,6 +7070,8 @@ Future<Nothing> Slave::recover(const Try<state::State>& state)
   LOG(INFO) << "Finished recovering checkpointed state from '" << metaDir
             << "', beginning agent recovery";
 
+  metrics.setStateRecoveryTime(Clock::now() - startTime);
+
   Option<ResourcesState> resourcesState = state->resources;
   Option<SlaveState> slaveState = state->slave;
 
@@ -7342,20 +7469,23 @@ void Slave::__recover(const Future<Nothing>& future)
   // in the recovery code, to recover all slaves instead of only
   // the latest slave.
   const string directory = path::join(flags.work_dir, "slaves");
-  Try<list<string>> entries = os::ls(directory);
+  // NOTE: We use `os::lsdir` so that filtering out non-directory
+  // entries does not cost a `stat` call per entry.
+  Try<vector<os::DirEntry>> entries = os::lsdir(directory);
   if (entries.isSome()) {
-    foreach (const string& entry, entries.get()) {
-      string path = path::join(directory, entry);
+    foreach (const os::DirEntry& entry, entries.get()) {
       // Ignore non-directory entries.
-      if (!os::stat::isdir(path)) {
+      if (entry.type != os::DirEntry::Type::DIRECTORY) {
         continue;
       }
 
+      string path = path::join(directory, entry.name);
+
       // We garbage collect a directory if either the slave has not
       // recovered its id (hence going to get a new id when it
       // registers with the master) or if it is an old work directory.
       SlaveID slaveId;
-      slaveId.set_value(entry);
+      slaveId.set_value(entry.name);
       if (!info.has_id() || slaveId != info.id()) {
         LOG(INFO) << "Garbage collecting old agent " << slaveId;
 
@@ -8387,6 +8517,15 @@ void Slave::_qosCorrections(const Future<list<QoSCorrection>>& future)
 
 Future<ResourceUsage> Slave::usage()
 {
+  // Serve the memoized snapshot if the executor/task topology has not
+  // changed since it was built and its statistics are still within
+  // the collection window. This makes the cost of concurrent pollers
+  // proportional to activity rather than to the number of containers.
+  if (usageCache.isSome() &&
+      Clock::now() - usageCacheTime <= CONTAINER_USAGE_CACHE_WINDOW) {
+    return usageCache.get();
+  }
+
   // NOTE: We use 'Owned' here trying to avoid the expensive copy.
   // C++11 lambda only supports capturing variables that have copy
   // constructors. Revisit once we remove the copy constructor for
@@ -8419,13 +8558,13 @@ Future<ResourceUsage> Slave::usage()
         }
       }
 
-      futures.push_back(containerizer->usage(executor->containerId));
+      futures.push_back(containerUsage(executor->containerId));
     }
   }
 
   usage->mutable_total()->CopyFrom(totalResources);
 
-  return await(futures).then(
+  usageCache = await(futures).then(
       [usage](const vector<Future<ResourceStatistics>>& futures) {
         // NOTE: We add ResourceUsage::Executor to 'usage' the same
         // order as we push future to 'futures'. So the variables
@@ -8450,6 +8589,48 @@ Future<ResourceUsage> Slave::usage()
 
         return Future<ResourceUsage>(*usage);
       });
+
+  usageCacheTime = Clock::now();
+
+  return usageCache.get();
+}
+
+
+Future<ResourceStatistics> Slave::containerUsage(
+    const ContainerID& containerId)
+{
+  const Time now = Clock::now();
+
+  // Invalidate the cache once it is older than the window. Note that
+  // this may memoize a failed collection, but only for the duration
+  // of the window.
+  if (now - containerUsageCacheTime > CONTAINER_USAGE_CACHE_WINDOW) {
+    containerUsageCache.clear();
+    containerUsageCacheTime = now;
+  }
+
+  if (!containerUsageCache.contains(containerId)) {
+    containerUsageCache.put(
+        containerId,
+        containerizer->usage(containerId)
+          .after(
+              CONTAINER_USAGE_COLLECTION_TIMEOUT,
+              [containerId](Future<ResourceStatistics> future)
+                  -> Future<ResourceStatistics> {
+                future.discard();
+                return Failure(
+                    "Timed out collecting resource statistics for container " +
+                    stringify(containerId));
+              }));
+  }
+
+  return containerUsageCache.at(containerId);
+}
+
+
+void Slave::invalidateUsageCache()
+{
+  usageCache = None();
 }
 
 
@@ -8616,7 +8797,7 @@ void Slave::sendExecutorTerminatedStatusUpdate(
           taskId,
           state,
           TaskStatus::SOURCE_SLAVE,
-          id::UUID::random(),
+          id::UUID::sequential(),
           message,
           reason,
           executor->id,
@@ -8921,13 +9102,15 @@ bool Framework::idle() const
 
 void Framework::checkpointFramework() const
 {
+  state::CheckpointGroup group;
+
   // Checkpoint the framework info.
   string path = paths::getFrameworkInfoPath(
       slave->metaDir, slave->info.id(), id());
 
   VLOG(1) << "Checkpointing FrameworkInfo to '" << path << "'";
 
-  CHECK_SOME(state::checkpoint(path, info));
+  CHECK_SOME(group.add(path, info));
 
   // Checkpoint the framework pid, note that we checkpoint a
   // UPID() when it is None (for HTTP schedulers) because
@@ -8940,7 +9123,9 @@ void Framework::checkpointFramework() const
           << " '" << pid.getOrElse(UPID()) << "'"
           << " to '" << path << "'";
 
-  CHECK_SOME(state::checkpoint(path, pid.getOrElse(UPID())));
+  CHECK_SOME(group.add(path, pid.getOrElse(UPID())));
+
+  CHECK_SOME(group.commit());
 }
 
 
@@ -9011,6 +9196,8 @@ Try<Executor*> Framework::addExecutor(const ExecutorInfo& executorInfo)
 
   executors[executorInfo.executor_id()] = executor;
 
+  slave->invalidateUsageCache();
+
   LOG(INFO) << "Launching executor '" << executorInfo.executor_id()
             << "' of framework " << id()
             << " with resources " << executorInfo.resources()
@@ -9120,6 +9307,8 @@ void Framework::destroyExecutor(const ExecutorID& executorId)
 
     // Pass ownership of the executor pointer.
     completedExecutors.push_back(Owned<Executor>(executor));
+
+    slave->invalidateUsageCache();
   }
 }
 
@@ -9590,6 +9779,8 @@ Executor::~Executor()
 void Executor::enqueueTask(const TaskInfo& task)
 {
   queuedTasks[task.task_id()] = task;
+
+  slave->invalidateUsageCache();
 }
 
 
@@ -9600,6 +9791,8 @@ void Executor::enqueueTaskGroup(const TaskGroupInfo& taskGroup)
   }
 
   queuedTaskGroups.push_back(taskGroup);
+
+  slave->invalidateUsageCache();
 }
 
 
@@ -9609,6 +9802,8 @@ Option<TaskInfo> Executor::dequeueTask(const TaskID& taskId)
 
   queuedTasks.erase(taskId);
 
+  slave->invalidateUsageCache();
+
   // Remove the task group if all of its tasks have been dequeued.
   for (auto it = queuedTaskGroups.begin(); it != queuedTaskGroups.end(); ++it) {
     foreach (const TaskInfo& t, it->tasks()) {
@@ -9658,6 +9853,8 @@ Task* Executor::addLaunchedTask(const TaskInfo& task)
 
   launchedTasks[task.task_id()] = t;
 
+  slave->invalidateUsageCache();
+
   if (info.has_type() && info.type() == ExecutorInfo::DEFAULT) {
     slave->attachTaskVolumeDirectory(info, containerId, *t);
   }
@@ -9730,6 +9927,34 @@ void Executor::checkpointTask(const TaskInfo& task)
 }
 
 
+void Executor::checkpointTasks(const vector<TaskInfo>& tasks)
+{
+  CHECK(checkpoint);
+
+  // Checkpoint all the tasks in one group so that the task info
+  // directories are synced (if syncing is enabled) once for the whole
+  // batch instead of once per task.
+  state::CheckpointGroup group;
+
+  foreach (const TaskInfo& task, tasks) {
+    const string path = paths::getTaskInfoPath(
+        slave->metaDir,
+        slave->info.id(),
+        frameworkId,
+        id,
+        containerId,
+        task.task_id());
+
+    VLOG(1) << "Checkpointing TaskInfo to '" << path << "'";
+
+    CHECK_SOME(group.add(
+        path, protobuf::createTask(task, TASK_STAGING, frameworkId)));
+  }
+
+  CHECK_SOME(group.commit());
+}
+
+
 void Executor::checkpointTask(const Task& task)
 {
   CHECK(checkpoint);
@@ -9830,6 +10055,8 @@ Try<Nothing> Executor::updateTaskState(const TaskStatus& status)
 
     if (terminal) {
       launchedTasks.erase(taskId);
+
+      slave->invalidateUsageCache();
     }
   } else if (terminatedTasks.contains(taskId)) {
     return Error("Task is already terminated with state"
@@ -10041,6 +10268,16 @@ map<string, string> executorEnvironment(
   environment["MESOS_SLAVE_ID"] = slaveId.value();
   environment["MESOS_SLAVE_PID"] = stringify(slavePid);
   environment["MESOS_AGENT_ENDPOINT"] = stringify(slavePid.address);
+
+#ifndef __WINDOWS__
+  // Advertise the domain socket serving the executor API so that
+  // local executors can skip the TCP stack; see the
+  // `--http_executor_domain_sockets` flag.
+  if (flags.http_executor_domain_sockets) {
+    environment["MESOS_DOMAIN_SOCKET"] = flags.domain_socket_location.getOrElse(
+        paths::getDomainSocketPath(flags.runtime_dir));
+  }
+#endif // __WINDOWS__
   environment["MESOS_CHECKPOINT"] = checkpoint ? "1" : "0";
   environment["MESOS_HTTP_COMMAND_EXECUTOR"] =
     flags.http_command_executor ? "1" : "0";
@@ -57,6 +57,7 @@
 #include <process/protobuf.hpp>
 #include <process/shared.hpp>
 #include <process/sequence.hpp>
+#include <process/time.hpp>
 
 #include <stout/boundedhashmap.hpp>
 #include <stout/bytes.hpp>
@@ -359,6 +360,12 @@ public:
       const TaskID& taskId,
       const std::string& uuid);
 
+  // Handles a batch of status update acknowledgements coalesced by
+  // the master into a single message.
+  void batchedStatusUpdateAcknowledgements(
+      const process::UPID& from,
+      const BatchedStatusUpdateAcknowledgementsMessage& message);
+
   void _statusUpdateAcknowledgement(
       const process::Future<bool>& future,
       const TaskID& taskId,
@@ -581,6 +588,18 @@ public:
   // Returns the resource usage information for all executors.
   virtual process::Future<ResourceUsage> usage();
 
+  // Returns the resource statistics for the given container, giving
+  // up if the collection does not complete in time. Results are
+  // memoized for a short window so that multiple monitoring requests
+  // arriving close together (e.g., several scrapers polling the
+  // '/containers' endpoint) share a single collection.
+  process::Future<ResourceStatistics> containerUsage(
+      const ContainerID& containerId);
+
+  // Drops the memoized `usage()` snapshot. Called whenever the set of
+  // executors or tasks (and hence their allocations) changes.
+  void invalidateUsageCache();
+
   // Handle the second phase of shutting down an executor for those
   // executors that have not properly shutdown within a timeout.
   void shutdownExecutorTimeout(
@@ -728,6 +747,12 @@ private:
 
   const Http http;
 
+#ifndef __WINDOWS__
+  // Serves the executor API on a local domain socket when
+  // `--http_executor_domain_sockets` is set.
+  process::Owned<process::http::Server> executorSocketServer;
+#endif // __WINDOWS__
+
   SlaveInfo info;
 
   protobuf::slave::Capabilities capabilities;
@@ -820,6 +845,21 @@ private:
   // (allocated and oversubscribable) resources.
   Option<Resources> oversubscribedResources;
 
+  // Per-container resource statistics collections that are in flight
+  // or recently completed, along with the time at which the cache was
+  // last (re)populated. See `containerUsage()`.
+  hashmap<ContainerID, process::Future<ResourceStatistics>>
+    containerUsageCache;
+  process::Time containerUsageCacheTime;
+
+  // Memoized result of `usage()`, shared between concurrent pollers
+  // (e.g., the resource estimator and the QoS controller each poll on
+  // their own interval). The snapshot is served as long as the
+  // executor/task topology is unchanged (see `invalidateUsageCache()`)
+  // and the underlying statistics are still fresh.
+  Option<process::Future<ResourceUsage>> usageCache;
+  process::Time usageCacheTime;
+
   process::Owned<ResourceProviderManager> resourceProviderManager;
   process::Owned<LocalResourceProviderDaemon> localResourceProviderDaemon;
 
@@ -876,7 +916,9 @@ struct HttpConnection
     return writer.readerClosed();
   }
 
-  process::http::Pipe::Writer writer;
+  // Coalescing writer so that bursts of events result in a single
+  // chunked-encoding write on the response rather than one per event.
+  recordio::Writer writer;
   ContentType contentType;
   ::recordio::Encoder<v1::executor::Event> encoder;
 };
@@ -911,6 +953,10 @@ public:
   void checkpointTask(const TaskInfo& task);
   void checkpointTask(const Task& task);
 
+  // Checkpoints the given tasks as a group, bounding the number of
+  // filesystem syncs (if enabled) during task launch bursts.
+  void checkpointTasks(const std::vector<TaskInfo>& tasks);
+
   void recoverTask(const state::TaskState& state, bool recheckpointTask);
 
   Try<Nothing> updateTaskState(const TaskStatus& status);
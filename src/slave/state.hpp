@@ -242,6 +242,108 @@ Try<Nothing> checkpoint(const std::string& path, const T& t, bool sync = false)
 }
 
 
+// Checkpoints a group of data to disk with a bounded number of
+// `fsync` calls. Each datum gets the same atomic (all-or-nothing)
+// semantics as `checkpoint()` above: it is first written to a
+// temporary file which `commit()` later renames to the desired path.
+// The renames are performed in the order in which the data were
+// added, so a crash mid-commit leaves a prefix of the group on disk,
+// which is indistinguishable from a crash between sequential
+// `checkpoint()` calls and hence handled by `recover()`.
+//
+// If `sync` is set, each datum is still synced to the filesystem when
+// written, but each distinct parent directory is synced only once for
+// the whole group (on the last rename into it), rather than once per
+// datum as with sequential `checkpoint()` calls.
+class CheckpointGroup
+{
+public:
+  explicit CheckpointGroup(bool sync = false) : sync(sync) {}
+
+  // Writes the instance of T to a temporary file next to `path`. The
+  // data only appears at `path` once `commit()` is called.
+  template <typename T>
+  Try<Nothing> add(const std::string& path, const T& t)
+  {
+    // Create the base directory.
+    std::string base = Path(path).dirname();
+
+    Try<Nothing> mkdir = os::mkdir(base, true, sync);
+    if (mkdir.isError()) {
+      return Error(
+          "Failed to create directory '" + base + "': " + mkdir.error());
+    }
+
+    // NOTE: We create the temporary file at 'base/XXXXXX' to make sure
+    // the rename in `commit()` does not cross devices (MESOS-2319).
+    Try<std::string> temp = os::mktemp(path::join(base, "XXXXXX"));
+    if (temp.isError()) {
+      return Error("Failed to create temporary file: " + temp.error());
+    }
+
+    Try<Nothing> checkpoint = internal::checkpoint(temp.get(), t, sync);
+    if (checkpoint.isError()) {
+      // Try removing the temporary file on error.
+      os::rm(temp.get());
+
+      return Error("Failed to write temporary file '" + temp.get() +
+                   "': " + checkpoint.error());
+    }
+
+    entries.push_back({temp.get(), path});
+
+    return Nothing();
+  }
+
+  // Renames the temporary files to their desired paths, in the order
+  // in which the data were added.
+  Try<Nothing> commit()
+  {
+    // Determine the last entry renamed into each parent directory;
+    // when syncing, only that rename syncs the directory.
+    hashmap<std::string, size_t> last;
+    for (size_t i = 0; i < entries.size(); i++) {
+      last[Path(entries[i].path).dirname()] = i;
+    }
+
+    for (size_t i = 0; i < entries.size(); i++) {
+      const Entry& entry = entries[i];
+
+      Try<Nothing> rename = os::rename(
+          entry.temp,
+          entry.path,
+          sync && last[Path(entry.path).dirname()] == i);
+
+      if (rename.isError()) {
+        // Try removing the remaining temporary files on error.
+        for (size_t j = i; j < entries.size(); j++) {
+          os::rm(entries[j].temp);
+        }
+
+        entries.clear();
+
+        return Error("Failed to rename '" + entry.temp + "' to '" +
+                     entry.path + "': " + rename.error());
+      }
+    }
+
+    entries.clear();
+
+    return Nothing();
+  }
+
+private:
+  struct Entry
+  {
+    std::string temp;
+    std::string path;
+  };
+
+  const bool sync;
+  std::vector<Entry> entries;
+};
+
+
 // NOTE: The *State structs (e.g., TaskState, RunState, etc) are
 // defined in reverse dependency order because many of them have
 // Option<*State> dependencies which means we need them declared in
@@ -0,0 +1,251 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License
+
+#include <list>
+#include <set>
+#include <string>
+
+#include <mesos/state/cached.hpp>
+#include <mesos/state/storage.hpp>
+
+#include <process/defer.hpp>
+#include <process/dispatch.hpp>
+#include <process/future.hpp>
+#include <process/id.hpp>
+#include <process/owned.hpp>
+#include <process/process.hpp>
+
+#include <stout/foreach.hpp>
+#include <stout/hashmap.hpp>
+#include <stout/hashset.hpp>
+#include <stout/lambda.hpp>
+#include <stout/option.hpp>
+#include <stout/uuid.hpp>
+
+using namespace process;
+
+// Note that we don't add 'using std::set' here because we need
+// 'std::' to disambiguate the 'set' member.
+using std::list;
+using std::string;
+
+using mesos::internal::state::Entry;
+
+namespace mesos {
+namespace state {
+
+
+class CachedStorageProcess : public Process<CachedStorageProcess>
+{
+public:
+  explicit CachedStorageProcess(Storage* _storage)
+    : ProcessBase(process::ID::generate("cached-storage")),
+      storage(_storage) {}
+
+  Future<Option<Entry>> get(const string& name)
+  {
+    if (cache.contains(name)) {
+      return cache.get(name);
+    }
+
+    return storage->get(name)
+      .then(defer(self(), &Self::_get, name, lambda::_1));
+  }
+
+  Future<bool> set(const Entry& entry, const id::UUID& uuid)
+  {
+    Owned<Write> write(new Write(entry, uuid));
+
+    Future<bool> future = write->promise.future();
+
+    queued[entry.name()].push_back(write);
+
+    flush(entry.name());
+
+    return future;
+  }
+
+  Future<bool> expunge(const Entry& entry)
+  {
+    return storage->expunge(entry)
+      .then(defer(self(), &Self::_expunge, entry.name(), lambda::_1));
+  }
+
+  Future<std::set<string>> names()
+  {
+    return storage->names();
+  }
+
+private:
+  // A store that has been accepted but not yet written through to
+  // the underlying storage.
+  struct Write
+  {
+    Write(const Entry& _entry, const id::UUID& _uuid)
+      : entry(_entry), uuid(_uuid) {}
+
+    Entry entry;
+    id::UUID uuid;
+    Promise<bool> promise;
+  };
+
+  Future<Option<Entry>> _get(const string& name, const Option<Entry>& entry)
+  {
+    if (entry.isSome()) {
+      cache.put(name, entry.get());
+    }
+
+    return entry;
+  }
+
+  Future<bool> _expunge(const string& name, bool result)
+  {
+    if (result) {
+      cache.erase(name);
+    }
+
+    return result;
+  }
+
+  // Starts a backend write for the specified variable unless one is
+  // already in flight (in which case it gets flushed again once that
+  // write completes).
+  void flush(const string& name)
+  {
+    if (writing.contains(name) || !queued.contains(name)) {
+      return;
+    }
+
+    list<Owned<Write>>& writes = queued[name];
+
+    CHECK(!writes.empty());
+
+    // Coalesce the longest prefix of writes forming a test-and-set
+    // chain (i.e., each write expects the UUID of the entry written
+    // before it) into a single backend write of the final entry:
+    // intermediate versions would be overwritten immediately anyway.
+    list<Owned<Write>> batch;
+
+    batch.push_back(writes.front());
+    writes.pop_front();
+
+    while (!writes.empty() &&
+           writes.front()->uuid ==
+             id::UUID::fromBytes(batch.back()->entry.uuid()).get()) {
+      batch.push_back(writes.front());
+      writes.pop_front();
+    }
+
+    if (writes.empty()) {
+      queued.erase(name);
+    }
+
+    writing.insert(name);
+
+    // The final entry gets written expecting the version that the
+    // backend currently holds, i.e., the one the first write in the
+    // chain expected.
+    storage->set(batch.back()->entry, batch.front()->uuid)
+      .onAny(defer(self(), &Self::flushed, name, batch, lambda::_1));
+  }
+
+  void flushed(
+      const string& name,
+      const list<Owned<Write>>& batch,
+      const Future<bool>& future)
+  {
+    writing.erase(name);
+
+    if (!future.isReady()) {
+      foreach (const Owned<Write>& write, batch) {
+        write->promise.fail(
+            future.isFailed() ? future.failure() : "Write discarded");
+      }
+    } else if (future.get()) {
+      cache.put(name, batch.back()->entry);
+
+      foreach (const Owned<Write>& write, batch) {
+        write->promise.set(true);
+      }
+    } else {
+      // Lost a race with another writer: whatever we had cached for
+      // this variable is stale.
+      cache.erase(name);
+
+      foreach (const Owned<Write>& write, batch) {
+        write->promise.set(false);
+      }
+    }
+
+    // Write anything that got queued up in the meantime.
+    flush(name);
+  }
+
+  Storage* storage;
+
+  // Entries that have been fetched from or written to the underlying
+  // storage and can be served from memory.
+  hashmap<string, Entry> cache;
+
+  // Writes that have not yet been handed to the underlying storage,
+  // per variable.
+  hashmap<string, list<Owned<Write>>> queued;
+
+  // Variables with a backend write currently in flight.
+  hashset<string> writing;
+};
+
+
+CachedStorage::CachedStorage(Storage* storage)
+{
+  process = new CachedStorageProcess(storage);
+  spawn(process);
+}
+
+
+CachedStorage::~CachedStorage()
+{
+  terminate(process);
+  wait(process);
+  delete process;
+}
+
+
+Future<Option<Entry>> CachedStorage::get(const string& name)
+{
+  return dispatch(process, &CachedStorageProcess::get, name);
+}
+
+
+Future<bool> CachedStorage::set(const Entry& entry, const id::UUID& uuid)
+{
+  return dispatch(process, &CachedStorageProcess::set, entry, uuid);
+}
+
+
+Future<bool> CachedStorage::expunge(const Entry& entry)
+{
+  return dispatch(process, &CachedStorageProcess::expunge, entry);
+}
+
+
+Future<std::set<string>> CachedStorage::names()
+{
+  return dispatch(process, &CachedStorageProcess::names);
+}
+
+} // namespace state {
+} // namespace mesos {
@@ -21,11 +21,13 @@
 #include <list>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <mesos/log/log.hpp>
 
 #include <mesos/state/log.hpp>
 
+#include <process/collect.hpp>
 #include <process/defer.hpp>
 #include <process/dispatch.hpp>
 #include <process/future.hpp>
@@ -39,6 +41,7 @@
 #include <stout/bytes.hpp>
 #include <stout/duration.hpp>
 #include <stout/foreach.hpp>
+#include <stout/gzip.hpp>
 #include <stout/lambda.hpp>
 #include <stout/hashmap.hpp>
 #include <stout/nothing.hpp>
@@ -56,6 +59,7 @@ using namespace process;
 // 'std::' to disambiguate the 'set' member.
 using std::list;
 using std::string;
+using std::vector;
 
 using mesos::log::Log;
 
@@ -65,6 +69,16 @@ using mesos::internal::state::Operation;
 namespace mesos {
 namespace state {
 
+// Serialized operations at least this large are gzip compressed and
+// fragmented across multiple log entries (see Operation::Fragment)
+// so that the size of a state entry is not bounded by what the
+// replicas are willing to store or transmit as a single log entry.
+static const size_t FRAGMENT_MINIMUM_LENGTH = 1024 * 1024;
+
+// Maximum amount of (compressed) data stored in each fragment.
+static const size_t FRAGMENT_LENGTH = 1024 * 1024;
+
+
 // A storage implementation for State that uses the replicated
 // log. The log is made up of appended operations. Each state entry is
 // mapped to a log "snapshot".
@@ -107,6 +121,18 @@ private:
   // Helper for applying log entries.
   Future<Nothing> apply(const list<Log::Entry>& entries);
 
+  // Helper for applying a single operation that was stored at (or,
+  // for a fragmented operation, starting at) the specified position.
+  Try<Nothing> apply(const Operation& operation, const Log::Position& position);
+
+  // Helper for appending a serialized operation to the log,
+  // compressing and fragmenting it first if it is too large to be
+  // stored as a single log entry. Returns the position of the first
+  // entry appended, or none if the writer got demoted.
+  Future<Option<Log::Position>> append(const string& value);
+  Future<Option<Log::Position>> _append(
+      const vector<Option<Log::Position>>& positions);
+
   // Helper for performing truncation.
   void truncate();
   Future<Nothing> _truncate();
@@ -204,6 +230,26 @@ private:
   // a default/empty constructor.
   hashmap<string, Snapshot> snapshots;
 
+  // A fragmented operation that we're in the middle of reassembling:
+  // the position of the first fragment (which represents the
+  // operation once it has been applied), the total number of
+  // fragments, the index of the next fragment we expect, and the
+  // compressed data accumulated so far.
+  struct Fragments
+  {
+    Fragments(const Log::Position& position, uint64_t count)
+      : position(position),
+        count(count),
+        next(0) {}
+
+    Log::Position position;
+    uint64_t count;
+    uint64_t next;
+    string data;
+  };
+
+  Option<Fragments> fragments;
+
   struct Metrics
   {
     Metrics()
@@ -324,43 +370,58 @@ Future<Nothing> LogStorageProcess::apply(const list<Log::Entry>& entries)
         return Failure("Failed to deserialize Operation");
       }
 
-      switch (operation.type()) {
-        case Operation::SNAPSHOT: {
-          CHECK(operation.has_snapshot());
-
-          // Add or update (override) the snapshot.
-          Snapshot snapshot(entry.position, operation.snapshot().entry());
-          snapshots.put(snapshot.entry.name(), snapshot);
-          break;
+      if (operation.type() == Operation::FRAGMENT) {
+        CHECK(operation.has_fragment());
+
+        const Operation::Fragment& fragment = operation.fragment();
+
+        if (fragment.index() == 0) {
+          fragments = Fragments(entry.position, fragment.count());
+        } else if (fragments.isNone() ||
+                   fragments->next != fragment.index() ||
+                   fragments->count != fragment.count()) {
+          // A fragment that doesn't continue the sequence we're
+          // reassembling means the writer got demoted (or failed)
+          // part way through appending: the operation it was writing
+          // never became durable, so the fragments that did make it
+          // into the log are simply ignored.
+          fragments = None();
+          index = entry.position;
+          continue;
         }
 
-        case Operation::DIFF: {
-          CHECK(operation.has_diff());
+        fragments->data += fragment.data();
+        fragments->next++;
 
-          Option<Snapshot> snapshot =
-            snapshots.get(operation.diff().entry().name());
+        if (fragments->next == fragments->count) {
+          Try<string> decompressed = gzip::decompress(fragments->data);
 
-          CHECK_SOME(snapshot);
+          if (decompressed.isError()) {
+            return Failure(
+                "Failed to decompress fragmented operation: " +
+                decompressed.error());
+          }
 
-          Try<Snapshot> patched = snapshot->patch(operation.diff());
+          operation.Clear();
 
-          if (patched.isError()) {
-            return Failure("Failed to apply the diff: " + patched.error());
+          if (!operation.ParseFromString(decompressed.get())) {
+            return Failure("Failed to deserialize fragmented Operation");
           }
 
-          // Replace the snapshot with the patched snapshot.
-          snapshots.put(patched->entry.name(), patched.get());
-          break;
-        }
+          Try<Nothing> applied = apply(operation, fragments->position);
 
-        case Operation::EXPUNGE: {
-          CHECK(operation.has_expunge());
-          snapshots.erase(operation.expunge().name());
-          break;
+          if (applied.isError()) {
+            return Failure(applied.error());
+          }
+
+          fragments = None();
         }
+      } else {
+        Try<Nothing> applied = apply(operation, entry.position);
 
-        default:
-          return Failure("Unknown operation: " + stringify(operation.type()));
+        if (applied.isError()) {
+          return Failure(applied.error());
+        }
       }
 
       index = entry.position;
@@ -371,6 +432,114 @@ Future<Nothing> LogStorageProcess::apply(const list<Log::Entry>& entries)
 }
 
 
+Try<Nothing> LogStorageProcess::apply(
+    const Operation& operation,
+    const Log::Position& position)
+{
+  switch (operation.type()) {
+    case Operation::SNAPSHOT: {
+      CHECK(operation.has_snapshot());
+
+      // Add or update (override) the snapshot.
+      Snapshot snapshot(position, operation.snapshot().entry());
+      snapshots.put(snapshot.entry.name(), snapshot);
+      break;
+    }
+
+    case Operation::DIFF: {
+      CHECK(operation.has_diff());
+
+      Option<Snapshot> snapshot =
+        snapshots.get(operation.diff().entry().name());
+
+      CHECK_SOME(snapshot);
+
+      Try<Snapshot> patched = snapshot->patch(operation.diff());
+
+      if (patched.isError()) {
+        return Error("Failed to apply the diff: " + patched.error());
+      }
+
+      // Replace the snapshot with the patched snapshot.
+      snapshots.put(patched->entry.name(), patched.get());
+      break;
+    }
+
+    case Operation::EXPUNGE: {
+      CHECK(operation.has_expunge());
+      snapshots.erase(operation.expunge().name());
+      break;
+    }
+
+    default:
+      return Error("Unknown operation: " + stringify(operation.type()));
+  }
+
+  return Nothing();
+}
+
+
+Future<Option<Log::Position>> LogStorageProcess::append(const string& value)
+{
+  if (value.size() < FRAGMENT_MINIMUM_LENGTH) {
+    return writer.append(value);
+  }
+
+  Try<string> compressed = gzip::compress(value);
+
+  if (compressed.isError()) {
+    return Failure("Failed to compress operation: " + compressed.error());
+  }
+
+  size_t count = (compressed->size() + FRAGMENT_LENGTH - 1) / FRAGMENT_LENGTH;
+
+  VLOG(1) << "Writing an operation of size " << Bytes(value.size())
+          << " as " << count << " fragment(s) ("
+          << Bytes(compressed->size()) << " compressed)";
+
+  // Note that we append all the fragments without waiting in between
+  // so they occupy consecutive positions in the log (appends are
+  // serialized through the writer) and the round trips to the
+  // replicas get pipelined.
+  vector<Future<Option<Log::Position>>> appends;
+
+  for (size_t i = 0; i < count; i++) {
+    Operation operation;
+    operation.set_type(Operation::FRAGMENT);
+    operation.mutable_fragment()->set_index(i);
+    operation.mutable_fragment()->set_count(count);
+    operation.mutable_fragment()->set_data(
+        compressed->substr(i * FRAGMENT_LENGTH, FRAGMENT_LENGTH));
+
+    string fragment;
+    if (!operation.SerializeToString(&fragment)) {
+      return Failure("Failed to serialize FRAGMENT Operation");
+    }
+
+    appends.push_back(writer.append(fragment));
+  }
+
+  return collect(appends)
+    .then(defer(self(), &Self::_append, lambda::_1));
+}
+
+
+Future<Option<Log::Position>> LogStorageProcess::_append(
+    const vector<Option<Log::Position>>& positions)
+{
+  // The operation is only durable if every fragment got appended.
+  foreach (const Option<Log::Position>& position, positions) {
+    if (position.isNone()) {
+      return None();
+    }
+  }
+
+  // The position of the first fragment represents the operation:
+  // truncating beyond it would throw away part of the payload.
+  return positions.front();
+}
+
+
 // TODO(benh): Truncation could be optimized by saving the "oldest"
 // snapshot and only doing a truncation if/when we update that
 // snapshot.
@@ -522,7 +691,7 @@ Future<bool> LogStorageProcess::__set(
         return Failure("Failed to serialize DIFF Operation");
       }
 
-      return writer.append(value)
+      return append(value)
         .then(defer(self(),
                     &Self::___set,
                     entry,
@@ -541,7 +710,7 @@ Future<bool> LogStorageProcess::__set(
     return Failure("Failed to serialize SNAPSHOT Operation");
   }
 
-  return writer.append(value)
+  return append(value)
     .then(defer(self(), &Self::___set, entry, 0, lambda::_1));
 }
 
@@ -618,7 +787,7 @@ Future<bool> LogStorageProcess::__expunge(const Entry& entry)
     return Failure("Failed to serialize Operation");
   }
 
-  return writer.append(value)
+  return append(value)
     .then(defer(self(), &Self::___expunge, entry, lambda::_1));
 }
 
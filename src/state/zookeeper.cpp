@@ -21,6 +21,7 @@
 #include <queue>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <mesos/zookeeper/authentication.hpp>
@@ -51,6 +52,7 @@ using namespace process;
 
 // Note that we don't add 'using std::set' here because we need
 // 'std::' to disambiguate the 'set' member.
+using std::pair;
 using std::queue;
 using std::string;
 using std::vector;
@@ -78,6 +80,7 @@ public:
   // Storage implementation.
   Future<Option<Entry>> get(const string& name);
   Future<bool> set(const Entry& entry, const id::UUID& uuid);
+  Future<bool> multiset(const vector<pair<Entry, id::UUID>>& entries);
   virtual Future<bool> expunge(const Entry& entry);
   Future<std::set<string>> names();
 
@@ -95,6 +98,7 @@ private:
   Result<std::set<string>> doNames();
   Result<Option<Entry>> doGet(const string& name);
   Result<bool> doSet(const Entry& entry, const id::UUID& uuid);
+  Result<bool> doMultiset(const vector<pair<Entry, id::UUID>>& entries);
   Result<bool> doExpunge(const Entry& entry);
 
   const string servers;
@@ -142,6 +146,15 @@ private:
     Promise<bool> promise;
   };
 
+  struct Multiset
+  {
+    explicit Multiset(const vector<pair<Entry, id::UUID>>& _entries)
+      : entries(_entries) {}
+
+    vector<pair<Entry, id::UUID>> entries;
+    Promise<bool> promise;
+  };
+
   struct Expunge
   {
     explicit Expunge(const Entry& _entry) : entry(_entry) {}
@@ -156,6 +169,7 @@ private:
     queue<Names*> names;
     queue<Get*> gets;
     queue<Set*> sets;
+    queue<Multiset*> multisets;
     queue<Expunge*> expunges;
   } pending;
 
@@ -200,6 +214,7 @@ ZooKeeperStorageProcess::~ZooKeeperStorageProcess()
   fail(&pending.names, "No longer managing storage");
   fail(&pending.gets, "No longer managing storage");
   fail(&pending.sets, "No longer managing storage");
+  fail(&pending.multisets, "No longer managing storage");
 
   delete zk;
   delete watcher;
@@ -289,6 +304,31 @@ Future<bool> ZooKeeperStorageProcess::set(
 }
 
 
+Future<bool> ZooKeeperStorageProcess::multiset(
+    const vector<pair<Entry, id::UUID>>& entries)
+{
+  if (error.isSome()) {
+    return Failure(error.get());
+  } else if (state != CONNECTED) {
+    Multiset* multiset = new Multiset(entries);
+    pending.multisets.push(multiset);
+    return multiset->promise.future();
+  }
+
+  Result<bool> result = doMultiset(entries);
+
+  if (result.isNone()) { // Try again later.
+    Multiset* multiset = new Multiset(entries);
+    pending.multisets.push(multiset);
+    return multiset->promise.future();
+  } else if (result.isError()) {
+    return Failure(result.error());
+  }
+
+  return result.get();
+}
+
+
 Future<bool> ZooKeeperStorageProcess::expunge(const Entry& entry)
 {
   if (error.isSome()) {
@@ -377,6 +417,20 @@ void ZooKeeperStorageProcess::connected(int64_t sessionId, bool reconnect)
     pending.sets.pop();
     delete set;
   }
+
+  while (!pending.multisets.empty()) {
+    Multiset* multiset = pending.multisets.front();
+    Result<bool> result = doMultiset(multiset->entries);
+    if (result.isNone()) {
+      return; // Try again later.
+    } else if (result.isError()) {
+      multiset->promise.fail(result.error());
+    } else {
+      multiset->promise.set(result.get());
+    }
+    pending.multisets.pop();
+    delete multiset;
+  }
 }
 
 
@@ -578,6 +632,101 @@ Result<bool> ZooKeeperStorageProcess::doSet(const Entry& entry,
 }
 
 
+Result<bool> ZooKeeperStorageProcess::doMultiset(
+    const vector<pair<Entry, id::UUID>>& entries)
+{
+  CHECK_NONE(error) << ": " << error.get();
+  CHECK(state == CONNECTED);
+
+  // Read every entry first to check the expected UUIDs and learn the
+  // znode versions that make the batched write atomic. Entries that
+  // don't exist yet can't be updated through the multi-op (which can
+  // only condition on a version), so they get created through the
+  // regular one entry path before the rest are updated together.
+  vector<ZooKeeper::Update> updates;
+  updates.reserve(entries.size());
+
+  for (size_t i = 0; i < entries.size(); i++) {
+    const Entry& entry = entries[i].first;
+    const id::UUID& uuid = entries[i].second;
+
+    // Serialize to make sure we're under the 1 MB limit.
+    string data;
+
+    if (!entry.SerializeToString(&data)) {
+      return Error("Failed to serialize Entry");
+    }
+
+    if (data.size() > 1024 * 1024) { // 1 MB
+      // TODO(benh): Use stout/gzip.hpp for compression.
+      return Error("Serialized data is too big (> 1 MB)");
+    }
+
+    string result;
+    Stat stat;
+
+    int code = zk->get(znode + "/" + entry.name(), false, &result, &stat);
+
+    if (code == ZNONODE) {
+      Result<bool> created = doSet(entry, uuid);
+
+      if (!(created.isSome() && created.get())) {
+        return created;
+      }
+
+      continue;
+    } else if (code == ZINVALIDSTATE || (code != ZOK && zk->retryable(code))) {
+      CHECK(zk->getState() != ZOO_AUTH_FAILED_STATE);
+      return None(); // Try again later.
+    } else if (code != ZOK) {
+      return Error(
+          "Failed to get '" + znode + "/" + entry.name() +
+          "' in ZooKeeper: " + zk->message(code));
+    }
+
+    google::protobuf::io::ArrayInputStream stream(result.data(), result.size());
+
+    Entry current;
+
+    if (!current.ParseFromZeroCopyStream(&stream)) {
+      return Error("Failed to deserialize Entry");
+    }
+
+    if (id::UUID::fromBytes(current.uuid()).get() != uuid) {
+      return false;
+    }
+
+    ZooKeeper::Update update;
+    update.path = znode + "/" + entry.name();
+    update.data = data;
+    update.version = stat.version;
+
+    updates.push_back(update);
+  }
+
+  if (updates.empty()) {
+    return true;
+  }
+
+  // Okay, apply the updates in a single round trip, we get atomicity
+  // across the batch by requiring each znode's version.
+  int code = zk->set(updates);
+
+  if (code == ZBADVERSION) {
+    return false;
+  } else if (code == ZINVALIDSTATE || (code != ZOK && zk->retryable(code))) {
+    CHECK(zk->getState() != ZOO_AUTH_FAILED_STATE);
+    return None(); // Try again later.
+  } else if (code != ZOK) {
+    return Error(
+        "Failed to apply batched set under '" + znode +
+        "' in ZooKeeper: " + zk->message(code));
+  }
+
+  return true;
+}
+
+
 Result<bool> ZooKeeperStorageProcess::doExpunge(const Entry& entry)
 {
   CHECK_NONE(error) << ": " << error.get();
@@ -661,6 +810,12 @@ Future<bool> ZooKeeperStorage::set(const Entry& entry, const id::UUID& uuid)
 }
 
 
+Future<bool> ZooKeeperStorage::set(const vector<pair<Entry, id::UUID>>& entries)
+{
+  return dispatch(process, &ZooKeeperStorageProcess::multiset, entries);
+}
+
+
 Future<bool> ZooKeeperStorage::expunge(const Entry& entry)
 {
   return dispatch(process, &ZooKeeperStorageProcess::expunge, entry);
@@ -632,9 +632,14 @@ private:
         }
 
         // Open the updates file.
+        // NOTE: We don't use `O_SYNC` here because we only read this
+        // file if the host did not crash. `os::write` success implies
+        // the kernel will have flushed our data to the page cache.
+        // This is sufficient for the recovery scenarios we use this
+        // data for.
         Try<int_fd> result = os::open(
             path.get(),
-            O_CREAT | O_SYNC | O_WRONLY | O_CLOEXEC,
+            O_CREAT | O_WRONLY | O_CLOEXEC,
             S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
 
         if (result.isError()) {
@@ -667,12 +672,14 @@ private:
       }
 
       // Open the status updates file for reading and writing.
+      // NOTE: See the NOTE in `create()` above for why `O_SYNC` is
+      // not used.
       Try<int_fd> fd = os::open(
           path,
 #ifdef __WINDOWS__
           O_BINARY |
 #endif // __WINDOWS__
-          O_SYNC | O_RDWR | O_CLOEXEC);
+          O_RDWR | O_CLOEXEC);
 
       if (fd.isError()) {
         return Error("Failed to open '" + path + "': " + fd.error());
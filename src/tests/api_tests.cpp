@@ -105,6 +105,7 @@ using testing::AtMost;
 using testing::DoAll;
 using testing::Eq;
 using testing::Return;
+using testing::SaveArg;
 using testing::Sequence;
 using testing::WithParamInterface;
 
@@ -788,6 +789,387 @@ TEST_P(MasterAPITest, GetTasks)
 }
 
 
+// This test verifies the filters and the limit/offset window of the
+// `GET_TASKS` call.
+TEST_P(MasterAPITest, GetTasksFiltering)
+{
+  Try<Owned<cluster::Master>> master = StartMaster();
+  ASSERT_SOME(master);
+
+  MockExecutor exec(DEFAULT_EXECUTOR_ID);
+  TestContainerizer containerizer(&exec);
+
+  Owned<MasterDetector> detector = master.get()->createDetector();
+  Try<Owned<cluster::Slave>> slave = StartSlave(detector.get(), &containerizer);
+  ASSERT_SOME(slave);
+
+  MockScheduler sched;
+  MesosSchedulerDriver driver(
+      &sched, DEFAULT_FRAMEWORK_INFO, master.get()->pid, DEFAULT_CREDENTIAL);
+
+  FrameworkID frameworkId;
+  EXPECT_CALL(sched, registered(&driver, _, _))
+    .WillOnce(SaveArg<1>(&frameworkId));
+
+  Future<vector<Offer>> offers;
+  EXPECT_CALL(sched, resourceOffers(&driver, _))
+    .WillOnce(FutureArg<1>(&offers))
+    .WillRepeatedly(Return()); // Ignore subsequent offers.
+
+  driver.start();
+
+  AWAIT_READY(offers);
+  ASSERT_FALSE(offers->empty());
+
+  // Launch three tasks so that the paging window has boundaries to
+  // exercise.
+  vector<TaskInfo> tasks;
+  for (int i = 0; i < 3; i++) {
+    TaskInfo task;
+    task.set_name("test");
+    task.mutable_task_id()->set_value(stringify(i));
+    task.mutable_slave_id()->MergeFrom(offers.get()[0].slave_id());
+    task.mutable_resources()->MergeFrom(
+        Resources::parse("cpus:0.1;mem:32").get());
+    task.mutable_executor()->MergeFrom(DEFAULT_EXECUTOR_INFO);
+
+    tasks.push_back(task);
+  }
+
+  EXPECT_CALL(exec, registered(_, _, _, _));
+
+  EXPECT_CALL(exec, launchTask(_, _))
+    .WillRepeatedly(SendStatusUpdateFromTask(TASK_RUNNING));
+
+  Future<TaskStatus> status1;
+  Future<TaskStatus> status2;
+  Future<TaskStatus> status3;
+  EXPECT_CALL(sched, statusUpdate(&driver, _))
+    .WillOnce(FutureArg<1>(&status1))
+    .WillOnce(FutureArg<1>(&status2))
+    .WillOnce(FutureArg<1>(&status3));
+
+  driver.launchTasks(offers.get()[0].id(), tasks);
+
+  AWAIT_READY(status1);
+  AWAIT_READY(status2);
+  AWAIT_READY(status3);
+
+  ContentType contentType = GetParam();
+
+  // Posts a `GET_TASKS` call with the given options and returns the
+  // tasks of the response.
+  auto getTasks = [this, &master, &contentType](
+      const v1::master::Call::GetTasks& options)
+    -> google::protobuf::RepeatedPtrField<mesos::v1::Task> {
+    v1::master::Call v1Call;
+    v1Call.set_type(v1::master::Call::GET_TASKS);
+    v1Call.mutable_get_tasks()->CopyFrom(options);
+
+    Future<v1::master::Response> v1Response =
+      post(master.get()->pid, v1Call, contentType);
+
+    AWAIT_EXPECT_READY(v1Response);
+    if (!v1Response.isReady()) {
+      return google::protobuf::RepeatedPtrField<mesos::v1::Task>();
+    }
+
+    EXPECT_EQ(v1::master::Response::GET_TASKS, v1Response->type());
+
+    return v1Response->get_tasks().tasks();
+  };
+
+  // Without any options all tasks are returned.
+  EXPECT_EQ(3, getTasks(v1::master::Call::GetTasks()).size());
+
+  // Filter by framework ID.
+  {
+    v1::master::Call::GetTasks options;
+    options.mutable_framework_id()->set_value(frameworkId.value());
+    EXPECT_EQ(3, getTasks(options).size());
+
+    options.mutable_framework_id()->set_value("unknown");
+    EXPECT_TRUE(getTasks(options).empty());
+  }
+
+  // Filter by state.
+  {
+    v1::master::Call::GetTasks options;
+    options.set_state(v1::TaskState::TASK_RUNNING);
+    EXPECT_EQ(3, getTasks(options).size());
+
+    options.set_state(v1::TaskState::TASK_FINISHED);
+    EXPECT_TRUE(getTasks(options).empty());
+  }
+
+  // Filter by agent ID.
+  {
+    v1::master::Call::GetTasks options;
+    options.mutable_agent_id()->set_value(
+        offers.get()[0].slave_id().value());
+    EXPECT_EQ(3, getTasks(options).size());
+
+    options.mutable_agent_id()->set_value("unknown");
+    EXPECT_TRUE(getTasks(options).empty());
+  }
+
+  // Limit and offset boundaries.
+  {
+    v1::master::Call::GetTasks options;
+    options.set_limit(2);
+    EXPECT_EQ(2, getTasks(options).size());
+
+    options.set_limit(0);
+    EXPECT_TRUE(getTasks(options).empty());
+
+    options.clear_limit();
+    options.set_offset(1);
+    EXPECT_EQ(2, getTasks(options).size());
+
+    options.set_offset(3);
+    EXPECT_TRUE(getTasks(options).empty());
+
+    options.set_offset(5);
+    EXPECT_TRUE(getTasks(options).empty());
+  }
+
+  // Paging through the tasks one at a time covers all of them without
+  // overlap. The master's task index is not mutated between the calls,
+  // so the iteration order is stable.
+  {
+    set<string> taskIds;
+    for (uint64_t offset = 0; offset < 3; offset++) {
+      v1::master::Call::GetTasks options;
+      options.set_offset(offset);
+      options.set_limit(1);
+
+      google::protobuf::RepeatedPtrField<mesos::v1::Task> page = getTasks(options);
+      ASSERT_EQ(1, page.size());
+      taskIds.insert(page.Get(0).task_id().value());
+    }
+
+    EXPECT_EQ(set<string>({"0", "1", "2"}), taskIds);
+  }
+
+  EXPECT_CALL(exec, shutdown(_))
+    .Times(AtMost(1));
+
+  driver.stop();
+  driver.join();
+}
+
+
+// This test verifies that tasks the principal is not authorized to
+// view are not returned by `GET_TASKS` and do not consume the
+// limit/offset window.
+TEST_P(MasterAPITest, GetTasksAuthorizationFiltering)
+{
+  ACLs acls;
+
+  // Only authorize the default credential to view tasks of the user
+  // 'root'.
+  {
+    mesos::ACL::ViewTask* acl = acls.add_view_tasks();
+    acl->mutable_principals()->add_values(DEFAULT_CREDENTIAL.principal());
+    acl->mutable_users()->add_values("root");
+  }
+
+  {
+    mesos::ACL::ViewTask* acl = acls.add_view_tasks();
+    acl->mutable_principals()->add_values(DEFAULT_CREDENTIAL.principal());
+    acl->mutable_users()->set_type(mesos::ACL::Entity::NONE);
+  }
+
+  Result<Authorizer*> authorizer = Authorizer::create(acls);
+  ASSERT_SOME(authorizer);
+
+  Try<Owned<cluster::Master>> master = StartMaster(authorizer.get());
+  ASSERT_SOME(master);
+
+  ExecutorID executorId1;
+  executorId1.set_value("executor_1");
+
+  ExecutorID executorId2;
+  executorId2.set_value("executor_2");
+
+  MockExecutor executor1(executorId1);
+  MockExecutor executor2(executorId2);
+
+  hashmap<ExecutorID, Executor*> executors;
+  executors[executorId1] = &executor1;
+  executors[executorId2] = &executor2;
+
+  TestContainerizer containerizer(executors);
+
+  // We don't need to actually launch tasks as the specified users,
+  // since we are only interested in testing the authorization path.
+  slave::Flags slaveFlags = CreateSlaveFlags();
+
+#ifndef __WINDOWS__
+  slaveFlags.switch_user = false;
+#endif
+
+  Owned<MasterDetector> detector = master.get()->createDetector();
+  Try<Owned<cluster::Slave>> slave =
+    StartSlave(detector.get(), &containerizer, slaveFlags);
+  ASSERT_SOME(slave);
+
+  // Launches two tasks with the given executor and waits until both
+  // are running.
+  auto launchTasks = [](
+      MockScheduler* sched,
+      MesosSchedulerDriver* driver,
+      const ExecutorID& executorId,
+      MockExecutor* executor,
+      const string& prefix,
+      FrameworkID* frameworkId) {
+    EXPECT_CALL(*sched, registered(driver, _, _))
+      .WillOnce(SaveArg<1>(frameworkId));
+
+    Future<vector<Offer>> offers;
+    EXPECT_CALL(*sched, resourceOffers(driver, _))
+      .WillOnce(FutureArg<1>(&offers))
+      .WillRepeatedly(Return()); // Ignore subsequent offers.
+
+    driver->start();
+
+    AWAIT_READY(offers);
+    ASSERT_FALSE(offers->empty());
+
+    ExecutorInfo executorInfo;
+    executorInfo.set_name(executorId.value());
+    executorInfo.mutable_executor_id()->CopyFrom(executorId);
+    executorInfo.mutable_command()->set_value("exit 1");
+
+    vector<TaskInfo> tasks;
+    for (int i = 0; i < 2; i++) {
+      TaskInfo task;
+      task.set_name("test");
+      task.mutable_task_id()->set_value(prefix + stringify(i));
+      task.mutable_slave_id()->MergeFrom(offers.get()[0].slave_id());
+      task.mutable_resources()->MergeFrom(
+          Resources::parse("cpus:0.1;mem:32").get());
+      task.mutable_executor()->MergeFrom(executorInfo);
+
+      tasks.push_back(task);
+    }
+
+    EXPECT_CALL(*executor, registered(_, _, _, _));
+
+    EXPECT_CALL(*executor, launchTask(_, _))
+      .WillRepeatedly(SendStatusUpdateFromTask(TASK_RUNNING));
+
+    Future<TaskStatus> status1;
+    Future<TaskStatus> status2;
+    EXPECT_CALL(*sched, statusUpdate(driver, _))
+      .WillOnce(FutureArg<1>(&status1))
+      .WillOnce(FutureArg<1>(&status2));
+
+    driver->launchTasks(offers.get()[0].id(), tasks);
+
+    AWAIT_READY(status1);
+    AWAIT_READY(status2);
+  };
+
+  // The first framework runs as 'root': its tasks are visible to the
+  // default credential.
+  FrameworkInfo frameworkInfo1 = DEFAULT_FRAMEWORK_INFO;
+  frameworkInfo1.set_user("root");
+
+  MockScheduler sched1;
+  MesosSchedulerDriver driver1(
+      &sched1, frameworkInfo1, master.get()->pid, DEFAULT_CREDENTIAL);
+
+  FrameworkID frameworkId1;
+  launchTasks(
+      &sched1, &driver1, executorId1, &executor1, "visible_", &frameworkId1);
+
+  // The second framework runs as a different user: its tasks are not
+  // visible to the default credential.
+  FrameworkInfo frameworkInfo2 = DEFAULT_FRAMEWORK_INFO;
+  frameworkInfo2.set_user("invisible-user");
+
+  MockScheduler sched2;
+  MesosSchedulerDriver driver2(
+      &sched2, frameworkInfo2, master.get()->pid, DEFAULT_CREDENTIAL);
+
+  FrameworkID frameworkId2;
+  launchTasks(
+      &sched2,
+      &driver2,
+      executorId2,
+      &executor2,
+      "invisible_",
+      &frameworkId2);
+
+  EXPECT_NE(frameworkId1, frameworkId2);
+
+  ContentType contentType = GetParam();
+
+  // Posts a `GET_TASKS` call with the given options and returns the
+  // tasks of the response.
+  auto getTasks = [this, &master, &contentType](
+      const v1::master::Call::GetTasks& options)
+    -> google::protobuf::RepeatedPtrField<mesos::v1::Task> {
+    v1::master::Call v1Call;
+    v1Call.set_type(v1::master::Call::GET_TASKS);
+    v1Call.mutable_get_tasks()->CopyFrom(options);
+
+    Future<v1::master::Response> v1Response =
+      post(master.get()->pid, v1Call, contentType);
+
+    AWAIT_EXPECT_READY(v1Response);
+    if (!v1Response.isReady()) {
+      return google::protobuf::RepeatedPtrField<mesos::v1::Task>();
+    }
+
+    EXPECT_EQ(v1::master::Response::GET_TASKS, v1Response->type());
+
+    return v1Response->get_tasks().tasks();
+  };
+
+  // Only the first framework's tasks are returned.
+  {
+    google::protobuf::RepeatedPtrField<mesos::v1::Task> tasks =
+      getTasks(v1::master::Call::GetTasks());
+
+    ASSERT_EQ(2, tasks.size());
+    foreach (const mesos::v1::Task& task, tasks) {
+      EXPECT_EQ(frameworkId1.value(), task.framework_id().value());
+    }
+  }
+
+  // Unauthorized tasks do not consume the limit/offset window: paging
+  // through with a window of one returns both authorized tasks.
+  {
+    set<string> taskIds;
+    for (uint64_t offset = 0; offset < 2; offset++) {
+      v1::master::Call::GetTasks options;
+      options.set_offset(offset);
+      options.set_limit(1);
+
+      google::protobuf::RepeatedPtrField<mesos::v1::Task> page = getTasks(options);
+      ASSERT_EQ(1, page.size());
+      taskIds.insert(page.Get(0).task_id().value());
+    }
+
+    EXPECT_EQ(set<string>({"visible_0", "visible_1"}), taskIds);
+  }
+
+  EXPECT_CALL(executor1, shutdown(_))
+    .Times(AtMost(1));
+
+  EXPECT_CALL(executor2, shutdown(_))
+    .Times(AtMost(1));
+
+  driver1.stop();
+  driver1.join();
+
+  driver2.stop();
+  driver2.join();
+}
+
+
 TEST_P(MasterAPITest, GetLoggingLevel)
 {
   Try<Owned<cluster::Master>> master = this->StartMaster();
@@ -57,7 +57,7 @@ public:
 
   MOCK_METHOD9(
       fork,
-      Try<pid_t>(
+      process::Future<pid_t>(
           const ContainerID& containerId,
           const std::string& path,
           const std::vector<std::string>& argv,
@@ -752,11 +752,16 @@ TEST_F(MesosContainerizerDestroyTest, DestroyWhileFetching)
 
   TaskInfo taskInfo = createTask(slaveId, Resources(), CommandInfo());
 
+  // The executor's command must specify at least one URI, otherwise
+  // the containerizer skips the fetch stage entirely.
+  ExecutorInfo executorInfo = createExecutorInfo("executor", "exit 0");
+  executorInfo.mutable_command()->add_uris()->set_value("hdfs://dummy/uri");
+
   containerizer->launch(
       containerId,
       createContainerConfig(
           taskInfo,
-          createExecutorInfo("executor", "exit 0"),
+          executorInfo,
           sandbox.get()),
       map<string, string>(),
       None());
@@ -1326,7 +1331,7 @@ TEST_F(MesosLauncherStatusTest, ExecutorPIDTest)
   ContainerID invalidContainerId;
   invalidContainerId.set_value(id::UUID::random().toString());
 
-  Try<pid_t> forked = launcher.get()->fork(
+  Future<pid_t> forked = launcher.get()->fork(
       containerId,
       path::join(flags.launcher_dir, MESOS_CONTAINERIZER),
       vector<string>(),
@@ -1337,7 +1342,7 @@ TEST_F(MesosLauncherStatusTest, ExecutorPIDTest)
       None(),
       vector<int_fd>());
 
-  ASSERT_SOME(forked);
+  AWAIT_READY(forked);
 
   Future<ContainerStatus> validStatus = launcher.get()->status(containerId);
 
@@ -348,7 +348,7 @@ protected:
     argv[0] = MESOS_CONTAINERIZER;
     argv[1] = MesosContainerizerLaunch::NAME;
 
-    Try<pid_t> pid = launcher->fork(
+    Future<pid_t> pid = launcher->fork(
         containerId,
         path::join(flags.launcher_dir, MESOS_CONTAINERIZER),
         argv,
@@ -359,7 +359,13 @@ protected:
         CLONE_NEWNET | CLONE_NEWNS,
         {pipes[0], pipes[1]});
 
-    return pid;
+    pid.await();
+
+    if (!pid.isReady()) {
+      return Error(pid.isFailed() ? pid.failure() : "Fork discarded");
+    }
+
+    return pid.get();
   }
 
   Result<ResourceStatistics> statisticsHelper(
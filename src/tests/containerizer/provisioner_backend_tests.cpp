@@ -45,6 +45,7 @@ using mesos::internal::slave::AUFS_BACKEND;
 using mesos::internal::slave::BIND_BACKEND;
 using mesos::internal::slave::COPY_BACKEND;
 using mesos::internal::slave::OVERLAY_BACKEND;
+using mesos::internal::slave::REFLINK_BACKEND;
 
 using std::string;
 using std::vector;
@@ -344,6 +345,58 @@ TEST_F(CopyBackendTest, ROOT_CopyBackend)
   EXPECT_FALSE(os::exists(rootfs));
 }
 
+
+#ifdef __linux__
+class ReflinkBackendTest : public TemporaryDirectoryTest {};
+
+
+// Provision a rootfs using multiple layers with the reflink backend.
+// The layers are cloned where the underlying filesystem supports
+// reflinks and copied otherwise, so the expectations hold either way.
+TEST_F(ReflinkBackendTest, ROOT_ReflinkBackend)
+{
+  string layer1 = path::join(sandbox.get(), "source1");
+  ASSERT_SOME(os::mkdir(layer1));
+  ASSERT_SOME(os::mkdir(path::join(layer1, "dir1")));
+  ASSERT_SOME(os::write(path::join(layer1, "dir1", "1"), "1"));
+  ASSERT_SOME(os::write(path::join(layer1, "file"), "test1"));
+
+  string layer2 = path::join(sandbox.get(), "source2");
+  ASSERT_SOME(os::mkdir(layer2));
+  ASSERT_SOME(os::mkdir(path::join(layer2, "dir2")));
+  ASSERT_SOME(os::write(path::join(layer2, "dir2", "2"), "2"));
+  ASSERT_SOME(os::write(path::join(layer2, "file"), "test2"));
+
+  string rootfs = path::join(sandbox.get(), "rootfs");
+
+  hashmap<string, Owned<Backend>> backends = Backend::create(slave::Flags());
+  ASSERT_TRUE(backends.contains(REFLINK_BACKEND));
+
+  AWAIT_READY(backends[REFLINK_BACKEND]->provision(
+      {layer1, layer2},
+      rootfs,
+      sandbox.get()));
+
+  EXPECT_TRUE(os::exists(path::join(rootfs, "dir1", "1")));
+  EXPECT_SOME_EQ("1", os::read(path::join(rootfs, "dir1", "1")));
+
+  EXPECT_TRUE(os::exists(path::join(rootfs, "dir2", "2")));
+  EXPECT_SOME_EQ("2", os::read(path::join(rootfs, "dir2", "2")));
+
+  // Last layer should overwrite existing file.
+  EXPECT_TRUE(os::exists(path::join(rootfs, "file")));
+  EXPECT_SOME_EQ("test2", os::read(path::join(rootfs, "file")));
+
+  // Writes into the rootfs must not be visible in the layers.
+  ASSERT_SOME(os::write(path::join(rootfs, "file"), "modified"));
+  EXPECT_SOME_EQ("test2", os::read(path::join(layer2, "file")));
+
+  AWAIT_READY(backends[REFLINK_BACKEND]->destroy(rootfs, sandbox.get()));
+
+  EXPECT_FALSE(os::exists(rootfs));
+}
+#endif // __linux__
+
 } // namespace tests {
 } // namespace internal {
 } // namespace mesos {
@@ -60,6 +60,7 @@ using process::Owned;
 using process::PID;
 using process::Promise;
 
+using process::http::Accepted;
 using process::http::BadRequest;
 using process::http::MethodNotAllowed;
 using process::http::NotAcceptable;
@@ -786,6 +787,129 @@ TEST_P(ExecutorHttpApiTest, StatusUpdateCallFailedValidation)
 }
 
 
+// This test verifies that an UPDATE_BATCH call is accepted and fanned
+// out to the agent's status update path, one dispatch per batched
+// update.
+TEST_P(ExecutorHttpApiTest, UpdateBatchCall)
+{
+  Try<Owned<cluster::Master>> master = StartMaster();
+  ASSERT_SOME(master);
+
+  Future<Nothing> __recover = FUTURE_DISPATCH(_, &Slave::__recover);
+
+  Owned<MasterDetector> detector = master.get()->createDetector();
+
+  slave::Flags flags = CreateSlaveFlags();
+
+  Try<Owned<cluster::Slave>> slave = StartSlave(detector.get(), flags);
+  ASSERT_SOME(slave);
+
+  AWAIT_READY(__recover);
+
+  // Wait for recovery to be complete.
+  Clock::pause();
+  Clock::settle();
+
+  Future<Nothing> statusUpdate1 = FUTURE_DISPATCH(_, &Slave::statusUpdate);
+  Future<Nothing> statusUpdate2 = FUTURE_DISPATCH(_, &Slave::statusUpdate);
+
+  // The updates are for a framework unknown to the agent, which drops
+  // them after the dispatch; that is of no consequence here.
+  Call call;
+  call.set_type(Call::UPDATE_BATCH);
+  call.mutable_framework_id()->set_value("dummy_framework_id");
+  call.mutable_executor_id()->set_value("dummy_executor_id");
+
+  for (int i = 0; i < 2; i++) {
+    v1::TaskStatus* status =
+      call.mutable_update_batch()->add_updates()->mutable_status();
+
+    status->mutable_executor_id()->set_value("dummy_executor_id");
+    status->mutable_task_id()->set_value("task" + stringify(i));
+    status->set_state(mesos::v1::TaskState::TASK_RUNNING);
+    status->set_source(mesos::v1::TaskStatus::SOURCE_EXECUTOR);
+    status->set_uuid(id::UUID::random().toBytes());
+  }
+
+  ContentType contentType = GetParam();
+
+  process::http::Headers headers;
+  headers["Accept"] = stringify(contentType);
+
+  Future<Response> response = process::http::post(
+      slave.get()->pid,
+      "api/v1/executor",
+      headers,
+      serialize(contentType, call),
+      stringify(contentType));
+
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(Accepted().status, response);
+
+  AWAIT_READY(statusUpdate1);
+  AWAIT_READY(statusUpdate2);
+}
+
+
+// This test verifies that each update carried by an UPDATE_BATCH call
+// is validated like a standalone UPDATE call.
+TEST_P(ExecutorHttpApiTest, UpdateBatchCallFailedValidation)
+{
+  Try<Owned<cluster::Master>> master = StartMaster();
+  ASSERT_SOME(master);
+
+  Future<Nothing> __recover = FUTURE_DISPATCH(_, &Slave::__recover);
+
+  Owned<MasterDetector> detector = master.get()->createDetector();
+
+  slave::Flags flags = CreateSlaveFlags();
+
+  Try<Owned<cluster::Slave>> slave = StartSlave(detector.get(), flags);
+  ASSERT_SOME(slave);
+
+  AWAIT_READY(__recover);
+
+  // Wait for recovery to be complete.
+  Clock::pause();
+  Clock::settle();
+
+  // We send an UPDATE_BATCH call whose second update has an invalid
+  // UUID. This should result in failed validation.
+  Call call;
+  call.set_type(Call::UPDATE_BATCH);
+  call.mutable_framework_id()->set_value("dummy_framework_id");
+  call.mutable_executor_id()->set_value("dummy_executor_id");
+
+  v1::TaskStatus* status =
+    call.mutable_update_batch()->add_updates()->mutable_status();
+
+  status->mutable_executor_id()->set_value("dummy_executor_id");
+  status->mutable_task_id()->set_value("task1");
+  status->set_state(mesos::v1::TaskState::TASK_RUNNING);
+  status->set_source(mesos::v1::TaskStatus::SOURCE_EXECUTOR);
+  status->set_uuid(id::UUID::random().toBytes());
+
+  status = call.mutable_update_batch()->add_updates()->mutable_status();
+
+  status->mutable_executor_id()->set_value("dummy_executor_id");
+  status->mutable_task_id()->set_value("task2");
+  status->set_state(mesos::v1::TaskState::TASK_RUNNING);
+  status->set_source(mesos::v1::TaskStatus::SOURCE_EXECUTOR);
+  status->set_uuid("dummy_uuid");
+
+  process::http::Headers headers;
+  headers["Accept"] = APPLICATION_JSON;
+
+  Future<Response> response = process::http::post(
+      slave.get()->pid,
+      "api/v1/executor",
+      headers,
+      serialize(ContentType::PROTOBUF, call),
+      APPLICATION_PROTOBUF);
+
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(BadRequest().status, response);
+}
+
+
 // This test verifies that the executor cannot subscribe with the agent
 // before it recovers the containerizer.
 TEST_F(ExecutorHttpApiTest, SubscribeBeforeContainerizerRecovery)
@@ -291,6 +291,11 @@ void FetcherCacheTest::verifyCacheMetrics()
   EXPECT_SOME_EQ(
       used.bytes(),
       metrics.at<JSON::Number>("containerizer/fetcher/cache_size_used_bytes"));
+
+  EXPECT_EQ(1u, metrics.values.count("containerizer/fetcher/cache_hits"));
+  EXPECT_EQ(1u, metrics.values.count("containerizer/fetcher/cache_misses"));
+  EXPECT_EQ(
+      1u, metrics.values.count("containerizer/fetcher/cache_inserted_bytes"));
 }
 
 
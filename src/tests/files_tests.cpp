@@ -493,6 +493,45 @@ TEST_F(FilesTest, DownloadTest)
 }
 
 
+// Tests that the '/files/download' endpoint honors HTTP 'Range'
+// requests, so that clients can resume or window large downloads.
+TEST_F(FilesTest, DownloadRangeTest)
+{
+  Files files;
+  process::UPID upid("files", process::address());
+
+  ASSERT_SOME(os::write("data", "0123456789"));
+  AWAIT_EXPECT_READY(files.attach("data", "data"));
+
+  // A satisfiable range yields a partial response.
+  Future<Response> response = process::http::get(
+      upid,
+      "download",
+      "path=data",
+      process::http::Headers({{"Range", "bytes=2-5"}}));
+
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(
+      process::http::Status::string(process::http::Status::PARTIAL_CONTENT),
+      response);
+  AWAIT_EXPECT_RESPONSE_HEADER_EQ("bytes 2-5/10", "Content-Range", response);
+  AWAIT_EXPECT_RESPONSE_BODY_EQ("2345", response);
+
+  // A range starting at the end of the file is unsatisfiable and
+  // names the file size in the 'Content-Range' header.
+  response = process::http::get(
+      upid,
+      "download",
+      "path=data",
+      process::http::Headers({{"Range", "bytes=10-"}}));
+
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(
+      process::http::Status::string(
+          process::http::Status::REQUESTED_RANGE_NOT_SATISFIABLE),
+      response);
+  AWAIT_EXPECT_RESPONSE_HEADER_EQ("bytes */10", "Content-Range", response);
+}
+
+
 // Tests that the '/files/debug' endpoint works as expected.
 TEST_F(FilesTest, DebugTest)
 {
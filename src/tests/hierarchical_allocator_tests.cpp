@@ -46,6 +46,7 @@
 #include "master/flags.hpp"
 
 #include "master/allocator/mesos/hierarchical.hpp"
+#include "master/allocator/mesos/offer_constraints.hpp"
 
 #include "slave/constants.hpp"
 
@@ -57,7 +58,9 @@
 using mesos::internal::master::MIN_CPUS;
 using mesos::internal::master::MIN_MEM;
 
+using mesos::internal::master::allocator::CompiledAttributes;
 using mesos::internal::master::allocator::HierarchicalDRFAllocator;
+using mesos::internal::master::allocator::OfferConstraintsFilter;
 
 using mesos::internal::protobuf::createLabel;
 
@@ -6718,6 +6721,146 @@ TEST_P(HierarchicalAllocator_BENCHMARK_Test, DeclineOffers)
 }
 
 
+class HierarchicalAllocatorShape_BENCHMARK_Test
+  : public HierarchicalAllocatorTestBase,
+    public WithParamInterface<std::tuple<size_t, size_t, size_t>> {};
+
+
+// This benchmark sweeps cluster shapes (agents x frameworks x roles).
+INSTANTIATE_TEST_CASE_P(
+    AgentFrameworkRoleCount,
+    HierarchicalAllocatorShape_BENCHMARK_Test,
+    ::testing::Combine(
+      ::testing::Values(1000U, 10000U),
+      ::testing::Values(100U, 1000U),
+      ::testing::Values(1U, 10U, 100U))
+    );
+
+
+// Measures a full periodic allocation cycle for each cluster shape
+// and emits one machine-readable JSON record per shape to stdout so
+// that results can be tracked release to release, e.g.:
+//
+//   {"agents":1000.0,"frameworks":100.0,"roles":10.0,
+//    "add_frameworks_secs":...,"add_agents_secs":...,
+//    "cycle_secs":...,"offers":...}
+TEST_P(HierarchicalAllocatorShape_BENCHMARK_Test, AllocationCycle)
+{
+  size_t slaveCount = std::get<0>(GetParam());
+  size_t frameworkCount = std::get<1>(GetParam());
+  size_t roleCount = std::get<2>(GetParam());
+
+  // Pause the clock because we want to manually drive the allocations.
+  Clock::pause();
+
+  struct OfferedResources
+  {
+    FrameworkID   frameworkId;
+    SlaveID       slaveId;
+    Resources     resources;
+  };
+
+  vector<OfferedResources> offers;
+
+  auto offerCallback = [&offers](
+      const FrameworkID& frameworkId,
+      const hashmap<string, hashmap<SlaveID, Resources>>& resources_)
+  {
+    foreachkey (const string& role, resources_) {
+      foreachpair (const SlaveID& slaveId,
+                   const Resources& resources,
+                   resources_.at(role)) {
+        offers.push_back(OfferedResources{frameworkId, slaveId, resources});
+      }
+    }
+  };
+
+  cout << "Using " << slaveCount << " agents, "
+       << frameworkCount << " frameworks and "
+       << roleCount << " roles" << endl;
+
+  initialize(master::Flags(), offerCallback);
+
+  Stopwatch watch;
+  watch.start();
+
+  vector<FrameworkInfo> frameworks;
+  frameworks.reserve(frameworkCount);
+
+  // Spread the frameworks round-robin across the roles.
+  for (size_t i = 0; i < frameworkCount; i++) {
+    frameworks.push_back(
+        createFrameworkInfo({"role" + stringify(i % roleCount)}));
+    allocator->addFramework(frameworks[i].id(), frameworks[i], {}, true, {});
+  }
+
+  // Wait for all the `addFramework` operations to be processed.
+  Clock::settle();
+
+  watch.stop();
+
+  const Duration addFrameworks = watch.elapsed();
+
+  const Resources agentResources = Resources::parse(
+      "cpus:24;mem:4096;disk:4096;ports:[31000-32000]").get();
+
+  watch.start();
+
+  vector<SlaveInfo> slaves;
+  slaves.reserve(slaveCount);
+
+  for (size_t i = 0; i < slaveCount; i++) {
+    slaves.push_back(createSlaveInfo(agentResources));
+
+    allocator->addSlave(
+        slaves[i].id(),
+        slaves[i],
+        AGENT_CAPABILITIES(),
+        None(),
+        slaves[i].resources(),
+        {});
+  }
+
+  // Wait for all the `addSlave` operations to be processed.
+  Clock::settle();
+
+  watch.stop();
+
+  const Duration addAgents = watch.elapsed();
+
+  // Recover all outstanding offers without installing filters, so
+  // that the next cycle has to re-evaluate and re-offer every agent.
+  foreach (const OfferedResources& offer, offers) {
+    allocator->recoverResources(
+        offer.frameworkId, offer.slaveId, offer.resources, None());
+  }
+
+  Clock::settle();
+  offers.clear();
+
+  watch.start();
+
+  // Advance the clock and trigger a background allocation cycle.
+  Clock::advance(flags.allocation_interval);
+  Clock::settle();
+
+  watch.stop();
+
+  JSON::Object record;
+  record.values["agents"] = slaveCount;
+  record.values["frameworks"] = frameworkCount;
+  record.values["roles"] = roleCount;
+  record.values["add_frameworks_secs"] = addFrameworks.secs();
+  record.values["add_agents_secs"] = addAgents.secs();
+  record.values["cycle_secs"] = watch.elapsed().secs();
+  record.values["offers"] = offers.size();
+
+  cout << stringify(record) << endl;
+
+  Clock::resume();
+}
+
+
 // Returns the requested number of labels:
 //   [{"<key>_1": "<value>_1"}, ..., {"<key>_<count>":"<value>_<count>"}]
 static Labels createLabels(
@@ -7373,6 +7516,283 @@ TEST_F(HierarchicalAllocatorTest, RemoveFilters)
 }
 
 
+// Returns offer constraints consisting of a single group with a
+// single predicate on the given attribute name.
+static FrameworkInfo::OfferConstraints createOfferConstraints(
+    FrameworkInfo::OfferConstraints::Predicate::Type type,
+    const string& name,
+    const Option<string>& text = None())
+{
+  FrameworkInfo::OfferConstraints constraints;
+
+  FrameworkInfo::OfferConstraints::Predicate* predicate =
+    constraints.add_groups()->add_predicates();
+
+  predicate->set_type(type);
+  predicate->set_name(name);
+
+  if (text.isSome()) {
+    predicate->set_text(text.get());
+  }
+
+  return constraints;
+}
+
+
+// Compiles the attributes obtained by parsing the given string.
+static CompiledAttributes compileAttributes(const string& attributes)
+{
+  return CompiledAttributes(Attributes::parse(attributes));
+}
+
+
+// Checks that malformed offer constraints are rejected by
+// `OfferConstraintsFilter::create()`.
+TEST(OfferConstraintsFilterTest, CreateErrors)
+{
+  // A predicate without an attribute name.
+  EXPECT_ERROR(OfferConstraintsFilter::create(createOfferConstraints(
+      FrameworkInfo::OfferConstraints::Predicate::EXISTS, "")));
+
+  // `TEXT_EQUALS` and `TEXT_NOT_EQUALS` require `text` to be set.
+  EXPECT_ERROR(OfferConstraintsFilter::create(createOfferConstraints(
+      FrameworkInfo::OfferConstraints::Predicate::TEXT_EQUALS, "rack")));
+
+  EXPECT_ERROR(OfferConstraintsFilter::create(createOfferConstraints(
+      FrameworkInfo::OfferConstraints::Predicate::TEXT_NOT_EQUALS, "rack")));
+
+  // A predicate of an unknown type.
+  EXPECT_ERROR(OfferConstraintsFilter::create(createOfferConstraints(
+      FrameworkInfo::OfferConstraints::Predicate::UNKNOWN, "rack")));
+}
+
+
+// Checks the `EXISTS` and `NOT_EXISTS` predicates.
+TEST(OfferConstraintsFilterTest, ExistsPredicates)
+{
+  Try<OfferConstraintsFilter> exists =
+    OfferConstraintsFilter::create(createOfferConstraints(
+        FrameworkInfo::OfferConstraints::Predicate::EXISTS, "rack"));
+
+  ASSERT_SOME(exists);
+
+  EXPECT_TRUE(exists->matches(compileAttributes("rack:a")));
+  EXPECT_FALSE(exists->matches(compileAttributes("zone:a")));
+  EXPECT_FALSE(exists->matches(compileAttributes("")));
+
+  // `EXISTS` holds regardless of the attribute's type.
+  EXPECT_TRUE(exists->matches(compileAttributes("rack:[1-5]")));
+
+  Try<OfferConstraintsFilter> notExists =
+    OfferConstraintsFilter::create(createOfferConstraints(
+        FrameworkInfo::OfferConstraints::Predicate::NOT_EXISTS, "rack"));
+
+  ASSERT_SOME(notExists);
+
+  EXPECT_FALSE(notExists->matches(compileAttributes("rack:a")));
+  EXPECT_TRUE(notExists->matches(compileAttributes("zone:a")));
+  EXPECT_TRUE(notExists->matches(compileAttributes("")));
+}
+
+
+// Checks the `TEXT_EQUALS` and `TEXT_NOT_EQUALS` predicates.
+TEST(OfferConstraintsFilterTest, TextPredicates)
+{
+  Try<OfferConstraintsFilter> equals =
+    OfferConstraintsFilter::create(createOfferConstraints(
+        FrameworkInfo::OfferConstraints::Predicate::TEXT_EQUALS,
+        "rack",
+        string("a")));
+
+  ASSERT_SOME(equals);
+
+  EXPECT_TRUE(equals->matches(compileAttributes("rack:a")));
+  EXPECT_FALSE(equals->matches(compileAttributes("rack:b")));
+  EXPECT_FALSE(equals->matches(compileAttributes("zone:a")));
+  EXPECT_FALSE(equals->matches(compileAttributes("")));
+
+  // A non-TEXT attribute never equals a text value.
+  EXPECT_FALSE(equals->matches(compileAttributes("rack:[1-5]")));
+
+  // Attribute names are not enforced to be unique (MESOS-1215);
+  // `TEXT_EQUALS` holds if any attribute with the name matches.
+  EXPECT_TRUE(equals->matches(compileAttributes("rack:b;rack:a")));
+
+  Try<OfferConstraintsFilter> notEquals =
+    OfferConstraintsFilter::create(createOfferConstraints(
+        FrameworkInfo::OfferConstraints::Predicate::TEXT_NOT_EQUALS,
+        "rack",
+        string("a")));
+
+  ASSERT_SOME(notEquals);
+
+  EXPECT_FALSE(notEquals->matches(compileAttributes("rack:a")));
+  EXPECT_TRUE(notEquals->matches(compileAttributes("rack:b")));
+  EXPECT_TRUE(notEquals->matches(compileAttributes("zone:a")));
+  EXPECT_TRUE(notEquals->matches(compileAttributes("")));
+}
+
+
+// Checks that predicates within a group are conjoined and that
+// groups are disjoined, and that empty constraints match everything.
+TEST(OfferConstraintsFilterTest, GroupSemantics)
+{
+  // Empty constraints place no restriction on the agents.
+  Try<OfferConstraintsFilter> empty =
+    OfferConstraintsFilter::create(FrameworkInfo::OfferConstraints());
+
+  ASSERT_SOME(empty);
+
+  EXPECT_TRUE(empty->matches(compileAttributes("")));
+  EXPECT_TRUE(empty->matches(compileAttributes("rack:a")));
+
+  // A group with two predicates: both must hold.
+  FrameworkInfo::OfferConstraints constraints = createOfferConstraints(
+      FrameworkInfo::OfferConstraints::Predicate::TEXT_EQUALS,
+      "rack",
+      string("a"));
+
+  FrameworkInfo::OfferConstraints::Predicate* predicate =
+    constraints.mutable_groups(0)->add_predicates();
+
+  predicate->set_type(FrameworkInfo::OfferConstraints::Predicate::EXISTS);
+  predicate->set_name("ssd");
+
+  Try<OfferConstraintsFilter> conjunction =
+    OfferConstraintsFilter::create(constraints);
+
+  ASSERT_SOME(conjunction);
+
+  EXPECT_TRUE(conjunction->matches(compileAttributes("rack:a;ssd:yes")));
+  EXPECT_FALSE(conjunction->matches(compileAttributes("rack:a")));
+  EXPECT_FALSE(conjunction->matches(compileAttributes("ssd:yes")));
+
+  // A second group: matching either group is sufficient.
+  predicate = constraints.add_groups()->add_predicates();
+  predicate->set_type(FrameworkInfo::OfferConstraints::Predicate::EXISTS);
+  predicate->set_name("gpu");
+
+  Try<OfferConstraintsFilter> disjunction =
+    OfferConstraintsFilter::create(constraints);
+
+  ASSERT_SOME(disjunction);
+
+  EXPECT_TRUE(disjunction->matches(compileAttributes("rack:a;ssd:yes")));
+  EXPECT_TRUE(disjunction->matches(compileAttributes("gpu:yes")));
+  EXPECT_FALSE(disjunction->matches(compileAttributes("rack:a")));
+}
+
+
+// Checks that a framework with offer constraints is not allocated
+// the resources of agents whose attributes do not match, while other
+// frameworks still receive them.
+TEST_F(HierarchicalAllocatorTest, OfferConstraints)
+{
+  // Pause the clock because we want to manually drive the allocations.
+  Clock::pause();
+
+  initialize();
+
+  FrameworkInfo framework1 = createFrameworkInfo({"role1"});
+  *framework1.mutable_offer_constraints() = createOfferConstraints(
+      FrameworkInfo::OfferConstraints::Predicate::TEXT_EQUALS,
+      "region",
+      string("west"));
+
+  allocator->addFramework(framework1.id(), framework1, {}, true, {});
+
+  // `agent1` does not match the constraints of `framework1`,
+  // so its resources should not be offered to it.
+  SlaveInfo agent1 = createSlaveInfo("cpus:1;mem:512;disk:0");
+  *agent1.mutable_attributes() = Attributes::parse("region:east");
+
+  allocator->addSlave(
+      agent1.id(),
+      agent1,
+      AGENT_CAPABILITIES(),
+      None(),
+      agent1.resources(),
+      {});
+
+  Clock::settle();
+
+  Future<Allocation> allocation = allocations.get();
+  EXPECT_TRUE(allocation.isPending());
+
+  // `agent2` matches the constraints and should be offered.
+  SlaveInfo agent2 = createSlaveInfo("cpus:1;mem:512;disk:0");
+  *agent2.mutable_attributes() = Attributes::parse("region:west");
+
+  allocator->addSlave(
+      agent2.id(),
+      agent2,
+      AGENT_CAPABILITIES(),
+      None(),
+      agent2.resources(),
+      {});
+
+  Allocation expected = Allocation(
+      framework1.id(),
+      {{"role1", {{agent2.id(), agent2.resources()}}}});
+
+  AWAIT_EXPECT_EQ(expected, allocation);
+
+  // An unconstrained framework should still be offered `agent1`.
+  FrameworkInfo framework2 = createFrameworkInfo({"role2"});
+  allocator->addFramework(framework2.id(), framework2, {}, true, {});
+
+  expected = Allocation(
+      framework2.id(),
+      {{"role2", {{agent1.id(), agent1.resources()}}}});
+
+  AWAIT_EXPECT_EQ(expected, allocations.get());
+}
+
+
+// Checks that updating a framework's offer constraints via
+// `updateFramework()` takes effect for subsequent allocations.
+TEST_F(HierarchicalAllocatorTest, OfferConstraintsUpdateFramework)
+{
+  // Pause the clock because we want to manually drive the allocations.
+  Clock::pause();
+
+  initialize();
+
+  FrameworkInfo framework = createFrameworkInfo({"role1"});
+  *framework.mutable_offer_constraints() = createOfferConstraints(
+      FrameworkInfo::OfferConstraints::Predicate::EXISTS, "ssd");
+
+  allocator->addFramework(framework.id(), framework, {}, true, {});
+
+  SlaveInfo agent = createSlaveInfo("cpus:1;mem:512;disk:0");
+  allocator->addSlave(
+      agent.id(),
+      agent,
+      AGENT_CAPABILITIES(),
+      None(),
+      agent.resources(),
+      {});
+
+  Clock::settle();
+
+  Future<Allocation> allocation = allocations.get();
+  EXPECT_TRUE(allocation.isPending());
+
+  // Re-add the framework without constraints; the agent should now
+  // be offered on the next allocation cycle.
+  framework.clear_offer_constraints();
+  allocator->updateFramework(framework.id(), framework, {});
+
+  Clock::advance(flags.allocation_interval);
+
+  Allocation expected = Allocation(
+      framework.id(),
+      {{"role1", {{agent.id(), agent.resources()}}}});
+
+  AWAIT_EXPECT_EQ(expected, allocation);
+}
+
+
 // This test uses `reviveOffers` to add allocation-triggering events
 // to the allocator queue in order to measure the impact of allocation
 // batching (MESOS-6904).
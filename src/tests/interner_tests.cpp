@@ -0,0 +1,71 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "common/interner.hpp"
+
+using std::shared_ptr;
+using std::string;
+
+using mesos::internal::StringInterner;
+
+namespace mesos {
+namespace internal {
+namespace tests {
+
+
+TEST(StringInternerTest, EqualStringsShareStorage)
+{
+  StringInterner interner;
+
+  shared_ptr<const string> interned1 = interner.intern("eng/team/service");
+  shared_ptr<const string> interned2 = interner.intern("eng/team/service");
+
+  // Equal strings intern to the same pointer.
+  EXPECT_EQ(interned1.get(), interned2.get());
+  EXPECT_EQ("eng/team/service", *interned1);
+
+  // Distinct strings do not.
+  shared_ptr<const string> other = interner.intern("eng/team");
+  EXPECT_NE(interned1.get(), other.get());
+
+  EXPECT_EQ(2u, interner.size());
+}
+
+
+TEST(StringInternerTest, DroppedWhenUnreferenced)
+{
+  StringInterner interner;
+
+  shared_ptr<const string> interned = interner.intern("role");
+  EXPECT_EQ(1u, interner.size());
+
+  interned.reset();
+  EXPECT_EQ(0u, interner.size());
+
+  // Re-interning after the entry was dropped yields a fresh entry.
+  interned = interner.intern("role");
+  EXPECT_EQ("role", *interned);
+  EXPECT_EQ(1u, interner.size());
+}
+
+} // namespace tests {
+} // namespace internal {
+} // namespace mesos {
@@ -321,6 +321,81 @@ TYPED_TEST(LogStorageTest, TruncateWithManyHoles)
 }
 
 
+TYPED_TEST(LogStorageTest, PersistGroup)
+{
+  TypeParam storage;
+
+  Try<Storage::State> state = storage.restore(os::getcwd() + "/.log");
+  ASSERT_SOME(state);
+
+  // Append from position 0 to position 9 as a single group.
+  list<Action> actions;
+
+  for (uint64_t i = 0; i < 10; i++) {
+    Action action;
+    action.set_position(i);
+    action.set_promised(1);
+    action.set_performed(1);
+    action.set_learned(true);
+    action.set_type(Action::APPEND);
+    action.mutable_append()->set_bytes(stringify(i));
+
+    actions.push_back(action);
+  }
+
+  ASSERT_SOME(storage.persist(actions));
+
+  for (uint64_t i = 0; i < 10; i++) {
+    Try<Action> action = storage.read(i);
+    ASSERT_SOME(action);
+
+    EXPECT_EQ(i, action->position());
+    EXPECT_EQ(Action::APPEND, action->type());
+    ASSERT_TRUE(action->has_append());
+    EXPECT_EQ(stringify(i), action->append().bytes());
+  }
+
+  // A group containing a learned truncation should still delete the
+  // truncated positions.
+  actions.clear();
+
+  for (uint64_t i = 10; i < 13; i++) {
+    Action action;
+    action.set_position(i);
+    action.set_promised(1);
+    action.set_performed(1);
+    action.set_learned(true);
+    action.set_type(Action::APPEND);
+    action.mutable_append()->set_bytes(stringify(i));
+
+    actions.push_back(action);
+  }
+
+  Action truncate;
+  truncate.set_position(13);
+  truncate.set_promised(1);
+  truncate.set_performed(1);
+  truncate.set_learned(true);
+  truncate.set_type(Action::TRUNCATE);
+  truncate.mutable_truncate()->set_to(5);
+
+  actions.push_back(truncate);
+
+  ASSERT_SOME(storage.persist(actions));
+
+  for (uint64_t i = 0; i < 14; i++) {
+    Try<Action> action = storage.read(i);
+
+    if (i < 5) {
+      // Position 0 to 4 have been truncated.
+      EXPECT_ERROR(action);
+    } else {
+      EXPECT_SOME(action);
+    }
+  }
+}
+
+
 class ReplicaTest : public TemporaryDirectoryTest
 {
 protected:
@@ -440,6 +515,47 @@ TEST_F(ReplicaTest, Append)
 }
 
 
+TEST_F(ReplicaTest, Learned)
+{
+  const string path = os::getcwd() + "/.log";
+  initializer.flags.path = path;
+  ASSERT_SOME(initializer.execute());
+
+  Replica replica(path);
+
+  Action action;
+  action.set_position(1);
+  action.set_promised(1);
+  action.set_performed(1);
+  action.set_learned(true);
+  action.set_type(Action::APPEND);
+  action.mutable_append()->set_bytes("hello world");
+
+  LearnedMessage message;
+  message.mutable_action()->CopyFrom(action);
+
+  // Learned notices are written to storage lazily (so that bursts of
+  // them can share a single sync); a subsequent request must still
+  // observe the action.
+  post(replica.pid(), message);
+
+  Future<bool> missing = replica.missing(1);
+
+  AWAIT_READY(missing);
+  EXPECT_FALSE(missing.get());
+
+  Future<list<Action>> actions = replica.read(1, 1);
+
+  AWAIT_READY(actions);
+  ASSERT_EQ(1u, actions->size());
+
+  EXPECT_EQ(1u, actions->front().position());
+  EXPECT_TRUE(actions->front().learned());
+  ASSERT_TRUE(actions->front().has_append());
+  EXPECT_EQ("hello world", actions->front().append().bytes());
+}
+
+
 TEST_F(ReplicaTest, Restore)
 {
   const string path = os::getcwd() + "/.log";
@@ -1205,6 +1321,62 @@ TEST_F(CoordinatorTest, MultipleAppends)
 }
 
 
+TEST_F(CoordinatorTest, PipelinedAppends)
+{
+  const string path1 = os::getcwd() + "/.log1";
+  initializer.flags.path = path1;
+  ASSERT_SOME(initializer.execute());
+
+  const string path2 = os::getcwd() + "/.log2";
+  initializer.flags.path = path2;
+  ASSERT_SOME(initializer.execute());
+
+  Shared<Replica> replica1(new Replica(path1));
+  Shared<Replica> replica2(new Replica(path2));
+
+  set<UPID> pids;
+  pids.insert(replica1->pid());
+  pids.insert(replica2->pid());
+
+  Shared<Network> network(new Network(pids));
+
+  Coordinator coord(2, replica1, network);
+
+  {
+    Future<Option<uint64_t>> electing = coord.elect();
+    AWAIT_READY(electing);
+    EXPECT_SOME_EQ(0u, electing.get());
+  }
+
+  // Issue all the appends before waiting on any of them: each append
+  // is assigned its position immediately and the rounds to the
+  // replicas overlap.
+  list<Future<Option<uint64_t>>> appendings;
+
+  for (uint64_t position = 1; position <= 10; position++) {
+    appendings.push_back(coord.append(stringify(position)));
+  }
+
+  uint64_t position = 1;
+  foreach (Future<Option<uint64_t>>& appending, appendings) {
+    AWAIT_READY(appending);
+    EXPECT_SOME_EQ(position, appending.get());
+    position++;
+  }
+
+  {
+    Future<list<Action>> actions = replica1->read(1, 10);
+    AWAIT_READY(actions);
+    EXPECT_EQ(10u, actions->size());
+    foreach (const Action& action, actions.get()) {
+      ASSERT_TRUE(action.has_type());
+      ASSERT_EQ(Action::APPEND, action.type());
+      EXPECT_EQ(stringify(action.position()), action.append().bytes());
+    }
+  }
+}
+
+
 TEST_F(CoordinatorTest, MultipleAppendsNotLearnedFill)
 {
   const string path1 = os::getcwd() + "/.log1";
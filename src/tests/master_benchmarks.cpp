@@ -14,6 +14,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -250,6 +251,237 @@ private:
 };
 
 
+// A synthetic agent for cluster-at-scale simulations. It speaks just
+// enough of the agent protocol to register with the master and stay
+// registered, so that its resources take part in allocation.
+class SimulationAgentProcess : public ProtobufProcess<SimulationAgentProcess>
+{
+public:
+  SimulationAgentProcess(const UPID& _masterPid, const SlaveID& _slaveId)
+    : ProcessBase(process::ID::generate("simulation-agent")),
+      masterPid(_masterPid),
+      slaveId(_slaveId) {}
+
+  SimulationAgentProcess(const SimulationAgentProcess& other) = delete;
+  SimulationAgentProcess& operator=(
+      const SimulationAgentProcess& other) = delete;
+
+  void initialize() override
+  {
+    install<SlaveRegisteredMessage>(&Self::registered);
+    install<PingSlaveMessage>(
+        &Self::ping,
+        &PingSlaveMessage::connected);
+  }
+
+  Future<Nothing> start()
+  {
+    RegisterSlaveMessage message;
+    *(message.mutable_slave()) = createSlaveInfo(slaveId);
+    message.set_version(MESOS_VERSION);
+
+    send(masterPid, message);
+    return promise.future();
+  }
+
+private:
+  void registered(const SlaveRegisteredMessage&)
+  {
+    promise.set(Nothing());
+  }
+
+  // We need to answer pings to keep the agent registered.
+  void ping(const UPID& from, bool)
+  {
+    send(from, PongSlaveMessage());
+  }
+
+  const UPID masterPid;
+  const SlaveID slaveId;
+
+  Promise<Nothing> promise;
+};
+
+
+class SimulationAgent
+{
+public:
+  SimulationAgent(const UPID& masterPid, const SlaveID& slaveId)
+    : process(new SimulationAgentProcess(masterPid, slaveId))
+  {
+    spawn(process.get());
+  }
+
+  ~SimulationAgent()
+  {
+    terminate(process.get());
+    process::wait(process.get());
+  }
+
+  Future<Nothing> start()
+  {
+    return dispatch(process.get(), &SimulationAgentProcess::start);
+  }
+
+private:
+  Owned<SimulationAgentProcess> process;
+};
+
+
+// A scripted framework workload for cluster-at-scale simulations. It
+// registers with the master, declines every offer it receives so that
+// the resources are immediately reoffered, and records the latency
+// between a decline and the arrival of the next offer, i.e., the time
+// the allocator and master take to turn the resources around. If
+// `failoverInterval` is non-zero, the scheduler simulates framework
+// churn by failing over after every `failoverInterval` offers.
+class SimulationSchedulerProcess
+  : public ProtobufProcess<SimulationSchedulerProcess>
+{
+public:
+  SimulationSchedulerProcess(
+      const UPID& _masterPid,
+      const string& _name,
+      size_t _offerGoal,
+      size_t _failoverInterval)
+    : ProcessBase(process::ID::generate("simulation-scheduler")),
+      masterPid(_masterPid),
+      name(_name),
+      offerGoal(_offerGoal),
+      failoverInterval(_failoverInterval),
+      offersReceived(0)
+  {
+    frameworkInfo = DEFAULT_FRAMEWORK_INFO;
+    frameworkInfo.set_name(name);
+    frameworkInfo.clear_id();
+  }
+
+  SimulationSchedulerProcess(
+      const SimulationSchedulerProcess& other) = delete;
+  SimulationSchedulerProcess& operator=(
+      const SimulationSchedulerProcess& other) = delete;
+
+  void initialize() override
+  {
+    install<FrameworkRegisteredMessage>(&Self::registered);
+    install<FrameworkReregisteredMessage>(&Self::reregistered);
+    install<ResourceOffersMessage>(&Self::offers);
+    install<RescindResourceOfferMessage>(&Self::rescind);
+  }
+
+  // Completes once `offerGoal` offer messages have been received.
+  Future<Nothing> start()
+  {
+    RegisterFrameworkMessage message;
+    *(message.mutable_framework()) = frameworkInfo;
+
+    send(masterPid, message);
+    return promise.future();
+  }
+
+  vector<Duration> latencies() { return samples; }
+
+private:
+  void registered(const FrameworkRegisteredMessage& message)
+  {
+    *(frameworkInfo.mutable_id()) = message.framework_id();
+  }
+
+  void reregistered(const FrameworkReregisteredMessage&) {}
+
+  // Offers rescinded during a failover are simply dropped.
+  void rescind(const RescindResourceOfferMessage&) {}
+
+  void offers(const ResourceOffersMessage& message)
+  {
+    if (declined.isSome()) {
+      samples.push_back(Clock::now() - declined.get());
+    }
+
+    offersReceived++;
+
+    // Decline everything without a filter so that the resources are
+    // reoffered on the next allocation cycle.
+    LaunchTasksMessage decline;
+    *(decline.mutable_framework_id()) = frameworkInfo.id();
+    decline.mutable_filters()->set_refuse_seconds(0);
+
+    foreach (const Offer& offer, message.offers()) {
+      *(decline.add_offer_ids()) = offer.id();
+    }
+
+    send(masterPid, decline);
+    declined = Clock::now();
+
+    if (failoverInterval > 0 && offersReceived % failoverInterval == 0) {
+      // Simulate framework churn by failing over the scheduler. The
+      // master rescinds our outstanding offers, so don't count the
+      // next turnaround in the latency distribution.
+      declined = None();
+
+      ReregisterFrameworkMessage reregister;
+      *(reregister.mutable_framework()) = frameworkInfo;
+      reregister.set_failover(true);
+
+      send(masterPid, reregister);
+    }
+
+    if (offersReceived >= offerGoal) {
+      promise.set(Nothing());
+    }
+  }
+
+  const UPID masterPid;
+  const string name;
+  const size_t offerGoal;
+  const size_t failoverInterval;
+
+  FrameworkInfo frameworkInfo;
+  size_t offersReceived;
+  Option<process::Time> declined;
+  vector<Duration> samples;
+  Promise<Nothing> promise;
+};
+
+
+class SimulationScheduler
+{
+public:
+  SimulationScheduler(
+      const UPID& masterPid,
+      const string& name,
+      size_t offerGoal,
+      size_t failoverInterval)
+    : process(new SimulationSchedulerProcess(
+          masterPid,
+          name,
+          offerGoal,
+          failoverInterval))
+  {
+    spawn(process.get());
+  }
+
+  ~SimulationScheduler()
+  {
+    terminate(process.get());
+    process::wait(process.get());
+  }
+
+  Future<Nothing> start()
+  {
+    return dispatch(process.get(), &SimulationSchedulerProcess::start);
+  }
+
+  Future<vector<Duration>> latencies()
+  {
+    return dispatch(process.get(), &SimulationSchedulerProcess::latencies);
+  }
+
+private:
+  Owned<SimulationSchedulerProcess> process;
+};
+
+
 class MasterFailover_BENCHMARK_Test
   : public MesosTest,
     public WithParamInterface<tuple<size_t, size_t, size_t, size_t, size_t>> {};
@@ -620,6 +852,136 @@ TEST_P(MasterMetricsQuery_BENCHMARK_Test, GetMetrics)
   }
 }
 
+class ClusterSimulation_BENCHMARK_Test
+  : public MesosTest,
+    public WithParamInterface<tuple<size_t, size_t, size_t, size_t>> {};
+
+
+// The value tuples are defined as:
+// - agentCount
+// - frameworkCount
+// - offersPerFramework (offer messages each framework waits for)
+// - failoverInterval (framework fails over after this many offers,
+//   0 disables churn)
+INSTANTIATE_TEST_CASE_P(
+    AgentFrameworkOfferChurnCount,
+    ClusterSimulation_BENCHMARK_Test,
+    ::testing::Values(
+        make_tuple(1000, 20, 25, 0),
+        make_tuple(10000, 200, 10, 0),
+        make_tuple(10000, 200, 10, 5),
+        make_tuple(50000, 2000, 5, 0)));
+
+
+// This benchmark simulates a cluster at scale in a single process:
+// synthetic agents register and take part in allocation, while
+// scripted frameworks decline every offer they get. It reports the
+// distribution of the offer turnaround latency (from declining an
+// offer to receiving the next one) and the overall offer throughput,
+// which together approximate the master's allocation responsiveness
+// under the given cluster size and framework churn.
+TEST_P(ClusterSimulation_BENCHMARK_Test, OfferLatency)
+{
+  size_t agentCount;
+  size_t frameworkCount;
+  size_t offersPerFramework;
+  size_t failoverInterval;
+
+  tie(agentCount,
+      frameworkCount,
+      offersPerFramework,
+      failoverInterval) = GetParam();
+
+  // Disable authentication to avoid the overhead, since we don't care
+  // about it in this test.
+  master::Flags masterFlags = CreateMasterFlags();
+  masterFlags.authenticate_agents = false;
+  masterFlags.authenticate_frameworks = false;
+
+  Try<Owned<cluster::Master>> master = StartMaster(masterFlags);
+  ASSERT_SOME(master);
+
+  vector<Owned<SimulationAgent>> agents;
+
+  for (size_t i = 0; i < agentCount; i++) {
+    SlaveID slaveId;
+    slaveId.set_value("agent" + stringify(i));
+
+    agents.push_back(Owned<SimulationAgent>(
+        new SimulationAgent(master.get()->pid, slaveId)));
+  }
+
+  Stopwatch watch;
+  watch.start();
+
+  vector<Future<Nothing>> registered;
+
+  foreach (const Owned<SimulationAgent>& agent, agents) {
+    registered.push_back(agent->start());
+  }
+
+  await(registered).await();
+
+  watch.stop();
+
+  cout << "Registered " << agentCount << " agents in "
+       << watch.elapsed() << endl;
+
+  vector<Owned<SimulationScheduler>> schedulers;
+
+  for (size_t i = 0; i < frameworkCount; i++) {
+    schedulers.push_back(Owned<SimulationScheduler>(new SimulationScheduler(
+        master.get()->pid,
+        "framework" + stringify(i),
+        offersPerFramework,
+        failoverInterval)));
+  }
+
+  vector<Future<Nothing>> finished;
+
+  watch.start();
+
+  foreach (const Owned<SimulationScheduler>& scheduler, schedulers) {
+    finished.push_back(scheduler->start());
+  }
+
+  await(finished).await();
+
+  watch.stop();
+
+  const size_t offerCount = frameworkCount * offersPerFramework;
+
+  cout << "Received " << offerCount << " offer messages across "
+       << frameworkCount << " frameworks in " << watch.elapsed()
+       << " (" << offerCount / watch.elapsed().secs() << " offers/s)"
+       << endl;
+
+  vector<Duration> samples;
+
+  foreach (const Owned<SimulationScheduler>& scheduler, schedulers) {
+    Future<vector<Duration>> latencies = scheduler->latencies();
+    latencies.await();
+
+    foreach (const Duration& sample, latencies.get()) {
+      samples.push_back(sample);
+    }
+  }
+
+  if (!samples.empty()) {
+    std::sort(samples.begin(), samples.end());
+
+    auto percentile = [&samples](double p) {
+      return samples[static_cast<size_t>(p * (samples.size() - 1))];
+    };
+
+    cout << "Offer turnaround latency (" << samples.size() << " samples):"
+         << " p50 " << percentile(0.5)
+         << ", p90 " << percentile(0.9)
+         << ", p99 " << percentile(0.99)
+         << ", max " << samples.back() << endl;
+  }
+}
+
 } // namespace tests {
 } // namespace internal {
 } // namespace mesos {
@@ -44,9 +44,11 @@
 
 #include "master/master.hpp"
 
+#include "master/contender/log.hpp"
 #include "master/contender/standalone.hpp"
 #include "master/contender/zookeeper.hpp"
 
+#include "master/detector/log.hpp"
 #include "master/detector/standalone.hpp"
 #include "master/detector/zookeeper.hpp"
 
@@ -67,11 +69,13 @@ using mesos::internal::slave::Slave;
 
 using mesos::internal::protobuf::createMasterInfo;
 
+using mesos::master::contender::LogMasterContender;
 using mesos::master::contender::MASTER_CONTENDER_ZK_SESSION_TIMEOUT;
 using mesos::master::contender::MasterContender;
 using mesos::master::contender::StandaloneMasterContender;
 using mesos::master::contender::ZooKeeperMasterContender;
 
+using mesos::master::detector::LogMasterDetector;
 using mesos::master::detector::MASTER_DETECTOR_ZK_SESSION_TIMEOUT;
 using mesos::master::detector::MasterDetector;
 using mesos::master::detector::StandaloneMasterDetector;
@@ -84,6 +88,7 @@ using process::PID;
 using process::UPID;
 
 using std::map;
+using std::set;
 using std::string;
 using std::vector;
 
@@ -215,6 +220,175 @@ TEST(BasicMasterContenderDetectorTest, MasterInfo)
 }
 
 
+class LogMasterContenderDetectorTest : public MesosTest {};
+
+
+// A single contender electing through the replicated log gets
+// elected automatically and is picked up by the detector.
+TEST_F(LogMasterContenderDetectorTest, MasterContender)
+{
+  const string path = path::join(os::getcwd(), "replicated_log");
+
+  PID<Master> pid;
+  pid.address.ip = net::IP(10000000);
+  pid.address.port = 10000;
+
+  MasterInfo master = createMasterInfo(pid);
+
+  LogMasterContender contender(1, path, set<UPID>());
+
+  contender.initialize(master);
+
+  Future<Future<Nothing>> contended = contender.contend();
+  AWAIT_READY(contended);
+
+  Future<Nothing> lostCandidacy = contended.get();
+
+  // The detector shares the contender's log instance (and hence its
+  // local replica); creating it on the same path must not conflict
+  // with the replica the contender holds open.
+  LogMasterDetector detector(1, path, set<UPID>());
+
+  Future<Option<MasterInfo>> leader = detector.detect();
+
+  AWAIT_READY(leader);
+  EXPECT_SOME_EQ(master, leader.get());
+
+  // The leader keeps renewing its lease, so neither the candidacy
+  // nor the leadership is lost.
+  EXPECT_TRUE(lostCandidacy.isPending());
+
+  leader = detector.detect(leader.get());
+  EXPECT_TRUE(leader.isPending());
+}
+
+
+// When the leading contender goes away its lease expires and another
+// contender takes over; the detector notices the change.
+TEST_F(LogMasterContenderDetectorTest, MasterContenderFailover)
+{
+  const string path = path::join(os::getcwd(), "replicated_log");
+
+  PID<Master> pid1;
+  pid1.address.ip = net::IP(10000000);
+  pid1.address.port = 10000;
+
+  PID<Master> pid2;
+  pid2.address.ip = net::IP(10000001);
+  pid2.address.port = 10001;
+
+  MasterInfo master1 = createMasterInfo(pid1);
+  MasterInfo master2 = createMasterInfo(pid2);
+
+  Owned<LogMasterContender> contender1(
+      new LogMasterContender(1, path, set<UPID>()));
+
+  contender1->initialize(master1);
+
+  Future<Future<Nothing>> contended1 = contender1->contend();
+  AWAIT_READY(contended1);
+
+  LogMasterDetector detector(1, path, set<UPID>());
+
+  Future<Option<MasterInfo>> leader = detector.detect();
+
+  AWAIT_READY(leader);
+  EXPECT_SOME_EQ(master1, leader.get());
+
+  Future<Option<MasterInfo>> change = detector.detect(leader.get());
+
+  // Kill the leader: its lease stops being renewed, so a second
+  // contender takes over once the lease has expired.
+  contender1.reset();
+
+  LogMasterContender contender2(1, path, set<UPID>());
+
+  contender2.initialize(master2);
+
+  Future<Future<Nothing>> contended2 = contender2.contend();
+  AWAIT_READY(contended2);
+
+  // The detector either notices the expired lease first (no leader)
+  // or directly picks up the new one.
+  AWAIT_READY(change);
+
+  if (change->isNone()) {
+    change = detector.detect(None());
+    AWAIT_READY(change);
+  }
+
+  EXPECT_SOME_EQ(master2, change.get());
+}
+
+
+// Module parameters for the log contender and detector are parsed
+// and validated.
+TEST_F(LogMasterContenderDetectorTest, Parameters)
+{
+  const string path = path::join(os::getcwd(), "replicated_log");
+
+  // Missing 'quorum' and 'log_path'.
+  Parameters parameters;
+  EXPECT_ERROR(LogMasterContender::create(parameters));
+  EXPECT_ERROR(LogMasterDetector::create(parameters));
+
+  Parameter* parameter = parameters.add_parameter();
+  parameter->set_key("quorum");
+  parameter->set_value("1");
+
+  // Still missing 'log_path'.
+  EXPECT_ERROR(LogMasterContender::create(parameters));
+
+  parameter = parameters.add_parameter();
+  parameter->set_key("log_path");
+  parameter->set_value(path);
+
+  Try<LogMasterContender*> contender =
+    LogMasterContender::create(parameters);
+
+  ASSERT_SOME(contender);
+
+  Try<LogMasterDetector*> detector = LogMasterDetector::create(parameters);
+
+  ASSERT_SOME(detector);
+
+  delete contender.get();
+  delete detector.get();
+
+  // A quorum that is not a positive integer is rejected.
+  Parameters malformed;
+
+  parameter = malformed.add_parameter();
+  parameter->set_key("quorum");
+  parameter->set_value("0");
+
+  parameter = malformed.add_parameter();
+  parameter->set_key("log_path");
+  parameter->set_value(path);
+
+  EXPECT_ERROR(LogMasterContender::create(malformed));
+  EXPECT_ERROR(LogMasterDetector::create(malformed));
+
+  // A malformed replica pid is rejected.
+  Parameters badReplica;
+
+  parameter = badReplica.add_parameter();
+  parameter->set_key("quorum");
+  parameter->set_value("1");
+
+  parameter = badReplica.add_parameter();
+  parameter->set_key("log_path");
+  parameter->set_value(path);
+
+  parameter = badReplica.add_parameter();
+  parameter->set_key("replicas");
+  parameter->set_value("not a pid");
+
+  EXPECT_ERROR(LogMasterContender::create(badReplica));
+  EXPECT_ERROR(LogMasterDetector::create(badReplica));
+}
+
+
 #ifdef MESOS_HAS_JAVA
 class ZooKeeperMasterContenderDetectorTest : public ZooKeeperTest {};
 
@@ -43,6 +43,8 @@
 #include <stout/net.hpp>
 #include <stout/option.hpp>
 #include <stout/os.hpp>
+#include <stout/path.hpp>
+#include <stout/recordio.hpp>
 #include <stout/strings.hpp>
 #include <stout/try.hpp>
 
@@ -106,6 +108,7 @@ using process::PID;
 using process::Promise;
 
 using process::http::Accepted;
+using process::http::BadRequest;
 using process::http::InternalServerError;
 using process::http::OK;
 using process::http::Response;
@@ -825,6 +828,145 @@ TEST_F(MasterTest, StatusUpdateAck)
 }
 
 
+// This test verifies that the master coalesces the acknowledgements
+// of an ACKNOWLEDGE_BATCH call destined for the same agent into a
+// single `BatchedStatusUpdateAcknowledgementsMessage`, and that the
+// agent processes every entry of the batch.
+TEST_F(MasterTest, BatchedStatusUpdateAcknowledgements)
+{
+  Try<Owned<cluster::Master>> master = StartMaster();
+  ASSERT_SOME(master);
+
+  MockExecutor exec(DEFAULT_EXECUTOR_ID);
+  TestContainerizer containerizer(&exec);
+
+  Owned<MasterDetector> detector = master.get()->createDetector();
+  Try<Owned<cluster::Slave>> slave = StartSlave(detector.get(), &containerizer);
+  ASSERT_SOME(slave);
+
+  auto scheduler = std::make_shared<v1::MockHTTPScheduler>();
+
+  EXPECT_CALL(*scheduler, connected(_))
+    .WillOnce(v1::scheduler::SendSubscribe(v1::DEFAULT_FRAMEWORK_INFO));
+
+  Future<Event::Subscribed> subscribed;
+  EXPECT_CALL(*scheduler, subscribed(_, _))
+    .WillOnce(FutureArg<1>(&subscribed));
+
+  EXPECT_CALL(*scheduler, heartbeat(_))
+    .WillRepeatedly(Return()); // Ignore heartbeats.
+
+  Future<Event::Offers> offers;
+  EXPECT_CALL(*scheduler, offers(_, _))
+    .WillOnce(FutureArg<1>(&offers))
+    .WillRepeatedly(Return()); // Ignore subsequent offers.
+
+  v1::scheduler::TestMesos mesos(
+      master.get()->pid, ContentType::PROTOBUF, scheduler);
+
+  AWAIT_READY(subscribed);
+
+  v1::FrameworkID frameworkId(subscribed->framework_id());
+
+  AWAIT_READY(offers);
+  ASSERT_FALSE(offers->offers().empty());
+
+  const v1::Offer& offer = offers->offers(0);
+
+  v1::TaskInfo task1;
+  task1.set_name("");
+  task1.mutable_task_id()->set_value("1");
+  task1.mutable_agent_id()->CopyFrom(offer.agent_id());
+  task1.mutable_resources()->CopyFrom(
+      v1::Resources::parse("cpus:0.1;mem:32").get());
+  task1.mutable_executor()->CopyFrom(v1::DEFAULT_EXECUTOR_INFO);
+
+  v1::TaskInfo task2 = task1;
+  task2.mutable_task_id()->set_value("2");
+
+  EXPECT_CALL(exec, registered(_, _, _, _));
+
+  EXPECT_CALL(exec, launchTask(_, _))
+    .WillRepeatedly(SendStatusUpdateFromTask(TASK_RUNNING));
+
+  Future<Event::Update> update1;
+  Future<Event::Update> update2;
+  EXPECT_CALL(*scheduler, update(_, _))
+    .WillOnce(FutureArg<1>(&update1))
+    .WillOnce(FutureArg<1>(&update2));
+
+  {
+    Call call;
+    call.mutable_framework_id()->CopyFrom(frameworkId);
+    call.set_type(Call::ACCEPT);
+
+    Call::Accept* accept = call.mutable_accept();
+    accept->add_offer_ids()->CopyFrom(offer.id());
+
+    v1::Offer::Operation* operation = accept->add_operations();
+    operation->set_type(v1::Offer::Operation::LAUNCH);
+    operation->mutable_launch()->add_task_infos()->CopyFrom(task1);
+    operation->mutable_launch()->add_task_infos()->CopyFrom(task2);
+
+    mesos.send(call);
+  }
+
+  AWAIT_READY(update1);
+  AWAIT_READY(update2);
+
+  EXPECT_EQ(v1::TASK_RUNNING, update1->status().state());
+  EXPECT_EQ(v1::TASK_RUNNING, update2->status().state());
+
+  Future<BatchedStatusUpdateAcknowledgementsMessage> batched =
+    FUTURE_PROTOBUF(
+        BatchedStatusUpdateAcknowledgementsMessage(),
+        master.get()->pid,
+        slave.get()->pid);
+
+  Future<Nothing> _statusUpdateAcknowledgement1 =
+    FUTURE_DISPATCH(slave.get()->pid, &Slave::_statusUpdateAcknowledgement);
+  Future<Nothing> _statusUpdateAcknowledgement2 =
+    FUTURE_DISPATCH(slave.get()->pid, &Slave::_statusUpdateAcknowledgement);
+
+  // Acknowledge both updates with a single batched call.
+  {
+    Call call;
+    call.mutable_framework_id()->CopyFrom(frameworkId);
+    call.set_type(Call::ACKNOWLEDGE_BATCH);
+
+    vector<v1::TaskStatus> statuses{update1->status(), update2->status()};
+
+    foreach (const v1::TaskStatus& status, statuses) {
+      Call::Acknowledge* acknowledge =
+        call.mutable_acknowledge_batch()->add_acknowledgements();
+
+      acknowledge->mutable_task_id()->CopyFrom(status.task_id());
+      acknowledge->mutable_agent_id()->CopyFrom(offer.agent_id());
+      acknowledge->set_uuid(status.uuid());
+    }
+
+    mesos.send(call);
+  }
+
+  AWAIT_READY(batched);
+  ASSERT_EQ(2, batched->acknowledgements_size());
+
+  // The acknowledgements are forwarded in the order they appeared in
+  // the batched call.
+  EXPECT_EQ("1", batched->acknowledgements(0).task_id().value());
+  EXPECT_EQ(update1->status().uuid(), batched->acknowledgements(0).uuid());
+  EXPECT_EQ("2", batched->acknowledgements(1).task_id().value());
+  EXPECT_EQ(update2->status().uuid(), batched->acknowledgements(1).uuid());
+
+  // The agent fans the batch out to its task status update manager.
+  AWAIT_READY(_statusUpdateAcknowledgement1);
+  AWAIT_READY(_statusUpdateAcknowledgement2);
+
+  EXPECT_CALL(exec, shutdown(_))
+    .Times(AtMost(1));
+}
+
+
 // This test checks that domain information is correctly returned by
 // the master's HTTP endpoints.
 TEST_F(MasterTest, DomainEndpoints)
@@ -4817,6 +4959,264 @@ TEST_F(MasterTest, StateEndpoint)
 }
 
 
+// This test verifies the delta semantics of the 'since' parameter of
+// the "/state" endpoint: a client that presents the `state_version`
+// of its previous response receives a response that omits the agent
+// and framework sections that have not changed in between, while a
+// stale or foreign version yields a full response.
+TEST_F(MasterTest, StateEndpointSinceParameter)
+{
+  Try<Owned<cluster::Master>> master = StartMaster();
+  ASSERT_SOME(master);
+
+  auto getState = [&master](const Option<string>& since) -> Try<JSON::Object> {
+    string path = "state";
+    if (since.isSome()) {
+      path += "?since=" + since.get();
+    }
+
+    Future<Response> response = process::http::get(
+        master.get()->pid,
+        path,
+        None(),
+        createBasicAuthHeaders(DEFAULT_CREDENTIAL));
+
+    AWAIT_EXPECT_RESPONSE_STATUS_EQ(OK().status, response);
+
+    if (!response.isReady() || response->status != OK().status) {
+      return Error("Unexpected response");
+    }
+
+    return JSON::parse<JSON::Object>(response->body);
+  };
+
+  // A full response contains the agent and framework sections as
+  // well as the state version.
+  Try<JSON::Object> state = getState(None());
+  ASSERT_SOME(state);
+
+  EXPECT_EQ(1u, state->values.count("slaves"));
+  EXPECT_EQ(1u, state->values.count("recovered_slaves"));
+  EXPECT_EQ(1u, state->values.count("frameworks"));
+  EXPECT_EQ(1u, state->values.count("completed_frameworks"));
+
+  ASSERT_TRUE(state->values["state_version"].is<JSON::String>());
+
+  string version1 = state->values["state_version"].as<JSON::String>().value;
+
+  // Polling with the current version omits the agent and framework
+  // sections since nothing has changed, but still reports the
+  // version so that the client can continue polling.
+  state = getState(version1);
+  ASSERT_SOME(state);
+
+  EXPECT_EQ(0u, state->values.count("slaves"));
+  EXPECT_EQ(0u, state->values.count("recovered_slaves"));
+  EXPECT_EQ(0u, state->values.count("frameworks"));
+  EXPECT_EQ(0u, state->values.count("completed_frameworks"));
+
+  ASSERT_TRUE(state->values["state_version"].is<JSON::String>());
+  EXPECT_EQ(version1, state->values["state_version"].as<JSON::String>().value);
+
+  // Registering an agent invalidates the agent sections but not the
+  // framework sections.
+  Future<SlaveRegisteredMessage> slaveRegisteredMessage =
+    FUTURE_PROTOBUF(SlaveRegisteredMessage(), _, _);
+
+  Owned<MasterDetector> detector = master.get()->createDetector();
+
+  Try<Owned<cluster::Slave>> slave = StartSlave(detector.get());
+  ASSERT_SOME(slave);
+
+  AWAIT_READY(slaveRegisteredMessage);
+
+  state = getState(version1);
+  ASSERT_SOME(state);
+
+  ASSERT_TRUE(state->values["slaves"].is<JSON::Array>());
+  EXPECT_EQ(1u, state->values["slaves"].as<JSON::Array>().values.size());
+  EXPECT_EQ(0u, state->values.count("frameworks"));
+
+  ASSERT_TRUE(state->values["state_version"].is<JSON::String>());
+
+  string version2 = state->values["state_version"].as<JSON::String>().value;
+  EXPECT_NE(version1, version2);
+
+  // Registering a framework invalidates the framework sections but
+  // not the agent sections.
+  MockScheduler sched;
+  MesosSchedulerDriver driver(
+      &sched, DEFAULT_FRAMEWORK_INFO, master.get()->pid, DEFAULT_CREDENTIAL);
+
+  Future<Nothing> registered;
+  EXPECT_CALL(sched, registered(&driver, _, _))
+    .WillOnce(FutureSatisfy(&registered));
+
+  EXPECT_CALL(sched, resourceOffers(&driver, _))
+    .WillRepeatedly(Return()); // Ignore offers.
+
+  driver.start();
+
+  AWAIT_READY(registered);
+
+  state = getState(version2);
+  ASSERT_SOME(state);
+
+  ASSERT_TRUE(state->values["frameworks"].is<JSON::Array>());
+  EXPECT_EQ(1u, state->values["frameworks"].as<JSON::Array>().values.size());
+  EXPECT_EQ(0u, state->values.count("slaves"));
+
+  // A version from a different master incarnation never matches, so
+  // the client receives a full response.
+  state = getState(string("1-2-3"));
+  ASSERT_SOME(state);
+
+  EXPECT_EQ(1u, state->values.count("slaves"));
+  EXPECT_EQ(1u, state->values.count("frameworks"));
+
+  // Malformed versions are rejected.
+  foreach (const string& since, vector<string>({"foo", "1-2", "1-2-3-4"})) {
+    Future<Response> response = process::http::get(
+        master.get()->pid,
+        "state?since=" + since,
+        None(),
+        createBasicAuthHeaders(DEFAULT_CREDENTIAL));
+
+    AWAIT_EXPECT_RESPONSE_STATUS_EQ(BadRequest().status, response);
+  }
+
+  driver.stop();
+  driver.join();
+}
+
+
+// This test ensures that the 'since' delta logic observes task state
+// changes on a master without any operator API event subscribers: the
+// state versions must move with the mutations themselves, not as a
+// side effect of sending events.
+TEST_F(MasterTest, StateEndpointSinceParameterWithoutSubscribers)
+{
+  Clock::pause();
+
+  master::Flags masterFlags = CreateMasterFlags();
+  Try<Owned<cluster::Master>> master = StartMaster(masterFlags);
+  ASSERT_SOME(master);
+
+  MockExecutor exec(DEFAULT_EXECUTOR_ID);
+  TestContainerizer containerizer(&exec);
+
+  Future<SlaveRegisteredMessage> slaveRegisteredMessage =
+    FUTURE_PROTOBUF(SlaveRegisteredMessage(), _, _);
+
+  slave::Flags agentFlags = CreateSlaveFlags();
+  Owned<MasterDetector> detector = master.get()->createDetector();
+  Try<Owned<cluster::Slave>> slave =
+    StartSlave(detector.get(), &containerizer, agentFlags);
+  ASSERT_SOME(slave);
+
+  Clock::advance(agentFlags.registration_backoff_factor);
+  Clock::advance(agentFlags.authentication_backoff_factor);
+  AWAIT_READY(slaveRegisteredMessage);
+
+  MockScheduler sched;
+  MesosSchedulerDriver driver(
+      &sched, DEFAULT_FRAMEWORK_INFO, master.get()->pid, DEFAULT_CREDENTIAL);
+
+  EXPECT_CALL(sched, registered(&driver, _, _));
+
+  Future<vector<Offer>> offers;
+  EXPECT_CALL(sched, resourceOffers(&driver, _))
+    .WillOnce(FutureArg<1>(&offers))
+    .WillRepeatedly(Return()); // Ignore subsequent offers.
+
+  driver.start();
+
+  Clock::advance(masterFlags.allocation_interval);
+  AWAIT_READY(offers);
+  ASSERT_FALSE(offers->empty());
+
+  TaskInfo task;
+  task.set_name("");
+  task.mutable_task_id()->set_value("1");
+  task.mutable_slave_id()->MergeFrom(offers.get()[0].slave_id());
+  task.mutable_resources()->MergeFrom(offers.get()[0].resources());
+  task.mutable_executor()->MergeFrom(DEFAULT_EXECUTOR_INFO);
+
+  EXPECT_CALL(exec, registered(_, _, _, _));
+
+  EXPECT_CALL(exec, launchTask(_, _))
+    .WillOnce(SendStatusUpdateFromTask(TASK_RUNNING));
+
+  Future<TaskStatus> runningStatus;
+  Future<TaskStatus> killedStatus;
+  EXPECT_CALL(sched, statusUpdate(&driver, _))
+    .WillOnce(FutureArg<1>(&runningStatus))
+    .WillOnce(FutureArg<1>(&killedStatus));
+
+  driver.launchTasks(offers.get()[0].id(), {task});
+
+  AWAIT_READY(runningStatus);
+  EXPECT_EQ(TASK_RUNNING, runningStatus->state());
+
+  Clock::settle();
+
+  auto getState = [&master](const Option<string>& since) -> Try<JSON::Object> {
+    string path = "state";
+    if (since.isSome()) {
+      path += "?since=" + since.get();
+    }
+
+    Future<Response> response = process::http::get(
+        master.get()->pid,
+        path,
+        None(),
+        createBasicAuthHeaders(DEFAULT_CREDENTIAL));
+
+    AWAIT_EXPECT_RESPONSE_STATUS_EQ(OK().status, response);
+
+    if (!response.isReady() || response->status != OK().status) {
+      return Error("Unexpected response");
+    }
+
+    return JSON::parse<JSON::Object>(response->body);
+  };
+
+  Try<JSON::Object> state = getState(None());
+  ASSERT_SOME(state);
+
+  ASSERT_TRUE(state->values["state_version"].is<JSON::String>());
+
+  string version1 = state->values["state_version"].as<JSON::String>().value;
+
+  // Note that there are no operator API event subscribers: killing
+  // the task must nonetheless invalidate the framework sections.
+  EXPECT_CALL(exec, killTask(_, _))
+    .WillOnce(SendStatusUpdateFromTaskID(TASK_KILLED));
+
+  driver.killTask(task.task_id());
+
+  AWAIT_READY(killedStatus);
+  EXPECT_EQ(TASK_KILLED, killedStatus->state());
+
+  Clock::settle();
+
+  state = getState(version1);
+  ASSERT_SOME(state);
+
+  ASSERT_TRUE(state->values["frameworks"].is<JSON::Array>());
+  EXPECT_EQ(0u, state->values.count("slaves"));
+
+  ASSERT_TRUE(state->values["state_version"].is<JSON::String>());
+  EXPECT_NE(version1, state->values["state_version"].as<JSON::String>().value);
+
+  EXPECT_CALL(exec, shutdown(_))
+    .Times(AtMost(1));
+
+  driver.stop();
+  driver.join();
+}
+
+
 // This test ensures that the framework's information is included in
 // the master's state endpoint.
 //
@@ -6527,7 +6927,272 @@ TEST_F(MasterTest, FrameworksEndpointMultipleFrameworks)
 }
 
 
-// Test the max_completed_frameworks flag for master.
+// This test verifies that with `--completed_archive_dir` set, a
+// framework (and its completed tasks) that has been evicted from the
+// in-memory cache of completed frameworks is archived on disk and is
+// served by the '/frameworks' endpoint when queried by framework ID,
+// including after a master restart.
+TEST_F(MasterTest, CompletedFrameworkArchive)
+{
+  Clock::pause();
+
+  master::Flags masterFlags = CreateMasterFlags();
+  masterFlags.completed_archive_dir = path::join(os::getcwd(), "archive");
+
+  // Disable the in-memory cache of completed frameworks so that the
+  // framework is only available through the on-disk archive.
+  masterFlags.max_completed_frameworks = 0;
+
+  Try<Owned<cluster::Master>> master = StartMaster(masterFlags);
+  ASSERT_SOME(master);
+
+  MockExecutor exec(DEFAULT_EXECUTOR_ID);
+  TestContainerizer containerizer(&exec);
+  EXPECT_CALL(exec, registered(_, _, _, _));
+
+  Future<SlaveRegisteredMessage> slaveRegisteredMessage =
+    FUTURE_PROTOBUF(SlaveRegisteredMessage(), _, _);
+
+  Owned<MasterDetector> detector = master.get()->createDetector();
+  slave::Flags agentFlags = CreateSlaveFlags();
+  Try<Owned<cluster::Slave>> slave =
+    StartSlave(detector.get(), &containerizer, agentFlags);
+  ASSERT_SOME(slave);
+
+  Clock::advance(agentFlags.registration_backoff_factor);
+  AWAIT_READY(slaveRegisteredMessage);
+
+  MockScheduler sched;
+  MesosSchedulerDriver driver(
+      &sched, DEFAULT_FRAMEWORK_INFO, master.get()->pid, DEFAULT_CREDENTIAL);
+
+  Future<FrameworkID> frameworkId;
+  EXPECT_CALL(sched, registered(_, _, _))
+    .WillOnce(FutureArg<1>(&frameworkId));
+
+  process::Queue<Offer> offers;
+  EXPECT_CALL(sched, resourceOffers(_, _))
+    .WillRepeatedly(EnqueueOffers(&offers));
+
+  driver.start();
+
+  AWAIT_READY(frameworkId);
+
+  // Trigger a batch allocation.
+  Clock::advance(masterFlags.allocation_interval);
+
+  Future<Offer> offer = offers.get();
+  AWAIT_READY(offer);
+
+  TaskInfo task;
+  task.set_name("");
+  task.mutable_task_id()->set_value("archived");
+  task.mutable_slave_id()->MergeFrom(offer->slave_id());
+  task.mutable_resources()->MergeFrom(offer->resources());
+  task.mutable_executor()->MergeFrom(DEFAULT_EXECUTOR_INFO);
+
+  Future<TaskStatus> statusFinished;
+  EXPECT_CALL(exec, launchTask(_, _))
+    .WillOnce(SendStatusUpdateFromTask(TASK_FINISHED));
+  EXPECT_CALL(sched, statusUpdate(_, _))
+    .WillOnce(FutureArg<1>(&statusFinished));
+
+  // The master moves the terminal task into the framework's list of
+  // completed tasks when the acknowledgement is processed; wait for
+  // the acknowledgement to be forwarded to the agent to ensure the
+  // task is completed before the framework is torn down.
+  Future<StatusUpdateAcknowledgementMessage> acknowledgement =
+    FUTURE_PROTOBUF(StatusUpdateAcknowledgementMessage(), _, _);
+
+  driver.launchTasks(offer->id(), {task});
+
+  AWAIT_READY(statusFinished);
+  EXPECT_EQ(TASK_FINISHED, statusFinished->state());
+
+  AWAIT_READY(acknowledgement);
+
+  EXPECT_CALL(exec, shutdown(_))
+    .Times(AtMost(1));
+
+  Future<ShutdownFrameworkMessage> shutdownFrameworkMessage =
+    FUTURE_PROTOBUF(ShutdownFrameworkMessage(), _, _);
+
+  driver.stop();
+  driver.join();
+
+  AWAIT_READY(shutdownFrameworkMessage);
+
+  // An unqualified request never consults the archive, and the
+  // framework is no longer held in memory.
+  {
+    Future<Response> response = process::http::get(
+        master.get()->pid,
+        "frameworks",
+        None(),
+        createBasicAuthHeaders(DEFAULT_CREDENTIAL));
+
+    AWAIT_EXPECT_RESPONSE_STATUS_EQ(OK().status, response);
+
+    Try<JSON::Object> parse = JSON::parse<JSON::Object>(response->body);
+    ASSERT_SOME(parse);
+
+    Result<JSON::Array> completedFrameworks =
+      parse->find<JSON::Array>("completed_frameworks");
+
+    ASSERT_SOME(completedFrameworks);
+    EXPECT_TRUE(completedFrameworks->values.empty());
+  }
+
+  // Querying by framework ID serves the framework and its completed
+  // tasks from the archive.
+  auto expectArchivedFramework = [&frameworkId](const Owned<cluster::Master>&
+                                                    master) {
+    Future<Response> response = process::http::get(
+        master->pid,
+        "frameworks?framework_id=" + frameworkId->value(),
+        None(),
+        createBasicAuthHeaders(DEFAULT_CREDENTIAL));
+
+    AWAIT_EXPECT_RESPONSE_STATUS_EQ(OK().status, response);
+
+    Try<JSON::Object> parse = JSON::parse<JSON::Object>(response->body);
+    ASSERT_SOME(parse);
+
+    Result<JSON::Array> completedFrameworks =
+      parse->find<JSON::Array>("completed_frameworks");
+
+    ASSERT_SOME(completedFrameworks);
+    ASSERT_EQ(1u, completedFrameworks->values.size());
+
+    JSON::Object framework =
+      completedFrameworks->values[0].as<JSON::Object>();
+
+    EXPECT_EQ(frameworkId->value(), framework.values["id"]);
+    EXPECT_EQ("default", framework.values["name"]);
+
+    Result<JSON::Array> tasks = framework.find<JSON::Array>("tasks");
+
+    ASSERT_SOME(tasks);
+    ASSERT_EQ(1u, tasks->values.size());
+    EXPECT_EQ("archived", tasks->values[0].as<JSON::Object>().values["id"]);
+  };
+
+  expectArchivedFramework(master.get());
+
+  // The archive outlives the master: restart it with the same archive
+  // directory and expect the framework to still be served.
+  slave.get()->terminate();
+  slave->reset();
+
+  master->reset();
+
+  master = StartMaster(masterFlags);
+  ASSERT_SOME(master);
+
+  expectArchivedFramework(master.get());
+}
+
+
+// This test verifies that corrupt or truncated records in the on-disk
+// archive of completed frameworks are skipped: a well-formed record
+// is still served by the '/frameworks' endpoint when it is followed
+// by a record with an unparsable payload and a partially written
+// record.
+TEST_F(MasterTest, CompletedFrameworkArchiveCorruptRecords)
+{
+  const string archiveDir = path::join(os::getcwd(), "archive");
+  ASSERT_SOME(os::mkdir(archiveDir));
+
+  FrameworkInfo frameworkInfo = DEFAULT_FRAMEWORK_INFO;
+  frameworkInfo.mutable_id()->set_value("archived-framework");
+
+  Archive::Framework record;
+  record.mutable_framework_info()->CopyFrom(frameworkInfo);
+
+  Task* task = record.add_tasks();
+  task->set_name("");
+  task->mutable_task_id()->set_value("archived");
+  task->mutable_framework_id()->CopyFrom(frameworkInfo.id());
+  task->mutable_slave_id()->set_value("agent");
+  task->set_state(TASK_FINISHED);
+
+  ::recordio::Encoder<Archive::Framework> encoder(
+      [](const Archive::Framework& record) {
+        return record.SerializeAsString();
+      });
+
+  // A well-formed record, followed by a record whose payload is not a
+  // parsable `Archive::Framework`, followed by a record whose length
+  // prefix promises more data than is present (e.g., the master died
+  // mid-write).
+  const string data =
+    encoder.encode(record) +
+    "7\ngarbage" +
+    "100\ntruncated";
+
+  ASSERT_SOME(
+      os::write(path::join(archiveDir, "completed.recordio"), data));
+
+  master::Flags masterFlags = CreateMasterFlags();
+  masterFlags.completed_archive_dir = archiveDir;
+
+  Try<Owned<cluster::Master>> master = StartMaster(masterFlags);
+  ASSERT_SOME(master);
+
+  // The well-formed record is served.
+  {
+    Future<Response> response = process::http::get(
+        master.get()->pid,
+        "frameworks?framework_id=archived-framework",
+        None(),
+        createBasicAuthHeaders(DEFAULT_CREDENTIAL));
+
+    AWAIT_EXPECT_RESPONSE_STATUS_EQ(OK().status, response);
+
+    Try<JSON::Object> parse = JSON::parse<JSON::Object>(response->body);
+    ASSERT_SOME(parse);
+
+    Result<JSON::Array> completedFrameworks =
+      parse->find<JSON::Array>("completed_frameworks");
+
+    ASSERT_SOME(completedFrameworks);
+    ASSERT_EQ(1u, completedFrameworks->values.size());
+
+    JSON::Object framework =
+      completedFrameworks->values[0].as<JSON::Object>();
+
+    EXPECT_EQ("archived-framework", framework.values["id"]);
+
+    Result<JSON::Array> tasks = framework.find<JSON::Array>("tasks");
+
+    ASSERT_SOME(tasks);
+    ASSERT_EQ(1u, tasks->values.size());
+    EXPECT_EQ("archived", tasks->values[0].as<JSON::Object>().values["id"]);
+  }
+
+  // The malformed records do not surface for any framework ID.
+  {
+    Future<Response> response = process::http::get(
+        master.get()->pid,
+        "frameworks?framework_id=unknown",
+        None(),
+        createBasicAuthHeaders(DEFAULT_CREDENTIAL));
+
+    AWAIT_EXPECT_RESPONSE_STATUS_EQ(OK().status, response);
+
+    Try<JSON::Object> parse = JSON::parse<JSON::Object>(response->body);
+    ASSERT_SOME(parse);
+
+    Result<JSON::Array> completedFrameworks =
+      parse->find<JSON::Array>("completed_frameworks");
+
+    ASSERT_SOME(completedFrameworks);
+    EXPECT_TRUE(completedFrameworks->values.empty());
+  }
+}
+
+
+// Test the max_completed_frameworks flag for master.
 TEST_F(MasterTest, MaxCompletedFrameworksFlag)
 {
   // In order to verify that the proper amount of history
@@ -6743,6 +7408,160 @@ TEST_F(MasterTest, MaxCompletedTasksPerFrameworkFlag)
 }
 
 
+// This test verifies that a framework with more tasks than
+// `TEARDOWN_BATCH_SIZE` is torn down incrementally: the remaining
+// backlog is exposed via the 'master/teardown_backlog' gauge,
+// resubscription is refused while the teardown is in progress, and
+// the framework is moved to the completed list once the backlog has
+// drained.
+TEST_F(MasterTest, TeardownFrameworkWithManyTasks)
+{
+  Clock::pause();
+
+  master::Flags masterFlags = CreateMasterFlags();
+
+  Try<Owned<cluster::Master>> master = StartMaster(masterFlags);
+  ASSERT_SOME(master);
+
+  const size_t totalTasks = master::TEARDOWN_BATCH_SIZE + 1;
+
+  Future<SlaveRegisteredMessage> slaveRegisteredMessage =
+    FUTURE_PROTOBUF(SlaveRegisteredMessage(), _, _);
+
+  Owned<MasterDetector> detector = master.get()->createDetector();
+  slave::Flags agentFlags = CreateSlaveFlags();
+  agentFlags.resources = "cpus:128;mem:65536";
+
+  Try<Owned<cluster::Slave>> slave = StartSlave(detector.get(), agentFlags);
+  ASSERT_SOME(slave);
+
+  Clock::advance(agentFlags.registration_backoff_factor);
+  AWAIT_READY(slaveRegisteredMessage);
+
+  MockScheduler sched;
+  MesosSchedulerDriver driver(
+      &sched, DEFAULT_FRAMEWORK_INFO, master.get()->pid, DEFAULT_CREDENTIAL);
+
+  Future<FrameworkID> frameworkId;
+  EXPECT_CALL(sched, registered(_, _, _))
+    .WillOnce(FutureArg<1>(&frameworkId));
+
+  process::Queue<Offer> offers;
+  EXPECT_CALL(sched, resourceOffers(_, _))
+    .WillRepeatedly(EnqueueOffers(&offers));
+
+  driver.start();
+
+  AWAIT_READY(frameworkId);
+
+  // Trigger a batch allocation.
+  Clock::advance(masterFlags.allocation_interval);
+
+  Future<Offer> offer = offers.get();
+  AWAIT_READY(offer);
+
+  // The tasks never need to reach the agent; drop the run messages
+  // so that launching this many tasks stays cheap.
+  DROP_PROTOBUFS(RunTaskMessage(), _, _);
+
+  Resources taskResources = Resources::parse("cpus:0.1;mem:32").get();
+
+  vector<TaskInfo> tasks;
+  tasks.reserve(totalTasks);
+
+  for (size_t i = 0; i < totalTasks; i++) {
+    TaskInfo task;
+    task.set_name("");
+    task.mutable_task_id()->set_value(stringify(i));
+    task.mutable_slave_id()->MergeFrom(offer->slave_id());
+    task.mutable_resources()->MergeFrom(taskResources);
+    task.mutable_command()->set_value("sleep 1000");
+
+    tasks.push_back(task);
+  }
+
+  driver.launchTasks(offer->id(), tasks);
+
+  Clock::settle();
+
+  JSON::Object metrics = Metrics();
+
+  EXPECT_EQ(
+      totalTasks,
+      metrics.values["master/tasks_staging"]
+        .as<JSON::Number>().as<size_t>());
+
+  // Drop the re-dispatch after the first batch of tasks has been
+  // removed, freezing the teardown in progress.
+  Future<Nothing> removeFramework =
+    DROP_DISPATCH(master.get()->pid, &Master::_removeFramework);
+
+  driver.stop();
+  driver.join();
+
+  AWAIT_READY(removeFramework);
+  Clock::settle();
+
+  // One task remains to be removed.
+  metrics = Metrics();
+
+  EXPECT_EQ(1, metrics.values["master/teardown_backlog"]);
+
+  // Resubscription is refused while the teardown is in progress.
+  FrameworkInfo frameworkInfo = DEFAULT_FRAMEWORK_INFO;
+  frameworkInfo.mutable_id()->CopyFrom(frameworkId.get());
+
+  MockScheduler sched2;
+  MesosSchedulerDriver driver2(
+      &sched2, frameworkInfo, master.get()->pid, DEFAULT_CREDENTIAL);
+
+  Future<string> error;
+  EXPECT_CALL(sched2, error(&driver2, _))
+    .WillOnce(FutureArg<1>(&error));
+
+  driver2.start();
+
+  AWAIT_READY(error);
+  EXPECT_EQ("Framework is currently being torn down", error.get());
+
+  driver2.stop();
+  driver2.join();
+
+  // Resume the teardown and let the backlog drain.
+  process::dispatch(
+      master.get()->pid, &Master::_removeFramework, frameworkId.get());
+
+  Clock::settle();
+
+  metrics = Metrics();
+
+  EXPECT_EQ(0, metrics.values["master/teardown_backlog"]);
+
+  // The framework has been moved to the completed list.
+  Future<Response> response = process::http::get(
+      master.get()->pid,
+      "frameworks",
+      None(),
+      createBasicAuthHeaders(DEFAULT_CREDENTIAL));
+
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(OK().status, response);
+
+  Try<JSON::Object> parse = JSON::parse<JSON::Object>(response->body);
+  ASSERT_SOME(parse);
+
+  Result<JSON::Array> completedFrameworks =
+    parse->find<JSON::Array>("completed_frameworks");
+
+  ASSERT_SOME(completedFrameworks);
+  ASSERT_EQ(1u, completedFrameworks->values.size());
+
+  EXPECT_EQ(
+      frameworkId->value(),
+      completedFrameworks->values[0]
+        .as<JSON::Object>().values["id"]);
+}
+
+
 // Test GET requests on various endpoints without authentication and
 // with bad credentials.
 // Note that we have similar checks for the maintenance, roles, quota, teardown,
@@ -0,0 +1,196 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/message_replay.hpp"
+
+#include <stdint.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <process/delay.hpp>
+#include <process/dispatch.hpp>
+#include <process/id.hpp>
+#include <process/process.hpp>
+
+#include <stout/check.hpp>
+#include <stout/error.hpp>
+#include <stout/stringify.hpp>
+
+using process::Future;
+using process::Promise;
+using process::UPID;
+
+using std::string;
+using std::vector;
+
+namespace mesos {
+namespace internal {
+namespace tests {
+namespace {
+
+template <typename T>
+bool read(std::ifstream& file, T* value)
+{
+  file.read(reinterpret_cast<char*>(value), sizeof(T));
+  return !file.fail();
+}
+
+
+bool read(std::ifstream& file, string* value)
+{
+  uint32_t size;
+  if (!read(file, &size)) {
+    return false;
+  }
+
+  value->resize(size);
+  file.read(&(*value)[0], size);
+  return !file.fail();
+}
+
+
+// Posts the messages of a trace one by one, honoring the recorded
+// inter-arrival times scaled by the replay speed.
+class MessageReplayProcess : public process::Process<MessageReplayProcess>
+{
+public:
+  MessageReplayProcess(
+      const vector<TracedMessage>& _messages,
+      const UPID& _pid,
+      double _speed)
+    : ProcessBase(process::ID::generate("message-replay")),
+      messages(_messages),
+      pid(_pid),
+      speed(_speed),
+      index(0) {}
+
+  Future<Nothing> replay()
+  {
+    if (messages.empty()) {
+      return Nothing();
+    }
+
+    post_();
+
+    return promise.future();
+  }
+
+private:
+  void post_()
+  {
+    while (index < messages.size()) {
+      const TracedMessage& message = messages[index++];
+
+      const string body(message.size, '\0');
+      process::post(message.from, pid, message.name, body.data(), body.size());
+
+      if (index >= messages.size()) {
+        promise.set(Nothing());
+        return;
+      }
+
+      if (speed > 0) {
+        const Duration gap = Nanoseconds(static_cast<int64_t>(
+            (messages[index].timestamp - message.timestamp).ns() / speed));
+
+        if (gap > Duration::zero()) {
+          process::delay(gap, self(), &Self::post_);
+          return;
+        }
+      }
+    }
+  }
+
+  const vector<TracedMessage> messages;
+  const UPID pid;
+  const double speed;
+
+  size_t index;
+  Promise<Nothing> promise;
+};
+
+} // namespace {
+
+
+Try<vector<TracedMessage>> readMessageTrace(const string& path)
+{
+  std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    return Error("Failed to open trace file '" + path + "'");
+  }
+
+  vector<TracedMessage> messages;
+
+  while (true) {
+    uint64_t timestamp;
+    if (!read(file, &timestamp)) {
+      // A clean end of file at a record boundary ends the trace.
+      break;
+    }
+
+    string name;
+    string from;
+    string to;
+    uint32_t size;
+
+    if (!read(file, &name) ||
+        !read(file, &from) ||
+        !read(file, &to) ||
+        !read(file, &size)) {
+      return Error(
+          "Truncated record #" + stringify(messages.size()) +
+          " in trace file '" + path + "'");
+    }
+
+    TracedMessage message;
+    message.timestamp = Nanoseconds(timestamp);
+    message.name = name;
+    message.from = UPID(from);
+    message.to = UPID(to);
+    message.size = size;
+
+    messages.push_back(message);
+  }
+
+  return messages;
+}
+
+
+Future<Nothing> replayMessageTrace(
+    const vector<TracedMessage>& messages,
+    const UPID& pid,
+    double speed)
+{
+  MessageReplayProcess* process =
+    new MessageReplayProcess(messages, pid, speed);
+
+  const UPID replayer = process::spawn(process, true);
+
+  Future<Nothing> replayed =
+    process::dispatch(process, &MessageReplayProcess::replay);
+
+  replayed.onAny([replayer]() {
+    process::terminate(replayer);
+  });
+
+  return replayed;
+}
+
+} // namespace tests {
+} // namespace internal {
+} // namespace mesos {
@@ -0,0 +1,76 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __TESTS_MESSAGE_REPLAY_HPP__
+#define __TESTS_MESSAGE_REPLAY_HPP__
+
+#include <string>
+#include <vector>
+
+#include <process/future.hpp>
+#include <process/pid.hpp>
+
+#include <stout/duration.hpp>
+#include <stout/nothing.hpp>
+#include <stout/try.hpp>
+
+namespace mesos {
+namespace internal {
+namespace tests {
+
+// A single message from a libprocess message trace recorded by
+// running the traced binary with `LIBPROCESS_MESSAGE_TRACE` set (see
+// 3rdparty/libprocess/src/process.cpp for the trace format).
+struct TracedMessage
+{
+  // Nanoseconds since the epoch at recording time.
+  Duration timestamp;
+
+  std::string name;
+  process::UPID from;
+  process::UPID to;
+
+  // Size of the (elided) message body.
+  size_t size;
+};
+
+
+// Reads a recorded message trace from disk.
+Try<std::vector<TracedMessage>> readMessageTrace(const std::string& path);
+
+
+// Replays a recorded trace against the process with the given PID,
+// e.g. a master started via `tests/cluster.hpp`. Messages are posted
+// with their recorded names and source PIDs and a zero-filled body of
+// the recorded size, paced by the recorded inter-arrival times
+// divided by `speed` (i.e. `speed == 2.0` replays twice as fast,
+// `speed == 0` posts the whole trace without any pacing). The
+// returned future is satisfied once the last message was posted.
+//
+// NOTE: Since only message sizes are recorded, the replayed bodies do
+// not deserialize into valid protobufs. This exercises delivery,
+// queueing and dispatch costs against a recorded workload shape
+// rather than the handler logic itself.
+process::Future<Nothing> replayMessageTrace(
+    const std::vector<TracedMessage>& messages,
+    const process::UPID& pid,
+    double speed = 1.0);
+
+} // namespace tests {
+} // namespace internal {
+} // namespace mesos {
+
+#endif // __TESTS_MESSAGE_REPLAY_HPP__
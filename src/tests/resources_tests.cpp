@@ -4284,6 +4284,131 @@ TEST_P(Resources_Ranges_BENCHMARK_Test, ArithmeticOverlapping)
   printResult("a - b", watch.elapsed());
 }
 
+
+class Resources_Reservation_BENCHMARK_Test
+  : public MesosTest,
+    public ::testing::WithParamInterface<size_t> {};
+
+
+// We parameterize on the number of distinct resource objects since
+// reservation push/pop copies and re-adds every object.
+INSTANTIATE_TEST_CASE_P(
+    ResourcesReservationSizes,
+    Resources_Reservation_BENCHMARK_Test,
+    ::testing::Values(10U, 100U, 1000U));
+
+
+// This test benchmarks the performance of pushing a labeled dynamic
+// reservation onto a vector of resource objects and popping it off
+// again.
+TEST_P(Resources_Reservation_BENCHMARK_Test, PushPopReservation)
+{
+  const size_t resourcesCount = GetParam();
+  const size_t totalOperations = 100000 / resourcesCount;
+
+  // Name the resources distinctly so that the `Resources`
+  // holds `resourcesCount` separate resource objects.
+  vector<string> rawResources;
+  for (size_t i = 0; i < resourcesCount; i++) {
+    rawResources.push_back("res" + stringify(i) + ":" + stringify(i + 1));
+  }
+
+  Resources unreserved =
+    Resources::parse(strings::join(";", rawResources)).get();
+
+  Labels labels;
+  Label* label = labels.add_labels();
+  label->set_key("key");
+  label->set_value("value");
+
+  Resource::ReservationInfo reservation =
+    createDynamicReservationInfo("role", "principal", labels);
+
+  Resources reserved;
+  Stopwatch watch;
+
+  watch.start();
+  for (size_t i = 0; i < totalOperations; i++) {
+    reserved = unreserved.pushReservation(reservation);
+  }
+  watch.stop();
+
+  cout << "Took " << watch.elapsed()
+       << " to perform " << totalOperations << " 'pushReservation' operations"
+       << " on " << resourcesCount << " resource objects" << endl;
+
+  watch.start();
+  for (size_t i = 0; i < totalOperations; i++) {
+    unreserved = reserved.popReservation();
+  }
+  watch.stop();
+
+  cout << "Took " << watch.elapsed()
+       << " to perform " << totalOperations << " 'popReservation' operations"
+       << " on " << resourcesCount << " resource objects" << endl;
+}
+
+
+class Resources_Apply_BENCHMARK_Test
+  : public MesosTest,
+    public ::testing::WithParamInterface<size_t> {};
+
+
+INSTANTIATE_TEST_CASE_P(
+    ResourcesApplySizes,
+    Resources_Apply_BENCHMARK_Test,
+    ::testing::Values(10U, 100U, 1000U));
+
+
+// This test benchmarks applying RESERVE and UNRESERVE operations,
+// which is what the master does when processing offer operations.
+TEST_P(Resources_Apply_BENCHMARK_Test, ReserveAndUnreserve)
+{
+  const size_t resourcesCount = GetParam();
+  const size_t totalOperations = 10000 / resourcesCount;
+
+  // Name the resources distinctly so that the `Resources`
+  // holds `resourcesCount` separate resource objects.
+  vector<string> rawResources;
+  for (size_t i = 0; i < resourcesCount; i++) {
+    rawResources.push_back("res" + stringify(i) + ":" + stringify(i + 1));
+  }
+
+  Resources unreserved =
+    Resources::parse(strings::join(";", rawResources)).get();
+
+  Resources reserved = unreserved.pushReservation(
+      createDynamicReservationInfo("role", "principal"));
+
+  Offer::Operation reserve = RESERVE(reserved);
+  Offer::Operation unreserve = UNRESERVE(reserved);
+
+  ASSERT_SOME_EQ(reserved, unreserved.apply(reserve));
+  ASSERT_SOME_EQ(unreserved, reserved.apply(unreserve));
+
+  Stopwatch watch;
+
+  watch.start();
+  for (size_t i = 0; i < totalOperations; i++) {
+    unreserved.apply(reserve);
+  }
+  watch.stop();
+
+  cout << "Took " << watch.elapsed()
+       << " to apply " << totalOperations << " 'RESERVE' operations"
+       << " on " << resourcesCount << " resource objects" << endl;
+
+  watch.start();
+  for (size_t i = 0; i < totalOperations; i++) {
+    reserved.apply(unreserve);
+  }
+  watch.stop();
+
+  cout << "Took " << watch.elapsed()
+       << " to apply " << totalOperations << " 'UNRESERVE' operations"
+       << " on " << resourcesCount << " resource objects" << endl;
+}
+
 } // namespace tests {
 } // namespace internal {
 } // namespace mesos {
@@ -32,6 +32,8 @@
 #include <process/future.hpp>
 #include <process/gmock.hpp>
 #include <process/gtest.hpp>
+#include <process/http.hpp>
+#include <process/id.hpp>
 #include <process/owned.hpp>
 #include <process/pid.hpp>
 #include <process/queue.hpp>
@@ -40,7 +42,11 @@
 
 #include <stout/hashset.hpp>
 #include <stout/lambda.hpp>
+#include <stout/recordio.hpp>
 #include <stout/try.hpp>
+#include <stout/uuid.hpp>
+
+#include "common/http.hpp"
 
 #include "internal/devolve.hpp"
 #include "internal/evolve.hpp"
@@ -555,6 +561,399 @@ TEST_P(SchedulerTest, TaskRunning)
 }
 
 
+// This test verifies that an ACKNOWLEDGE_BATCH call is semantically
+// equivalent to a sequence of ACKNOWLEDGE calls: the master fans the
+// batched acknowledgements out to the agent.
+TEST_P(SchedulerTest, AcknowledgeBatch)
+{
+  Try<Owned<cluster::Master>> master = StartMaster();
+  ASSERT_SOME(master);
+
+  auto scheduler = std::make_shared<v1::MockHTTPScheduler>();
+  auto executor = std::make_shared<v1::MockHTTPExecutor>();
+
+  ExecutorID executorId = DEFAULT_EXECUTOR_ID;
+  TestContainerizer containerizer(executorId, executor);
+
+  Owned<MasterDetector> detector = master.get()->createDetector();
+  Try<Owned<cluster::Slave>> slave = StartSlave(detector.get(), &containerizer);
+  ASSERT_SOME(slave);
+
+  Future<Nothing> connected;
+  EXPECT_CALL(*scheduler, connected(_))
+    .WillOnce(FutureSatisfy(&connected));
+
+  ContentType contentType = GetParam();
+
+  v1::scheduler::TestMesos mesos(
+      master.get()->pid,
+      contentType,
+      scheduler);
+
+  AWAIT_READY(connected);
+
+  Future<Event::Subscribed> subscribed;
+  EXPECT_CALL(*scheduler, subscribed(_, _))
+    .WillOnce(FutureArg<1>(&subscribed));
+
+  EXPECT_CALL(*scheduler, heartbeat(_))
+    .WillRepeatedly(Return()); // Ignore heartbeats.
+
+  Future<Event::Offers> offers;
+  EXPECT_CALL(*scheduler, offers(_, _))
+    .WillOnce(FutureArg<1>(&offers));
+
+  {
+    Call call;
+    call.set_type(Call::SUBSCRIBE);
+
+    Call::Subscribe* subscribe = call.mutable_subscribe();
+    subscribe->mutable_framework_info()->CopyFrom(v1::DEFAULT_FRAMEWORK_INFO);
+
+    mesos.send(call);
+  }
+
+  AWAIT_READY(subscribed);
+
+  v1::FrameworkID frameworkId(subscribed->framework_id());
+
+  AWAIT_READY(offers);
+  ASSERT_FALSE(offers->offers().empty());
+
+  EXPECT_CALL(*executor, connected(_))
+    .WillOnce(v1::executor::SendSubscribe(frameworkId, evolve(executorId)));
+
+  EXPECT_CALL(*executor, subscribed(_, _));
+
+  // Each task is reported running as soon as it is launched.
+  EXPECT_CALL(*executor, launch(_, _))
+    .WillOnce(v1::executor::SendUpdateFromTask(
+        frameworkId, evolve(executorId), v1::TASK_RUNNING))
+    .WillOnce(v1::executor::SendUpdateFromTask(
+        frameworkId, evolve(executorId), v1::TASK_RUNNING));
+
+  EXPECT_CALL(*executor, acknowledged(_, _))
+    .Times(2);
+
+  EXPECT_CALL(containerizer, update(_, _))
+    .WillRepeatedly(Return(Nothing()));
+
+  Future<Event::Update> update1;
+  Future<Event::Update> update2;
+  EXPECT_CALL(*scheduler, update(_, _))
+    .WillOnce(FutureArg<1>(&update1))
+    .WillOnce(FutureArg<1>(&update2));
+
+  v1::Resources resources =
+    v1::Resources::parse("cpus:0.1;mem:32;disk:32").get();
+
+  v1::TaskInfo task1;
+  task1.set_name("");
+  task1.mutable_task_id()->set_value("1");
+  task1.mutable_agent_id()->CopyFrom(offers->offers(0).agent_id());
+  task1.mutable_resources()->CopyFrom(resources);
+  task1.mutable_executor()->CopyFrom(v1::DEFAULT_EXECUTOR_INFO);
+
+  v1::TaskInfo task2 = task1;
+  task2.mutable_task_id()->set_value("2");
+
+  {
+    Call call;
+    call.mutable_framework_id()->CopyFrom(frameworkId);
+    call.set_type(Call::ACCEPT);
+
+    Call::Accept* accept = call.mutable_accept();
+    accept->add_offer_ids()->CopyFrom(offers->offers(0).id());
+
+    v1::Offer::Operation* operation = accept->add_operations();
+    operation->set_type(v1::Offer::Operation::LAUNCH);
+    operation->mutable_launch()->add_task_infos()->CopyFrom(task1);
+    operation->mutable_launch()->add_task_infos()->CopyFrom(task2);
+
+    mesos.send(call);
+  }
+
+  AWAIT_READY(update1);
+  AWAIT_READY(update2);
+
+  EXPECT_EQ(v1::TASK_RUNNING, update1->status().state());
+  EXPECT_EQ(v1::TASK_RUNNING, update2->status().state());
+
+  // The master coalesces the acknowledgements destined for the agent
+  // into a single batch message.
+  Future<BatchedStatusUpdateAcknowledgementsMessage> acknowledgements =
+    FUTURE_PROTOBUF(
+        BatchedStatusUpdateAcknowledgementsMessage(),
+        master.get()->pid,
+        slave.get()->pid);
+
+  // Acknowledge both updates with a single batched call.
+  {
+    Call call;
+    call.mutable_framework_id()->CopyFrom(frameworkId);
+    call.set_type(Call::ACKNOWLEDGE_BATCH);
+
+    vector<v1::TaskStatus> statuses{update1->status(), update2->status()};
+
+    foreach (const v1::TaskStatus& status, statuses) {
+      Call::Acknowledge* acknowledge =
+        call.mutable_acknowledge_batch()->add_acknowledgements();
+
+      acknowledge->mutable_task_id()->CopyFrom(status.task_id());
+      acknowledge->mutable_agent_id()->CopyFrom(offers->offers(0).agent_id());
+      acknowledge->set_uuid(status.uuid());
+    }
+
+    mesos.send(call);
+  }
+
+  AWAIT_READY(acknowledgements);
+
+  // Both batched acknowledgements were forwarded to the agent.
+  ASSERT_EQ(2, acknowledgements->acknowledgements_size());
+
+  const hashset<string> expected{update1->status().uuid(),
+                                 update2->status().uuid()};
+
+  EXPECT_EQ(
+      expected,
+      hashset<string>({acknowledgements->acknowledgements(0).uuid(),
+                       acknowledgements->acknowledgements(1).uuid()}));
+
+  EXPECT_CALL(*executor, shutdown(_))
+    .Times(AtMost(1));
+
+  EXPECT_CALL(*executor, disconnected(_))
+    .Times(AtMost(1));
+}
+
+
+// This test verifies that the scheduler library sends acknowledgements
+// queued up behind an in-flight acknowledgement request as a single
+// ACKNOWLEDGE_BATCH call.
+TEST_P(SchedulerTest, AcknowledgementBatching)
+{
+  Try<Owned<cluster::Master>> master = StartMaster();
+  ASSERT_SOME(master);
+
+  auto scheduler = std::make_shared<v1::MockHTTPScheduler>();
+
+  Future<Nothing> connected;
+  EXPECT_CALL(*scheduler, connected(_))
+    .WillOnce(FutureSatisfy(&connected));
+
+  ContentType contentType = GetParam();
+
+  v1::scheduler::TestMesos mesos(
+      master.get()->pid,
+      contentType,
+      scheduler);
+
+  AWAIT_READY(connected);
+
+  Future<Event::Subscribed> subscribed;
+  EXPECT_CALL(*scheduler, subscribed(_, _))
+    .WillOnce(FutureArg<1>(&subscribed));
+
+  EXPECT_CALL(*scheduler, heartbeat(_))
+    .WillRepeatedly(Return()); // Ignore heartbeats.
+
+  {
+    Call call;
+    call.set_type(Call::SUBSCRIBE);
+
+    Call::Subscribe* subscribe = call.mutable_subscribe();
+    subscribe->mutable_framework_info()->CopyFrom(v1::DEFAULT_FRAMEWORK_INFO);
+
+    mesos.send(call);
+  }
+
+  AWAIT_READY(subscribed);
+
+  v1::FrameworkID frameworkId(subscribed->framework_id());
+
+  Future<Call> acknowledgeCall =
+    FUTURE_HTTP_CALL(Call(), Call::ACKNOWLEDGE, _, contentType);
+
+  Future<Call> batchCall =
+    FUTURE_HTTP_CALL(Call(), Call::ACKNOWLEDGE_BATCH, _, contentType);
+
+  // Send three acknowledgements back to back: the first is sent
+  // immediately, the other two queue behind the in-flight request
+  // and are flushed as a single batch once it completes. The master
+  // drops the acknowledgements since the agent is unknown to it,
+  // which is of no consequence here.
+  for (int i = 0; i < 3; i++) {
+    Call call;
+    call.mutable_framework_id()->CopyFrom(frameworkId);
+    call.set_type(Call::ACKNOWLEDGE);
+
+    Call::Acknowledge* acknowledge = call.mutable_acknowledge();
+    acknowledge->mutable_task_id()->set_value(stringify(i));
+    acknowledge->mutable_agent_id()->set_value("agent");
+    acknowledge->set_uuid(id::UUID::random().toBytes());
+
+    mesos.send(call);
+  }
+
+  AWAIT_READY(acknowledgeCall);
+  EXPECT_EQ("0", acknowledgeCall->acknowledge().task_id().value());
+
+  AWAIT_READY(batchCall);
+  ASSERT_EQ(2, batchCall->acknowledge_batch().acknowledgements().size());
+  EXPECT_EQ(
+      "1",
+      batchCall->acknowledge_batch().acknowledgements(0).task_id().value());
+  EXPECT_EQ(
+      "2",
+      batchCall->acknowledge_batch().acknowledgements(1).task_id().value());
+}
+
+
+// Simulates a master that predates the ACKNOWLEDGE_BATCH call: it
+// subscribes the framework, accepts individual acknowledgements, and
+// fails an ACKNOWLEDGE_BATCH call with '400 Bad Request' like a
+// master that does not recognize the call type would.
+class OldMasterProcess : public process::Process<OldMasterProcess>
+{
+public:
+  explicit OldMasterProcess(ContentType _contentType)
+    : process::ProcessBase(process::ID::generate("old-master")),
+      contentType(_contentType) {}
+
+  MOCK_METHOD1(acknowledge, void(const Call::Acknowledge&));
+
+protected:
+  void initialize() override
+  {
+    route("/api/v1/scheduler", None(), &OldMasterProcess::api);
+  }
+
+private:
+  Future<process::http::Response> api(const process::http::Request& request)
+  {
+    Try<Call> call = deserialize<Call>(contentType, request.body);
+
+    if (call.isError()) {
+      return process::http::BadRequest(call.error());
+    }
+
+    switch (call->type()) {
+      case Call::SUBSCRIBE: {
+        process::http::Pipe pipe;
+
+        OK ok;
+        ok.headers["Content-Type"] = stringify(contentType);
+        ok.headers["Mesos-Stream-Id"] = id::UUID::random().toString();
+        ok.type = process::http::Response::PIPE;
+        ok.reader = pipe.reader();
+
+        Event event;
+        event.set_type(Event::SUBSCRIBED);
+        event.mutable_subscribed()->mutable_framework_id()->set_value(
+            "framework");
+
+        ::recordio::Encoder<Event> encoder(
+            lambda::bind(serialize, contentType, lambda::_1));
+
+        writer = pipe.writer();
+        writer->write(encoder.encode(event));
+
+        return ok;
+      }
+
+      case Call::ACKNOWLEDGE:
+        acknowledge(call->acknowledge());
+        return process::http::Accepted();
+
+      default:
+        // An old master does not recognize the ACKNOWLEDGE_BATCH
+        // type, so the call fails its validation.
+        return process::http::BadRequest("Expecting 'type' to be present");
+    }
+  }
+
+  const ContentType contentType;
+  Option<process::http::Pipe::Writer> writer; // Keeps the stream open.
+};
+
+
+// This test verifies that the scheduler library falls back to
+// sending acknowledgements individually when the master fails an
+// ACKNOWLEDGE_BATCH call because it predates it.
+TEST_P(SchedulerTest, AcknowledgementBatchingOldMaster)
+{
+  ContentType contentType = GetParam();
+
+  OldMasterProcess oldMaster(contentType);
+  process::spawn(oldMaster);
+
+  auto scheduler = std::make_shared<v1::MockHTTPScheduler>();
+
+  Future<Nothing> connected;
+  EXPECT_CALL(*scheduler, connected(_))
+    .WillOnce(FutureSatisfy(&connected));
+
+  v1::scheduler::TestMesos mesos(oldMaster.self(), contentType, scheduler);
+
+  AWAIT_READY(connected);
+
+  Future<Event::Subscribed> subscribed;
+  EXPECT_CALL(*scheduler, subscribed(_, _))
+    .WillOnce(FutureArg<1>(&subscribed));
+
+  {
+    Call call;
+    call.set_type(Call::SUBSCRIBE);
+
+    Call::Subscribe* subscribe = call.mutable_subscribe();
+    subscribe->mutable_framework_info()->CopyFrom(v1::DEFAULT_FRAMEWORK_INFO);
+
+    mesos.send(call);
+  }
+
+  AWAIT_READY(subscribed);
+
+  v1::FrameworkID frameworkId(subscribed->framework_id());
+
+  // The first acknowledgement goes out on its own; the two queued
+  // behind it form a batch, which the old master fails. The library
+  // then falls back to sending them individually.
+  Future<Call::Acknowledge> acknowledge1;
+  Future<Call::Acknowledge> acknowledge2;
+  Future<Call::Acknowledge> acknowledge3;
+  EXPECT_CALL(oldMaster, acknowledge(_))
+    .WillOnce(FutureArg<0>(&acknowledge1))
+    .WillOnce(FutureArg<0>(&acknowledge2))
+    .WillOnce(FutureArg<0>(&acknowledge3));
+
+  for (int i = 0; i < 3; i++) {
+    Call call;
+    call.mutable_framework_id()->CopyFrom(frameworkId);
+    call.set_type(Call::ACKNOWLEDGE);
+
+    Call::Acknowledge* acknowledge = call.mutable_acknowledge();
+    acknowledge->mutable_task_id()->set_value(stringify(i));
+    acknowledge->mutable_agent_id()->set_value("agent");
+    acknowledge->set_uuid(id::UUID::random().toBytes());
+
+    mesos.send(call);
+  }
+
+  AWAIT_READY(acknowledge1);
+  EXPECT_EQ("0", acknowledge1->task_id().value());
+
+  AWAIT_READY(acknowledge2);
+  EXPECT_EQ("1", acknowledge2->task_id().value());
+
+  AWAIT_READY(acknowledge3);
+  EXPECT_EQ("2", acknowledge3->task_id().value());
+
+  process::terminate(oldMaster);
+  process::wait(oldMaster);
+}
+
+
 // Ensures that a task group can be successfully launched
 // on the `DEFAULT` executor.
 TEST_P(SchedulerTest, TaskGroupRunning)
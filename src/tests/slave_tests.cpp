@@ -1311,6 +1311,7 @@ TEST_F(SlaveTest, MetricsInMetricsEndpoint)
 
   EXPECT_EQ(1u, snapshot.values.count("slave/recovery_errors"));
   EXPECT_EQ(1u, snapshot.values.count("slave/recovery_time_secs"));
+  EXPECT_EQ(1u, snapshot.values.count("slave/state_recovery_time_secs"));
 
   EXPECT_EQ(1u, snapshot.values.count("slave/frameworks_active"));
 
@@ -2720,6 +2721,11 @@ TEST_F(SlaveTest, ContainersEndpoint)
   AWAIT_READY(containerId1);
   AWAIT_READY(containerId2);
 
+  // Advance the clock past the usage cache window so that the second
+  // request triggers a fresh collection.
+  Clock::pause();
+  Clock::advance(slave::CONTAINER_USAGE_CACHE_WINDOW);
+
   // Will be called once during the second request.
   EXPECT_CALL(containerizer, usage(_))
     .WillOnce(Return(statistics1));
@@ -2768,6 +2774,8 @@ TEST_F(SlaveTest, ContainersEndpoint)
     EXPECT_TRUE(value->contains(expected.get()));
   }
 
+  Clock::resume();
+
   EXPECT_CALL(exec1, shutdown(_))
     .Times(AtMost(1));
   EXPECT_CALL(exec2, shutdown(_))
@@ -0,0 +1,327 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+
+#include <mesos/resources.hpp>
+
+#include <stout/foreach.hpp>
+#include <stout/stopwatch.hpp>
+#include <stout/stringify.hpp>
+
+#include "master/allocator/sorter/drf/sorter.hpp"
+
+#include "master/allocator/sorter/random/sorter.hpp"
+
+#include "tests/mesos.hpp"
+
+using mesos::internal::master::allocator::DRFSorter;
+using mesos::internal::master::allocator::RandomSorter;
+
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+namespace mesos {
+namespace internal {
+namespace tests {
+
+// These benchmarks sweep the sorter workload shapes observed in
+// production clusters: deep role hierarchies, large numbers of
+// inactive clients, activation churn and frequent weight updates.
+// They complement the ad-hoc BENCHMARK tests in sorter_tests.cpp,
+// which only cover flat hierarchies of active clients.
+//
+// NOTE: There is not a way to write a test that is *both* type and
+// value parameterized, so the benchmarks are typed and iterate over
+// the values specific to what they benchmark.
+template <typename T>
+class SorterBenchmark : public ::testing::Test
+{
+protected:
+  // Returns the role paths of the leaves of a tree of the given
+  // depth where every internal node has `branching` children,
+  // e.g. depth 2, branching 2: "0/0", "0/1", "1/0", "1/1".
+  static vector<string> makeLeafPaths(size_t depth, size_t branching)
+  {
+    vector<string> frontier = {""};
+
+    for (size_t level = 0; level < depth; level++) {
+      vector<string> next;
+      next.reserve(frontier.size() * branching);
+
+      foreach (const string& prefix, frontier) {
+        for (size_t i = 0; i < branching; i++) {
+          next.push_back(
+              prefix.empty() ? stringify(i) : prefix + "/" + stringify(i));
+        }
+      }
+
+      frontier = std::move(next);
+    }
+
+    return frontier;
+  }
+
+  // Adds `agentCount` agents to the sorter and returns their ids.
+  static vector<SlaveID> addAgents(T& sorter, size_t agentCount)
+  {
+    const Resources agentResources = Resources::parse(
+        "cpus:24;mem:4096;disk:4096").get();
+
+    vector<SlaveID> agents;
+    agents.reserve(agentCount);
+
+    for (size_t i = 0; i < agentCount; i++) {
+      SlaveID slaveId;
+      slaveId.set_value("agent" + stringify(i));
+
+      agents.push_back(slaveId);
+
+      sorter.add(slaveId, agentResources);
+    }
+
+    return agents;
+  }
+};
+
+
+typedef ::testing::Types<DRFSorter, RandomSorter> SorterTypes;
+TYPED_TEST_CASE(SorterBenchmark, SorterTypes);
+
+
+// This benchmark measures sorting a 5-level role hierarchy in which
+// only a fraction of the clients is active, as happens when many
+// frameworks are subscribed but most have their offers suppressed.
+TYPED_TEST(SorterBenchmark, BENCHMARK_DeepHierarchySort)
+{
+  const size_t treeDepth = 5;
+  const size_t branchingFactors[] = {4U, 5U, 6U};
+  const double activeFractions[] = {1.0, 0.25, 0.05};
+
+  const Resources allocated =
+    Resources::parse("cpus:16;mem:2048;disk:1024").get();
+
+  foreach (size_t branchingFactor, branchingFactors) {
+    foreach (double activeFraction, activeFractions) {
+      const vector<string> clients =
+        this->makeLeafPaths(treeDepth, branchingFactor);
+
+      const size_t activeCount =
+        static_cast<size_t>(clients.size() * activeFraction);
+
+      cout << "Using a depth " << treeDepth << ", branching factor "
+           << branchingFactor << " hierarchy: " << clients.size()
+           << " clients, " << activeCount << " active" << endl;
+
+      TypeParam sorter;
+      Stopwatch watch;
+
+      const vector<SlaveID> agents = this->addAgents(sorter, 1000);
+
+      watch.start();
+      {
+        foreach (const string& client, clients) {
+          sorter.add(client);
+        }
+      }
+      watch.stop();
+
+      cout << "Added " << clients.size() << " clients in "
+           << watch.elapsed() << endl;
+
+      watch.start();
+      {
+        for (size_t i = 0; i < activeCount; i++) {
+          sorter.activate(clients[i]);
+        }
+      }
+      watch.stop();
+
+      cout << "Activated " << activeCount << " clients in "
+           << watch.elapsed() << endl;
+
+      watch.start();
+      {
+        // Allocate resources to the active clients,
+        // round-robin through the agents.
+        for (size_t i = 0; i < activeCount; i++) {
+          sorter.allocated(clients[i], agents[i % agents.size()], allocated);
+        }
+      }
+      watch.stop();
+
+      cout << "Added allocations for " << activeCount << " clients in "
+           << watch.elapsed() << endl;
+
+      watch.start();
+      {
+        sorter.sort();
+      }
+      watch.stop();
+
+      cout << "Full sort of " << activeCount << " active clients took "
+           << watch.elapsed() << endl;
+
+      watch.start();
+      {
+        sorter.sort();
+      }
+      watch.stop();
+
+      cout << "No-op sort of " << activeCount << " active clients took "
+           << watch.elapsed() << endl;
+    }
+  }
+}
+
+
+// This benchmark measures the cost of activation churn: frameworks
+// suppressing and reviving offers force the sorter to repeatedly
+// deactivate and activate clients in between sorts.
+TYPED_TEST(SorterBenchmark, BENCHMARK_ActivationChurn)
+{
+  const size_t clientCounts[] = {1000U, 5000U, 10000U};
+  const size_t churnCounts[] = {100U, 1000U};
+
+  const Resources allocated =
+    Resources::parse("cpus:16;mem:2048;disk:1024").get();
+
+  foreach (size_t clientCount, clientCounts) {
+    foreach (size_t churnCount, churnCounts) {
+      cout << "Using " << clientCount << " clients and a churn of "
+           << churnCount << endl;
+
+      TypeParam sorter;
+      Stopwatch watch;
+
+      const vector<SlaveID> agents = this->addAgents(sorter, 1000);
+
+      vector<string> clients;
+      clients.reserve(clientCount);
+
+      for (size_t i = 0; i < clientCount; i++) {
+        const string client = stringify(i);
+
+        clients.push_back(client);
+
+        sorter.add(client);
+        sorter.activate(client);
+        sorter.allocated(client, agents[i % agents.size()], allocated);
+      }
+
+      // Populate the sorter's internal state.
+      sorter.sort();
+
+      watch.start();
+      {
+        for (size_t i = 0; i < churnCount; i++) {
+          sorter.deactivate(clients[i]);
+          sorter.activate(clients[i]);
+        }
+      }
+      watch.stop();
+
+      cout << "Deactivated and activated " << churnCount << " clients in "
+           << watch.elapsed() << endl;
+
+      watch.start();
+      {
+        sorter.sort();
+      }
+      watch.stop();
+
+      cout << "Sort of " << clientCount << " clients after churn took "
+           << watch.elapsed() << endl;
+    }
+  }
+}
+
+
+// This benchmark measures the cost of weight updates on a 5-level
+// hierarchy. Weights can be updated at any level of the hierarchy,
+// and each update potentially dirties the sort order of the subtree
+// below it.
+TYPED_TEST(SorterBenchmark, BENCHMARK_WeightUpdates)
+{
+  const size_t treeDepth = 5;
+  const size_t branchingFactor = 4;
+  const size_t updateCounts[] = {100U, 1000U};
+
+  const Resources allocated =
+    Resources::parse("cpus:16;mem:2048;disk:1024").get();
+
+  foreach (size_t updateCount, updateCounts) {
+    const vector<string> clients =
+      this->makeLeafPaths(treeDepth, branchingFactor);
+
+    cout << "Using a depth " << treeDepth << ", branching factor "
+         << branchingFactor << " hierarchy: " << clients.size()
+         << " clients, " << updateCount << " weight updates" << endl;
+
+    TypeParam sorter;
+    Stopwatch watch;
+
+    const vector<SlaveID> agents = this->addAgents(sorter, 1000);
+
+    for (size_t i = 0; i < clients.size(); i++) {
+      sorter.add(clients[i]);
+      sorter.activate(clients[i]);
+      sorter.allocated(clients[i], agents[i % agents.size()], allocated);
+    }
+
+    // Populate the sorter's internal state.
+    sorter.sort();
+
+    watch.start();
+    {
+      // Update weights across all levels of the hierarchy by walking
+      // up from a leaf to the root, round-robin through the leaves.
+      for (size_t i = 0; i < updateCount; i++) {
+        string path = clients[i % clients.size()];
+
+        while (!path.empty()) {
+          sorter.updateWeight(path, 1.0 + (i % 10));
+
+          size_t separator = path.find_last_of('/');
+          path = separator == string::npos ? "" : path.substr(0, separator);
+        }
+      }
+    }
+    watch.stop();
+
+    cout << "Applied " << updateCount << " weight update walks in "
+         << watch.elapsed() << endl;
+
+    watch.start();
+    {
+      sorter.sort();
+    }
+    watch.stop();
+
+    cout << "Sort of " << clients.size() << " clients after weight"
+         << " updates took " << watch.elapsed() << endl;
+  }
+}
+
+} // namespace tests {
+} // namespace internal {
+} // namespace mesos {
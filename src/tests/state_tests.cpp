@@ -17,6 +17,7 @@
 #include <list>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <gmock/gmock.h>
@@ -26,6 +27,7 @@
 
 #include <mesos/log/log.hpp>
 
+#include <mesos/state/cached.hpp>
 #include <mesos/state/in_memory.hpp>
 #include <mesos/state/leveldb.hpp>
 #include <mesos/state/log.hpp>
@@ -42,6 +44,7 @@
 #include <stout/option.hpp>
 #include <stout/os.hpp>
 #include <stout/try.hpp>
+#include <stout/uuid.hpp>
 
 #include <stout/tests/utils.hpp>
 
@@ -395,6 +398,195 @@ TEST_F(InMemoryStateTest, Names)
 }
 
 
+// Tests the default batched get/set implementations provided by the
+// Storage interface.
+TEST_F(InMemoryStateTest, Batch)
+{
+  vector<std::pair<mesos::internal::state::Entry, id::UUID>> entries;
+
+  for (size_t i = 0; i < 3; i++) {
+    mesos::internal::state::Entry entry;
+    entry.set_name("batch" + stringify(i));
+    entry.set_uuid(id::UUID::random().toBytes());
+    entry.set_value("value" + stringify(i));
+
+    // The expected UUID is irrelevant for entries that don't exist.
+    entries.push_back(std::make_pair(entry, id::UUID::random()));
+  }
+
+  AWAIT_EXPECT_TRUE(storage->set(entries));
+
+  vector<string> names;
+  names.push_back("batch0");
+  names.push_back("batch2");
+  names.push_back("missing");
+
+  Future<vector<Option<mesos::internal::state::Entry>>> gets =
+    storage->get(names);
+
+  AWAIT_READY(gets);
+
+  ASSERT_EQ(3u, gets->size());
+  ASSERT_SOME(gets->at(0));
+  EXPECT_EQ("value0", gets->at(0)->value());
+  ASSERT_SOME(gets->at(1));
+  EXPECT_EQ("value2", gets->at(1)->value());
+  EXPECT_NONE(gets->at(2));
+
+  // Now update the entries, expecting the stored UUIDs, except for
+  // one stale expectation which makes the batch fail.
+  for (size_t i = 0; i < entries.size(); i++) {
+    entries[i].second = id::UUID::fromBytes(entries[i].first.uuid()).get();
+    entries[i].first.set_uuid(id::UUID::random().toBytes());
+  }
+
+  entries[1].second = id::UUID::random(); // Stale.
+
+  AWAIT_EXPECT_FALSE(storage->set(entries));
+}
+
+
+class CachedStateTest : public ::testing::Test
+{
+public:
+  CachedStateTest()
+    : backend(nullptr),
+      storage(nullptr),
+      state(nullptr) {}
+
+protected:
+  void SetUp() override
+  {
+    backend = new mesos::state::InMemoryStorage();
+    storage = new mesos::state::CachedStorage(backend);
+    state = new State(storage);
+  }
+
+  void TearDown() override
+  {
+    delete state;
+    delete storage;
+    delete backend;
+  }
+
+  mesos::state::Storage* backend;
+  mesos::state::Storage* storage;
+  State* state;
+};
+
+
+TEST_F(CachedStateTest, FetchAndStoreAndFetch)
+{
+  FetchAndStoreAndFetch(state);
+}
+
+
+TEST_F(CachedStateTest, FetchAndStoreAndStoreAndFetch)
+{
+  FetchAndStoreAndStoreAndFetch(state);
+}
+
+
+TEST_F(CachedStateTest, FetchAndStoreAndStoreFailAndFetch)
+{
+  FetchAndStoreAndStoreFailAndFetch(state);
+}
+
+
+TEST_F(CachedStateTest, FetchAndStoreAndExpungeAndFetch)
+{
+  FetchAndStoreAndExpungeAndFetch(state);
+}
+
+
+TEST_F(CachedStateTest, FetchAndStoreAndExpungeAndExpunge)
+{
+  FetchAndStoreAndExpungeAndExpunge(state);
+}
+
+
+TEST_F(CachedStateTest, FetchAndStoreAndExpungeAndStoreAndFetch)
+{
+  FetchAndStoreAndExpungeAndStoreAndFetch(state);
+}
+
+
+TEST_F(CachedStateTest, Names)
+{
+  Names(state);
+}
+
+
+// Tests that a fetch after a write through the cache by another
+// process serves the stale cached entry, that a store based on it
+// then fails (evicting the stale entry), and that the subsequent
+// fetch reads through to the backend again.
+TEST_F(CachedStateTest, Consistency)
+{
+  Future<Variable<Slaves>> future1 = state->fetch<Slaves>("slaves");
+  AWAIT_READY(future1);
+
+  Variable<Slaves> variable = future1.get();
+
+  Slaves slaves = variable.get();
+  ASSERT_TRUE(slaves.slaves().empty());
+
+  Slave* slave = slaves.add_slaves();
+  slave->mutable_info()->set_hostname("localhost1");
+
+  variable = variable.mutate(slaves);
+
+  Future<Option<Variable<Slaves>>> future2 = state->store(variable);
+  AWAIT_READY(future2);
+  ASSERT_SOME(future2.get());
+
+  variable = future2->get();
+
+  // Update the backend directly, as another process would.
+  Future<Option<mesos::internal::state::Entry>> current =
+    backend->get("slaves");
+
+  AWAIT_READY(current);
+  ASSERT_SOME(current.get());
+
+  Slaves slaves2 = slaves;
+  slaves2.add_slaves()->mutable_info()->set_hostname("localhost2");
+
+  string value;
+  ASSERT_TRUE(slaves2.SerializeToString(&value));
+
+  mesos::internal::state::Entry entry;
+  entry.set_name("slaves");
+  entry.set_uuid(id::UUID::random().toBytes());
+  entry.set_value(value);
+
+  AWAIT_EXPECT_TRUE(backend->set(
+      entry,
+      id::UUID::fromBytes(current.get()->uuid()).get()));
+
+  // The cache still serves the old entry...
+  future1 = state->fetch<Slaves>("slaves");
+  AWAIT_READY(future1);
+  EXPECT_EQ(1, future1->get().slaves().size());
+
+  // ...so a store based on it fails and evicts the stale entry...
+  slaves.add_slaves()->mutable_info()->set_hostname("localhost3");
+  variable = variable.mutate(slaves);
+
+  future2 = state->store(variable);
+  AWAIT_READY(future2);
+  EXPECT_NONE(future2.get());
+
+  // ...and the next fetch reads through to the backend.
+  future1 = state->fetch<Slaves>("slaves");
+  AWAIT_READY(future1);
+
+  Slaves slaves3 = future1->get();
+  ASSERT_EQ(2, slaves3.slaves().size());
+  EXPECT_EQ("localhost2", slaves3.slaves(1).info().hostname());
+}
+
+
 class LevelDBStateTest : public TemporaryDirectoryTest
 {
 public:
@@ -692,6 +884,90 @@ TEST_F(LogStateTest, Diff)
 }
 
 
+TEST_F(LogStateTest, Fragment)
+{
+  Future<Variable<Slaves>> future1 = state->fetch<Slaves>("slaves");
+  AWAIT_READY(future1);
+
+  Variable<Slaves> variable = future1.get();
+
+  Slaves slaves = variable.get();
+  ASSERT_TRUE(slaves.slaves().empty());
+
+  // Use poorly compressible hostnames so that even after compression
+  // the serialized snapshot spans multiple fragments.
+  for (size_t i = 0; i < 2048; i++) {
+    string hostname;
+    for (size_t j = 0; j < 32; j++) {
+      hostname += id::UUID::random().toString();
+    }
+
+    Slave* slave = slaves.add_slaves();
+    slave->mutable_info()->set_hostname(hostname);
+  }
+
+  variable = variable.mutate(slaves);
+
+  Future<Option<Variable<Slaves>>> future2 = state->store(variable);
+  AWAIT_READY(future2);
+  ASSERT_SOME(future2.get());
+
+  // Wait for any asynchronous truncation to finish (see the comment
+  // in the Diff test above).
+  Clock::pause();
+  Clock::settle();
+  Clock::resume();
+
+  Log::Reader reader(log);
+
+  Future<Log::Position> beginning = reader.beginning();
+  Future<Log::Position> ending = reader.ending();
+
+  AWAIT_READY(beginning);
+  AWAIT_READY(ending);
+
+  Future<list<Log::Entry>> entries = reader.read(beginning.get(), ending.get());
+
+  AWAIT_READY(entries);
+
+  // The snapshot should have been written as consecutive fragments.
+  vector<Operation> operations;
+
+  foreach (const Log::Entry& entry, entries.get()) {
+    Operation operation;
+
+    google::protobuf::io::ArrayInputStream stream(
+        entry.data.data(),
+        entry.data.size());
+
+    ASSERT_TRUE(operation.ParseFromZeroCopyStream(&stream));
+
+    operations.push_back(operation);
+  }
+
+  ASSERT_LE(2u, operations.size());
+
+  for (size_t i = 0; i < operations.size(); i++) {
+    EXPECT_EQ(Operation::FRAGMENT, operations[i].type());
+    EXPECT_EQ(i, operations[i].fragment().index());
+    EXPECT_EQ(operations.size(), operations[i].fragment().count());
+  }
+
+  // Now make sure a fresh storage reassembles the snapshot when
+  // reading the log.
+  mesos::state::LogStorage storage2(log, 1024);
+  State state2(&storage2);
+
+  future1 = state2.fetch<Slaves>("slaves");
+  AWAIT_READY(future1);
+
+  Slaves slaves2 = future1->get();
+  ASSERT_EQ(2048, slaves2.slaves().size());
+  EXPECT_EQ(slaves.slaves(0).info().hostname(),
+            slaves2.slaves(0).info().hostname());
+}
+
+
 #ifdef MESOS_HAS_JAVA
 class ZooKeeperStateTest : public tests::ZooKeeperTest
 {
@@ -52,6 +52,8 @@ Try<Owned<Fetcher>> create(const Option<Flags>& _flags)
        [flags]() { return CopyFetcherPlugin::create(flags); }},
     {HadoopFetcherPlugin::NAME,
        [flags]() { return HadoopFetcherPlugin::create(flags); }},
+    {WebHdfsFetcherPlugin::NAME,
+       [flags]() { return WebHdfsFetcherPlugin::create(flags); }},
 #ifndef __WINDOWS__
     // TODO(coffler): Enable Docker plugin. See MESOS-8570.
     {DockerFetcherPlugin::NAME,
@@ -29,6 +29,7 @@
 #include "uri/fetchers/curl.hpp"
 #include "uri/fetchers/docker.hpp"
 #include "uri/fetchers/hadoop.hpp"
+#include "uri/fetchers/webhdfs.hpp"
 
 namespace mesos {
 namespace uri {
@@ -41,10 +42,12 @@ class Flags :
   public virtual CopyFetcherPlugin::Flags,
   public virtual CurlFetcherPlugin::Flags,
 #ifdef __WINDOWS__
-  public virtual HadoopFetcherPlugin::Flags {};
+  public virtual HadoopFetcherPlugin::Flags,
+  public virtual WebHdfsFetcherPlugin::Flags {};
 #else
   // TODO(coffler): Add support for Docker plugins. See MESOS-8570.
   public virtual HadoopFetcherPlugin::Flags,
+  public virtual WebHdfsFetcherPlugin::Flags,
   public virtual DockerFetcherPlugin::Flags {};
 #endif // __WINDOWS__
 
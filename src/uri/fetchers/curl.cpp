@@ -14,42 +14,47 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#ifndef __WINDOWS__
-#include <sys/wait.h>
-#endif // __WINDOWS__
+#include <curl/curl.h>
 
+#include <set>
 #include <string>
-#include <tuple>
-#include <vector>
 
-#include <process/check.hpp>
-#include <process/collect.hpp>
+#include <process/defer.hpp>
+#include <process/delay.hpp>
+#include <process/dispatch.hpp>
+#include <process/id.hpp>
 #include <process/io.hpp>
-#include <process/subprocess.hpp>
+#include <process/process.hpp>
 
+#include <stout/check.hpp>
+#include <stout/hashmap.hpp>
+#include <stout/lambda.hpp>
 #include <stout/path.hpp>
+#include <stout/stringify.hpp>
 #include <stout/strings.hpp>
 
-#include <stout/os/constants.hpp>
+#include <stout/os/close.hpp>
+#include <stout/os/exists.hpp>
+#include <stout/os/int_fd.hpp>
 #include <stout/os/mkdir.hpp>
+#include <stout/os/open.hpp>
+#include <stout/os/rename.hpp>
+#include <stout/os/rm.hpp>
+#include <stout/os/stat.hpp>
+#include <stout/os/write.hpp>
 
 #include "uri/fetchers/curl.hpp"
 
-namespace http = process::http;
 namespace io = process::io;
 
 using std::set;
 using std::string;
-using std::tuple;
-using std::vector;
-
-using process::await;
-using process::subprocess;
 
 using process::Failure;
 using process::Future;
 using process::Owned;
-using process::Subprocess;
+using process::Process;
+using process::Promise;
 
 namespace mesos {
 namespace uri {
@@ -67,134 +72,449 @@ CurlFetcherPlugin::Flags::Flags()
 const char CurlFetcherPlugin::NAME[] = "curl";
 
 
-Try<Owned<Fetcher::Plugin>> CurlFetcherPlugin::create(const Flags& flags)
+// Drives all transfers through one libcurl multi handle, which pools
+// connections across them, using libprocess for readiness and timer
+// notifications (CURLMOPT_SOCKETFUNCTION / CURLMOPT_TIMERFUNCTION).
+// All libcurl calls, and hence all libcurl callbacks, happen on this
+// actor.
+class CurlFetcherPluginProcess : public Process<CurlFetcherPluginProcess>
 {
-  // TODO(jieyu): Make sure curl is available.
+public:
+  explicit CurlFetcherPluginProcess(const Option<Duration>& _stallTimeout)
+    : ProcessBase(process::ID::generate("curl-fetcher")),
+      stallTimeout(_stallTimeout),
+      sequence(0)
+  {
+    multi = curl_multi_init();
+
+    if (multi != nullptr) {
+      curl_multi_setopt(
+          multi, CURLMOPT_SOCKETFUNCTION, &CurlFetcherPluginProcess::socket);
+      curl_multi_setopt(multi, CURLMOPT_SOCKETDATA, this);
+      curl_multi_setopt(
+          multi, CURLMOPT_TIMERFUNCTION, &CurlFetcherPluginProcess::timer);
+      curl_multi_setopt(multi, CURLMOPT_TIMERDATA, this);
+    }
+
+    // Share DNS entries and TLS sessions across the easy handles
+    // (the connection pool itself lives in the multi handle). No
+    // lock callbacks are needed since the share is only used from
+    // this actor.
+    share = curl_share_init();
+
+    if (share != nullptr) {
+      curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+      curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    }
+  }
 
-  return Owned<Fetcher::Plugin>(new CurlFetcherPlugin(flags));
-}
+  Future<Nothing> fetch(const URI& uri, const string& directory)
+  {
+    if (multi == nullptr) {
+      return Failure("Failed to initialize a curl multi handle");
+    }
 
+    // TODO(jieyu): Validate the given URI.
 
-set<string> CurlFetcherPlugin::schemes() const
-{
-  return {"http", "https", "ftp", "ftps"};
-}
+    if (!uri.has_path()) {
+      return Failure("URI path is not specified");
+    }
 
+    Try<Nothing> mkdir = os::mkdir(directory);
+    if (mkdir.isError()) {
+      return Failure(
+          "Failed to create directory '" +
+          directory + "': " + mkdir.error());
+    }
 
-string CurlFetcherPlugin::name() const
-{
-  return NAME;
-}
+    // TODO(jieyu): Allow user to specify the name of the output file.
+    const string output =
+      path::join(directory, Path(path::from_uri(uri.path())).basename());
 
+    Owned<Transfer> transfer(new Transfer());
+    transfer->url = strings::trim(stringify(uri));
+    transfer->output = output;
+    transfer->part = output + ".part";
 
-Future<Nothing> CurlFetcherPlugin::fetch(
-    const URI& uri,
-    const string& directory,
-    const Option<string>& data) const
-{
-  // TODO(jieyu): Validate the given URI.
+    Try<Nothing> added = add(transfer, true);
+    if (added.isError()) {
+      return Failure(added.error());
+    }
 
-  if (!uri.has_path()) {
-    return Failure("URI path is not specified");
+    return transfer->promise.future();
   }
 
-  Try<Nothing> mkdir = os::mkdir(directory);
-  if (mkdir.isError()) {
-    return Failure(
-        "Failed to create directory '" +
-        directory + "': " + mkdir.error());
+protected:
+  void finalize() override
+  {
+    foreachvalue (const Owned<Transfer>& transfer, transfers) {
+      curl_multi_remove_handle(multi, transfer->easy);
+      curl_easy_cleanup(transfer->easy);
+      os::close(transfer->fd);
+      transfer->promise.discard();
+    }
+
+    transfers.clear();
+
+    if (multi != nullptr) {
+      curl_multi_cleanup(multi);
+    }
+
+    if (share != nullptr) {
+      curl_share_cleanup(share);
+    }
   }
 
-  // TODO(jieyu): Allow user to specify the name of the output file.
-  const string output =
-    path::join(directory, Path(path::from_uri(uri.path())).basename());
-#ifndef __WINDOWS__
-  const string curl = "curl";
-#else
-  const string curl = "curl.exe";
-#endif // __WINDOWS__
-
-  vector<string> argv = {
-    curl,
-    "-s",                 // Don't show progress meter or error messages.
-    "-S",                 // Makes curl show an error message if it fails.
-    "-L",                 // Follow HTTP 3xx redirects.
-    "-w", "%{http_code}", // Display HTTP response code on stdout.
-    "-o", output,         // Write output to the file.
-    strings::trim(stringify(uri))
+private:
+  struct Transfer
+  {
+    Transfer() : easy(nullptr), fd(-1), resumed(0) { error[0] = '\0'; }
+
+    CURL* easy;
+    string url;
+    string output;
+    string part; // The in-progress (and resumable) partial file.
+    int_fd fd;
+    curl_off_t resumed; // Bytes already on disk when the transfer started.
+    char error[CURL_ERROR_SIZE];
+    Promise<Nothing> promise;
   };
 
-  // Add a timeout for curl to abort when the download speed keeps low
-  // (1 byte per second by default) for the specified duration. See:
-  // https://curl.haxx.se/docs/manpage.html#-y
-  if (flags.curl_stall_timeout.isSome()) {
-    argv.push_back("-y");
-    argv.push_back(
-        std::to_string(static_cast<long>(flags.curl_stall_timeout->secs())));
+  // Sets up an easy handle for the given transfer, resuming from an
+  // existing partial file if requested, and hands it to libcurl.
+  Try<Nothing> add(const Owned<Transfer>& transfer, bool resume)
+  {
+    curl_off_t offset = 0;
+
+    if (resume && os::exists(transfer->part)) {
+      Try<Bytes> size = os::stat::size(transfer->part);
+      if (size.isSome()) {
+        offset = size->bytes();
+      }
+    }
+
+    Try<int_fd> fd = os::open(
+        transfer->part,
+        O_WRONLY | O_CREAT | O_CLOEXEC | (offset > 0 ? O_APPEND : O_TRUNC),
+        S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+
+    if (fd.isError()) {
+      return Error(
+          "Failed to open file '" + transfer->part + "': " + fd.error());
+    }
+
+    CURL* easy = curl_easy_init();
+    if (easy == nullptr) {
+      os::close(fd.get());
+      return Error("Failed to initialize a curl easy handle");
+    }
+
+    transfer->easy = easy;
+    transfer->fd = fd.get();
+    transfer->resumed = offset;
+    transfer->error[0] = '\0';
+
+    curl_easy_setopt(easy, CURLOPT_URL, transfer->url.c_str());
+    curl_easy_setopt(easy, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(easy, CURLOPT_FAILONERROR, 1L);
+    curl_easy_setopt(
+        easy, CURLOPT_WRITEFUNCTION, &CurlFetcherPluginProcess::write);
+    curl_easy_setopt(easy, CURLOPT_WRITEDATA, transfer.get());
+    curl_easy_setopt(easy, CURLOPT_ERRORBUFFER, transfer->error);
+
+    if (share != nullptr) {
+      curl_easy_setopt(easy, CURLOPT_SHARE, share);
+    }
+
+    if (offset > 0) {
+      curl_easy_setopt(easy, CURLOPT_RESUME_FROM_LARGE, offset);
+    }
+
+    // Abort when the download speed keeps low (1 byte per second by
+    // default) for the specified duration, matching 'curl -y'.
+    if (stallTimeout.isSome()) {
+      curl_easy_setopt(easy, CURLOPT_LOW_SPEED_LIMIT, 1L);
+      curl_easy_setopt(
+          easy,
+          CURLOPT_LOW_SPEED_TIME,
+          static_cast<long>(stallTimeout->secs()));
+    }
+
+    transfers[easy] = transfer;
+
+    curl_multi_add_handle(multi, easy);
+
+    return Nothing();
   }
 
-  Try<Subprocess> s = subprocess(
-      curl,
-      argv,
-      Subprocess::PATH(os::DEV_NULL),
-      Subprocess::PIPE(),
-      Subprocess::PIPE());
+  // Invoked by libcurl (from within a curl_multi_* call on this
+  // actor) when the events it is interested in for a socket change.
+  static int socket(CURL*, curl_socket_t s, int what, void* data, void*)
+  {
+    CurlFetcherPluginProcess* process =
+      static_cast<CurlFetcherPluginProcess*>(data);
 
-  if (s.isError()) {
-    return Failure("Failed to exec the curl subprocess: " + s.error());
+    process->watch(s, what);
+    return 0;
   }
 
-  return await(
-      s->status(),
-      io::read(s->out().get()),
-      io::read(s->err().get()))
-    .then([](const tuple<
-        Future<Option<int>>,
-        Future<string>,
-        Future<string>>& t) -> Future<Nothing> {
-      const Future<Option<int>>& status = std::get<0>(t);
-      if (!status.isReady()) {
-        return Failure(
-            "Failed to get the exit status of the curl subprocess: " +
-            (status.isFailed() ? status.failure() : "discarded"));
-      }
+  void watch(curl_socket_t s, int what)
+  {
+    // Cancel the outstanding (one-shot) poll, if any; a stale
+    // notification is ignored in 'polled()'.
+    if (polls.contains(s)) {
+      polls.at(s).discard();
+      polls.erase(s);
+    }
+
+    if (what == CURL_POLL_REMOVE) {
+      interests.erase(s);
+      return;
+    }
+
+    interests[s] = what;
+    arm(s);
+  }
 
-      if (status->isNone()) {
-        return Failure("Failed to reap the curl subprocess");
-      }
+  void arm(curl_socket_t s)
+  {
+    CHECK(interests.contains(s));
 
-      if (status->get() != 0) {
-        const Future<string>& error = std::get<2>(t);
-        if (!error.isReady()) {
-          return Failure(
-              "Failed to perform 'curl'. Reading stderr failed: " +
-              (error.isFailed() ? error.failure() : "discarded"));
-        }
+    const int what = interests.at(s);
 
-        return Failure("Failed to perform 'curl': " + error.get());
-      }
+    short events = 0;
+    if (what == CURL_POLL_IN || what == CURL_POLL_INOUT) {
+      events |= io::READ;
+    }
+    if (what == CURL_POLL_OUT || what == CURL_POLL_INOUT) {
+      events |= io::WRITE;
+    }
+
+    Future<short> poll = io::poll(s, events);
+    polls[s] = poll;
+
+    poll.onAny(defer(self(), &Self::polled, s, lambda::_1));
+  }
+
+  void polled(curl_socket_t s, const Future<short>& revents)
+  {
+    // Ignore notifications for watches that have since been changed
+    // or removed (the poll gets discarded in 'watch()', but it may
+    // already have been ready).
+    if (!revents.isReady() ||
+        !polls.contains(s) ||
+        !(polls.at(s) == revents)) {
+      return;
+    }
+
+    polls.erase(s);
+
+    int mask = 0;
+    if (revents.get() & io::READ) {
+      mask |= CURL_CSELECT_IN;
+    }
+    if (revents.get() & io::WRITE) {
+      mask |= CURL_CSELECT_OUT;
+    }
+
+    int running = 0;
+    curl_multi_socket_action(multi, s, mask, &running);
+
+    check();
+
+    // The poll is one-shot: re-arm it unless libcurl changed (or
+    // removed) the watch during the socket action above, in which
+    // case 'watch()' already did.
+    if (interests.contains(s) && !polls.contains(s)) {
+      arm(s);
+    }
+  }
+
+  // Invoked by libcurl (from within a curl_multi_* call on this
+  // actor) to (re)schedule its single timeout.
+  static int timer(CURLM*, long timeout, void* data)
+  {
+    CurlFetcherPluginProcess* process =
+      static_cast<CurlFetcherPluginProcess*>(data);
+
+    process->schedule(timeout);
+    return 0;
+  }
+
+  void schedule(long timeout)
+  {
+    // Invalidate any previously scheduled timeout.
+    sequence++;
+
+    if (timeout >= 0) {
+      delay(Milliseconds(timeout), self(), &Self::timedout, sequence);
+    }
+  }
+
+  void timedout(uint64_t _sequence)
+  {
+    if (_sequence != sequence) {
+      return; // The timeout has been rescheduled or cancelled.
+    }
+
+    int running = 0;
+    curl_multi_socket_action(multi, CURL_SOCKET_TIMEOUT, 0, &running);
+
+    check();
+  }
+
+  // Invoked by libcurl to sink the response body.
+  //
+  // NOTE: This writes to disk from the actor; that serializes disk
+  // I/O with the (non-blocking) network I/O but keeps all transfer
+  // state confined to this process.
+  static size_t write(char* data, size_t size, size_t count, void* userdata)
+  {
+    Transfer* transfer = static_cast<Transfer*>(userdata);
+
+    const size_t length = size * count;
+
+    Try<Nothing> written = os::write(transfer->fd, string(data, length));
+    if (written.isError()) {
+      return 0; // Signals CURLE_WRITE_ERROR to libcurl.
+    }
+
+    return length;
+  }
+
+  // Completes transfers that libcurl has finished with.
+  void check()
+  {
+    int pending = 0;
+    CURLMsg* message;
 
-      const Future<string>& output = std::get<1>(t);
-      if (!output.isReady()) {
-        return Failure(
-            "Failed to read stdout from 'curl': " +
-            (output.isFailed() ? output.failure() : "discarded"));
+    while ((message = curl_multi_info_read(multi, &pending)) != nullptr) {
+      if (message->msg != CURLMSG_DONE) {
+        continue;
       }
 
-      // Parse the output and get the HTTP response code.
-      Try<int> code = numify<int>(output.get());
-      if (code.isError()) {
-        return Failure("Unexpected output from 'curl': " + output.get());
+      CURL* easy = message->easy_handle;
+      const CURLcode result = message->data.result;
+
+      CHECK(transfers.contains(easy));
+      Owned<Transfer> transfer = transfers.at(easy);
+      transfers.erase(easy);
+
+      curl_multi_remove_handle(multi, easy);
+      curl_easy_cleanup(easy);
+      os::close(transfer->fd);
+
+      if (result == CURLE_OK) {
+        Try<Nothing> rename = os::rename(transfer->part, transfer->output);
+        if (rename.isError()) {
+          transfer->promise.fail(
+              "Failed to rename '" + transfer->part + "' to '" +
+              transfer->output + "': " + rename.error());
+        } else {
+          transfer->promise.set(Nothing());
+        }
+        continue;
       }
 
-      if (code.get() != http::Status::OK) {
-        return Failure(
-            "Unexpected HTTP response code: " +
-            http::Status::string(code.get()));
+      // A failed resumption (e.g., the server does not support
+      // ranges, or the partial file is stale) is retried once from
+      // scratch. Other failures keep the partial file around so a
+      // later fetch can resume it.
+      if (transfer->resumed > 0) {
+        os::rm(transfer->part);
+
+        Try<Nothing> added = add(transfer, false);
+        if (added.isError()) {
+          transfer->promise.fail(
+              "Failed to restart the download of '" + transfer->url + "': " +
+              added.error());
+        }
+        continue;
       }
 
-      return Nothing();
-    });
+      const string error = transfer->error[0] != '\0'
+        ? string(transfer->error)
+        : string(curl_easy_strerror(result));
+
+      transfer->promise.fail(
+          "Failed to download '" + transfer->url + "': " + error);
+    }
+  }
+
+  const Option<Duration> stallTimeout;
+
+  CURLM* multi;
+  CURLSH* share;
+
+  hashmap<CURL*, Owned<Transfer>> transfers;
+
+  // The events libcurl is interested in, and the outstanding poll,
+  // per socket.
+  hashmap<curl_socket_t, int> interests;
+  hashmap<curl_socket_t, Future<short>> polls;
+
+  // Used to invalidate previously scheduled libcurl timeouts.
+  uint64_t sequence;
+};
+
+
+Try<Owned<Fetcher::Plugin>> CurlFetcherPlugin::create(const Flags& flags)
+{
+  // libcurl's global initialization is not thread safe, so make sure
+  // it only happens once.
+  static const CURLcode initialized = curl_global_init(CURL_GLOBAL_ALL);
+
+  if (initialized != CURLE_OK) {
+    return Error(
+        "Failed to initialize libcurl: " +
+        string(curl_easy_strerror(initialized)));
+  }
+
+  Owned<CurlFetcherPluginProcess> process(
+      new CurlFetcherPluginProcess(flags.curl_stall_timeout));
+
+  return Owned<Fetcher::Plugin>(new CurlFetcherPlugin(process));
+}
+
+
+CurlFetcherPlugin::CurlFetcherPlugin(
+    Owned<CurlFetcherPluginProcess> _process)
+  : process(_process)
+{
+  spawn(CHECK_NOTNULL(process.get()));
+}
+
+
+CurlFetcherPlugin::~CurlFetcherPlugin()
+{
+  terminate(process.get());
+  wait(process.get());
+}
+
+
+set<string> CurlFetcherPlugin::schemes() const
+{
+  return {"http", "https", "ftp", "ftps"};
+}
+
+
+string CurlFetcherPlugin::name() const
+{
+  return NAME;
+}
+
+
+Future<Nothing> CurlFetcherPlugin::fetch(
+    const URI& uri,
+    const string& directory,
+    const Option<string>& data) const
+{
+  return dispatch(
+      process.get(),
+      &CurlFetcherPluginProcess::fetch,
+      uri,
+      directory);
 }
 
 } // namespace uri {
@@ -27,6 +27,15 @@
 namespace mesos {
 namespace uri {
 
+// Forward declarations.
+class CurlFetcherPluginProcess;
+
+
+// A fetcher plugin that downloads through libcurl's multi interface
+// in-process (libcurl is already a link dependency): transfers run in
+// parallel on one actor, connections and TLS sessions are pooled and
+// reused across fetches, and an interrupted download is resumed from
+// its partial file where the server supports ranges.
 class CurlFetcherPlugin : public Fetcher::Plugin
 {
 public:
@@ -42,7 +51,7 @@ public:
 
   static Try<process::Owned<Fetcher::Plugin>> create(const Flags& flags);
 
-  ~CurlFetcherPlugin() override {}
+  ~CurlFetcherPlugin() override;
 
   std::set<std::string> schemes() const override;
 
@@ -54,9 +63,10 @@ public:
       const Option<std::string>& data = None()) const override;
 
 private:
-  explicit CurlFetcherPlugin(const Flags& _flags) : flags(_flags) {}
+  explicit CurlFetcherPlugin(
+      process::Owned<CurlFetcherPluginProcess> _process);
 
-  const Flags flags;
+  process::Owned<CurlFetcherPluginProcess> process;
 };
 
 } // namespace uri {
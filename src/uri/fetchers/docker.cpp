@@ -14,10 +14,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <deque>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
+#include <process/clock.hpp>
 #include <process/collect.hpp>
 #include <process/dispatch.hpp>
 #include <process/http.hpp>
@@ -27,6 +30,7 @@
 #include <process/process.hpp>
 #include <process/subprocess.hpp>
 
+#include <stout/hashset.hpp>
 #include <stout/none.hpp>
 #include <stout/option.hpp>
 #include <stout/strings.hpp>
@@ -59,11 +63,14 @@ using process::spawn;
 using process::terminate;
 using process::wait;
 
+using process::Clock;
 using process::Failure;
 using process::Future;
 using process::Owned;
 using process::Process;
+using process::Promise;
 using process::Subprocess;
+using process::Time;
 
 namespace mesos {
 namespace uri {
@@ -82,6 +89,19 @@ static set<string> schemes()
   };
 }
 
+// The default number of image blobs downloaded in parallel.
+static constexpr size_t DEFAULT_BLOB_CONCURRENCY = 8;
+
+// The lifetime the registry token spec prescribes when the auth
+// server does not return 'expires_in'. See:
+// https://docs.docker.com/registry/spec/auth/token/
+static constexpr Duration DEFAULT_TOKEN_LIFETIME = Seconds(60);
+
+// Cached tokens are not used this close to (or past) their expiry so
+// that a request sent with a cached token does not arrive expired.
+static constexpr Duration TOKEN_EXPIRY_MARGIN = Seconds(30);
+
+
 // TODO(jieyu): Move the following curl based utility functions to a
 // command utils common directory.
 
@@ -241,7 +261,8 @@ static Future<int> download(
     const string& uri,
     const string& blobPath,
     const http::Headers& headers,
-    const Option<Duration>& stallTimeout)
+    const Option<Duration>& stallTimeout,
+    bool resume = false)
 {
   vector<string> argv = {
     "curl",
@@ -251,6 +272,12 @@ static Future<int> download(
     "-o", blobPath        // Write output to the file.
   };
 
+  // Resume from whatever is already on disk with a ranged request.
+  if (resume) {
+    argv.push_back("-C");
+    argv.push_back("-");
+  }
+
   // Add additional headers.
   foreachpair (const string& key, const string& value, headers) {
     argv.push_back("-H");
@@ -333,7 +360,8 @@ static Future<int> download(
       if (tokens.size() == 2) {
         // Headers are not attached because the request is already
         // authenticated.
-        return download(tokens[1], blobPath, http::Headers(), stallTimeout);
+        return download(
+            tokens[1], blobPath, http::Headers(), stallTimeout, resume);
       }
 
       return code.get();
@@ -345,11 +373,12 @@ static Future<int> download(
     const URI& uri,
     const string& directory,
     const http::Headers& headers,
-    const Option<Duration>& stallTimeout)
+    const Option<Duration>& stallTimeout,
+    bool resume = false)
 {
   const string blobPath = path::join(directory, Path(uri.path()).basename());
   return download(
-      strings::trim(stringify(uri)), blobPath, headers, stallTimeout);
+      strings::trim(stringify(uri)), blobPath, headers, stallTimeout, resume);
 }
 
 
@@ -417,10 +446,13 @@ class DockerFetcherPluginProcess : public Process<DockerFetcherPluginProcess>
 public:
   DockerFetcherPluginProcess(
       const hashmap<string, spec::Config::Auth>& _auths,
-      const Option<Duration>& _stallTimeout)
+      const Option<Duration>& _stallTimeout,
+      size_t _blobConcurrency)
     : ProcessBase(process::ID::generate("docker-fetcher-plugin")),
       auths(_auths),
-      stallTimeout(_stallTimeout) {}
+      stallTimeout(_stallTimeout),
+      blobConcurrency(_blobConcurrency),
+      activeBlobFetches(0) {}
 
   Future<Nothing> fetch(
       const URI& uri,
@@ -455,8 +487,19 @@ private:
 
   Future<Nothing> __fetchBlob(int code);
 
+  // Enqueues a blob fetch, bounding the number of parallel blob
+  // downloads by '--docker_blob_concurrency'.
+  Future<Nothing> queueBlobFetch(
+      const URI& uri,
+      const string& directory,
+      const http::Headers& authHeaders);
+
+  void nextBlobFetch();
+
   // Returns a token-based authorization header. Basic authorization
   // header may be required to get a proper authorization token.
+  // Tokens are cached (and in-flight token requests shared) per
+  // realm/service/scope until they near expiry.
   Future<http::Headers> getAuthHeader(
       const URI& uri,
       const http::Headers& basicAuthHeaders,
@@ -472,6 +515,26 @@ private:
 
   // Timeout for curl to wait when a net download stalls.
   const Option<Duration> stallTimeout;
+
+  struct BlobFetch
+  {
+    URI uri;
+    string directory;
+    http::Headers authHeaders;
+    Owned<Promise<Nothing>> promise;
+  };
+
+  const size_t blobConcurrency;
+  size_t activeBlobFetches;
+  std::deque<BlobFetch> blobFetchQueue;
+
+  // Bearer tokens (and their use-until deadlines) keyed by the auth
+  // server URI, i.e. per realm/service/scope.
+  hashmap<string, std::pair<string, Time>> tokens;
+
+  // In-flight token requests, shared by concurrent fetches needing
+  // the same realm/service/scope.
+  hashmap<string, Future<string>> tokenRequests;
 };
 
 
@@ -486,6 +549,11 @@ DockerFetcherPlugin::Flags::Flags()
       "Amount of time for the fetcher to wait before considering a download\n"
       "being too slow and abort it when the download stalls (i.e., the speed\n"
       "keeps below one byte per second).");
+
+  add(&Flags::docker_blob_concurrency,
+      "docker_blob_concurrency",
+      "The maximum number of image blobs downloaded in parallel.",
+      DEFAULT_BLOB_CONCURRENCY);
 }
 
 
@@ -508,9 +576,14 @@ Try<Owned<Fetcher::Plugin>> DockerFetcherPlugin::create(const Flags& flags)
     auths = cachedAuths.get();
   }
 
+  if (flags.docker_blob_concurrency == 0) {
+    return Error("Flag '--docker_blob_concurrency' must be positive");
+  }
+
   Owned<DockerFetcherPluginProcess> process(new DockerFetcherPluginProcess(
       hashmap<string, spec::Config::Auth>(auths),
-      flags.docker_stall_timeout));
+      flags.docker_stall_timeout,
+      flags.docker_blob_concurrency));
 
   return Owned<Fetcher::Plugin>(new DockerFetcherPlugin(process));
 }
@@ -608,7 +681,7 @@ Future<Nothing> DockerFetcherPluginProcess::fetch(
   http::Headers basicAuthHeaders = getAuthHeaderBasic(uri, _auths);
 
   if (uri.scheme() == "docker-blob") {
-    return fetchBlob(uri, directory, basicAuthHeaders);
+    return queueBlobFetch(uri, directory, basicAuthHeaders);
   }
 
   URI manifestUri = getManifestUri(uri);
@@ -722,12 +795,24 @@ Future<Nothing> DockerFetcherPluginProcess::__fetch(
     return Nothing();
   }
 
-  // Download all the filesystem layers.
+  // Download all the filesystem layers. The same blob often backs
+  // multiple layers (e.g., empty layers), so each distinct digest is
+  // fetched only once; the number of parallel downloads is bounded
+  // by '--docker_blob_concurrency'.
+  hashset<string> digests;
   vector<Future<Nothing>> futures;
   for (int i = 0; i < manifest->fslayers_size(); i++) {
+    const string& digest = manifest->fslayers(i).blobsum();
+
+    if (digests.contains(digest)) {
+      continue;
+    }
+
+    digests.insert(digest);
+
     URI blob = uri::docker::blob(
         uri.path(),                         // The 'repository'.
-        manifest->fslayers(i).blobsum(),    // The 'digest'.
+        digest,                             // The 'digest'.
         uri.host(),                         // The 'registry'.
         (uri.has_fragment()                 // The 'scheme'.
           ? Option<string>(uri.fragment())
@@ -737,7 +822,7 @@ Future<Nothing> DockerFetcherPluginProcess::__fetch(
           : None()));
 
     // Use the same 'authHeaders' as for the manifest to pull the blobs.
-    futures.push_back(fetchBlob(
+    futures.push_back(queueBlobFetch(
         blob,
         directory,
         authHeaders));
@@ -748,6 +833,51 @@ Future<Nothing> DockerFetcherPluginProcess::__fetch(
 }
 
 
+Future<Nothing> DockerFetcherPluginProcess::queueBlobFetch(
+    const URI& uri,
+    const string& directory,
+    const http::Headers& authHeaders)
+{
+  BlobFetch fetch;
+  fetch.uri = uri;
+  fetch.directory = directory;
+  fetch.authHeaders = authHeaders;
+  fetch.promise.reset(new Promise<Nothing>());
+
+  blobFetchQueue.push_back(fetch);
+
+  nextBlobFetch();
+
+  return fetch.promise->future();
+}
+
+
+void DockerFetcherPluginProcess::nextBlobFetch()
+{
+  while (activeBlobFetches < blobConcurrency && !blobFetchQueue.empty()) {
+    BlobFetch fetch = blobFetchQueue.front();
+    blobFetchQueue.pop_front();
+
+    activeBlobFetches++;
+
+    fetchBlob(fetch.uri, fetch.directory, fetch.authHeaders)
+      .onAny(defer(self(), [=](const Future<Nothing>& future) {
+        activeBlobFetches--;
+
+        if (future.isReady()) {
+          fetch.promise->set(Nothing());
+        } else if (future.isFailed()) {
+          fetch.promise->fail(future.failure());
+        } else {
+          fetch.promise->discard();
+        }
+
+        nextBlobFetch();
+      }));
+  }
+}
+
+
 Future<Nothing> DockerFetcherPluginProcess::fetchBlob(
     const URI& uri,
     const string& directory,
@@ -756,6 +886,15 @@ Future<Nothing> DockerFetcherPluginProcess::fetchBlob(
   URI blobUri = getBlobUri(uri);
 
   return download(blobUri, directory, authHeaders, stallTimeout)
+    .repair(defer(self(), [=](const Future<int>& failed) -> Future<int> {
+      // A transport level failure (no HTTP response code made it
+      // back, e.g., a stalled or reset connection): retry once with
+      // a ranged request resuming from whatever made it to disk.
+      LOG(WARNING) << "Retrying (resuming) the download of '" << blobUri
+                   << "' after: " << failed.failure();
+
+      return download(blobUri, directory, authHeaders, stallTimeout, true);
+    }))
     .then(defer(self(), [=](int code) -> Future<Nothing> {
       if (code == http::Status::UNAUTHORIZED) {
         // If we get a '401 Unauthorized', we assume that 'authHeaders'
@@ -794,6 +933,14 @@ Future<Nothing> DockerFetcherPluginProcess::_fetchBlob(
         .then(defer(self(), [=](
             const http::Headers& authHeaders) -> Future<Nothing> {
           return download(blobUri, directory, authHeaders, stallTimeout)
+            .repair(defer(self(), [=](
+                const Future<int>& failed) -> Future<int> {
+              LOG(WARNING) << "Retrying (resuming) the download of '"
+                           << blobUri << "' after: " << failed.failure();
+
+              return download(
+                  blobUri, directory, authHeaders, stallTimeout, true);
+            }))
             .then(defer(self(),
                         &Self::__fetchBlob,
                         lambda::_1));
@@ -865,31 +1012,75 @@ Future<http::Headers> DockerFetcherPluginProcess::getAuthHeader(
       "service=" + authParam.at("service") + "&" +
       "scope=" + authParam.at("scope");
 
-    return curl(authServerUri, basicAuthHeaders, stallTimeout)
-      .then([authServerUri](
-          const http::Response& response) -> Future<http::Headers> {
-        if (response.code != http::Status::OK) {
-          return Failure(
-            "Unexpected HTTP response '" + response.status + "' "
-            "when trying to GET '" + authServerUri + "'");
-        }
-
-        CHECK_EQ(response.type, http::Response::BODY);
+    // Reuse a cached token for this realm/service/scope so that N
+    // blobs of an image do not cause N auth server round-trips.
+    if (tokens.contains(authServerUri)) {
+      if (Clock::now() < tokens.at(authServerUri).second) {
+        return getAuthHeaderBearer(tokens.at(authServerUri).first);
+      }
 
-        Try<JSON::Object> object = JSON::parse<JSON::Object>(response.body);
-        if (object.isError()) {
-          return Failure("Parsing the JSON object failed: " + object.error());
-        }
+      tokens.erase(authServerUri);
+    }
 
-        Result<JSON::String> token = object->find<JSON::String>("token");
-        if (token.isError()) {
-          return Failure(
-              "Finding token in JSON object failed: " + token.error());
-        } else if (token.isNone()) {
-          return Failure("Failed to find token in JSON object");
-        }
+    // Piggyback on an in-flight request for the same token, if any.
+    if (!tokenRequests.contains(authServerUri)) {
+      Future<string> request =
+        curl(authServerUri, basicAuthHeaders, stallTimeout)
+          .then(defer(self(), [=](
+              const http::Response& response) -> Future<string> {
+            if (response.code != http::Status::OK) {
+              return Failure(
+                "Unexpected HTTP response '" + response.status + "' "
+                "when trying to GET '" + authServerUri + "'");
+            }
+
+            CHECK_EQ(response.type, http::Response::BODY);
+
+            Try<JSON::Object> object =
+              JSON::parse<JSON::Object>(response.body);
+            if (object.isError()) {
+              return Failure(
+                  "Parsing the JSON object failed: " + object.error());
+            }
+
+            Result<JSON::String> token = object->find<JSON::String>("token");
+            if (token.isError()) {
+              return Failure(
+                  "Finding token in JSON object failed: " + token.error());
+            } else if (token.isNone()) {
+              return Failure("Failed to find token in JSON object");
+            }
+
+            Duration lifetime = DEFAULT_TOKEN_LIFETIME;
+
+            Result<JSON::Number> expiration =
+              object->find<JSON::Number>("expires_in");
+            if (expiration.isSome()) {
+              lifetime = Seconds(static_cast<int64_t>(expiration->as<double>()));
+            }
+
+            // Only cache tokens that live long enough to be reused
+            // with some margin before they expire.
+            if (lifetime > TOKEN_EXPIRY_MARGIN) {
+              tokens[authServerUri] = std::make_pair(
+                  token->value,
+                  Clock::now() + lifetime - TOKEN_EXPIRY_MARGIN);
+            }
+
+            return token->value;
+          }));
+
+      tokenRequests[authServerUri] = request;
+
+      request
+        .onAny(defer(self(), [=](const Future<string>&) {
+          tokenRequests.erase(authServerUri);
+        }));
+    }
 
-        return getAuthHeaderBearer(token->value);
+    return tokenRequests.at(authServerUri)
+      .then([](const string& token) -> Future<http::Headers> {
+        return getAuthHeaderBearer(token);
       });
   }
 
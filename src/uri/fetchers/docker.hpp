@@ -41,6 +41,7 @@ public:
 
     Option<JSON::Object> docker_config;
     Option<Duration> docker_stall_timeout;
+    size_t docker_blob_concurrency;
   };
 
   static const char NAME[];
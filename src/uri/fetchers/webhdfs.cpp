@@ -0,0 +1,376 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include <process/defer.hpp>
+#include <process/dispatch.hpp>
+#include <process/http.hpp>
+#include <process/id.hpp>
+#include <process/io.hpp>
+#include <process/process.hpp>
+
+#include <stout/check.hpp>
+#include <stout/hashmap.hpp>
+#include <stout/lambda.hpp>
+#include <stout/path.hpp>
+#include <stout/stringify.hpp>
+#include <stout/strings.hpp>
+
+#include <stout/os/close.hpp>
+#include <stout/os/int_fd.hpp>
+#include <stout/os/mkdir.hpp>
+#include <stout/os/open.hpp>
+#include <stout/os/write.hpp>
+
+#include "uri/fetchers/webhdfs.hpp"
+
+namespace http = process::http;
+namespace io = process::io;
+
+using std::set;
+using std::string;
+using std::vector;
+
+using process::Failure;
+using process::Future;
+using process::Owned;
+using process::Process;
+
+namespace mesos {
+namespace uri {
+
+// The default NameNode HTTP port, where the WebHDFS REST API is
+// served. Note that this is different from the (RPC) port typically
+// embedded in 'hdfs://' URIs.
+static constexpr uint16_t DEFAULT_WEBHDFS_PORT = 50070;
+
+// The WebHDFS OPEN operation redirects to the DataNode holding the
+// first block of the file; more hops than that are unexpected.
+static constexpr unsigned int WEBHDFS_MAX_REDIRECTS = 2;
+
+
+WebHdfsFetcherPlugin::Flags::Flags()
+{
+  add(&Flags::webhdfs_supported_schemes,
+      "webhdfs_supported_schemes",
+      "A comma-separated list of the schemes fetched through WebHDFS.\n"
+      "To fetch 'hdfs' URIs through WebHDFS, add 'hdfs' here and remove\n"
+      "it from `--hadoop_client_supported_schemes`.",
+      "webhdfs");
+
+  add(&Flags::webhdfs_port,
+      "webhdfs_port",
+      "The NameNode HTTP port used when a URI does not specify one.\n"
+      "NOTE: 'hdfs' URIs typically carry the NameNode RPC port, which\n"
+      "WebHDFS does not serve; such URIs should omit the port and rely\n"
+      "on this flag instead.",
+      DEFAULT_WEBHDFS_PORT);
+
+  add(&Flags::webhdfs_user,
+      "webhdfs_user",
+      "The user name passed to WebHDFS ('user.name') on clusters with\n"
+      "simple authentication.");
+
+  add(&Flags::webhdfs_delegation_token,
+      "webhdfs_delegation_token",
+      "A delegation token passed to WebHDFS ('delegation') on secure\n"
+      "clusters. The token is reused across all fetches performed by\n"
+      "this agent; acquiring and renewing it is left to the operator.");
+}
+
+
+const char WebHdfsFetcherPlugin::NAME[] = "webhdfs";
+
+
+class WebHdfsFetcherPluginProcess : public Process<WebHdfsFetcherPluginProcess>
+{
+public:
+  WebHdfsFetcherPluginProcess(
+      uint16_t _defaultPort,
+      const Option<string>& _user,
+      const Option<string>& _token)
+    : ProcessBase(process::ID::generate("webhdfs-fetcher")),
+      defaultPort(_defaultPort),
+      user(_user),
+      token(_token) {}
+
+  Future<Nothing> fetch(const URI& uri, const string& directory)
+  {
+    if (!uri.has_path()) {
+      return Failure("URI path is not specified");
+    }
+
+    if (!uri.has_host()) {
+      return Failure(
+          "URI host is not specified; it is required to locate "
+          "the WebHDFS NameNode");
+    }
+
+    Try<Nothing> mkdir = os::mkdir(directory);
+    if (mkdir.isError()) {
+      return Failure(
+          "Failed to create directory '" +
+          directory + "': " + mkdir.error());
+    }
+
+    http::URL url;
+    url.scheme = "http";
+    url.domain = uri.host();
+    url.port = uri.has_port() ? uri.port() : defaultPort;
+    url.path = path::join("/webhdfs/v1", uri.path());
+    url.query["op"] = "OPEN";
+
+    if (token.isSome()) {
+      url.query["delegation"] = token.get();
+    } else if (user.isSome()) {
+      url.query["user.name"] = user.get();
+    }
+
+    // TODO(jieyu): Allow user to specify the name of the output file.
+    const string output =
+      path::join(directory, Path(uri.path()).basename());
+
+    return download(url, output, WEBHDFS_MAX_REDIRECTS);
+  }
+
+private:
+  // Returns a (possibly cached) keep-alive connection to the server
+  // the given URL points at.
+  Future<http::Connection> connection(const http::URL& url)
+  {
+    const string key =
+      url.domain.get() + ":" + stringify(url.port.get());
+
+    if (connections.contains(key)) {
+      return connections.at(key);
+    }
+
+    return http::connect(url)
+      .then(defer(self(), [this, key](const http::Connection& connection)
+          -> Future<http::Connection> {
+        // NOTE: 'Connection' is not assignable, hence the emplace.
+        connections.erase(key);
+        connections.emplace(key, connection);
+
+        // Evict the cached connection once the server (or an idle
+        // timeout) closes it, so that a later fetch reconnects.
+        connection.disconnected()
+          .onAny(defer(self(), [this, key, connection](
+              const Future<Nothing>&) {
+            if (connections.contains(key) &&
+                connections.at(key) == connection) {
+              connections.erase(key);
+            }
+          }));
+
+        return connection;
+      }));
+  }
+
+  Future<Nothing> download(
+      const http::URL& url,
+      const string& output,
+      unsigned int redirects)
+  {
+    return connection(url)
+      .then(defer(self(),
+                  &Self::_download,
+                  lambda::_1,
+                  url,
+                  output,
+                  redirects));
+  }
+
+  Future<Nothing> _download(
+      http::Connection connection,
+      const http::URL& url,
+      const string& output,
+      unsigned int redirects)
+  {
+    http::Request request;
+    request.method = "GET";
+    request.url = url;
+    request.keepAlive = true;
+
+    return connection.send(request, true)
+      .then(defer(self(), &Self::__download, lambda::_1, output, redirects));
+  }
+
+  Future<Nothing> __download(
+      const http::Response& response,
+      const string& output,
+      unsigned int redirects)
+  {
+    CHECK_SOME(response.reader);
+
+    // The OPEN operation redirects to the DataNode holding the data.
+    if (response.code == http::Status::TEMPORARY_REDIRECT ||
+        response.code == http::Status::MOVED_PERMANENTLY ||
+        response.code == http::Status::FOUND) {
+      if (redirects == 0) {
+        return Failure("Too many HTTP redirects");
+      }
+
+      Option<string> location = response.headers.get("Location");
+      if (location.isNone()) {
+        return Failure(
+            "HTTP response '" + response.status + "' lacks a 'Location' "
+            "header");
+      }
+
+      Try<http::URL> url = http::URL::parse(location.get());
+      if (url.isError()) {
+        return Failure(
+            "Failed to parse the redirect URL '" + location.get() + "': " +
+            url.error());
+      }
+
+      // Drain the (empty or small) redirect body so the connection
+      // can be reused, then follow the redirect.
+      return drain(response.reader.get())
+        .then(defer(self(), &Self::download, url.get(), output, redirects - 1));
+    }
+
+    if (response.code != http::Status::OK) {
+      // Read out the body, which carries the WebHDFS remote
+      // exception, to produce a useful error message.
+      http::Pipe::Reader reader = response.reader.get();
+      const string status = response.status;
+
+      return reader.readAll()
+        .then([status](const string& body) -> Future<Nothing> {
+          return Failure(
+              "Unexpected HTTP response '" + status + "': " + body);
+        });
+    }
+
+    Try<int_fd> fd = os::open(
+        output,
+        O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+        S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+
+    if (fd.isError()) {
+      return Failure(
+          "Failed to open file '" + output + "': " + fd.error());
+    }
+
+    return stream(response.reader.get(), fd.get())
+      .onAny([fd](const Future<Nothing>&) { os::close(fd.get()); });
+  }
+
+  // Splices the response body into the given file.
+  static Future<Nothing> stream(http::Pipe::Reader reader, int_fd fd)
+  {
+    return reader.read()
+      .then([reader, fd](const string& data) -> Future<Nothing> {
+        if (data.empty()) {
+          return Nothing(); // EOF.
+        }
+
+        Try<Nothing> write = os::write(fd, data);
+        if (write.isError()) {
+          return Failure("Failed to write: " + write.error());
+        }
+
+        return stream(reader, fd);
+      });
+  }
+
+  // Reads and discards the response body.
+  static Future<Nothing> drain(http::Pipe::Reader reader)
+  {
+    return reader.read()
+      .then([reader](const string& data) -> Future<Nothing> {
+        if (data.empty()) {
+          return Nothing(); // EOF.
+        }
+
+        return drain(reader);
+      });
+  }
+
+  const uint16_t defaultPort;
+  const Option<string> user;
+  const Option<string> token;
+
+  // Cached keep-alive connections, keyed by 'host:port'.
+  hashmap<string, http::Connection> connections;
+};
+
+
+Try<Owned<Fetcher::Plugin>> WebHdfsFetcherPlugin::create(const Flags& flags)
+{
+  vector<string> schemes = strings::tokenize(
+      flags.webhdfs_supported_schemes, ",");
+
+  Owned<WebHdfsFetcherPluginProcess> process(
+      new WebHdfsFetcherPluginProcess(
+          flags.webhdfs_port,
+          flags.webhdfs_user,
+          flags.webhdfs_delegation_token));
+
+  return Owned<Fetcher::Plugin>(new WebHdfsFetcherPlugin(
+      process,
+      set<string>(schemes.begin(), schemes.end())));
+}
+
+
+WebHdfsFetcherPlugin::WebHdfsFetcherPlugin(
+    Owned<WebHdfsFetcherPluginProcess> _process,
+    const set<string>& _schemes)
+  : process(_process),
+    schemes_(_schemes)
+{
+  spawn(CHECK_NOTNULL(process.get()));
+}
+
+
+WebHdfsFetcherPlugin::~WebHdfsFetcherPlugin()
+{
+  terminate(process.get());
+  wait(process.get());
+}
+
+
+set<string> WebHdfsFetcherPlugin::schemes() const
+{
+  return schemes_;
+}
+
+
+string WebHdfsFetcherPlugin::name() const
+{
+  return NAME;
+}
+
+
+Future<Nothing> WebHdfsFetcherPlugin::fetch(
+    const URI& uri,
+    const string& directory,
+    const Option<string>& data) const
+{
+  return dispatch(
+      process.get(),
+      &WebHdfsFetcherPluginProcess::fetch,
+      uri,
+      directory);
+}
+
+} // namespace uri {
+} // namespace mesos {
@@ -19,11 +19,16 @@
 #endif // __WINDOWS__
 
 #include <deque>
+#include <list>
+#include <mutex>
 
 #include <process/clock.hpp>
 
+#include <stout/duration.hpp>
 #include <stout/foreach.hpp>
 #include <stout/os.hpp>
+#include <stout/stopwatch.hpp>
+#include <stout/synchronized.hpp>
 
 #include <stout/os/pstree.hpp>
 
@@ -32,9 +37,51 @@
 namespace mesos {
 namespace internal {
 
+namespace {
+
+// Window during which calls to `usage()` share a single scan of the
+// process table. Collecting usage for every container in an interval
+// otherwise rescans all of /proc once per container per isolator,
+// which on agents with large process trees amounts to thousands of
+// file opens per second.
+const Duration PROCESSES_SNAPSHOT_WINDOW = Milliseconds(500);
+
+
+Try<std::list<os::Process>> processes()
+{
+  // Deliberately leaked to avoid destruction order issues at exit.
+  static std::mutex* mutex = new std::mutex();
+  static Option<std::list<os::Process>>* snapshot =
+    new Option<std::list<os::Process>>();
+  static Stopwatch* age = new Stopwatch();
+
+  synchronized (mutex) {
+    if (snapshot->isNone() || age->elapsed() > PROCESSES_SNAPSHOT_WINDOW) {
+      Try<std::list<os::Process>> processes = os::processes();
+      if (processes.isError()) {
+        return Error(processes.error());
+      }
+
+      *snapshot = processes.get();
+      age->start();
+    }
+
+    return snapshot->get();
+  }
+}
+
+} // namespace
+
+
 Try<ResourceStatistics> usage(pid_t pid, bool mem, bool cpus)
 {
-  Try<os::ProcessTree> pstree = os::pstree(pid);
+  Try<std::list<os::Process>> snapshot = processes();
+
+  if (snapshot.isError()) {
+    return Error("Failed to get usage: " + snapshot.error());
+  }
+
+  Try<os::ProcessTree> pstree = os::pstree(pid, snapshot.get());
 
   if (pstree.isError()) {
     return Error("Failed to get usage: " + pstree.error());
@@ -29,6 +29,9 @@ namespace internal {
 // Collects resource usage of a process tree rooted at 'pid'. Only
 // collects the 'mem_*' values if 'mem' is true and the 'cpus_*'
 // values if 'cpus' is true.
+// NOTE: Calls made within a short window share a single snapshot of
+// the process table, so collecting usage for many containers in one
+// interval performs only one scan of /proc.
 Try<ResourceStatistics> usage(pid_t pid, bool mem = true, bool cpus = true);
 
 } // namespace internal {
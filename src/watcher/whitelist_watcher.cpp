@@ -14,13 +14,20 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#ifdef __linux__
+#include <limits.h>
+#include <sys/inotify.h>
+#endif
+
 #include <string>
 #include <vector>
 
 #include <glog/logging.h>
 
+#include <process/defer.hpp>
 #include <process/delay.hpp>
 #include <process/id.hpp>
+#include <process/io.hpp>
 
 #include <stout/foreach.hpp>
 #include <stout/os.hpp>
@@ -79,12 +86,42 @@ void WhitelistWatcher::initialize()
       subscriber(None());
     }
   } else {
+#ifdef __linux__
+    // Prefer file change notification over polling: with tens of
+    // thousands of entries, re-reading and re-hashing the file on a
+    // fixed interval is wasted work when the file rarely changes.
+    if (startNotifier()) {
+      read();
+      waitNotifier();
+      return;
+    }
+#endif
     watch();
   }
 }
 
 
+void WhitelistWatcher::finalize()
+{
+#ifdef __linux__
+  if (notifierFd.isSome()) {
+    os::close(notifierFd.get());
+    notifierFd = None();
+  }
+#endif
+}
+
+
 void WhitelistWatcher::watch()
+{
+  read();
+
+  // Schedule the next check.
+  delay(watchInterval, self(), &WhitelistWatcher::watch);
+}
+
+
+void WhitelistWatcher::read()
 {
   // Read the list of white listed nodes from local file.
   // TODO(vinod): Add support for reading from ZooKeeper.
@@ -116,10 +153,105 @@ void WhitelistWatcher::watch()
     subscriber(whitelist);
   }
 
-  // Schedule the next check.
   lastWhitelist = whitelist;
-  delay(watchInterval, self(), &WhitelistWatcher::watch);
 }
 
+
+#ifdef __linux__
+bool WhitelistWatcher::startNotifier()
+{
+  CHECK_SOME(path);
+
+  int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (fd == -1) {
+    PLOG(WARNING) << "Failed to initialize inotify, "
+                  << "falling back to polling the whitelist file";
+    return false;
+  }
+
+  // Watch the directory containing the whitelist so that we observe
+  // the file being replaced via rename(2) (how most tools rewrite
+  // configuration files atomically) as well as in-place rewrites.
+  Path filePath(path->string());
+
+  int wd = inotify_add_watch(
+      fd,
+      filePath.dirname().c_str(),
+      IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE);
+
+  if (wd == -1) {
+    PLOG(WARNING) << "Failed to watch '" << filePath.dirname() << "', "
+                  << "falling back to polling the whitelist file";
+    os::close(fd);
+    return false;
+  }
+
+  notifierFd = fd;
+  return true;
+}
+
+
+void WhitelistWatcher::waitNotifier()
+{
+  CHECK_SOME(notifierFd);
+
+  process::io::poll(notifierFd.get(), process::io::READ)
+    .onAny(defer(self(), &WhitelistWatcher::handleNotification, lambda::_1));
+}
+
+
+void WhitelistWatcher::handleNotification(
+    const process::Future<short>& ready)
+{
+  if (notifierFd.isNone()) {
+    return; // The notifier was closed during finalization.
+  }
+
+  if (!ready.isReady()) {
+    LOG(WARNING) << "Failed to wait for inotify events: "
+                 << (ready.isFailed() ? ready.failure() : "discarded") << ". "
+                 << "Falling back to polling the whitelist file";
+    os::close(notifierFd.get());
+    notifierFd = None();
+    watch();
+    return;
+  }
+
+  // Drain the event queue. We re-read the whitelist if any event
+  // concerns the whitelist file itself; events for other files in
+  // the watched directory are ignored.
+  const string basename = Path(path->string()).basename();
+  bool changed = false;
+
+  char buffer[sizeof(struct inotify_event) + NAME_MAX + 1]
+    __attribute__((aligned(__alignof__(struct inotify_event))));
+
+  while (true) {
+    ssize_t length = ::read(notifierFd.get(), buffer, sizeof(buffer));
+    if (length <= 0) {
+      break;
+    }
+
+    size_t offset = 0;
+    while (offset < static_cast<size_t>(length)) {
+      struct inotify_event* event =
+        reinterpret_cast<struct inotify_event*>(buffer + offset);
+
+      if (event->len > 0 && basename == event->name) {
+        changed = true;
+      }
+
+      offset += sizeof(struct inotify_event) + event->len;
+    }
+  }
+
+  if (changed) {
+    read();
+  }
+
+  waitNotifier();
+}
+#endif // __linux__
+
 } // namespace internal {
 } // namespace mesos {
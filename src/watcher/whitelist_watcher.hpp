@@ -19,6 +19,7 @@
 
 #include <string>
 
+#include <process/future.hpp>
 #include <process/process.hpp>
 
 #include <stout/duration.hpp>
@@ -59,14 +60,34 @@ public:
 
 protected:
   void initialize() override;
+  void finalize() override;
   void watch();
 
 private:
+  // Reads the whitelist file and notifies the subscriber if its
+  // contents changed since the last read.
+  void read();
+
+#ifdef __linux__
+  // Sets up an inotify watch on the directory containing the
+  // whitelist file, so that the file is only re-read when it is
+  // rewritten or replaced (e.g., via rename(2)). Returns false if
+  // the watch could not be established, in which case the caller
+  // should fall back to polling on `watchInterval`.
+  bool startNotifier();
+  void waitNotifier();
+  void handleNotification(const process::Future<short>& ready);
+#endif
+
   const Option<Path> path;
   const Duration watchInterval;
   lambda::function<void(const Option<hashset<std::string>>& whitelist)>
     subscriber;
   Option<hashset<std::string>> lastWhitelist;
+
+#ifdef __linux__
+  Option<int> notifierFd;
+#endif
 };
 
 } // namespace internal {
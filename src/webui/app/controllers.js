@@ -514,9 +514,31 @@
       // request.
       var leader_info = $scope.state ? $scope.state.leader_info : null;
 
-      $http.jsonp(leadingMasterURLPrefix(leader_info) +
-                  '/master/state?jsonp=JSON_CALLBACK')
+      var url = leadingMasterURLPrefix(leader_info) +
+                '/master/state?jsonp=JSON_CALLBACK';
+
+      // Present the version of the state we already hold so that the
+      // master omits the sections that have not changed in between,
+      // rather than re-transferring the full state on every poll.
+      if ($scope.state && $scope.state.state_version) {
+        url += '&since=' + $scope.state.state_version;
+      }
+
+      $http.jsonp(url)
         .success(function(response) {
+          // A delta response omits the sections that have not changed
+          // since the version presented above; patch them over from
+          // the previous state (JSON merge patch semantics).
+          if ($scope.state) {
+            _.each(['slaves', 'recovered_slaves', 'frameworks',
+                    'completed_frameworks'],
+                   function(key) {
+              if (!(key in response)) {
+                response[key] = $scope.state[key];
+              }
+            });
+          }
+
           if (updateState($scope, $timeout, response)) {
             $scope.delay = updateInterval(_.size($scope.agents));
             $timeout(pollState, $scope.delay);
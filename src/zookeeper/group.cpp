@@ -59,6 +59,10 @@ namespace zookeeper {
 const Duration GroupProcess::RETRY_INTERVAL = Seconds(2);
 
 
+// Time to wait before re-listing memberships after a watch event.
+const Duration GroupProcess::REFRESH_INTERVAL = Milliseconds(100);
+
+
 // Helper for failing a queue of promises.
 template <typename T>
 void fail(queue<T*>* queue, const string& message)
@@ -101,7 +105,8 @@ GroupProcess::GroupProcess(
     watcher(nullptr),
     zk(nullptr),
     state(DISCONNECTED),
-    retrying(false)
+    retrying(false),
+    refreshing(false)
 {}
 
 
@@ -543,6 +548,11 @@ void GroupProcess::expired(int64_t sessionId)
 
   CHECK(owned.empty());
 
+  // Toss the cached membership data: the members may no longer exist
+  // by the time we reconnect, and re-reading what does still exist is
+  // cheap compared to serving stale data.
+  datas.clear();
+
   // Note that we DO NOT clear unowned. The next time we try and cache
   // the memberships we'll trigger any cancelled unowned memberships
   // then. We could imagine doing this for owned memberships too, but
@@ -564,6 +574,37 @@ void GroupProcess::updated(int64_t sessionId, const string& path)
 
   CHECK_EQ(znode, path);
 
+  // Invalidate the cache right away (to preserve causality for any
+  // subsequent operations), but debounce the actual re-listing:
+  // during bursts of membership churn all the watch events that
+  // arrive within the refresh interval collapse into a single
+  // getChildren round trip against the ensemble.
+  memberships = None();
+
+  if (!refreshing) {
+    delay(REFRESH_INTERVAL, self(), &GroupProcess::refresh);
+    refreshing = true;
+  }
+}
+
+
+void GroupProcess::refresh()
+{
+  refreshing = false;
+
+  if (error.isSome() || state != READY) {
+    // Either we aborted, or the session (re)connection logic is in
+    // charge and will sync the cache once the group is ready again.
+    return;
+  }
+
+  if (memberships.isSome()) {
+    // Already cached again (e.g., by an intervening 'watch()');
+    // just make sure any pending watches get updated.
+    update();
+    return;
+  }
+
   Try<bool> cached = cache(); // Update cache (will invalidate first).
 
   if (cached.isError()) {
@@ -692,6 +733,13 @@ Result<Option<string>> GroupProcess::doData(
 {
   CHECK_EQ(state, READY);
 
+  // Member znodes are created with their data and never rewritten,
+  // so data fetched once stays valid for as long as the member
+  // exists (the cache is evicted when the membership goes away).
+  if (datas.count(membership.id()) > 0) {
+    return Some(datas[membership.id()]);
+  }
+
   string path = path::join(
       znode,
       zkBasename(membership),
@@ -715,6 +763,8 @@ Result<Option<string>> GroupProcess::doData(
         "' in ZooKeeper: " + zk->message(code));
   }
 
+  datas[membership.id()] = result;
+
   return Some(result);
 }
 
@@ -771,6 +821,7 @@ Try<bool> GroupProcess::cache()
       cancelled->set(false);
       owned.erase(sequence); // Okay since iterating over a copy.
       delete cancelled;
+      datas.erase(sequence);
     } else {
       current.insert(Group::Membership(
           sequence, sequences[sequence], cancelled->future()));
@@ -786,6 +837,7 @@ Try<bool> GroupProcess::cache()
       cancelled->set(false);
       unowned.erase(sequence); // Okay since iterating over a copy.
       delete cancelled;
+      datas.erase(sequence);
     } else {
       current.insert(Group::Membership(
           sequence, sequences[sequence], cancelled->future()));
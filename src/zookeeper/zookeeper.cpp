@@ -406,6 +406,64 @@ public:
     return future;
   }
 
+  // Applies the updates as a single atomic multi-op. Note that this
+  // is named 'multi' rather than overloading 'set' so that taking
+  // '&ZooKeeperProcess::set' for dispatching stays unambiguous.
+  Future<int> multi(const vector<ZooKeeper::Update>& updates)
+  {
+    CHECK(!updates.empty());
+
+    Promise<int>* promise = new Promise<int>();
+
+    Future<int> future = promise->future();
+
+    // Copy the updates so the paths and data outlive the call, and
+    // initialize one operation per update pointing into that copy.
+    // Everything must stay alive until the completion runs.
+    vector<ZooKeeper::Update>* copies = new vector<ZooKeeper::Update>(updates);
+    vector<zoo_op_t>* ops = new vector<zoo_op_t>(copies->size());
+    vector<zoo_op_result_t>* results =
+      new vector<zoo_op_result_t>(copies->size());
+
+    for (size_t i = 0; i < copies->size(); i++) {
+      zoo_set_op_init(
+          &(*ops)[i],
+          (*copies)[i].path.c_str(),
+          (*copies)[i].data.data(),
+          static_cast<int>((*copies)[i].data.size()),
+          (*copies)[i].version,
+          nullptr);
+    }
+
+    tuple<Promise<int>*,
+          vector<ZooKeeper::Update>*,
+          vector<zoo_op_t>*,
+          vector<zoo_op_result_t>*>* args =
+      new tuple<Promise<int>*,
+                vector<ZooKeeper::Update>*,
+                vector<zoo_op_t>*,
+                vector<zoo_op_result_t>*>(promise, copies, ops, results);
+
+    int ret = zoo_amulti(
+        zh,
+        static_cast<int>(ops->size()),
+        ops->data(),
+        results->data(),
+        multiCompletion,
+        args);
+
+    if (ret != ZOK) {
+      delete promise;
+      delete copies;
+      delete ops;
+      delete results;
+      delete args;
+      return ret;
+    }
+
+    return future;
+  }
+
 private:
   // This method is registered as a watcher callback function and is
   // invoked by a single ZooKeeper event thread.
@@ -476,6 +534,42 @@ private:
     delete args;
   }
 
+  static void multiCompletion(int ret, const void* data)
+  {
+    const tuple<Promise<int>*,
+                vector<ZooKeeper::Update>*,
+                vector<zoo_op_t>*,
+                vector<zoo_op_result_t>*>* args =
+      reinterpret_cast<const tuple<Promise<int>*,
+                                   vector<ZooKeeper::Update>*,
+                                   vector<zoo_op_t>*,
+                                   vector<zoo_op_result_t>*>*>(data);
+
+    Promise<int>* promise = std::get<0>(*args);
+    vector<zoo_op_result_t>* results = std::get<3>(*args);
+
+    // On failure surface the return code of the first operation that
+    // could not be applied: the other operations report
+    // ZRUNTIMEINCONSISTENCY (rolled back) which tells the caller
+    // nothing about what went wrong.
+    if (ret != ZOK) {
+      foreach (const zoo_op_result_t& result, *results) {
+        if (result.err != ZOK && result.err != ZRUNTIMEINCONSISTENCY) {
+          ret = result.err;
+          break;
+        }
+      }
+    }
+
+    promise->set(ret);
+
+    delete promise;
+    delete std::get<1>(*args);
+    delete std::get<2>(*args);
+    delete results;
+    delete args;
+  }
+
   static void dataCompletion(
       int ret,
       const char* value,
@@ -665,6 +759,12 @@ int ZooKeeper::set(const string& path, const string& data, int version)
 }
 
 
+int ZooKeeper::set(const vector<Update>& updates)
+{
+  return dispatch(process, &ZooKeeperProcess::multi, updates).get();
+}
+
+
 string ZooKeeper::message(int code) const
 {
   return string(zerror(code));
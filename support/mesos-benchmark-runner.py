@@ -0,0 +1,233 @@
+#!/usr/bin/env python
+#
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+"""
+Benchmark runner for GoogleTest programs.
+
+This script discovers all BENCHMARK-tagged tests in one or more test
+binaries (e.g. `src/mesos-tests` and
+`3rdparty/libprocess/libprocess-tests`), runs each of them with
+configurable warmup and repetition counts, and emits a single JSON
+report with per-benchmark wall-clock timings (mean, min, max and
+coefficient of variation) suitable for automated regression tracking
+between releases.
+
+The per-benchmark output printed by the tests themselves is captured
+verbatim in the report, so finer-grained numbers (e.g. ns/op counters
+printed by individual benchmarks) remain available to downstream
+tooling.
+"""
+
+from __future__ import print_function
+
+import json
+import optparse
+import os
+import platform
+import subprocess
+import sys
+import time
+
+
+BENCHMARK_FILTER = '*BENCHMARK*'
+
+DEFAULT_NUM_WARMUPS = 1
+DEFAULT_NUM_REPETITIONS = 3
+
+
+class Benchmark(object):
+    """A single benchmark test inside a test binary."""
+
+    def __init__(self, binary, name, needs_benchmark_flag):
+        self.binary = binary
+        self.name = name
+        self.needs_benchmark_flag = needs_benchmark_flag
+
+    def command(self):
+        command = [self.binary, '--gtest_filter=' + self.name]
+
+        # `mesos-tests` hides benchmarks unless `--benchmark` is passed;
+        # `libprocess-tests` does not know the flag.
+        if self.needs_benchmark_flag:
+            command.append('--benchmark')
+
+        return command
+
+    def run(self):
+        """Runs the benchmark once, returning (duration_ns, output)."""
+        start = time.time()
+
+        process = subprocess.Popen(
+            self.command(),
+            stdout=subprocess.PIPE,
+            stderr=subprocess.STDOUT)
+
+        output = process.communicate()[0].decode('utf-8', 'replace')
+
+        if process.returncode != 0:
+            raise RuntimeError(
+                'Benchmark %s exited with status %d:\n%s'
+                % (self.name, process.returncode, output))
+
+        return int((time.time() - start) * 1e9), output
+
+
+def list_benchmarks(binary):
+    """Returns the benchmarks contained in the given test binary."""
+    command = [
+        binary,
+        '--gtest_list_tests',
+        '--gtest_filter=' + BENCHMARK_FILTER,
+    ]
+
+    # Probe whether the binary understands `--benchmark`.
+    needs_benchmark_flag = True
+    try:
+        output = subprocess.check_output(
+            command + ['--benchmark'], stderr=subprocess.STDOUT)
+    except subprocess.CalledProcessError:
+        needs_benchmark_flag = False
+        output = subprocess.check_output(command, stderr=subprocess.STDOUT)
+
+    benchmarks = []
+    test_case = None
+    for line in output.decode('utf-8', 'replace').splitlines():
+        if not line.strip() or line.startswith('Note:'):
+            continue
+
+        if not line.startswith(' '):
+            test_case = line.split('#')[0].strip()
+        else:
+            test = line.split('#')[0].strip()
+            benchmarks.append(Benchmark(
+                binary, test_case + test, needs_benchmark_flag))
+
+    return benchmarks
+
+
+def measure(benchmark, num_warmups, num_repetitions):
+    """Runs a benchmark repeatedly and returns its report entry."""
+    for _ in range(num_warmups):
+        benchmark.run()
+
+    durations = []
+    output = ''
+    for _ in range(num_repetitions):
+        duration_ns, output = benchmark.run()
+        durations.append(duration_ns)
+
+    mean = sum(durations) / float(len(durations))
+    variance = \
+        sum((d - mean) ** 2 for d in durations) / float(len(durations))
+    cv = (variance ** 0.5) / mean if mean > 0 else 0.0
+
+    return {
+        'name': benchmark.name,
+        'binary': benchmark.binary,
+        'repetitions': num_repetitions,
+        'mean_ns': int(mean),
+        'min_ns': min(durations),
+        'max_ns': max(durations),
+        'cv': round(cv, 4),
+        'output': output,
+    }
+
+
+def main():
+    parser = optparse.OptionParser(
+        usage='Usage: %prog [options] <test binary> [<test binary> ...]')
+
+    parser.add_option(
+        '--output',
+        metavar='FILE',
+        help='write the JSON report to FILE instead of stdout')
+
+    parser.add_option(
+        '--filter',
+        default='',
+        metavar='PATTERN',
+        help='only run benchmarks whose name contains PATTERN')
+
+    parser.add_option(
+        '--warmups',
+        type='int',
+        default=DEFAULT_NUM_WARMUPS,
+        metavar='N',
+        help='number of untimed warmup runs per benchmark [default: %default]')
+
+    parser.add_option(
+        '--repetitions',
+        type='int',
+        default=DEFAULT_NUM_REPETITIONS,
+        metavar='N',
+        help='number of timed runs per benchmark [default: %default]')
+
+    (options, binaries) = parser.parse_args()
+
+    if not binaries:
+        parser.error('no test binaries given')
+
+    for binary in binaries:
+        if not os.access(binary, os.X_OK):
+            parser.error('%s is not an executable' % binary)
+
+    benchmarks = []
+    for binary in binaries:
+        benchmarks.extend(list_benchmarks(binary))
+
+    if options.filter:
+        benchmarks = [b for b in benchmarks if options.filter in b.name]
+
+    report = {
+        'timestamp': int(time.time()),
+        'hostname': platform.node(),
+        'warmups': options.warmups,
+        'benchmarks': [],
+    }
+
+    for benchmark in benchmarks:
+        print('Running %s (%d warmups, %d repetitions)'
+              % (benchmark.name, options.warmups, options.repetitions))
+
+        try:
+            entry = measure(benchmark, options.warmups, options.repetitions)
+        except RuntimeError as error:
+            print(str(error), file=sys.stderr)
+            return 1
+
+        print('  mean: %.3fs cv: %.2f%%'
+              % (entry['mean_ns'] / 1e9, 100 * entry['cv']))
+
+        report['benchmarks'].append(entry)
+
+    serialized = json.dumps(report, indent=2, sort_keys=True)
+
+    if options.output:
+        with open(options.output, 'w') as output:
+            output.write(serialized + '\n')
+        print('Wrote report with %d benchmarks to %s'
+              % (len(report['benchmarks']), options.output))
+    else:
+        print(serialized)
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())